@@ -34,6 +34,8 @@
  * channel.If you are using another Operating System may want to implement
  * tmwtarg_initMultiTimer, tmwtarg_setMultiTimer, and tmwtarg_deleteMultiTimer
  * in addition to the other tmwtarg_xxx functionality.
+ * For many channels on Linux, tmwtargrt.h in LinIoTarg runs the channels on a
+ * fixed pool of worker threads instead of a thread per channel.
  */
 #if defined(TMW_WTK_TARGET)
 #include "StdAfx.h"
@@ -51,6 +53,7 @@ extern "C" {
 #include "tmwscl/dnp/sdnputil.h"
 #include "tmwscl/dnp/sdnpo002.h"
 #include "tmwscl/dnp/sdnpo022.h"
+#include "tmwscl/dnp/sdnpsevt.h"
 
 #include "tmwtargio.h"
 }
@@ -91,6 +94,17 @@ static void             myLogOutput(char *pBuf);
 static void             myPutDiagString(const TMWDIAG_ANLZ_ID *pAnlzId, const TMWTYPES_CHAR *pString);
 
 static TMW_ThreadDecl   myChannelThreadDNP(void *pParam);
+
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+/* Every session on every channel serves the same points, so their events
+ * are kept once in a shared event store and added by the first channel
+ * thread only, instead of being copied into each session's queue. Each
+ * session picks up new events every SHARED_EVENT_CHECK_PERIOD ms.
+ */
+#define MAX_SHARED_EVENTS 100
+#define SHARED_EVENT_CHECK_PERIOD 50
+static SDNPSEVT_STORE  *pSharedEvents;
+#endif
  
 /*
  * Begin the main loop
@@ -116,6 +130,15 @@ int main(int argc, char* argv[])
    */
   tmwappl_initSCL();
 
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+  pSharedEvents = sdnpsevt_create(MAX_SHARED_EVENTS, SHARED_EVENT_CHECK_PERIOD);
+  if(pSharedEvents == TMWDEFS_NULL)
+  {
+    printf("Failed to create shared event store, exiting program \n");
+    return (0);
+  }
+#endif
+
   /* Start the channel threads */
   for(i=0; i<NUMBER_CHANNELS; i++)
   {
@@ -228,6 +251,9 @@ TMW_ThreadDecl myChannelThreadDNP(void *pParam)
   
   // If using TCP the DNP Spec requires keep alives to be configured in order to detect disconnects.
   sesnConfig.linkStatusPeriod = 30000;
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+  sesnConfig.userManagedEvents = TMWDEFS_TRUE;
+#endif
 
   /*
    * Open the Channel, Sessions, and Sectors
@@ -265,6 +291,9 @@ TMW_ThreadDecl myChannelThreadDNP(void *pParam)
       tmwtarg_sleep(10000);
       return (0);
     }
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+    sdnpsevt_attach(pSharedEvents, pSclSession[i]);
+#endif
   }
 
   if (USE_POLLED_MODE)
@@ -292,6 +321,22 @@ TMW_ThreadDecl myChannelThreadDNP(void *pParam)
    
     if(myTimeToSendEvent(&pMyRequests->lastEvent, pMyRequests->eventInterval))
     {
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+      if (channelNumber == 0)
+      {
+        TMWDTIME timeStamp;
+        SDNPDATA_ADD_EVENT_VALUE value;
+
+        sdnputil_getDateTime(pSclSession[0], &timeStamp);
+        sdnpsevt_addEvent(pSharedEvents, DNPDEFS_OBJ_2_BIN_CHNG_EVENTS, 4, 0x02, TMWDEFS_NULL, &timeStamp);
+        value.ulValue = 100;
+        if(sdnpsevt_addEvent(pSharedEvents, DNPDEFS_OBJ_22_CNTR_EVENTS, 4, 0x02, &value, &timeStamp))
+          sprintf(logBuf, "Added shared events for all sessions\n");
+        else
+          sprintf(logBuf, "Failed to add shared events\n");
+        myLogOutput(logBuf);
+      }
+#else
       for (int i = 0; i < NUMBER_SESSIONS; i++)
       {
         TMWDTIME timeStamp;
@@ -302,6 +347,7 @@ TMW_ThreadDecl myChannelThreadDNP(void *pParam)
         sdnpo002_addEvent(pSclSession[i], 4, 0x02, &timeStamp);
         sdnpo022_addEvent(pSclSession[i], 4, 100, 0x02, &timeStamp);
       }
+#endif
     }
     tmwtarg_sleep(pollInterval);
   }
@@ -311,6 +357,9 @@ TMW_ThreadDecl myChannelThreadDNP(void *pParam)
   {
     sprintf(logBuf, "closing DNP session %d\n", i);
     myLogOutput(logBuf);
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+    sdnpsevt_detach(pSclSession[i]);
+#endif
     sdnpsesn_closeSession(pSclSession[i]);
   }
 
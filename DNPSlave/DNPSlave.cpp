@@ -54,6 +54,7 @@ extern "C" {
 #include "tmwscl/dnp/sdnpsim.h"
 #endif
 #include "tmwscl/dnp/sdnpo032.h"
+#include "tmwscl/dnp/sdnpmpub.h"
 #include "tmwscl/dnp/sdnputil.h"
 #include "tmwtargio.h"
 }
@@ -78,6 +79,23 @@ TMWTYPES_BOOL     noUserAtStartup = TMWDEFS_FALSE;
 
 struct mqtt_client client;
 
+/* Broker the analog input events are published to */
+static const char *brokerAddr = "192.168.197.195";
+static const char *brokerPort = "1883";
+
+static mqtt_pal_socket_handle myOpenBroker(void *pParam, TMWTYPES_UINT index)
+{
+  TMWTARG_UNUSED_PARAM(pParam);
+  TMWTARG_UNUSED_PARAM(index);
+  return(open_nb_socket(brokerAddr, brokerPort));
+}
+
+static void myCloseBroker(void *pParam, mqtt_pal_socket_handle socketfd)
+{
+  TMWTARG_UNUSED_PARAM(pParam);
+  close(socketfd);
+}
+
 #if !TMWCNFG_MULTIPLE_TIMER_QS
 /* forward references */
 void myPutDiagString(const TMWDIAG_ANLZ_ID *pAnlzId, const TMWTYPES_CHAR *pString);
@@ -344,6 +362,27 @@ int main(int argc, char* argv[])
     return (1);
   } 
 
+#if SDNPCNFG_SUPPORT_MQTT_PUBLISHER
+  /* Publish the analog input events to the broker, over connections that
+   * are opened and kept open by the publisher's threads
+   */
+  {
+    SDNPMPUB_CONFIG pubConfig;
+    SDNPMPUB *pPublisher;
+
+    sdnpmpub_initConfig(&pubConfig);
+    strcpy(pubConfig.clientId, "DNPSlave");
+    pubConfig.pOpenFunc = myOpenBroker;
+    pubConfig.pCloseFunc = myCloseBroker;
+
+    pPublisher = sdnpmpub_create(&pubConfig);
+    if(pPublisher != TMWDEFS_NULL)
+      sdnpmpub_attachSession(pSclSession, pPublisher);
+    else
+      printf("Failed to create MQTT publisher\n");
+  }
+#endif
+
 #if DNPCNFG_SUPPORT_AUTHENTICATION
   if (myUseAuthentication)
   {
@@ -447,45 +486,7 @@ int main(int argc, char* argv[])
       TMWTYPES_ANALOG_VALUE analogValue;
       TMWDTIME timeStamp;
 
-      struct mqtt_response_publish *published;
-      //192.168.197.195
-      const char addr[] = "192.168.197.195";
-      const char port[] = "1883";
-
-      // const char str[] = "A";
-      // char buffer[20];
-      // sprintf(buffer,"%ls_%d", str,point);
-      char topic [] = "datetime";
-
-      int sockfd;
-      const char *client_id = NULL;
-      // uint8_t *sendbuf;
-      // uint8_t *recvbuf;
-      /* Create an anonymous session */
-
-      /* Ensure we have a clean session */
-      uint8_t connect_flags = MQTT_CONNECT_CLEAN_SESSION;
-      uint8_t sendbuf[2048]; /* sendbuf should be large enough to hold multiple whole mqtt messages */
-      uint8_t recvbuf[1024]; /* recvbuf should be large enough any whole mqtt message expected to be received */
-
-
-      int open_nb_socket(const char *addr, const char *port);
-
-      /* open the non-blocking TCP socket (connecting to the broker) */
-      sockfd = open_nb_socket(addr, port);
-
-      if (sockfd == -1)
-      {
-        perror("Failed to open socket: ");
-      }
-      /* Send connection request to the broker. */
-
-      mqtt_connect(&client, client_id, NULL, NULL, 0, NULL, NULL, connect_flags, 400);
-      mqtt_subscribe(&client, topic, 0);
-
-      
-
-
+      tmwdtime_getDateTime(pSclSession, &timeStamp);
       analogValue.value.dval = rand();
       analogValue.type = TMWTYPES_ANALOG_TYPE_DOUBLE;
       printf("value of publish SLAVE___________________%lf \n",analogValue.value.dval);
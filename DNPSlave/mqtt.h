@@ -174,6 +174,19 @@ struct mqtt_fixed_header {
  */
 #define MQTT_PROTOCOL_LEVEL 0x04
 
+/**
+ * @brief The protocol version for MQTT v5.0.
+ * @ingroup packers
+ * 
+ * Connections made with mqtt_connect5 use this protocol level and the MQTT v5.0 
+ * framing of every packet.
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: CONNECT Variable Header, Protocol Version.
+ * </a>  
+ */
+#define MQTT_PROTOCOL_LEVEL_5 0x05
+
 /** 
  * @brief A macro used to declare the enum MQTTErrors and associated 
  *        error messages (the members of the num) at the same time.
@@ -286,6 +299,56 @@ ssize_t __mqtt_pack_str(uint8_t *buf, const char* str);
 /** @brief A macro to get the MQTT string length from a c-string. */
 #define __mqtt_packed_cstrlen(x) (2 + (unsigned int)strlen(x))
 
+/**
+ * @brief Pack a MQTT 32 bit integer, given a native 32 bit integer.
+ * 
+ * @param[out] buf the buffer that the MQTT integer will be written to.
+ * @param[in] integer the native integer to be written to \p buf.
+ * 
+ * @warning This function provides no error checking.
+ * 
+ * @returns 4
+*/
+ssize_t __mqtt_pack_uint32(uint8_t *buf, uint32_t integer);
+
+/**
+ * @brief Unpack a MQTT 32 bit integer to a native 32 bit integer.
+ * 
+ * @param[in] buf the buffer that the MQTT integer will be read from.
+ * 
+ * @warning This function provides no error checking and does not modify \p buf.
+ * 
+ * @returns The native integer
+*/
+uint32_t __mqtt_unpack_uint32(const uint8_t *buf);
+
+/**
+ * @brief Pack a MQTT variable byte integer, as used for MQTT v5.0 property lengths.
+ * 
+ * @param[out] buf the buffer that the variable byte integer will be written to.
+ * @param[in] integer the integer to be written to \p buf, less than 268435456.
+ * 
+ * @warning This function provides no error checking.
+ * 
+ * @returns __mqtt_packed_varintlen(integer)
+*/
+ssize_t __mqtt_pack_varint(uint8_t *buf, uint32_t integer);
+
+/**
+ * @brief Unpack a MQTT variable byte integer.
+ * 
+ * @param[out] integer the unpacked integer.
+ * @param[in] buf the buffer that the variable byte integer will be read from.
+ * @param[in] bufsz the number of bytes in \p buf.
+ * 
+ * @returns The number of bytes consumed, 0 if \p buf ends before the integer does, or
+ *          \c MQTT_ERROR_MALFORMED_RESPONSE if the integer is longer than 4 bytes.
+*/
+ssize_t __mqtt_unpack_varint(uint32_t *integer, const uint8_t *buf, size_t bufsz);
+
+/** @brief A macro to get the size of a MQTT variable byte integer. */
+#define __mqtt_packed_varintlen(x) ((x) < 128u ? 1u : (x) < 16384u ? 2u : (x) < 2097152u ? 3u : 4u)
+
 /* RESPONSES */
 
 /**
@@ -305,6 +368,172 @@ enum MQTTConnackReturnCode {
     MQTT_CONNACK_REFUSED_NOT_AUTHORIZED = 5u
 };
 
+/**
+ * @brief An enumeration of the MQTT v5.0 reason codes.
+ * @ingroup unpackers
+ * 
+ * MQTT v5.0 CONNACK, PUBACK, PUBREC, PUBREL, PUBCOMP, SUBACK, UNSUBACK and DISCONNECT 
+ * packets carry a reason code. Values below 0x80 report success, values of 0x80 and 
+ * above report a failure.
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: Reason Code.
+ * </a> 
+ */
+enum MQTTReasonCodes {
+    MQTT_REASON_SUCCESS = 0x00u,
+    MQTT_REASON_NORMAL_DISCONNECTION = 0x00u,
+    MQTT_REASON_GRANTED_QOS_0 = 0x00u,
+    MQTT_REASON_GRANTED_QOS_1 = 0x01u,
+    MQTT_REASON_GRANTED_QOS_2 = 0x02u,
+    MQTT_REASON_DISCONNECT_WITH_WILL_MESSAGE = 0x04u,
+    MQTT_REASON_NO_MATCHING_SUBSCRIBERS = 0x10u,
+    MQTT_REASON_NO_SUBSCRIPTION_EXISTED = 0x11u,
+    MQTT_REASON_CONTINUE_AUTHENTICATION = 0x18u,
+    MQTT_REASON_RE_AUTHENTICATE = 0x19u,
+    MQTT_REASON_UNSPECIFIED_ERROR = 0x80u,
+    MQTT_REASON_MALFORMED_PACKET = 0x81u,
+    MQTT_REASON_PROTOCOL_ERROR = 0x82u,
+    MQTT_REASON_IMPLEMENTATION_SPECIFIC_ERROR = 0x83u,
+    MQTT_REASON_UNSUPPORTED_PROTOCOL_VERSION = 0x84u,
+    MQTT_REASON_CLIENT_IDENTIFIER_NOT_VALID = 0x85u,
+    MQTT_REASON_BAD_USER_NAME_OR_PASSWORD = 0x86u,
+    MQTT_REASON_NOT_AUTHORIZED = 0x87u,
+    MQTT_REASON_SERVER_UNAVAILABLE = 0x88u,
+    MQTT_REASON_SERVER_BUSY = 0x89u,
+    MQTT_REASON_BANNED = 0x8Au,
+    MQTT_REASON_SERVER_SHUTTING_DOWN = 0x8Bu,
+    MQTT_REASON_BAD_AUTHENTICATION_METHOD = 0x8Cu,
+    MQTT_REASON_KEEP_ALIVE_TIMEOUT = 0x8Du,
+    MQTT_REASON_SESSION_TAKEN_OVER = 0x8Eu,
+    MQTT_REASON_TOPIC_FILTER_INVALID = 0x8Fu,
+    MQTT_REASON_TOPIC_NAME_INVALID = 0x90u,
+    MQTT_REASON_PACKET_IDENTIFIER_IN_USE = 0x91u,
+    MQTT_REASON_PACKET_IDENTIFIER_NOT_FOUND = 0x92u,
+    MQTT_REASON_RECEIVE_MAXIMUM_EXCEEDED = 0x93u,
+    MQTT_REASON_TOPIC_ALIAS_INVALID = 0x94u,
+    MQTT_REASON_PACKET_TOO_LARGE = 0x95u,
+    MQTT_REASON_MESSAGE_RATE_TOO_HIGH = 0x96u,
+    MQTT_REASON_QUOTA_EXCEEDED = 0x97u,
+    MQTT_REASON_ADMINISTRATIVE_ACTION = 0x98u,
+    MQTT_REASON_PAYLOAD_FORMAT_INVALID = 0x99u,
+    MQTT_REASON_RETAIN_NOT_SUPPORTED = 0x9Au,
+    MQTT_REASON_QOS_NOT_SUPPORTED = 0x9Bu,
+    MQTT_REASON_USE_ANOTHER_SERVER = 0x9Cu,
+    MQTT_REASON_SERVER_MOVED = 0x9Du,
+    MQTT_REASON_SHARED_SUBSCRIPTIONS_NOT_SUPPORTED = 0x9Eu,
+    MQTT_REASON_CONNECTION_RATE_EXCEEDED = 0x9Fu,
+    MQTT_REASON_MAXIMUM_CONNECT_TIME = 0xA0u,
+    MQTT_REASON_SUBSCRIPTION_IDENTIFIERS_NOT_SUPPORTED = 0xA1u,
+    MQTT_REASON_WILDCARD_SUBSCRIPTIONS_NOT_SUPPORTED = 0xA2u
+};
+
+/**
+ * @brief An enumeration of the MQTT v5.0 property identifiers.
+ * @ingroup unpackers
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: Properties.
+ * </a> 
+ */
+enum MQTTPropertyIdentifiers {
+    MQTT_PROP_PAYLOAD_FORMAT_INDICATOR = 0x01u,
+    MQTT_PROP_MESSAGE_EXPIRY_INTERVAL = 0x02u,
+    MQTT_PROP_CONTENT_TYPE = 0x03u,
+    MQTT_PROP_RESPONSE_TOPIC = 0x08u,
+    MQTT_PROP_CORRELATION_DATA = 0x09u,
+    MQTT_PROP_SUBSCRIPTION_IDENTIFIER = 0x0Bu,
+    MQTT_PROP_SESSION_EXPIRY_INTERVAL = 0x11u,
+    MQTT_PROP_ASSIGNED_CLIENT_IDENTIFIER = 0x12u,
+    MQTT_PROP_SERVER_KEEP_ALIVE = 0x13u,
+    MQTT_PROP_AUTHENTICATION_METHOD = 0x15u,
+    MQTT_PROP_AUTHENTICATION_DATA = 0x16u,
+    MQTT_PROP_REQUEST_PROBLEM_INFORMATION = 0x17u,
+    MQTT_PROP_WILL_DELAY_INTERVAL = 0x18u,
+    MQTT_PROP_REQUEST_RESPONSE_INFORMATION = 0x19u,
+    MQTT_PROP_RESPONSE_INFORMATION = 0x1Au,
+    MQTT_PROP_SERVER_REFERENCE = 0x1Cu,
+    MQTT_PROP_REASON_STRING = 0x1Fu,
+    MQTT_PROP_RECEIVE_MAXIMUM = 0x21u,
+    MQTT_PROP_TOPIC_ALIAS_MAXIMUM = 0x22u,
+    MQTT_PROP_TOPIC_ALIAS = 0x23u,
+    MQTT_PROP_MAXIMUM_QOS = 0x24u,
+    MQTT_PROP_RETAIN_AVAILABLE = 0x25u,
+    MQTT_PROP_USER_PROPERTY = 0x26u,
+    MQTT_PROP_MAXIMUM_PACKET_SIZE = 0x27u,
+    MQTT_PROP_WILDCARD_SUBSCRIPTION_AVAILABLE = 0x28u,
+    MQTT_PROP_SUBSCRIPTION_IDENTIFIER_AVAILABLE = 0x29u,
+    MQTT_PROP_SHARED_SUBSCRIPTION_AVAILABLE = 0x2Au
+};
+
+/**
+ * @brief A MQTT v5.0 user property, a name and value pair of strings.
+ * @ingroup packers
+ */
+struct mqtt_user_property {
+    /** @brief The name of the property. */
+    const char *name;
+
+    /** @brief The value of the property. */
+    const char *value;
+};
+
+/**
+ * @brief A MQTT v5.0 property unpacked from a received packet.
+ * @ingroup unpackers
+ * 
+ * @see mqtt_unpack_property
+ */
+struct mqtt_property {
+    /** @brief The property identifier, one of \ref MQTTPropertyIdentifiers. */
+    uint8_t identifier;
+
+    /** @brief The value of a byte, two byte integer, four byte integer or variable byte integer property. */
+    uint32_t value;
+
+    /** 
+     * @brief The UTF-8 string or binary data of a property, or the name of a user property.
+     * @note data is not null terminated. Therefore data_size must be used to get its length.
+     */
+    const uint8_t *data;
+
+    /** @brief The size of \c data in bytes. */
+    uint16_t data_size;
+
+    /** @brief The value of a user property, not null terminated. */
+    const uint8_t *pair_value;
+
+    /** @brief The size of \c pair_value in bytes. */
+    uint16_t pair_value_size;
+};
+
+/**
+ * @brief Unpack the next property of a MQTT v5.0 property list.
+ * @ingroup unpackers
+ * 
+ * The properties of a received packet are left in place, see for example
+ * \ref mqtt_response_publish.properties. They are walked with:
+ * @code
+ * const uint8_t *p = publish->properties;
+ * size_t n = publish->properties_size;
+ * struct mqtt_property property;
+ * ssize_t rv;
+ * while((rv = mqtt_unpack_property(&property, p, n)) > 0) {
+ *     p += rv;
+ *     n -= (size_t) rv;
+ * }
+ * @endcode
+ * 
+ * @param[out] property the unpacked property.
+ * @param[in] buf the start of the property.
+ * @param[in] bufsz the number of bytes left in the property list.
+ * 
+ * @returns The number of bytes consumed, 0 at the end of the list, or 
+ *          \c MQTT_ERROR_MALFORMED_RESPONSE if the property does not fit in the list or has
+ *          an unknown identifier.
+ */
+ssize_t mqtt_unpack_property(struct mqtt_property *property, const uint8_t *buf, size_t bufsz);
+
 /**
  * @brief A connection response datastructure.
  * @ingroup unpackers
@@ -323,9 +552,17 @@ struct mqtt_response_connack {
     /** 
      * @brief The return code of the connection request. 
      * 
+     * @note On a MQTT v5.0 connection this is one of the \ref MQTTReasonCodes instead.
+     * 
      * @see MQTTConnackReturnCode
      */
     enum MQTTConnackReturnCode return_code;
+
+    /** @brief The MQTT v5.0 CONNACK properties, see mqtt_unpack_property. */
+    const uint8_t *properties;
+
+    /** @brief The size of \c properties in bytes, 0 for MQTT v3.1.1. */
+    size_t properties_size;
 };
 
  /**
@@ -371,6 +608,12 @@ struct mqtt_response_publish {
     /** @brief The publish message's packet ID. */
     uint16_t packet_id;
 
+    /** @brief The MQTT v5.0 PUBLISH properties, see mqtt_unpack_property. */
+    const uint8_t *properties;
+
+    /** @brief The size of \c properties in bytes, 0 for MQTT v3.1.1. */
+    size_t properties_size;
+
     /** @brief The publish message's application message.*/
     const void* application_message;
 
@@ -390,6 +633,9 @@ struct mqtt_response_publish {
 struct mqtt_response_puback {
     /** @brief The published messages packet ID. */
     uint16_t packet_id;
+
+    /** @brief The MQTT v5.0 reason code, \c MQTT_REASON_SUCCESS for MQTT v3.1.1. */
+    uint8_t reason_code;
 };
 
 /**
@@ -404,6 +650,9 @@ struct mqtt_response_puback {
 struct mqtt_response_pubrec {
     /** @brief The published messages packet ID. */
     uint16_t packet_id;
+
+    /** @brief The MQTT v5.0 reason code, \c MQTT_REASON_SUCCESS for MQTT v3.1.1. */
+    uint8_t reason_code;
 };
 
 /**
@@ -418,6 +667,9 @@ struct mqtt_response_pubrec {
 struct mqtt_response_pubrel {
     /** @brief The published messages packet ID. */
     uint16_t packet_id;
+
+    /** @brief The MQTT v5.0 reason code, \c MQTT_REASON_SUCCESS for MQTT v3.1.1. */
+    uint8_t reason_code;
 };
 
 /**
@@ -432,6 +684,9 @@ struct mqtt_response_pubrel {
 struct mqtt_response_pubcomp {
     /** T@brief he published messages packet ID. */
     uint16_t packet_id;
+
+    /** @brief The MQTT v5.0 reason code, \c MQTT_REASON_SUCCESS for MQTT v3.1.1. */
+    uint8_t reason_code;
 };
 
 /**
@@ -464,6 +719,8 @@ struct mqtt_response_suback {
     /** 
      * Array of return codes corresponding to the requested subscribe topics.
      * 
+     * @note On a MQTT v5.0 connection these are \ref MQTTReasonCodes.
+     * 
      * @see MQTTSubackReturnCodes
      */
     const uint8_t *return_codes;
@@ -483,6 +740,12 @@ struct mqtt_response_suback {
 struct mqtt_response_unsuback {
     /** @brief The published messages packet ID. */
     uint16_t packet_id;
+
+    /** @brief The MQTT v5.0 \ref MQTTReasonCodes of the requested unsubscribe topics. */
+    const uint8_t *reason_codes;
+
+    /** @brief The number of reason codes, 0 for MQTT v3.1.1. */
+    size_t num_reason_codes;
 };
 
 /**
@@ -499,6 +762,25 @@ struct mqtt_response_pingresp {
   int dummy;
 };
 
+/**
+ * @brief A DISCONNECT sent by the broker, MQTT v5.0 only.
+ * @ingroup unpackers
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: DISCONNECT - Disconnect notification.
+ * </a> 
+ */
+struct mqtt_response_disconnect {
+    /** @brief Why the broker is closing the connection, see \ref MQTTReasonCodes. */
+    uint8_t reason_code;
+
+    /** @brief The DISCONNECT properties, see mqtt_unpack_property. */
+    const uint8_t *properties;
+
+    /** @brief The size of \c properties in bytes. */
+    size_t properties_size;
+};
+
 /**
  * @brief A struct used to deserialize/interpret an incoming packet from the broker.
  * @ingroup unpackers
@@ -525,6 +807,7 @@ struct mqtt_response {
         struct mqtt_response_suback   suback;
         struct mqtt_response_unsuback unsuback;
         struct mqtt_response_pingresp pingresp;
+        struct mqtt_response_disconnect disconnect;
     } decoded;
 };
 
@@ -646,6 +929,24 @@ ssize_t mqtt_unpack_unsuback_response(struct mqtt_response *mqtt_response, const
  */
 ssize_t mqtt_unpack_response(struct mqtt_response* response, const uint8_t *buf, size_t bufsz);
 
+/**
+ * @brief Deserialize a packet from a broker on a MQTT v5.0 connection.
+ * @ingroup unpackers
+ * 
+ * Like mqtt_unpack_response, but the variable headers are read with their MQTT v5.0 
+ * properties and reason codes, and a DISCONNECT from the broker is accepted.
+ * 
+ * @param[out] response the mqtt_response that will be initialize from \p buf.
+ * @param[in] buf the incoming data buffer.
+ * @param[in] bufsz the number of bytes available in the buffer.
+ * 
+ * @relates mqtt_response
+ * 
+ * @returns The number of bytes consumed on success, zero \p buf does not contain enough bytes
+ *          to deserialize the packet, a negative value if a protocol violation was encountered.  
+ */
+ssize_t mqtt_unpack_response5(struct mqtt_response* response, const uint8_t *buf, size_t bufsz);
+
 /* REQUESTS */
 
  /**
@@ -732,6 +1033,64 @@ ssize_t mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
                                      uint8_t connect_flags,
                                      uint16_t keep_alive);
 
+/**
+ * @brief The MQTT v5.0 properties of a CONNECT packet.
+ * @ingroup packers
+ * 
+ * Members that are 0 or \c NULL are left out of the packet.
+ */
+struct mqtt_connect_properties {
+    /** 
+     * @brief How many seconds the broker keeps the session after the connection closes, 
+     *        0xFFFFFFFF for as long as it can. 0 ends the session with the connection.
+     */
+    uint32_t session_expiry_interval;
+
+    /** 
+     * @brief How many QoS 1 and QoS 2 publishes the broker may send the client before they
+     *        are acknowledged. 0 leaves the default of 65535.
+     */
+    uint16_t receive_maximum;
+
+    /** @brief The largest packet the client accepts, in bytes. 0 for no limit. */
+    uint32_t maximum_packet_size;
+
+    /** @brief User properties sent with the CONNECT. */
+    const struct mqtt_user_property *user_properties;
+
+    /** @brief The number of \c user_properties. */
+    size_t num_user_properties;
+};
+
+/**
+ * @brief Serialize a MQTT v5.0 connection request into a buffer. 
+ * @ingroup packers
+ * 
+ * The arguments are those of mqtt_pack_connection_request, with the CONNECT 
+ * \p properties added. \c MQTT_CONNECT_CLEAN_SESSION requests a clean start. The will 
+ * message is sent without properties, and the client does not accept topic aliases from 
+ * the broker.
+ * 
+ * @param[in] properties the CONNECT properties, or \c NULL for none.
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: CONNECT - Connection Request.
+ * </a>
+ * 
+ * @returns The number of bytes put into \p buf, 0 if \p buf is too small to fit the CONNECT 
+ *          packet, a negative value if there was a protocol violation.
+ */
+ssize_t mqtt_pack_connection_request5(uint8_t* buf, size_t bufsz, 
+                                      const char* client_id,
+                                      const char* will_topic,
+                                      const void* will_message,
+                                      size_t will_message_size,
+                                      const char* user_name,
+                                      const char* password,
+                                      uint8_t connect_flags,
+                                      uint16_t keep_alive,
+                                      const struct mqtt_connect_properties *properties);
+
 /**
  * @brief An enumeration of the PUBLISH flags.
  * @ingroup packers
@@ -779,6 +1138,67 @@ ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
                                   size_t application_message_size,
                                   uint8_t publish_flags);
 
+/**
+ * @brief The MQTT v5.0 properties of a PUBLISH packet.
+ * @ingroup packers
+ * 
+ * Members that are 0 or \c NULL are left out of the packet.
+ */
+struct mqtt_publish_properties {
+    /** @brief 1 if the application message is UTF-8 encoded character data. */
+    uint8_t payload_format_indicator;
+
+    /** @brief How many seconds the broker keeps the message for subscribers that are offline. */
+    uint32_t message_expiry_interval;
+
+    /** @brief The MIME type of the application message. */
+    const char *content_type;
+
+    /** @brief The topic a response to a request message should be published on. */
+    const char *response_topic;
+
+    /** @brief Data a response to a request message should carry back. */
+    const void *correlation_data;
+
+    /** @brief The size of \c correlation_data in bytes. */
+    uint16_t correlation_data_size;
+
+    /** @brief User properties sent with the message. */
+    const struct mqtt_user_property *user_properties;
+
+    /** @brief The number of \c user_properties. */
+    size_t num_user_properties;
+};
+
+/**
+ * @brief Serialize a MQTT v5.0 PUBLISH request and put it in \p buf.
+ * @ingroup packers
+ * 
+ * The arguments are those of mqtt_pack_publish_request, with a \p topic_alias and the 
+ * PUBLISH \p properties added.
+ * 
+ * @param[in] topic_name the topic to publish the message under, or an empty string to 
+ *                       publish it under the topic \p topic_alias was set to earlier.
+ * @param[in] topic_alias the topic alias, 0 for none. If \p topic_name is not empty the
+ *                        alias is set to it for the rest of the connection.
+ * @param[in] properties the PUBLISH properties, or \c NULL for none.
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: PUBLISH - Publish message.
+ * </a>
+ * 
+ * @returns The number of bytes put into \p buf, 0 if \p buf is too small to fit the PUBLISH 
+ *          packet, a negative value if there was a protocol violation.
+ */
+ssize_t mqtt_pack_publish_request5(uint8_t *buf, size_t bufsz,
+                                   const char* topic_name,
+                                   uint16_t topic_alias,
+                                   uint16_t packet_id,
+                                   const void* application_message,
+                                   size_t application_message_size,
+                                   uint8_t publish_flags,
+                                   const struct mqtt_publish_properties *properties);
+
 /**
  * @brief Serialize a PUBACK, PUBREC, PUBREL, or PUBCOMP packet and put it in \p buf.
  * @ingroup packers
@@ -912,6 +1332,24 @@ ssize_t mqtt_pack_ping_request(uint8_t *buf, size_t bufsz);
  */
 ssize_t mqtt_pack_disconnect(uint8_t *buf, size_t bufsz);
 
+/**
+ * @brief Serialize a MQTT v5.0 DISCONNECT with a reason code and put it into \p buf.
+ * @ingroup packers
+ * 
+ * @param[out] buf the buffer to put the DISCONNECT packet in.
+ * @param[in] bufsz the maximum number of bytes that can be put into \p buf.
+ * @param[in] reason_code why the client is disconnecting, for example 
+ *                        \c MQTT_REASON_DISCONNECT_WITH_WILL_MESSAGE.
+ * 
+ * @see <a href="https://docs.oasis-open.org/mqtt/mqtt/v5.0/os/mqtt-v5.0-os.html">
+ * MQTT v5.0: DISCONNECT - Disconnect notification.
+ * </a>
+ * 
+ * @returns The number of bytes put into \p buf, 0 if \p buf is too small to fit the DISCONNECT 
+ *          packet, a negative value if there was a protocol violation.
+ */
+ssize_t mqtt_pack_disconnect5(uint8_t *buf, size_t bufsz, uint8_t reason_code);
+
 
 /**
  * @brief An enumeration of queued message states. 
@@ -1085,6 +1523,25 @@ struct mqtt_queued_message* mqtt_mq_find(const struct mqtt_message_queue *mq, en
 
 /* CLIENT */
 
+/**
+ * @brief The number of topic aliases a client sets on a MQTT v5.0 connection.
+ * @ingroup details
+ * 
+ * The first topics published to get an alias, up to the Topic Alias Maximum of the 
+ * broker, and keep it until the connection closes.
+ */
+#if !defined(MQTT_TOPIC_ALIASES)
+#define MQTT_TOPIC_ALIASES 16
+#endif
+
+/**
+ * @brief The size of the longest topic that gets an alias, including the terminating null.
+ * @ingroup details
+ */
+#if !defined(MQTT_TOPIC_ALIAS_TOPIC_SIZE)
+#define MQTT_TOPIC_ALIAS_TOPIC_SIZE 64
+#endif
+
 /**
  * @brief An MQTT client. 
  * @ingroup details
@@ -1175,6 +1632,17 @@ struct mqtt_client {
      */
     void* publish_response_callback_state;
 
+    /**
+     * @brief The callback that is called with the payload of a publish that is larger
+     *        than the receive buffer, one segment at a time.
+     * 
+     * If this is NULL such a publish sets an MQTT_ERROR_RECV_BUFFER_TOO_SMALL error.
+     * 
+     * @see mqtt_set_publish_segment_callback
+     */
+    void (*publish_segment_callback)(void** state, struct mqtt_response_publish *publish,
+                                     size_t offset, size_t total_size);
+
     /**
      * @brief A user-specified callback, triggered on each \ref mqtt_sync, allowing
      *        the user to perform state inspections (and custom socket error detection)
@@ -1222,6 +1690,36 @@ struct mqtt_client {
 
         /** @brief The number of bytes that are still writable at curr. */
         size_t curr_sz;
+
+        /** @brief The start of the first packet that has not been handled yet. */
+        uint8_t *parse;
+
+        /** 
+         * @brief The size of the fixed header of the packet at parse, or 0 if it has not
+         *        been unpacked yet.
+         */
+        size_t header_size;
+
+        /** @brief The fixed header of the packet at parse, valid when header_size is not 0. */
+        struct mqtt_fixed_header fixed_header;
+
+        /** @brief Where the payload of a publish received in segments is read to. */
+        uint8_t *segment_start;
+
+        /** 
+         * @brief The payload size of the publish being received in segments, or 0 if
+         *        there is none.
+         */
+        size_t segment_total;
+
+        /** @brief The offset in the payload of the current segment. */
+        size_t segment_offset;
+
+        /** @brief The size of the current segment, once it has been passed up. */
+        size_t segment_size;
+
+        /** @brief Set if the publish being received in segments is a QoS 2 duplicate. */
+        int segment_duplicate;
     } recv_buffer;
 
     /** 
@@ -1234,6 +1732,44 @@ struct mqtt_client {
 
     /** @brief The sending message queue. */
     struct mqtt_message_queue mq;
+
+    /** 
+     * @brief The protocol level of the connection, \c MQTT_PROTOCOL_LEVEL, or 
+     *        \c MQTT_PROTOCOL_LEVEL_5 after mqtt_connect5.
+     */
+    uint8_t protocol_level;
+
+    /**
+     * @brief What was agreed with the broker on a MQTT v5.0 connection.
+     */
+    struct {
+        /** @brief The session expiry interval, as requested or as set by the broker's CONNACK. */
+        uint32_t session_expiry_interval;
+
+        /** 
+         * @brief The Receive Maximum of the broker. No more QoS 1 and QoS 2 publishes than 
+         *        this are sent before they are acknowledged.
+         */
+        uint16_t receive_maximum;
+
+        /** @brief The Topic Alias Maximum of the broker, 0 until the CONNACK arrives. */
+        uint16_t topic_alias_maximum;
+
+        /** @brief The last failure reason code the broker sent, \c MQTT_REASON_SUCCESS if none. */
+        uint8_t reason_code;
+
+        /** @brief The number of topic aliases set, alias N is topic_aliases[N - 1]. */
+        uint16_t num_topic_aliases;
+
+        /** @brief The topics the aliases were set to. */
+        struct {
+            /** @brief strlen(topic). */
+            uint16_t length;
+
+            /** @brief The topic. */
+            char topic[MQTT_TOPIC_ALIAS_TOPIC_SIZE];
+        } topic_aliases[MQTT_TOPIC_ALIASES];
+    } v5;
 };
 
 /**
@@ -1427,6 +1963,36 @@ void mqtt_reinit(struct mqtt_client* client,
                  uint8_t *sendbuf, size_t sendbufsz,
                  uint8_t *recvbuf, size_t recvbufsz);
 
+/**
+ * @brief Receive publishes that are larger than the receive buffer in segments.
+ * @ingroup api
+ * 
+ * Publishes that fit in the receive buffer are still passed whole to the 
+ * publish_response_callback. For a larger publish, the topic and packet ID are kept
+ * at the start of the receive buffer and the payload is read into the rest of it.
+ * Each time that space fills up, or the end of the payload arrives, 
+ * \p publish_segment_callback is called with \c application_message pointing at the 
+ * segment in the receive buffer and \c application_message_size set to its size.
+ * \p offset is where the segment starts in the payload and \p total_size is the size of
+ * the whole payload. The publish is acknowledged after its last segment.
+ * 
+ * @pre None.
+ * 
+ * @param[in,out] client The MQTT client.
+ * @param[in] publish_segment_callback The callback, or NULL to fail such publishes with
+ *            an MQTT_ERROR_RECV_BUFFER_TOO_SMALL error.
+ * 
+ * @note A pointer to \ref mqtt_client.publish_response_callback_state is passed as the
+ *       \c state argument to \p publish_segment_callback.
+ * @note The topic and packet ID must fit in the receive buffer with room to spare.
+ * @note Like \ref mqtt_client.inspector_callback this is not protected by the client's
+ *       mutex. Set it before \ref mqtt_connect is called.
+ */
+void mqtt_set_publish_segment_callback(struct mqtt_client *client,
+                                       void (*publish_segment_callback)(void** state,
+                                           struct mqtt_response_publish *publish,
+                                           size_t offset, size_t total_size));
+
 /**
  * @brief Establishes a session with the MQTT broker.
  * @ingroup api
@@ -1463,6 +2029,40 @@ enum MQTTErrors mqtt_connect(struct mqtt_client *client,
                              uint8_t connect_flags,
                              uint16_t keep_alive);
 
+/**
+ * @brief Establishes a MQTT v5.0 session with the MQTT broker.
+ * @ingroup api
+ * 
+ * The arguments are those of mqtt_connect, with the CONNECT \p properties added. Every
+ * later packet of the connection uses the MQTT v5.0 framing:
+ *  - mqtt_publish and mqtt_publish5 publish each topic under a topic alias once the 
+ *    broker allows them, up to \c MQTT_TOPIC_ALIASES topics, so the topic string is 
+ *    only sent the first time.
+ *  - No more QoS 1 and QoS 2 publishes than the broker's Receive Maximum are in flight; 
+ *    the rest wait in the send buffer.
+ *  - The session expiry interval, Receive Maximum, Topic Alias Maximum and Server Keep 
+ *    Alive the broker returns in its CONNACK are applied.
+ *  - Failure reason codes in acknowledgements are kept in 
+ *    \ref mqtt_client.v5 \c .reason_code. A refused publish is not retried.
+ *  - A DISCONNECT from the broker sets \c MQTT_ERROR_CONNECTION_CLOSED.
+ * 
+ * @pre mqtt_init must have been called.
+ * 
+ * @param[in] properties The CONNECT properties, or \c NULL for none.
+ * 
+ * @returns \c MQTT_OK upon success, an \ref MQTTErrors otherwise.
+ */
+enum MQTTErrors mqtt_connect5(struct mqtt_client *client,
+                              const char* client_id,
+                              const char* will_topic,
+                              const void* will_message,
+                              size_t will_message_size,
+                              const char* user_name,
+                              const char* password,
+                              uint8_t connect_flags,
+                              uint16_t keep_alive,
+                              const struct mqtt_connect_properties *properties);
+
 /* 
     todo: will_message should be a void*
 */
@@ -1491,6 +2091,26 @@ enum MQTTErrors mqtt_publish(struct mqtt_client *client,
                              size_t application_message_size,
                              uint8_t publish_flags);
 
+/**
+ * @brief Publish an application message with MQTT v5.0 properties.
+ * @ingroup api
+ * 
+ * The arguments are those of mqtt_publish, with the PUBLISH \p properties added.
+ * 
+ * @pre mqtt_connect or mqtt_connect5 must have been called. On a connection made with
+ *      mqtt_connect the \p properties are not sent.
+ * 
+ * @param[in] properties The PUBLISH properties, or \c NULL for none.
+ * 
+ * @returns \c MQTT_OK upon success, an \ref MQTTErrors otherwise.
+ */
+enum MQTTErrors mqtt_publish5(struct mqtt_client *client,
+                              const char* topic_name,
+                              const void* application_message,
+                              size_t application_message_size,
+                              uint8_t publish_flags,
+                              const struct mqtt_publish_properties *properties);
+
 /**
  * @brief Acknowledge an ingree publish with QOS==1.
  * @ingroup details
@@ -1599,6 +2219,21 @@ enum MQTTErrors __mqtt_ping(struct mqtt_client *client);
  */
 enum MQTTErrors mqtt_disconnect(struct mqtt_client *client);
 
+/**
+ * @brief Terminates the MQTT v5.0 session with the MQTT broker, giving a reason.
+ * @ingroup api
+ * 
+ * @param[in,out] client The MQTT client.
+ * @param[in] reason_code Why the client is disconnecting, for example 
+ *            \c MQTT_REASON_DISCONNECT_WITH_WILL_MESSAGE to have the broker publish the 
+ *            will message.
+ * 
+ * @pre mqtt_connect5 must have been called.
+ * 
+ * @returns \c MQTT_OK upon success, an \ref MQTTErrors otherwise.
+ */
+enum MQTTErrors mqtt_disconnect5(struct mqtt_client *client, uint8_t reason_code);
+
 /**
  * @brief Terminate the session with the MQTT broker and prepare to
  * reconnect. Client code should call \ref mqtt_sync immediately 
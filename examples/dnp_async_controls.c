@@ -0,0 +1,533 @@
+/**
+ * @file
+ * Checks the operate responses an outstation holds while its database
+ * completes controls asynchronously.
+ *
+ * The outstation runs in this process with its channel on an in-memory
+ * physical layer, as in dnp_file_transfers. Direct operate requests are
+ * built as a master would send them and handed to dnplink_parseBytes, and
+ * the responses are reassembled from the transmitted frames.
+ *
+ * Binary outputs 1 to 3 and analog output 0 of the simulated database are
+ * put in TMWSIM_TESTINGMODE_OPERATEFAIL with a status of ASYNC, so
+ * sdnpdata_binOutOperate and sdnpdata_anlgOutOperate accept their controls
+ * and leave the result to sdnpsesn_controlComplete. Binary output 4 fails
+ * at once with LOCAL, and binary output 5 is also ASYNC but reports its
+ * result from inside sdnpdata_binOutOperate, through a wrapper the linker
+ * puts in front of sdnpsim_binOutOperate.
+ *
+ * It checks that:
+ *   - a control completed from another thread releases the response
+ *   - a control that never completes is reported as HARDWARE_ERROR once
+ *     asyncControlTimeout passes
+ *   - a retry of the request is answered by the held response
+ *   - a different request discards the held response
+ *   - a request mixing synchronous and asynchronous controls, in both
+ *     object groups, is answered once with every status in place
+ *   - a result reported inside the operate call is used, not timed out
+ *
+ * Usage:
+ *   dnp_async_controls
+ *
+ * Exits with failure if any check fails.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/utils/tmwpltmr.h"
+#include "tmwscl/utils/tmwsim.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnplink.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define MASTER_ADDR       3
+#define OUTSTATION_ADDR   4
+#define MAX_FRAME         292
+#define MAX_FRAGMENT      2048
+#define ASYNC_TIMEOUT_MS  200
+#define COMPLETE_DELAY_US 20000
+
+/* Binary outputs */
+#define SYNC_POINT        0
+#define ASYNC_POINT_1     1
+#define ASYNC_POINT_2     2
+#define ASYNC_POINT_3     3
+#define LOCAL_POINT       4
+#define EARLY_POINT       5
+#define NUM_BIN_OUTS      6
+
+/* Analog output */
+#define ASYNC_ANALOG      0
+
+/* Object sizes, after the index */
+#define CROB_SIZE         12
+#define ANALOG_SIZE       4
+
+struct outstation_t {
+    TMWCHNL* channel;
+    TMWSESN* session;
+    void* db;
+    uint8_t app_seq;
+    uint8_t tprt_seq;
+
+    /* Last response fragment, reassembled by the in-memory transmit */
+    uint8_t response[MAX_FRAGMENT];
+    size_t response_len;
+    int responses;
+
+    /* Set by the wrapper when it reports EARLY_POINT from inside the operate */
+    int early_reported;
+};
+
+static struct outstation_t outstation;
+
+/* ---- Database ---- */
+
+DNPDEFS_CROB_ST TMWDEFS_GLOBAL __real_sdnpsim_binOutOperate(void* pPoint, TMWTYPES_UCHAR control,
+                                                            TMWTYPES_UCHAR count, TMWTYPES_ULONG onTime,
+                                                            TMWTYPES_ULONG offTime);
+
+DNPDEFS_CROB_ST TMWDEFS_GLOBAL __wrap_sdnpsim_binOutOperate(void* pPoint, TMWTYPES_UCHAR control,
+                                                            TMWTYPES_UCHAR count, TMWTYPES_ULONG onTime,
+                                                            TMWTYPES_ULONG offTime);
+
+/**
+ * @brief Operate a simulated binary output, reporting the result of
+ *        EARLY_POINT before returning ASYNC for it.
+ */
+DNPDEFS_CROB_ST TMWDEFS_GLOBAL __wrap_sdnpsim_binOutOperate(void* pPoint, TMWTYPES_UCHAR control,
+                                                            TMWTYPES_UCHAR count, TMWTYPES_ULONG onTime,
+                                                            TMWTYPES_ULONG offTime)
+{
+    DNPDEFS_CROB_ST status = __real_sdnpsim_binOutOperate(pPoint, control, count, onTime, offTime);
+
+    if (status == DNPDEFS_CROB_ST_ASYNC && tmwsim_getPointNumber((TMWSIM_POINT*)pPoint) == EARLY_POINT) {
+        outstation.early_reported = sdnpsesn_controlComplete(outstation.session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS,
+                                                             EARLY_POINT, DNPDEFS_CROB_ST_SUCCESS);
+    }
+    return status;
+}
+
+static int setup_points(struct outstation_t* os)
+{
+    TMWSIM_POINT* point;
+    int i;
+
+    for (i = sdnpsim_binOutQuantity(os->db); i < NUM_BIN_OUTS; i++) {
+        sdnpsim_addBinaryOutput(os->db, TMWDEFS_CLASS_MASK_NONE, 0x01, TMWDEFS_FALSE, 0xff);
+    }
+    if (sdnpsim_anlgOutQuantity(os->db) == 0) {
+        sdnpsim_addAnalogOutput(os->db, TMWDEFS_CLASS_MASK_NONE, 0x01, 0);
+    }
+
+    /* In OPERATEFAIL a binary output returns its flags as the CROB status */
+    for (i = ASYNC_POINT_1; i < NUM_BIN_OUTS; i++) {
+        point = (TMWSIM_POINT*)sdnpsim_binOutGetPoint(os->db, (TMWTYPES_USHORT)i);
+        if (point == TMWDEFS_NULL) return -1;
+        tmwsim_setTestingMode(point, TMWSIM_TESTINGMODE_OPERATEFAIL);
+        tmwsim_setFlags(point, (i == LOCAL_POINT) ? DNPDEFS_CROB_ST_LOCAL : DNPDEFS_CROB_ST_ASYNC,
+                        TMWDEFS_CHANGE_NONE);
+    }
+
+    /* and an analog output its value */
+    point = (TMWSIM_POINT*)sdnpsim_anlgOutGetPoint(os->db, ASYNC_ANALOG);
+    if (point == TMWDEFS_NULL) return -1;
+    tmwsim_setTestingMode(point, TMWSIM_TESTINGMODE_OPERATEFAIL);
+    tmwsim_setAnalogValue(point, DNPDEFS_CTLSTAT_ASYNC, TMWDEFS_CHANGE_NONE);
+    return 0;
+}
+
+/* ---- Outstation ---- */
+
+/**
+ * @brief Strip the link header and CRCs from a transmitted frame and add
+ *        its transport segment to the response fragment.
+ */
+static void collect_response(void* param, const uint8_t* frame, size_t len)
+{
+    struct outstation_t* os = (struct outstation_t*)param;
+    uint8_t user[256];
+    size_t user_len, pos, in = 10;
+
+    TMWTARG_UNUSED_PARAM(len);
+
+    /* Frames without user data are link layer only */
+    user_len = (frame[2] > 5) ? (size_t)frame[2] - 5 : 0;
+    for (pos = 0; pos < user_len; pos += 16) {
+        size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+        memcpy(user + pos, frame + in, block);
+        in += block + 2;
+    }
+    if (user_len > 1) {
+        if (user[0] & 0x40) os->response_len = 0;
+        if (os->response_len + user_len - 1 <= sizeof os->response) {
+            memcpy(os->response + os->response_len, user + 1, user_len - 1);
+            os->response_len += user_len - 1;
+        }
+        if (user[0] & 0x80) os->responses++;
+    }
+}
+
+static int open_outstation(struct outstation_t* os)
+{
+    struct outstation_config_t config;
+    TMWAPPL* appl = start_scl();
+
+    os->channel = open_mem_channel(appl, &config, "async");
+    if (os->channel == TMWDEFS_NULL) return -1;
+    mem_tx_handler = collect_response;
+    mem_tx_param = os;
+
+    config.sesn.source = OUTSTATION_ADDR;
+    config.sesn.destination = MASTER_ADDR;
+    config.sesn.asyncControlTimeout = ASYNC_TIMEOUT_MS;
+    os->session = sdnpsesn_openSession(os->channel, &config.sesn, TMWDEFS_NULL);
+    if (os->session == TMWDEFS_NULL) return -1;
+    os->db = ((SDNPSESN*)os->session)->pDbHandle;
+
+    tmwlink_openChannel((TMWLINK_CONTEXT*)os->channel->pLinkContext);
+    return setup_points(os);
+}
+
+/* ---- Master side ---- */
+
+/**
+ * @brief A direct operate request, built up one object at a time.
+ */
+struct request_t {
+    uint8_t app[MAX_FRAGMENT];
+    size_t len;
+};
+
+static void start_request(struct outstation_t* os, struct request_t* req)
+{
+    req->app[0] = (uint8_t)(0xC0 | os->app_seq);    /* FIR | FIN */
+    req->app[1] = DNPDEFS_FC_DIRECT_OP;
+    req->len = 2;
+    os->app_seq = (uint8_t)((os->app_seq + 1) & 0x0f);
+}
+
+static void put32(uint8_t* p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Add object 12 variation 1 latching on each of points.
+ */
+static void add_crobs(struct request_t* req, const uint8_t* points, int count)
+{
+    uint8_t* p = req->app + req->len;
+    int i;
+
+    *p++ = DNPDEFS_OBJ_12_BIN_OUT_CTRLS;
+    *p++ = 1;
+    *p++ = DNPDEFS_QUAL_8BIT_INDEX;
+    *p++ = (uint8_t)count;
+    for (i = 0; i < count; i++) {
+        *p++ = points[i];
+        *p++ = DNPDEFS_CROB_CTRL_LATCH_ON;
+        *p++ = 1;
+        put32(p, 100);
+        put32(p + 4, 100);
+        p += 8;
+        *p++ = 0;
+    }
+    req->len = (size_t)(p - req->app);
+}
+
+/**
+ * @brief Add object 41 variation 2 setting point to value.
+ */
+static void add_analog(struct request_t* req, uint8_t point, uint16_t value)
+{
+    uint8_t* p = req->app + req->len;
+
+    *p++ = DNPDEFS_OBJ_41_ANA_OUT_CTRLS;
+    *p++ = 2;
+    *p++ = DNPDEFS_QUAL_8BIT_INDEX;
+    *p++ = 1;
+    *p++ = point;
+    *p++ = (uint8_t)value;
+    *p++ = (uint8_t)(value >> 8);
+    *p++ = 0;
+    req->len = (size_t)(p - req->app);
+}
+
+/**
+ * @brief Send an application fragment to the outstation in one frame.
+ */
+static void send_request(struct outstation_t* os, const struct request_t* req)
+{
+    uint8_t frame[MAX_FRAME];
+    uint8_t user[MAX_FRAME];
+    size_t user_len = req->len + 1;
+    size_t frame_len = 10, block_pos;
+    uint16_t crc;
+
+    user[0] = (uint8_t)(0xC0 | os->tprt_seq);
+    os->tprt_seq = (uint8_t)((os->tprt_seq + 1) & 0x3f);
+    memcpy(user + 1, req->app, req->len);
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = (uint8_t)(5 + user_len);
+    frame[3] = 0xC4;    /* DIR | PRM | UNCONFIRMED USER DATA */
+    frame[4] = OUTSTATION_ADDR & 0xff;
+    frame[5] = OUTSTATION_ADDR >> 8;
+    frame[6] = MASTER_ADDR & 0xff;
+    frame[7] = MASTER_ADDR >> 8;
+    crc = dnplink_computeCRC(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+
+    for (block_pos = 0; block_pos < user_len; block_pos += 16) {
+        size_t block = (user_len - block_pos < 16) ? user_len - block_pos : 16;
+        memcpy(frame + frame_len, user + block_pos, block);
+        crc = dnplink_computeCRC(user + block_pos, (TMWTYPES_USHORT)block);
+        frame_len += block;
+        frame[frame_len++] = (uint8_t)(crc & 0xff);
+        frame[frame_len++] = (uint8_t)(crc >> 8);
+    }
+    feed_link(os->channel, frame, frame_len);
+}
+
+/**
+ * @brief The status of the control at offset in the request, as echoed in
+ *        the last response, or -1 if the response is not to that request.
+ */
+static int response_status(const struct outstation_t* os, const struct request_t* req, size_t offset)
+{
+    if (os->response_len != req->len + 2 || os->response[1] != DNPDEFS_FC_RESPONSE
+        || (os->response[0] & 0x0f) != (req->app[0] & 0x0f)) {
+        return -1;
+    }
+    return os->response[offset + 2];
+}
+
+/* Offset of the status of the index'th CROB in an object starting at object */
+#define CROB_STATUS(object, index) ((object) + 4 + (size_t)(index) * CROB_SIZE + 11)
+
+/* Offset of the status of the analog output in an object starting at object */
+#define ANALOG_STATUS(object) ((object) + 4 + ANALOG_SIZE - 1)
+
+/* ---- Checks ---- */
+
+static int failures;
+
+static void check(int ok, const char* what)
+{
+    printf("%-60s %s\n", what, ok ? "ok" : "FAILED");
+    if (!ok) failures++;
+}
+
+struct completion_t {
+    TMWTYPES_USHORT point;
+    TMWTYPES_UCHAR status;
+    TMWTYPES_BOOL found;
+    int responses_before;
+};
+
+static void* complete_later(void* param)
+{
+    struct completion_t* completion = (struct completion_t*)param;
+
+    usleep(COMPLETE_DELAY_US);
+    completion->responses_before = outstation.responses;
+    completion->found = sdnpsesn_controlComplete(outstation.session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS,
+                                                 completion->point, completion->status);
+    return NULL;
+}
+
+static void check_other_thread(struct outstation_t* os)
+{
+    struct request_t req;
+    struct completion_t completion;
+    pthread_t thread;
+    uint8_t point = ASYNC_POINT_1;
+    int responses = os->responses;
+    uint64_t start;
+
+    start_request(os, &req);
+    add_crobs(&req, &point, 1);
+    send_request(os, &req);
+    check(os->responses == responses, "response held while a control is executing");
+
+    completion.point = ASYNC_POINT_1;
+    completion.status = DNPDEFS_CROB_ST_SUCCESS;
+    start = now_us();
+    pthread_create(&thread, NULL, complete_later, &completion);
+    pthread_join(thread, NULL);
+
+    check(completion.found && completion.responses_before == responses && os->responses == responses + 1,
+          "completion from another thread sends the response");
+    check(response_status(os, &req, CROB_STATUS(2, 0)) == DNPDEFS_CROB_ST_SUCCESS
+              && now_us() - start >= COMPLETE_DELAY_US,
+          "response carries the reported status");
+}
+
+static void check_timeout(struct outstation_t* os)
+{
+    struct request_t req;
+    uint8_t point = ASYNC_POINT_2;
+    int responses = os->responses;
+    uint64_t start = now_us();
+
+    start_request(os, &req);
+    add_crobs(&req, &point, 1);
+    send_request(os, &req);
+    while (os->responses == responses && now_us() - start < 10u * ASYNC_TIMEOUT_MS * 1000u) {
+        tmwtarg_sleep(10);
+        tmwpltmr_checkTimer();
+    }
+
+    check(os->responses == responses + 1 && now_us() - start >= ASYNC_TIMEOUT_MS * 1000u,
+          "response sent once asyncControlTimeout passes");
+    check(response_status(os, &req, CROB_STATUS(2, 0)) == DNPDEFS_CTLSTAT_HARDWARE_ERROR,
+          "control that never completed reported as HARDWARE_ERROR");
+    check(!sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, ASYNC_POINT_2,
+                                    DNPDEFS_CROB_ST_SUCCESS),
+          "late completion after the timeout is ignored");
+}
+
+static void check_retry(struct outstation_t* os)
+{
+    struct request_t req;
+    uint8_t point = ASYNC_POINT_3;
+    int responses = os->responses;
+
+    start_request(os, &req);
+    add_crobs(&req, &point, 1);
+    send_request(os, &req);
+    send_request(os, &req);
+    check(os->responses == responses, "retry of the request does not discard the held response");
+
+    check(sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, ASYNC_POINT_3,
+                                   DNPDEFS_CROB_ST_SUCCESS)
+              && os->responses == responses + 1
+              && response_status(os, &req, CROB_STATUS(2, 0)) == DNPDEFS_CROB_ST_SUCCESS,
+          "retry answered once by the held response");
+}
+
+static void check_discard(struct outstation_t* os)
+{
+    struct request_t held, other;
+    uint8_t async_point = ASYNC_POINT_1;
+    uint8_t sync_point = SYNC_POINT;
+    int responses = os->responses;
+
+    start_request(os, &held);
+    add_crobs(&held, &async_point, 1);
+    send_request(os, &held);
+
+    start_request(os, &other);
+    add_crobs(&other, &sync_point, 1);
+    send_request(os, &other);
+
+    check(os->responses == responses + 1
+              && response_status(os, &other, CROB_STATUS(2, 0)) == DNPDEFS_CROB_ST_SUCCESS,
+          "different request is answered");
+    check(!sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, ASYNC_POINT_1,
+                                    DNPDEFS_CROB_ST_SUCCESS)
+              && os->responses == responses + 1,
+          "different request discards the held response");
+}
+
+static void check_mixed(struct outstation_t* os)
+{
+    struct request_t req;
+    uint8_t points[] = { SYNC_POINT, ASYNC_POINT_1, LOCAL_POINT, ASYNC_POINT_2 };
+    size_t analog_object;
+    int responses = os->responses;
+    int ok;
+
+    start_request(os, &req);
+    add_crobs(&req, points, 4);
+    analog_object = req.len;
+    add_analog(&req, ASYNC_ANALOG, 1234);
+    send_request(os, &req);
+
+    ok = os->responses == responses;
+    ok = ok && sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, ASYNC_POINT_2,
+                                        DNPDEFS_CROB_ST_NOT_SUPPORTED);
+    ok = ok && sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, ASYNC_POINT_1,
+                                        DNPDEFS_CROB_ST_SUCCESS);
+    ok = ok && os->responses == responses;
+    check(ok, "mixed request held until its last control completes");
+
+    check(sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_41_ANA_OUT_CTRLS, ASYNC_ANALOG,
+                                   DNPDEFS_CTLSTAT_SUCCESS)
+              && os->responses == responses + 1,
+          "analog output completion sends the response");
+    check(response_status(os, &req, CROB_STATUS(2, 0)) == DNPDEFS_CROB_ST_SUCCESS
+              && response_status(os, &req, CROB_STATUS(2, 1)) == DNPDEFS_CROB_ST_SUCCESS
+              && response_status(os, &req, CROB_STATUS(2, 2)) == DNPDEFS_CROB_ST_LOCAL
+              && response_status(os, &req, CROB_STATUS(2, 3)) == DNPDEFS_CROB_ST_NOT_SUPPORTED
+              && response_status(os, &req, ANALOG_STATUS(analog_object)) == DNPDEFS_CTLSTAT_SUCCESS,
+          "mixed response has every status in place");
+}
+
+static void check_early(struct outstation_t* os)
+{
+    struct request_t req;
+    uint8_t early = EARLY_POINT;
+    uint8_t points[] = { EARLY_POINT, ASYNC_POINT_3 };
+    int responses = os->responses;
+
+    os->early_reported = 0;
+    start_request(os, &req);
+    add_crobs(&req, &early, 1);
+    send_request(os, &req);
+    check(os->early_reported && os->responses == responses + 1
+              && response_status(os, &req, CROB_STATUS(2, 0)) == DNPDEFS_CROB_ST_SUCCESS,
+          "result reported inside the operate call is sent at once");
+
+    os->early_reported = 0;
+    start_request(os, &req);
+    add_crobs(&req, points, 2);
+    send_request(os, &req);
+    check(os->early_reported && os->responses == responses + 1,
+          "result reported inside the operate call, response still held");
+    check(sdnpsesn_controlComplete(os->session, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, ASYNC_POINT_3,
+                                   DNPDEFS_CROB_ST_SUCCESS)
+              && os->responses == responses + 2
+              && response_status(os, &req, CROB_STATUS(2, 0)) == DNPDEFS_CROB_ST_SUCCESS
+              && response_status(os, &req, CROB_STATUS(2, 1)) == DNPDEFS_CROB_ST_SUCCESS,
+          "then sent with both results once the other control completes");
+}
+
+int main(void)
+{
+    memset(&outstation, 0, sizeof outstation);
+    if (open_outstation(&outstation) != 0) {
+        fprintf(stderr, "error: failed to open the outstation\n");
+        exit(EXIT_FAILURE);
+    }
+
+    check_other_thread(&outstation);
+    check_timeout(&outstation);
+    check_retry(&outstation);
+    check_discard(&outstation);
+    check_mixed(&outstation);
+    check_early(&outstation);
+
+    if (failures != 0) {
+        printf("error: %d checks failed\n", failures);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,460 @@
+/**
+ * @file
+ * Microbenchmarks for the DNP3 outstation link, transport and object
+ * codecs.
+ *
+ * The outstation runs in this process on the simulated database. Its
+ * channel uses an in-memory physical layer in place of tmwphys, so no
+ * sockets are opened: requests are handed straight to dnplink_parseBytes
+ * and responses are counted and dropped by the in-memory transmit.
+ *
+ * Each benchmark repeats one operation for a fixed time and prints the
+ * nanoseconds per operation and the bytes per second it processed:
+ *   - dnplink CRC compute and check on header and data block sizes
+ *   - dnplink_parseBytes on a maximum size frame, fed whole and a byte at
+ *     a time, with the transport layer stubbed out
+ *   - dnptprt_parseFrame reassembling a fragment, with the application
+ *     layer stubbed out
+ *   - whole requests through sdnpsesn for the common READ qualifier forms
+ *   - static reads using the sdnpo030 encoders, and event reads using the
+ *     sdnpo002 and sdnpo032 encoders; events are not confirmed so each
+ *     read sends the same events again
+ * The byte counts for whole requests are the response bytes transmitted.
+ *
+ * Usage:
+ *   dnp_codec_bench [-t msPerBenchmark] [-f nameFilter] [-a]
+ *
+ * The analog input event reads only run with -a, since sdnpo032_addEvent
+ * also publishes each event to the MQTT broker and exits if it cannot
+ * connect to it.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/utils/tmwpltmr.h"
+#include "tmwscl/utils/tmwsim.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnplink.h"
+#include "tmwscl/dnp/dnptprt.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnputil.h"
+#include "tmwscl/dnp/sdnpo002.h"
+#include "tmwscl/dnp/sdnpo032.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define MASTER_ADDR      3
+#define OUTSTATION_ADDR  4
+#define NUM_POINTS       100
+#define NUM_SEGMENTS     8
+#define MAX_FRAME        292
+
+struct bench_t {
+    TMWCHNL* channel;
+    TMWSESN* session;
+    void* db;
+
+    /* Counted by the in-memory physical layer */
+    unsigned long tx_bytes;
+    unsigned long tx_frames;
+
+    /* Counted by the stubbed upper layers */
+    unsigned long frames_parsed;
+    unsigned long fragments_parsed;
+
+    /* Canned input for the current benchmark */
+    uint8_t input[16][MAX_FRAME];
+    size_t input_len[16];
+    int num_inputs;
+    int next_input;
+    TMWSESN_RX_DATA segments[NUM_SEGMENTS];
+    uint8_t segment_data[NUM_SEGMENTS][250];
+};
+
+typedef void (*bench_func_t)(struct bench_t* bench);
+
+static const char* name_filter = NULL;
+static long bench_ms = 200;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* ---- Outstation ---- */
+
+static struct bench_t* mem_bench;
+
+/**
+ * @brief Count what the outstation sends.
+ */
+static void count_tx(void* param, const uint8_t* frame, size_t len)
+{
+    struct bench_t* bench = (struct bench_t*)param;
+    TMWTARG_UNUSED_PARAM(frame);
+    bench->tx_bytes += len;
+    bench->tx_frames++;
+}
+
+/**
+ * @brief Open an outstation channel on the in-memory physical layer and
+ *        a session with NUM_POINTS binary and analog inputs.
+ */
+static int open_outstation(struct bench_t* bench)
+{
+    struct outstation_config_t config;
+    TMWAPPL* appl;
+    int i;
+
+    appl = start_scl();
+    bench->channel = open_mem_channel(appl, &config, "bench");
+    if (bench->channel == TMWDEFS_NULL) return -1;
+    mem_bench = bench;
+    mem_tx_handler = count_tx;
+    mem_tx_param = bench;
+
+    config.sesn.source = OUTSTATION_ADDR;
+    config.sesn.destination = MASTER_ADDR;
+    config.sesn.binaryInputMaxEvents = NUM_POINTS;
+    config.sesn.analogInputMaxEvents = NUM_POINTS;
+    config.sesn.analogInputScanPeriod = 1;
+
+    bench->session = sdnpsesn_openSession(bench->channel, &config.sesn, TMWDEFS_NULL);
+    if (bench->session == TMWDEFS_NULL) return -1;
+    bench->db = ((SDNPSESN*)bench->session)->pDbHandle;
+
+    for (i = sdnpsim_binInQuantity(bench->db); i < NUM_POINTS; i++) {
+        sdnpsim_addBinaryInput(bench->db, TMWDEFS_CLASS_MASK_ONE, 0x01, TMWDEFS_FALSE);
+    }
+    for (i = sdnpsim_anlgInQuantity(bench->db); i < NUM_POINTS; i++) {
+        sdnpsim_addAnalogInput(bench->db, TMWDEFS_CLASS_MASK_TWO, 0x01, 0, 0);
+    }
+
+    tmwlink_openChannel((TMWLINK_CONTEXT*)bench->channel->pLinkContext);
+    return 0;
+}
+
+/**
+ * @brief Build a single frame request from the master, with the
+ *        transport header \p tprt.
+ *
+ * @returns the frame length.
+ */
+static size_t build_frame(uint8_t* frame, uint8_t tprt, const uint8_t* app, size_t app_len)
+{
+    uint8_t user[250];
+    size_t user_len = app_len + 1;
+    size_t pos, frame_len = 10;
+    uint16_t crc;
+
+    user[0] = tprt;
+    memcpy(user + 1, app, app_len);
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = (uint8_t)(5 + user_len);
+    frame[3] = 0xC4;    /* DIR | PRM | UNCONFIRMED USER DATA */
+    frame[4] = OUTSTATION_ADDR & 0xff;
+    frame[5] = OUTSTATION_ADDR >> 8;
+    frame[6] = MASTER_ADDR & 0xff;
+    frame[7] = MASTER_ADDR >> 8;
+    crc = dnplink_computeCRC(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+
+    for (pos = 0; pos < user_len; pos += 16) {
+        size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+        memcpy(frame + frame_len, user + pos, block);
+        crc = dnplink_computeCRC(user + pos, (TMWTYPES_USHORT)block);
+        frame_len += block;
+        frame[frame_len++] = (uint8_t)(crc & 0xff);
+        frame[frame_len++] = (uint8_t)(crc >> 8);
+    }
+    return frame_len;
+}
+
+/**
+ * @brief Prepare a request for every application sequence number, so the
+ *        outstation never sees a repeated request.
+ */
+static void set_request(struct bench_t* bench, uint8_t function, const uint8_t* objects, size_t len)
+{
+    uint8_t app[64];
+    int seq;
+
+    for (seq = 0; seq < 16; seq++) {
+        app[0] = (uint8_t)(0xC0 | seq);    /* FIR | FIN */
+        app[1] = function;
+        memcpy(app + 2, objects, len);
+        bench->input_len[seq] = build_frame(bench->input[seq], (uint8_t)(0xC0 | seq), app, len + 2);
+    }
+    bench->num_inputs = 16;
+    bench->next_input = 0;
+}
+
+static void parse_next_input(struct bench_t* bench)
+{
+    int i = bench->next_input;
+
+    bench->next_input = (i + 1) % bench->num_inputs;
+    feed_link(bench->channel, bench->input[i], bench->input_len[i]);
+}
+
+/* ---- Benchmarks ---- */
+
+static TMWTYPES_UCHAR crc_block[18];
+
+static void bench_crc_header(struct bench_t* bench)
+{
+    (void)bench;
+    crc_block[0] ^= (TMWTYPES_UCHAR)dnplink_computeCRC(crc_block, 8);
+}
+
+static void bench_crc_block(struct bench_t* bench)
+{
+    (void)bench;
+    crc_block[0] ^= (TMWTYPES_UCHAR)dnplink_computeCRC(crc_block, 16);
+}
+
+static void bench_crc_check(struct bench_t* bench)
+{
+    bench->frames_parsed += dnplink_checkCRC(crc_block, 18);
+}
+
+static void TMWDEFS_CALLBACK count_frame(void* pParam, TMWSESN* pSession, TMWSESN_RX_DATA* pRxData)
+{
+    TMWTARG_UNUSED_PARAM(pParam);
+    TMWTARG_UNUSED_PARAM(pSession);
+    TMWTARG_UNUSED_PARAM(pRxData);
+    mem_bench->frames_parsed++;
+}
+
+static void bench_link_whole(struct bench_t* bench)
+{
+    parse_next_input(bench);
+}
+
+static void bench_link_bytewise(struct bench_t* bench)
+{
+    size_t i;
+
+    for (i = 0; i < bench->input_len[0]; i++) {
+        dnplink_parseBytes(bench->channel->pLinkContext, &bench->input[0][i], 1, 0);
+    }
+}
+
+static void TMWDEFS_CALLBACK count_fragment(TMWSESN* pSession, TMWSESN_RX_DATA* pRxData)
+{
+    TMWTARG_UNUSED_PARAM(pSession);
+    TMWTARG_UNUSED_PARAM(pRxData);
+    mem_bench->fragments_parsed++;
+}
+
+static void bench_tprt_single(struct bench_t* bench)
+{
+    dnptprt_parseFrame(bench->channel->pTprtContext, bench->session, &bench->segments[NUM_SEGMENTS - 1]);
+}
+
+static void bench_tprt_reassembly(struct bench_t* bench)
+{
+    int i;
+
+    for (i = 0; i < NUM_SEGMENTS - 1; i++) {
+        dnptprt_parseFrame(bench->channel->pTprtContext, bench->session, &bench->segments[i]);
+    }
+}
+
+/**
+ * @brief Run \p func for bench_ms and print the time per operation.
+ *
+ * @param bytes the bytes processed per operation, or 0 to count the bytes
+ *        transmitted.
+ */
+static void run(struct bench_t* bench, const char* name, bench_func_t func, double bytes)
+{
+    uint64_t start, elapsed, deadline;
+    unsigned long ops = 0, batch = 1, tx_bytes;
+
+    if (name_filter != NULL && strstr(name, name_filter) == NULL) return;
+
+    /* Warm up and check the operation does something */
+    bench->tx_bytes = 0;
+    func(bench);
+    tx_bytes = bench->tx_bytes;
+
+    start = now_ns();
+    deadline = start + (uint64_t)bench_ms * 1000000u;
+    bench->tx_bytes = 0;
+    do {
+        unsigned long i;
+        for (i = 0; i < batch; i++) func(bench);
+        ops += batch;
+        if (batch < 1u << 20) batch *= 2;
+        elapsed = now_ns() - start;
+    } while (now_ns() < deadline);
+
+    if (bytes == 0) {
+        bytes = (double)bench->tx_bytes / (double)ops;
+        if (tx_bytes == 0) {
+            printf("%-34s no response\n", name);
+            return;
+        }
+    }
+    printf("%-34s %10lu %10.1f ns/op %9.1f MB/s\n", name, ops, (double)elapsed / (double)ops,
+           bytes * (double)ops * 1000.0 / (double)elapsed);
+}
+
+static void run_read(struct bench_t* bench, const char* name, const uint8_t* objects, size_t len)
+{
+    set_request(bench, 0x01, objects, len);
+    run(bench, name, parse_next_input, 0);
+}
+
+int main(int argc, char* argv[])
+{
+    static struct bench_t bench;
+    DNPLINK_CONTEXT* link;
+    DNPTPRT_CONTEXT* tprt;
+    TMWLINK_PARSE_FUNC link_parse;
+    TMWTPRT_PARSE_FUNC tprt_parse;
+    uint8_t user[250];
+    TMWDTIME time_stamp;
+    int analog_events = 0;
+    int opt, i;
+
+    while ((opt = getopt(argc, argv, "t:f:a")) != -1) {
+        switch (opt) {
+        case 't': bench_ms = atol(optarg); break;
+        case 'f': name_filter = optarg; break;
+        case 'a': analog_events = 1; break;
+        default:
+            fprintf(stderr, "usage: %s [-t msPerBenchmark] [-f nameFilter] [-a]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (bench_ms < 1) bench_ms = 1;
+
+    if (open_outstation(&bench) != 0) {
+        fprintf(stderr, "error: failed to open outstation\n");
+        exit(EXIT_FAILURE);
+    }
+    link = (DNPLINK_CONTEXT*)bench.channel->pLinkContext;
+    tprt = (DNPTPRT_CONTEXT*)bench.channel->pTprtContext;
+
+    printf("%-34s %10s %16s %14s\n", "benchmark", "ops", "time", "throughput");
+
+    /* CRC */
+    for (i = 0; i < (int)sizeof crc_block; i++) crc_block[i] = (TMWTYPES_UCHAR)(i * 37);
+    run(&bench, "dnplink crc compute 8 bytes", bench_crc_header, 8);
+    run(&bench, "dnplink crc compute 16 bytes", bench_crc_block, 16);
+    {
+        uint16_t crc = dnplink_computeCRC(crc_block, 16);
+        crc_block[16] = (TMWTYPES_UCHAR)(crc & 0xff);
+        crc_block[17] = (TMWTYPES_UCHAR)(crc >> 8);
+    }
+    run(&bench, "dnplink crc check 16+2 bytes", bench_crc_check, 18);
+
+    /* Link layer, with the transport layer stubbed out */
+    for (i = 0; i < (int)sizeof user; i++) user[i] = (uint8_t)i;
+    bench.input_len[0] = build_frame(bench.input[0], 0x40, user, 249);
+    bench.num_inputs = 1;
+    bench.next_input = 0;
+    link_parse = link->tmw.pParseFunc;
+    link->tmw.pParseFunc = count_frame;
+    run(&bench, "dnplink parseBytes 292 byte frame", bench_link_whole, (double)bench.input_len[0]);
+    run(&bench, "dnplink parseBytes byte at a time", bench_link_bytewise, (double)bench.input_len[0]);
+    link->tmw.pParseFunc = link_parse;
+    if (bench.frames_parsed == 0 && name_filter == NULL) {
+        fprintf(stderr, "error: the link layer passed no frames up\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Transport layer, with the application layer stubbed out */
+    for (i = 0; i < NUM_SEGMENTS; i++) {
+        TMWSESN_RX_DATA* rx = &bench.segments[i];
+        uint8_t header = (uint8_t)i;
+        if (i == 0) header |= 0x40;
+        if (i == NUM_SEGMENTS - 2) header |= 0x80;
+        memset(bench.segment_data[i], i, sizeof bench.segment_data[i]);
+        bench.segment_data[i][0] = header;
+        rx->pSession = bench.session;
+        rx->pMsgBuf = bench.segment_data[i];
+        rx->msgLength = 250;
+        rx->maxLength = 250;
+    }
+    /* The last one is a fragment in a single segment */
+    bench.segment_data[NUM_SEGMENTS - 1][0] = 0xC0;
+    tprt_parse = tprt->tmw.pParseFunc;
+    tprt->tmw.pParseFunc = count_fragment;
+    run(&bench, "dnptprt single segment fragment", bench_tprt_single, 249);
+    run(&bench, "dnptprt reassemble 7 segments", bench_tprt_reassembly, 249.0 * (NUM_SEGMENTS - 1));
+    tprt->tmw.pParseFunc = tprt_parse;
+    if (bench.fragments_parsed == 0 && name_filter == NULL) {
+        fprintf(stderr, "error: the transport layer passed no fragments up\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Whole requests, the throughput is the response bytes */
+    {
+        static const uint8_t q00[] = { 1, 2, 0x00, 0, NUM_POINTS - 1 };
+        static const uint8_t q01[] = { 1, 2, 0x01, 0, 0, NUM_POINTS - 1, 0 };
+        static const uint8_t q06[] = { 1, 2, 0x06 };
+        static const uint8_t q07[] = { 1, 2, 0x07, 10 };
+        static const uint8_t q17[] = { 1, 2, 0x17, 4, 3, 17, 42, 99 };
+        static const uint8_t q28[] = { 1, 2, 0x28, 4, 0, 3, 0, 17, 0, 42, 0, 99, 0 };
+        static const uint8_t g30v1[] = { 30, 1, 0x06 };
+        static const uint8_t g30v2[] = { 30, 2, 0x06 };
+        static const uint8_t g30v3[] = { 30, 3, 0x06 };
+        static const uint8_t class0[] = { 60, 1, 0x06 };
+        static const uint8_t g2v2[] = { 2, 2, 0x06 };
+        static const uint8_t g2v0[] = { 2, 0, 0x06 };
+        static const uint8_t g32v1[] = { 32, 1, 0x06 };
+        static const uint8_t g32v3[] = { 32, 3, 0x06 };
+
+        run_read(&bench, "read g1v2 q00 start-stop 8 bit", q00, sizeof q00);
+        run_read(&bench, "read g1v2 q01 start-stop 16 bit", q01, sizeof q01);
+        run_read(&bench, "read g1v2 q06 all points", q06, sizeof q06);
+        run_read(&bench, "read g1v2 q07 limited count", q07, sizeof q07);
+        run_read(&bench, "read g1v2 q17 8 bit index", q17, sizeof q17);
+        run_read(&bench, "read g1v2 q28 16 bit index", q28, sizeof q28);
+        run_read(&bench, "read g30v1 static (sdnpo030)", g30v1, sizeof g30v1);
+        run_read(&bench, "read g30v2 static (sdnpo030)", g30v2, sizeof g30v2);
+        run_read(&bench, "read g30v3 static (sdnpo030)", g30v3, sizeof g30v3);
+        run_read(&bench, "read class 0 integrity", class0, sizeof class0);
+
+        /* Binary input events from sdnpo002 */
+        for (i = 0; i < NUM_POINTS; i++) {
+            sdnputil_getDateTime(bench.session, &time_stamp);
+            sdnpo002_addEvent(bench.session, (TMWTYPES_USHORT)i, (TMWTYPES_UCHAR)(0x01 | ((i & 1) << 7)),
+                              &time_stamp);
+        }
+        run_read(&bench, "read g2v0 events (sdnpo002)", g2v0, sizeof g2v0);
+        run_read(&bench, "read g2v2 events (sdnpo002)", g2v2, sizeof g2v2);
+
+        /* Analog input events come from the sdnpo032 change scan */
+        if (!analog_events) return EXIT_SUCCESS;
+        for (i = 0; i < NUM_POINTS; i++) {
+            TMWSIM_POINT* point = (TMWSIM_POINT*)sdnpsim_anlgInGetPoint(bench.db, (TMWTYPES_USHORT)i);
+            if (point != TMWDEFS_NULL) tmwsim_setAnalogValue(point, 1000 + i, TMWDEFS_CHANGE_LOCAL_OP);
+        }
+        for (i = 0; i < 100 && sdnpo032_countEvents(bench.session, TMWDEFS_CLASS_MASK_ALL, TMWDEFS_TRUE, 0) < NUM_POINTS; i++) {
+            tmwtarg_sleep(2);
+            tmwpltmr_checkTimer();
+        }
+        run_read(&bench, "read g32v1 events (sdnpo032)", g32v1, sizeof g32v1);
+        run_read(&bench, "read g32v3 events (sdnpo032)", g32v3, sizeof g32v3);
+    }
+
+    return EXIT_SUCCESS;
+}
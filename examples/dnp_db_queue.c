@@ -0,0 +1,359 @@
+/**
+ * @file
+ * Asynchronous database queue under many producer threads.
+ *
+ * Producer threads, standing in for channel threads parsing responses, add
+ * entries to the tmwdb queue (see tmwscl/utils/tmwdb.h), with a little work
+ * between entries, while one consumer thread stores them in batches with
+ * tmwdb_storeEntries.
+ * The same workload is then run on a list guarded by a mutex with every
+ * entry allocated from the heap, the way the queue worked before
+ * TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE.
+ *
+ * Every entry of a producer must be stored in the order it was added, and
+ * every add must either be stored or counted as an overflow. Entries of a
+ * database closed with tmwdb_closeDatabase must never be stored.
+ *
+ * The report shows the entries stored per second and the queue counters.
+ *
+ * Usage:
+ *   dnp_db_queue [-p producers] [-n entries per producer] [-q queue size] [-b batch] [-w work]
+ *
+ * Exits with a failure status if any check fails.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwdb.h"
+#include "templates/dnp_outstation.h"
+
+#define MAX_PRODUCERS 64
+
+struct entry_t {
+    TMWDB_DATA base;
+    int producer;
+    unsigned long seq;
+};
+
+struct producer_t {
+    pthread_t thread;
+    int index;
+    unsigned long count;
+    unsigned long added;
+    unsigned long rejected;
+};
+
+static struct producer_t producers[MAX_PRODUCERS];
+static unsigned long next_seq[MAX_PRODUCERS];
+static volatile int producers_done;
+static unsigned int work = 200;
+static volatile unsigned long work_sink;
+static int failed;
+
+/* Database handles, entries of the closed one must not be stored */
+static int open_db, closed_db;
+
+/**
+ * @brief Stand in for parsing the next value of a response.
+ */
+static void do_work(unsigned long seed)
+{
+    unsigned int i;
+    for (i = 0; i < work; i++) seed = seed * 6364136223846793005ul + 1442695040888963407ul;
+    work_sink = seed;
+}
+
+static int check_entry(struct entry_t* entry)
+{
+    if (entry->base.pDbHandle == &closed_db) {
+        fprintf(stderr, "error: entry of a closed database stored\n");
+        return -1;
+    }
+    if (entry->seq < next_seq[entry->producer]) {
+        fprintf(stderr, "error: producer %d entry %lu stored after entry %lu\n", entry->producer, entry->seq,
+                next_seq[entry->producer] - 1);
+        return -1;
+    }
+    next_seq[entry->producer] = entry->seq + 1;
+    return 0;
+}
+
+static TMWTYPES_BOOL store_entry(TMWDB_DATA* pData)
+{
+    if (check_entry((struct entry_t*)pData) != 0) failed = 1;
+    return TMWDEFS_TRUE;
+}
+
+/* ---- tmwdb queue ---- */
+
+static void* tmwdb_producer(void* arg)
+{
+    struct producer_t* producer = (struct producer_t*)arg;
+    unsigned long i;
+
+    for (i = 0; i < producer->count; i++) {
+        struct entry_t* entry;
+        do_work(i);
+        entry = (struct entry_t*)tmwdb_allocData(sizeof *entry);
+        if (entry == NULL) {
+            producer->rejected++;
+            continue;
+        }
+        tmwdb_initData(&entry->base, &open_db, store_entry);
+        entry->producer = producer->index;
+        entry->seq = i;
+        if (tmwdb_addEntry(&entry->base)) {
+            producer->added++;
+        } else {
+            tmwdb_freeData(entry);
+            producer->rejected++;
+        }
+    }
+    return NULL;
+}
+
+static unsigned long tmwdb_consume(unsigned int batch)
+{
+    unsigned long stored = 0;
+
+    for (;;) {
+        int done = producers_done;
+        unsigned int n = tmwdb_storeEntries(batch);
+        stored += n;
+        if (n == 0) {
+            if (done) break;
+            sched_yield();
+        }
+    }
+    return stored;
+}
+
+/* ---- Locked list, as the queue was ---- */
+
+struct node_t {
+    struct node_t* next;
+    struct entry_t entry;
+};
+
+static pthread_mutex_t list_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct node_t *list_head, *list_tail;
+static unsigned long list_size, list_max;
+
+static void* list_producer(void* arg)
+{
+    struct producer_t* producer = (struct producer_t*)arg;
+    unsigned long i;
+
+    for (i = 0; i < producer->count; i++) {
+        struct node_t* node;
+        int added = 0;
+        do_work(i);
+        node = (struct node_t*)malloc(sizeof *node);
+        if (node == NULL) {
+            producer->rejected++;
+            continue;
+        }
+        node->next = NULL;
+        node->entry.producer = producer->index;
+        node->entry.seq = i;
+        node->entry.base.pDbHandle = &open_db;
+
+        pthread_mutex_lock(&list_mutex);
+        if (list_size < list_max) {
+            if (list_tail != NULL) list_tail->next = node; else list_head = node;
+            list_tail = node;
+            list_size++;
+            added = 1;
+        }
+        pthread_mutex_unlock(&list_mutex);
+
+        if (added) {
+            producer->added++;
+        } else {
+            free(node);
+            producer->rejected++;
+        }
+    }
+    return NULL;
+}
+
+static unsigned long list_consume(unsigned int batch)
+{
+    unsigned long stored = 0;
+
+    for (;;) {
+        int done = producers_done;
+        unsigned int n;
+
+        pthread_mutex_lock(&list_mutex);
+        for (n = 0; n < batch && list_head != NULL; n++) {
+            struct node_t* node = list_head;
+            list_head = node->next;
+            if (list_head == NULL) list_tail = NULL;
+            list_size--;
+            if (check_entry(&node->entry) != 0) failed = 1;
+            free(node);
+        }
+        pthread_mutex_unlock(&list_mutex);
+
+        stored += n;
+        if (n == 0) {
+            if (done) break;
+            sched_yield();
+        }
+    }
+    return stored;
+}
+
+static int num_running;
+
+/**
+ * @brief Wait for the producers, then tell the consumer to stop once the
+ *        queue is empty.
+ */
+static void* join_producers(void* arg)
+{
+    int i;
+
+    (void)arg;
+    for (i = 0; i < num_running; i++) pthread_join(producers[i].thread, NULL);
+    producers_done = 1;
+    return NULL;
+}
+
+/**
+ * @brief Run \p num_producers producers against one consumer.
+ */
+static int run(const char* name, void* (*producer_func)(void*), unsigned long (*consume_func)(unsigned int),
+               int num_producers, unsigned long count, unsigned int batch)
+{
+    unsigned long added = 0, rejected = 0, stored;
+    uint64_t start, elapsed;
+    pthread_t joiner;
+    int i;
+
+    memset(next_seq, 0, sizeof next_seq);
+    producers_done = 0;
+    num_running = num_producers;
+
+    start = now_us();
+    for (i = 0; i < num_producers; i++) {
+        producers[i].index = i;
+        producers[i].count = count;
+        producers[i].added = 0;
+        producers[i].rejected = 0;
+        pthread_create(&producers[i].thread, NULL, producer_func, &producers[i]);
+    }
+    pthread_create(&joiner, NULL, join_producers, NULL);
+
+    /* This thread is the consumer */
+    stored = consume_func(batch);
+    elapsed = now_us() - start;
+    pthread_join(joiner, NULL);
+
+    for (i = 0; i < num_producers; i++) {
+        added += producers[i].added;
+        rejected += producers[i].rejected;
+    }
+
+    printf("%-12s %10.0f entries/s stored  %lu added  %lu rejected\n", name, stored * 1e6 / (double)elapsed,
+           added, rejected);
+    if (stored != added) {
+        fprintf(stderr, "error: %s added %lu entries but stored %lu\n", name, added, stored);
+        return -1;
+    }
+    if (added + rejected != count * (unsigned long)num_producers) {
+        fprintf(stderr, "error: %s lost track of %lu entries\n", name,
+                count * (unsigned long)num_producers - added - rejected);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Entries of a closed database must be removed from the queue.
+ */
+static int close_database(void)
+{
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        struct entry_t* entry = (struct entry_t*)tmwdb_allocData(sizeof *entry);
+        if (entry == NULL) return -1;
+        tmwdb_initData(&entry->base, i % 2 ? &closed_db : &open_db, store_entry);
+        entry->producer = 0;
+        entry->seq = (unsigned long)i;
+        if (!tmwdb_addEntry(&entry->base)) {
+            tmwdb_freeData(entry);
+            return -1;
+        }
+    }
+
+    memset(next_seq, 0, sizeof next_seq);
+    tmwdb_closeDatabase(&closed_db);
+    if (tmwdb_getSize() != 4) {
+        fprintf(stderr, "error: %u entries queued after closing a database, expected 4\n", tmwdb_getSize());
+        return -1;
+    }
+    if (tmwdb_storeEntries(100) != 4 || tmwdb_getSize() != 0) {
+        fprintf(stderr, "error: entries of the open database not stored\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int num_producers = 8, opt;
+    unsigned long count = 200000;
+    unsigned int queue_size = 4096, batch = 64;
+    TMWDB_STATS stats;
+
+    while ((opt = getopt(argc, argv, "p:n:q:b:w:")) != -1) {
+        switch (opt) {
+        case 'p': num_producers = atoi(optarg); break;
+        case 'n': count = strtoul(optarg, NULL, 0); break;
+        case 'q': queue_size = (unsigned int)strtoul(optarg, NULL, 0); break;
+        case 'b': batch = (unsigned int)strtoul(optarg, NULL, 0); break;
+        case 'w': work = (unsigned int)strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-p producers] [-n entries per producer] [-q queue size] [-b batch] [-w work]\n",
+                    argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_producers < 1) num_producers = 1;
+    if (num_producers > MAX_PRODUCERS) num_producers = MAX_PRODUCERS;
+    if (queue_size < 8) queue_size = 8;
+    if (batch < 1) batch = 1;
+
+    tmwtargp_registerPutDiagStringFunc(quiet_diag);
+    printf("%d producers, %lu entries each, queue of %u, batches of %u, work %u\n", num_producers, count,
+           queue_size, batch, work);
+
+    tmwdb_init(queue_size);
+    if (run("tmwdb", tmwdb_producer, tmwdb_consume, num_producers, count, batch) != 0) failed = 1;
+
+    tmwdb_getStats(&stats);
+    printf("%-12s %lu added  %lu stored  %lu overflows  high water %lu  %lu contended  %lu heap allocations\n",
+           "", (unsigned long)stats.added, (unsigned long)stats.stored, (unsigned long)stats.overflows,
+           (unsigned long)stats.highWater, (unsigned long)stats.contended, (unsigned long)stats.allocated);
+    if (stats.added != stats.stored || stats.highWater > queue_size) {
+        fprintf(stderr, "error: queue counters do not add up\n");
+        failed = 1;
+    }
+    if (close_database() != 0) failed = 1;
+    tmwdb_destroy();
+
+    list_max = queue_size;
+    if (run("locked list", list_producer, list_consume, num_producers, count, batch) != 0) failed = 1;
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,634 @@
+/**
+ * @file
+ * Checks concurrent object 70 file transfers on one outstation session,
+ * built with SDNPDATA_SUPPORT_OBJ70.
+ *
+ * The outstation runs in this process with its channel on an in-memory
+ * physical layer, as in dnp_codec_bench. Requests are built as a master
+ * would send them and handed to dnplink_parseBytes, and the responses are
+ * reassembled from the transmitted frames, so every transfer goes through
+ * the link, transport and application layers and the simulated file
+ * database to the Linux file target.
+ *
+ * The session opens one file per handle it can hold open at once,
+ * SDNPCNFG_OBJ70_MAX_OPEN_FILES, and moves a block of each in turn:
+ *   - reads of source files, compared with their contents
+ *   - writes of copies, compared with the sources once closed
+ *   - reads of the same files one at a time, for reference
+ * Then it checks that one more open than the limit is refused, and that a
+ * held file is closed once the file transfer timeout passes without a
+ * request for it.
+ *
+ * Usage:
+ *   dnp_file_transfers [-s fileKB] [-b blockSize]
+ *
+ * Exits with failure if a transfer fails or a file does not match.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/utils/tmwpltmr.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnplink.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#if !SDNPDATA_SUPPORT_OBJ70
+#error dnp_file_transfers must be built with SDNPDATA_SUPPORT_OBJ70 set to TMWDEFS_TRUE
+#endif
+
+#define MASTER_ADDR      3
+#define OUTSTATION_ADDR  4
+#define NUM_FILES        SDNPCNFG_OBJ70_MAX_OPEN_FILES
+#define MAX_FRAME        292
+#define MAX_SEGMENT      249
+#define MAX_FRAGMENT     4096
+#define TRANSFER_TIMEOUT_MS 1000
+
+struct transfer_t {
+    TMWCHNL* channel;
+    TMWSESN* session;
+    uint8_t app_seq;
+    uint8_t tprt_seq;
+
+    /* Last response fragment, reassembled by the in-memory transmit */
+    uint8_t response[MAX_FRAGMENT];
+    size_t response_len;
+    int response_done;
+};
+
+struct file_t {
+    char source[256];
+    char copy[256];
+    uint8_t* data;
+    uint8_t* received;
+    size_t length;
+    size_t offset;
+    uint32_t handle;
+    uint32_t block;
+    int done;
+};
+
+/* ---- Outstation ---- */
+
+/**
+ * @brief Strip the link header and CRCs from a transmitted frame and add
+ *        its transport segment to the response fragment.
+ */
+static void collect_response(void* param, const uint8_t* frame, size_t len)
+{
+    struct transfer_t* transfer = (struct transfer_t*)param;
+    uint8_t user[256];
+    size_t user_len, pos, in = 10;
+
+    TMWTARG_UNUSED_PARAM(len);
+
+    /* Frames without user data are link layer only */
+    user_len = (frame[2] > 5) ? (size_t)frame[2] - 5 : 0;
+    for (pos = 0; pos < user_len; pos += 16) {
+        size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+        memcpy(user + pos, frame + in, block);
+        in += block + 2;
+    }
+    if (user_len > 1) {
+        if (user[0] & 0x40) transfer->response_len = 0;
+        if (transfer->response_len + user_len - 1 <= sizeof transfer->response) {
+            memcpy(transfer->response + transfer->response_len, user + 1, user_len - 1);
+            transfer->response_len += user_len - 1;
+        }
+        if (user[0] & 0x80) transfer->response_done = 1;
+    }
+}
+
+static int open_outstation(struct transfer_t* transfer)
+{
+    struct outstation_config_t config;
+    TMWAPPL* appl = start_scl();
+
+    transfer->channel = open_mem_channel(appl, &config, "files");
+    if (transfer->channel == TMWDEFS_NULL) return -1;
+    mem_tx_handler = collect_response;
+    mem_tx_param = transfer;
+
+    config.sesn.source = OUTSTATION_ADDR;
+    config.sesn.destination = MASTER_ADDR;
+    config.sesn.fileTransferTimeout = TRANSFER_TIMEOUT_MS;
+    transfer->session = sdnpsesn_openSession(transfer->channel, &config.sesn, TMWDEFS_NULL);
+    if (transfer->session == TMWDEFS_NULL) return -1;
+
+    tmwlink_openChannel((TMWLINK_CONTEXT*)transfer->channel->pLinkContext);
+    return 0;
+}
+
+/* ---- Master side ---- */
+
+/**
+ * @brief Send an application fragment to the outstation, one frame per
+ *        transport segment.
+ */
+static void send_fragment(struct transfer_t* transfer, const uint8_t* app, size_t app_len)
+{
+    size_t pos;
+
+    for (pos = 0; pos < app_len; pos += MAX_SEGMENT) {
+        uint8_t frame[MAX_FRAME];
+        uint8_t user[MAX_SEGMENT + 1];
+        size_t segment = (app_len - pos < MAX_SEGMENT) ? app_len - pos : MAX_SEGMENT;
+        size_t user_len = segment + 1;
+        size_t frame_len = 10, block_pos;
+        uint16_t crc;
+
+        user[0] = (uint8_t)((pos == 0 ? 0x40 : 0) | (pos + segment == app_len ? 0x80 : 0) | transfer->tprt_seq);
+        transfer->tprt_seq = (uint8_t)((transfer->tprt_seq + 1) & 0x3f);
+        memcpy(user + 1, app + pos, segment);
+
+        frame[0] = 0x05;
+        frame[1] = 0x64;
+        frame[2] = (uint8_t)(5 + user_len);
+        frame[3] = 0xC4;    /* DIR | PRM | UNCONFIRMED USER DATA */
+        frame[4] = OUTSTATION_ADDR & 0xff;
+        frame[5] = OUTSTATION_ADDR >> 8;
+        frame[6] = MASTER_ADDR & 0xff;
+        frame[7] = MASTER_ADDR >> 8;
+        crc = dnplink_computeCRC(frame, 8);
+        frame[8] = (uint8_t)(crc & 0xff);
+        frame[9] = (uint8_t)(crc >> 8);
+
+        for (block_pos = 0; block_pos < user_len; block_pos += 16) {
+            size_t block = (user_len - block_pos < 16) ? user_len - block_pos : 16;
+            memcpy(frame + frame_len, user + block_pos, block);
+            crc = dnplink_computeCRC(user + block_pos, (TMWTYPES_USHORT)block);
+            frame_len += block;
+            frame[frame_len++] = (uint8_t)(crc & 0xff);
+            frame[frame_len++] = (uint8_t)(crc >> 8);
+        }
+        feed_link(transfer->channel, frame, frame_len);
+    }
+}
+
+/**
+ * @brief Send a request and return the first object 70 in the response,
+ *        confirming the response if the outstation asked for it.
+ *
+ * @returns the object data after its size field, or NULL if the response
+ *          has no object 70 of the expected variation.
+ */
+static const uint8_t* request(struct transfer_t* transfer, uint8_t function, const uint8_t* objects,
+                              size_t len, uint8_t variation)
+{
+    static uint8_t app[MAX_FRAGMENT];
+    const uint8_t* response = transfer->response;
+
+    app[0] = (uint8_t)(0xC0 | transfer->app_seq);    /* FIR | FIN */
+    app[1] = function;
+    memcpy(app + 2, objects, len);
+    transfer->app_seq = (uint8_t)((transfer->app_seq + 1) & 0x0f);
+
+    transfer->response_done = 0;
+    send_fragment(transfer, app, len + 2);
+    if (!transfer->response_done || transfer->response_len < 10 || response[1] != DNPDEFS_FC_RESPONSE) return NULL;
+
+    if (response[0] & 0x20) {
+        uint8_t confirm[2];
+        confirm[0] = (uint8_t)(0xC0 | (response[0] & 0x0f));
+        confirm[1] = DNPDEFS_FC_CONFIRM;
+        send_fragment(transfer, confirm, sizeof confirm);
+    }
+
+    if (response[4] != DNPDEFS_OBJ_70_FILE_EVENTS || response[5] != variation
+        || response[6] != DNPDEFS_QUAL_16BIT_FREE_FORMAT) {
+        return NULL;
+    }
+    return response + 10;
+}
+
+static void put16(uint8_t* p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t* p, uint32_t value)
+{
+    put16(p, (uint16_t)value);
+    put16(p + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t get16(const uint8_t* p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* p)
+{
+    return (uint32_t)get16(p) | ((uint32_t)get16(p + 2) << 16);
+}
+
+static void object_header(uint8_t* objects, uint8_t variation, uint16_t size)
+{
+    objects[0] = DNPDEFS_OBJ_70_FILE_EVENTS;
+    objects[1] = variation;
+    objects[2] = DNPDEFS_QUAL_16BIT_FREE_FORMAT;
+    objects[3] = 1;
+    put16(objects + 4, size);
+}
+
+/**
+ * @brief Open a file with object 70 variation 3.
+ *
+ * @returns the file command status, or -1 if there was no status.
+ */
+static int open_file(struct transfer_t* transfer, const char* name, uint16_t mode, uint16_t block_size,
+                     uint32_t* handle)
+{
+    uint8_t objects[300];
+    uint16_t name_len = (uint16_t)strlen(name);
+    const uint8_t* status;
+
+    memset(objects, 0, sizeof objects);
+    object_header(objects, 3, (uint16_t)(26 + name_len));
+    put16(objects + 6, 26);                /* file name offset */
+    put16(objects + 8, name_len);
+    put16(objects + 16, 0x1b6);            /* permissions */
+    put16(objects + 26, mode);
+    put16(objects + 28, block_size);
+    memcpy(objects + 32, name, name_len);
+
+    status = request(transfer, DNPDEFS_FC_OPEN_FILE, objects, 32u + name_len, 4);
+    if (status == NULL) return -1;
+    *handle = get32(status);
+    return status[12];
+}
+
+/**
+ * @brief Close a file with object 70 variation 4.
+ *
+ * @returns the file command status, or -1 if there was no status.
+ */
+static int close_file(struct transfer_t* transfer, uint32_t handle)
+{
+    uint8_t objects[19];
+    const uint8_t* status;
+
+    memset(objects, 0, sizeof objects);
+    object_header(objects, 4, 13);
+    put32(objects + 6, handle);
+
+    status = request(transfer, DNPDEFS_FC_CLOSE_FILE, objects, sizeof objects, 4);
+    return (status == NULL) ? -1 : status[12];
+}
+
+/**
+ * @brief Read the next block of a file and add it to the received data.
+ *
+ * @returns 0 if the block was read, otherwise the transport status or -1.
+ */
+static int read_block(struct transfer_t* transfer, struct file_t* file)
+{
+    uint8_t objects[14];
+    const uint8_t* data;
+    size_t data_len;
+    uint32_t block;
+
+    object_header(objects, 5, 8);
+    put32(objects + 6, file->handle);
+    put32(objects + 10, file->block);
+
+    data = request(transfer, DNPDEFS_FC_READ, objects, sizeof objects, 5);
+    if (data == NULL) {
+        data = transfer->response + 10;
+        return (transfer->response_len >= 19 && transfer->response[5] == 6) ? data[8] : -1;
+    }
+
+    data_len = (size_t)get16(data - 2) - 8;
+    block = get32(data + 4);
+    if (get32(data) != file->handle || (block & 0x7fffffff) != file->block
+        || file->offset + data_len > file->length) {
+        return -1;
+    }
+    memcpy(file->received + file->offset, data + 8, data_len);
+    file->offset += data_len;
+    file->block++;
+    file->done = (block & 0x80000000) != 0;
+    return 0;
+}
+
+/**
+ * @brief Write the next block of a file from its data.
+ *
+ * @returns the transport status, or -1 if there was no status.
+ */
+static int write_block(struct transfer_t* transfer, struct file_t* file, uint16_t block_size)
+{
+    static uint8_t objects[MAX_FRAGMENT];
+    size_t len = file->length - file->offset;
+    uint32_t block = file->block;
+    const uint8_t* status;
+
+    if (len > block_size) len = block_size;
+    if (file->offset + len == file->length) block |= 0x80000000;
+
+    object_header(objects, 5, (uint16_t)(8 + len));
+    put32(objects + 6, file->handle);
+    put32(objects + 10, block);
+    memcpy(objects + 14, file->data + file->offset, len);
+
+    status = request(transfer, DNPDEFS_FC_WRITE, objects, 14 + len, 6);
+    if (status == NULL) return -1;
+    if (status[8] == DNPDEFS_FILE_TFER_STAT_SUCCESS) {
+        file->offset += len;
+        file->block++;
+        file->done = (block & 0x80000000) != 0;
+    }
+    return status[8];
+}
+
+/* ---- Checks ---- */
+
+static int write_source(struct file_t* file, unsigned int seed)
+{
+    FILE* out;
+    size_t i;
+
+    for (i = 0; i < file->length; i++) file->data[i] = (uint8_t)(rand_r(&seed) >> 8);
+    out = fopen(file->source, "wb");
+    if (out == NULL) return -1;
+    if (fwrite(file->data, 1, file->length, out) != file->length) {
+        fclose(out);
+        return -1;
+    }
+    return fclose(out);
+}
+
+static int same_as_source(const struct file_t* file, const char* name)
+{
+    FILE* in = fopen(name, "rb");
+    uint8_t* contents = malloc(file->length + 1);
+    size_t len = 0;
+    int same;
+
+    if (in != NULL && contents != NULL) len = fread(contents, 1, file->length + 1, in);
+    same = (in != NULL && contents != NULL && len == file->length && memcmp(contents, file->data, len) == 0);
+    if (in != NULL) fclose(in);
+    free(contents);
+    return same;
+}
+
+static void reset(struct file_t* files, int num_files)
+{
+    int i;
+
+    for (i = 0; i < num_files; i++) {
+        files[i].offset = 0;
+        files[i].block = 0;
+        files[i].done = 0;
+        files[i].handle = 0;
+        if (files[i].received != NULL) memset(files[i].received, 0, files[i].length);
+    }
+}
+
+/**
+ * @brief Open every file, then move one block of each in turn until all
+ *        are done, and close them.
+ *
+ * @returns the seconds taken, or a negative value on failure.
+ */
+static double transfer_all(struct transfer_t* transfer, struct file_t* files, int num_files, int writing,
+                           uint16_t block_size)
+{
+    uint64_t start = now_us();
+    int i, running;
+
+    reset(files, num_files);
+    for (i = 0; i < num_files; i++) {
+        const char* name = writing ? files[i].copy : files[i].source;
+        int status = open_file(transfer, name, writing ? DNPDEFS_FILE_MODE_WRITE : DNPDEFS_FILE_MODE_READ,
+                               block_size, &files[i].handle);
+        if (status != DNPDEFS_FILE_CMD_STAT_SUCCESS) {
+            printf("error: open of file %d of %d returned status %d\n", i + 1, num_files, status);
+            return -1;
+        }
+    }
+
+    do {
+        running = 0;
+        for (i = 0; i < num_files; i++) {
+            int status;
+            if (files[i].done) continue;
+            status = writing ? write_block(transfer, &files[i], block_size) : read_block(transfer, &files[i]);
+            if (status != 0) {
+                printf("error: %s of block %u of file %d returned status %d\n",
+                       writing ? "write" : "read", files[i].block, i + 1, status);
+                return -1;
+            }
+            running += !files[i].done;
+        }
+    } while (running > 0);
+
+    for (i = 0; i < num_files; i++) {
+        int status = close_file(transfer, files[i].handle);
+        if (status != DNPDEFS_FILE_CMD_STAT_SUCCESS) {
+            printf("error: close of file %d returned status %d\n", i + 1, status);
+            return -1;
+        }
+    }
+    return (double)(now_us() - start) / 1e6;
+}
+
+/**
+ * @brief Read the files one at a time, for comparison.
+ */
+static double read_one_at_a_time(struct transfer_t* transfer, struct file_t* files, int num_files,
+                                 uint16_t block_size)
+{
+    double seconds = 0;
+    int i;
+
+    for (i = 0; i < num_files; i++) {
+        double file_seconds = transfer_all(transfer, &files[i], 1, 0, block_size);
+        if (file_seconds < 0) return -1;
+        seconds += file_seconds;
+    }
+    return seconds;
+}
+
+static int check_limit(struct transfer_t* transfer, struct file_t* files, uint16_t block_size)
+{
+    uint32_t handles[NUM_FILES + 1];
+    int i, status = 0, result = 0;
+
+    /* Opening a file that is already held closes it, so the extra open
+     * uses one of the copies made by the concurrent writes
+     */
+    for (i = 0; i <= NUM_FILES; i++) {
+        const char* name = (i < NUM_FILES) ? files[i].source : files[0].copy;
+        status = open_file(transfer, name, DNPDEFS_FILE_MODE_READ, block_size, &handles[i]);
+        if (i < NUM_FILES && status != DNPDEFS_FILE_CMD_STAT_SUCCESS) {
+            printf("error: open %d returned status %d\n", i + 1, status);
+            return -1;
+        }
+    }
+    if (status != DNPDEFS_FILE_CMD_STAT_TOO_MANY) {
+        printf("error: open %d returned status %d, not too many open\n", NUM_FILES + 1, status);
+        result = -1;
+    }
+    for (i = 0; i < NUM_FILES; i++) {
+        if (close_file(transfer, handles[i]) != DNPDEFS_FILE_CMD_STAT_SUCCESS) {
+            printf("error: close of handle %d failed\n", i + 1);
+            result = -1;
+        }
+    }
+    return result;
+}
+
+static int check_held_timeout(struct transfer_t* transfer, struct file_t* files, uint16_t block_size)
+{
+    uint32_t held, current;
+    uint64_t deadline;
+    int status;
+
+    if (open_file(transfer, files[0].source, DNPDEFS_FILE_MODE_READ, block_size, &held) != 0
+        || open_file(transfer, files[1].source, DNPDEFS_FILE_MODE_READ, block_size, &current) != 0) {
+        printf("error: open for the held file timeout failed\n");
+        return -1;
+    }
+
+    /* Keep the current file in use until the held one has expired */
+    deadline = now_us() + (TRANSFER_TIMEOUT_MS * 3u / 2u) * 1000u;
+    reset(&files[1], 1);
+    files[1].handle = current;
+    while (now_us() < deadline) {
+        tmwtarg_sleep(10);
+        tmwpltmr_checkTimer();
+        if (!files[1].done && read_block(transfer, &files[1]) != 0) {
+            printf("error: read of the current file failed\n");
+            return -1;
+        }
+    }
+
+    reset(&files[0], 1);
+    files[0].handle = held;
+    status = read_block(transfer, &files[0]);
+    close_file(transfer, current);
+    if (status != DNPDEFS_FILE_TFER_STAT_NOT_OPEN && status != DNPDEFS_FILE_TFER_STAT_INV_HANDLE) {
+        printf("error: read of the expired held file returned status %d\n", status);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    struct transfer_t transfer;
+    struct file_t files[NUM_FILES];
+    char dir[] = "/tmp/dnp_file_transfersXXXXXX";
+    size_t file_kb = 1024;
+    long block_size = 1024;
+    double seconds, megabytes;
+    int opt, i;
+    int result = EXIT_SUCCESS;
+
+    while ((opt = getopt(argc, argv, "s:b:")) != -1) {
+        switch (opt) {
+        case 's': file_kb = (size_t)atol(optarg); break;
+        case 'b': block_size = atol(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-s fileKB] [-b blockSize]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (block_size < 16 || block_size > DNPCNFG_MAX_RX_FRAGMENT_LENGTH - 16) {
+        fprintf(stderr, "error: block size must be 16 to %d\n", DNPCNFG_MAX_RX_FRAGMENT_LENGTH - 16);
+        exit(EXIT_FAILURE);
+    }
+    if (NUM_FILES < 2) {
+        fprintf(stderr, "error: SDNPCNFG_OBJ70_MAX_OPEN_FILES must be 2 or more\n");
+        exit(EXIT_FAILURE);
+    }
+    if (mkdtemp(dir) == NULL) {
+        fprintf(stderr, "error: failed to create %s\n", dir);
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&transfer, 0, sizeof transfer);
+    memset(files, 0, sizeof files);
+    for (i = 0; i < NUM_FILES; i++) {
+        snprintf(files[i].source, sizeof files[i].source, "%s/source%d", dir, i);
+        snprintf(files[i].copy, sizeof files[i].copy, "%s/copy%d", dir, i);
+        files[i].length = file_kb * 1024 + (size_t)i * 7;
+        files[i].data = malloc(files[i].length);
+        files[i].received = malloc(files[i].length);
+        if (files[i].data == NULL || files[i].received == NULL || write_source(&files[i], (unsigned int)i + 1) != 0) {
+            fprintf(stderr, "error: failed to create %s\n", files[i].source);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if (open_outstation(&transfer) != 0) {
+        fprintf(stderr, "error: failed to open the outstation\n");
+        exit(EXIT_FAILURE);
+    }
+
+    megabytes = (double)NUM_FILES * (double)file_kb / 1024.0;
+    printf("%d files of %lu KB, %ld byte blocks\n", NUM_FILES, (unsigned long)file_kb, block_size);
+
+    seconds = transfer_all(&transfer, files, NUM_FILES, 0, (uint16_t)block_size);
+    if (seconds < 0) {
+        result = EXIT_FAILURE;
+    } else {
+        printf("concurrent reads:  %.3f s  %.1f MB/s\n", seconds, megabytes / seconds);
+        for (i = 0; i < NUM_FILES; i++) {
+            if (memcmp(files[i].received, files[i].data, files[i].length) != 0) {
+                printf("error: file %d read back different data\n", i + 1);
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+
+    seconds = transfer_all(&transfer, files, NUM_FILES, 1, (uint16_t)block_size);
+    if (seconds < 0) {
+        result = EXIT_FAILURE;
+    } else {
+        printf("concurrent writes: %.3f s  %.1f MB/s\n", seconds, megabytes / seconds);
+        for (i = 0; i < NUM_FILES; i++) {
+            if (!same_as_source(&files[i], files[i].copy)) {
+                printf("error: copy %d differs from its source\n", i + 1);
+                result = EXIT_FAILURE;
+            }
+        }
+    }
+
+    seconds = read_one_at_a_time(&transfer, files, NUM_FILES, (uint16_t)block_size);
+    if (seconds < 0) {
+        result = EXIT_FAILURE;
+    } else {
+        printf("sequential reads:  %.3f s  %.1f MB/s\n", seconds, megabytes / seconds);
+    }
+
+    if (check_limit(&transfer, files, (uint16_t)block_size) != 0) result = EXIT_FAILURE;
+    else printf("open %d of %d refused as too many\n", NUM_FILES + 1, NUM_FILES);
+
+    if (check_held_timeout(&transfer, files, (uint16_t)block_size) != 0) result = EXIT_FAILURE;
+    else printf("held file closed after the %d ms file transfer timeout\n", TRANSFER_TIMEOUT_MS);
+
+    sdnpsesn_closeSession(transfer.session);
+    dnpchnl_closeChannel(transfer.channel);
+
+    for (i = 0; i < NUM_FILES; i++) {
+        remove(files[i].source);
+        remove(files[i].copy);
+        free(files[i].data);
+        free(files[i].received);
+    }
+    rmdir(dir);
+    return result;
+}
@@ -0,0 +1,547 @@
+/**
+ * @file
+ * A crash consistency test for the DNP3 outstation event journal.
+ *
+ * Each round forks an outstation that journals its session with sdnpjrnl
+ * and runs a deterministic series of operations on it: binary input and
+ * counter events (each also setting its point), master confirms of the
+ * oldest events and explicit checkpoints. The queues are kept small so
+ * events overflow and, for counters, are replaced by newer ones. Analog
+ * input events are left out since sdnpo032_addEvent also publishes each
+ * event to the MQTT broker and exits if it cannot connect to it. The outstation reports each operation it finishes over a pipe and
+ * is killed with SIGKILL after a random delay.
+ *
+ * A second process then replays the journal and compares the result with
+ * the state after the last finished operation (A) and after the one that
+ * may have been in progress (B), both computed by running the same
+ * operations on a session without a journal. Every event in both A and B
+ * must have been restored, no event outside A and B may appear, the
+ * queues must be in time order and every point must hold its value from
+ * A or from B. The restored session is then closed and the journal
+ * replayed again, which must give exactly the same state.
+ *
+ * Usage:
+ *   dnp_journal_crash [-n rounds] [-d directory] [-p port] [-c checkpointSize]
+ *                     [-k maxDelayMs] [-s seed] [-y]
+ *
+ * -y flushes every record to the disk. Exits with a failure status if any
+ * round restored an inconsistent state.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <poll.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/wait.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/utils/tmwsim.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnpdtime.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpdata.h"
+#include "tmwscl/dnp/sdnprbe.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwscl/dnp/sdnpo002.h"
+#include "tmwscl/dnp/sdnpo022.h"
+#include "tmwscl/dnp/sdnpjrnl.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define MASTER_ADDR     3
+#define OUTSTATION_ADDR 4
+#define NUM_POINTS      8
+#define MAX_EVENTS      16
+#define MAX_OPERATIONS  1000000
+
+/* Event times are this many milliseconds since 1970 plus the operation number */
+#define TIME_BASE_MS    1600000000000ULL
+
+enum journal_type_t {
+    TYPE_BINARY,
+    TYPE_COUNTER,
+    NUM_TYPES
+};
+
+struct journal_config_t {
+    int rounds;
+    const char* directory;
+    int port;
+    unsigned long checkpoint_size;
+    int max_delay_ms;
+    unsigned int seed;
+    int sync_writes;
+};
+
+struct journal_event_t {
+    uint64_t ms;
+    uint16_t point;
+    uint8_t flags;
+    uint32_t value;
+};
+
+/* Events queued and point values of a session */
+struct journal_state_t {
+    int num_events[NUM_TYPES];
+    struct journal_event_t events[NUM_TYPES][MAX_EVENTS];
+    uint8_t flags[NUM_TYPES][NUM_POINTS];
+    uint32_t values[NUM_TYPES][NUM_POINTS];
+};
+
+/**
+ * @brief A well mixed number from the seed and an operation number, so
+ *        every process derives the same operations.
+ */
+static uint64_t operation_hash(unsigned int seed, uint64_t operation)
+{
+    uint64_t z = ((uint64_t)seed << 32) + operation + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static void operation_time(uint64_t operation, TMWDTIME* time_stamp)
+{
+    TMWTYPES_MS_SINCE_70 msSince70;
+    uint64_t ms = TIME_BASE_MS + operation;
+
+    msSince70.mostSignificant = (TMWTYPES_ULONG)(ms >> 16);
+    msSince70.leastSignificant = (TMWTYPES_USHORT)(ms & 0xffff);
+    dnpdtime_msSince70ToDateTime(time_stamp, &msSince70);
+}
+
+static uint64_t event_ms(const TMWDTIME* time_stamp)
+{
+    TMWTYPES_MS_SINCE_70 msSince70;
+
+    dnpdtime_dateTimeToMSSince70(&msSince70, time_stamp);
+    return ((uint64_t)msSince70.mostSignificant << 16) | msSince70.leastSignificant;
+}
+
+/**
+ * @brief Mark the oldest \p count events of a queue as sent.
+ */
+static void mark_sent(TMWDLIST* list, int count)
+{
+    SDNPEVNT* event = (SDNPEVNT*)tmwdlist_getFirst(list);
+    while (event != TMWDEFS_NULL && count-- > 0) {
+        event->eventSent = TMWDEFS_TRUE;
+        event = (SDNPEVNT*)tmwdlist_getNext((TMWDLIST_MEMBER*)event);
+    }
+}
+
+/**
+ * @brief Run operation \p operation on a session. Events also set their
+ *        point, the way an application that updates its database and
+ *        then adds the event does.
+ */
+static void run_operation(TMWSESN* session, unsigned int seed, uint64_t operation)
+{
+    SDNPSESN* sdnp_session = (SDNPSESN*)session;
+    void* db = sdnp_session->pDbHandle;
+    uint64_t h = operation_hash(seed, operation);
+    TMWTYPES_USHORT point = (TMWTYPES_USHORT)((h >> 8) % NUM_POINTS);
+    TMWDEFS_CHANGE_REASON reason;
+    TMWSIM_POINT* sim_point;
+    TMWDTIME time_stamp;
+
+    operation_time(operation, &time_stamp);
+    switch (h % 16) {
+    case 0: case 1: case 2: case 3: case 4: case 5: {
+        TMWTYPES_BOOL on = (TMWTYPES_BOOL)((h >> 16) & 1);
+        sim_point = (TMWSIM_POINT*)sdnpsim_binInGetPoint(db, point);
+        tmwsim_setBinaryValue(sim_point, on, TMWDEFS_CHANGE_NONE);
+        tmwsim_setFlags(sim_point, DNPDEFS_DBAS_FLAG_ON_LINE, TMWDEFS_CHANGE_NONE);
+        tmwsim_getChanged(sim_point, &reason);
+        sdnpo002_addEvent(session, point,
+                          (TMWTYPES_UCHAR)(DNPDEFS_DBAS_FLAG_ON_LINE | (on ? DNPDEFS_DBAS_FLAG_BINARY_ON : 0)),
+                          &time_stamp);
+        break;
+    }
+    case 6: case 7: case 8: case 9: case 10:
+        sim_point = (TMWSIM_POINT*)sdnpsim_binaryCounterGetPoint(db, point);
+        tmwsim_setCounterValue(sim_point, (TMWTYPES_ULONG)operation, TMWDEFS_CHANGE_NONE);
+        tmwsim_getChanged(sim_point, &reason);
+        sdnpo022_addEvent(session, point, (TMWTYPES_ULONG)operation, DNPDEFS_DBAS_FLAG_ON_LINE, &time_stamp);
+        break;
+    case 11: case 12: case 13: case 14: {
+        /* The master confirms a response with the oldest events */
+        int count = (int)((h >> 16) % 6) + 1;
+        mark_sent(&sdnp_session->obj2Events, count);
+        mark_sent(&sdnp_session->obj22Events, count);
+        sdnprbe_cleanupEvents(session, TMWDEFS_TRUE);
+        break;
+    }
+    default:
+        /* Does nothing on a session without a journal */
+        sdnpjrnl_checkpoint(session);
+        break;
+    }
+}
+
+static TMWCHNL* open_channel(TMWAPPL* appl, int port)
+{
+    struct outstation_config_t config;
+    char name[16];
+
+    snprintf(name, sizeof name, "Journal%d", port);
+    init_outstation_config(&config, name, port);
+    return open_outstation_channel(appl, &config);
+}
+
+/**
+ * @brief Open a session with NUM_POINTS points of each type and small
+ *        event queues, counters keep only their most recent event.
+ */
+static TMWSESN* open_session(TMWCHNL* channel)
+{
+    SDNPSESN_CONFIG sesn_config;
+    TMWSESN* session;
+    void* db;
+    int i;
+
+    sdnpsesn_initConfig(&sesn_config);
+    sesn_config.source = OUTSTATION_ADDR;
+    sesn_config.destination = MASTER_ADDR;
+    sesn_config.unsolAllowed = TMWDEFS_FALSE;
+    sesn_config.linkStatusPeriod = 0;
+    sesn_config.sesnDiagMask = 0;
+    sesn_config.binaryInputMaxEvents = MAX_EVENTS;
+    sesn_config.binaryInputEventMode = TMWDEFS_EVENT_MODE_SOE;
+    sesn_config.binaryCounterMaxEvents = MAX_EVENTS;
+    sesn_config.binaryCounterEventMode = TMWDEFS_EVENT_MODE_MOST_RECENT;
+
+    session = sdnpsesn_openSession(channel, &sesn_config, TMWDEFS_NULL);
+    if (session == TMWDEFS_NULL) return TMWDEFS_NULL;
+
+    db = ((SDNPSESN*)session)->pDbHandle;
+    sdnpsim_clear(db);
+    for (i = 0; i < NUM_POINTS; i++) {
+        sdnpsim_addBinaryInput(db, TMWDEFS_CLASS_MASK_ONE, DNPDEFS_DBAS_FLAG_ON_LINE, TMWDEFS_FALSE);
+        sdnpsim_addBinaryCounter(db, TMWDEFS_CLASS_MASK_ONE, TMWDEFS_CLASS_MASK_NONE, DNPDEFS_DBAS_FLAG_ON_LINE, 0);
+    }
+    return session;
+}
+
+static int open_journal(TMWSESN* session, const struct journal_config_t* config, const char* file_name)
+{
+    SDNPJRNL_CONFIG jrnl_config;
+
+    sdnpjrnl_initConfig(&jrnl_config);
+    snprintf(jrnl_config.fileName, sizeof jrnl_config.fileName, "%s", file_name);
+    jrnl_config.checkpointSize = config->checkpoint_size;
+    jrnl_config.syncWrites = (TMWTYPES_BOOL)config->sync_writes;
+    return sdnpjrnl_open(session, &jrnl_config);
+}
+
+static void snapshot_queue(TMWDLIST* list, enum journal_type_t type, struct journal_state_t* state)
+{
+    SDNPEVNT* event = (SDNPEVNT*)tmwdlist_getFirst(list);
+
+    state->num_events[type] = 0;
+    while (event != TMWDEFS_NULL && state->num_events[type] < MAX_EVENTS) {
+        struct journal_event_t* copy = &state->events[type][state->num_events[type]++];
+        copy->ms = event_ms(&event->timeStamp);
+        copy->point = event->point;
+        copy->flags = event->flags;
+        copy->value = 0;
+        if (type == TYPE_COUNTER) copy->value = ((SDNPEVNT_O022_EVENT*)event)->value;
+        event = (SDNPEVNT*)tmwdlist_getNext((TMWDLIST_MEMBER*)event);
+    }
+}
+
+static void snapshot(TMWSESN* session, struct journal_state_t* state)
+{
+    SDNPSESN* sdnp_session = (SDNPSESN*)session;
+    void* db = sdnp_session->pDbHandle;
+    TMWTYPES_USHORT i;
+
+    memset(state, 0, sizeof *state);
+    snapshot_queue(&sdnp_session->obj2Events, TYPE_BINARY, state);
+    snapshot_queue(&sdnp_session->obj22Events, TYPE_COUNTER, state);
+
+    for (i = 0; i < NUM_POINTS; i++) {
+        TMWTYPES_ULONG counter;
+
+        sdnpdata_binInRead(sdnpdata_binInGetPoint(db, i), &state->flags[TYPE_BINARY][i]);
+        sdnpdata_binCntrRead(sdnpdata_binCntrGetPoint(db, i), &counter, &state->flags[TYPE_COUNTER][i]);
+        state->values[TYPE_COUNTER][i] = counter;
+    }
+}
+
+static const struct journal_event_t* find_event(const struct journal_state_t* state, int type, uint64_t ms)
+{
+    int i;
+    for (i = 0; i < state->num_events[type]; i++) {
+        if (state->events[type][i].ms == ms) return &state->events[type][i];
+    }
+    return NULL;
+}
+
+static int same_event(const struct journal_event_t* a, const struct journal_event_t* b)
+{
+    return a->point == b->point && a->flags == b->flags && a->value == b->value;
+}
+
+/**
+ * @brief Check a restored state \p r against the states \p a and \p b
+ *        either side of the operation that may have been in progress.
+ *
+ * @returns 1 if the restored state is consistent.
+ */
+static int check_restored(const struct journal_state_t* a, const struct journal_state_t* b,
+                          const struct journal_state_t* r, char* reason, size_t reason_size)
+{
+    static const char* type_names[NUM_TYPES] = { "binary", "counter" };
+    int type, i;
+
+    for (type = 0; type < NUM_TYPES; type++) {
+        for (i = 0; i < r->num_events[type]; i++) {
+            const struct journal_event_t* event = &r->events[type][i];
+            const struct journal_event_t* in_a = find_event(a, type, event->ms);
+            const struct journal_event_t* in_b = find_event(b, type, event->ms);
+
+            if (i > 0 && r->events[type][i - 1].ms > event->ms) {
+                snprintf(reason, reason_size, "%s events out of order", type_names[type]);
+                return 0;
+            }
+            if (!(in_a && same_event(in_a, event)) && !(in_b && same_event(in_b, event))) {
+                snprintf(reason, reason_size, "unexpected %s event at +%llu ms", type_names[type],
+                         (unsigned long long)(event->ms - TIME_BASE_MS));
+                return 0;
+            }
+        }
+        for (i = 0; i < a->num_events[type]; i++) {
+            uint64_t ms = a->events[type][i].ms;
+            if (find_event(b, type, ms) && !find_event(r, type, ms)) {
+                snprintf(reason, reason_size, "lost %s event at +%llu ms", type_names[type],
+                         (unsigned long long)(ms - TIME_BASE_MS));
+                return 0;
+            }
+        }
+        for (i = 0; i < NUM_POINTS; i++) {
+            int matches_a = r->flags[type][i] == a->flags[type][i] && r->values[type][i] == a->values[type][i];
+            int matches_b = r->flags[type][i] == b->flags[type][i] && r->values[type][i] == b->values[type][i];
+            if (!matches_a && !matches_b) {
+                snprintf(reason, reason_size, "%s point %d restored as %lu flags 0x%02x", type_names[type], i,
+                         (unsigned long)r->values[type][i], r->flags[type][i]);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief The outstation: run operations until killed, writing the number
+ *        of each finished operation to \p fd.
+ */
+static void run_outstation(const struct journal_config_t* config, const char* file_name, unsigned int seed, int fd)
+{
+    TMWAPPL* appl = start_scl();
+    TMWCHNL* channel = open_channel(appl, config->port);
+    TMWSESN* session = channel ? open_session(channel) : TMWDEFS_NULL;
+    uint64_t operation;
+
+    if (session == TMWDEFS_NULL || !open_journal(session, config, file_name)) {
+        fprintf(stderr, "error: failed to open the outstation\n");
+        _exit(EXIT_FAILURE);
+    }
+    for (operation = 0; operation < MAX_OPERATIONS; operation++) {
+        uint32_t finished = (uint32_t)operation;
+        run_operation(session, seed, operation);
+        if (write(fd, &finished, sizeof finished) != (ssize_t)sizeof finished) _exit(EXIT_FAILURE);
+    }
+    _exit(EXIT_SUCCESS);
+}
+
+/**
+ * @brief Leave a forked process, \c _exit skips the stdio buffers.
+ */
+static void exit_child(int status)
+{
+    fflush(stdout);
+    _exit(status);
+}
+
+/**
+ * @brief The verifier: replay the journal after \p finished operations
+ *        and check it against states computed without a journal.
+ */
+static void run_verifier(const struct journal_config_t* config, const char* file_name, unsigned int seed,
+                         uint64_t finished)
+{
+    static struct journal_state_t a, b, r1, r2;
+    TMWAPPL* appl = start_scl();
+    TMWCHNL* channel = open_channel(appl, config->port + 1);
+    TMWSESN* session;
+    char reason[128];
+    uint64_t operation;
+
+    if (channel == TMWDEFS_NULL || (session = open_session(channel)) == TMWDEFS_NULL) {
+        fprintf(stderr, "error: failed to open the verifier\n");
+        exit_child(EXIT_FAILURE);
+    }
+    for (operation = 0; operation < finished; operation++) run_operation(session, seed, operation);
+    snapshot(session, &a);
+    run_operation(session, seed, finished);
+    snapshot(session, &b);
+    sdnpsesn_closeSession(session);
+
+    session = open_session(channel);
+    if (session == TMWDEFS_NULL || !open_journal(session, config, file_name)) {
+        printf("  journal could not be replayed\n");
+        exit_child(EXIT_FAILURE);
+    }
+    snapshot(session, &r1);
+    if (!check_restored(&a, &b, &r1, reason, sizeof reason)) {
+        printf("  inconsistent after %llu operations: %s\n", (unsigned long long)finished, reason);
+        exit_child(EXIT_FAILURE);
+    }
+    sdnpsesn_closeSession(session);
+
+    /* The checkpoints written when opening and closing must keep the state */
+    session = open_session(channel);
+    if (session == TMWDEFS_NULL || !open_journal(session, config, file_name)) {
+        printf("  journal could not be replayed a second time\n");
+        exit_child(EXIT_FAILURE);
+    }
+    snapshot(session, &r2);
+    if (memcmp(&r1, &r2, sizeof r1) != 0) {
+        printf("  second replay after %llu operations differs from the first\n", (unsigned long long)finished);
+        exit_child(EXIT_FAILURE);
+    }
+    sdnpsesn_closeSession(session);
+    exit_child(EXIT_SUCCESS);
+}
+
+static uint64_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Run the outstation, kill it after \p delay_ms and return the
+ *        number of operations it reported finishing.
+ */
+static uint64_t crash_outstation(const struct journal_config_t* config, const char* file_name, unsigned int seed,
+                                 int delay_ms)
+{
+    uint64_t deadline, finished = 0;
+    uint32_t reported[1024];
+    int fds[2], status;
+    pid_t pid;
+
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+    fflush(stdout);
+    pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        run_outstation(config, file_name, seed, fds[1]);
+    }
+    close(fds[1]);
+
+    /* Keep draining the pipe so the outstation never waits on it */
+    deadline = now_ms() + (uint64_t)delay_ms;
+    for (;;) {
+        struct pollfd pfd;
+        uint64_t now = now_ms();
+        ssize_t n;
+
+        if (now >= deadline) break;
+        pfd.fd = fds[0];
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, (int)(deadline - now)) <= 0) continue;
+        n = read(fds[0], reported, sizeof reported);
+        if (n <= 0) break;
+        if (n >= (ssize_t)sizeof reported[0]) finished = (uint64_t)reported[n / sizeof reported[0] - 1] + 1;
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, &status, 0);
+
+    /* Operations reported before the kill landed */
+    for (;;) {
+        ssize_t n = read(fds[0], reported, sizeof reported);
+        if (n <= 0) break;
+        if (n >= (ssize_t)sizeof reported[0]) finished = (uint64_t)reported[n / sizeof reported[0] - 1] + 1;
+    }
+    close(fds[0]);
+    return finished;
+}
+
+int main(int argc, char* argv[])
+{
+    struct journal_config_t config;
+    char file_name[SDNPJRNL_MAX_FILE_NAME];
+    int failures = 0, round, opt;
+
+    config.rounds = 50;
+    config.directory = "/tmp";
+    config.port = 20300;
+    config.checkpoint_size = 4096;
+    config.max_delay_ms = 200;
+    config.seed = (unsigned int)time(NULL);
+    config.sync_writes = 0;
+
+    while ((opt = getopt(argc, argv, "n:d:p:c:k:s:y")) != -1) {
+        switch (opt) {
+        case 'n': config.rounds = atoi(optarg); break;
+        case 'd': config.directory = optarg; break;
+        case 'p': config.port = atoi(optarg); break;
+        case 'c': config.checkpoint_size = strtoul(optarg, NULL, 10); break;
+        case 'k': config.max_delay_ms = atoi(optarg); break;
+        case 's': config.seed = (unsigned int)strtoul(optarg, NULL, 10); break;
+        case 'y': config.sync_writes = 1; break;
+        default:
+            fprintf(stderr, "usage: %s [-n rounds] [-d directory] [-p port] [-c checkpointSize] [-k maxDelayMs] "
+                            "[-s seed] [-y]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (config.max_delay_ms < 1) config.max_delay_ms = 1;
+
+    snprintf(file_name, sizeof file_name, "%s/dnp_journal_crash.%d.jrnl", config.directory, (int)getpid());
+    printf("%d rounds, seed %u, checkpoint every %lu bytes%s, journal %s\n", config.rounds, config.seed,
+           config.checkpoint_size, config.sync_writes ? " with synchronous writes" : "", file_name);
+
+    srand(config.seed);
+    for (round = 0; round < config.rounds; round++) {
+        unsigned int seed = config.seed + (unsigned int)round;
+        int delay_ms = rand() % config.max_delay_ms + 1;
+        uint64_t finished;
+        int status;
+        pid_t pid;
+
+        unlink(file_name);
+        finished = crash_outstation(&config, file_name, seed, delay_ms);
+
+        fflush(stdout);
+        pid = fork();
+        if (pid == 0) run_verifier(&config, file_name, seed, finished);
+        waitpid(pid, &status, 0);
+
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            failures++;
+            printf("round %d: FAILED, seed %u, killed after %d ms and %llu operations\n", round, seed, delay_ms,
+                   (unsigned long long)finished);
+        } else {
+            printf("round %d: ok, killed after %d ms and %llu operations\n", round, delay_ms,
+                   (unsigned long long)finished);
+        }
+    }
+
+    unlink(file_name);
+    printf("%d of %d rounds restored a consistent state\n", config.rounds - failures, config.rounds);
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file
+ * Benchmark for routing received frames to their session in the DNP3 link
+ * layer, comparing the session hash with a linear search.
+ *
+ * The outstation runs in this process with one channel on an in-memory
+ * physical layer, as in dnp_codec_bench, and the given numbers of
+ * sessions on it. Frames are handed straight to dnplink_parseBytes,
+ * addressed to each session in turn, and the transport layer is stubbed
+ * out to check that every frame reached the session it was addressed to.
+ *
+ * After every frame the link layer also asks each session in turn whether
+ * it has data to send, which costs the same whichever way the session was
+ * found. While routing is timed that question is answered by a stub, but
+ * the walk over the sessions is still O(sessions) per frame and is most
+ * of the time per frame, so the hash only shortens the part of it spent
+ * finding the session. The time per frame with the real check is shown
+ * separately.
+ *
+ * Each session count is timed three times both ways, keeping the fastest:
+ *   - hash: the link layer's table of sessions hashed on their local
+ *     address, DNPCNFG_LINK_SESSION_HASH_SIZE buckets
+ *   - linear: every bucket pointed at one chain of all the sessions in the
+ *     order they were opened, so each frame searches the sessions one at a
+ *     time the way the link layer did before the table
+ *
+ * Usage:
+ *   dnp_link_routing [-t msPerBenchmark] [-s sessions[,sessions...]]
+ *
+ * The default session counts are 1, 32 and 250. Exits with failure if a
+ * frame reaches the wrong session. The speedup is reported, not checked,
+ * since the walk above leaves it small and within run to run noise.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnplink.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define MASTER_ADDR      3
+#define FIRST_ADDR       100
+#define MAX_SESSIONS     1000
+#define MAX_COUNTS       8
+#define FRAME_LEN        15
+#define REPEATS          3
+
+struct routing_t {
+    TMWCHNL* channel;
+    DNPLINK_CONTEXT* link;
+    TMWSESN* sessions[MAX_SESSIONS];
+    int num_sessions;
+
+    /* One frame addressed to each session */
+    uint8_t frames[MAX_SESSIONS][FRAME_LEN];
+    int next_frame;
+
+    /* Checked by the stubbed transport layer */
+    TMWSESN* expected;
+    unsigned long frames_routed;
+    unsigned long frames_misrouted;
+};
+
+static long bench_ms = 200;
+static struct routing_t* mem_routing;
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* ---- Outstation ---- */
+
+/**
+ * @brief Open an outstation channel on the in-memory physical layer and
+ *        \p num_sessions sessions on it, at local addresses FIRST_ADDR on.
+ */
+static int open_outstation(struct routing_t* routing, TMWAPPL* appl, int num_sessions)
+{
+    struct outstation_config_t config;
+    int i;
+
+    /* Frames the outstation sends are dropped */
+    routing->channel = open_mem_channel(appl, &config, "routing");
+    if (routing->channel == TMWDEFS_NULL) return -1;
+    routing->link = (DNPLINK_CONTEXT*)routing->channel->pLinkContext;
+    mem_routing = routing;
+
+    config.sesn.destination = MASTER_ADDR;
+    for (i = 0; i < num_sessions; i++) {
+        config.sesn.source = (TMWTYPES_USHORT)(FIRST_ADDR + i);
+        routing->sessions[i] = sdnpsesn_openSession(routing->channel, &config.sesn, TMWDEFS_NULL);
+        if (routing->sessions[i] == TMWDEFS_NULL) return -1;
+    }
+    routing->num_sessions = num_sessions;
+
+    tmwlink_openChannel((TMWLINK_CONTEXT*)routing->channel->pLinkContext);
+    return 0;
+}
+
+static void close_outstation(struct routing_t* routing)
+{
+    int i;
+
+    for (i = 0; i < routing->num_sessions; i++) {
+        sdnpsesn_closeSession(routing->sessions[i]);
+    }
+    routing->num_sessions = 0;
+    dnpchnl_closeChannel(routing->channel);
+}
+
+/**
+ * @brief Build an unconfirmed user data frame from the master to
+ *        \p address, with a transport header and a two byte request.
+ */
+static void build_frame(uint8_t* frame, int address)
+{
+    uint16_t crc;
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = 5 + 3;
+    frame[3] = 0xC4;    /* DIR | PRM | UNCONFIRMED USER DATA */
+    frame[4] = (uint8_t)(address & 0xff);
+    frame[5] = (uint8_t)(address >> 8);
+    frame[6] = MASTER_ADDR & 0xff;
+    frame[7] = MASTER_ADDR >> 8;
+    crc = dnplink_computeCRC(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+
+    frame[10] = 0xC0;   /* FIR | FIN */
+    frame[11] = 0xC0;   /* FIR | FIN */
+    frame[12] = 0x01;   /* READ */
+    crc = dnplink_computeCRC(frame + 10, 3);
+    frame[13] = (uint8_t)(crc & 0xff);
+    frame[14] = (uint8_t)(crc >> 8);
+}
+
+/**
+ * @brief Check the frame reached the session it was addressed to.
+ */
+static void TMWDEFS_CALLBACK route_frame(void* pParam, TMWSESN* pSession, TMWSESN_RX_DATA* pRxData)
+{
+    TMWTARG_UNUSED_PARAM(pParam);
+    TMWTARG_UNUSED_PARAM(pRxData);
+    if (pSession == mem_routing->expected) {
+        mem_routing->frames_routed++;
+    } else {
+        mem_routing->frames_misrouted++;
+    }
+}
+
+/**
+ * @brief Report that no session has data to send.
+ */
+static TMWTYPES_BOOL TMWDEFS_CALLBACK no_data(void* pParam, TMWSESN* pSession,
+                                              TMWDEFS_CLASS_MASK classMask, TMWTYPES_BOOL buildResponse)
+{
+    TMWTARG_UNUSED_PARAM(pParam);
+    TMWTARG_UNUSED_PARAM(pSession);
+    TMWTARG_UNUSED_PARAM(classMask);
+    TMWTARG_UNUSED_PARAM(buildResponse);
+    return TMWDEFS_FALSE;
+}
+
+/**
+ * @brief Hand the next frame to the link layer, noting the session it is
+ *        addressed to.
+ */
+static void parse_next_frame(struct routing_t* routing)
+{
+    int i = routing->next_frame;
+
+    routing->next_frame = (i + 1) % routing->num_sessions;
+    routing->expected = routing->sessions[i];
+    feed_link(routing->channel, routing->frames[i], FRAME_LEN);
+}
+
+/**
+ * @brief Point every hash bucket at one chain of all the sessions, in the
+ *        order they were opened, saving the table in \p saved.
+ */
+static void use_linear_search(struct routing_t* routing, TMWSESN** saved, TMWSESN** saved_next)
+{
+    int i;
+
+    for (i = 0; i < routing->num_sessions; i++) {
+        DNPLINK_SESSION_INFO* info = (DNPLINK_SESSION_INFO*)routing->sessions[i]->pLinkSession;
+        saved_next[i] = info->pNextHashSession;
+        info->pNextHashSession = (i + 1 < routing->num_sessions) ? routing->sessions[i + 1] : TMWDEFS_NULL;
+    }
+    for (i = 0; i < DNPCNFG_LINK_SESSION_HASH_SIZE; i++) {
+        saved[i] = routing->link->pSessionHash[i];
+        routing->link->pSessionHash[i] = routing->sessions[0];
+    }
+}
+
+static void restore_hash(struct routing_t* routing, TMWSESN** saved, TMWSESN** saved_next)
+{
+    int i;
+
+    for (i = 0; i < routing->num_sessions; i++) {
+        ((DNPLINK_SESSION_INFO*)routing->sessions[i]->pLinkSession)->pNextHashSession = saved_next[i];
+    }
+    for (i = 0; i < DNPCNFG_LINK_SESSION_HASH_SIZE; i++) {
+        routing->link->pSessionHash[i] = saved[i];
+    }
+}
+
+/**
+ * @brief Route frames for bench_ms and return the nanoseconds per frame.
+ */
+static double run(struct routing_t* routing)
+{
+    uint64_t start, elapsed, deadline;
+    unsigned long ops = 0, batch = 1;
+    double ns;
+
+    /* Warm up */
+    for (routing->next_frame = 0; routing->next_frame + 1 < routing->num_sessions;) {
+        parse_next_frame(routing);
+    }
+    parse_next_frame(routing);
+
+    start = now_ns();
+    deadline = start + (uint64_t)bench_ms * 1000000u;
+    do {
+        unsigned long i;
+        for (i = 0; i < batch; i++) parse_next_frame(routing);
+        ops += batch;
+        if (batch < 1u << 16) batch *= 2;
+        elapsed = now_ns() - start;
+    } while (now_ns() < deadline);
+
+    ns = (double)elapsed / (double)ops;
+    return ns;
+}
+
+int main(int argc, char* argv[])
+{
+    static struct routing_t routing;
+    static TMWSESN* saved[DNPCNFG_LINK_SESSION_HASH_SIZE];
+    static TMWSESN* saved_next[MAX_SESSIONS];
+    TMWLINK_PARSE_FUNC link_parse;
+    TMWLINK_CHECK_CLASS_FUNC link_check_class;
+    TMWAPPL* appl;
+    int counts[MAX_COUNTS] = { 1, 32, 250 };
+    int num_counts = 3;
+    int result = EXIT_SUCCESS;
+    int opt, c, i, r;
+
+    while ((opt = getopt(argc, argv, "t:s:")) != -1) {
+        switch (opt) {
+        case 't': bench_ms = atol(optarg); break;
+        case 's': {
+            char* next = optarg;
+            num_counts = 0;
+            while (*next != '\0' && num_counts < MAX_COUNTS) {
+                counts[num_counts] = (int)strtol(next, &next, 10);
+                if (counts[num_counts] < 1 || counts[num_counts] > MAX_SESSIONS) {
+                    fprintf(stderr, "error: sessions must be 1 to %d\n", MAX_SESSIONS);
+                    exit(EXIT_FAILURE);
+                }
+                num_counts++;
+                if (*next == ',') next++;
+            }
+            break;
+        }
+        default:
+            fprintf(stderr, "usage: %s [-t msPerBenchmark] [-s sessions[,sessions...]]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (bench_ms < 1) bench_ms = 1;
+
+    appl = start_scl();
+    printf("%8s  %16s  %16s  %7s  %26s\n", "sessions", "hash", "linear", "speedup", "hash with transmit check");
+
+    for (c = 0; c < num_counts; c++) {
+        double hash_ns = 0, linear_ns = 0, full_ns;
+
+        if (open_outstation(&routing, appl, counts[c]) != 0) {
+            fprintf(stderr, "error: failed to open %d sessions\n", counts[c]);
+            exit(EXIT_FAILURE);
+        }
+        for (i = 0; i < routing.num_sessions; i++) {
+            build_frame(routing.frames[i], FIRST_ADDR + i);
+        }
+
+        /* Stub out the transport layer to check where each frame went */
+        link_parse = routing.link->tmw.pParseFunc;
+        routing.link->tmw.pParseFunc = route_frame;
+
+        /* Alternate the two so both see the same machine load */
+        link_check_class = routing.link->tmw.pCheckClassFunc;
+        routing.link->tmw.pCheckClassFunc = no_data;
+        for (r = 0; r < REPEATS; r++) {
+            double ns = run(&routing);
+            if (r == 0 || ns < hash_ns) hash_ns = ns;
+
+            use_linear_search(&routing, saved, saved_next);
+            ns = run(&routing);
+            if (r == 0 || ns < linear_ns) linear_ns = ns;
+            restore_hash(&routing, saved, saved_next);
+        }
+        routing.link->tmw.pCheckClassFunc = link_check_class;
+        full_ns = run(&routing);
+
+        printf("%8d  %8.1f ns/frame  %8.1f ns/frame  %6.2fx  %17.1f ns/frame\n", routing.num_sessions,
+               hash_ns, linear_ns, linear_ns / hash_ns, full_ns);
+
+        routing.link->tmw.pParseFunc = link_parse;
+        if (routing.frames_misrouted != 0 || routing.frames_routed == 0) {
+            printf("error: %lu of %lu frames reached the wrong session\n", routing.frames_misrouted,
+                   routing.frames_misrouted + routing.frames_routed);
+            result = EXIT_FAILURE;
+        }
+        routing.frames_routed = 0;
+        routing.frames_misrouted = 0;
+        close_outstation(&routing);
+    }
+
+    return result;
+}
@@ -0,0 +1,700 @@
+/**
+ * @file
+ * A loopback load generator and latency benchmark for the DNP3 outstation.
+ *
+ * The outstation runs in this process on the simulated database, with one
+ * TCP channel and session per simulated master on ports port..port+n-1 of
+ * the loopback address. Each master is a thread with a small built-in
+ * DNP3 master that issues integrity polls, event polls and CROB
+ * select/operate pairs at the configured rates, and confirms every
+ * response that asks for it. An event thread adds binary input events to
+ * every session at a fixed rate. Each master does an untimed integrity poll
+ * after connecting, and the run starts once every master has done one.
+ *
+ * The report shows requests per second and p50/p99/p999 latency for each
+ * request type, plus the event end-to-end latency: the time from adding
+ * an event on the outstation to the master receiving it in a response.
+ *
+ * Usage:
+ *   dnp_master_load [-s sessions] [-p port] [-t seconds] [-i integrityPerSec]
+ *                   [-e eventPollsPerSec] [-c crobsPerSec] [-g eventsPerSec]
+ *                   [-m metricsFile]
+ *
+ * Rates are per session. A rate of 0 disables that request type. With -m
+ * the outstation's runtime metrics are written to metricsFile in the
+ * Prometheus text format at the end of the run.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/utils/tmwpltmr.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnputil.h"
+#include "tmwscl/dnp/sdnpo002.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwtargio.h"
+#include "tmwtargmt.h"
+#include "templates/dnp_outstation.h"
+
+#define MASTER_ADDR            3
+#define OUTSTATION_ADDR        4
+#define MAX_SAMPLES            200000
+#define RESPONSE_TIMEOUT_MS    5000
+#define EVENT_RING_SIZE        4096
+#define MAX_FRAGMENT           4096
+
+/* Application layer function codes and control bits */
+#define APP_FC_CONFIRM         0x00
+#define APP_FC_READ            0x01
+#define APP_FC_SELECT          0x03
+#define APP_FC_OPERATE         0x04
+#define APP_FIR                0x80
+#define APP_FIN                0x40
+#define APP_CON                0x20
+#define APP_UNS                0x10
+
+#define IIN2_EVENT_OVERFLOW    0x08
+
+enum load_request_t {
+    REQUEST_INTEGRITY,
+    REQUEST_EVENT_POLL,
+    REQUEST_CROB,
+    NUM_REQUEST_TYPES
+};
+
+static const char* request_names[NUM_REQUEST_TYPES] = {
+    "integrity poll", "event poll", "crob select/operate"
+};
+
+struct load_config_t {
+    int num_sessions;
+    int port;
+    int seconds;
+    double rates[NUM_REQUEST_TYPES];
+    double event_rate;
+    const char* metrics_file;
+};
+
+struct load_samples_t {
+    unsigned long count;
+    unsigned long num_samples;
+    uint32_t* samples_us;
+};
+
+/* Times at which the outstation added the events a master has not seen yet */
+struct event_ring_t {
+    pthread_mutex_t lock;
+    uint64_t added_us[EVENT_RING_SIZE];
+    unsigned long head;
+    unsigned long tail;
+    unsigned long dropped;
+};
+
+struct load_master_t {
+    const struct load_config_t* config;
+    int index;
+    volatile int* stop;
+    volatile int* start;
+    volatile int* ready;
+    int sockfd;
+    uint8_t app_seq;
+    uint8_t tprt_seq;
+    struct event_ring_t events;
+    struct load_samples_t requests[NUM_REQUEST_TYPES];
+    struct load_samples_t event_latency;
+    unsigned long events_received;
+    unsigned long overflows;
+    unsigned long failed;
+    /* Received link user data, reassembled */
+    uint8_t rx[MAX_FRAGMENT];
+    size_t rx_len;
+    uint8_t stream[2048];
+    size_t stream_len;
+};
+
+static void add_sample(struct load_samples_t* samples, uint64_t us)
+{
+    samples->count++;
+    if (samples->num_samples < MAX_SAMPLES) {
+        samples->samples_us[samples->num_samples++] = (uint32_t)us;
+    }
+}
+
+/* ---- Outstation ---- */
+
+/**
+ * @brief Open one outstation channel and session listening on \p port.
+ */
+static TMWSESN* open_outstation(TMWAPPL* appl, int port)
+{
+    struct outstation_config_t config;
+    char name[16];
+    TMWSESN* session;
+
+    snprintf(name, sizeof name, "Load%d", port);
+    init_outstation_config(&config, name, port);
+    config.io.targTCP.polledMode = TMWDEFS_FALSE;
+    config.io.targTCP.disconnectOnNewSyn = TMWDEFS_TRUE;
+    config.sesn.source = OUTSTATION_ADDR;
+    config.sesn.destination = MASTER_ADDR;
+    config.sesn.binaryInputMaxEvents = EVENT_RING_SIZE / 4;
+
+    session = open_outstation_session(appl, &config);
+    if (session != TMWDEFS_NULL) {
+        /* A binary output for the CROBs, without events */
+        sdnpsim_addBinaryOutput(((SDNPSESN*)session)->pDbHandle, TMWDEFS_CLASS_MASK_NONE, 0x01, TMWDEFS_FALSE,
+                                SDNPDATA_CROB_CTRL_LATCH_ON | SDNPDATA_CROB_CTRL_LATCH_OFF);
+    }
+    return session;
+}
+
+struct event_thread_t {
+    const struct load_config_t* config;
+    TMWSESN** sessions;
+    struct load_master_t* masters;
+    volatile int* stop;
+};
+
+void* event_generator(void* arg)
+{
+    struct event_thread_t* thread = (struct event_thread_t*)arg;
+    const struct load_config_t* config = thread->config;
+    uint64_t interval_us = (uint64_t)(1000000.0 / config->event_rate);
+    uint64_t next = now_us();
+    unsigned long n = 0;
+    int i;
+
+    while (!*thread->stop) {
+        uint64_t now = now_us();
+        if (now < next) {
+            usleep((useconds_t)(next - now));
+            continue;
+        }
+        next += interval_us;
+
+        for (i = 0; i < config->num_sessions; i++) {
+            struct event_ring_t* ring = &thread->masters[i].events;
+            TMWDTIME time_stamp;
+
+            sdnputil_getDateTime(thread->sessions[i], &time_stamp);
+            pthread_mutex_lock(&ring->lock);
+            if (ring->head - ring->tail < EVENT_RING_SIZE) {
+                ring->added_us[ring->head++ % EVENT_RING_SIZE] = now_us();
+                pthread_mutex_unlock(&ring->lock);
+                sdnpo002_addEvent(thread->sessions[i], 0, (TMWTYPES_UCHAR)((n & 1) ? 0x81 : 0x01), &time_stamp);
+            } else {
+                ring->dropped++;
+                pthread_mutex_unlock(&ring->lock);
+            }
+        }
+        n++;
+    }
+    return NULL;
+}
+
+/* ---- Master ---- */
+
+static int connect_master(int port)
+{
+    struct sockaddr_in addr;
+    int sockfd, one = 1, attempt;
+
+    for (attempt = 0; attempt < 100; attempt++) {
+        sockfd = socket(AF_INET, SOCK_STREAM, 0);
+        if (sockfd == -1) return -1;
+        memset(&addr, 0, sizeof addr);
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons((uint16_t)port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(sockfd, (struct sockaddr*)&addr, sizeof addr) == 0) {
+            setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+            return sockfd;
+        }
+        close(sockfd);
+        usleep(50000);
+    }
+    return -1;
+}
+
+/**
+ * @brief Send one application fragment in a single link frame.
+ */
+static int send_fragment(struct load_master_t* master, const uint8_t* app, size_t app_len)
+{
+    uint8_t user[250];
+    uint8_t frame[292];
+    size_t user_len = app_len + 1;
+    size_t pos, frame_len = 10;
+    uint16_t crc;
+
+    user[0] = (uint8_t)(0xC0 | (master->tprt_seq++ & 0x3f));
+    memcpy(user + 1, app, app_len);
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = (uint8_t)(5 + user_len);
+    frame[3] = 0xC4;    /* DIR | PRM | UNCONFIRMED USER DATA */
+    frame[4] = (uint8_t)(OUTSTATION_ADDR & 0xff);
+    frame[5] = (uint8_t)(OUTSTATION_ADDR >> 8);
+    frame[6] = (uint8_t)(MASTER_ADDR & 0xff);
+    frame[7] = (uint8_t)(MASTER_ADDR >> 8);
+    crc = dnp_crc(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+
+    for (pos = 0; pos < user_len; pos += 16) {
+        size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+        memcpy(frame + frame_len, user + pos, block);
+        crc = dnp_crc(user + pos, block);
+        frame_len += block;
+        frame[frame_len++] = (uint8_t)(crc & 0xff);
+        frame[frame_len++] = (uint8_t)(crc >> 8);
+    }
+
+    return send(master->sockfd, frame, frame_len, MSG_NOSIGNAL) == (ssize_t)frame_len ? 0 : -1;
+}
+
+/**
+ * @brief Read link frames until a whole application fragment has arrived
+ *        in master->rx.
+ *
+ * @returns 0 on success, -1 on a timeout or error.
+ */
+static int read_fragment(struct load_master_t* master)
+{
+    struct pollfd pfd;
+
+    pfd.fd = master->sockfd;
+    pfd.events = POLLIN;
+    master->rx_len = 0;
+
+    for (;;) {
+        /* Handle every complete frame in the stream */
+        while (master->stream_len >= 10) {
+            uint8_t* frame = master->stream;
+            size_t user_len, frame_len, pos, out;
+
+            if (frame[0] != 0x05 || frame[1] != 0x64 || frame[2] < 5) return -1;
+            user_len = (size_t)frame[2] - 5;
+            frame_len = 10 + user_len + 2 * ((user_len + 15) / 16);
+            if (master->stream_len < frame_len) break;
+
+            /* Skip link layer frames without user data */
+            if (user_len > 0) {
+                uint8_t tprt = frame[10];
+                out = master->rx_len;
+                if (tprt & 0x40) out = 0;
+                for (pos = 0; pos < user_len; pos += 16) {
+                    size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+                    size_t skip = (pos == 0) ? 1 : 0;
+                    if (out + block > sizeof master->rx) return -1;
+                    memcpy(master->rx + out, frame + 10 + pos + 2 * (pos / 16) + skip, block - skip);
+                    out += block - skip;
+                }
+                master->rx_len = out;
+                memmove(master->stream, master->stream + frame_len, master->stream_len - frame_len);
+                master->stream_len -= frame_len;
+                if (tprt & 0x80) return 0;
+                continue;
+            }
+            memmove(master->stream, master->stream + frame_len, master->stream_len - frame_len);
+            master->stream_len -= frame_len;
+        }
+
+        if (poll(&pfd, 1, RESPONSE_TIMEOUT_MS) <= 0) return -1;
+        {
+            ssize_t n = recv(master->sockfd, master->stream + master->stream_len,
+                             sizeof master->stream - master->stream_len, 0);
+            if (n <= 0) return -1;
+            master->stream_len += (size_t)n;
+        }
+    }
+}
+
+/**
+ * @brief Count the binary input events at the start of a response and
+ *        take their add times off the session's ring.
+ */
+static void count_events(struct load_master_t* master, uint64_t received)
+{
+    const uint8_t* p = master->rx + 4;
+    const uint8_t* end = master->rx + master->rx_len;
+
+    if (master->rx_len < 4) return;
+
+    if (master->rx[3] & IIN2_EVENT_OVERFLOW) {
+        /* Events were lost, so the ring no longer lines up */
+        master->overflows++;
+    }
+
+    while (p + 3 <= end) {
+        uint8_t group = p[0], variation = p[1], qualifier = p[2];
+        size_t count, prefix, size, i;
+
+        p += 3;
+        switch (qualifier & 0x0f) {
+        case 0x07: if (p + 1 > end) return; count = p[0]; p += 1; break;
+        case 0x08: if (p + 2 > end) return; count = (size_t)p[0] | ((size_t)p[1] << 8); p += 2; break;
+        default: return;
+        }
+        switch (qualifier >> 4) {
+        case 0: prefix = 0; break;
+        case 1: prefix = 1; break;
+        case 2: prefix = 2; break;
+        default: return;
+        }
+
+        if (group == 51) {
+            size = 6;
+        } else if (group == 2) {
+            size = (variation == 1) ? 1 : (variation == 2) ? 7 : (variation == 3) ? 3 : 0;
+            if (size == 0) return;
+        } else {
+            /* Events come first, the rest of the response is static data */
+            return;
+        }
+        if (p + count * (prefix + size) > end) return;
+        p += count * (prefix + size);
+
+        if (group != 2) continue;
+        pthread_mutex_lock(&master->events.lock);
+        for (i = 0; i < count && master->events.tail != master->events.head; i++) {
+            uint64_t added = master->events.added_us[master->events.tail++ % EVENT_RING_SIZE];
+            add_sample(&master->event_latency, received - added);
+        }
+        pthread_mutex_unlock(&master->events.lock);
+        master->events_received += count;
+    }
+}
+
+/**
+ * @brief Send a request and read every fragment of its response,
+ *        confirming fragments that ask for it.
+ *
+ * @returns 0 on success, -1 on failure.
+ */
+static int transaction(struct load_master_t* master, uint8_t function, const uint8_t* objects, size_t len)
+{
+    uint8_t request[64];
+    uint8_t seq = master->app_seq;
+
+    master->app_seq = (uint8_t)((master->app_seq + 1) & 0x0f);
+    request[0] = (uint8_t)(APP_FIR | APP_FIN | seq);
+    request[1] = function;
+    memcpy(request + 2, objects, len);
+    if (send_fragment(master, request, len + 2) != 0) return -1;
+
+    for (;;) {
+        uint8_t control;
+
+        if (read_fragment(master) != 0 || master->rx_len < 4) return -1;
+        control = master->rx[0];
+
+        /* Unsolicited responses are not enabled, ignore anything else */
+        if ((control & APP_UNS) || (control & 0x0f) != seq) continue;
+
+        count_events(master, now_us());
+        if (control & APP_CON) {
+            uint8_t confirm[2];
+            confirm[0] = (uint8_t)(APP_FIR | APP_FIN | (control & 0x0f));
+            confirm[1] = APP_FC_CONFIRM;
+            if (send_fragment(master, confirm, sizeof confirm) != 0) return -1;
+        }
+        if (control & APP_FIN) return 0;
+        seq = (uint8_t)((seq + 1) & 0x0f);
+    }
+}
+
+static int integrity_poll(struct load_master_t* master)
+{
+    static const uint8_t objects[] = {
+        60, 2, 0x06, 60, 3, 0x06, 60, 4, 0x06, 60, 1, 0x06
+    };
+    return transaction(master, APP_FC_READ, objects, sizeof objects);
+}
+
+static int event_poll(struct load_master_t* master)
+{
+    static const uint8_t objects[] = {
+        60, 2, 0x06, 60, 3, 0x06, 60, 4, 0x06
+    };
+    return transaction(master, APP_FC_READ, objects, sizeof objects);
+}
+
+static int crob(struct load_master_t* master, int on)
+{
+    /* g12v1, 2 byte count and index, point 0 */
+    uint8_t objects[] = {
+        12, 1, 0x28, 1, 0, 0, 0,
+        0x03, 1, 100, 0, 0, 0, 0, 0, 0, 0, 0
+    };
+    objects[7] = (uint8_t)(on ? 0x03 : 0x04);    /* LATCH ON or LATCH OFF */
+    if (transaction(master, APP_FC_SELECT, objects, sizeof objects) != 0) return -1;
+    return transaction(master, APP_FC_OPERATE, objects, sizeof objects);
+}
+
+void* load_master(void* arg)
+{
+    struct load_master_t* master = (struct load_master_t*)arg;
+    const struct load_config_t* config = master->config;
+    uint64_t next[NUM_REQUEST_TYPES];
+    uint64_t interval[NUM_REQUEST_TYPES];
+    unsigned long crobs = 0;
+    int type;
+
+    master->sockfd = connect_master(config->port + master->index);
+    if (master->sockfd == -1 || integrity_poll(master) != 0) {
+        master->failed++;
+        __sync_fetch_and_add(master->ready, 1);
+        if (master->sockfd != -1) close(master->sockfd);
+        return NULL;
+    }
+    __sync_fetch_and_add(master->ready, 1);
+    while (!*master->start && !*master->stop) usleep(1000);
+
+    /* Spread the sessions' first requests over one interval */
+    for (type = 0; type < NUM_REQUEST_TYPES; type++) {
+        interval[type] = config->rates[type] > 0 ? (uint64_t)(1000000.0 / config->rates[type]) : 0;
+        next[type] = now_us() + (interval[type] * (uint64_t)master->index) / (uint64_t)config->num_sessions;
+    }
+
+    while (!*master->stop) {
+        uint64_t start = now_us();
+        int due = -1, result;
+
+        for (type = 0; type < NUM_REQUEST_TYPES; type++) {
+            if (interval[type] != 0 && (due == -1 || next[type] < next[due])) due = type;
+        }
+        if (due == -1) break;
+        if (next[due] > start) {
+            uint64_t wait = next[due] - start;
+            usleep((useconds_t)(wait > 100000 ? 100000 : wait));
+            continue;
+        }
+        next[due] += interval[due];
+
+        switch (due) {
+        case REQUEST_INTEGRITY: result = integrity_poll(master); break;
+        case REQUEST_EVENT_POLL: result = event_poll(master); break;
+        default: result = crob(master, (int)(crobs++ & 1)); break;
+        }
+        if (result != 0) {
+            master->failed++;
+            break;
+        }
+        add_sample(&master->requests[due], now_us() - start);
+    }
+    close(master->sockfd);
+    return NULL;
+}
+
+/* ---- Report ---- */
+
+/**
+ * @brief Merge the samples of every master and print their percentiles.
+ */
+static void report(const char* name, struct load_samples_t** per_master, int num_masters, int seconds)
+{
+    unsigned long count = 0, num_samples = 0;
+    uint32_t* samples;
+    int i;
+
+    for (i = 0; i < num_masters; i++) {
+        count += per_master[i]->count;
+        num_samples += per_master[i]->num_samples;
+    }
+    printf("%-20s %9lu %10.1f/s", name, count, (double)count / seconds);
+    if (num_samples == 0) {
+        printf("\n");
+        return;
+    }
+
+    samples = malloc(num_samples * sizeof(uint32_t));
+    if (samples == NULL) {
+        printf("\n");
+        return;
+    }
+    num_samples = 0;
+    for (i = 0; i < num_masters; i++) {
+        memcpy(samples + num_samples, per_master[i]->samples_us, per_master[i]->num_samples * sizeof(uint32_t));
+        num_samples += per_master[i]->num_samples;
+    }
+    qsort(samples, num_samples, sizeof(uint32_t), compare_u32);
+    printf("   p50 %7u  p99 %7u  p999 %7u  max %7u us\n",
+           samples[num_samples / 2], samples[num_samples * 99 / 100],
+           samples[num_samples * 999 / 1000], samples[num_samples - 1]);
+    free(samples);
+}
+
+int main(int argc, char* argv[])
+{
+    struct load_config_t config;
+    struct load_master_t* masters;
+    struct load_samples_t** per_master;
+    struct event_thread_t event_thread;
+    TMWSESN** sessions;
+    pthread_t* threads;
+    pthread_t event_id;
+    TMWAPPL* appl;
+    volatile int stop = 0;
+    volatile int start = 0;
+    volatile int ready = 0;
+    unsigned long total = 0, events = 0, dropped = 0, overflows = 0, failed = 0;
+    uint64_t end;
+    int opt, i, type;
+
+    config.num_sessions = 4;
+    config.port = 20100;
+    config.seconds = 10;
+    config.rates[REQUEST_INTEGRITY] = 1;
+    config.rates[REQUEST_EVENT_POLL] = 20;
+    config.rates[REQUEST_CROB] = 2;
+    config.event_rate = 50;
+    config.metrics_file = NULL;
+
+    while ((opt = getopt(argc, argv, "s:p:t:i:e:c:g:m:")) != -1) {
+        switch (opt) {
+        case 's': config.num_sessions = atoi(optarg); break;
+        case 'p': config.port = atoi(optarg); break;
+        case 't': config.seconds = atoi(optarg); break;
+        case 'i': config.rates[REQUEST_INTEGRITY] = atof(optarg); break;
+        case 'e': config.rates[REQUEST_EVENT_POLL] = atof(optarg); break;
+        case 'c': config.rates[REQUEST_CROB] = atof(optarg); break;
+        case 'g': config.event_rate = atof(optarg); break;
+        case 'm': config.metrics_file = optarg; break;
+        default:
+            fprintf(stderr, "usage: %s [-s sessions] [-p port] [-t seconds] [-i integrityPerSec]\n"
+                            "       [-e eventPollsPerSec] [-c crobsPerSec] [-g eventsPerSec]\n"
+                            "       [-m metricsFile]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (config.num_sessions < 1) config.num_sessions = 1;
+    if (config.seconds < 1) config.seconds = 1;
+
+    masters = calloc((size_t)config.num_sessions, sizeof *masters);
+    sessions = calloc((size_t)config.num_sessions, sizeof *sessions);
+    threads = calloc((size_t)config.num_sessions, sizeof *threads);
+    per_master = calloc((size_t)config.num_sessions, sizeof *per_master);
+    if (masters == NULL || sessions == NULL || threads == NULL || per_master == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Start the outstation */
+    appl = start_scl();
+    for (i = 0; i < config.num_sessions; i++) {
+        sessions[i] = open_outstation(appl, config.port + i);
+        if (sessions[i] == TMWDEFS_NULL) {
+            fprintf(stderr, "error: failed to open outstation on port %d\n", config.port + i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("%d sessions on 127.0.0.1:%d-%d for %d seconds\n", config.num_sessions, config.port,
+           config.port + config.num_sessions - 1, config.seconds);
+    printf("per session: %.1f integrity/s, %.1f event polls/s, %.1f crobs/s, %.1f events/s\n",
+           config.rates[REQUEST_INTEGRITY], config.rates[REQUEST_EVENT_POLL], config.rates[REQUEST_CROB],
+           config.event_rate);
+
+    for (i = 0; i < config.num_sessions; i++) {
+        masters[i].config = &config;
+        masters[i].index = i;
+        masters[i].stop = &stop;
+        masters[i].start = &start;
+        masters[i].ready = &ready;
+        pthread_mutex_init(&masters[i].events.lock, NULL);
+        for (type = 0; type < NUM_REQUEST_TYPES; type++) {
+            masters[i].requests[type].samples_us = malloc(MAX_SAMPLES * sizeof(uint32_t));
+            if (masters[i].requests[type].samples_us == NULL) {
+                fprintf(stderr, "error: out of memory\n");
+                exit(EXIT_FAILURE);
+            }
+        }
+        masters[i].event_latency.samples_us = malloc(MAX_SAMPLES * sizeof(uint32_t));
+        if (masters[i].event_latency.samples_us == NULL) {
+            fprintf(stderr, "error: out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        if (pthread_create(&threads[i], NULL, load_master, &masters[i])) {
+            fprintf(stderr, "error: failed to start master %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* The outstation uses the polled timer */
+    while (ready < config.num_sessions) {
+        tmwpltmr_checkTimer();
+        tmwtarg_sleep(10);
+    }
+    start = 1;
+
+    event_thread.config = &config;
+    event_thread.sessions = sessions;
+    event_thread.masters = masters;
+    event_thread.stop = &stop;
+    if (config.event_rate > 0 && pthread_create(&event_id, NULL, event_generator, &event_thread)) {
+        fprintf(stderr, "error: failed to start event thread\n");
+        exit(EXIT_FAILURE);
+    }
+
+    end = now_us() + (uint64_t)config.seconds * 1000000u;
+    while (now_us() < end) {
+        tmwpltmr_checkTimer();
+        tmwtarg_sleep(10);
+    }
+    stop = 1;
+
+    if (config.event_rate > 0) pthread_join(event_id, NULL);
+    for (i = 0; i < config.num_sessions; i++) {
+        pthread_join(threads[i], NULL);
+        for (type = 0; type < NUM_REQUEST_TYPES; type++) total += masters[i].requests[type].count;
+        events += masters[i].events_received;
+        dropped += masters[i].events.dropped;
+        overflows += masters[i].overflows;
+        failed += masters[i].failed;
+    }
+
+    printf("%-20s %9s %12s\n", "", "count", "rate");
+    for (type = 0; type < NUM_REQUEST_TYPES; type++) {
+        for (i = 0; i < config.num_sessions; i++) per_master[i] = &masters[i].requests[type];
+        report(request_names[type], per_master, config.num_sessions, config.seconds);
+    }
+    for (i = 0; i < config.num_sessions; i++) per_master[i] = &masters[i].event_latency;
+    report("event end to end", per_master, config.num_sessions, config.seconds);
+    printf("requests %lu (%.1f/s), events received %lu, not added %lu, overflow responses %lu, failed sessions %lu\n",
+           total, (double)total / config.seconds, events, dropped, overflows, failed);
+
+#if TMWTARGMT_SUPPORTED
+    if (config.metrics_file != NULL && !tmwtargmt_writeFile(config.metrics_file)) {
+        fprintf(stderr, "error: failed to write metrics to %s\n", config.metrics_file);
+    }
+#endif
+
+    for (i = 0; i < config.num_sessions; i++) {
+        for (type = 0; type < NUM_REQUEST_TYPES; type++) free(masters[i].requests[type].samples_us);
+        free(masters[i].event_latency.samples_us);
+        pthread_mutex_destroy(&masters[i].events.lock);
+    }
+    free(per_master);
+    free(threads);
+    free(sessions);
+    free(masters);
+    return (failed == 0 && total > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
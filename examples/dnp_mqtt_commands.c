@@ -0,0 +1,394 @@
+/**
+ * @file
+ * Binary and analog output commands sent to a DNP3 outstation over MQTT.
+ *
+ * The outstation runs in this process on the simulated database, with its
+ * MQTT client connected through a socket pair to a small broker stand-in
+ * instead of a real broker. The stand-in answers CONNECT, SUBSCRIBE and
+ * PINGREQ, publishes commands on the topics the outstation subscribed to
+ * (see tmwscl/dnp/sdnpmqtt.h) and collects the replies it publishes.
+ *
+ * A malformed command and a command for a point that does not exist are
+ * sent first and must be answered with FORMAT_ERROR and NOT_SUPPORTED.
+ * Then commands latch binary outputs on and off and set analog outputs to
+ * whole and fractional values in turn. Each reply must report success and
+ * the database must hold the commanded value. When binary output or analog
+ * output command events are compiled in, an event must have been queued
+ * for every command.
+ *
+ * The report shows the time from a command being written by the broker to
+ * its reply arriving back at the broker.
+ *
+ * Usage:
+ *   dnp_mqtt_commands [-n commands]
+ *
+ * Exits with a failure status if any check fails.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+#include <mqtt.h>
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnputil.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpdata.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwscl/dnp/sdnpmqtt.h"
+#include "tmwscl/dnp/sdnpo011.h"
+#include "tmwscl/dnp/sdnpo043.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define NUM_OUTPUTS       10
+#define REPLY_TIMEOUT_US  2000000u
+
+struct broker_t {
+    int fd;
+    uint8_t rx[4096];
+    size_t rx_len;
+    int subscriptions;
+    char reply[128];
+    int have_reply;
+};
+
+static void report(const char* name, uint32_t* samples, size_t num_samples)
+{
+    if (num_samples == 0) {
+        printf("%-12s no samples\n", name);
+        return;
+    }
+    qsort(samples, num_samples, sizeof(uint32_t), compare_u32);
+    printf("%-12s p50 %7u  p99 %7u  max %7u us\n", name, samples[num_samples / 2],
+           samples[num_samples * 99 / 100], samples[num_samples - 1]);
+}
+
+/* ---- Broker stand-in ---- */
+
+static int broker_write(struct broker_t* broker, const uint8_t* buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t rv = send(broker->fd, buf, len, 0);
+        if (rv < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += rv;
+        len -= (size_t)rv;
+    }
+    return 0;
+}
+
+/**
+ * @brief Handle one whole packet from the outstation's client.
+ */
+static int broker_handle(struct broker_t* broker, const uint8_t* packet, size_t header_len, size_t packet_len)
+{
+    uint8_t out[64];
+    struct mqtt_response response;
+
+    switch (packet[0] >> 4) {
+    case MQTT_CONTROL_CONNECT:
+        out[0] = MQTT_CONTROL_CONNACK << 4; out[1] = 2; out[2] = 0; out[3] = MQTT_CONNACK_ACCEPTED;
+        return broker_write(broker, out, 4);
+
+    case MQTT_CONTROL_SUBSCRIBE: {
+        /* packet id, then a length prefixed topic and a QoS byte for each */
+        size_t pos = header_len + 2, n = 0;
+        while (pos + 2 <= packet_len && n < sizeof out - 4) {
+            pos += 2u + (((size_t)packet[pos] << 8) | packet[pos + 1]) + 1u;
+            out[4 + n++] = 0;
+        }
+        out[0] = MQTT_CONTROL_SUBACK << 4; out[1] = (uint8_t)(2 + n);
+        out[2] = packet[header_len]; out[3] = packet[header_len + 1];
+        broker->subscriptions += (int)n;
+        return broker_write(broker, out, 4 + n);
+    }
+
+    case MQTT_CONTROL_PUBLISH:
+        if (mqtt_unpack_response(&response, packet, packet_len) <= 0) return -1;
+        if (response.decoded.publish.application_message_size >= sizeof broker->reply) return -1;
+        memcpy(broker->reply, response.decoded.publish.application_message,
+               response.decoded.publish.application_message_size);
+        broker->reply[response.decoded.publish.application_message_size] = '\0';
+        broker->have_reply = 1;
+        return 0;
+
+    case MQTT_CONTROL_PINGREQ:
+        out[0] = MQTT_CONTROL_PINGRESP << 4; out[1] = 0;
+        return broker_write(broker, out, 2);
+
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Wait up to \p timeout_ms for data from the client and handle every
+ *        whole packet received.
+ */
+static int broker_poll(struct broker_t* broker, int timeout_ms)
+{
+    struct pollfd pfd;
+    ssize_t rv;
+    size_t pos = 0;
+
+    pfd.fd = broker->fd;
+    pfd.events = POLLIN;
+    if (poll(&pfd, 1, timeout_ms) <= 0) return 0;
+
+    rv = recv(broker->fd, broker->rx + broker->rx_len, sizeof broker->rx - broker->rx_len, MSG_DONTWAIT);
+    if (rv <= 0) return rv == 0 || (errno != EAGAIN && errno != EINTR) ? -1 : 0;
+    broker->rx_len += (size_t)rv;
+
+    while (pos < broker->rx_len) {
+        struct mqtt_response response;
+        ssize_t header_len = mqtt_unpack_fixed_header(&response, broker->rx + pos, broker->rx_len - pos);
+        size_t packet_len;
+        if (header_len < 0) return -1;
+        if (header_len == 0) break;
+        packet_len = (size_t)header_len + response.fixed_header.remaining_length;
+        if (broker_handle(broker, broker->rx + pos, (size_t)header_len, packet_len) != 0) return -1;
+        pos += packet_len;
+    }
+    memmove(broker->rx, broker->rx + pos, broker->rx_len - pos);
+    broker->rx_len -= pos;
+    return 0;
+}
+
+/**
+ * @brief Publish \p command on \p topic and run the outstation until its
+ *        reply arrives, returning the round trip time in \p elapsed_us.
+ */
+static int command(struct broker_t* broker, TMWSESN* session, const char* topic, const char* command,
+                   uint32_t* elapsed_us)
+{
+    uint8_t packet[512];
+    ssize_t len;
+    uint64_t start;
+
+    len = mqtt_pack_publish_request(packet, sizeof packet, topic, 0, command, strlen(command), MQTT_PUBLISH_QOS_0);
+    if (len <= 0) return -1;
+
+    broker->have_reply = 0;
+    start = now_us();
+    if (broker_write(broker, packet, (size_t)len) != 0) return -1;
+    while (!broker->have_reply) {
+        if (sdnpmqtt_sync(session) != MQTT_OK) return -1;
+        if (broker_poll(broker, 1) != 0) return -1;
+        if (now_us() - start > REPLY_TIMEOUT_US) return -1;
+    }
+    *elapsed_us = (uint32_t)(now_us() - start);
+    return 0;
+}
+
+/**
+ * @brief Check the reply to the last command.
+ */
+static int check_reply(struct broker_t* broker, int id, int group, int point, int status)
+{
+    char expected[128];
+    snprintf(expected, sizeof expected, "id=%d group=%d point=%d status=%d", id, group, point, status);
+    if (strcmp(broker->reply, expected) != 0) {
+        fprintf(stderr, "error: expected reply \"%s\", got \"%s\"\n", expected, broker->reply);
+        return -1;
+    }
+    return 0;
+}
+
+/* ---- Outstation ---- */
+
+static TMWSESN* open_outstation(TMWAPPL* appl)
+{
+    struct outstation_config_t config;
+
+    /* The channel is only there for the session, no master connects */
+    init_outstation_config(&config, "mqtt", 0);
+    return open_outstation_session(appl, &config);
+}
+
+#if SDNPDATA_SUPPORT_OBJ11 || SDNPDATA_SUPPORT_OBJ43
+static TMWTYPES_USHORT count_events(TMWSESN* session, int group)
+{
+#if SDNPDATA_SUPPORT_OBJ11
+    if (group == 11) return sdnpo011_countEvents(session, TMWDEFS_CLASS_MASK_ALL, TMWDEFS_TRUE, 0);
+#endif
+#if SDNPDATA_SUPPORT_OBJ43
+    if (group == 43) return sdnpo043_countEvents(session, TMWDEFS_CLASS_MASK_ALL, TMWDEFS_TRUE, 0);
+#endif
+    return 0;
+}
+
+static int expected_events(int commands, TMWTYPES_USHORT max_events)
+{
+    return commands < max_events ? commands : max_events;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+    struct broker_t broker;
+    struct mqtt_client client;
+    SDNPMQTT_CONFIG mqtt_config;
+    static uint8_t sendbuf[8192], recvbuf[2048];
+    uint32_t *latency;
+    size_t num_samples = 0;
+    unsigned long failed = 0;
+    int num_commands = 1000, num_bin_out, num_anlg_out;
+    int expected_bin_events = 0, expected_anlg_events = 0;
+    int sv[2], opt, i;
+    uint32_t elapsed;
+    TMWSESN* session;
+    TMWAPPL* appl;
+
+    while ((opt = getopt(argc, argv, "n:")) != -1) {
+        switch (opt) {
+        case 'n': num_commands = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-n commands]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_commands < 1) num_commands = 1;
+
+    latency = malloc((size_t)num_commands * sizeof(uint32_t));
+    if (latency == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Start the outstation */
+    appl = start_scl();
+    session = open_outstation(appl);
+    if (session == TMWDEFS_NULL) {
+        fprintf(stderr, "error: failed to open outstation\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < NUM_OUTPUTS; i++) {
+        sdnpsim_addBinaryOutput(((SDNPSESN*)session)->pDbHandle, TMWDEFS_CLASS_MASK_ONE,
+                                DNPDEFS_DBAS_FLAG_ON_LINE, TMWDEFS_FALSE, 0xff);
+        sdnpsim_addAnalogOutput(((SDNPSESN*)session)->pDbHandle, TMWDEFS_CLASS_MASK_ONE,
+                                DNPDEFS_DBAS_FLAG_ON_LINE, 0);
+    }
+    num_bin_out = sdnpsim_binOutQuantity(((SDNPSESN*)session)->pDbHandle);
+    num_anlg_out = sdnpsim_anlgOutQuantity(((SDNPSESN*)session)->pDbHandle);
+    if (num_bin_out == 0 || num_anlg_out == 0) {
+        fprintf(stderr, "error: failed to add outputs to the simulated database\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Connect its client to the broker stand-in */
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        fprintf(stderr, "error: socketpair failed, %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+    memset(&broker, 0, sizeof broker);
+    broker.fd = sv[1];
+
+    mqtt_init(&client, sv[0], sendbuf, sizeof sendbuf, recvbuf, sizeof recvbuf, NULL);
+    mqtt_connect(&client, "dnp_mqtt_commands", NULL, NULL, 0, NULL, NULL, MQTT_CONNECT_CLEAN_SESSION, 400);
+
+    /* The simulated database adds binary output events itself */
+    sdnpmqtt_initConfig(&mqtt_config);
+    mqtt_config.binOutFeedback = TMWDEFS_FALSE;
+    if (!sdnpmqtt_open(session, &client, &mqtt_config)) {
+        fprintf(stderr, "error: sdnpmqtt_open failed\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < 100 && broker.subscriptions < 2; i++) {
+        if (sdnpmqtt_sync(session) != MQTT_OK || broker_poll(&broker, 10) != 0) break;
+    }
+    if (broker.subscriptions < 2) {
+        fprintf(stderr, "error: outstation did not subscribe to the command topics\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Commands that must be rejected */
+    if (command(&broker, session, mqtt_config.binOutTopic, "point=0 code=sideways id=1", &elapsed) != 0
+        || check_reply(&broker, 1, 12, 0, DNPDEFS_CROB_ST_FORMAT_ERROR) != 0
+        || command(&broker, session, mqtt_config.anlgOutTopic, "point=60000 value=1 id=2", &elapsed) != 0
+        || check_reply(&broker, 2, 41, 60000, DNPDEFS_CTLSTAT_NOT_SUPPORTED) != 0) {
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%d binary outputs, %d analog outputs, %d commands\n", num_bin_out, num_anlg_out, num_commands);
+
+    for (i = 0; i < num_commands; i++) {
+        char text[128];
+        int point, ok = 0;
+        void* pPoint;
+
+        if (i % 2 == 0) {
+            int on = (i / 2) % 2 == 0;
+            TMWTYPES_UCHAR flags = 0;
+            point = (i / 4) % num_bin_out;
+            snprintf(text, sizeof text, "point=%d code=%s id=%d", point, on ? "latch_on" : "latch_off", i);
+            if (command(&broker, session, mqtt_config.binOutTopic, text, &elapsed) == 0
+                && check_reply(&broker, i, 12, point, DNPDEFS_CROB_ST_SUCCESS) == 0) {
+                pPoint = sdnpdata_binOutGetPoint(((SDNPSESN*)session)->pDbHandle, (TMWTYPES_USHORT)point);
+                sdnpdata_binOutRead(pPoint, &flags);
+                ok = ((flags & DNPDEFS_DBAS_FLAG_BINARY_ON) != 0) == on;
+            }
+            expected_bin_events++;
+        } else {
+            double value = (i / 2) % 2 == 0 ? (double)i : i + 0.25;
+            TMWTYPES_ANALOG_VALUE read;
+            TMWTYPES_UCHAR flags;
+            point = (i / 4) % num_anlg_out;
+            snprintf(text, sizeof text, "point=%d value=%g id=%d", point, value, i);
+            if (command(&broker, session, mqtt_config.anlgOutTopic, text, &elapsed) == 0
+                && check_reply(&broker, i, 41, point, DNPDEFS_CTLSTAT_SUCCESS) == 0) {
+                pPoint = sdnpdata_anlgOutGetPoint(((SDNPSESN*)session)->pDbHandle, (TMWTYPES_USHORT)point);
+                sdnpdata_anlgOutRead(pPoint, &read, &flags);
+                ok = dnputil_getAnalogValueDouble(&read) == value;
+            }
+            expected_anlg_events++;
+        }
+
+        if (ok) {
+            latency[num_samples++] = elapsed;
+        } else {
+            fprintf(stderr, "error: command \"%s\" failed\n", text);
+            failed++;
+        }
+    }
+
+    printf("%lu of %d commands carried out\n", (unsigned long)num_samples, num_commands);
+    report("round trip", latency, num_samples);
+    if (sdnpmqtt_getRepliesDropped(session) != 0) {
+        fprintf(stderr, "error: %lu replies dropped\n", (unsigned long)sdnpmqtt_getRepliesDropped(session));
+        failed++;
+    }
+
+    /* Every command queued an event, up to the size of the queue */
+#if SDNPDATA_SUPPORT_OBJ11
+    printf("%u binary output events\n", count_events(session, 11));
+    if (count_events(session, 11) < expected_events(expected_bin_events,
+                                                    ((SDNPSESN*)session)->binaryOutputMaxEvents)) failed++;
+#endif
+#if SDNPDATA_SUPPORT_OBJ43
+    printf("%u analog output command events\n", count_events(session, 43));
+    if (count_events(session, 43) < expected_events(expected_anlg_events,
+                                                    ((SDNPSESN*)session)->analogOutCmdMaxEvents)) failed++;
+#endif
+    TMWTARG_UNUSED_PARAM(expected_bin_events);
+    TMWTARG_UNUSED_PARAM(expected_anlg_events);
+
+    sdnpmqtt_close(session);
+    close(sv[0]);
+    close(sv[1]);
+    free(latency);
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
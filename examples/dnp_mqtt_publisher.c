@@ -0,0 +1,484 @@
+/**
+ * @file
+ * Point values published to MQTT over one and over several connections.
+ *
+ * Each connection of the publisher (see tmwscl/dnp/sdnpmpub.h) is opened
+ * through a socket pair to its own broker stand-in, a thread that answers
+ * CONNECT and PINGREQ and reads slowly, as a broker behind a congested link
+ * would. Producer threads publish a sequence number on each of their topics
+ * as fast as they can, first over one connection and then over several.
+ *
+ * Every message that arrives must have come over the connection its topic
+ * hashes to, and must carry a higher sequence number than the last one seen
+ * on its topic. Once the producers stop, every message the publisher queued
+ * must arrive. Last, an analog input event added to an outstation attached to
+ * the publisher must arrive on its point's topic.
+ *
+ * The report shows the messages delivered per second and those dropped
+ * because a send buffer was full, for each number of connections.
+ *
+ * Usage:
+ *   dnp_mqtt_publisher [-c connections] [-p producers] [-t topics] [-d seconds] [-s slow-us]
+ *
+ * Exits with a failure status if any check fails.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+
+#include <mqtt.h>
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwscl/dnp/sdnpo032.h"
+#include "tmwscl/dnp/sdnpmpub.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define MAX_TOPICS        4096
+#define MAX_BROKERS       64
+#define DRAIN_TIMEOUT_US  5000000u
+
+struct broker_t {
+    int fd;
+    unsigned int index;
+    pthread_t thread;
+    unsigned long delivered;
+    int failed;
+};
+
+struct bench_t {
+    pthread_mutex_t mutex;
+    struct broker_t brokers[MAX_BROKERS];
+    int num_brokers;
+    int slow_us;
+
+    /* Connection each topic hashes to, and the last sequence number seen */
+    unsigned int topic_index[MAX_TOPICS];
+    long last_seq[MAX_TOPICS];
+
+    /* Last message received on a topic outside the benchmark */
+    char other_topic[128];
+    char other_message[128];
+};
+
+struct producer_t {
+    SDNPMPUB* publisher;
+    int first_topic, num_topics, step;
+    volatile int* stop;
+    unsigned long attempts;
+};
+
+static struct bench_t bench;
+
+/* ---- Broker stand-ins ---- */
+
+static int broker_write(struct broker_t* broker, const uint8_t* buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t rv = send(broker->fd, buf, len, MSG_NOSIGNAL);
+        if (rv < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        buf += rv;
+        len -= (size_t)rv;
+    }
+    return 0;
+}
+
+/**
+ * @brief Check one PUBLISH from the publisher.
+ */
+static int broker_publish(struct broker_t* broker, const uint8_t* packet, size_t packet_len)
+{
+    struct mqtt_response response;
+    const struct mqtt_response_publish* publish = &response.decoded.publish;
+    char topic[128], message[128];
+    int t;
+    long seq;
+
+    if (mqtt_unpack_response(&response, packet, packet_len) <= 0) return -1;
+    if (publish->topic_name_size >= sizeof topic || publish->application_message_size >= sizeof message) return -1;
+    memcpy(topic, publish->topic_name, publish->topic_name_size);
+    topic[publish->topic_name_size] = '\0';
+    memcpy(message, publish->application_message, publish->application_message_size);
+    message[publish->application_message_size] = '\0';
+
+    if (sscanf(topic, "bench/%d", &t) != 1) {
+        pthread_mutex_lock(&bench.mutex);
+        strcpy(bench.other_topic, topic);
+        strcpy(bench.other_message, message);
+        pthread_mutex_unlock(&bench.mutex);
+        return 0;
+    }
+
+    if (t < 0 || t >= MAX_TOPICS || sscanf(message, "seq=%ld", &seq) != 1) {
+        fprintf(stderr, "error: unexpected message \"%s\" on %s\n", message, topic);
+        return -1;
+    }
+    if (bench.topic_index[t] != broker->index) {
+        fprintf(stderr, "error: %s arrived on connection %u instead of %u\n", topic, broker->index,
+                bench.topic_index[t]);
+        return -1;
+    }
+    if (seq <= bench.last_seq[t]) {
+        fprintf(stderr, "error: %s seq %ld arrived after seq %ld\n", topic, seq, bench.last_seq[t]);
+        return -1;
+    }
+    bench.last_seq[t] = seq;
+    broker->delivered++;
+    return 0;
+}
+
+/**
+ * @brief Read from one connection until the publisher closes it, at most
+ *        a small buffer at a time with a pause after each read.
+ */
+static void* broker_thread(void* arg)
+{
+    struct broker_t* broker = (struct broker_t*)arg;
+    uint8_t rx[8192];
+    size_t rx_len = 0;
+
+    for (;;) {
+        size_t pos = 0;
+        ssize_t rv = recv(broker->fd, rx + rx_len, sizeof rx - rx_len < 1024 ? sizeof rx - rx_len : 1024, 0);
+        if (rv < 0 && errno == EINTR) continue;
+        if (rv <= 0) break;
+        rx_len += (size_t)rv;
+
+        while (pos < rx_len) {
+            struct mqtt_response response;
+            ssize_t header_len = mqtt_unpack_fixed_header(&response, rx + pos, rx_len - pos);
+            size_t packet_len;
+            uint8_t out[4];
+            if (header_len < 0) broker->failed = 1;
+            if (header_len <= 0) break;
+            packet_len = (size_t)header_len + response.fixed_header.remaining_length;
+            if (packet_len > rx_len - pos) break;
+
+            switch (rx[pos] >> 4) {
+            case MQTT_CONTROL_CONNECT:
+                out[0] = MQTT_CONTROL_CONNACK << 4; out[1] = 2; out[2] = 0; out[3] = MQTT_CONNACK_ACCEPTED;
+                if (broker_write(broker, out, 4) != 0) broker->failed = 1;
+                break;
+            case MQTT_CONTROL_PINGREQ:
+                out[0] = MQTT_CONTROL_PINGRESP << 4; out[1] = 0;
+                if (broker_write(broker, out, 2) != 0) broker->failed = 1;
+                break;
+            case MQTT_CONTROL_PUBLISH:
+                if (broker_publish(broker, rx + pos, packet_len) != 0) broker->failed = 1;
+                break;
+            default:
+                break;
+            }
+            pos += packet_len;
+        }
+        if (broker->failed) break;
+        memmove(rx, rx + pos, rx_len - pos);
+        rx_len -= pos;
+
+        if (bench.slow_us > 0) usleep((useconds_t)bench.slow_us);
+    }
+
+    close(broker->fd);
+    return NULL;
+}
+
+static mqtt_pal_socket_handle open_broker(void* pParam, TMWTYPES_UINT index)
+{
+    struct bench_t* b = (struct bench_t*)pParam;
+    struct broker_t* broker;
+    int sv[2];
+
+    pthread_mutex_lock(&b->mutex);
+    if (b->num_brokers == MAX_BROKERS || socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+        pthread_mutex_unlock(&b->mutex);
+        return -1;
+    }
+    broker = &b->brokers[b->num_brokers++];
+    memset(broker, 0, sizeof *broker);
+    broker->fd = sv[1];
+    broker->index = index;
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+    pthread_create(&broker->thread, NULL, broker_thread, broker);
+    pthread_mutex_unlock(&b->mutex);
+    return sv[0];
+}
+
+static void close_broker(void* pParam, mqtt_pal_socket_handle socketfd)
+{
+    TMWTARG_UNUSED_PARAM(pParam);
+    close(socketfd);
+}
+
+/**
+ * @brief Wait for the broker threads of the closed publisher and check them.
+ */
+static int join_brokers(unsigned long* delivered)
+{
+    int i, failed = 0;
+
+    *delivered = 0;
+    for (i = 0; i < bench.num_brokers; i++) {
+        pthread_join(bench.brokers[i].thread, NULL);
+        *delivered += bench.brokers[i].delivered;
+        failed |= bench.brokers[i].failed;
+    }
+    bench.num_brokers = 0;
+    return failed ? -1 : 0;
+}
+
+static unsigned long delivered_so_far(void)
+{
+    unsigned long delivered = 0;
+    int i;
+
+    pthread_mutex_lock(&bench.mutex);
+    for (i = 0; i < bench.num_brokers; i++) delivered += bench.brokers[i].delivered;
+    pthread_mutex_unlock(&bench.mutex);
+    return delivered;
+}
+
+static SDNPMPUB* create_publisher(int num_connections)
+{
+    SDNPMPUB_CONFIG config;
+    SDNPMPUB* publisher;
+    SDNPMPUB_STATS stats;
+    uint64_t start;
+
+    sdnpmpub_initConfig(&config);
+    config.numConnections = (TMWTYPES_UINT)num_connections;
+    strcpy(config.clientId, "dnp_mqtt_publisher");
+    config.pOpenFunc = open_broker;
+    config.pCloseFunc = close_broker;
+    config.pCallbackParam = &bench;
+
+    publisher = sdnpmpub_create(&config);
+    if (publisher == TMWDEFS_NULL) return TMWDEFS_NULL;
+
+    start = now_us();
+    do {
+        usleep(1000);
+        sdnpmpub_getStats(publisher, SDNPMPUB_MAX_CONNECTIONS, &stats);
+    } while (stats.connected < (TMWTYPES_ULONG)num_connections && now_us() - start < DRAIN_TIMEOUT_US);
+
+    if (stats.connected < (TMWTYPES_ULONG)num_connections) {
+        sdnpmpub_destroy(publisher);
+        return TMWDEFS_NULL;
+    }
+    return publisher;
+}
+
+/* ---- Producers ---- */
+
+static void* producer_thread(void* arg)
+{
+    struct producer_t* producer = (struct producer_t*)arg;
+    long seq = 0;
+
+    while (!*producer->stop) {
+        int t;
+        for (t = producer->first_topic; t < producer->num_topics; t += producer->step) {
+            char topic[32], message[32];
+            int len;
+            snprintf(topic, sizeof topic, "bench/%d", t);
+            len = snprintf(message, sizeof message, "seq=%ld", seq);
+            sdnpmpub_publish(producer->publisher, topic, message, (TMWTYPES_UINT)len);
+            producer->attempts++;
+        }
+        seq++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Publish over \p num_connections for \p seconds and check what arrived.
+ */
+static int run(int num_connections, int num_producers, int num_topics, int seconds)
+{
+    struct producer_t producers[64];
+    pthread_t threads[64];
+    volatile int stop = 0;
+    unsigned long attempts = 0, delivered;
+    SDNPMPUB_STATS stats;
+    SDNPMPUB* publisher;
+    uint64_t start, elapsed;
+    int i, failed = 0;
+
+    publisher = create_publisher(num_connections);
+    if (publisher == TMWDEFS_NULL) {
+        fprintf(stderr, "error: failed to connect %d connections\n", num_connections);
+        return -1;
+    }
+    for (i = 0; i < num_topics; i++) {
+        char topic[32];
+        snprintf(topic, sizeof topic, "bench/%d", i);
+        bench.topic_index[i] = sdnpmpub_connectionIndex(publisher, topic);
+        bench.last_seq[i] = -1;
+    }
+
+    start = now_us();
+    for (i = 0; i < num_producers; i++) {
+        producers[i].publisher = publisher;
+        producers[i].first_topic = i;
+        producers[i].num_topics = num_topics;
+        producers[i].step = num_producers;
+        producers[i].stop = &stop;
+        producers[i].attempts = 0;
+        pthread_create(&threads[i], NULL, producer_thread, &producers[i]);
+    }
+    sleep((unsigned int)seconds);
+    stop = 1;
+    for (i = 0; i < num_producers; i++) {
+        pthread_join(threads[i], NULL);
+        attempts += producers[i].attempts;
+    }
+
+    /* Everything queued must still arrive */
+    sdnpmpub_getStats(publisher, SDNPMPUB_MAX_CONNECTIONS, &stats);
+    while (delivered_so_far() < stats.published && now_us() - start < (uint64_t)seconds * 1000000u + DRAIN_TIMEOUT_US)
+        usleep(1000);
+    elapsed = now_us() - start;
+
+    sdnpmpub_getStats(publisher, SDNPMPUB_MAX_CONNECTIONS, &stats);
+    sdnpmpub_destroy(publisher);
+    if (join_brokers(&delivered) != 0) failed = 1;
+
+    printf("%2d connections  %9.0f msgs/s delivered  %lu published  %lu dropped  %lu dropped offline\n",
+           num_connections, delivered * 1e6 / (double)elapsed, (unsigned long)stats.published,
+           (unsigned long)stats.dropped, (unsigned long)stats.droppedOffline);
+
+    if (delivered != stats.published) {
+        fprintf(stderr, "error: %lu messages queued but %lu delivered\n", (unsigned long)stats.published, delivered);
+        failed = 1;
+    }
+    if (attempts != stats.published + stats.dropped + stats.droppedOffline) {
+        fprintf(stderr, "error: %lu publishes but %lu counted\n", attempts,
+                (unsigned long)(stats.published + stats.dropped + stats.droppedOffline));
+        failed = 1;
+    }
+    return failed ? -1 : 0;
+}
+
+/* ---- Outstation ---- */
+
+static TMWSESN* open_outstation(TMWAPPL* appl)
+{
+    struct outstation_config_t config;
+
+    /* The channel is only there for the session, no master connects */
+    init_outstation_config(&config, "mqtt", 0);
+    return open_outstation_session(appl, &config);
+}
+
+/**
+ * @brief Add an analog input event to an attached outstation and wait for it.
+ */
+static int outstation_event(void)
+{
+    TMWTYPES_ANALOG_VALUE value;
+    TMWDTIME time_stamp;
+    SDNPMPUB* publisher;
+    TMWSESN* session;
+    TMWAPPL* appl;
+    char expected[128];
+    unsigned long delivered;
+    uint64_t start;
+    int found = 0;
+
+    appl = start_scl();
+    session = open_outstation(appl);
+    if (session == TMWDEFS_NULL) {
+        fprintf(stderr, "error: failed to open outstation\n");
+        return -1;
+    }
+    sdnpsim_addAnalogInput(((SDNPSESN*)session)->pDbHandle, TMWDEFS_CLASS_MASK_ONE,
+                           DNPDEFS_DBAS_FLAG_ON_LINE, 0, 0);
+
+    publisher = create_publisher(2);
+    if (publisher == TMWDEFS_NULL) {
+        fprintf(stderr, "error: failed to connect the outstation's publisher\n");
+        return -1;
+    }
+    sdnpmpub_attachSession(session, publisher);
+
+    value.type = TMWTYPES_ANALOG_TYPE_DOUBLE;
+    value.value.dval = 12.5;
+    tmwdtime_getDateTime(session, &time_stamp);
+    sdnpo032_addEvent(session, 0, &value, DNPDEFS_DBAS_FLAG_ON_LINE, &time_stamp);
+
+    snprintf(expected, sizeof expected, "dnp/%u/32/0", session->srcAddress);
+    start = now_us();
+    while (!found && now_us() - start < DRAIN_TIMEOUT_US) {
+        usleep(1000);
+        pthread_mutex_lock(&bench.mutex);
+        found = strcmp(bench.other_topic, expected) == 0;
+        pthread_mutex_unlock(&bench.mutex);
+    }
+
+    sdnpmpub_attachSession(session, TMWDEFS_NULL);
+    sdnpmpub_destroy(publisher);
+    join_brokers(&delivered);
+
+    if (!found) {
+        fprintf(stderr, "error: no event published on %s\n", expected);
+        return -1;
+    }
+    printf("%s: %s\n", bench.other_topic, bench.other_message);
+    if (strncmp(bench.other_message, "value=12.5 flags=1 time=", 24) != 0) {
+        fprintf(stderr, "error: unexpected event message \"%s\"\n", bench.other_message);
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int num_connections = 4, num_producers = 4, num_topics = 256, seconds = 1;
+    int opt, failed = 0;
+
+    bench.slow_us = 500;
+    while ((opt = getopt(argc, argv, "c:p:t:d:s:")) != -1) {
+        switch (opt) {
+        case 'c': num_connections = atoi(optarg); break;
+        case 'p': num_producers = atoi(optarg); break;
+        case 't': num_topics = atoi(optarg); break;
+        case 'd': seconds = atoi(optarg); break;
+        case 's': bench.slow_us = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-c connections] [-p producers] [-t topics] [-d seconds] [-s slow-us]\n",
+                    argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_connections < 1) num_connections = 1;
+    if (num_connections > SDNPMPUB_MAX_CONNECTIONS) num_connections = SDNPMPUB_MAX_CONNECTIONS;
+    if (num_producers < 1) num_producers = 1;
+    if (num_producers > 64) num_producers = 64;
+    if (num_topics < num_producers) num_topics = num_producers;
+    if (num_topics > MAX_TOPICS) num_topics = MAX_TOPICS;
+    if (seconds < 1) seconds = 1;
+
+    pthread_mutex_init(&bench.mutex, NULL);
+    printf("%d producers, %d topics, %d s per run, broker pauses %d us per read\n", num_producers, num_topics,
+           seconds, bench.slow_us);
+
+    if (run(1, num_producers, num_topics, seconds) != 0) failed = 1;
+    if (num_connections > 1 && run(num_connections, num_producers, num_topics, seconds) != 0) failed = 1;
+    if (outstation_event() != 0) failed = 1;
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file
+ * A stress test for the sdnpshm point value store used behind the DNP3
+ * outstation sdnpdata read and changed callbacks.
+ *
+ * Writer threads keep updating the same binary input, counter and analog
+ * input points while reader threads read them the way a static poll
+ * does, and a scanner thread looks for changed points the way the event
+ * scan does. Every update derives the flags, value and time from one
+ * number, so a reader that sees a mix of two updates finds they do not
+ * agree. Readers never take a lock, so this also shows how many reads
+ * per second a poll can do while the writers are busy.
+ *
+ * Usage:
+ *   dnp_point_store_stress [-w writers] [-r readers] [-p points] [-t seconds]
+ *
+ * Exits with a failure status if any inconsistent point was read.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "tmwscl/dnp/sdnpshm.h"
+#include "tmwscl/dnp/dnpdtime.h"
+
+/* Times written are this many milliseconds since 1970 plus the update number */
+#define TIME_BASE_MS 1600000000000ULL
+
+struct stress_config_t {
+    int num_writers;
+    int num_readers;
+    int num_points;
+    int seconds;
+};
+
+struct stress_thread_t {
+    const struct stress_config_t* config;
+    void* region;
+    int index;
+    volatile int* stop;
+    unsigned long operations;
+    unsigned long changes;
+    unsigned long errors;
+};
+
+/**
+ * @brief The flags written with update number \p update, always ON_LINE.
+ */
+static uint8_t update_flags(uint64_t update)
+{
+    return (uint8_t)((update & 0xfe) | 0x01);
+}
+
+static double update_analog(uint64_t update)
+{
+    return (double)update * 0.25;
+}
+
+/**
+ * @brief Check that the flags, value and time of a point came from the
+ *        same update.
+ *
+ * @returns 1 if the point is consistent.
+ */
+static int check_point(SDNPSHM_TYPE type, const SDNPSHM_POINT* point)
+{
+    uint64_t update;
+
+    /* Not written yet */
+    if (point->msSince70 == 0) return point->flags == 0;
+
+    update = point->msSince70 - TIME_BASE_MS;
+    if (point->flags != update_flags(update)) return 0;
+    if (type == SDNPSHM_TYPE_BIN_CNTR) return point->value.counter == (TMWTYPES_ULONG)update;
+    if (type == SDNPSHM_TYPE_ANLG_IN) return point->value.analog == update_analog(update);
+    return 1;
+}
+
+static const SDNPSHM_TYPE stress_types[] = {
+    SDNPSHM_TYPE_BIN_IN, SDNPSHM_TYPE_BIN_CNTR, SDNPSHM_TYPE_ANLG_IN
+};
+#define NUM_STRESS_TYPES (sizeof stress_types / sizeof stress_types[0])
+
+void* stress_writer(void* arg)
+{
+    struct stress_thread_t* thread = (struct stress_thread_t*)arg;
+    const struct stress_config_t* config = thread->config;
+    uint64_t update = (uint64_t)thread->index + 1;
+
+    /* Writers share the points, each uses its own update numbers */
+    while (!*thread->stop) {
+        TMWTYPES_MS_SINCE_70 msSince70;
+        TMWDTIME timeStamp;
+        uint64_t ms = TIME_BASE_MS + update;
+        TMWTYPES_USHORT point = (TMWTYPES_USHORT)(update % (uint64_t)config->num_points);
+
+        msSince70.mostSignificant = (TMWTYPES_ULONG)(ms >> 16);
+        msSince70.leastSignificant = (TMWTYPES_USHORT)(ms & 0xffff);
+        dnpdtime_msSince70ToDateTime(&timeStamp, &msSince70);
+
+        sdnpshm_setBinary(thread->region, SDNPSHM_TYPE_BIN_IN, point, update_flags(update), &timeStamp);
+        sdnpshm_setCounter(thread->region, SDNPSHM_TYPE_BIN_CNTR, point, (TMWTYPES_ULONG)update,
+                           update_flags(update), &timeStamp);
+        sdnpshm_setAnalog(thread->region, SDNPSHM_TYPE_ANLG_IN, point, update_analog(update),
+                          update_flags(update), &timeStamp);
+
+        thread->operations += NUM_STRESS_TYPES;
+        update += (uint64_t)config->num_writers;
+    }
+    return NULL;
+}
+
+void* stress_reader(void* arg)
+{
+    struct stress_thread_t* thread = (struct stress_thread_t*)arg;
+    const struct stress_config_t* config = thread->config;
+    SDNPSHM_POINT point;
+    size_t t;
+    int i;
+
+    while (!*thread->stop) {
+        for (t = 0; t < NUM_STRESS_TYPES; t++) {
+            for (i = 0; i < config->num_points; i++) {
+                sdnpshm_read(thread->region, stress_types[t], (TMWTYPES_USHORT)i, &point);
+                if (!check_point(stress_types[t], &point)) thread->errors++;
+            }
+        }
+        thread->operations += NUM_STRESS_TYPES * (unsigned long)config->num_points;
+    }
+    return NULL;
+}
+
+void* stress_scanner(void* arg)
+{
+    struct stress_thread_t* thread = (struct stress_thread_t*)arg;
+    const struct stress_config_t* config = thread->config;
+    TMWTYPES_ULONG* last_sequence;
+    SDNPSHM_POINT point;
+    size_t t;
+    int i;
+
+    last_sequence = calloc(NUM_STRESS_TYPES * (size_t)config->num_points, sizeof *last_sequence);
+    if (last_sequence == NULL) {
+        thread->errors++;
+        return NULL;
+    }
+
+    while (!*thread->stop) {
+        for (t = 0; t < NUM_STRESS_TYPES; t++) {
+            for (i = 0; i < config->num_points; i++) {
+                TMWTYPES_ULONG* last = &last_sequence[t * (size_t)config->num_points + (size_t)i];
+                TMWTYPES_ULONG previous = *last;
+                if (!sdnpshm_readChanged(thread->region, stress_types[t], (TMWTYPES_USHORT)i, last, &point)) {
+                    continue;
+                }
+                thread->changes++;
+                /* Sequences only move forward, and a completed update is even */
+                if (!check_point(stress_types[t], &point) || (*last & 1) || *last <= previous) {
+                    thread->errors++;
+                }
+            }
+        }
+        thread->operations += NUM_STRESS_TYPES * (unsigned long)config->num_points;
+    }
+    free(last_sequence);
+    return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+    struct stress_config_t config;
+    struct stress_thread_t* threads;
+    pthread_t* ids;
+    TMWTYPES_ULONG quantities[SDNPSHM_NUM_TYPES];
+    TMWTYPES_ULONG size;
+    volatile int stop = 0;
+    unsigned long writes = 0, reads = 0, scans = 0, changes = 0, errors = 0;
+    void* region;
+    int num_threads, opt, i;
+
+    config.num_writers = 2;
+    config.num_readers = 2;
+    config.num_points = 64;
+    config.seconds = 5;
+
+    while ((opt = getopt(argc, argv, "w:r:p:t:")) != -1) {
+        switch (opt) {
+        case 'w': config.num_writers = atoi(optarg); break;
+        case 'r': config.num_readers = atoi(optarg); break;
+        case 'p': config.num_points = atoi(optarg); break;
+        case 't': config.seconds = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-w writers] [-r readers] [-p points] [-t seconds]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (config.num_writers < 1) config.num_writers = 1;
+    if (config.num_readers < 0) config.num_readers = 0;
+    if (config.num_points < 1) config.num_points = 1;
+    if (config.num_points > 65535) config.num_points = 65535;
+
+    memset(quantities, 0, sizeof quantities);
+    quantities[SDNPSHM_TYPE_BIN_IN] = (TMWTYPES_ULONG)config.num_points;
+    quantities[SDNPSHM_TYPE_BIN_CNTR] = (TMWTYPES_ULONG)config.num_points;
+    quantities[SDNPSHM_TYPE_ANLG_IN] = (TMWTYPES_ULONG)config.num_points;
+    region = sdnpshm_alloc(quantities, &size);
+
+    /* Writers, readers and one scanner */
+    num_threads = config.num_writers + config.num_readers + 1;
+    threads = calloc((size_t)num_threads, sizeof *threads);
+    ids = calloc((size_t)num_threads, sizeof *ids);
+    if (region == NULL || threads == NULL || ids == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%d writers, %d readers and a scanner sharing %d points of each type for %d seconds\n",
+           config.num_writers, config.num_readers, config.num_points, config.seconds);
+
+    for (i = 0; i < num_threads; i++) {
+        void* (*entry)(void*);
+
+        threads[i].config = &config;
+        threads[i].region = region;
+        threads[i].stop = &stop;
+        if (i < config.num_writers) {
+            threads[i].index = i;
+            entry = stress_writer;
+        } else if (i < num_threads - 1) {
+            threads[i].index = i - config.num_writers;
+            entry = stress_reader;
+        } else {
+            entry = stress_scanner;
+        }
+        if (pthread_create(&ids[i], NULL, entry, &threads[i])) {
+            fprintf(stderr, "error: failed to start thread %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    sleep((unsigned)config.seconds);
+    stop = 1;
+
+    for (i = 0; i < num_threads; i++) {
+        pthread_join(ids[i], NULL);
+        errors += threads[i].errors;
+        if (i < config.num_writers) {
+            writes += threads[i].operations;
+        } else if (i < num_threads - 1) {
+            reads += threads[i].operations;
+        } else {
+            scans += threads[i].operations;
+            changes += threads[i].changes;
+        }
+    }
+
+    printf("writes %lu (%.0f/s), reads %lu (%.0f/s)\n",
+           writes, (double)writes / config.seconds, reads, (double)reads / config.seconds);
+    printf("scanned %lu (%.0f/s), changes found %lu\n",
+           scans, (double)scans / config.seconds, changes);
+    printf("inconsistent points %lu\n", errors);
+
+    sdnpshm_free(region);
+    free(ids);
+    free(threads);
+    return (errors == 0 && changes > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
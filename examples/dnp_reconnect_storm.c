@@ -0,0 +1,358 @@
+/**
+ * @file
+ * A reconnect storm benchmark for a DNP3 outstation, or a farm of
+ * outstations, listening on TCP.
+ *
+ * Each client thread repeatedly connects, sends a DNP3 link layer
+ * REQUEST LINK STATUS, waits for the LINK STATUS reply and disconnects.
+ * The time from starting the connect to receiving the reply includes the
+ * outstation accepting the connection and handing it to its channel, so
+ * this measures how well the listener keeps up when many masters
+ * reconnect at once, for example after a network outage.
+ *
+ * Usage:
+ *   dnp_reconnect_storm [-h host] [-p port] [-n numPorts] [-c clients]
+ *                       [-t seconds] [-d outstationAddr] [-s masterAddr]
+ *                       [-o outstationsPerPort]
+ *
+ * The outstations run in this process: -o channels listen on each port,
+ * sharing its listener threads and their SO_REUSEPORT sockets. With -o 0
+ * the clients connect to outstations that are already listening on -h.
+ *
+ * With -n the clients are spread over ports port..port+numPorts-1. A
+ * connection the outstation has no free channel for is closed by it and
+ * counted as refused.
+ *
+ * Fails if any exchange fails, none completes, or the median connect to
+ * reply latency exceeds MAX_P50_US.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <pthread.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include "tmwscl/utils/tmwpltmr.h"
+#include "templates/dnp_outstation.h"
+
+#define MAX_SAMPLES_PER_CLIENT 100000
+#define REPLY_TIMEOUT_MS       2000
+
+/* A connection handed to a channel is read as soon as the channel has */
+/* it, so a median in the hundreds of milliseconds means connections   */
+/* are waiting out a retry or sleep instead.                           */
+#define MAX_P50_US             100000u
+
+struct storm_config_t {
+    const char* hostname;
+    int port;
+    int num_ports;
+    int num_clients;
+    int seconds;
+    int outstations_per_port;
+    uint16_t outstation_addr;
+    uint16_t master_addr;
+};
+
+struct storm_client_t {
+    const struct storm_config_t* config;
+    int index;
+    volatile int* stop;
+    volatile int done;
+    uint8_t request[10];
+    unsigned long completed;
+    unsigned long refused;
+    unsigned long failed;
+    unsigned long num_samples;
+    uint32_t* samples_us;
+};
+
+/**
+ * @brief Build the REQUEST LINK STATUS frame a master sends to the outstation.
+ */
+static void build_request(uint8_t frame[10], uint16_t dest, uint16_t src)
+{
+    uint16_t crc;
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = 5;       /* length: control and addresses */
+    frame[3] = 0xC9;    /* DIR | PRM | REQUEST LINK STATUS */
+    frame[4] = (uint8_t)(dest & 0xff);
+    frame[5] = (uint8_t)(dest >> 8);
+    frame[6] = (uint8_t)(src & 0xff);
+    frame[7] = (uint8_t)(src >> 8);
+    crc = dnp_crc(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+}
+
+/**
+ * @brief Connect to \p port on the configured host.
+ *
+ * @returns the socket, or -1 on failure.
+ */
+static int open_connection(const struct storm_config_t* config, int port)
+{
+    struct addrinfo hints, *servinfo, *p;
+    char port_name[16];
+    int sockfd = -1;
+    int one = 1;
+
+    memset(&hints, 0, sizeof hints);
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    snprintf(port_name, sizeof port_name, "%d", port);
+    if (getaddrinfo(config->hostname, port_name, &hints, &servinfo) != 0) {
+        return -1;
+    }
+
+    for (p = servinfo; p != NULL; p = p->ai_next) {
+        sockfd = socket(p->ai_family, p->ai_socktype, p->ai_protocol);
+        if (sockfd == -1) continue;
+        if (connect(sockfd, p->ai_addr, p->ai_addrlen) == -1) {
+            close(sockfd);
+            sockfd = -1;
+            continue;
+        }
+        break;
+    }
+    freeaddrinfo(servinfo);
+
+    if (sockfd != -1) {
+        setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+    }
+    return sockfd;
+}
+
+/**
+ * @brief Wait for a 10 byte link header reply.
+ *
+ * @returns 1 on a reply, 0 if the outstation closed the connection and
+ *          -1 on a timeout or error.
+ */
+static int read_reply(int sockfd)
+{
+    uint8_t reply[10];
+    size_t received = 0;
+    struct pollfd pfd;
+
+    pfd.fd = sockfd;
+    pfd.events = POLLIN;
+    while (received < sizeof reply) {
+        ssize_t n;
+        if (poll(&pfd, 1, REPLY_TIMEOUT_MS) <= 0) return -1;
+        n = recv(sockfd, reply + received, sizeof reply - received, 0);
+        if (n == 0) return 0;
+        if (n < 0) return (errno == ECONNRESET) ? 0 : -1;
+        received += (size_t)n;
+    }
+    if (reply[0] != 0x05 || reply[1] != 0x64) return -1;
+    return 1;
+}
+
+/**
+ * @brief Open \p outstations_per_port outstation channels on each port.
+ *
+ * @returns 0 on success, -1 if a channel could not be opened.
+ */
+static int start_outstations(const struct storm_config_t* config)
+{
+    TMWAPPL* appl = start_scl();
+    int port, i;
+
+    for (port = config->port; port < config->port + config->num_ports; port++) {
+        for (i = 0; i < config->outstations_per_port; i++) {
+            struct outstation_config_t outstation;
+            char name[32];
+
+            snprintf(name, sizeof name, "Storm%d.%d", port, i);
+            init_outstation_config(&outstation, name, port);
+            outstation.io.targTCP.polledMode = TMWDEFS_FALSE;
+            outstation.sesn.source = config->outstation_addr;
+            outstation.sesn.destination = config->master_addr;
+            if (open_outstation_session(appl, &outstation) == TMWDEFS_NULL) {
+                fprintf(stderr, "error: failed to open outstation %d on port %d\n", i, port);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+void* storm_client(void* arg)
+{
+    struct storm_client_t* client = (struct storm_client_t*)arg;
+    const struct storm_config_t* config = client->config;
+    int port = config->port + (client->index % config->num_ports);
+
+    while (!*client->stop) {
+        uint64_t start = now_us();
+        int sockfd = open_connection(config, port);
+        int result;
+
+        if (sockfd == -1) {
+            client->failed++;
+            usleep(10000);
+            continue;
+        }
+
+        if (send(sockfd, client->request, sizeof client->request, MSG_NOSIGNAL) != sizeof client->request) {
+            result = 0;
+        } else {
+            result = read_reply(sockfd);
+        }
+        close(sockfd);
+
+        if (result == 1) {
+            client->completed++;
+            if (client->num_samples < MAX_SAMPLES_PER_CLIENT) {
+                client->samples_us[client->num_samples++] = (uint32_t)(now_us() - start);
+            }
+        } else if (result == 0) {
+            client->refused++;
+        } else {
+            client->failed++;
+        }
+    }
+    client->done = 1;
+    return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+    struct storm_config_t config;
+    struct storm_client_t* clients;
+    pthread_t* threads;
+    volatile int stop = 0;
+    unsigned long completed = 0, refused = 0, failed = 0, num_samples = 0;
+    int result = EXIT_SUCCESS;
+    uint32_t* samples;
+    uint64_t end;
+    int opt, i;
+
+    config.hostname = "127.0.0.1";
+    config.port = 20000;
+    config.num_ports = 1;
+    config.num_clients = 8;
+    config.seconds = 10;
+    config.outstations_per_port = 16;
+    config.outstation_addr = 4;
+    config.master_addr = 3;
+
+    while ((opt = getopt(argc, argv, "h:p:n:c:t:d:s:o:")) != -1) {
+        switch (opt) {
+        case 'h': config.hostname = optarg; break;
+        case 'p': config.port = atoi(optarg); break;
+        case 'n': config.num_ports = atoi(optarg); break;
+        case 'c': config.num_clients = atoi(optarg); break;
+        case 't': config.seconds = atoi(optarg); break;
+        case 'd': config.outstation_addr = (uint16_t)atoi(optarg); break;
+        case 's': config.master_addr = (uint16_t)atoi(optarg); break;
+        case 'o': config.outstations_per_port = atoi(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-h host] [-p port] [-n numPorts] [-c clients] "
+                            "[-t seconds] [-d outstationAddr] [-s masterAddr] [-o outstationsPerPort]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (config.num_ports < 1) config.num_ports = 1;
+    if (config.num_clients < 1) config.num_clients = 1;
+    if (config.outstations_per_port < 0) config.outstations_per_port = 0;
+
+    clients = calloc((size_t)config.num_clients, sizeof *clients);
+    threads = calloc((size_t)config.num_clients, sizeof *threads);
+    if (clients == NULL || threads == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (config.outstations_per_port > 0) {
+        config.hostname = "127.0.0.1";
+        if (start_outstations(&config) != 0) exit(EXIT_FAILURE);
+        printf("%d outstations listening on each port\n", config.outstations_per_port);
+    }
+
+    printf("%d clients reconnecting to %s:%d", config.num_clients, config.hostname, config.port);
+    if (config.num_ports > 1) printf("-%d", config.port + config.num_ports - 1);
+    printf(" for %d seconds\n", config.seconds);
+
+    for (i = 0; i < config.num_clients; i++) {
+        clients[i].config = &config;
+        clients[i].index = i;
+        clients[i].stop = &stop;
+        clients[i].samples_us = malloc(MAX_SAMPLES_PER_CLIENT * sizeof(uint32_t));
+        if (clients[i].samples_us == NULL) {
+            fprintf(stderr, "error: out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+        build_request(clients[i].request, config.outstation_addr, config.master_addr);
+        if (pthread_create(&threads[i], NULL, storm_client, &clients[i])) {
+            fprintf(stderr, "error: failed to start client %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* The outstations use the polled timer, so keep it running until the
+       last client has had its final reply. A channel reopens on a 1 ms
+       timer after each disconnect, so check it about that often. */
+    end = now_us() + (uint64_t)config.seconds * 1000000u;
+    for (;;) {
+        int running = 0;
+        if (now_us() >= end) stop = 1;
+        for (i = 0; i < config.num_clients; i++) running += !clients[i].done;
+        if (running == 0) break;
+        if (config.outstations_per_port > 0) tmwpltmr_checkTimer();
+        usleep(1000);
+    }
+
+    for (i = 0; i < config.num_clients; i++) {
+        pthread_join(threads[i], NULL);
+        completed += clients[i].completed;
+        refused += clients[i].refused;
+        failed += clients[i].failed;
+        num_samples += clients[i].num_samples;
+    }
+
+    samples = malloc((num_samples ? num_samples : 1) * sizeof(uint32_t));
+    if (samples == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    num_samples = 0;
+    for (i = 0; i < config.num_clients; i++) {
+        memcpy(samples + num_samples, clients[i].samples_us, clients[i].num_samples * sizeof(uint32_t));
+        num_samples += clients[i].num_samples;
+        free(clients[i].samples_us);
+    }
+    qsort(samples, num_samples, sizeof(uint32_t), compare_u32);
+
+    printf("completed %lu (%.1f/s), refused %lu, failed %lu\n",
+           completed, (double)completed / config.seconds, refused, failed);
+    if (num_samples > 0) {
+        printf("connect to reply latency us: p50 %u  p90 %u  p99 %u  max %u\n",
+               samples[num_samples / 2], samples[num_samples * 9 / 10],
+               samples[num_samples * 99 / 100], samples[num_samples - 1]);
+    }
+
+    if (failed > 0 || completed == 0) {
+        result = EXIT_FAILURE;
+    } else if (num_samples > 0 && samples[num_samples / 2] > MAX_P50_US) {
+        fprintf(stderr, "error: p50 latency %u us is over %u us\n",
+                samples[num_samples / 2], MAX_P50_US);
+        result = EXIT_FAILURE;
+    }
+
+    free(samples);
+    free(threads);
+    free(clients);
+    return result;
+}
@@ -0,0 +1,413 @@
+/**
+ * @file
+ * A multidrop serial turnaround benchmark for the DNP3 outstation.
+ *
+ * A pseudo-terminal pair stands in for the serial line. The outstation runs
+ * in this process on the simulated database with one serial channel on the
+ * slave side of the pair and one session per simulated outstation address,
+ * as on a multidrop link. A small built-in DNP3 master on the master side
+ * of the pair polls the outstations in turn with class 0 reads and confirms
+ * every response that asks for it.
+ *
+ * Each outstation is polled once, untimed, after the channel opens. The
+ * report shows the turnaround for each request: the time from the last
+ * byte of the request being written to the first byte of the response
+ * arriving, and the time to receive the whole response.
+ *
+ * Usage:
+ *   dnp_serial_pty [-s sessions] [-n requests] [-r baudRate] [-b]
+ *
+ * -b writes each request one byte at a time, so the outstation sees every
+ * frame split across many reads. Exits with a failure status if any request
+ * went unanswered.
+ */
+/* Needed for posix_openpt and cfmakeraw */
+#define _GNU_SOURCE
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <poll.h>
+#include <termios.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "tmwtargio.h"
+#include "templates/dnp_outstation.h"
+
+#define MASTER_ADDR            3
+#define FIRST_OUTSTATION_ADDR  4
+#define MAX_SESSIONS           32
+#define RESPONSE_TIMEOUT_MS    5000
+#define MAX_FRAGMENT           4096
+
+/* Application layer function codes and control bits */
+#define APP_FC_CONFIRM         0x00
+#define APP_FC_READ            0x01
+#define APP_FIR                0x80
+#define APP_FIN                0x40
+#define APP_CON                0x20
+#define APP_UNS                0x10
+
+struct pty_master_t {
+    int fd;
+    int bytewise;
+    uint8_t tprt_seq;
+    uint8_t app_seq[MAX_SESSIONS];
+    uint8_t rx[MAX_FRAGMENT];
+    size_t rx_len;
+    uint16_t rx_source;
+    uint8_t stream[2048];
+    size_t stream_len;
+    uint64_t first_byte_us;
+};
+
+static void report(const char* name, uint32_t* samples, size_t num_samples)
+{
+    if (num_samples == 0) {
+        printf("%-12s no samples\n", name);
+        return;
+    }
+    qsort(samples, num_samples, sizeof(uint32_t), compare_u32);
+    printf("%-12s p50 %7u  p99 %7u  max %7u us\n", name, samples[num_samples / 2],
+           samples[num_samples * 99 / 100], samples[num_samples - 1]);
+}
+
+/* ---- Outstation ---- */
+
+/**
+ * @brief Open the serial channel on \p port_name with one session for each
+ *        of \p num_sessions outstation addresses.
+ */
+static int open_outstation(TMWAPPL* appl, const char* port_name, const char* baud_rate, int num_sessions)
+{
+    TMWTARGIO_CONFIG io_config;
+    TMWPHYS_CONFIG phys_config;
+    TMWTARG_CONFIG targ_config;
+    DNPCHNL_CONFIG chnl_config;
+    DNPLINK_CONFIG link_config;
+    DNPTPRT_CONFIG tprt_config;
+    SDNPSESN_CONFIG sesn_config;
+    TMWCHNL* channel;
+    int i;
+
+    tmwtarg_initConfig(&targ_config);
+    dnpchnl_initConfig(&chnl_config, &tprt_config, &link_config, &phys_config);
+    chnl_config.chnlDiagMask = 0;
+
+    tmwtargio_initConfig(&io_config);
+    io_config.type = TMWTARGIO_TYPE_232;
+    strcpy(io_config.targ232.chnlName, "pty");
+    snprintf(io_config.targ232.portName, sizeof io_config.targ232.portName, "%s", port_name);
+    snprintf(io_config.targ232.baudRate, sizeof io_config.targ232.baudRate, "%s", baud_rate);
+    io_config.targ232.polledMode = TMWDEFS_FALSE;
+
+    channel = dnpchnl_openChannel(appl, &chnl_config, &tprt_config, &link_config,
+                                  &phys_config, &io_config, &targ_config);
+    if (channel == TMWDEFS_NULL) return -1;
+
+    for (i = 0; i < num_sessions; i++) {
+        sdnpsesn_initConfig(&sesn_config);
+        sesn_config.source = (TMWTYPES_USHORT)(FIRST_OUTSTATION_ADDR + i);
+        sesn_config.destination = MASTER_ADDR;
+        sesn_config.unsolAllowed = TMWDEFS_FALSE;
+        sesn_config.linkStatusPeriod = 0;
+        sesn_config.sesnDiagMask = 0;
+        if (sdnpsesn_openSession(channel, &sesn_config, TMWDEFS_NULL) == TMWDEFS_NULL) return -1;
+    }
+    return 0;
+}
+
+/* ---- Master ---- */
+
+/**
+ * @brief Open a pseudo-terminal pair, returning the master side and the
+ *        name of the slave side in \p slave_name.
+ */
+static int open_pty(char* slave_name, size_t size)
+{
+    struct termios settings;
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if (fd < 0) return -1;
+    if (grantpt(fd) != 0 || unlockpt(fd) != 0 || ptsname(fd) == NULL) {
+        close(fd);
+        return -1;
+    }
+    snprintf(slave_name, size, "%s", ptsname(fd));
+
+    /* Pass the bytes through untouched in both directions */
+    if (tcgetattr(fd, &settings) == 0) {
+        cfmakeraw(&settings);
+        tcsetattr(fd, TCSANOW, &settings);
+    }
+    return fd;
+}
+
+static int write_all(struct pty_master_t* master, const uint8_t* buf, size_t len)
+{
+    size_t pos = 0;
+    size_t chunk = master->bytewise ? 1 : len;
+
+    while (pos < len) {
+        ssize_t n;
+        if (master->bytewise && pos > 0) usleep(100);
+        n = write(master->fd, buf + pos, (len - pos < chunk) ? len - pos : chunk);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN) continue;
+            return -1;
+        }
+        pos += (size_t)n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Send one application fragment to \p destination in a single link
+ *        frame.
+ */
+static int send_fragment(struct pty_master_t* master, uint16_t destination, const uint8_t* app, size_t app_len)
+{
+    uint8_t user[250];
+    uint8_t frame[292];
+    size_t user_len = app_len + 1;
+    size_t pos, frame_len = 10;
+    uint16_t crc;
+
+    user[0] = (uint8_t)(0xC0 | (master->tprt_seq++ & 0x3f));
+    memcpy(user + 1, app, app_len);
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = (uint8_t)(5 + user_len);
+    frame[3] = 0xC4;    /* DIR | PRM | UNCONFIRMED USER DATA */
+    frame[4] = (uint8_t)(destination & 0xff);
+    frame[5] = (uint8_t)(destination >> 8);
+    frame[6] = (uint8_t)(MASTER_ADDR & 0xff);
+    frame[7] = (uint8_t)(MASTER_ADDR >> 8);
+    crc = dnp_crc(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+
+    for (pos = 0; pos < user_len; pos += 16) {
+        size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+        memcpy(frame + frame_len, user + pos, block);
+        crc = dnp_crc(user + pos, block);
+        frame_len += block;
+        frame[frame_len++] = (uint8_t)(crc & 0xff);
+        frame[frame_len++] = (uint8_t)(crc >> 8);
+    }
+
+    return write_all(master, frame, frame_len);
+}
+
+/**
+ * @brief Read link frames until a whole application fragment has arrived
+ *        in master->rx. master->first_byte_us is set to the time the first
+ *        byte after the request was read.
+ *
+ * @returns 0 on success, -1 on a timeout or error.
+ */
+static int read_fragment(struct pty_master_t* master)
+{
+    struct pollfd pfd;
+
+    pfd.fd = master->fd;
+    pfd.events = POLLIN;
+    master->rx_len = 0;
+
+    for (;;) {
+        /* Handle every complete frame in the stream */
+        while (master->stream_len >= 10) {
+            uint8_t* frame = master->stream;
+            size_t user_len, frame_len, pos, out;
+
+            if (frame[0] != 0x05 || frame[1] != 0x64 || frame[2] < 5) return -1;
+            user_len = (size_t)frame[2] - 5;
+            frame_len = 10 + user_len + 2 * ((user_len + 15) / 16);
+            if (master->stream_len < frame_len) break;
+
+            /* Skip link layer frames without user data */
+            if (user_len > 0) {
+                uint8_t tprt = frame[10];
+                out = master->rx_len;
+                if (tprt & 0x40) out = 0;
+                for (pos = 0; pos < user_len; pos += 16) {
+                    size_t block = (user_len - pos < 16) ? user_len - pos : 16;
+                    size_t skip = (pos == 0) ? 1 : 0;
+                    if (out + block > sizeof master->rx) return -1;
+                    memcpy(master->rx + out, frame + 10 + pos + 2 * (pos / 16) + skip, block - skip);
+                    out += block - skip;
+                }
+                master->rx_len = out;
+                master->rx_source = (uint16_t)(frame[6] | (frame[7] << 8));
+                memmove(master->stream, master->stream + frame_len, master->stream_len - frame_len);
+                master->stream_len -= frame_len;
+                if (tprt & 0x80) return 0;
+                continue;
+            }
+            memmove(master->stream, master->stream + frame_len, master->stream_len - frame_len);
+            master->stream_len -= frame_len;
+        }
+
+        if (poll(&pfd, 1, RESPONSE_TIMEOUT_MS) <= 0) return -1;
+        {
+            ssize_t n = read(master->fd, master->stream + master->stream_len,
+                             sizeof master->stream - master->stream_len);
+            if (n <= 0) {
+                if (n < 0 && (errno == EINTR || errno == EAGAIN)) continue;
+                return -1;
+            }
+            if (master->first_byte_us == 0) master->first_byte_us = now_us();
+            master->stream_len += (size_t)n;
+        }
+    }
+}
+
+/**
+ * @brief Send a class 0 read to session \p index and read every fragment
+ *        of its response, confirming fragments that ask for it.
+ *
+ * @returns 0 on success, -1 on failure.
+ */
+static int class0_poll(struct pty_master_t* master, int index, uint32_t* turnaround_us, uint32_t* response_us)
+{
+    static const uint8_t objects[] = { 0x3c, 0x01, 0x06 };
+    uint16_t destination = (uint16_t)(FIRST_OUTSTATION_ADDR + index);
+    uint8_t request[16];
+    uint8_t seq = master->app_seq[index];
+    uint64_t sent;
+
+    master->app_seq[index] = (uint8_t)((seq + 1) & 0x0f);
+    request[0] = (uint8_t)(APP_FIR | APP_FIN | seq);
+    request[1] = APP_FC_READ;
+    memcpy(request + 2, objects, sizeof objects);
+    if (send_fragment(master, destination, request, sizeof objects + 2) != 0) return -1;
+    sent = now_us();
+    master->first_byte_us = 0;
+
+    for (;;) {
+        uint8_t control;
+
+        if (read_fragment(master) != 0 || master->rx_len < 4) return -1;
+        control = master->rx[0];
+
+        /* Unsolicited responses are not enabled, ignore anything else */
+        if ((control & APP_UNS) || (control & 0x0f) != seq || master->rx_source != destination) continue;
+
+        if (control & APP_CON) {
+            uint8_t confirm[2];
+            confirm[0] = (uint8_t)(APP_FIR | APP_FIN | (control & 0x0f));
+            confirm[1] = APP_FC_CONFIRM;
+            if (send_fragment(master, destination, confirm, sizeof confirm) != 0) return -1;
+        }
+        if (control & APP_FIN) {
+            *turnaround_us = (uint32_t)(master->first_byte_us - sent);
+            *response_us = (uint32_t)(now_us() - sent);
+            return 0;
+        }
+        seq = (uint8_t)((seq + 1) & 0x0f);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    struct pty_master_t master;
+    char slave_name[64];
+    const char* baud_rate = "115200";
+    uint32_t *turnaround, *response;
+    size_t num_samples = 0;
+    unsigned long failed = 0;
+    int num_sessions = 4, num_requests = 1000;
+    int slave_fd, opt, i;
+    TMWAPPL* appl;
+
+    memset(&master, 0, sizeof master);
+    while ((opt = getopt(argc, argv, "s:n:r:b")) != -1) {
+        switch (opt) {
+        case 's': num_sessions = atoi(optarg); break;
+        case 'n': num_requests = atoi(optarg); break;
+        case 'r': baud_rate = optarg; break;
+        case 'b': master.bytewise = 1; break;
+        default:
+            fprintf(stderr, "usage: %s [-s sessions] [-n requests] [-r baudRate] [-b]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_sessions < 1) num_sessions = 1;
+    if (num_sessions > MAX_SESSIONS) num_sessions = MAX_SESSIONS;
+    if (num_requests < 1) num_requests = 1;
+
+    turnaround = malloc((size_t)num_requests * sizeof(uint32_t));
+    response = malloc((size_t)num_requests * sizeof(uint32_t));
+    if (turnaround == NULL || response == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    master.fd = open_pty(slave_name, sizeof slave_name);
+    if (master.fd < 0) {
+        fprintf(stderr, "error: unable to open a pseudo-terminal, %s\n", strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+
+    /* Hold the slave side open so the line never hangs up between opens,
+     * and make it raw until the outstation sets it up */
+    slave_fd = open(slave_name, O_RDWR | O_NOCTTY);
+    if (slave_fd >= 0) {
+        struct termios settings;
+        if (tcgetattr(slave_fd, &settings) == 0) {
+            cfmakeraw(&settings);
+            tcsetattr(slave_fd, TCSANOW, &settings);
+        }
+    }
+
+    /* Start the outstation */
+    appl = start_scl();
+    if (open_outstation(appl, slave_name, baud_rate, num_sessions) != 0) {
+        fprintf(stderr, "error: failed to open outstation on %s\n", slave_name);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%d sessions on %s at %s baud, %d requests%s\n", num_sessions, slave_name, baud_rate,
+           num_requests, master.bytewise ? ", written a byte at a time" : "");
+
+    /* The channel opens on its own thread, so the first poll may wait for it */
+    for (i = 0; i < num_sessions; i++) {
+        uint32_t t, r;
+        if (class0_poll(&master, i, &t, &r) != 0) {
+            fprintf(stderr, "error: outstation %d did not answer\n", FIRST_OUTSTATION_ADDR + i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    for (i = 0; i < num_requests; i++) {
+        uint32_t t, r;
+        if (class0_poll(&master, i % num_sessions, &t, &r) == 0) {
+            turnaround[num_samples] = t;
+            response[num_samples++] = r;
+        } else {
+            failed++;
+            master.stream_len = 0;
+        }
+    }
+
+    printf("%lu of %d requests answered\n", (unsigned long)num_samples, num_requests);
+    report("turnaround", turnaround, num_samples);
+    report("response", response, num_samples);
+
+    close(master.fd);
+    if (slave_fd >= 0) close(slave_fd);
+    free(turnaround);
+    free(response);
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
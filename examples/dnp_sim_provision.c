@@ -0,0 +1,334 @@
+/**
+ * @file
+ * Provisioning a large simulated outstation database.
+ *
+ * The same points are added to two simulated databases (see
+ * tmwscl/dnp/sdnpsim.h), in eight object groups: one point at a time with
+ * the sdnpsim_addXxx functions, and one range per group with
+ * sdnpsim_addPoints, which stores each range in a single arena. Every
+ * hundredth point of a range is given its own settings.
+ *
+ * The two databases must hold identical points. Random points are then
+ * looked up by point number in both, the way requests from a master find
+ * them, and the bulk database is checked again after deleting and adding
+ * points, which breaks up an arena.
+ *
+ * The report shows the time to add the points and the lookups per second.
+ *
+ * Usage:
+ *   dnp_sim_provision [-n points per group] [-l lookups]
+ *
+ * Exits with a failure status if any check fails.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/dnp/sdnpmem.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#include "templates/dnp_outstation.h"
+
+#define OVERRIDE_STRIDE 100
+
+static const TMWTYPES_UCHAR groups[] = {
+    DNPDEFS_OBJ_1_BIN_INPUTS,    DNPDEFS_OBJ_3_DBL_INPUTS,    DNPDEFS_OBJ_10_BIN_OUTS,
+    DNPDEFS_OBJ_20_RUNNING_CNTRS, DNPDEFS_OBJ_21_FROZEN_CNTRS, DNPDEFS_OBJ_30_ANA_INPUTS,
+    DNPDEFS_OBJ_31_FRZN_ANA_INPUTS, DNPDEFS_OBJ_40_ANA_OUT_STATUSES,
+};
+#define NUM_GROUPS (sizeof groups / sizeof groups[0])
+
+/* Neither database belongs to an open session */
+static SDNPSESN session;
+
+static TMWSIM_TABLE_HEAD* group_table(SDNPSIM_DATABASE* db, TMWTYPES_UCHAR group)
+{
+    switch (group) {
+    case DNPDEFS_OBJ_1_BIN_INPUTS: return &db->binaryInputs;
+    case DNPDEFS_OBJ_3_DBL_INPUTS: return &db->doubleInputs;
+    case DNPDEFS_OBJ_10_BIN_OUTS: return &db->binaryOutputs;
+    case DNPDEFS_OBJ_20_RUNNING_CNTRS: return &db->binaryCounters;
+    case DNPDEFS_OBJ_21_FROZEN_CNTRS: return &db->frozenCounters;
+    case DNPDEFS_OBJ_30_ANA_INPUTS: return &db->analogInputs;
+    case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS: return &db->frozenAnalogInputs;
+    default: return &db->analogOutputs;
+    }
+}
+
+/**
+ * @brief Settings of point \p i, every hundredth point differs from the
+ *        rest of its range.
+ */
+static SDNPSIM_POINT_INIT point_init(unsigned long i)
+{
+    SDNPSIM_POINT_INIT init;
+    if (i % OVERRIDE_STRIDE == OVERRIDE_STRIDE - 1) {
+        init.classMask = TMWDEFS_CLASS_MASK_TWO;
+        init.flags = 0x41;
+        init.value = (TMWTYPES_DOUBLE)(i % 1000);
+    } else {
+        init.classMask = TMWDEFS_CLASS_MASK_ONE;
+        init.flags = 0x01;
+        init.value = 0;
+    }
+    return init;
+}
+
+static void* new_database(void)
+{
+    void* db = sdnpsim_init((TMWSESN*)&session);
+    if (db != NULL) sdnpsim_clear(db);
+    return db;
+}
+
+static int add_one_at_a_time(void* db, unsigned long count)
+{
+    unsigned long i;
+    size_t g;
+
+    for (g = 0; g < NUM_GROUPS; g++) {
+        for (i = 0; i < count; i++) {
+            SDNPSIM_POINT_INIT init = point_init(i);
+            void* point;
+            switch (groups[g]) {
+            case DNPDEFS_OBJ_1_BIN_INPUTS:
+                point = sdnpsim_addBinaryInput(db, init.classMask, init.flags, init.value != 0);
+                break;
+            case DNPDEFS_OBJ_3_DBL_INPUTS:
+                point = sdnpsim_addDoubleInput(db, init.classMask, init.flags);
+                break;
+            case DNPDEFS_OBJ_10_BIN_OUTS:
+                point = sdnpsim_addBinaryOutput(db, init.classMask, init.flags, init.value != 0, 0xff);
+                break;
+            case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+                point = sdnpsim_addBinaryCounter(db, init.classMask, init.classMask, init.flags,
+                                                 (TMWTYPES_ULONG)init.value);
+                break;
+            case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+                point = sdnpsim_addFrozenCounter(db, init.classMask, init.classMask, init.flags,
+                                                 (TMWTYPES_ULONG)init.value);
+                break;
+            case DNPDEFS_OBJ_30_ANA_INPUTS:
+                point = sdnpsim_addAnalogInput(db, init.classMask, init.flags, (TMWSIM_DATA_TYPE)init.value, 0);
+                break;
+            case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+                point = sdnpsim_addfrznAnlgInput(db, init.classMask, init.flags, (TMWSIM_DATA_TYPE)init.value);
+                break;
+            default:
+                point = sdnpsim_addAnalogOutput(db, init.classMask, init.flags, (TMWSIM_DATA_TYPE)init.value);
+                break;
+            }
+            if (point == NULL) return -1;
+        }
+    }
+    return 0;
+}
+
+static int add_in_bulk(void* db, unsigned long count, SDNPSIM_POINT_OVERRIDE* overrides)
+{
+    SDNPSIM_POINT_INIT defaults = point_init(0);
+    unsigned long i;
+    TMWTYPES_USHORT num_overrides = 0;
+    size_t g;
+
+    for (i = OVERRIDE_STRIDE - 1; i < count; i += OVERRIDE_STRIDE) {
+        overrides[num_overrides].offset = (TMWTYPES_USHORT)i;
+        overrides[num_overrides].init = point_init(i);
+        num_overrides++;
+    }
+    for (g = 0; g < NUM_GROUPS; g++) {
+        if (sdnpsim_addPoints(db, groups[g], (TMWTYPES_USHORT)count, &defaults, overrides, num_overrides) == NULL)
+            return -1;
+    }
+    return 0;
+}
+
+static int same_value(const TMWSIM_POINT* a, const TMWSIM_POINT* b)
+{
+    switch (a->type) {
+    case TMWSIM_TYPE_BINARY:
+        return a->data.binary.value == b->data.binary.value;
+    case TMWSIM_TYPE_DOUBLE_BINARY:
+        return a->data.doubleBinary.value == b->data.doubleBinary.value;
+    case TMWSIM_TYPE_COUNTER:
+        return a->data.counter.value == b->data.counter.value;
+    case TMWSIM_TYPE_ANALOG:
+        return a->data.analog.value == b->data.analog.value && a->data.analog.deadband == b->data.analog.deadband;
+    default:
+        return 0;
+    }
+}
+
+static int same_point(const TMWSIM_POINT* a, const TMWSIM_POINT* b)
+{
+    return a->pointNumber == b->pointNumber && a->type == b->type && a->classMask == b->classMask &&
+           a->flags == b->flags && a->defaultStaticVariation == b->defaultStaticVariation &&
+           a->defaultEventVariation == b->defaultEventVariation && a->eventMode == b->eventMode &&
+           a->enabled == b->enabled && a->pSCLHandle == b->pSCLHandle &&
+           same_value(a, b);
+}
+
+/**
+ * @brief Every point of the bulk database must match the same point added
+ *        one at a time.
+ */
+static int compare(SDNPSIM_DATABASE* single, SDNPSIM_DATABASE* bulk, unsigned long count)
+{
+    size_t g;
+
+    for (g = 0; g < NUM_GROUPS; g++) {
+        TMWSIM_TABLE_HEAD* a = group_table(single, groups[g]);
+        TMWSIM_TABLE_HEAD* b = group_table(bulk, groups[g]);
+        TMWSIM_POINT *pa = NULL, *pb = NULL;
+        unsigned long i;
+
+        if (tmwsim_tableSize(a) != count || tmwsim_tableSize(b) != count) {
+            fprintf(stderr, "error: group %u holds %u and %u points, expected %lu\n", groups[g],
+                    tmwsim_tableSize(a), tmwsim_tableSize(b), count);
+            return -1;
+        }
+        for (i = 0; i < count; i++) {
+            pa = tmwsim_tableGetNextPoint(a, pa);
+            pb = tmwsim_tableGetNextPoint(b, pb);
+            if (pa == NULL || pb == NULL || !same_point(pa, pb) || pb->pointNumber != i || pb->pDbHandle != bulk ||
+                (groups[g] == DNPDEFS_OBJ_10_BIN_OUTS && pa->data.binary.control != pb->data.binary.control) ||
+                (groups[g] == DNPDEFS_OBJ_30_ANA_INPUTS &&
+                 pa->data.analog.defaultDeadbandVariation != pb->data.analog.defaultDeadbandVariation)) {
+                fprintf(stderr, "error: group %u point %lu differs\n", groups[g], i);
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Look up every point by number and by index.
+ */
+static int check_lookups(TMWSIM_TABLE_HEAD* table, unsigned long count)
+{
+    TMWSIM_POINT* point = NULL;
+    unsigned long i;
+
+    for (i = 0; i < count; i++) {
+        point = tmwsim_tableGetNextPoint(table, point);
+        if (point == NULL || tmwsim_tableFindPoint(table, i) != point ||
+            (i <= 0xffff && tmwsim_tableFindPointByIndex(table, (TMWTYPES_USHORT)i) != point)) {
+            fprintf(stderr, "error: point %lu not found\n", i);
+            return -1;
+        }
+    }
+    if (tmwsim_tableFindPoint(table, count) != NULL ||
+        (count <= 0xffff && tmwsim_tableFindPointByIndex(table, (TMWTYPES_USHORT)count) != NULL)) {
+        fprintf(stderr, "error: point %lu found past the end of the table\n", count);
+        return -1;
+    }
+    return 0;
+}
+
+static double lookups_per_second(void* db, unsigned long count, unsigned long lookups)
+{
+    unsigned long i, found = 0, seed = 12345;
+    uint64_t start = now_us(), elapsed;
+
+    for (i = 0; i < lookups; i++) {
+        seed = seed * 6364136223846793005ul + 1442695040888963407ul;
+        if (sdnpsim_anlgInGetPoint(db, (TMWTYPES_USHORT)((seed >> 33) % count)) != NULL) found++;
+    }
+    elapsed = now_us() - start;
+    if (found != lookups) return -1;
+    return lookups * 1e6 / (double)(elapsed ? elapsed : 1);
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned long count = 12500, lookups = 20000;
+    SDNPSIM_POINT_OVERRIDE* overrides;
+    void *single, *bulk;
+    uint64_t start, single_us, bulk_us;
+    double single_rate, bulk_rate;
+    int failed = 0, opt;
+
+    while ((opt = getopt(argc, argv, "n:l:")) != -1) {
+        switch (opt) {
+        case 'n': count = strtoul(optarg, NULL, 0); break;
+        case 'l': lookups = strtoul(optarg, NULL, 0); break;
+        default:
+            fprintf(stderr, "usage: %s [-n points per group] [-l lookups]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (count < 2) count = 2;
+    if (count > 0xff00) count = 0xff00;
+
+    if (start_scl() == NULL || !sdnpmem_init(TMWDEFS_NULL)) {
+        fprintf(stderr, "error: could not initialize memory\n");
+        return EXIT_FAILURE;
+    }
+
+    overrides = (SDNPSIM_POINT_OVERRIDE*)calloc(count / OVERRIDE_STRIDE + 1, sizeof *overrides);
+    single = new_database();
+    bulk = new_database();
+    if (overrides == NULL || single == NULL || bulk == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        return EXIT_FAILURE;
+    }
+    printf("%lu points in each of %u object groups, %lu lookups\n", count, (unsigned)NUM_GROUPS, lookups);
+
+    start = now_us();
+    if (add_one_at_a_time(single, count) != 0) {
+        fprintf(stderr, "error: could not add points one at a time\n");
+        return EXIT_FAILURE;
+    }
+    single_us = now_us() - start;
+
+    start = now_us();
+    if (add_in_bulk(bulk, count, overrides) != 0) {
+        fprintf(stderr, "error: could not add points in bulk\n");
+        return EXIT_FAILURE;
+    }
+    bulk_us = now_us() - start;
+
+    if (compare((SDNPSIM_DATABASE*)single, (SDNPSIM_DATABASE*)bulk, count) != 0) failed = 1;
+    if (check_lookups(&((SDNPSIM_DATABASE*)bulk)->analogInputs, count) != 0) failed = 1;
+
+    single_rate = lookups_per_second(single, count, lookups);
+    bulk_rate = lookups_per_second(bulk, count, lookups);
+    printf("%-14s %10.1f ms to add  %12.0f lookups/s\n", "one at a time", single_us / 1000.0, single_rate);
+    printf("%-14s %10.1f ms to add  %12.0f lookups/s\n", "bulk", bulk_us / 1000.0, bulk_rate);
+    if (single_rate < 0 || bulk_rate < 0) {
+        fprintf(stderr, "error: lookup missed a point\n");
+        failed = 1;
+    }
+
+    /* Deleting the last point breaks up the arena, lookups must walk it */
+    if (!sdnpsim_deleteAnalogInput(bulk) || check_lookups(&((SDNPSIM_DATABASE*)bulk)->analogInputs, count - 1) != 0)
+        failed = 1;
+    if (sdnpsim_addAnalogInput(bulk, TMWDEFS_CLASS_MASK_ONE, 0x01, 0, 0) == NULL ||
+        check_lookups(&((SDNPSIM_DATABASE*)bulk)->analogInputs, count) != 0)
+        failed = 1;
+
+    /* A second range follows the first, a range past point 65535 is refused */
+    {
+        SDNPSIM_POINT_INIT init = point_init(0);
+        TMWSIM_POINT* first = (TMWSIM_POINT*)sdnpsim_addPoints(bulk, DNPDEFS_OBJ_1_BIN_INPUTS, 1, &init, NULL, 0);
+        if (first == NULL || first->pointNumber != count ||
+            check_lookups(&((SDNPSIM_DATABASE*)bulk)->binaryInputs, count + 1) != 0) {
+            fprintf(stderr, "error: second range not added after the first\n");
+            failed = 1;
+        }
+        if (sdnpsim_addPoints(bulk, DNPDEFS_OBJ_1_BIN_INPUTS, 0xffff, &init, NULL, 0) != NULL) {
+            fprintf(stderr, "error: range past point 65535 added\n");
+            failed = 1;
+        }
+    }
+
+    sdnpsim_close(single);
+    sdnpsim_close(bulk);
+    free(overrides);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
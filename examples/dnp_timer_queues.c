@@ -0,0 +1,254 @@
+/**
+ * @file
+ * Checks the per-channel timer queues of the Linux target, built with
+ * TMWCNFG_MULTIPLE_TIMER_QS.
+ *
+ * Each channel has its own timer queue, driven by a timerfd that the
+ * channel thread waits on along with its sockets. This opens a number of
+ * outstation channels, some with a master connected and some only
+ * listening, and keeps a timer running on each channel's queue. Every
+ * expiry records how late the callback ran and starts the timer again
+ * with a new random timeout.
+ *
+ * Once all timers have run, the channels are left idle and the wakeups
+ * of the process's other threads are counted. A channel thread that waits
+ * on its timerfd with no timer armed should not wake at all, one that
+ * polls its timer queue wakes every 100 ms.
+ *
+ * Usage:
+ *   dnp_timer_queues [-p port] [-c channels] [-r rounds] [-l maxLateMs]
+ *                    [-t idleSeconds] [-w maxIdleWakeups]
+ *
+ * Exits with failure if a timer ran more than maxLateMs late, or if the
+ * idle channels woke more than maxIdleWakeups times per channel per second,
+ * by default at all.
+ */
+#define _GNU_SOURCE
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+
+#include "templates/dnp_outstation.h"
+
+#if !TMWCNFG_MULTIPLE_TIMER_QS
+#error dnp_timer_queues must be built with TMWCNFG_MULTIPLE_TIMER_QS set to TMWDEFS_TRUE
+#endif
+
+#define MAX_TIMEOUT_MS 100
+#define WAIT_MARGIN_S  5
+#define CONNECT_ATTEMPTS 200
+
+struct timer_channel_t {
+    TMWSESN* session;
+    TMWCHNL* channel;
+    TMWTIMER timer;
+    uint64_t due_us;
+    int round;
+    int rounds;
+    unsigned int seed;
+    uint32_t* late_us;
+    volatile int done;
+};
+
+static void start_timer(struct timer_channel_t* timer_channel);
+
+static void timer_expired(void* param)
+{
+    struct timer_channel_t* timer_channel = (struct timer_channel_t*)param;
+    uint64_t now = now_us();
+
+    timer_channel->late_us[timer_channel->round] =
+        (uint32_t)((now > timer_channel->due_us) ? now - timer_channel->due_us : 0);
+
+    if (++timer_channel->round < timer_channel->rounds) {
+        start_timer(timer_channel);
+        return;
+    }
+    timer_channel->done = 1;
+}
+
+static void start_timer(struct timer_channel_t* timer_channel)
+{
+    TMWTYPES_MILLISECONDS timeout = 1 + (TMWTYPES_MILLISECONDS)(rand_r(&timer_channel->seed) % MAX_TIMEOUT_MS);
+
+    timer_channel->due_us = now_us() + (uint64_t)timeout * 1000u;
+    tmwtimer_start(&timer_channel->timer, timeout, timer_channel->channel,
+                   timer_expired, timer_channel);
+}
+
+/**
+ * @brief Connect a socket to an outstation, retrying while its listener
+ * thread starts up.
+ */
+static int connect_master(int port)
+{
+    struct sockaddr_in addr;
+    int attempt;
+
+    memset(&addr, 0, sizeof addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (attempt = 0; attempt < CONNECT_ATTEMPTS; attempt++) {
+        int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+        if (sockfd == -1) return -1;
+        if (connect(sockfd, (struct sockaddr*)&addr, sizeof addr) == 0) return sockfd;
+        close(sockfd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+/**
+ * @brief Voluntary context switches of every thread but this one, which
+ * sleeps while they are counted.
+ */
+static long voluntary_switches(void)
+{
+    struct rusage process, self;
+    getrusage(RUSAGE_SELF, &process);
+    getrusage(RUSAGE_THREAD, &self);
+    return process.ru_nvcsw - self.ru_nvcsw;
+}
+
+int main(int argc, char* argv[])
+{
+    struct timer_channel_t* timer_channels;
+    int* sockets;
+    uint32_t* samples;
+    TMWAPPL* appl;
+    int port = 20400;
+    int num_channels = 16;
+    int rounds = 20;
+    int max_late_ms = 20;
+    int idle_seconds = 2;
+    double max_idle_wakeups = 0.0;
+    double idle_wakeups;
+    unsigned long num_samples = 0;
+    uint64_t deadline;
+    long switches;
+    int opt, i, j, running;
+    int result = EXIT_SUCCESS;
+
+    while ((opt = getopt(argc, argv, "p:c:r:l:t:w:")) != -1) {
+        switch (opt) {
+        case 'p': port = atoi(optarg); break;
+        case 'c': num_channels = atoi(optarg); break;
+        case 'r': rounds = atoi(optarg); break;
+        case 'l': max_late_ms = atoi(optarg); break;
+        case 't': idle_seconds = atoi(optarg); break;
+        case 'w': max_idle_wakeups = atof(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-p port] [-c channels] [-r rounds] [-l maxLateMs] "
+                            "[-t idleSeconds] [-w maxIdleWakeups]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_channels < 1) num_channels = 1;
+    if (rounds < 1) rounds = 1;
+
+    timer_channels = calloc((size_t)num_channels, sizeof *timer_channels);
+    sockets = calloc((size_t)num_channels, sizeof *sockets);
+    samples = malloc((size_t)num_channels * (size_t)rounds * sizeof(uint32_t));
+    if (timer_channels == NULL || sockets == NULL || samples == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Each channel listens on its own port, so every other one can be
+       given a master connection */
+    appl = start_scl();
+    for (i = 0; i < num_channels; i++) {
+        struct outstation_config_t outstation;
+        char name[32];
+
+        snprintf(name, sizeof name, "Timers%d", i);
+        init_outstation_config(&outstation, name, port + i);
+        outstation.io.targTCP.polledMode = TMWDEFS_FALSE;
+        /* The channel only starts listening once a session is opened on it */
+        timer_channels[i].session = open_outstation_session(appl, &outstation);
+        if (timer_channels[i].session == TMWDEFS_NULL) {
+            fprintf(stderr, "error: failed to open channel %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+        timer_channels[i].channel = timer_channels[i].session->pChannel;
+        sockets[i] = -1;
+    }
+    for (i = 0; i < num_channels; i += 2) {
+        sockets[i] = connect_master(port + i);
+        if (sockets[i] == -1) {
+            fprintf(stderr, "error: failed to connect to channel %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    printf("%d channels, %d connected, %d timers of 1-%d ms each\n",
+           num_channels, (num_channels + 1) / 2, rounds, MAX_TIMEOUT_MS);
+
+    for (i = 0; i < num_channels; i++) {
+        tmwtimer_init(&timer_channels[i].timer);
+        timer_channels[i].rounds = rounds;
+        timer_channels[i].seed = (unsigned int)i + 1;
+        timer_channels[i].late_us = samples + (size_t)i * (size_t)rounds;
+        start_timer(&timer_channels[i]);
+    }
+
+    deadline = now_us() + ((uint64_t)rounds * MAX_TIMEOUT_MS / 1000u + WAIT_MARGIN_S) * 1000000u;
+    do {
+        usleep(10000);
+        running = 0;
+        for (i = 0; i < num_channels; i++) running += !timer_channels[i].done;
+    } while (running > 0 && now_us() < deadline);
+
+    if (running > 0) {
+        printf("error: %d channels did not run all of their timers\n", running);
+        result = EXIT_FAILURE;
+    }
+
+    for (i = 0; i < num_channels; i++) {
+        for (j = 0; j < timer_channels[i].round; j++) {
+            samples[num_samples++] = timer_channels[i].late_us[j];
+        }
+    }
+    qsort(samples, num_samples, sizeof(uint32_t), compare_u32);
+    if (num_samples > 0) {
+        printf("timer lateness us: p50 %u  p99 %u  max %u\n",
+               samples[num_samples / 2], samples[num_samples * 99 / 100], samples[num_samples - 1]);
+        if (samples[num_samples - 1] > (uint32_t)max_late_ms * 1000u) {
+            printf("error: a timer ran more than %d ms late\n", max_late_ms);
+            result = EXIT_FAILURE;
+        }
+    }
+
+    /* All timer queues are empty now, so the channel threads should not
+       wake at all */
+    switches = voluntary_switches();
+    sleep((unsigned int)idle_seconds);
+    switches = voluntary_switches() - switches;
+    idle_wakeups = (double)switches / num_channels / (idle_seconds > 0 ? idle_seconds : 1);
+    printf("idle wakeups: %ld in %d s, %.1f per channel per second\n",
+           switches, idle_seconds, idle_wakeups);
+    if (idle_wakeups > max_idle_wakeups) {
+        printf("error: idle channels woke more than %.1f times per second\n", max_idle_wakeups);
+        result = EXIT_FAILURE;
+    }
+
+    for (i = 0; i < num_channels; i++) {
+        if (sockets[i] != -1) close(sockets[i]);
+        sdnpsesn_closeSession(timer_channels[i].session);
+        dnpchnl_closeChannel(timer_channels[i].channel);
+    }
+
+    free(samples);
+    free(sockets);
+    free(timer_channels);
+    return result;
+}
@@ -0,0 +1,412 @@
+/**
+ * @file
+ * Checks the Linux worker pool runtime in tmwtargrt.c, built with
+ * TMWCNFG_MULTIPLE_TIMER_QS.
+ *
+ * The runtime opens a number of TCP outstation channels, each with one
+ * session, spread over a few worker threads. A master connects to every
+ * channel and sends link status requests, timing the round trip to the
+ * link status response. Every channel is also handed a function through
+ * tmwtargrt_submit, which starts a timer on the channel's own queue, and
+ * the time until the submitted function runs and the lateness of the
+ * timer are recorded. Each channel's work must run on one worker thread.
+ *
+ * Afterwards the masters stay connected but quiet, and the wakeups of the
+ * process are counted. Idle workers block until a descriptor or timer is
+ * ready, so they should hardly wake at all. Finally every master
+ * reconnects and sends one more link status request.
+ *
+ * Usage:
+ *   dnp_worker_pool [-p port] [-c channels] [-n workers] [-r rounds]
+ *                   [-l maxLateMs] [-t idleSeconds] [-w maxIdleWakeups]
+ *
+ * Exits with failure if a request or timer is lost, if a timer ran more
+ * than maxLateMs late, if the idle workers woke more than maxIdleWakeups
+ * times per worker per second, or if a master could not reconnect.
+ */
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <poll.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+
+#include "tmwtargrt.h"
+#include "templates/dnp_outstation.h"
+
+#if !TMWTARGRT_SUPPORTED
+#error dnp_worker_pool must be built with TMWCNFG_MULTIPLE_TIMER_QS set to TMWDEFS_TRUE
+#endif
+
+#define MASTER_ADDR        3
+#define OUTSTATION_ADDR    4
+#define TIMER_MS           20
+#define RESPONSE_TIMEOUT_MS 2000
+#define WAIT_MARGIN_S      5
+#define CONNECT_ATTEMPTS   200
+#define RECONNECT_ATTEMPTS 5
+
+/* Link layer function codes */
+#define LINK_FC_REQUEST_STATUS 0x09
+#define LINK_FC_STATUS         0x0B
+#define LINK_DIR               0x80
+#define LINK_PRM               0x40
+
+struct pool_t {
+    TMWTARGRT* runtime;
+    int port;
+    TMWSESN** sessions;
+};
+
+struct pool_channel_t {
+    struct pool_t* pool;
+    int index;
+    TMWTIMER timer;
+    uint64_t submitted_us;
+    uint64_t due_us;
+    uint32_t submit_us;
+    uint32_t late_us;
+    pthread_t thread;
+    int started;
+    int wrong_thread;
+    volatile int done;
+};
+
+static TMWCHNL* open_channel(void* param, TMWAPPL* appl, int index)
+{
+    struct pool_t* pool = (struct pool_t*)param;
+    struct outstation_config_t outstation;
+    char name[32];
+
+    snprintf(name, sizeof name, "Pool%d", index);
+    init_outstation_config(&outstation, name, pool->port + index);
+    outstation.io.targTCP.polledMode = TMWDEFS_FALSE;
+    outstation.sesn.source = OUTSTATION_ADDR;
+    outstation.sesn.destination = MASTER_ADDR;
+    pool->sessions[index] = open_outstation_session(appl, &outstation);
+    return (pool->sessions[index] != TMWDEFS_NULL) ? pool->sessions[index]->pChannel : TMWDEFS_NULL;
+}
+
+static void close_channel(void* param, TMWCHNL* channel, int index)
+{
+    struct pool_t* pool = (struct pool_t*)param;
+
+    if (pool->sessions[index] != TMWDEFS_NULL) {
+        sdnpsesn_closeSession(pool->sessions[index]);
+        pool->sessions[index] = TMWDEFS_NULL;
+    }
+    dnpchnl_closeChannel(channel);
+}
+
+static void timer_expired(void* param)
+{
+    struct pool_channel_t* pool_channel = (struct pool_channel_t*)param;
+    uint64_t now = now_us();
+
+    pool_channel->late_us = (uint32_t)((now > pool_channel->due_us) ? now - pool_channel->due_us : 0);
+    pool_channel->wrong_thread |= !pthread_equal(pthread_self(), pool_channel->thread);
+    pool_channel->done = 1;
+}
+
+/* Runs on the channel's worker thread */
+static void start_timer(void* param)
+{
+    struct pool_channel_t* pool_channel = (struct pool_channel_t*)param;
+    uint64_t now = now_us();
+
+    pool_channel->submit_us = (uint32_t)(now - pool_channel->submitted_us);
+    if (pool_channel->started) {
+        pool_channel->wrong_thread |= !pthread_equal(pthread_self(), pool_channel->thread);
+    }
+    pool_channel->thread = pthread_self();
+    pool_channel->started = 1;
+    pool_channel->due_us = now + TIMER_MS * 1000u;
+    tmwtimer_start(&pool_channel->timer, TIMER_MS,
+                   tmwtargrt_getChannel(pool_channel->pool->runtime, pool_channel->index),
+                   timer_expired, pool_channel);
+}
+
+/**
+ * @brief Connect a socket to an outstation, retrying while its channel
+ * starts listening.
+ */
+static int connect_master(int port)
+{
+    struct sockaddr_in addr;
+    int attempt;
+    int one = 1;
+
+    memset(&addr, 0, sizeof addr);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (attempt = 0; attempt < CONNECT_ATTEMPTS; attempt++) {
+        int sockfd = socket(AF_INET, SOCK_STREAM, 0);
+        if (sockfd == -1) return -1;
+        if (connect(sockfd, (struct sockaddr*)&addr, sizeof addr) == 0) {
+            setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof one);
+            return sockfd;
+        }
+        close(sockfd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+/**
+ * @brief Send a link status request and wait for the link status response.
+ * Returns the round trip in microseconds, or -1 on failure.
+ */
+static int64_t link_status(int sockfd)
+{
+    uint8_t frame[10];
+    uint8_t response[10];
+    size_t received = 0;
+    uint64_t start;
+    uint16_t crc;
+
+    frame[0] = 0x05;
+    frame[1] = 0x64;
+    frame[2] = 5;
+    frame[3] = LINK_DIR | LINK_PRM | LINK_FC_REQUEST_STATUS;
+    frame[4] = OUTSTATION_ADDR & 0xff;
+    frame[5] = OUTSTATION_ADDR >> 8;
+    frame[6] = MASTER_ADDR & 0xff;
+    frame[7] = MASTER_ADDR >> 8;
+    crc = dnp_crc(frame, 8);
+    frame[8] = (uint8_t)(crc & 0xff);
+    frame[9] = (uint8_t)(crc >> 8);
+
+    start = now_us();
+    if (send(sockfd, frame, sizeof frame, 0) != (ssize_t)sizeof frame) return -1;
+
+    while (received < sizeof response) {
+        struct pollfd pfd;
+        ssize_t n;
+
+        pfd.fd = sockfd;
+        pfd.events = POLLIN;
+        if (poll(&pfd, 1, RESPONSE_TIMEOUT_MS) <= 0) return -1;
+        n = recv(sockfd, response + received, sizeof response - received, 0);
+        if (n <= 0) return -1;
+        received += (size_t)n;
+    }
+    if ((response[0] != 0x05) || (response[1] != 0x64) || ((response[3] & 0x0f) != LINK_FC_STATUS)) {
+        return -1;
+    }
+    return (int64_t)(now_us() - start);
+}
+
+/**
+ * @brief Connect a new master once the previous one has closed. A
+ * connection that arrives before the outstation has seen the previous one
+ * close is dropped, so retry the way a master would.
+ */
+static int reconnect_master(int port)
+{
+    int attempt;
+
+    for (attempt = 0; attempt < RECONNECT_ATTEMPTS; attempt++) {
+        int sockfd = connect_master(port);
+        if (sockfd == -1) return -1;
+        if (link_status(sockfd) >= 0) return sockfd;
+        close(sockfd);
+        usleep(10000);
+    }
+    return -1;
+}
+
+static long voluntary_switches(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw;
+}
+
+static void print_percentiles(const char* name, uint32_t* samples, size_t count)
+{
+    qsort(samples, count, sizeof(uint32_t), compare_u32);
+    printf("%s us: p50 %u  p99 %u  max %u\n", name,
+           samples[count / 2], samples[count * 99 / 100], samples[count - 1]);
+}
+
+int main(int argc, char* argv[])
+{
+    TMWTARGRT_CONFIG config;
+    struct pool_t pool;
+    struct pool_channel_t* pool_channels;
+    int* sockets;
+    uint32_t* samples;
+    uint32_t* late_samples;
+    int num_channels = 64;
+    int num_workers = 4;
+    int rounds = 20;
+    int max_late_ms = 20;
+    int idle_seconds = 2;
+    double max_idle_wakeups = 1.0;
+    double idle_wakeups;
+    size_t num_samples = 0;
+    uint64_t deadline;
+    long switches;
+    int opt, i, j, running;
+    int result = EXIT_SUCCESS;
+
+    pool.port = 20600;
+    while ((opt = getopt(argc, argv, "p:c:n:r:l:t:w:")) != -1) {
+        switch (opt) {
+        case 'p': pool.port = atoi(optarg); break;
+        case 'c': num_channels = atoi(optarg); break;
+        case 'n': num_workers = atoi(optarg); break;
+        case 'r': rounds = atoi(optarg); break;
+        case 'l': max_late_ms = atoi(optarg); break;
+        case 't': idle_seconds = atoi(optarg); break;
+        case 'w': max_idle_wakeups = atof(optarg); break;
+        default:
+            fprintf(stderr, "usage: %s [-p port] [-c channels] [-n workers] [-r rounds] "
+                            "[-l maxLateMs] [-t idleSeconds] [-w maxIdleWakeups]\n", argv[0]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (num_channels < 1) num_channels = 1;
+    if (num_workers < 1) num_workers = 1;
+    if (rounds < 1) rounds = 1;
+
+    pool.sessions = calloc((size_t)num_channels, sizeof *pool.sessions);
+    pool_channels = calloc((size_t)num_channels, sizeof *pool_channels);
+    sockets = calloc((size_t)num_channels, sizeof *sockets);
+    samples = malloc((size_t)num_channels * (size_t)rounds * sizeof(uint32_t));
+    late_samples = malloc((size_t)num_channels * (size_t)rounds * sizeof(uint32_t));
+    if (pool.sessions == NULL || pool_channels == NULL || sockets == NULL
+        || samples == NULL || late_samples == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Each worker creates its own application context, so only the SCL
+       itself is initialized here */
+    tmwtargp_registerPutDiagStringFunc(quiet_diag);
+    tmwappl_initSCL();
+
+    tmwtargrt_initConfig(&config);
+    config.numWorkers = num_workers;
+    pool.runtime = tmwtargrt_start(&config, num_channels, open_channel, close_channel, &pool);
+    if (pool.runtime == TMWDEFS_NULL) {
+        fprintf(stderr, "error: failed to start the runtime\n");
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < num_channels; i++) {
+        if (tmwtargrt_getChannel(pool.runtime, i) == TMWDEFS_NULL) {
+            fprintf(stderr, "error: failed to open channel %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+        sockets[i] = connect_master(pool.port + i);
+        if (sockets[i] == -1) {
+            fprintf(stderr, "error: failed to connect to channel %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    printf("%d channels on %d workers, %d rounds\n", num_channels, num_workers, rounds);
+
+    /* Link status round trips through the workers */
+    for (j = 0; j < rounds; j++) {
+        for (i = 0; i < num_channels; i++) {
+            int64_t us = link_status(sockets[i]);
+            if (us < 0) {
+                printf("error: no link status response from channel %d\n", i);
+                exit(EXIT_FAILURE);
+            }
+            samples[num_samples++] = (uint32_t)us;
+        }
+    }
+    print_percentiles("link status round trip", samples, num_samples);
+
+    /* Submitted functions starting a timer on each channel's queue */
+    num_samples = 0;
+    for (i = 0; i < num_channels; i++) {
+        pool_channels[i].pool = &pool;
+        pool_channels[i].index = i;
+        tmwtimer_init(&pool_channels[i].timer);
+    }
+    for (j = 0; j < rounds; j++) {
+        for (i = 0; i < num_channels; i++) {
+            pool_channels[i].done = 0;
+            pool_channels[i].submitted_us = now_us();
+            if (!tmwtargrt_submit(pool.runtime, i, start_timer, &pool_channels[i])) {
+                printf("error: submit queue full for channel %d\n", i);
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        deadline = now_us() + (uint64_t)WAIT_MARGIN_S * 1000000u;
+        do {
+            usleep(1000);
+            running = 0;
+            for (i = 0; i < num_channels; i++) running += !pool_channels[i].done;
+        } while (running > 0 && now_us() < deadline);
+        if (running > 0) {
+            printf("error: %d timers did not expire\n", running);
+            exit(EXIT_FAILURE);
+        }
+
+        for (i = 0; i < num_channels; i++) {
+            samples[num_samples] = pool_channels[i].submit_us;
+            late_samples[num_samples++] = pool_channels[i].late_us;
+        }
+    }
+    print_percentiles("submit to run", samples, num_samples);
+    print_percentiles("timer lateness", late_samples, num_samples);
+    for (i = 0; i < num_channels; i++) {
+        if (pool_channels[i].wrong_thread) {
+            printf("error: channel %d ran on more than one thread\n", i);
+            result = EXIT_FAILURE;
+        }
+    }
+    if (late_samples[num_samples - 1] > (uint32_t)max_late_ms * 1000u) {
+        printf("error: a timer ran more than %d ms late\n", max_late_ms);
+        result = EXIT_FAILURE;
+    }
+
+    /* The masters are connected but quiet, so the workers should only
+       wake for work submitted to them */
+    switches = voluntary_switches();
+    sleep((unsigned int)idle_seconds);
+    switches = voluntary_switches() - switches;
+    idle_wakeups = (double)switches / num_workers / (idle_seconds > 0 ? idle_seconds : 1);
+    printf("idle wakeups: %ld in %d s, %.1f per worker per second\n",
+           switches, idle_seconds, idle_wakeups);
+    if (idle_wakeups > max_idle_wakeups) {
+        printf("error: idle workers woke more than %.1f times per second\n", max_idle_wakeups);
+        result = EXIT_FAILURE;
+    }
+
+    /* Without a periodic wakeup the channels must still accept a master
+       that reconnects */
+    for (i = 0; i < num_channels; i++) {
+        close(sockets[i]);
+        sockets[i] = reconnect_master(pool.port + i);
+        if (sockets[i] == -1) {
+            printf("error: channel %d did not accept a reconnected master\n", i);
+            result = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    tmwtargrt_stop(pool.runtime);
+    for (i = 0; i < num_channels; i++) {
+        if (sockets[i] != -1) close(sockets[i]);
+    }
+
+    free(late_samples);
+    free(samples);
+    free(sockets);
+    free(pool_channels);
+    free(pool.sessions);
+    return result;
+}
@@ -0,0 +1,260 @@
+#if !defined(__DNP_OUTSTATION_TEMPLATE_H__)
+#define __DNP_OUTSTATION_TEMPLATE_H__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwtargp.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/dnp/dnpchnl.h"
+#include "tmwscl/dnp/dnplink.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwtargio.h"
+
+/*
+    Helpers shared by the dnp_* examples and benchmarks.
+*/
+
+/*
+    Monotonic time in microseconds.
+*/
+uint64_t now_us(void);
+
+uint64_t now_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+
+/*
+    The DNP3 CRC of len bytes, as appended to every link layer block.
+*/
+uint16_t dnp_crc(const uint8_t* buf, size_t len);
+
+uint16_t dnp_crc(const uint8_t* buf, size_t len) {
+    uint16_t crc = 0;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; i++) {
+        crc ^= buf[i];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ 0xA6BC) : (uint16_t)(crc >> 1);
+        }
+    }
+    return (uint16_t)~crc;
+}
+
+/*
+    qsort comparison for latency samples.
+*/
+int compare_u32(const void* a, const void* b);
+
+int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+    A diagnostic sink that drops everything, so the SCL does not flood stdout.
+*/
+void quiet_diag(const TMWDIAG_ANLZ_ID* pAnlzId, const TMWTYPES_CHAR* pString);
+
+void quiet_diag(const TMWDIAG_ANLZ_ID* pAnlzId, const TMWTYPES_CHAR* pString) {
+    TMWTARG_UNUSED_PARAM(pAnlzId);
+    TMWTARG_UNUSED_PARAM(pString);
+}
+
+/*
+    Initialize the SCL with quiet diagnostics and return the application context.
+*/
+TMWAPPL* start_scl(void);
+
+TMWAPPL* start_scl(void) {
+    tmwtargp_registerPutDiagStringFunc(quiet_diag);
+    tmwappl_initSCL();
+#if !TMWCNFG_MULTIPLE_TIMER_QS
+    /* With a timer queue per channel there is no global queue to start */
+    tmwtimer_initialize();
+#endif
+    return tmwappl_initApplication();
+}
+
+/*
+    Everything needed to open an outstation channel and one session on it.
+*/
+struct outstation_config_t {
+    TMWTARGIO_CONFIG io;
+    TMWPHYS_CONFIG phys;
+    TMWTARG_CONFIG targ;
+    DNPCHNL_CONFIG chnl;
+    DNPLINK_CONFIG link;
+    DNPTPRT_CONFIG tprt;
+    SDNPSESN_CONFIG sesn;
+};
+
+/*
+    Defaults for a TCP outstation named name, listening on 127.0.0.1:port,
+    with diagnostics, unsolicited responses and link status requests off.
+    Callers adjust the fields before opening.
+*/
+void init_outstation_config(struct outstation_config_t* config, const char* name, int port);
+
+void init_outstation_config(struct outstation_config_t* config, const char* name, int port) {
+    tmwtarg_initConfig(&config->targ);
+    dnpchnl_initConfig(&config->chnl, &config->tprt, &config->link, &config->phys);
+    config->link.networkType = DNPLINK_NETWORK_TCP_UDP;
+    config->chnl.chnlDiagMask = 0;
+
+    tmwtargio_initConfig(&config->io);
+    config->io.type = TMWTARGIO_TYPE_TCP;
+    snprintf(config->io.targTCP.chnlName, sizeof config->io.targTCP.chnlName, "%s", name);
+    strcpy(config->io.targTCP.ipAddress, "127.0.0.1");
+    config->io.targTCP.ipPort = (TMWTYPES_USHORT)port;
+    config->io.targTCP.mode = TMWTARGTCP_MODE_SERVER;
+    config->io.targTCP.role = TMWTARGTCP_ROLE_OUTSTATION;
+    config->io.targTCP.localUDPPort = TMWTARG_UDP_PORT_NONE;
+
+    sdnpsesn_initConfig(&config->sesn);
+    config->sesn.unsolAllowed = TMWDEFS_FALSE;
+    config->sesn.linkStatusPeriod = 0;
+    config->sesn.sesnDiagMask = 0;
+}
+
+/*
+    Open the channel described by config, without a session.
+*/
+TMWCHNL* open_outstation_channel(TMWAPPL* appl, struct outstation_config_t* config);
+
+TMWCHNL* open_outstation_channel(TMWAPPL* appl, struct outstation_config_t* config) {
+    return dnpchnl_openChannel(appl, &config->chnl, &config->tprt, &config->link,
+                               &config->phys, &config->io, &config->targ);
+}
+
+/*
+    Open the channel described by config and one session on it.
+*/
+TMWSESN* open_outstation_session(TMWAPPL* appl, struct outstation_config_t* config);
+
+TMWSESN* open_outstation_session(TMWAPPL* appl, struct outstation_config_t* config) {
+    TMWCHNL* channel = open_outstation_channel(appl, config);
+    if (channel == TMWDEFS_NULL) return TMWDEFS_NULL;
+    return sdnpsesn_openSession(channel, &config->sesn, TMWDEFS_NULL);
+}
+
+/*
+    An in-memory physical layer, so an outstation channel can be driven
+    without sockets or threads. Every transmit completes at once, after
+    the frame is passed to mem_tx_handler if one is set. Frames from the
+    master are handed to the link layer with feed_link.
+*/
+typedef void (*mem_tx_handler_t)(void* param, const uint8_t* frame, size_t len);
+
+mem_tx_handler_t mem_tx_handler = NULL;
+void* mem_tx_param = NULL;
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_open(TMWPHYS_CONTEXT* pContext);
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_open(TMWPHYS_CONTEXT* pContext) {
+    pContext->channelOpen = TMWPHYS_OPEN;
+    return TMWDEFS_TRUE;
+}
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_close(TMWPHYS_CONTEXT* pContext, TMWDEFS_TARG_OC_REASON reason);
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_close(TMWPHYS_CONTEXT* pContext, TMWDEFS_TARG_OC_REASON reason) {
+    TMWTARG_UNUSED_PARAM(reason);
+    pContext->channelOpen = TMWPHYS_CLOSED;
+    return TMWDEFS_TRUE;
+}
+
+void TMWDEFS_CALLBACK mem_setCallbacks(TMWPHYS_CONTEXT* pContext, TMWPHYS_CHANNEL_FUNC pChannelFunc,
+                                       TMWPHYS_NEEDED_CHARS_FUNC pNeededCharsFunc,
+                                       TMWPHYS_PARSE_FUNC pParseFunc,
+                                       TMWPHYS_CHECK_ADDRESS_FUNC pCheckAddressFunc,
+                                       void* pCallbackParam);
+
+void TMWDEFS_CALLBACK mem_setCallbacks(TMWPHYS_CONTEXT* pContext, TMWPHYS_CHANNEL_FUNC pChannelFunc,
+                                       TMWPHYS_NEEDED_CHARS_FUNC pNeededCharsFunc,
+                                       TMWPHYS_PARSE_FUNC pParseFunc,
+                                       TMWPHYS_CHECK_ADDRESS_FUNC pCheckAddressFunc,
+                                       void* pCallbackParam) {
+    pContext->pCallbackParam = pCallbackParam;
+    pContext->pParseFunc = pParseFunc;
+    pContext->pChannelFunc = pChannelFunc;
+    pContext->pNeededCharsFunc = pNeededCharsFunc;
+    pContext->pCheckAddressFunc = pCheckAddressFunc;
+}
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_transmit(TMWPHYS_CONTEXT* pContext,
+                                            const TMWPHYS_TX_DESCRIPTOR* pTxDescriptor);
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_transmit(TMWPHYS_CONTEXT* pContext,
+                                            const TMWPHYS_TX_DESCRIPTOR* pTxDescriptor) {
+    TMWTARG_UNUSED_PARAM(pContext);
+    if (pTxDescriptor->beforeTxCallback) pTxDescriptor->beforeTxCallback(pTxDescriptor->pCallbackParam);
+    if (mem_tx_handler) mem_tx_handler(mem_tx_param, pTxDescriptor->pTxBuffer, pTxDescriptor->numBytesToTx);
+    if (pTxDescriptor->afterTxCallback) pTxDescriptor->afterTxCallback(pTxDescriptor->pCallbackParam);
+    return TMWDEFS_TRUE;
+}
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_receive(TMWPHYS_CONTEXT* pContext, TMWTYPES_MILLISECONDS maxTimeout);
+
+TMWTYPES_BOOL TMWDEFS_CALLBACK mem_receive(TMWPHYS_CONTEXT* pContext, TMWTYPES_MILLISECONDS maxTimeout) {
+    TMWTARG_UNUSED_PARAM(pContext);
+    TMWTARG_UNUSED_PARAM(maxTimeout);
+    return TMWDEFS_FALSE;
+}
+
+const TMWPHYS_INTERFACE mem_phys = {
+    mem_open, mem_close, mem_setCallbacks, mem_transmit, mem_receive
+};
+
+/*
+    Open an outstation channel named name on the in-memory physical layer,
+    leaving config set up for it. Open its sessions with config->sesn, then
+    start it with tmwlink_openChannel.
+*/
+TMWCHNL* open_mem_channel(TMWAPPL* appl, struct outstation_config_t* config, const char* name);
+
+TMWCHNL* open_mem_channel(TMWAPPL* appl, struct outstation_config_t* config, const char* name) {
+    TMWCHNL* channel;
+
+    /* The target channel is never opened, so it has no socket */
+    init_outstation_config(config, name, 0);
+    config->link.networkType = DNPLINK_NETWORK_NO_IP;
+    config->phys.active = TMWDEFS_FALSE;
+    config->io.targTCP.polledMode = TMWDEFS_TRUE;
+
+    channel = open_outstation_channel(appl, config);
+    if (channel == TMWDEFS_NULL) return TMWDEFS_NULL;
+
+    /* Keep the tmwphys context, which holds the link layer callbacks */
+    channel->pPhys = &mem_phys;
+    channel->pPhysContext->active = TMWDEFS_TRUE;
+    return channel;
+}
+
+/*
+    Hand bytes to the link layer the way tmwphys does, asking it how many
+    it needs next.
+*/
+void feed_link(TMWCHNL* channel, uint8_t* bytes, size_t len);
+
+void feed_link(TMWCHNL* channel, uint8_t* bytes, size_t len) {
+    while (len > 0) {
+        size_t needed = dnplink_getNeededBytes(channel->pLinkContext);
+        if (needed == 0 || needed > len) needed = len;
+        dnplink_parseBytes(channel->pLinkContext, bytes, (TMWTYPES_USHORT)needed, 0);
+        bytes += needed;
+        len -= needed;
+    }
+}
+
+#endif
@@ -82,6 +82,56 @@ enum MQTTErrors mqtt_sync(struct mqtt_client *client) {
     return err;
 }
 
+static ssize_t __mqtt_unpack_fixed_header_only(struct mqtt_fixed_header *fixed_header, const uint8_t *buf, size_t bufsz);
+static ssize_t __mqtt_unpack_response(struct mqtt_response* response, const uint8_t *buf, size_t bufsz, uint8_t protocol_level);
+static ssize_t __mqtt_unpack_publish_response5(struct mqtt_response *mqtt_response, const uint8_t *buf);
+static ssize_t __mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
+                                              uint8_t protocol_level,
+                                              const char* client_id,
+                                              const char* will_topic,
+                                              const void* will_message,
+                                              size_t will_message_size,
+                                              const char* user_name,
+                                              const char* password,
+                                              uint8_t connect_flags,
+                                              uint16_t keep_alive,
+                                              const struct mqtt_connect_properties *properties);
+static ssize_t __mqtt_pack_subscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id,
+                                             uint8_t protocol_level,
+                                             const char *const *topic, const uint8_t *max_qos,
+                                             unsigned int num_subs);
+static ssize_t __mqtt_pack_unsubscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id,
+                                               uint8_t protocol_level,
+                                               const char *const *topic, unsigned int num_subs);
+
+/**
+ * @brief Start a connection at \p protocol_level, forgetting what was agreed with the 
+ *        broker on the last one.
+ */
+static void __mqtt_connection_reset(struct mqtt_client *client, uint8_t protocol_level,
+                                    const struct mqtt_connect_properties *properties) {
+    client->protocol_level = protocol_level;
+    client->v5.session_expiry_interval = properties != NULL ? properties->session_expiry_interval : 0;
+    client->v5.receive_maximum = 65535u;
+    client->v5.topic_alias_maximum = 0;
+    client->v5.reason_code = MQTT_REASON_SUCCESS;
+    client->v5.num_topic_aliases = 0;
+}
+
+/**
+ * @brief Forget any partly received packet and start parsing at the front of the
+ *        receive buffer.
+ */
+static void __mqtt_recv_reset(struct mqtt_client *client) {
+    client->recv_buffer.parse = client->recv_buffer.mem_start;
+    client->recv_buffer.header_size = 0;
+    client->recv_buffer.segment_start = NULL;
+    client->recv_buffer.segment_total = 0;
+    client->recv_buffer.segment_offset = 0;
+    client->recv_buffer.segment_size = 0;
+    client->recv_buffer.segment_duplicate = 0;
+}
+
 uint16_t __mqtt_next_pid(struct mqtt_client *client) {
     int pid_exists = 0;
     if (client->pid_lfsr == 0) {
@@ -132,6 +182,7 @@ enum MQTTErrors mqtt_init(struct mqtt_client *client,
     client->recv_buffer.mem_size = recvbufsz;
     client->recv_buffer.curr = client->recv_buffer.mem_start;
     client->recv_buffer.curr_sz = client->recv_buffer.mem_size;
+    __mqtt_recv_reset(client);
 
     client->error = MQTT_ERROR_CONNECT_NOT_CALLED;
     client->response_timeout = 30;
@@ -139,12 +190,14 @@ enum MQTTErrors mqtt_init(struct mqtt_client *client,
     client->number_of_keep_alives = 0;
     client->typical_response_time = -1.0f;
     client->publish_response_callback = publish_response_callback;
+    client->publish_segment_callback = NULL;
     client->pid_lfsr = 0;
     client->send_offset = 0;
 
     client->inspector_callback = NULL;
     client->reconnect_callback = NULL;
     client->reconnect_state = NULL;
+    __mqtt_connection_reset(client, MQTT_PROTOCOL_LEVEL, NULL);
 
     return MQTT_OK;
 }
@@ -165,6 +218,7 @@ void mqtt_init_reconnect(struct mqtt_client *client,
     client->recv_buffer.mem_size = 0;
     client->recv_buffer.curr = NULL;
     client->recv_buffer.curr_sz = 0;
+    __mqtt_recv_reset(client);
 
     client->error = MQTT_ERROR_INITIAL_RECONNECT;
     client->response_timeout = 30;
@@ -172,12 +226,14 @@ void mqtt_init_reconnect(struct mqtt_client *client,
     client->number_of_keep_alives = 0;
     client->typical_response_time = -1.0f;
     client->publish_response_callback = publish_response_callback;
+    client->publish_segment_callback = NULL;
     client->pid_lfsr = 0;
     client->send_offset = 0;
 
     client->inspector_callback = NULL;
     client->reconnect_callback = reconnect;
     client->reconnect_state = reconnect_state;
+    __mqtt_connection_reset(client, MQTT_PROTOCOL_LEVEL, NULL);
 }
 
 void mqtt_reinit(struct mqtt_client* client,
@@ -194,6 +250,15 @@ void mqtt_reinit(struct mqtt_client* client,
     client->recv_buffer.mem_size = recvbufsz;
     client->recv_buffer.curr = client->recv_buffer.mem_start;
     client->recv_buffer.curr_sz = client->recv_buffer.mem_size;
+    __mqtt_recv_reset(client);
+}
+
+void mqtt_set_publish_segment_callback(struct mqtt_client *client,
+                                       void (*publish_segment_callback)(void** state,
+                                           struct mqtt_response_publish *publish,
+                                           size_t offset, size_t total_size))
+{
+    client->publish_segment_callback = publish_segment_callback;
 }
 
 /** 
@@ -230,15 +295,17 @@ void mqtt_reinit(struct mqtt_client* client,
     msg = mqtt_mq_register(&client->mq, (size_t)tmp);                       \
 
 
-enum MQTTErrors mqtt_connect(struct mqtt_client *client,
-                     const char* client_id,
-                     const char* will_topic,
-                     const void* will_message,
-                     size_t will_message_size,
-                     const char* user_name,
-                     const char* password,
-                     uint8_t connect_flags,
-                     uint16_t keep_alive)
+static enum MQTTErrors __mqtt_connect(struct mqtt_client *client,
+                                      uint8_t protocol_level,
+                                      const char* client_id,
+                                      const char* will_topic,
+                                      const void* will_message,
+                                      size_t will_message_size,
+                                      const char* user_name,
+                                      const char* password,
+                                      uint8_t connect_flags,
+                                      uint16_t keep_alive,
+                                      const struct mqtt_connect_properties *properties)
 {
     ssize_t rv;
     struct mqtt_queued_message *msg;
@@ -250,14 +317,16 @@ enum MQTTErrors mqtt_connect(struct mqtt_client *client,
     if (client->error == MQTT_ERROR_CONNECT_NOT_CALLED) {
         client->error = MQTT_OK;
     }
+    __mqtt_connection_reset(client, protocol_level, properties);
     
     /* try to pack the message */
     MQTT_CLIENT_TRY_PACK(rv, msg, client, 
-        mqtt_pack_connection_request(
+        __mqtt_pack_connection_request(
             client->mq.curr, client->mq.curr_sz,
+            protocol_level,
             client_id, will_topic, will_message, 
             will_message_size,user_name, password, 
-            connect_flags, keep_alive
+            connect_flags, keep_alive, properties
         ), 
         1
     );
@@ -268,11 +337,57 @@ enum MQTTErrors mqtt_connect(struct mqtt_client *client,
     return MQTT_OK;
 }
 
-enum MQTTErrors mqtt_publish(struct mqtt_client *client,
-                     const char* topic_name,
-                     const void* application_message,
-                     size_t application_message_size,
-                     uint8_t publish_flags)
+enum MQTTErrors mqtt_connect(struct mqtt_client *client,
+                     const char* client_id,
+                     const char* will_topic,
+                     const void* will_message,
+                     size_t will_message_size,
+                     const char* user_name,
+                     const char* password,
+                     uint8_t connect_flags,
+                     uint16_t keep_alive)
+{
+    return __mqtt_connect(client, MQTT_PROTOCOL_LEVEL, client_id, will_topic, will_message,
+                          will_message_size, user_name, password, connect_flags, keep_alive, NULL);
+}
+
+enum MQTTErrors mqtt_connect5(struct mqtt_client *client,
+                      const char* client_id,
+                      const char* will_topic,
+                      const void* will_message,
+                      size_t will_message_size,
+                      const char* user_name,
+                      const char* password,
+                      uint8_t connect_flags,
+                      uint16_t keep_alive,
+                      const struct mqtt_connect_properties *properties)
+{
+    return __mqtt_connect(client, MQTT_PROTOCOL_LEVEL_5, client_id, will_topic, will_message,
+                          will_message_size, user_name, password, connect_flags, keep_alive, properties);
+}
+
+/**
+ * @brief Find the alias of a topic on a MQTT v5.0 connection.
+ * 
+ * @returns The alias, or 0 if the topic does not have one.
+ */
+static uint16_t __mqtt_find_topic_alias(const struct mqtt_client *client, const char *topic_name, size_t length) {
+    uint16_t i;
+    for(i = 0; i < client->v5.num_topic_aliases; ++i) {
+        if (client->v5.topic_aliases[i].length == length &&
+            memcmp(client->v5.topic_aliases[i].topic, topic_name, length) == 0) {
+            return (uint16_t) (i + 1);
+        }
+    }
+    return 0;
+}
+
+static enum MQTTErrors __mqtt_publish(struct mqtt_client *client,
+                                      const char* topic_name,
+                                      const void* application_message,
+                                      size_t application_message_size,
+                                      uint8_t publish_flags,
+                                      const struct mqtt_publish_properties *properties)
 {
     struct mqtt_queued_message *msg;
     ssize_t rv;
@@ -280,20 +395,55 @@ enum MQTTErrors mqtt_publish(struct mqtt_client *client,
     MQTT_PAL_MUTEX_LOCK(&client->mutex);
     packet_id = __mqtt_next_pid(client);
 
+    if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5 && topic_name != NULL) {
+        /* send the topic once, with a new alias while the broker allows more */
+        size_t topic_length = strlen(topic_name);
+        uint16_t topic_alias = __mqtt_find_topic_alias(client, topic_name, topic_length);
+        int new_alias = 0;
+        if (topic_alias == 0 && topic_length > 0 && topic_length < MQTT_TOPIC_ALIAS_TOPIC_SIZE &&
+            client->v5.num_topic_aliases < client->v5.topic_alias_maximum &&
+            client->v5.num_topic_aliases < MQTT_TOPIC_ALIASES) {
+            topic_alias = (uint16_t) (client->v5.num_topic_aliases + 1);
+            new_alias = 1;
+        }
 
-    /* try to pack the message */
-    MQTT_CLIENT_TRY_PACK(
-        rv, msg, client, 
-        mqtt_pack_publish_request(
-            client->mq.curr, client->mq.curr_sz,
-            topic_name,
-            packet_id,
-            application_message,
-            application_message_size,
-            publish_flags
-        ), 
-        1
-    );
+        /* try to pack the message */
+        MQTT_CLIENT_TRY_PACK(
+            rv, msg, client, 
+            mqtt_pack_publish_request5(
+                client->mq.curr, client->mq.curr_sz,
+                topic_alias != 0 && !new_alias ? "" : topic_name,
+                topic_alias,
+                packet_id,
+                application_message,
+                application_message_size,
+                publish_flags,
+                properties
+            ), 
+            1
+        );
+
+        /* the alias is only set once the publish that sets it is queued */
+        if (new_alias) {
+            client->v5.topic_aliases[client->v5.num_topic_aliases].length = (uint16_t) topic_length;
+            memcpy(client->v5.topic_aliases[client->v5.num_topic_aliases].topic, topic_name, topic_length + 1);
+            ++client->v5.num_topic_aliases;
+        }
+    } else {
+        /* try to pack the message */
+        MQTT_CLIENT_TRY_PACK(
+            rv, msg, client, 
+            mqtt_pack_publish_request(
+                client->mq.curr, client->mq.curr_sz,
+                topic_name,
+                packet_id,
+                application_message,
+                application_message_size,
+                publish_flags
+            ), 
+            1
+        );
+    }
     /* save the control type and packet id of the message */
     msg->control_type = MQTT_CONTROL_PUBLISH;
     msg->packet_id = packet_id;
@@ -302,6 +452,27 @@ enum MQTTErrors mqtt_publish(struct mqtt_client *client,
     return MQTT_OK;
 }
 
+enum MQTTErrors mqtt_publish(struct mqtt_client *client,
+                     const char* topic_name,
+                     const void* application_message,
+                     size_t application_message_size,
+                     uint8_t publish_flags)
+{
+    return __mqtt_publish(client, topic_name, application_message, application_message_size,
+                          publish_flags, NULL);
+}
+
+enum MQTTErrors mqtt_publish5(struct mqtt_client *client,
+                      const char* topic_name,
+                      const void* application_message,
+                      size_t application_message_size,
+                      uint8_t publish_flags,
+                      const struct mqtt_publish_properties *properties)
+{
+    return __mqtt_publish(client, topic_name, application_message, application_message_size,
+                          publish_flags, properties);
+}
+
 ssize_t __mqtt_puback(struct mqtt_client *client, uint16_t packet_id) {
     ssize_t rv;
     struct mqtt_queued_message *msg;
@@ -393,18 +564,20 @@ enum MQTTErrors mqtt_subscribe(struct mqtt_client *client,
     ssize_t rv;
     uint16_t packet_id;
     struct mqtt_queued_message *msg;
+    uint8_t max_qos = (uint8_t) max_qos_level;
     MQTT_PAL_MUTEX_LOCK(&client->mutex);
     packet_id = __mqtt_next_pid(client);
 
     /* try to pack the message */
     MQTT_CLIENT_TRY_PACK(
         rv, msg, client, 
-        mqtt_pack_subscribe_request(
+        __mqtt_pack_subscribe_request(
             client->mq.curr, client->mq.curr_sz,
             packet_id,
-            topic_name,
-            max_qos_level,
-            (const char*)NULL
+            client->protocol_level,
+            &topic_name,
+            &max_qos,
+            1
         ), 
         1
     );
@@ -427,11 +600,12 @@ enum MQTTErrors mqtt_unsubscribe(struct mqtt_client *client,
     /* try to pack the message */
     MQTT_CLIENT_TRY_PACK(
         rv, msg, client, 
-        mqtt_pack_unsubscribe_request(
+        __mqtt_pack_unsubscribe_request(
             client->mq.curr, client->mq.curr_sz,
             packet_id,
-            topic_name,
-            (const char*)NULL
+            client->protocol_level,
+            &topic_name,
+            1
         ), 
         1
     );
@@ -504,11 +678,35 @@ enum MQTTErrors mqtt_disconnect(struct mqtt_client *client)
     return MQTT_OK;
 }
 
+enum MQTTErrors mqtt_disconnect5(struct mqtt_client *client, uint8_t reason_code) 
+{
+    ssize_t rv;
+    struct mqtt_queued_message *msg;
+    MQTT_PAL_MUTEX_LOCK(&client->mutex);
+
+    /* try to pack the message */
+    MQTT_CLIENT_TRY_PACK(
+        rv, msg, client, 
+        mqtt_pack_disconnect5(
+            client->mq.curr, client->mq.curr_sz,
+            reason_code
+        ), 
+        1
+    );
+    /* save the control type and packet id of the message */
+    msg->control_type = MQTT_CONTROL_DISCONNECT;
+
+    MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
+    return MQTT_OK;
+}
+
 ssize_t __mqtt_send(struct mqtt_client *client) 
 {
     uint8_t inspected;
     ssize_t len;
     int inflight_qos2 = 0;
+    int inflight = 0;
+    int publish_held = 0;
     int i = 0;
     
     MQTT_PAL_MUTEX_LOCK(&client->mutex);
@@ -518,8 +716,21 @@ ssize_t __mqtt_send(struct mqtt_client *client)
         return client->error;
     }
 
-    /* loop through all messages in the queue */
     len = mqtt_mq_length(&client->mq);
+    if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        /* count the QoS 1 and QoS 2 publishes the broker has not finished acknowledging */
+        for(; i < len; ++i) {
+            struct mqtt_queued_message *msg = mqtt_mq_get(&client->mq, i);
+            if ((msg->control_type == MQTT_CONTROL_PUBLISH && msg->state == MQTT_QUEUED_AWAITING_ACK &&
+                 (msg->start[0] & MQTT_PUBLISH_QOS_MASK) != 0) ||
+                (msg->control_type == MQTT_CONTROL_PUBREL && msg->state != MQTT_QUEUED_COMPLETE)) {
+                ++inflight;
+            }
+        }
+        i = 0;
+    }
+
+    /* loop through all messages in the queue */
     for(; i < len; ++i) {
         struct mqtt_queued_message *msg = mqtt_mq_get(&client->mq, i);
         int resend = 0;
@@ -548,6 +759,25 @@ ssize_t __mqtt_send(struct mqtt_client *client)
             }
         }
 
+        /* 
+        MQTT v5.0: only send a QoS 1 or 2 PUBLISH while the broker's Receive Maximum allows
+        it, and hold back every PUBLISH after one that waits, so none arrives ahead of the
+        PUBLISH that sets its topic alias.
+        */
+        if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5
+            && msg->control_type == MQTT_CONTROL_PUBLISH && msg->state == MQTT_QUEUED_UNSENT)
+        {
+            inspected = 0x03 & ((msg->start[0]) >> 1); /* qos */
+            if (publish_held || (inspected > 0 && inflight >= client->v5.receive_maximum)) {
+                resend = 0;
+            }
+            if (!resend) {
+                publish_held = 1;
+            } else if (inspected > 0) {
+                ++inflight;
+            }
+        }
+
         /* goto next message if we don't need to send */
         if (!resend) {
             continue;
@@ -646,31 +876,225 @@ ssize_t __mqtt_send(struct mqtt_client *client)
     return MQTT_OK;
 }
 
+/**
+ * @brief Move the unhandled bytes to the front of the receive buffer.
+ */
+static void __mqtt_recv_compact(struct mqtt_client *client) {
+    size_t buffered = (size_t) (client->recv_buffer.curr - client->recv_buffer.parse);
+
+    if (client->recv_buffer.parse == client->recv_buffer.mem_start) return;
+    memmove(client->recv_buffer.mem_start, client->recv_buffer.parse, buffered);
+    client->recv_buffer.parse = client->recv_buffer.mem_start;
+    client->recv_buffer.curr = client->recv_buffer.mem_start + buffered;
+    client->recv_buffer.curr_sz = client->recv_buffer.mem_size - buffered;
+}
+
+/**
+ * @brief Pass up the next segment of a publish that is larger than the receive buffer.
+ * 
+ * @returns The size of the segment, or 0 if the buffer is not full yet and the rest of
+ *          the payload has not arrived.
+ */
+static ssize_t __mqtt_recv_segment(struct mqtt_client *client, struct mqtt_response *response) {
+    size_t available = (size_t) (client->recv_buffer.curr - client->recv_buffer.segment_start);
+    size_t remaining = client->recv_buffer.segment_total - client->recv_buffer.segment_offset;
+    size_t size = available < remaining ? available : remaining;
+    ssize_t rv;
+
+    if (size == 0 || (size < remaining && client->recv_buffer.curr_sz != 0)) {
+        return 0;
+    }
+
+    response->fixed_header = client->recv_buffer.fixed_header;
+    if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        rv = __mqtt_unpack_publish_response5(response, client->recv_buffer.parse + client->recv_buffer.header_size);
+    } else {
+        rv = mqtt_unpack_publish_response(response, client->recv_buffer.parse + client->recv_buffer.header_size);
+    }
+    if (rv < 0) return rv;
+    response->decoded.publish.application_message = client->recv_buffer.segment_start;
+    response->decoded.publish.application_message_size = size;
+    client->recv_buffer.segment_size = size;
+    return (ssize_t) size;
+}
+
+/**
+ * @brief Start receiving a publish that is larger than the receive buffer in segments,
+ *        once its topic and packet ID have arrived.
+ */
+static ssize_t __mqtt_recv_segment_start(struct mqtt_client *client, struct mqtt_response *response) {
+    const struct mqtt_fixed_header *fixed_header = &client->recv_buffer.fixed_header;
+    size_t header_size = client->recv_buffer.header_size;
+    size_t buffered, variable_size;
+
+    /* keep the topic at the front so the rest of the buffer is free for the payload */
+    __mqtt_recv_compact(client);
+    buffered = (size_t) (client->recv_buffer.curr - client->recv_buffer.parse);
+    if (buffered < header_size + 2) return 0;
+
+    variable_size = 2u + __mqtt_unpack_uint16(client->recv_buffer.parse + header_size);
+    if (fixed_header->control_flags & MQTT_PUBLISH_QOS_MASK) {
+        variable_size += 2u;
+    }
+    if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        /* the properties are part of the variable header too */
+        uint32_t properties_size;
+        ssize_t rv;
+        if (buffered < header_size + variable_size) return 0;
+        rv = __mqtt_unpack_varint(&properties_size, client->recv_buffer.parse + header_size + variable_size,
+                                  buffered - header_size - variable_size);
+        if (rv <= 0) return rv;
+        variable_size += (size_t) rv + properties_size;
+    }
+    if (fixed_header->remaining_length <= variable_size) {
+        return MQTT_ERROR_MALFORMED_RESPONSE;
+    }
+    if (header_size + variable_size >= client->recv_buffer.mem_size) {
+        return MQTT_ERROR_RECV_BUFFER_TOO_SMALL;
+    }
+    if (buffered < header_size + variable_size) return 0;
+
+    client->recv_buffer.segment_start = client->recv_buffer.parse + header_size + variable_size;
+    client->recv_buffer.segment_total = fixed_header->remaining_length - variable_size;
+    client->recv_buffer.segment_offset = 0;
+    client->recv_buffer.segment_size = 0;
+    client->recv_buffer.segment_duplicate = 0;
+    return __mqtt_recv_segment(client, response);
+}
+
+/**
+ * @brief Unpack the next whole packet in the receive buffer where it lies.
+ * 
+ * The fixed header of each packet is unpacked once, as soon as it has arrived, and the 
+ * rest of the packet is left in place until all of it has arrived. Bytes are only moved 
+ * when the remainder of a partly received packet would not fit behind it.
+ * 
+ * @returns The number of bytes in the packet, 0 if more data is needed, or an 
+ *          \ref MQTTErrors.
+ */
+static ssize_t __mqtt_recv_next(struct mqtt_client *client, struct mqtt_response *response) {
+    size_t buffered, packet_size;
+    ssize_t rv;
+
+    /* finish with the segment that was passed up last time */
+    if (client->recv_buffer.segment_size != 0) {
+        client->recv_buffer.segment_offset += client->recv_buffer.segment_size;
+        if (client->recv_buffer.segment_offset == client->recv_buffer.segment_total) {
+            /* anything after the payload is the start of the next packet */
+            client->recv_buffer.parse = client->recv_buffer.segment_start + client->recv_buffer.segment_size;
+            client->recv_buffer.header_size = 0;
+            client->recv_buffer.segment_total = 0;
+        } else {
+            client->recv_buffer.curr = client->recv_buffer.segment_start;
+            client->recv_buffer.curr_sz = client->recv_buffer.mem_size - (size_t) (client->recv_buffer.segment_start - client->recv_buffer.mem_start);
+        }
+        client->recv_buffer.segment_size = 0;
+    }
+    if (client->recv_buffer.segment_total != 0) {
+        return __mqtt_recv_segment(client, response);
+    }
+
+    buffered = (size_t) (client->recv_buffer.curr - client->recv_buffer.parse);
+    if (buffered == 0) {
+        /* everything has been handled, start again at the front */
+        client->recv_buffer.parse = client->recv_buffer.mem_start;
+        client->recv_buffer.curr = client->recv_buffer.mem_start;
+        client->recv_buffer.curr_sz = client->recv_buffer.mem_size;
+        return 0;
+    }
+
+    if (client->recv_buffer.header_size == 0) {
+        rv = __mqtt_unpack_fixed_header_only(&client->recv_buffer.fixed_header, client->recv_buffer.parse, buffered);
+        if (rv < 0) return rv;
+        if (rv == 0) {
+            /* the remaining length is up to 4 bytes long */
+            if (client->recv_buffer.curr_sz < 4) __mqtt_recv_compact(client);
+            return 0;
+        }
+        client->recv_buffer.header_size = (size_t) rv;
+    }
+
+    packet_size = client->recv_buffer.header_size + client->recv_buffer.fixed_header.remaining_length;
+    if (buffered < packet_size) {
+        if (packet_size > client->recv_buffer.mem_size) {
+            if (client->recv_buffer.fixed_header.control_type == MQTT_CONTROL_PUBLISH &&
+                client->publish_segment_callback != NULL) {
+                return __mqtt_recv_segment_start(client, response);
+            }
+            return MQTT_ERROR_RECV_BUFFER_TOO_SMALL;
+        }
+        if (client->recv_buffer.parse + packet_size > client->recv_buffer.mem_start + client->recv_buffer.mem_size) {
+            __mqtt_recv_compact(client);
+        }
+        return 0;
+    }
+
+    rv = __mqtt_unpack_response(response, client->recv_buffer.parse, packet_size, client->protocol_level);
+    if (rv < 0) return rv;
+    if (rv == 0) return MQTT_ERROR_MALFORMED_RESPONSE;
+    client->recv_buffer.parse += packet_size;
+    client->recv_buffer.header_size = 0;
+    return (ssize_t) packet_size;
+}
+
+/**
+ * @brief Apply the properties of the broker's MQTT v5.0 CONNACK.
+ */
+static void __mqtt_recv_connack5(struct mqtt_client *client, const struct mqtt_response_connack *connack) {
+    const uint8_t *buf = connack->properties;
+    size_t bufsz = connack->properties_size;
+    struct mqtt_property property;
+    ssize_t rv;
+
+    while((rv = mqtt_unpack_property(&property, buf, bufsz)) > 0) {
+        switch (property.identifier) {
+            case MQTT_PROP_SESSION_EXPIRY_INTERVAL:
+                client->v5.session_expiry_interval = property.value;
+                break;
+            case MQTT_PROP_RECEIVE_MAXIMUM:
+                if (property.value != 0) {
+                    client->v5.receive_maximum = (uint16_t) property.value;
+                }
+                break;
+            case MQTT_PROP_TOPIC_ALIAS_MAXIMUM:
+                client->v5.topic_alias_maximum = (uint16_t) property.value;
+                break;
+            case MQTT_PROP_SERVER_KEEP_ALIVE:
+                /* 0 turns keep alive off, pinging anyway does no harm */
+                if (property.value != 0) {
+                    client->keep_alive = (uint16_t) property.value;
+                }
+                break;
+            default:
+                break;
+        }
+        buf += rv;
+        bufsz -= (size_t) rv;
+    }
+}
+
+/**
+ * @brief Keep a MQTT v5.0 failure reason code the broker sent.
+ */
+static void __mqtt_recv_reason(struct mqtt_client *client, uint8_t reason_code) {
+    if (reason_code >= MQTT_REASON_UNSPECIFIED_ERROR) {
+        client->v5.reason_code = reason_code;
+    }
+}
+
 ssize_t __mqtt_recv(struct mqtt_client *client)
 {
     struct mqtt_response response;
     ssize_t mqtt_recv_ret = MQTT_OK;
     MQTT_PAL_MUTEX_LOCK(&client->mutex);
 
-    /* read until there is nothing left to read, or there was an error */
+    /* handle packets until there is nothing left to read, or there was an error */
     while(mqtt_recv_ret == MQTT_OK) {
-        /* read in as many bytes as possible */
         ssize_t rv, consumed;
         struct mqtt_queued_message *msg = NULL;
 
-        rv = mqtt_pal_recvall(client->socketfd, client->recv_buffer.curr, client->recv_buffer.curr_sz, 0);
-        if (rv < 0) {
-            /* an error occurred */
-            client->error = (enum MQTTErrors)rv;
-            MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
-            return rv;
-        } else {
-            client->recv_buffer.curr += rv;
-            client->recv_buffer.curr_sz -= (unsigned long)rv;
-        }
-
         /* attempt to parse */
-        consumed = mqtt_unpack_response(&response, client->recv_buffer.mem_start, (size_t) (client->recv_buffer.curr - client->recv_buffer.mem_start));
+        consumed = __mqtt_recv_next(client, &response);
 
         if (consumed < 0) {
             client->error = (enum MQTTErrors)consumed;
@@ -684,9 +1108,21 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                 return MQTT_ERROR_RECV_BUFFER_TOO_SMALL;
             }
 
-            /* just need to wait for the rest of the data */
-            MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
-            return MQTT_OK;
+            /* read in as many bytes as possible */
+            rv = mqtt_pal_recvall(client->socketfd, client->recv_buffer.curr, client->recv_buffer.curr_sz, 0);
+            if (rv < 0) {
+                /* an error occurred */
+                client->error = (enum MQTTErrors)rv;
+                MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
+                return rv;
+            } else if (rv == 0) {
+                /* just need to wait for the rest of the data */
+                MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
+                return MQTT_OK;
+            }
+            client->recv_buffer.curr += rv;
+            client->recv_buffer.curr_sz -= (unsigned long)rv;
+            continue;
         }
 
         /* response was unpacked successfully */
@@ -718,6 +1154,8 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
             -> release UNSUBSCRIBE
         MQTT_CONTROL_PINGRESP:
             -> release PINGREQ
+        MQTT_CONTROL_DISCONNECT (MQTT v5.0):
+            -> close the connection
         */
         switch (response.fixed_header.control_type) {
             case MQTT_CONTROL_CONNACK:
@@ -733,7 +1171,12 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                 client->typical_response_time = (float) (MQTT_PAL_TIME() - msg->time_sent);
                 /* check that connection was successful */
                 if (response.decoded.connack.return_code != MQTT_CONNACK_ACCEPTED) {
-                    if (response.decoded.connack.return_code == MQTT_CONNACK_REFUSED_IDENTIFIER_REJECTED) {
+                    if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+                        client->v5.reason_code = (uint8_t) response.decoded.connack.return_code;
+                    }
+                    if (response.decoded.connack.return_code == MQTT_CONNACK_REFUSED_IDENTIFIER_REJECTED ||
+                        (client->protocol_level == MQTT_PROTOCOL_LEVEL_5 &&
+                         (uint8_t) response.decoded.connack.return_code == MQTT_REASON_CLIENT_IDENTIFIER_NOT_VALID)) {
                         client->error = MQTT_ERROR_CONNECT_CLIENT_ID_REFUSED;
                         mqtt_recv_ret = MQTT_ERROR_CONNECT_CLIENT_ID_REFUSED;
                     } else {
@@ -742,8 +1185,49 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                     }
                     break;
                 }
+                if (client->protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+                    __mqtt_recv_connack5(client, &response.decoded.connack);
+                }
                 break;
             case MQTT_CONTROL_PUBLISH:
+                if (response.decoded.publish.topic_name_size == 0 && client->protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+                    /* the client allows no topic aliases, so every publish must name its topic */
+                    client->error = MQTT_ERROR_MALFORMED_RESPONSE;
+                    mqtt_recv_ret = MQTT_ERROR_MALFORMED_RESPONSE;
+                    break;
+                }
+                if (client->recv_buffer.segment_total != 0) {
+                    /* a publish larger than the receive buffer, passed up a segment at a time */
+                    size_t offset = client->recv_buffer.segment_offset;
+                    size_t total_size = client->recv_buffer.segment_total;
+
+                    /* check if this is a duplicate */
+                    if (offset == 0 && response.decoded.publish.qos_level == 2 &&
+                        mqtt_mq_find(&client->mq, MQTT_CONTROL_PUBREC, &response.decoded.publish.packet_id) != NULL) {
+                        client->recv_buffer.segment_duplicate = 1;
+                    }
+                    if (!client->recv_buffer.segment_duplicate) {
+                        client->publish_segment_callback(&client->publish_response_callback_state, &response.decoded.publish, offset, total_size);
+                    }
+
+                    /* acknowledge once the whole payload has been handled */
+                    if (offset + response.decoded.publish.application_message_size < total_size) {
+                        break;
+                    }
+                    if (response.decoded.publish.qos_level == 1) {
+                        rv = __mqtt_puback(client, response.decoded.publish.packet_id);
+                    } else if (response.decoded.publish.qos_level == 2 && !client->recv_buffer.segment_duplicate) {
+                        rv = __mqtt_pubrec(client, response.decoded.publish.packet_id);
+                    } else {
+                        rv = MQTT_OK;
+                    }
+                    if (rv != MQTT_OK) {
+                        client->error = (enum MQTTErrors)rv;
+                        mqtt_recv_ret = rv;
+                    }
+                    break;
+                }
+
                 /* stage response, none if qos==0, PUBACK if qos==1, PUBREC if qos==2 */
                 if (response.decoded.publish.qos_level == 1) {
                     rv = __mqtt_puback(client, response.decoded.publish.packet_id);
@@ -777,6 +1261,7 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                     break;
                 }
                 msg->state = MQTT_QUEUED_COMPLETE;
+                __mqtt_recv_reason(client, response.decoded.puback.reason_code);
                 /* update response time */
                 client->typical_response_time = 0.875f * (client->typical_response_time) + 0.125f * (float) (MQTT_PAL_TIME() - msg->time_sent);
                 break;
@@ -795,6 +1280,11 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                 msg->state = MQTT_QUEUED_COMPLETE;
                 /* update response time */
                 client->typical_response_time = 0.875f * (client->typical_response_time) + 0.125f * (float) (MQTT_PAL_TIME() - msg->time_sent);
+                /* a MQTT v5.0 broker that refuses the publish ends the exchange here */
+                if (response.decoded.pubrec.reason_code >= MQTT_REASON_UNSPECIFIED_ERROR) {
+                    __mqtt_recv_reason(client, response.decoded.pubrec.reason_code);
+                    break;
+                }
                 /* stage PUBREL */
                 rv = __mqtt_pubrel(client, response.decoded.pubrec.packet_id);
                 if (rv != MQTT_OK) {
@@ -831,6 +1321,7 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                     break;
                 }
                 msg->state = MQTT_QUEUED_COMPLETE;
+                __mqtt_recv_reason(client, response.decoded.pubcomp.reason_code);
                 /* update response time */
                 client->typical_response_time = 0.875f * (client->typical_response_time) + 0.125f * (float) (MQTT_PAL_TIME() - msg->time_sent);
                 break;
@@ -846,7 +1337,8 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                 /* update response time */
                 client->typical_response_time = 0.875f * (client->typical_response_time) + 0.125f * (float) (MQTT_PAL_TIME() - msg->time_sent);
                 /* check that subscription was successful (not currently only one subscribe at a time) */
-                if (response.decoded.suback.return_codes[0] == MQTT_SUBACK_FAILURE) {
+                if (response.decoded.suback.return_codes[0] >= MQTT_SUBACK_FAILURE) {
+                    __mqtt_recv_reason(client, response.decoded.suback.return_codes[0]);
                     client->error = MQTT_ERROR_SUBSCRIBE_FAILED;
                     mqtt_recv_ret = MQTT_ERROR_SUBSCRIBE_FAILED;
                     break;
@@ -861,6 +1353,9 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                     break;
                 }
                 msg->state = MQTT_QUEUED_COMPLETE;
+                if (response.decoded.unsuback.num_reason_codes > 0) {
+                    __mqtt_recv_reason(client, response.decoded.unsuback.reason_codes[0]);
+                }
                 /* update response time */
                 client->typical_response_time = 0.875f * (client->typical_response_time) + 0.125f * (float) (MQTT_PAL_TIME() - msg->time_sent);
                 break;
@@ -876,20 +1371,18 @@ ssize_t __mqtt_recv(struct mqtt_client *client)
                 /* update response time */
                 client->typical_response_time = 0.875f * (client->typical_response_time) + 0.125f * (float) (MQTT_PAL_TIME() - msg->time_sent);
                 break;
+            case MQTT_CONTROL_DISCONNECT:
+                /* the broker is closing the connection */
+                client->v5.reason_code = response.decoded.disconnect.reason_code;
+                client->error = MQTT_ERROR_CONNECTION_CLOSED;
+                mqtt_recv_ret = MQTT_ERROR_CONNECTION_CLOSED;
+                break;
             default:
                 client->error = MQTT_ERROR_MALFORMED_RESPONSE;
                 mqtt_recv_ret = MQTT_ERROR_MALFORMED_RESPONSE;
                 break;
         }
-        {
-          /* we've handled the response, now clean the buffer */
-          void* dest = (unsigned char*)client->recv_buffer.mem_start;
-          void* src  = (unsigned char*)client->recv_buffer.mem_start + consumed;
-          size_t n = (size_t) (client->recv_buffer.curr - client->recv_buffer.mem_start - consumed);
-          memmove(dest, src, n);
-          client->recv_buffer.curr -= consumed;
-          client->recv_buffer.curr_sz += (unsigned long)consumed;
-        }
+        /* the packet stays in the buffer until the next call to __mqtt_recv_next */
     }
 
     /* In case there was some error handling the (well formed) message, we end up here */
@@ -989,17 +1482,16 @@ static ssize_t mqtt_fixed_header_rule_violation(const struct mqtt_fixed_header *
     return 0;
 }
 
-ssize_t mqtt_unpack_fixed_header(struct mqtt_response *response, const uint8_t *buf, size_t bufsz) {
-    struct mqtt_fixed_header *fixed_header;
+/**
+ * @brief Unpack a fixed header without waiting for the rest of the packet.
+ * 
+ * @returns The number of bytes in the fixed header, 0 if not all of it is in \p buf, 
+ *          or an \ref MQTTErrors.
+ */
+static ssize_t __mqtt_unpack_fixed_header_only(struct mqtt_fixed_header *fixed_header, const uint8_t *buf, size_t bufsz) {
     const uint8_t *start = buf;
     int lshift;
     ssize_t errcode;
-    
-    /* check for null pointers or empty buffer */
-    if (response == NULL || buf == NULL) {
-        return MQTT_ERROR_NULLPTR;
-    }
-    fixed_header = &(response->fixed_header);
 
     /* check that bufsz is not zero */
     if (bufsz == 0) return 0;
@@ -1038,13 +1530,28 @@ ssize_t mqtt_unpack_fixed_header(struct mqtt_response *response, const uint8_t *
         return errcode;
     }
 
+    /* return how many bytes were consumed */
+    return buf - start;
+}
+
+ssize_t mqtt_unpack_fixed_header(struct mqtt_response *response, const uint8_t *buf, size_t bufsz) {
+    ssize_t rv;
+
+    /* check for null pointers or empty buffer */
+    if (response == NULL || buf == NULL) {
+        return MQTT_ERROR_NULLPTR;
+    }
+
+    rv = __mqtt_unpack_fixed_header_only(&(response->fixed_header), buf, bufsz);
+    if (rv <= 0) return rv;
+
     /* check that the buffer size if GT remaining length */
-    if (bufsz < fixed_header->remaining_length) {
+    if (bufsz - (size_t) rv < response->fixed_header.remaining_length) {
         return 0;
     }
 
     /* return how many bytes were consumed */
-    return buf - start;
+    return rv;
 }
 
 ssize_t mqtt_pack_fixed_header(uint8_t *buf, size_t bufsz, const struct mqtt_fixed_header *fixed_header) {
@@ -1101,25 +1608,200 @@ ssize_t mqtt_pack_fixed_header(uint8_t *buf, size_t bufsz, const struct mqtt_fix
     return buf - start;
 }
 
-/* CONNECT */
-ssize_t mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
-                                     const char* client_id,
-                                     const char* will_topic,
-                                     const void* will_message,
-                                     size_t will_message_size,
-                                     const char* user_name,
-                                     const char* password,
-                                     uint8_t connect_flags,
-                                     uint16_t keep_alive)
-{ 
-    struct mqtt_fixed_header fixed_header;
-    size_t remaining_length;
+/* PROPERTIES */
+
+/* how each MQTT v5.0 property is encoded, by identifier */
+enum {
+    __MQTT_PROP_NONE = 0,
+    __MQTT_PROP_BYTE,
+    __MQTT_PROP_UINT16,
+    __MQTT_PROP_UINT32,
+    __MQTT_PROP_VARINT,
+    __MQTT_PROP_STRING,
+    __MQTT_PROP_BINARY,
+    __MQTT_PROP_PAIR
+};
+
+static const uint8_t mqtt_property_types[] = {
+    __MQTT_PROP_NONE,   /* 0x00 */
+    __MQTT_PROP_BYTE,   /* 0x01 MQTT_PROP_PAYLOAD_FORMAT_INDICATOR */
+    __MQTT_PROP_UINT32, /* 0x02 MQTT_PROP_MESSAGE_EXPIRY_INTERVAL */
+    __MQTT_PROP_STRING, /* 0x03 MQTT_PROP_CONTENT_TYPE */
+    __MQTT_PROP_NONE,   /* 0x04 */
+    __MQTT_PROP_NONE,   /* 0x05 */
+    __MQTT_PROP_NONE,   /* 0x06 */
+    __MQTT_PROP_NONE,   /* 0x07 */
+    __MQTT_PROP_STRING, /* 0x08 MQTT_PROP_RESPONSE_TOPIC */
+    __MQTT_PROP_BINARY, /* 0x09 MQTT_PROP_CORRELATION_DATA */
+    __MQTT_PROP_NONE,   /* 0x0A */
+    __MQTT_PROP_VARINT, /* 0x0B MQTT_PROP_SUBSCRIPTION_IDENTIFIER */
+    __MQTT_PROP_NONE,   /* 0x0C */
+    __MQTT_PROP_NONE,   /* 0x0D */
+    __MQTT_PROP_NONE,   /* 0x0E */
+    __MQTT_PROP_NONE,   /* 0x0F */
+    __MQTT_PROP_NONE,   /* 0x10 */
+    __MQTT_PROP_UINT32, /* 0x11 MQTT_PROP_SESSION_EXPIRY_INTERVAL */
+    __MQTT_PROP_STRING, /* 0x12 MQTT_PROP_ASSIGNED_CLIENT_IDENTIFIER */
+    __MQTT_PROP_UINT16, /* 0x13 MQTT_PROP_SERVER_KEEP_ALIVE */
+    __MQTT_PROP_NONE,   /* 0x14 */
+    __MQTT_PROP_STRING, /* 0x15 MQTT_PROP_AUTHENTICATION_METHOD */
+    __MQTT_PROP_BINARY, /* 0x16 MQTT_PROP_AUTHENTICATION_DATA */
+    __MQTT_PROP_BYTE,   /* 0x17 MQTT_PROP_REQUEST_PROBLEM_INFORMATION */
+    __MQTT_PROP_UINT32, /* 0x18 MQTT_PROP_WILL_DELAY_INTERVAL */
+    __MQTT_PROP_BYTE,   /* 0x19 MQTT_PROP_REQUEST_RESPONSE_INFORMATION */
+    __MQTT_PROP_STRING, /* 0x1A MQTT_PROP_RESPONSE_INFORMATION */
+    __MQTT_PROP_NONE,   /* 0x1B */
+    __MQTT_PROP_STRING, /* 0x1C MQTT_PROP_SERVER_REFERENCE */
+    __MQTT_PROP_NONE,   /* 0x1D */
+    __MQTT_PROP_NONE,   /* 0x1E */
+    __MQTT_PROP_STRING, /* 0x1F MQTT_PROP_REASON_STRING */
+    __MQTT_PROP_NONE,   /* 0x20 */
+    __MQTT_PROP_UINT16, /* 0x21 MQTT_PROP_RECEIVE_MAXIMUM */
+    __MQTT_PROP_UINT16, /* 0x22 MQTT_PROP_TOPIC_ALIAS_MAXIMUM */
+    __MQTT_PROP_UINT16, /* 0x23 MQTT_PROP_TOPIC_ALIAS */
+    __MQTT_PROP_BYTE,   /* 0x24 MQTT_PROP_MAXIMUM_QOS */
+    __MQTT_PROP_BYTE,   /* 0x25 MQTT_PROP_RETAIN_AVAILABLE */
+    __MQTT_PROP_PAIR,   /* 0x26 MQTT_PROP_USER_PROPERTY */
+    __MQTT_PROP_UINT32, /* 0x27 MQTT_PROP_MAXIMUM_PACKET_SIZE */
+    __MQTT_PROP_BYTE,   /* 0x28 MQTT_PROP_WILDCARD_SUBSCRIPTION_AVAILABLE */
+    __MQTT_PROP_BYTE,   /* 0x29 MQTT_PROP_SUBSCRIPTION_IDENTIFIER_AVAILABLE */
+    __MQTT_PROP_BYTE    /* 0x2A MQTT_PROP_SHARED_SUBSCRIPTION_AVAILABLE */
+};
+
+ssize_t mqtt_unpack_property(struct mqtt_property *property, const uint8_t *buf, size_t bufsz) {
     const uint8_t *const start = buf;
+    const uint8_t *const end = buf + bufsz;
+    uint8_t type = __MQTT_PROP_NONE;
     ssize_t rv;
 
-    /* pack the fixed headr */
-    fixed_header.control_type = MQTT_CONTROL_CONNECT;
-    fixed_header.control_flags = 0x00;
+    if (bufsz == 0) {
+        /* end of the list */
+        return 0;
+    }
+
+    /* identifiers are variable byte integers, but all of them fit in one byte */
+    property->identifier = *buf++;
+    if (property->identifier < sizeof(mqtt_property_types)) {
+        type = mqtt_property_types[property->identifier];
+    }
+    property->value = 0;
+    property->data = NULL;
+    property->data_size = 0;
+    property->pair_value = NULL;
+    property->pair_value_size = 0;
+
+    switch (type) {
+        case __MQTT_PROP_BYTE:
+            if (end - buf < 1) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->value = *buf++;
+            break;
+        case __MQTT_PROP_UINT16:
+            if (end - buf < 2) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->value = __mqtt_unpack_uint16(buf);
+            buf += 2;
+            break;
+        case __MQTT_PROP_UINT32:
+            if (end - buf < 4) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->value = __mqtt_unpack_uint32(buf);
+            buf += 4;
+            break;
+        case __MQTT_PROP_VARINT:
+            rv = __mqtt_unpack_varint(&property->value, buf, (size_t) (end - buf));
+            if (rv <= 0) return MQTT_ERROR_MALFORMED_RESPONSE;
+            buf += rv;
+            break;
+        case __MQTT_PROP_STRING:
+        case __MQTT_PROP_BINARY:
+        case __MQTT_PROP_PAIR:
+            if (end - buf < 2) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->data_size = __mqtt_unpack_uint16(buf);
+            buf += 2;
+            if (end - buf < property->data_size) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->data = buf;
+            buf += property->data_size;
+            if (type != __MQTT_PROP_PAIR) break;
+
+            /* a user property is a name and a value */
+            if (end - buf < 2) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->pair_value_size = __mqtt_unpack_uint16(buf);
+            buf += 2;
+            if (end - buf < property->pair_value_size) return MQTT_ERROR_MALFORMED_RESPONSE;
+            property->pair_value = buf;
+            buf += property->pair_value_size;
+            break;
+        default:
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+    }
+    return buf - start;
+}
+
+/**
+ * @brief Unpack the property length and the properties of a MQTT v5.0 variable header,
+ *        checking that every property is well formed.
+ * 
+ * @returns The number of bytes taken by the property length and the properties, or
+ *          \c MQTT_ERROR_MALFORMED_RESPONSE.
+ */
+static ssize_t __mqtt_unpack_properties(const uint8_t **properties, size_t *properties_size,
+                                        const uint8_t *buf, size_t bufsz) {
+    struct mqtt_property property;
+    uint32_t length;
+    size_t offset;
+    ssize_t rv = __mqtt_unpack_varint(&length, buf, bufsz);
+
+    if (rv <= 0 || length > bufsz - (size_t) rv) {
+        return MQTT_ERROR_MALFORMED_RESPONSE;
+    }
+    *properties = buf + rv;
+    *properties_size = length;
+    for(offset = 0; offset < length; offset += (size_t) rv) {
+        rv = mqtt_unpack_property(&property, *properties + offset, length - offset);
+        if (rv <= 0) return MQTT_ERROR_MALFORMED_RESPONSE;
+    }
+    return (ssize_t) (*properties - buf) + (ssize_t) length;
+}
+
+static size_t __mqtt_user_properties_size(const struct mqtt_user_property *user_properties, size_t num_user_properties) {
+    size_t size = 0, i;
+    for(i = 0; i < num_user_properties; ++i) {
+        size += 1 + __mqtt_packed_cstrlen(user_properties[i].name) + __mqtt_packed_cstrlen(user_properties[i].value);
+    }
+    return size;
+}
+
+static ssize_t __mqtt_pack_user_properties(uint8_t *buf, const struct mqtt_user_property *user_properties, size_t num_user_properties) {
+    const uint8_t *const start = buf;
+    size_t i;
+    for(i = 0; i < num_user_properties; ++i) {
+        *buf++ = MQTT_PROP_USER_PROPERTY;
+        buf += __mqtt_pack_str(buf, user_properties[i].name);
+        buf += __mqtt_pack_str(buf, user_properties[i].value);
+    }
+    return buf - start;
+}
+
+/* CONNECT */
+static ssize_t __mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
+                                              uint8_t protocol_level,
+                                              const char* client_id,
+                                              const char* will_topic,
+                                              const void* will_message,
+                                              size_t will_message_size,
+                                              const char* user_name,
+                                              const char* password,
+                                              uint8_t connect_flags,
+                                              uint16_t keep_alive,
+                                              const struct mqtt_connect_properties *properties)
+{ 
+    struct mqtt_fixed_header fixed_header;
+    size_t remaining_length;
+    size_t properties_size = 0;
+    const uint8_t *const start = buf;
+    ssize_t rv;
+
+    /* pack the fixed headr */
+    fixed_header.control_type = MQTT_CONTROL_CONNECT;
+    fixed_header.control_flags = 0x00;
 
     /* calculate remaining length and build connect_flags at the same time */
     connect_flags = (uint8_t) (connect_flags & ~MQTT_CONNECT_RESERVED);
@@ -1128,13 +1810,30 @@ ssize_t mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
     if (client_id == NULL) {
         client_id = "";
     }
-    /* For an empty client_id, a clean session is required */
-    if (client_id[0] == '\0' && !(connect_flags & MQTT_CONNECT_CLEAN_SESSION)) {
+    /* For an empty client_id, a clean session is required (MQTT v3.1.1 only) */
+    if (client_id[0] == '\0' && !(connect_flags & MQTT_CONNECT_CLEAN_SESSION) &&
+        protocol_level != MQTT_PROTOCOL_LEVEL_5) {
         return MQTT_ERROR_CLEAN_SESSION_IS_REQUIRED;
     }
     /* mqtt_string length is strlen + 2 */
     remaining_length += __mqtt_packed_cstrlen(client_id);
 
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        /* the CONNECT properties follow the keep alive */
+        if (properties != NULL) {
+            if (properties->session_expiry_interval != 0) properties_size += 5;
+            if (properties->receive_maximum != 0) properties_size += 3;
+            if (properties->maximum_packet_size != 0) properties_size += 5;
+            properties_size += __mqtt_user_properties_size(properties->user_properties, properties->num_user_properties);
+        }
+        remaining_length += __mqtt_packed_varintlen(properties_size) + properties_size;
+
+        /* and the will has its own, empty, properties */
+        if (will_topic != NULL) {
+            remaining_length += 1;
+        }
+    }
+
     if (will_topic != NULL) {
         uint8_t temp;
         /* there is a will */
@@ -1200,13 +1899,34 @@ ssize_t mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
     *buf++ = (uint8_t) 'Q';
     *buf++ = (uint8_t) 'T';
     *buf++ = (uint8_t) 'T';
-    *buf++ = MQTT_PROTOCOL_LEVEL;
+    *buf++ = protocol_level;
     *buf++ = connect_flags;
     buf += __mqtt_pack_uint16(buf, keep_alive);
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        buf += __mqtt_pack_varint(buf, (uint32_t) properties_size);
+        if (properties != NULL) {
+            if (properties->session_expiry_interval != 0) {
+                *buf++ = MQTT_PROP_SESSION_EXPIRY_INTERVAL;
+                buf += __mqtt_pack_uint32(buf, properties->session_expiry_interval);
+            }
+            if (properties->receive_maximum != 0) {
+                *buf++ = MQTT_PROP_RECEIVE_MAXIMUM;
+                buf += __mqtt_pack_uint16(buf, properties->receive_maximum);
+            }
+            if (properties->maximum_packet_size != 0) {
+                *buf++ = MQTT_PROP_MAXIMUM_PACKET_SIZE;
+                buf += __mqtt_pack_uint32(buf, properties->maximum_packet_size);
+            }
+            buf += __mqtt_pack_user_properties(buf, properties->user_properties, properties->num_user_properties);
+        }
+    }
 
     /* pack the payload */
     buf += __mqtt_pack_str(buf, client_id);
     if (will_topic != NULL) {
+        if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+            *buf++ = 0; /* no will properties */
+        }
         buf += __mqtt_pack_str(buf, will_topic);
         buf += __mqtt_pack_uint16(buf, (uint16_t)will_message_size);
         memcpy(buf, will_message, will_message_size);
@@ -1223,17 +1943,51 @@ ssize_t mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
     return buf - start;
 }
 
+ssize_t mqtt_pack_connection_request(uint8_t* buf, size_t bufsz,
+                                     const char* client_id,
+                                     const char* will_topic,
+                                     const void* will_message,
+                                     size_t will_message_size,
+                                     const char* user_name,
+                                     const char* password,
+                                     uint8_t connect_flags,
+                                     uint16_t keep_alive)
+{
+    return __mqtt_pack_connection_request(buf, bufsz, MQTT_PROTOCOL_LEVEL,
+                                          client_id, will_topic, will_message, will_message_size,
+                                          user_name, password, connect_flags, keep_alive, NULL);
+}
+
+ssize_t mqtt_pack_connection_request5(uint8_t* buf, size_t bufsz,
+                                      const char* client_id,
+                                      const char* will_topic,
+                                      const void* will_message,
+                                      size_t will_message_size,
+                                      const char* user_name,
+                                      const char* password,
+                                      uint8_t connect_flags,
+                                      uint16_t keep_alive,
+                                      const struct mqtt_connect_properties *properties)
+{
+    return __mqtt_pack_connection_request(buf, bufsz, MQTT_PROTOCOL_LEVEL_5,
+                                          client_id, will_topic, will_message, will_message_size,
+                                          user_name, password, connect_flags, keep_alive, properties);
+}
+
 /* CONNACK */
-ssize_t mqtt_unpack_connack_response(struct mqtt_response *mqtt_response, const uint8_t *buf) {
+static ssize_t __mqtt_unpack_connack_response(struct mqtt_response *mqtt_response, const uint8_t *buf, uint8_t protocol_level) {
     const uint8_t *const start = buf;
     struct mqtt_response_connack *response;
+    uint32_t remaining_length = mqtt_response->fixed_header.remaining_length;
 
-    /* check that remaining length is 2 */
-    if (mqtt_response->fixed_header.remaining_length != 2) {
+    /* check that remaining length is 2, or at least 2 with MQTT v5.0 properties */
+    if (remaining_length != 2 && (protocol_level != MQTT_PROTOCOL_LEVEL_5 || remaining_length < 2)) {
         return MQTT_ERROR_MALFORMED_RESPONSE;
     }
     
     response = &(mqtt_response->decoded.connack);
+    response->properties = NULL;
+    response->properties_size = 0;
     
     /* unpack */
     if (*buf & 0xFE) {
@@ -1243,15 +1997,28 @@ ssize_t mqtt_unpack_connack_response(struct mqtt_response *mqtt_response, const
         response->session_present_flag = *buf++;
     }
 
-    if (*buf > 5u) {
+    if (*buf > 5u && protocol_level != MQTT_PROTOCOL_LEVEL_5) {
         /* only bit 1 can be set */
         return MQTT_ERROR_CONNACK_FORBIDDEN_CODE;
     } else {
         response->return_code = (enum MQTTConnackReturnCode) *buf++;
     }
+
+    /* a broker that does not speak MQTT v5.0 refuses it with a MQTT v3.1.1 CONNACK */
+    if (remaining_length > 2) {
+        ssize_t rv = __mqtt_unpack_properties(&response->properties, &response->properties_size, buf, remaining_length - 2);
+        if (rv != (ssize_t) (remaining_length - 2)) {
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+        }
+        buf += rv;
+    }
     return buf - start;
 }
 
+ssize_t mqtt_unpack_connack_response(struct mqtt_response *mqtt_response, const uint8_t *buf) {
+    return __mqtt_unpack_connack_response(mqtt_response, buf, MQTT_PROTOCOL_LEVEL);
+}
+
 /* DISCONNECT */
 ssize_t mqtt_pack_disconnect(uint8_t *buf, size_t bufsz) {
     struct mqtt_fixed_header fixed_header;
@@ -1261,6 +2028,44 @@ ssize_t mqtt_pack_disconnect(uint8_t *buf, size_t bufsz) {
     return mqtt_pack_fixed_header(buf, bufsz, &fixed_header);
 }
 
+ssize_t mqtt_pack_disconnect5(uint8_t *buf, size_t bufsz, uint8_t reason_code) {
+    struct mqtt_fixed_header fixed_header;
+    ssize_t rv;
+    fixed_header.control_type = MQTT_CONTROL_DISCONNECT;
+    fixed_header.control_flags = 0;
+    fixed_header.remaining_length = 1;
+    rv = mqtt_pack_fixed_header(buf, bufsz, &fixed_header);
+    if (rv <= 0) {
+        return rv;
+    }
+
+    /* the property length is left out when there are none */
+    buf[rv] = reason_code;
+    return rv + 1;
+}
+
+static ssize_t __mqtt_unpack_disconnect_response(struct mqtt_response *mqtt_response, const uint8_t *buf) {
+    const uint8_t *const start = buf;
+    uint32_t remaining_length = mqtt_response->fixed_header.remaining_length;
+    struct mqtt_response_disconnect *response = &(mqtt_response->decoded.disconnect);
+
+    /* the reason code and the properties can be left out */
+    response->reason_code = MQTT_REASON_NORMAL_DISCONNECTION;
+    response->properties = NULL;
+    response->properties_size = 0;
+    if (remaining_length > 0) {
+        response->reason_code = *buf++;
+    }
+    if (remaining_length > 1) {
+        ssize_t rv = __mqtt_unpack_properties(&response->properties, &response->properties_size, buf, remaining_length - 1);
+        if (rv != (ssize_t) (remaining_length - 1)) {
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+        }
+        buf += rv;
+    }
+    return buf - start;
+}
+
 /* PING */
 ssize_t mqtt_pack_ping_request(uint8_t *buf, size_t bufsz) {
     struct mqtt_fixed_header fixed_header;
@@ -1271,17 +2076,21 @@ ssize_t mqtt_pack_ping_request(uint8_t *buf, size_t bufsz) {
 }
 
 /* PUBLISH */
-ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
-                                  const char* topic_name,
-                                  uint16_t packet_id,
-                                  const void* application_message,
-                                  size_t application_message_size,
-                                  uint8_t publish_flags)
+static ssize_t __mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
+                                           uint8_t protocol_level,
+                                           const char* topic_name,
+                                           uint16_t topic_alias,
+                                           uint16_t packet_id,
+                                           const void* application_message,
+                                           size_t application_message_size,
+                                           uint8_t publish_flags,
+                                           const struct mqtt_publish_properties *properties)
 {
     const uint8_t *const start = buf;
     ssize_t rv;
     struct mqtt_fixed_header fixed_header;
     uint32_t remaining_length;
+    uint32_t properties_size = 0;
     uint8_t inspected_qos;
 
     /* check for null pointers */
@@ -1289,6 +2098,11 @@ ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
         return MQTT_ERROR_NULLPTR;
     }
 
+    /* without a topic the message is published under the topic of its alias */
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5 && topic_name[0] == '\0' && topic_alias == 0) {
+        return MQTT_ERROR_MALFORMED_REQUEST;
+    }
+
     /* inspect QoS level */
     inspected_qos = (publish_flags & MQTT_PUBLISH_QOS_MASK) >> 1; /* mask */
 
@@ -1300,6 +2114,22 @@ ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
     if (inspected_qos > 0) {
         remaining_length += 2;
     }
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        /* the PUBLISH properties follow the packet ID */
+        if (topic_alias != 0) properties_size += 3;
+        if (properties != NULL) {
+            if (properties->payload_format_indicator > 1) {
+                return MQTT_ERROR_MALFORMED_REQUEST;
+            }
+            if (properties->payload_format_indicator != 0) properties_size += 2;
+            if (properties->message_expiry_interval != 0) properties_size += 5;
+            if (properties->content_type != NULL) properties_size += 1 + __mqtt_packed_cstrlen(properties->content_type);
+            if (properties->response_topic != NULL) properties_size += 1 + __mqtt_packed_cstrlen(properties->response_topic);
+            if (properties->correlation_data != NULL) properties_size += 3u + properties->correlation_data_size;
+            properties_size += (uint32_t) __mqtt_user_properties_size(properties->user_properties, properties->num_user_properties);
+        }
+        remaining_length += __mqtt_packed_varintlen(properties_size) + properties_size;
+    }
     remaining_length += (uint32_t)application_message_size;
     fixed_header.remaining_length = remaining_length;
 
@@ -1333,6 +2163,38 @@ ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
     if (inspected_qos > 0) {
         buf += __mqtt_pack_uint16(buf, packet_id);
     }
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        buf += __mqtt_pack_varint(buf, properties_size);
+        if (topic_alias != 0) {
+            *buf++ = MQTT_PROP_TOPIC_ALIAS;
+            buf += __mqtt_pack_uint16(buf, topic_alias);
+        }
+        if (properties != NULL) {
+            if (properties->payload_format_indicator != 0) {
+                *buf++ = MQTT_PROP_PAYLOAD_FORMAT_INDICATOR;
+                *buf++ = properties->payload_format_indicator;
+            }
+            if (properties->message_expiry_interval != 0) {
+                *buf++ = MQTT_PROP_MESSAGE_EXPIRY_INTERVAL;
+                buf += __mqtt_pack_uint32(buf, properties->message_expiry_interval);
+            }
+            if (properties->content_type != NULL) {
+                *buf++ = MQTT_PROP_CONTENT_TYPE;
+                buf += __mqtt_pack_str(buf, properties->content_type);
+            }
+            if (properties->response_topic != NULL) {
+                *buf++ = MQTT_PROP_RESPONSE_TOPIC;
+                buf += __mqtt_pack_str(buf, properties->response_topic);
+            }
+            if (properties->correlation_data != NULL) {
+                *buf++ = MQTT_PROP_CORRELATION_DATA;
+                buf += __mqtt_pack_uint16(buf, properties->correlation_data_size);
+                memcpy(buf, properties->correlation_data, properties->correlation_data_size);
+                buf += properties->correlation_data_size;
+            }
+            buf += __mqtt_pack_user_properties(buf, properties->user_properties, properties->num_user_properties);
+        }
+    }
 
     /* pack payload */
     memcpy(buf, application_message, application_message_size);
@@ -1341,6 +2203,79 @@ ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
     return buf - start;
 }
 
+ssize_t mqtt_pack_publish_request(uint8_t *buf, size_t bufsz,
+                                  const char* topic_name,
+                                  uint16_t packet_id,
+                                  const void* application_message,
+                                  size_t application_message_size,
+                                  uint8_t publish_flags)
+{
+    return __mqtt_pack_publish_request(buf, bufsz, MQTT_PROTOCOL_LEVEL, topic_name, 0, packet_id,
+                                       application_message, application_message_size, publish_flags, NULL);
+}
+
+ssize_t mqtt_pack_publish_request5(uint8_t *buf, size_t bufsz,
+                                   const char* topic_name,
+                                   uint16_t topic_alias,
+                                   uint16_t packet_id,
+                                   const void* application_message,
+                                   size_t application_message_size,
+                                   uint8_t publish_flags,
+                                   const struct mqtt_publish_properties *properties)
+{
+    return __mqtt_pack_publish_request(buf, bufsz, MQTT_PROTOCOL_LEVEL_5, topic_name, topic_alias, packet_id,
+                                       application_message, application_message_size, publish_flags, properties);
+}
+
+/**
+ * @brief Unpack a MQTT v5.0 PUBLISH, whose properties lie between the packet ID and the
+ *        application message.
+ */
+static ssize_t __mqtt_unpack_publish_response5(struct mqtt_response *mqtt_response, const uint8_t *buf)
+{
+    const uint8_t *const start = buf;
+    struct mqtt_fixed_header *fixed_header = &(mqtt_response->fixed_header);
+    struct mqtt_response_publish *response = &(mqtt_response->decoded.publish);
+    size_t variable_size;
+    ssize_t rv;
+
+    /* get flags */
+    response->dup_flag = (fixed_header->control_flags & MQTT_PUBLISH_DUP) >> 3;
+    response->qos_level = (fixed_header->control_flags & MQTT_PUBLISH_QOS_MASK) >> 1;
+    response->retain_flag = fixed_header->control_flags & MQTT_PUBLISH_RETAIN;
+
+    /* the topic, the packet ID and at least the property length must fit */
+    if (fixed_header->remaining_length < 3) {
+        return MQTT_ERROR_MALFORMED_RESPONSE;
+    }
+    response->topic_name_size = __mqtt_unpack_uint16(buf);
+    variable_size = 2u + response->topic_name_size + (response->qos_level > 0 ? 2u : 0u);
+    if (fixed_header->remaining_length <= variable_size) {
+        return MQTT_ERROR_MALFORMED_RESPONSE;
+    }
+
+    /* parse variable header */
+    buf += 2;
+    response->topic_name = buf;
+    buf += response->topic_name_size;
+    if (response->qos_level > 0) {
+        response->packet_id = __mqtt_unpack_uint16(buf);
+        buf += 2;
+    }
+    rv = __mqtt_unpack_properties(&response->properties, &response->properties_size,
+                                  buf, fixed_header->remaining_length - variable_size);
+    if (rv < 0) return rv;
+    buf += rv;
+
+    /* get payload */
+    response->application_message = buf;
+    response->application_message_size = fixed_header->remaining_length - (size_t) (buf - start);
+    buf += response->application_message_size;
+
+    /* return number of bytes consumed */
+    return buf - start;
+}
+
 ssize_t mqtt_unpack_publish_response(struct mqtt_response *mqtt_response, const uint8_t *buf)
 {    
     const uint8_t *const start = buf;
@@ -1350,6 +2285,8 @@ ssize_t mqtt_unpack_publish_response(struct mqtt_response *mqtt_response, const
     fixed_header = &(mqtt_response->fixed_header);
     
     response = &(mqtt_response->decoded.publish);
+    response->properties = NULL;
+    response->properties_size = 0;
 
     /* get flags */
     response->dup_flag = (fixed_header->control_flags & MQTT_PUBLISH_DUP) >> 3;
@@ -1421,13 +2358,15 @@ ssize_t mqtt_pack_pubxxx_request(uint8_t *buf, size_t bufsz,
     return buf - start;
 }
 
-ssize_t mqtt_unpack_pubxxx_response(struct mqtt_response *mqtt_response, const uint8_t *buf) 
+static ssize_t __mqtt_unpack_pubxxx_response(struct mqtt_response *mqtt_response, const uint8_t *buf, uint8_t protocol_level) 
 {
     const uint8_t *const start = buf;
+    uint32_t remaining_length = mqtt_response->fixed_header.remaining_length;
     uint16_t packet_id;
+    uint8_t reason_code = MQTT_REASON_SUCCESS;
 
-    /* assert remaining length is correct */
-    if (mqtt_response->fixed_header.remaining_length != 2) {
+    /* assert remaining length is correct, MQTT v5.0 can add a reason code and properties */
+    if (remaining_length != 2 && (protocol_level != MQTT_PROTOCOL_LEVEL_5 || remaining_length < 2)) {
         return MQTT_ERROR_MALFORMED_RESPONSE;
     }
 
@@ -1435,21 +2374,44 @@ ssize_t mqtt_unpack_pubxxx_response(struct mqtt_response *mqtt_response, const u
     packet_id = __mqtt_unpack_uint16(buf);
     buf += 2;
 
+    if (remaining_length > 2) {
+        reason_code = *buf++;
+    }
+    if (remaining_length > 3) {
+        /* the properties are only of interest to the application, which does not see acks */
+        const uint8_t *properties;
+        size_t properties_size;
+        ssize_t rv = __mqtt_unpack_properties(&properties, &properties_size, buf, remaining_length - 3);
+        if (rv != (ssize_t) (remaining_length - 3)) {
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+        }
+        buf += rv;
+    }
+
     if (mqtt_response->fixed_header.control_type == MQTT_CONTROL_PUBACK) {
         mqtt_response->decoded.puback.packet_id = packet_id;
+        mqtt_response->decoded.puback.reason_code = reason_code;
     } else if (mqtt_response->fixed_header.control_type == MQTT_CONTROL_PUBREC) {
         mqtt_response->decoded.pubrec.packet_id = packet_id;
+        mqtt_response->decoded.pubrec.reason_code = reason_code;
     } else if (mqtt_response->fixed_header.control_type == MQTT_CONTROL_PUBREL) {
         mqtt_response->decoded.pubrel.packet_id = packet_id;
+        mqtt_response->decoded.pubrel.reason_code = reason_code;
     } else {
         mqtt_response->decoded.pubcomp.packet_id = packet_id;
+        mqtt_response->decoded.pubcomp.reason_code = reason_code;
     }
 
     return buf - start;
 }
 
+ssize_t mqtt_unpack_pubxxx_response(struct mqtt_response *mqtt_response, const uint8_t *buf) 
+{
+    return __mqtt_unpack_pubxxx_response(mqtt_response, buf, MQTT_PROTOCOL_LEVEL);
+}
+
 /* SUBACK */
-ssize_t mqtt_unpack_suback_response (struct mqtt_response *mqtt_response, const uint8_t *buf) {
+static ssize_t __mqtt_unpack_suback_response(struct mqtt_response *mqtt_response, const uint8_t *buf, uint8_t protocol_level) {
     const uint8_t *const start = buf;
     uint32_t remaining_length = mqtt_response->fixed_header.remaining_length;
     
@@ -1463,6 +2425,18 @@ ssize_t mqtt_unpack_suback_response (struct mqtt_response *mqtt_response, const
     buf += 2;
     remaining_length -= 2;
 
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        /* skip the properties, there must still be a reason code after them */
+        const uint8_t *properties;
+        size_t properties_size;
+        ssize_t rv = __mqtt_unpack_properties(&properties, &properties_size, buf, remaining_length);
+        if (rv < 0 || (uint32_t) rv >= remaining_length) {
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+        }
+        buf += rv;
+        remaining_length -= (uint32_t) rv;
+    }
+
     /* unpack return codes */
     mqtt_response->decoded.suback.num_return_codes = (size_t) remaining_length;
     mqtt_response->decoded.suback.return_codes = buf;
@@ -1471,40 +2445,27 @@ ssize_t mqtt_unpack_suback_response (struct mqtt_response *mqtt_response, const
     return buf - start;
 }
 
+ssize_t mqtt_unpack_suback_response (struct mqtt_response *mqtt_response, const uint8_t *buf) {
+    return __mqtt_unpack_suback_response(mqtt_response, buf, MQTT_PROTOCOL_LEVEL);
+}
+
 /* SUBSCRIBE */
-ssize_t mqtt_pack_subscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id, ...) {
-    va_list args;
+static ssize_t __mqtt_pack_subscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id,
+                                             uint8_t protocol_level,
+                                             const char *const *topic, const uint8_t *max_qos,
+                                             unsigned int num_subs) {
     const uint8_t *const start = buf;
     ssize_t rv;
     struct mqtt_fixed_header fixed_header;
-    unsigned int num_subs = 0;
     unsigned int i;
-    const char *topic[MQTT_SUBSCRIBE_REQUEST_MAX_NUM_TOPICS];
-    uint8_t max_qos[MQTT_SUBSCRIBE_REQUEST_MAX_NUM_TOPICS];
-
-    /* parse all subscriptions */
-    va_start(args, packet_id);
-    for(;;) {
-        topic[num_subs] = va_arg(args, const char*);
-        if (topic[num_subs] == NULL) {
-            /* end of list */
-            break;
-        }
-
-        max_qos[num_subs] = (uint8_t) va_arg(args, unsigned int);
-
-        ++num_subs;
-        if (num_subs >= MQTT_SUBSCRIBE_REQUEST_MAX_NUM_TOPICS) {
-            va_end(args);
-            return MQTT_ERROR_SUBSCRIBE_TOO_MANY_TOPICS;
-        }
-    }
-    va_end(args);
 
     /* build the fixed header */
     fixed_header.control_type = MQTT_CONTROL_SUBSCRIBE;
     fixed_header.control_flags = 2u;
     fixed_header.remaining_length = 2u; /* size of variable header */
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        fixed_header.remaining_length += 1u; /* no properties */
+    }
     for(i = 0; i < num_subs; ++i) {
         /* payload is topic name + max qos (1 byte) */
         fixed_header.remaining_length += __mqtt_packed_cstrlen(topic[i]) + 1;
@@ -1526,9 +2487,12 @@ ssize_t mqtt_pack_subscribe_request(uint8_t *buf, size_t bufsz, unsigned int pac
     
     /* pack variable header */
     buf += __mqtt_pack_uint16(buf, (uint16_t)packet_id);
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        *buf++ = 0;
+    }
 
 
-    /* pack payload */
+    /* pack payload, the MQTT v5.0 subscription options keep the max qos in the same bits */
     for(i = 0; i < num_subs; ++i) {
         buf += __mqtt_pack_str(buf, topic[i]);
         *buf++ = max_qos[i];
@@ -1537,53 +2501,96 @@ ssize_t mqtt_pack_subscribe_request(uint8_t *buf, size_t bufsz, unsigned int pac
     return buf - start;
 }
 
+ssize_t mqtt_pack_subscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id, ...) {
+    va_list args;
+    unsigned int num_subs = 0;
+    const char *topic[MQTT_SUBSCRIBE_REQUEST_MAX_NUM_TOPICS];
+    uint8_t max_qos[MQTT_SUBSCRIBE_REQUEST_MAX_NUM_TOPICS];
+
+    /* parse all subscriptions */
+    va_start(args, packet_id);
+    for(;;) {
+        topic[num_subs] = va_arg(args, const char*);
+        if (topic[num_subs] == NULL) {
+            /* end of list */
+            break;
+        }
+
+        max_qos[num_subs] = (uint8_t) va_arg(args, unsigned int);
+
+        ++num_subs;
+        if (num_subs >= MQTT_SUBSCRIBE_REQUEST_MAX_NUM_TOPICS) {
+            va_end(args);
+            return MQTT_ERROR_SUBSCRIBE_TOO_MANY_TOPICS;
+        }
+    }
+    va_end(args);
+
+    return __mqtt_pack_subscribe_request(buf, bufsz, packet_id, MQTT_PROTOCOL_LEVEL, topic, max_qos, num_subs);
+}
+
 /* UNSUBACK */
-ssize_t mqtt_unpack_unsuback_response(struct mqtt_response *mqtt_response, const uint8_t *buf) 
+static ssize_t __mqtt_unpack_unsuback_response(struct mqtt_response *mqtt_response, const uint8_t *buf, uint8_t protocol_level) 
 {
     const uint8_t *const start = buf;
+    uint32_t remaining_length = mqtt_response->fixed_header.remaining_length;
 
-    if (mqtt_response->fixed_header.remaining_length != 2) {
+    mqtt_response->decoded.unsuback.reason_codes = NULL;
+    mqtt_response->decoded.unsuback.num_reason_codes = 0;
+    if (protocol_level != MQTT_PROTOCOL_LEVEL_5) {
+        if (remaining_length != 2) {
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+        }
+    } else if (remaining_length < 4) {
+        /* packet id, properties and at least 1 reason code */
         return MQTT_ERROR_MALFORMED_RESPONSE;
     }
 
     /* parse packet_id */
     mqtt_response->decoded.unsuback.packet_id = __mqtt_unpack_uint16(buf);
     buf += 2;
+    remaining_length -= 2;
+
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        const uint8_t *properties;
+        size_t properties_size;
+        ssize_t rv = __mqtt_unpack_properties(&properties, &properties_size, buf, remaining_length);
+        if (rv < 0 || (uint32_t) rv >= remaining_length) {
+            return MQTT_ERROR_MALFORMED_RESPONSE;
+        }
+        buf += rv;
+        remaining_length -= (uint32_t) rv;
+
+        /* unpack reason codes */
+        mqtt_response->decoded.unsuback.reason_codes = buf;
+        mqtt_response->decoded.unsuback.num_reason_codes = (size_t) remaining_length;
+        buf += remaining_length;
+    }
 
     return buf - start;
 }
 
+ssize_t mqtt_unpack_unsuback_response(struct mqtt_response *mqtt_response, const uint8_t *buf) 
+{
+    return __mqtt_unpack_unsuback_response(mqtt_response, buf, MQTT_PROTOCOL_LEVEL);
+}
+
 /* UNSUBSCRIBE */
-ssize_t mqtt_pack_unsubscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id, ...) {
-    va_list args;
+static ssize_t __mqtt_pack_unsubscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id,
+                                               uint8_t protocol_level,
+                                               const char *const *topic, unsigned int num_subs) {
     const uint8_t *const start = buf;
     ssize_t rv;
     struct mqtt_fixed_header fixed_header;
-    unsigned int num_subs = 0;
     unsigned int i;
-    const char *topic[MQTT_UNSUBSCRIBE_REQUEST_MAX_NUM_TOPICS];
-
-    /* parse all subscriptions */
-    va_start(args, packet_id);
-    for(;;) {
-        topic[num_subs] = va_arg(args, const char*);
-        if (topic[num_subs] == NULL) {
-            /* end of list */
-            break;
-        }
-
-        ++num_subs;
-        if (num_subs >= MQTT_UNSUBSCRIBE_REQUEST_MAX_NUM_TOPICS) {
-            va_end(args);
-            return MQTT_ERROR_UNSUBSCRIBE_TOO_MANY_TOPICS;
-        }
-    }
-    va_end(args);
 
     /* build the fixed header */
     fixed_header.control_type = MQTT_CONTROL_UNSUBSCRIBE;
     fixed_header.control_flags = 2u;
     fixed_header.remaining_length = 2u; /* size of variable header */
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        fixed_header.remaining_length += 1u; /* no properties */
+    }
     for(i = 0; i < num_subs; ++i) {
         /* payload is topic name */
         fixed_header.remaining_length += __mqtt_packed_cstrlen(topic[i]);
@@ -1604,6 +2611,9 @@ ssize_t mqtt_pack_unsubscribe_request(uint8_t *buf, size_t bufsz, unsigned int p
 
     /* pack variable header */
     buf += __mqtt_pack_uint16(buf, (uint16_t)packet_id);
+    if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+        *buf++ = 0;
+    }
 
 
     /* pack payload */
@@ -1614,6 +2624,31 @@ ssize_t mqtt_pack_unsubscribe_request(uint8_t *buf, size_t bufsz, unsigned int p
     return buf - start;
 }
 
+ssize_t mqtt_pack_unsubscribe_request(uint8_t *buf, size_t bufsz, unsigned int packet_id, ...) {
+    va_list args;
+    unsigned int num_subs = 0;
+    const char *topic[MQTT_UNSUBSCRIBE_REQUEST_MAX_NUM_TOPICS];
+
+    /* parse all subscriptions */
+    va_start(args, packet_id);
+    for(;;) {
+        topic[num_subs] = va_arg(args, const char*);
+        if (topic[num_subs] == NULL) {
+            /* end of list */
+            break;
+        }
+
+        ++num_subs;
+        if (num_subs >= MQTT_UNSUBSCRIBE_REQUEST_MAX_NUM_TOPICS) {
+            va_end(args);
+            return MQTT_ERROR_UNSUBSCRIBE_TOO_MANY_TOPICS;
+        }
+    }
+    va_end(args);
+
+    return __mqtt_pack_unsubscribe_request(buf, bufsz, packet_id, MQTT_PROTOCOL_LEVEL, topic, num_subs);
+}
+
 /* MESSAGE QUEUE */
 void mqtt_mq_init(struct mqtt_message_queue *mq, void *buf, size_t bufsz) 
 {  
@@ -1701,38 +2736,49 @@ struct mqtt_queued_message* mqtt_mq_find(const struct mqtt_message_queue *mq, en
 
 
 /* RESPONSE UNPACKING */
-ssize_t mqtt_unpack_response(struct mqtt_response* response, const uint8_t *buf, size_t bufsz) {
+static ssize_t __mqtt_unpack_response(struct mqtt_response* response, const uint8_t *buf, size_t bufsz, uint8_t protocol_level) {
     const uint8_t *const start = buf;
     ssize_t rv = mqtt_unpack_fixed_header(response, buf, bufsz);
     if (rv <= 0) return rv;
     else buf += rv;
     switch(response->fixed_header.control_type) {
         case MQTT_CONTROL_CONNACK:
-            rv = mqtt_unpack_connack_response(response, buf);
+            rv = __mqtt_unpack_connack_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_PUBLISH:
-            rv = mqtt_unpack_publish_response(response, buf);
+            if (protocol_level == MQTT_PROTOCOL_LEVEL_5) {
+                rv = __mqtt_unpack_publish_response5(response, buf);
+            } else {
+                rv = mqtt_unpack_publish_response(response, buf);
+            }
             break;
         case MQTT_CONTROL_PUBACK:
-            rv = mqtt_unpack_pubxxx_response(response, buf);
+            rv = __mqtt_unpack_pubxxx_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_PUBREC:
-            rv = mqtt_unpack_pubxxx_response(response, buf);
+            rv = __mqtt_unpack_pubxxx_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_PUBREL:
-            rv = mqtt_unpack_pubxxx_response(response, buf);
+            rv = __mqtt_unpack_pubxxx_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_PUBCOMP:
-            rv = mqtt_unpack_pubxxx_response(response, buf);
+            rv = __mqtt_unpack_pubxxx_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_SUBACK:
-            rv = mqtt_unpack_suback_response(response, buf);
+            rv = __mqtt_unpack_suback_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_UNSUBACK:
-            rv = mqtt_unpack_unsuback_response(response, buf);
+            rv = __mqtt_unpack_unsuback_response(response, buf, protocol_level);
             break;
         case MQTT_CONTROL_PINGRESP:
             return rv;
+        case MQTT_CONTROL_DISCONNECT:
+            /* only a MQTT v5.0 broker sends a DISCONNECT */
+            if (protocol_level != MQTT_PROTOCOL_LEVEL_5) {
+                return MQTT_ERROR_RESPONSE_INVALID_CONTROL_TYPE;
+            }
+            rv = __mqtt_unpack_disconnect_response(response, buf);
+            break;
         default:
             return MQTT_ERROR_RESPONSE_INVALID_CONTROL_TYPE;
     }
@@ -1742,6 +2788,14 @@ ssize_t mqtt_unpack_response(struct mqtt_response* response, const uint8_t *buf,
     return buf - start;
 }
 
+ssize_t mqtt_unpack_response(struct mqtt_response* response, const uint8_t *buf, size_t bufsz) {
+    return __mqtt_unpack_response(response, buf, bufsz, MQTT_PROTOCOL_LEVEL);
+}
+
+ssize_t mqtt_unpack_response5(struct mqtt_response* response, const uint8_t *buf, size_t bufsz) {
+    return __mqtt_unpack_response(response, buf, bufsz, MQTT_PROTOCOL_LEVEL_5);
+}
+
 /* EXTRA DETAILS */
 ssize_t __mqtt_pack_uint16(uint8_t *buf, uint16_t integer)
 {
@@ -1757,6 +2811,45 @@ uint16_t __mqtt_unpack_uint16(const uint8_t *buf)
   return MQTT_PAL_NTOHS(integer_htons);
 }
 
+ssize_t __mqtt_pack_uint32(uint8_t *buf, uint32_t integer)
+{
+  buf[0] = (uint8_t) (integer >> 24);
+  buf[1] = (uint8_t) (integer >> 16);
+  buf[2] = (uint8_t) (integer >> 8);
+  buf[3] = (uint8_t) integer;
+  return 4;
+}
+
+uint32_t __mqtt_unpack_uint32(const uint8_t *buf)
+{
+  return ((uint32_t) buf[0] << 24) | ((uint32_t) buf[1] << 16) | ((uint32_t) buf[2] << 8) | (uint32_t) buf[3];
+}
+
+ssize_t __mqtt_pack_varint(uint8_t *buf, uint32_t integer)
+{
+  ssize_t n = 0;
+  do {
+    buf[n] = (uint8_t) (integer & 0x7F);
+    integer >>= 7;
+    if (integer > 0) buf[n] |= 0x80;
+    ++n;
+  } while(integer > 0);
+  return n;
+}
+
+ssize_t __mqtt_unpack_varint(uint32_t *integer, const uint8_t *buf, size_t bufsz)
+{
+  uint32_t value = 0;
+  size_t n = 0;
+  do {
+    if (n == 4) return MQTT_ERROR_MALFORMED_RESPONSE;
+    if (n == bufsz) return 0;
+    value |= (uint32_t) (buf[n] & 0x7F) << (7 * n);
+  } while(buf[n++] & 0x80);
+  *integer = value;
+  return (ssize_t) n;
+}
+
 ssize_t __mqtt_pack_str(uint8_t *buf, const char* str) {
     uint16_t length = (uint16_t)strlen(str);
     int i = 0;
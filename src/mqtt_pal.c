@@ -361,7 +361,7 @@ ssize_t mqtt_pal_sendall(mqtt_pal_socket_handle fd, const void* buf, size_t len,
 
 ssize_t mqtt_pal_recvall(mqtt_pal_socket_handle fd, void* buf, size_t bufsz, int flags) {
     const void *const start = buf;
-    enum MQTTErrors error = MQTT_OK;
+    enum MQTTErrors error = 0;
     ssize_t rv;
     do {
         rv = recv(fd, buf, bufsz, flags);
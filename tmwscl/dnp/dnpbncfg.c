@@ -26,6 +26,11 @@
 
 /* file: dnpbncfg.c
  * description: Processes binary configuration files
+ *
+ *  The whole file is held in memory while it is processed. The sizes of
+ *  all of the sections are checked against the file length before any
+ *  section is decoded, and the fields are then decoded in place. On Linux
+ *  the file is mapped rather than read.
  */
 #include "tmwscl/dnp/dnpdiag.h"
 #include "tmwscl/utils/tmwtarg.h"
@@ -36,110 +41,214 @@
 
 #if DNPCNFG_SUPPORT_BINCONFIG
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigHeader(
-  FILE *fp, 
-  DNPBNCFG_FILEVALUES *fileValues,
-  TMWTYPES_USHORT *pXMLVersionIndex);
+#if defined(TMW_LINUX_TARGET)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_1(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues,
-  TMWTARG_BINFILE_VALS *pTargBinFileValues);
+/* Number of sections that every binary configuration file contains */
+#define DNPBNCFG_NUM_SECTIONS                 13
+
+/* Size of the header at the start of the file */
+#define DNPBNCFG_HEADER_SIZE                  (3 * DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN)
+
+/* Sizes of the sections, not counting the section size field */
+#define DNPBNCFG_SECTION_SIZE1_1 \
+  (DNPBNCFG_CONTROL_SIZE1_1 + DNPBNCFG_DEVFUNCTION_SIZE1_1 + DNPBNCFG_VENDORNAME_SIZE1_1 \
+  + DNPBNCFG_DEVICENAME_SIZE1_1 + DNPBNCFG_HARDWAREVERSION_SIZE1_1 + DNPBNCFG_SOFTWAREVERSION_SIZE1_1 \
+  + DNPBNCFG_DOCVERSIONNUM_SIZE1_1 + DNPBNCFG_DNPLEVELSSUPPORTED_SIZE1_1 \
+  + DNPBNCFG_SUPPORTEDFUNCTIONBLOCK_SIZE1_1 + DNPBNCFG_METHODSTOSETCONFIGPARAMS_SIZE1_1 \
+  + DNPBNCFG_CONNECTIONSSUPPORTED_SIZE1_1)
+
+#define DNPBNCFG_SECTION_SIZE1_2 \
+  (DNPBNCFG_CONTROL_SIZE1_2 + DNPBNCFG_SPECIALCONTROL_SIZE1_2 + DNPBNCFG_PORTNAME_SIZE1_2 \
+  + DNPBNCFG_BAUDRATE_SIZE1_2 + DNPBNCFG_FLOWCONTROL_SIZE1_2 + DNPBNCFG_LINKSTATUSINTERVAL_SIZE1_2 \
+  + DNPBNCFG_MINBACKOFFTIMEFORCOLLISIONAVIODANCE_SIZE1_2 \
+  + DNPBNCFG_MAXRANDOMBACKOFFTIMEFORCOLLISIONAVIODANCE_SIZE1_2 \
+  + DNPBNCFG_RECEIVERINTERCHARTIMEOUT_SIZE1_2 + DNPBNCFG_INTERCHARMAXGAPSINTX_SIZE1_2)
+
+/* Fields of section 1.3 before the list of IP addresses */
+#define DNPBNCFG_SECTION_HEAD_SIZE1_3 \
+  (DNPBNCFG_CONTROL_SIZE1_3 + DNPBNCFG_SPECIALCONTROL_SIZE1_3 + DNPBNCFG_PORTNAME_SIZE1_3 \
+  + DNPBNCFG_TYPEOFENDPOINT_SIZE1_3 + DNPBNCFG_IPOFDEVICE_SIZE1_3 + DNPBNCFG_SUBNETMASK_SIZE1_3 \
+  + DNPBNCFG_GATEWAYIPADDR_SIZE1_3 + DNPBNCFG_ACCEPTSTCPCONNSORUDPDARAGRAMS_SIZE1_3 \
+  + DNPBNCFG_IPADDRSTOACCEPTTCPANDUDPCOUNT_SIZE1_3)
+
+/* Fields of section 1.3 after the list of IP addresses */
+#define DNPBNCFG_SECTION_TAIL_SIZE1_3 \
+  (DNPBNCFG_TCPLISTENPORTNUMBER_SIZE1_3 + DNPBNCFG_TCPLISTENPORTNUMBEROFREMOTE_SIZE1_3 \
+  + DNPBNCFG_TCPKEEPALIVETIMER_SIZE1_3 + DNPBNCFG_LOCALUDPPORT_SIZE1_3 \
+  + DNPBNCFG_DESTUDPPORTFORDNP3REQ_SIZE1_3 + DNPBNCFG_DESTUDPPORTFORINITIALUNSOLNULLRESP_SIZE1_3 \
+  + DNPBNCFG_DESTUDPPORTFORRESPONSES_SIZE1_3 + DNPBNCFG_MULTIPLEMASTERCONNECTIONS_SIZE1_3 \
+  + DNPBNCFG_TIMESYNCHSUPPORT_SIZE1_3)
+
+#define DNPBNCFG_SECTION_SIZE1_4 \
+  (DNPBNCFG_CONTROL_SIZE1_4 + DNPBNCFG_SPECIALCONTROL_SIZE1_4 + DNPBNCFG_DATALINKADDRESS_SIZE1_4 \
+  + DNPBNCFG_DNP3SOURCEADDRVALIDATION_SIZE1_4 + DNPBNCFG_DNP3SOURCEADDRS_SIZE1_4 \
+  + DNPBNCFG_SENDSCONFIRMEDUSERDATAFRAMES_SIZE1_4 + DNPBNCFG_DATALINKLAYERCONFIRMTIMEOUT_SIZE1_4 \
+  + DNPBNCFG_MAXDATALINKRETRIES_SIZE1_4 + DNPBNCFG_MAXNUMOCTETSTXINDATALINKFRAME_SIZE1_4 \
+  + DNPBNCFG_MAXNUMOCTETSRECEIVEDINDATALINKFRAME_SIZE1_4)
+
+#define DNPBNCFG_SECTION_SIZE1_5 \
+  (DNPBNCFG_CONTROL_SIZE1_5 + DNPBNCFG_SPECIALCONTROL_SIZE1_5 \
+  + DNPBNCFG_MAXTRANSMITTEDFRAGMENTSIZE_SIZE1_5 + DNPBNCFG_MAXFILETRANSFERTRANSMITTEDFRAGMENTSIZE_SIZE1_5 \
+  + DNPBNCFG_MAXRECEIVEDFRAGMENTSIZE_SIZE1_5 + DNPBNCFG_MAXOBJECTSINCROBCONTROLREQUEST_SIZE1_5 \
+  + DNPBNCFG_MAXOBJECTSINANALOGOUTPUTCONTROLREQUEST_SIZE1_5 \
+  + DNPBNCFG_MAXOBJECTSINDATASETSCONTROLREQUEST_SIZE1_5 \
+  + DNPBNCFG_SUPPORTSMIXEDOBJECTGROUPSINCONTROLREQUEST_SIZE1_5)
+
+#define DNPBNCFG_SECTION_SIZE1_6 \
+  (DNPBNCFG_CONTROL_SIZE1_6 + DNPBNCFG_SPECIALCONTROL_SIZE1_6 \
+  + DNPBNCFG_APPLLAYERCOMPLETERESPONSETIMEOUT_SIZE1_6 + DNPBNCFG_APPLLAYERFRAGMENTRESPONSETIMEOUT_SIZE1_6)
+
+#define DNPBNCFG_SECTION_SIZE1_7 \
+  (DNPBNCFG_CONTROL_SIZE1_7 + DNPBNCFG_SPECIALCONTROL_SIZE1_7 \
+  + DNPBNCFG_APPLICATIONLAYERCONFIRMTIMEOUT_SIZE1_7 + DNPBNCFG_TIMESYNCREQUIRED_SIZE1_7 \
+  + DNPBNCFG_FILEHANDLETIMEOUT_SIZE1_7 + DNPBNCFG_EVENTBUFFEROVERFLOWBEHAVIOR_SIZE1_7)
+
+#define DNPBNCFG_SECTION_SIZE1_8 \
+  (DNPBNCFG_CONTROL_SIZE1_8 + DNPBNCFG_SPECIALCONTROL_SIZE1_8 + DNPBNCFG_MASTERDATALINKADDRESS_SIZE1_8 \
+  + DNPBNCFG_UNSOLICITEDRESPONSECONFIRMATIONTIMEOUT_SIZE1_8 + DNPBNCFG_MAXUNSOLICITEDRETRIES_SIZE1_8)
+
+#define DNPBNCFG_SECTION_SIZE1_9 \
+  (DNPBNCFG_CONTROL_SIZE1_9 + DNPBNCFG_SPECIALCONTROL_SIZE1_9 \
+  + DNPBNCFG_NUMBEROFCLASSONEEVENTS_SIZE1_9 + DNPBNCFG_NUMBEROFCLASSTWOEVENTS_SIZE1_9 \
+  + DNPBNCFG_NUMBEROFCLASSTHREEEVENTS_SIZE1_9 + DNPBNCFG_HOLDTIMEAFTERCLASSONEEVENT_SIZE1_9 \
+  + DNPBNCFG_HOLDTIMEAFTERCLASSTWOEVENT_SIZE1_9 + DNPBNCFG_HOLDTIMEAFTERCLASSTHREEEVENT_SIZE1_9)
+
+#define DNPBNCFG_SECTION_SIZE1_10 \
+  (DNPBNCFG_CONTROL_SIZE1_10 + DNPBNCFG_SPECIALCONTROL_SIZE1_10 + DNPBNCFG_OUTSTATIONSETSIIN14_SIZE1_10 \
+  + DNPBNCFG_AFTERLASTTIMESYNCOUTSTATIONSETSIIN14_SIZE1_10 \
+  + DNPBNCFG_WHENTIMEERROREXCEEDSOUTSTATIONSETSIIN14_SIZE1_10)
+
+#define DNPBNCFG_SECTION_SIZE1_11 \
+  (DNPBNCFG_CONTROL_SIZE1_11 + DNPBNCFG_OUTSTATIONLOCATION_SIZE1_11 \
+  + DNPBNCFG_OUTSTATIONID_SIZE1_11 + DNPBNCFG_OUTSTATIONNAME_SIZE1_11)
+
+/* Section 1.12 without the field added for the Nov2013 device profile */
+#define DNPBNCFG_SECTION_SIZE1_12 \
+  (DNPBNCFG_CONTROL_SIZE1_12 + DNPBNCFG_SPECIALCONTROL_SIZE1_12 \
+  + DNPBNCFG_VERSIONOFSECUREAUTHENTICATIONSUPPORTED_SIZE1_12 + DNPBNCFG_MAXNUMBERUSERS_SIZE1_12 \
+  + DNPBNCFG_SECURITYRESPONSETIMEOUT_SIZE1_12 + DNPBNCFG_SESSIONKEYCHANGEINTERVAL_SIZE1_12 \
+  + DNPBNCFG_SESSIONKEYCHANGEMESSAGECOUNT_SIZE1_12 + DNPBNCFG_MAXERRORCOUNT_SIZE1_12 \
+  + DNPBNCFG_HMACALGORITHMREQUESTED_SIZE1_12 + DNPBNCFG_KEYWRAPALGORITHM_SIZE1_12 \
+  + DNPBNCFG_ADDITIONALCRITICALFCS_SIZE1_12)
+
+#define DNPBNCFG_SECTION_SIZE1_13 \
+  (DNPBNCFG_CONTROL_SIZE1_13 + DNPBNCFG_SPECIALCONTROL_SIZE1_13)
+
+/* Fields of the point list section before the point ranges */
+#define DNPBNCFG_SECTION_HEAD_SIZE_POINTLIST \
+  (DNPBNCFG_SECTIONID_SIZE_POINTLIST + DNPBNCFG_RANGECOUNT_SIZE_POINTLIST)
+
+/* Size of one range in the point list section */
+#define DNPBNCFG_RANGE_SIZE_POINTLIST \
+  (DNPBNCFG_OBJECTGROUP_SIZE_POINTLIST + DNPBNCFG_QUANTITY_SIZE_POINTLIST \
+  + DNPBNCFG_CLASSMASK_SIZE_POINTLIST + DNPBNCFG_FLAGS_SIZE_POINTLIST)
+
+/* Location of one section within the file */
+typedef struct DnpBinConfigSection {
+  const TMWTYPES_UCHAR *pData;
+  TMWTYPES_ULONG size;
+} DNPBNCFG_SECTION;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_2(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues,
-  TMWTARG_BINFILE_VALS *pTargBinFileValues);
+static TMWTYPES_USHORT TMWDEFS_LOCAL dnpbncfg_GetXmlVersionIndex(
+  DNPBNCFG_FILEVALUES *fileValues);
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_3(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues,
-  TMWTARG_BINFILE_VALS *pTargBinFileValues);
+/* function: _getULong
+ *  decode a 32 bit field and move past it
+ */
+static void TMWDEFS_LOCAL _getULong(
+  const TMWTYPES_UCHAR **ppField,
+  TMWTYPES_ULONG *pValue)
+{
+  tmwtarg_get32(*ppField, pValue);
+  *ppField += 4;
+}
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_4(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+/* function: _getString
+ *  copy a fixed length string field and move past it
+ */
+static void TMWDEFS_LOCAL _getString(
+  const TMWTYPES_UCHAR **ppField,
+  TMWTYPES_CHAR *pString,
+  TMWTYPES_ULONG length)
+{
+  strncpy(pString, (const char *)*ppField, length);
+  *ppField += length;
+}
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_5(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+/* function: _findSections
+ *  Walk the section size fields and check that every section lies within
+ *  the file before any of them is decoded. The point list section is
+ *  optional, anything else after section 1.13 is ignored.
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _findSections(
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length,
+  DNPBNCFG_SECTION *pSections,
+  DNPBNCFG_SECTION *pPointList)
+{
+  TMWTYPES_ULONG offset = DNPBNCFG_HEADER_SIZE;
+  TMWTYPES_ULONG sectionSize;
+  int i;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_6(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+  if(length < DNPBNCFG_HEADER_SIZE)
+    return TMWDEFS_FALSE;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_7(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+  for(i = 0; i < DNPBNCFG_NUM_SECTIONS; i++)
+  {
+    if(length - offset < DNPBNCFG_SECTION_SIZE_FIELD_SIZE)
+      return TMWDEFS_FALSE;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_8(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+    tmwtarg_get32(pData + offset, &sectionSize);
+    offset += DNPBNCFG_SECTION_SIZE_FIELD_SIZE;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_9(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+    if(sectionSize > length - offset)
+      return TMWDEFS_FALSE;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_10(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+    pSections[i].pData = pData + offset;
+    pSections[i].size = sectionSize;
+    offset += sectionSize;
+  }
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_11(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+  pPointList->pData = TMWDEFS_NULL;
+  pPointList->size = 0;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_12(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+  if(length - offset >= DNPBNCFG_SECTION_SIZE_FIELD_SIZE + DNPBNCFG_SECTIONID_SIZE_POINTLIST)
+  {
+    TMWTYPES_ULONG sectionId;
 
-static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_13(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
-  DNPBNCFG_FILEVALUES *fileValues);
+    tmwtarg_get32(pData + offset, &sectionSize);
+    tmwtarg_get32(pData + offset + DNPBNCFG_SECTION_SIZE_FIELD_SIZE, &sectionId);
+    offset += DNPBNCFG_SECTION_SIZE_FIELD_SIZE;
 
-static TMWTYPES_USHORT TMWDEFS_LOCAL dnpbncfg_GetXmlVersionIndex(
-  DNPBNCFG_FILEVALUES *fileValues);
+    if(sectionId == DNPBNCFG_SECTIONID_POINTLIST)
+    {
+      if(sectionSize > length - offset)
+        return TMWDEFS_FALSE;
+
+      pPointList->pData = pData + offset;
+      pPointList->size = sectionSize;
+    }
+  }
+
+  return TMWDEFS_TRUE;
+}
 
 /* function: dnpbncfg_ReadBinaryConfigHeader */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigHeader(
-  FILE *fp, 
+  const TMWTYPES_UCHAR *pData,
   DNPBNCFG_FILEVALUES *fileValues,
   TMWTYPES_USHORT *pXMLVersionIndex)
 {
-  size_t charRead;
+  /* The first field holds the file type, which is not used */
+  memcpy(fileValues->xmlVersion, pData + DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN, DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN);
+  memcpy(fileValues->fileVersion, pData + 2 * DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN, DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN);
 
-  TMWTYPES_UCHAR fileType[DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN];
-
-  charRead = fread(fileType, 1, DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN, fp);
-
-  if (charRead == DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN)
-    charRead = fread(fileValues->xmlVersion, 1, DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN, fp);
-  else
-    return TMWDEFS_FALSE;
-
-  if (charRead == DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN)
-    charRead = fread(fileValues->fileVersion, 1, DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN, fp);
-  else
-    return TMWDEFS_FALSE;
-
-  if (charRead == DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN)
-  {
-      *pXMLVersionIndex = dnpbncfg_GetXmlVersionIndex(fileValues);
-  }
-  else
-    return TMWDEFS_FALSE;
+  *pXMLVersionIndex = dnpbncfg_GetXmlVersionIndex(fileValues);
 
   return TMWDEFS_TRUE;
 }
@@ -170,885 +279,595 @@ static TMWTYPES_USHORT TMWDEFS_LOCAL dnpbncfg_GetXmlVersionIndex(
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_1 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_1(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues,
   TMWTARG_BINFILE_VALS *pTargBinFileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_1];
-  TMWTYPES_UCHAR field2[DNPBNCFG_DEVFUNCTION_SIZE1_1];
-  TMWTYPES_UCHAR field3[DNPBNCFG_VENDORNAME_SIZE1_1];
-  TMWTYPES_UCHAR field4[DNPBNCFG_DEVICENAME_SIZE1_1];
-  TMWTYPES_UCHAR field5[DNPBNCFG_HARDWAREVERSION_SIZE1_1];
-  TMWTYPES_UCHAR field6[DNPBNCFG_SOFTWAREVERSION_SIZE1_1];
-  TMWTYPES_UCHAR field7[DNPBNCFG_DOCVERSIONNUM_SIZE1_1];
-  TMWTYPES_UCHAR field8[DNPBNCFG_DNPLEVELSSUPPORTED_SIZE1_1];
-  TMWTYPES_UCHAR field9[DNPBNCFG_SUPPORTEDFUNCTIONBLOCK_SIZE1_1];
-  TMWTYPES_UCHAR field10[DNPBNCFG_METHODSTOSETCONFIGPARAMS_SIZE1_1];
-  TMWTYPES_UCHAR field11[DNPBNCFG_CONNECTIONSSUPPORTED_SIZE1_1];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
+  TMWTYPES_ULONG fieldUsed = 0;
+  TMWTYPES_ULONG fieldValue = 0;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_1, fp);
-  charRead += fread(field2, 1, DNPBNCFG_DEVFUNCTION_SIZE1_1, fp);
-  charRead += fread(field3, 1, DNPBNCFG_VENDORNAME_SIZE1_1, fp);
-  charRead += fread(field4, 1, DNPBNCFG_DEVICENAME_SIZE1_1, fp);
-  charRead += fread(field5, 1, DNPBNCFG_HARDWAREVERSION_SIZE1_1, fp);
-  charRead += fread(field6, 1, DNPBNCFG_SOFTWAREVERSION_SIZE1_1, fp);
-  charRead += fread(field7, 1, DNPBNCFG_DOCVERSIONNUM_SIZE1_1, fp);
-  charRead += fread(field8, 1, DNPBNCFG_DNPLEVELSSUPPORTED_SIZE1_1, fp);
-  charRead += fread(field9, 1, DNPBNCFG_SUPPORTEDFUNCTIONBLOCK_SIZE1_1, fp);
-  charRead += fread(field10, 1, DNPBNCFG_METHODSTOSETCONFIGPARAMS_SIZE1_1, fp);
-  charRead += fread(field11, 1, DNPBNCFG_CONNECTIONSSUPPORTED_SIZE1_1, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_1)
+    return TMWDEFS_FALSE;
 
-  readOK = (sectionSize == charRead);
+  _getULong(&pField, &fieldUsed);
+  fileValues->fieldsUsed1_1 = fieldUsed;
 
-  if(readOK)
+  /* section 1.1.1 */
+  _getULong(&pField, &fieldValue);
+  if(fieldUsed & CRTL_DEVFUNCT1_1_1)
   {
-    TMWTYPES_ULONG fieldUsed = 0;
-    TMWTYPES_ULONG fieldValue = 0;
-
-    tmwtarg_get32(field1, &fieldUsed);
-    fileValues->fieldsUsed1_1 = fieldUsed;
+    if(fieldValue & FUNCTION_MASTER1_1)
+      fileValues->isOutStation = TMWDEFS_FALSE;
+    else
+      fileValues->isOutStation = TMWDEFS_TRUE;
+  }
 
+  /* 1.1.2 to 1.1.10 are not used */
+  pField += DNPBNCFG_VENDORNAME_SIZE1_1 + DNPBNCFG_DEVICENAME_SIZE1_1
+    + DNPBNCFG_HARDWAREVERSION_SIZE1_1 + DNPBNCFG_SOFTWAREVERSION_SIZE1_1
+    + DNPBNCFG_DOCVERSIONNUM_SIZE1_1 + DNPBNCFG_DNPLEVELSSUPPORTED_SIZE1_1
+    + DNPBNCFG_SUPPORTEDFUNCTIONBLOCK_SIZE1_1 + DNPBNCFG_METHODSTOSETCONFIGPARAMS_SIZE1_1;
 
-    /* section 1.1.1 */
-    if(fieldUsed & CRTL_DEVFUNCT1_1_1)
+  /* save target layer values */
+  if(pTargBinFileValues != TMWDEFS_NULL)
+  {
+    /*1.1.13 */
+    if(fileValues->fieldsUsed1_1 & CRTL_CONNECTIONSUP1_1_13)
     {
-      tmwtarg_get32(field2, &fieldValue);
+      _getULong(&pField, &fileValues->connectionsSupported1_1);
 
-      if(fieldValue & FUNCTION_MASTER1_1)
-        fileValues->isOutStation = TMWDEFS_FALSE;
+      if(fileValues->connectionsSupported1_1 & CONNTYPES_SERIAL1_1)
+        pTargBinFileValues->supportsSerialConn = TMWDEFS_TRUE;
       else
-        fileValues->isOutStation = TMWDEFS_TRUE;
-    }
+        pTargBinFileValues->supportsSerialConn = TMWDEFS_FALSE;
 
-    
-    /* save target layer values */
-    fieldValue = 0;
-
-    if(pTargBinFileValues != TMWDEFS_NULL)
-    {
-      /*1.1.13 */
-      if(fileValues->fieldsUsed1_1 & CRTL_CONNECTIONSUP1_1_13)
-      {
-        tmwtarg_get32(field11, &fileValues->connectionsSupported1_1);
-
-        if(fileValues->connectionsSupported1_1 & CONNTYPES_SERIAL1_1)
-          pTargBinFileValues->supportsSerialConn = TMWDEFS_TRUE;
-        else
-          pTargBinFileValues->supportsSerialConn = TMWDEFS_FALSE;
-
-        if(fileValues->connectionsSupported1_1 & CONNTYPES_NETWORK1_1)
-          pTargBinFileValues->supportsTCPConn = TMWDEFS_TRUE;
-        else
-          pTargBinFileValues->supportsTCPConn = TMWDEFS_FALSE;
+      if(fileValues->connectionsSupported1_1 & CONNTYPES_NETWORK1_1)
+        pTargBinFileValues->supportsTCPConn = TMWDEFS_TRUE;
+      else
+        pTargBinFileValues->supportsTCPConn = TMWDEFS_FALSE;
 
-        pTargBinFileValues->useSupportedComm1_1_13 = TMWDEFS_TRUE;
-      }
+      pTargBinFileValues->useSupportedComm1_1_13 = TMWDEFS_TRUE;
     }
   }
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_2 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_2(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues,
   TMWTARG_BINFILE_VALS *pTargBinFileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_2];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_2];
-  TMWTYPES_UCHAR field3[DNPBNCFG_PORTNAME_SIZE1_2];
-  TMWTYPES_UCHAR field4[DNPBNCFG_BAUDRATE_SIZE1_2];
-  TMWTYPES_UCHAR field5[DNPBNCFG_FLOWCONTROL_SIZE1_2];
-  TMWTYPES_UCHAR field6[DNPBNCFG_LINKSTATUSINTERVAL_SIZE1_2];
-  TMWTYPES_UCHAR field7[DNPBNCFG_MINBACKOFFTIMEFORCOLLISIONAVIODANCE_SIZE1_2];
-  TMWTYPES_UCHAR field8[DNPBNCFG_MAXRANDOMBACKOFFTIMEFORCOLLISIONAVIODANCE_SIZE1_2];
-  TMWTYPES_UCHAR field9[DNPBNCFG_RECEIVERINTERCHARTIMEOUT_SIZE1_2];
-  TMWTYPES_UCHAR field10[DNPBNCFG_INTERCHARMAXGAPSINTX_SIZE1_2];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_2)
+    return TMWDEFS_FALSE;
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_2, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_2, fp);
-  charRead += fread(field3, 1, DNPBNCFG_PORTNAME_SIZE1_2, fp);
-  charRead += fread(field4, 1, DNPBNCFG_BAUDRATE_SIZE1_2, fp);
-  charRead += fread(field5, 1, DNPBNCFG_FLOWCONTROL_SIZE1_2, fp);
-  charRead += fread(field6, 1, DNPBNCFG_LINKSTATUSINTERVAL_SIZE1_2, fp);
-  charRead += fread(field7, 1, DNPBNCFG_MINBACKOFFTIMEFORCOLLISIONAVIODANCE_SIZE1_2, fp);
-  charRead += fread(field8, 1, DNPBNCFG_MAXRANDOMBACKOFFTIMEFORCOLLISIONAVIODANCE_SIZE1_2, fp);
-  charRead += fread(field9, 1, DNPBNCFG_RECEIVERINTERCHARTIMEOUT_SIZE1_2, fp);
-  charRead += fread(field10, 1, DNPBNCFG_INTERCHARMAXGAPSINTX_SIZE1_2, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
-
-  readOK = (sectionSize == charRead);
-
-  if(readOK)
+  _getULong(&pField, &fileValues->fieldsUsed1_2);
+  _getULong(&pField, &fileValues->specialControls1_2);
+  _getString(&pField, fileValues->portName1_2, DNPBNCFG_PORTNAME_SIZE1_2);
+  _getULong(&pField, &fileValues->baudRate1_2);
+  _getULong(&pField, &fileValues->flowControl1_2);
+  _getULong(&pField, &fileValues->linkStatusInterval1_2);
+  _getULong(&pField, &fileValues->minBackOffTimeCollAviod1_2);
+  _getULong(&pField, &fileValues->maxRandBackOffTimeCollAviod1_2);
+  _getULong(&pField, &fileValues->receiverInterCharTimeout1_2);
+  _getULong(&pField, &fileValues->interCharMaxGapsInTx1_2);
+
+  /* save target layer values */
+  if(pTargBinFileValues != TMWDEFS_NULL)
   {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_2);
-    tmwtarg_get32(field2, &fileValues->specialControls1_2);
-    strncpy(fileValues->portName1_2, (const char *)field3, DNPBNCFG_PORTNAME_SIZE1_2);
-    tmwtarg_get32(field4, &fileValues->baudRate1_2);
-    tmwtarg_get32(field5, &fileValues->flowControl1_2);
-    tmwtarg_get32(field6, &fileValues->linkStatusInterval1_2);
-    tmwtarg_get32(field7, &fileValues->minBackOffTimeCollAviod1_2);
-    tmwtarg_get32(field8, &fileValues->maxRandBackOffTimeCollAviod1_2);
-    tmwtarg_get32(field9, &fileValues->receiverInterCharTimeout1_2);
-    tmwtarg_get32(field10, &fileValues->interCharMaxGapsInTx1_2);
-
-    /* save target layer values */
-    if(pTargBinFileValues != TMWDEFS_NULL)
+    /*1.2.1*/
+    if(fileValues->fieldsUsed1_2 & CRTL_PORTNAME1_2_1)
     {
-      /*1.2.1*/
-      if(fileValues->fieldsUsed1_2 & CRTL_PORTNAME1_2_1)
-      {
-        strncpy(pTargBinFileValues->serialPortName, fileValues->portName1_2, DNPBNCFG_PORTNAME_SIZE1_2);
-        pTargBinFileValues->useSerialPortName1_2_1 = TMWDEFS_TRUE;
-      }
+      strncpy(pTargBinFileValues->serialPortName, fileValues->portName1_2, DNPBNCFG_PORTNAME_SIZE1_2);
+      pTargBinFileValues->useSerialPortName1_2_1 = TMWDEFS_TRUE;
+    }
 
-      /*1.2.3*/
-      if(fileValues->fieldsUsed1_2 & CRTL_BAUDRATE1_2_3)
-      {
-        sprintf(pTargBinFileValues->baudRate, "%d", fileValues->baudRate1_2);
-        pTargBinFileValues->useBuadRate1_2_3 = TMWDEFS_TRUE;
-      }
+    /*1.2.3*/
+    if(fileValues->fieldsUsed1_2 & CRTL_BAUDRATE1_2_3)
+    {
+      sprintf(pTargBinFileValues->baudRate, "%d", fileValues->baudRate1_2);
+      pTargBinFileValues->useBuadRate1_2_3 = TMWDEFS_TRUE;
     }
   }
 
-  return readOK;
-
+  return TMWDEFS_TRUE;
 }
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_3 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_3(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues,
   TMWTARG_BINFILE_VALS *pBinFileTargValues)
 {
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTYPES_ULONG i;
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
   TMWTYPES_ULONG numberOfIPAddrs = 0;
-    
-  
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_3];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_3];
-  TMWTYPES_UCHAR field3[DNPBNCFG_PORTNAME_SIZE1_3];
-  TMWTYPES_UCHAR field4[DNPBNCFG_TYPEOFENDPOINT_SIZE1_3];
-  TMWTYPES_UCHAR field5[DNPBNCFG_IPOFDEVICE_SIZE1_3];
-  TMWTYPES_UCHAR field6[DNPBNCFG_SUBNETMASK_SIZE1_3];
-  TMWTYPES_UCHAR field7[DNPBNCFG_GATEWAYIPADDR_SIZE1_3];
-  TMWTYPES_UCHAR field8[DNPBNCFG_ACCEPTSTCPCONNSORUDPDARAGRAMS_SIZE1_3];
-  TMWTYPES_UCHAR field9[DNPBNCFG_IPADDRSTOACCEPTTCPANDUDPCOUNT_SIZE1_3];
-  TMWTYPES_UCHAR field10[DNPBNCFG_MAXNUMIPADDRS1_3][DNPBNCFG_IPADDRTOACCEPTTCPANDUDP_SIZE1_3];
-  TMWTYPES_UCHAR field11[DNPBNCFG_TCPLISTENPORTNUMBER_SIZE1_3];
-  TMWTYPES_UCHAR field12[DNPBNCFG_TCPLISTENPORTNUMBEROFREMOTE_SIZE1_3];
-  TMWTYPES_UCHAR field13[DNPBNCFG_TCPKEEPALIVETIMER_SIZE1_3];
-  TMWTYPES_UCHAR field14[DNPBNCFG_LOCALUDPPORT_SIZE1_3];
-  TMWTYPES_UCHAR field15[DNPBNCFG_DESTUDPPORTFORDNP3REQ_SIZE1_3];
-  TMWTYPES_UCHAR field16[DNPBNCFG_DESTUDPPORTFORINITIALUNSOLNULLRESP_SIZE1_3];
-  TMWTYPES_UCHAR field17[DNPBNCFG_DESTUDPPORTFORRESPONSES_SIZE1_3];
-  TMWTYPES_UCHAR field18[DNPBNCFG_MULTIPLEMASTERCONNECTIONS_SIZE1_3];
-  TMWTYPES_UCHAR field19[DNPBNCFG_TIMESYNCHSUPPORT_SIZE1_3];
+  TMWTYPES_ULONG numberInFile;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
+  if(pSection->size < DNPBNCFG_SECTION_HEAD_SIZE1_3)
+    return TMWDEFS_FALSE;
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_3, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_3, fp);
-  charRead += fread(field3, 1, DNPBNCFG_PORTNAME_SIZE1_3, fp);
-  charRead += fread(field4, 1, DNPBNCFG_TYPEOFENDPOINT_SIZE1_3, fp);
-  charRead += fread(field5, 1, DNPBNCFG_IPOFDEVICE_SIZE1_3, fp);
-  charRead += fread(field6, 1, DNPBNCFG_SUBNETMASK_SIZE1_3, fp);
-  charRead += fread(field7, 1, DNPBNCFG_GATEWAYIPADDR_SIZE1_3, fp);
-  charRead += fread(field8, 1, DNPBNCFG_ACCEPTSTCPCONNSORUDPDARAGRAMS_SIZE1_3, fp);
-  charRead += fread(field9, 1, DNPBNCFG_IPADDRSTOACCEPTTCPANDUDPCOUNT_SIZE1_3, fp);
+  /* The section holds at most DNPBNCFG_MAXNUMIPADDRS1_3 addresses */
+  tmwtarg_get32(pField + DNPBNCFG_SECTION_HEAD_SIZE1_3 - DNPBNCFG_IPADDRSTOACCEPTTCPANDUDPCOUNT_SIZE1_3, &numberOfIPAddrs);
+  numberInFile = (numberOfIPAddrs < DNPBNCFG_MAXNUMIPADDRS1_3) ? numberOfIPAddrs : DNPBNCFG_MAXNUMIPADDRS1_3;
 
-  tmwtarg_get32(field9, &numberOfIPAddrs);
+  if(pSection->size != DNPBNCFG_SECTION_HEAD_SIZE1_3
+    + (numberInFile * DNPBNCFG_IPADDRTOACCEPTTCPANDUDP_SIZE1_3) + DNPBNCFG_SECTION_TAIL_SIZE1_3)
+    return TMWDEFS_FALSE;
 
-  for (i = 0; i < numberOfIPAddrs && i < DNPBNCFG_MAXNUMIPADDRS1_3; ++i)
+  _getULong(&pField, &fileValues->fieldsUsed1_3);
+  _getULong(&pField, &fileValues->specialControls1_3);
+  _getString(&pField, fileValues->portName1_3, DNPBNCFG_PORTNAME_SIZE1_3);
+  _getULong(&pField, &fileValues->typeOfEndpoint1_3);
+  _getString(&pField, fileValues->ipOfDevice1_3, DNPBNCFG_IPOFDEVICE_SIZE1_3);
+  _getString(&pField, fileValues->subnetMask1_3, DNPBNCFG_SUBNETMASK_SIZE1_3);
+  _getString(&pField, fileValues->gatewayIpAddr1_3, DNPBNCFG_GATEWAYIPADDR_SIZE1_3);
+  _getULong(&pField, &fileValues->acceptsTcpConnsOrUdp1_3);
+  _getULong(&pField, &fileValues->ipAddrsToAcceptTcpandUdpCount1_3);
+
+  for (i = 0; i < numberInFile; ++i)
   {
-    charRead += fread(field10[i], 1, DNPBNCFG_IPADDRTOACCEPTTCPANDUDP_SIZE1_3, fp);
+    _getString(&pField, fileValues->ipAddrToAcceptTcpandUdp1_3[i], DNPBNCFG_IPADDRTOACCEPTTCPANDUDP_SIZE1_3);
   }
 
-  charRead += fread(field11, 1, DNPBNCFG_TCPLISTENPORTNUMBER_SIZE1_3, fp);
-  charRead += fread(field12, 1, DNPBNCFG_TCPLISTENPORTNUMBEROFREMOTE_SIZE1_3, fp);
-  charRead += fread(field13, 1, DNPBNCFG_TCPKEEPALIVETIMER_SIZE1_3, fp);
-  charRead += fread(field14, 1, DNPBNCFG_LOCALUDPPORT_SIZE1_3, fp);
-  charRead += fread(field15, 1, DNPBNCFG_DESTUDPPORTFORDNP3REQ_SIZE1_3, fp);
-  charRead += fread(field16, 1, DNPBNCFG_DESTUDPPORTFORINITIALUNSOLNULLRESP_SIZE1_3, fp);
-  charRead += fread(field17, 1, DNPBNCFG_DESTUDPPORTFORRESPONSES_SIZE1_3, fp);
-  charRead += fread(field18, 1, DNPBNCFG_MULTIPLEMASTERCONNECTIONS_SIZE1_3, fp);
-  charRead += fread(field19, 1, DNPBNCFG_TIMESYNCHSUPPORT_SIZE1_3, fp);
+  _getULong(&pField, &fileValues->tcpListenPortNumber1_3);
+  _getULong(&pField, &fileValues->tcpListenPortNumberOfRemote1_3);
+  _getULong(&pField, &fileValues->tcpKeepAliveTimer1_3);
+  _getULong(&pField, &fileValues->localUdpPort1_3);
+  _getULong(&pField, &fileValues->destUdpPortForDnp3req1_3);
+  _getULong(&pField, &fileValues->destUdpPortForInitialUnsolNullResp1_3);
+  _getULong(&pField, &fileValues->destUdpPortForResponses1_3);
+  _getULong(&pField, &fileValues->multiMasterConnections1_3);
+  _getULong(&pField, &fileValues->timeSynchSupport1_3);
 
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
 
-  readOK = (sectionSize == charRead);
-
-  if(readOK)
+  /* save target layer values */
+  if(pBinFileTargValues != TMWDEFS_NULL)
   {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_3);
-    tmwtarg_get32(field2, &fileValues->specialControls1_3);
-    strncpy(fileValues->portName1_3, (const char *)field3, DNPBNCFG_PORTNAME_SIZE1_3);
-    tmwtarg_get32(field4, &fileValues->typeOfEndpoint1_3);
-    strncpy(fileValues->ipOfDevice1_3, (const char *)field5, DNPBNCFG_IPOFDEVICE_SIZE1_3);
-    strncpy(fileValues->subnetMask1_3, (const char *)field6, DNPBNCFG_SUBNETMASK_SIZE1_3);
-    strncpy(fileValues->gatewayIpAddr1_3, (const char *)field7, DNPBNCFG_GATEWAYIPADDR_SIZE1_3);
-    tmwtarg_get32(field8, &fileValues->acceptsTcpConnsOrUdp1_3);
-    tmwtarg_get32(field9, &fileValues->ipAddrsToAcceptTcpandUdpCount1_3);
-
-    for (i = 0; i < numberOfIPAddrs && i < DNPBNCFG_MAXNUMIPADDRS1_3; ++i)
+
+    /*1.3.1*/
+    if(fileValues->fieldsUsed1_3 & CRTL_PORTNAME1_3_1)
     {
-      strncpy(fileValues->ipAddrToAcceptTcpandUdp1_3[i], (const char *)field10[i], DNPBNCFG_IPADDRTOACCEPTTCPANDUDP_SIZE1_3);
+      strncpy(pBinFileTargValues->ipPortName, fileValues->portName1_3, TMWTARG_STR_LEN);
+      pBinFileTargValues->useIpPortName1_3_1 = TMWDEFS_TRUE;
     }
 
-    tmwtarg_get32(field11, &fileValues->tcpListenPortNumber1_3);
-    tmwtarg_get32(field12, &fileValues->tcpListenPortNumberOfRemote1_3);
-    tmwtarg_get32(field13, &fileValues->tcpKeepAliveTimer1_3);
-    tmwtarg_get32(field14, &fileValues->localUdpPort1_3);
-    tmwtarg_get32(field15, &fileValues->destUdpPortForDnp3req1_3);
-    tmwtarg_get32(field16, &fileValues->destUdpPortForInitialUnsolNullResp1_3);
-    tmwtarg_get32(field17, &fileValues->destUdpPortForResponses1_3);
-    tmwtarg_get32(field18, &fileValues->multiMasterConnections1_3);
-    tmwtarg_get32(field19, &fileValues->timeSynchSupport1_3);
+    /*1.3.2*/
+    if(fileValues->fieldsUsed1_3 & CRTL_TYPEOFENDPOINT1_3_2)
+    {
+      pBinFileTargValues->endpointIsTcpInitiating = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_TCPINITIATING) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+      pBinFileTargValues->endpointIsTcpListening = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_TCPLISTENING) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+      pBinFileTargValues->endpointIsTcpDual = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_TCPDUAL) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+      pBinFileTargValues->endpointIsUDPDatagram = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_UDPDATAGRAM) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+      pBinFileTargValues->useEndpoint1_3_2 = TMWDEFS_TRUE;
+    }
 
 
-    /* save target layer values */
-    if(pBinFileTargValues != TMWDEFS_NULL)
+    /*1.3.3*/
+    if(fileValues->fieldsUsed1_3 & CRTL_IPOFDEVICE1_3_3)
     {
+      strncpy(pBinFileTargValues->ipAddress, fileValues->ipOfDevice1_3, TMWTARG_STR_LEN);
+      pBinFileTargValues->useIpAddress1_3_3 = TMWDEFS_TRUE;
+    }
 
-      /*1.3.1*/
-      if(fileValues->fieldsUsed1_3 & CRTL_PORTNAME1_3_1)
-      {
-        strncpy(pBinFileTargValues->ipPortName, fileValues->portName1_3, TMWTARG_STR_LEN);
-        pBinFileTargValues->useIpPortName1_3_1 = TMWDEFS_TRUE;
-      }
-
-      /*1.3.2*/
-      if(fileValues->fieldsUsed1_3 & CRTL_TYPEOFENDPOINT1_3_2)
-      {
-        pBinFileTargValues->endpointIsTcpInitiating = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_TCPINITIATING) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
-        pBinFileTargValues->endpointIsTcpListening = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_TCPLISTENING) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
-        pBinFileTargValues->endpointIsTcpDual = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_TCPDUAL) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
-        pBinFileTargValues->endpointIsUDPDatagram = (fileValues->typeOfEndpoint1_3 & ENDPOINTS_UDPDATAGRAM) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
-        pBinFileTargValues->useEndpoint1_3_2 = TMWDEFS_TRUE;
-      }
 
+    /*1.3.4*/
+    if(fileValues->fieldsUsed1_3 & CRTL_SUBNETMASK1_3_4)
+    {
+      strncpy(pBinFileTargValues->subnetMask, fileValues->subnetMask1_3, TMWTARG_STR_LEN);
+      pBinFileTargValues->useSubnetMask1_3_4 = TMWDEFS_TRUE;
+    }
 
-      /*1.3.3*/
-      if(fileValues->fieldsUsed1_3 & CRTL_IPOFDEVICE1_3_3)
-      {
-        strncpy(pBinFileTargValues->ipAddress, fileValues->ipOfDevice1_3, TMWTARG_STR_LEN);
-        pBinFileTargValues->useIpAddress1_3_3 = TMWDEFS_TRUE;
-      }
+    /*1.3.5*/
+    if(fileValues->fieldsUsed1_3 & CRTL_GATEWAYIPADDR1_3_5)
+    {
+      strncpy(pBinFileTargValues->gatewayIp, fileValues->gatewayIpAddr1_3, TMWTARG_STR_LEN);
+      pBinFileTargValues->useGateWayIp1_3_5 = TMWDEFS_TRUE;
+    }
 
 
-      /*1.3.4*/
-      if(fileValues->fieldsUsed1_3 & CRTL_SUBNETMASK1_3_4)
-      {
-        strncpy(pBinFileTargValues->subnetMask, fileValues->subnetMask1_3, TMWTARG_STR_LEN);
-        pBinFileTargValues->useSubnetMask1_3_4 = TMWDEFS_TRUE;
-      }
+    /*1.3.7*/
+    if(fileValues->fieldsUsed1_3 & CRTL_IPADDRSTOACCEPTTCPANDUDP1_3_7)
+    {
+      TMWTYPES_UINT maxIpStringLen = 0;
 
-      /*1.3.5*/
-      if(fileValues->fieldsUsed1_3 & CRTL_GATEWAYIPADDR1_3_5)
+      if(numberOfIPAddrs > 0)
       {
-        strncpy(pBinFileTargValues->gatewayIp, fileValues->gatewayIpAddr1_3, TMWTARG_STR_LEN);
-        pBinFileTargValues->useGateWayIp1_3_5 = TMWDEFS_TRUE;
+        maxIpStringLen = TMWTARG_STR_LEN / numberOfIPAddrs - 1;  /* minus one accounts for the ';' between addrs and the final '\0' */
+        pBinFileTargValues->allowedConnIpList[0] = '\0';
       }
 
-
-      /*1.3.7*/
-      if(fileValues->fieldsUsed1_3 & CRTL_IPADDRSTOACCEPTTCPANDUDP1_3_7)
+      for (i = 0; i < numberInFile; ++i)
       {
-        TMWTYPES_UINT maxIpStringLen = 0;
+        strncat(pBinFileTargValues->allowedConnIpList, fileValues->ipAddrToAcceptTcpandUdp1_3[i], maxIpStringLen);
 
-        if(numberOfIPAddrs > 0)
-        {
-          maxIpStringLen = TMWTARG_STR_LEN / numberOfIPAddrs - 1;  /* minus one accounts for the ';' between addrs and the final '\0' */
-          pBinFileTargValues->allowedConnIpList[0] = '\0';
-        }
+        if(i < numberOfIPAddrs - 1)
+          strcat(pBinFileTargValues->allowedConnIpList, ";");
+      }
 
-        for (i = 0; i < numberOfIPAddrs && i < DNPBNCFG_MAXNUMIPADDRS1_3; ++i)
-        {
-          strncat(pBinFileTargValues->allowedConnIpList, fileValues->ipAddrToAcceptTcpandUdp1_3[i], maxIpStringLen);
+      pBinFileTargValues->allowedConnIpList[TMWTARG_STR_LEN - 1] = '\0';
+      pBinFileTargValues->useAllowedConnIpList1_3_7 = TMWDEFS_TRUE;
+    }
 
-          if(i < numberOfIPAddrs - 1)
-            strcat(pBinFileTargValues->allowedConnIpList, ";");
-        }
+      /*1.3.8*/
+    if (fileValues->fieldsUsed1_3 & CRTL_TCPLISTENPORTNUMBER1_3_8)
+    {
+      pBinFileTargValues->tcpListenPort = (TMWTYPES_USHORT)fileValues->tcpListenPortNumber1_3;
+      if (!((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NOTAPPLICABLETCPLISTENPORT1_3_8))
+        pBinFileTargValues->useTcpListenPort1_3_8 = TMWDEFS_TRUE;
+    }
 
-        pBinFileTargValues->allowedConnIpList[TMWTARG_STR_LEN - 1] = '\0';
-        pBinFileTargValues->useAllowedConnIpList1_3_7 = TMWDEFS_TRUE;
-      }
+    /*1.3.9*/
+    if (fileValues->fieldsUsed1_3 & CRTL_TCPLISTENPORTNUMBEROFREMOTE1_3_9)
+    {
+      pBinFileTargValues->tcpListenPortOfRemote = (TMWTYPES_USHORT)fileValues->tcpListenPortNumberOfRemote1_3;
+      if (!((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NOTAPPLICABLETCPLISTENPORTOFREMOTE1_3_9))
+        pBinFileTargValues->useTcpListenPortOfRemote1_3_9 = TMWDEFS_TRUE;
+    }
 
-        /*1.3.8*/
-      if (fileValues->fieldsUsed1_3 & CRTL_TCPLISTENPORTNUMBER1_3_8)
+    /*1.3.11*/
+    if(fileValues->fieldsUsed1_3 & CRTL_LOCALUDPPORT1_3_11)
+    {
+      pBinFileTargValues->useLocalUdpPort1_3_11 = TMWDEFS_TRUE;
+      if (((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_LETSYSTEMCHOOSELOCALUDPPORT1_3_11))
       {
-        pBinFileTargValues->tcpListenPort = (TMWTYPES_USHORT)fileValues->tcpListenPortNumber1_3;
-        if (!((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NOTAPPLICABLETCPLISTENPORT1_3_8))
-          pBinFileTargValues->useTcpListenPort1_3_8 = TMWDEFS_TRUE;
+        /* used by masters only*/
+        pBinFileTargValues->localUdpPort = TMWTARG_UDP_PORT_ANY;
       }
-
-      /*1.3.9*/
-      if (fileValues->fieldsUsed1_3 & CRTL_TCPLISTENPORTNUMBEROFREMOTE1_3_9)
+      else
       {
-        pBinFileTargValues->tcpListenPortOfRemote = (TMWTYPES_USHORT)fileValues->tcpListenPortNumberOfRemote1_3;
-        if (!((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NOTAPPLICABLETCPLISTENPORTOFREMOTE1_3_9))
-          pBinFileTargValues->useTcpListenPortOfRemote1_3_9 = TMWDEFS_TRUE;
+        pBinFileTargValues->localUdpPort = (TMWTYPES_USHORT)fileValues->localUdpPort1_3;
       }
+    }
 
-      /*1.3.11*/
-      if(fileValues->fieldsUsed1_3 & CRTL_LOCALUDPPORT1_3_11)
-      {
-        pBinFileTargValues->useLocalUdpPort1_3_11 = TMWDEFS_TRUE;
-        if (((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_LETSYSTEMCHOOSELOCALUDPPORT1_3_11))
-        {
-          /* used by masters only*/
-          pBinFileTargValues->localUdpPort = TMWTARG_UDP_PORT_ANY;
-        }
-        else
-        {
-          pBinFileTargValues->localUdpPort = (TMWTYPES_USHORT)fileValues->localUdpPort1_3;
-        }
-      }
+    /*1.3.12*/
+    /* used by masters only */
+    if(fileValues->fieldsUsed1_3 & CRTL_DESINTATIONUDPPORTFORDNP3REQ1_3_12)
+    {
+      pBinFileTargValues->destUdpPort = (TMWTYPES_USHORT)fileValues->destUdpPortForDnp3req1_3;
+      pBinFileTargValues->useDestUpdPort1_3_12 = TMWDEFS_TRUE;
+    }
 
-      /*1.3.12*/
-      /* used by masters only */
-      if(fileValues->fieldsUsed1_3 & CRTL_DESINTATIONUDPPORTFORDNP3REQ1_3_12)
-      {
-        pBinFileTargValues->destUdpPort = (TMWTYPES_USHORT)fileValues->destUdpPortForDnp3req1_3;
-        pBinFileTargValues->useDestUpdPort1_3_12 = TMWDEFS_TRUE;
-      }
+    /*1.3.13*/
+    /* used by outstations only */
+    if(fileValues->fieldsUsed1_3 & CRTL_DESINTATIONUDPPORTFORINITIALUNSOLNULLRESP1_3_13)
+    {
+      pBinFileTargValues->destUdpPortForUnsol = (TMWTYPES_USHORT)fileValues->destUdpPortForInitialUnsolNullResp1_3;
+      if (!((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NONEDESINTATIONUDPPORTFORINITIALUNSOLNULLRESP1_3_13))
+        pBinFileTargValues->useDestUdpPortForUnsol1_3_13 = TMWDEFS_TRUE;
+    }
+
+    /*1.3.14*/
+    /* used by outstations only*/
+    if(fileValues->fieldsUsed1_3 & CRTL_DESINTATIONUDPPORTFORRESPONSES1_3_14)
+    {
+      pBinFileTargValues->useSourcePortNumberForResponses = TMWDEFS_FALSE;
 
-      /*1.3.13*/
-      /* used by outstations only */
-      if(fileValues->fieldsUsed1_3 & CRTL_DESINTATIONUDPPORTFORINITIALUNSOLNULLRESP1_3_13)
+      if ((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NONEDESINTATIONUDPPORTFORRESPONSES1_3_14)
+        pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_FALSE;
+
+      else if ((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_USESOURCEPORTNUMBERDESINTATIONUDPPORTFORRESP1_3_14)
       {
-        pBinFileTargValues->destUdpPortForUnsol = (TMWTYPES_USHORT)fileValues->destUdpPortForInitialUnsolNullResp1_3;
-        if (!((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NONEDESINTATIONUDPPORTFORINITIALUNSOLNULLRESP1_3_13))
-          pBinFileTargValues->useDestUdpPortForUnsol1_3_13 = TMWDEFS_TRUE;
+        pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_TRUE;
+        pBinFileTargValues->useSourcePortNumberForResponses = TMWDEFS_TRUE;
       }
-
-      /*1.3.14*/
-      /* used by outstations only*/
-      if(fileValues->fieldsUsed1_3 & CRTL_DESINTATIONUDPPORTFORRESPONSES1_3_14)
+      else
       {
-        pBinFileTargValues->useSourcePortNumberForResponses = TMWDEFS_FALSE;
-
-        if ((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_NONEDESINTATIONUDPPORTFORRESPONSES1_3_14)
-          pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_FALSE;
-
-        else if ((TMWTYPES_USHORT)fileValues->specialControls1_3 & SPCTRL_USESOURCEPORTNUMBERDESINTATIONUDPPORTFORRESP1_3_14)
-        {
-          pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_TRUE;
-          pBinFileTargValues->useSourcePortNumberForResponses = TMWDEFS_TRUE;
-        }
-        else
-        {
-          pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_TRUE;
-          pBinFileTargValues->destUdpPortForResponses = (TMWTYPES_USHORT)fileValues->destUdpPortForResponses1_3;
-        }
+        pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_TRUE;
+        pBinFileTargValues->destUdpPortForResponses = (TMWTYPES_USHORT)fileValues->destUdpPortForResponses1_3;
       }
     }
   }
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_4 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_4(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize = 0;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_4];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_4];
-  TMWTYPES_UCHAR field3[DNPBNCFG_DATALINKADDRESS_SIZE1_4];
-  TMWTYPES_UCHAR field4[DNPBNCFG_DNP3SOURCEADDRVALIDATION_SIZE1_4];
-  TMWTYPES_UCHAR field5[DNPBNCFG_DNP3SOURCEADDRS_SIZE1_4];
-  TMWTYPES_UCHAR field6[DNPBNCFG_SENDSCONFIRMEDUSERDATAFRAMES_SIZE1_4];
-  TMWTYPES_UCHAR field7[DNPBNCFG_DATALINKLAYERCONFIRMTIMEOUT_SIZE1_4];
-  TMWTYPES_UCHAR field8[DNPBNCFG_MAXDATALINKRETRIES_SIZE1_4];
-  TMWTYPES_UCHAR field9[DNPBNCFG_MAXNUMOCTETSTXINDATALINKFRAME_SIZE1_4];
-  TMWTYPES_UCHAR field10[DNPBNCFG_MAXNUMOCTETSRECEIVEDINDATALINKFRAME_SIZE1_4];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_4, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_4, fp);
-  charRead += fread(field3, 1, DNPBNCFG_DATALINKADDRESS_SIZE1_4, fp);
-  charRead += fread(field4, 1, DNPBNCFG_DNP3SOURCEADDRVALIDATION_SIZE1_4, fp);
-  charRead += fread(field5, 1, DNPBNCFG_DNP3SOURCEADDRS_SIZE1_4, fp);
-  charRead += fread(field6, 1, DNPBNCFG_SENDSCONFIRMEDUSERDATAFRAMES_SIZE1_4, fp);
-  charRead += fread(field7, 1, DNPBNCFG_DATALINKLAYERCONFIRMTIMEOUT_SIZE1_4, fp);
-  charRead += fread(field8, 1, DNPBNCFG_MAXDATALINKRETRIES_SIZE1_4, fp);
-  charRead += fread(field9, 1, DNPBNCFG_MAXNUMOCTETSTXINDATALINKFRAME_SIZE1_4, fp);
-  charRead += fread(field10, 1, DNPBNCFG_MAXNUMOCTETSRECEIVEDINDATALINKFRAME_SIZE1_4, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
-
-  readOK = (sectionSize == charRead);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_4)
+    return TMWDEFS_FALSE;
 
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_4);
-    tmwtarg_get32(field2, &fileValues->specialControls1_4);
-    tmwtarg_get32(field3, &fileValues->dataLinkAddress1_4);
-    tmwtarg_get32(field4, &fileValues->dnp3SourceAddrValidation1_4);
-    tmwtarg_get32(field5, &fileValues->dnp3SourceAddrs1_4);
-    tmwtarg_get32(field6, &fileValues->sendsConfirmedUserDataFrames1_4);
-    tmwtarg_get32(field7, &fileValues->dataLinkLayerConfirmTimeout1_4);
-    tmwtarg_get32(field8, &fileValues->maxDataLinkRetries1_4);
-    tmwtarg_get32(field9, &fileValues->maxNumOctetsTxDataLinkFrame1_4);
-    tmwtarg_get32(field10, &fileValues->maxNumOctetsRxDataLinkFrame1_4);
-  }
+  _getULong(&pField, &fileValues->fieldsUsed1_4);
+  _getULong(&pField, &fileValues->specialControls1_4);
+  _getULong(&pField, &fileValues->dataLinkAddress1_4);
+  _getULong(&pField, &fileValues->dnp3SourceAddrValidation1_4);
+  _getULong(&pField, &fileValues->dnp3SourceAddrs1_4);
+  _getULong(&pField, &fileValues->sendsConfirmedUserDataFrames1_4);
+  _getULong(&pField, &fileValues->dataLinkLayerConfirmTimeout1_4);
+  _getULong(&pField, &fileValues->maxDataLinkRetries1_4);
+  _getULong(&pField, &fileValues->maxNumOctetsTxDataLinkFrame1_4);
+  _getULong(&pField, &fileValues->maxNumOctetsRxDataLinkFrame1_4);
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_5 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_5(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_5];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_5];
-  TMWTYPES_UCHAR field3[DNPBNCFG_MAXTRANSMITTEDFRAGMENTSIZE_SIZE1_5];
-  TMWTYPES_UCHAR field4[DNPBNCFG_MAXFILETRANSFERTRANSMITTEDFRAGMENTSIZE_SIZE1_5];
-  TMWTYPES_UCHAR field5[DNPBNCFG_MAXRECEIVEDFRAGMENTSIZE_SIZE1_5];
-  TMWTYPES_UCHAR field6[DNPBNCFG_MAXOBJECTSINCROBCONTROLREQUEST_SIZE1_5];
-  TMWTYPES_UCHAR field7[DNPBNCFG_MAXOBJECTSINANALOGOUTPUTCONTROLREQUEST_SIZE1_5];
-  TMWTYPES_UCHAR field8[DNPBNCFG_MAXOBJECTSINDATASETSCONTROLREQUEST_SIZE1_5];
-  TMWTYPES_UCHAR field9[DNPBNCFG_SUPPORTSMIXEDOBJECTGROUPSINCONTROLREQUEST_SIZE1_5];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_5, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_5, fp);
-  charRead += fread(field3, 1, DNPBNCFG_MAXTRANSMITTEDFRAGMENTSIZE_SIZE1_5, fp);
-  charRead += fread(field4, 1, DNPBNCFG_MAXFILETRANSFERTRANSMITTEDFRAGMENTSIZE_SIZE1_5, fp);
-  charRead += fread(field5, 1, DNPBNCFG_MAXRECEIVEDFRAGMENTSIZE_SIZE1_5, fp);
-  charRead += fread(field6, 1, DNPBNCFG_MAXOBJECTSINCROBCONTROLREQUEST_SIZE1_5, fp);
-  charRead += fread(field7, 1, DNPBNCFG_MAXOBJECTSINANALOGOUTPUTCONTROLREQUEST_SIZE1_5, fp);
-  charRead += fread(field8, 1, DNPBNCFG_MAXOBJECTSINDATASETSCONTROLREQUEST_SIZE1_5, fp);
-  charRead += fread(field9, 1, DNPBNCFG_SUPPORTSMIXEDOBJECTGROUPSINCONTROLREQUEST_SIZE1_5, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
-
-  readOK = (sectionSize == charRead);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_5)
+    return TMWDEFS_FALSE;
 
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_5);
-    tmwtarg_get32(field2, &fileValues->specialControls1_5);
-    tmwtarg_get32(field3, &fileValues->maxTxFragmentSize1_5);
-    tmwtarg_get32(field4, &fileValues->maxFileTransferTxFragSize1_5);
-    tmwtarg_get32(field5, &fileValues->maxRxFragmentSize1_5);
-    tmwtarg_get32(field6, &fileValues->maxObjsInCROBControlRequest1_5);
-    tmwtarg_get32(field7, &fileValues->maxObjsInAnalogOutputCtrlReq1_5);
-    tmwtarg_get32(field8, &fileValues->maxObjsInDataSetsCtrlReq1_5);
-    tmwtarg_get32(field9, &fileValues->supportsMixedObjGrpsInCtrlReq1_5);
-  }
+  _getULong(&pField, &fileValues->fieldsUsed1_5);
+  _getULong(&pField, &fileValues->specialControls1_5);
+  _getULong(&pField, &fileValues->maxTxFragmentSize1_5);
+  _getULong(&pField, &fileValues->maxFileTransferTxFragSize1_5);
+  _getULong(&pField, &fileValues->maxRxFragmentSize1_5);
+  _getULong(&pField, &fileValues->maxObjsInCROBControlRequest1_5);
+  _getULong(&pField, &fileValues->maxObjsInAnalogOutputCtrlReq1_5);
+  _getULong(&pField, &fileValues->maxObjsInDataSetsCtrlReq1_5);
+  _getULong(&pField, &fileValues->supportsMixedObjGrpsInCtrlReq1_5);
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_6 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_6(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_6];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_6];
-  TMWTYPES_UCHAR field3[DNPBNCFG_APPLLAYERCOMPLETERESPONSETIMEOUT_SIZE1_6];
-  TMWTYPES_UCHAR field4[DNPBNCFG_APPLLAYERFRAGMENTRESPONSETIMEOUT_SIZE1_6];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_6, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_6, fp);
-  charRead += fread(field3, 1, DNPBNCFG_APPLLAYERCOMPLETERESPONSETIMEOUT_SIZE1_6, fp);
-  charRead += fread(field4, 1, DNPBNCFG_APPLLAYERFRAGMENTRESPONSETIMEOUT_SIZE1_6, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_6)
+    return TMWDEFS_FALSE;
 
-  readOK = (sectionSize == charRead);
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_6);
-    tmwtarg_get32(field2, &fileValues->specialControls1_6);
-    tmwtarg_get32(field3, &fileValues->applLayerCompleteRespTimeout1_6);
-    tmwtarg_get32(field4, &fileValues->applLayerFragRespTimeout1_6);
-  }
+  _getULong(&pField, &fileValues->fieldsUsed1_6);
+  _getULong(&pField, &fileValues->specialControls1_6);
+  _getULong(&pField, &fileValues->applLayerCompleteRespTimeout1_6);
+  _getULong(&pField, &fileValues->applLayerFragRespTimeout1_6);
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_7 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_7(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_7];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_7];
-  TMWTYPES_UCHAR field3[DNPBNCFG_APPLICATIONLAYERCONFIRMTIMEOUT_SIZE1_7];
-  TMWTYPES_UCHAR field4[DNPBNCFG_TIMESYNCREQUIRED_SIZE1_7];
-  TMWTYPES_UCHAR field5[DNPBNCFG_FILEHANDLETIMEOUT_SIZE1_7];
-  TMWTYPES_UCHAR field6[DNPBNCFG_EVENTBUFFEROVERFLOWBEHAVIOR_SIZE1_7];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_7, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_7, fp);
-  charRead += fread(field3, 1, DNPBNCFG_APPLICATIONLAYERCONFIRMTIMEOUT_SIZE1_7, fp);
-  charRead += fread(field4, 1, DNPBNCFG_TIMESYNCREQUIRED_SIZE1_7, fp);
-  charRead += fread(field5, 1, DNPBNCFG_FILEHANDLETIMEOUT_SIZE1_7, fp);
-  charRead += fread(field6, 1, DNPBNCFG_EVENTBUFFEROVERFLOWBEHAVIOR_SIZE1_7, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
-
-  readOK = (sectionSize == charRead);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_7)
+    return TMWDEFS_FALSE;
 
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_7);
-    tmwtarg_get32(field2, &fileValues->specialControls1_7);
-    tmwtarg_get32(field3, &fileValues->applLayerConfirmTimeout1_7);
-    tmwtarg_get32(field4, &fileValues->timeSyncRequired1_7);
-    tmwtarg_get32(field5, &fileValues->fileHandleTimeout1_7);
-    tmwtarg_get32(field6, &fileValues->eventBufOverflowBehavior1_7);
-  }
+  _getULong(&pField, &fileValues->fieldsUsed1_7);
+  _getULong(&pField, &fileValues->specialControls1_7);
+  _getULong(&pField, &fileValues->applLayerConfirmTimeout1_7);
+  _getULong(&pField, &fileValues->timeSyncRequired1_7);
+  _getULong(&pField, &fileValues->fileHandleTimeout1_7);
+  _getULong(&pField, &fileValues->eventBufOverflowBehavior1_7);
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_8 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_8(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_8];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_8];
-  TMWTYPES_UCHAR field3[DNPBNCFG_MASTERDATALINKADDRESS_SIZE1_8];
-  TMWTYPES_UCHAR field4[DNPBNCFG_UNSOLICITEDRESPONSECONFIRMATIONTIMEOUT_SIZE1_8];
-  TMWTYPES_UCHAR field5[DNPBNCFG_MAXUNSOLICITEDRETRIES_SIZE1_8];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_8, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_8, fp);
-  charRead += fread(field3, 1, DNPBNCFG_MASTERDATALINKADDRESS_SIZE1_8, fp);
-  charRead += fread(field4, 1, DNPBNCFG_UNSOLICITEDRESPONSECONFIRMATIONTIMEOUT_SIZE1_8, fp);
-  charRead += fread(field5, 1, DNPBNCFG_MAXUNSOLICITEDRETRIES_SIZE1_8, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_8)
+    return TMWDEFS_FALSE;
 
-  readOK = (sectionSize == charRead);
+  _getULong(&pField, &fileValues->fieldsUsed1_8);
+  _getULong(&pField, &fileValues->specialControls1_8);
+  _getULong(&pField, &fileValues->masterDataLinkAddr1_8);
+  _getULong(&pField, &fileValues->unsolRespConfirmTimeout1_8);
+  _getULong(&pField, &fileValues->maxUnsolicitedRetries1_8);
 
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_8);
-    tmwtarg_get32(field2, &fileValues->specialControls1_8);
-    tmwtarg_get32(field3, &fileValues->masterDataLinkAddr1_8);
-    tmwtarg_get32(field4, &fileValues->unsolRespConfirmTimeout1_8);
-    tmwtarg_get32(field5, &fileValues->maxUnsolicitedRetries1_8);
-  }
-
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_9 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_9(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_9];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_9];
-  TMWTYPES_UCHAR field3[DNPBNCFG_NUMBEROFCLASSONEEVENTS_SIZE1_9];
-  TMWTYPES_UCHAR field4[DNPBNCFG_NUMBEROFCLASSTWOEVENTS_SIZE1_9];
-  TMWTYPES_UCHAR field5[DNPBNCFG_NUMBEROFCLASSTHREEEVENTS_SIZE1_9];
-  TMWTYPES_UCHAR field6[DNPBNCFG_HOLDTIMEAFTERCLASSONEEVENT_SIZE1_9];
-  TMWTYPES_UCHAR field7[DNPBNCFG_HOLDTIMEAFTERCLASSTWOEVENT_SIZE1_9];
-  TMWTYPES_UCHAR field8[DNPBNCFG_HOLDTIMEAFTERCLASSTHREEEVENT_SIZE1_9];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_9, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_9, fp);
-  charRead += fread(field3, 1, DNPBNCFG_NUMBEROFCLASSONEEVENTS_SIZE1_9, fp);
-  charRead += fread(field4, 1, DNPBNCFG_NUMBEROFCLASSTWOEVENTS_SIZE1_9, fp);
-  charRead += fread(field5, 1, DNPBNCFG_NUMBEROFCLASSTHREEEVENTS_SIZE1_9, fp);
-  charRead += fread(field6, 1, DNPBNCFG_HOLDTIMEAFTERCLASSONEEVENT_SIZE1_9, fp);
-  charRead += fread(field7, 1, DNPBNCFG_HOLDTIMEAFTERCLASSTWOEVENT_SIZE1_9, fp);
-  charRead += fread(field8, 1, DNPBNCFG_HOLDTIMEAFTERCLASSTHREEEVENT_SIZE1_9, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_9)
+    return TMWDEFS_FALSE;
 
-  readOK = (sectionSize == charRead);
+  _getULong(&pField, &fileValues->fieldsUsed1_9);
+  _getULong(&pField, &fileValues->specialControls1_9);
+  _getULong(&pField, &fileValues->numClassOneEvents1_9);
+  _getULong(&pField, &fileValues->numClassTwoEvents1_9);
+  _getULong(&pField, &fileValues->numClassThreeEvents1_9);
+  _getULong(&pField, &fileValues->holdTimeAfterClassOneEvent1_9);
+  _getULong(&pField, &fileValues->holdTimeAfterClassTwoEvent1_9);
+  _getULong(&pField, &fileValues->holdTimeAfterClassThreeEvent1_9);
 
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_9);
-    tmwtarg_get32(field2, &fileValues->specialControls1_9);
-    tmwtarg_get32(field3, &fileValues->numClassOneEvents1_9);
-    tmwtarg_get32(field4, &fileValues->numClassTwoEvents1_9);
-    tmwtarg_get32(field5, &fileValues->numClassThreeEvents1_9);
-    tmwtarg_get32(field6, &fileValues->holdTimeAfterClassOneEvent1_9);
-    tmwtarg_get32(field7, &fileValues->holdTimeAfterClassTwoEvent1_9);
-    tmwtarg_get32(field8, &fileValues->holdTimeAfterClassThreeEvent1_9);
-  }
-
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_10 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_10(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_10];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_10];
-  TMWTYPES_UCHAR field3[DNPBNCFG_OUTSTATIONSETSIIN14_SIZE1_10];
-  TMWTYPES_UCHAR field4[DNPBNCFG_AFTERLASTTIMESYNCOUTSTATIONSETSIIN14_SIZE1_10];
-  TMWTYPES_UCHAR field5[DNPBNCFG_WHENTIMEERROREXCEEDSOUTSTATIONSETSIIN14_SIZE1_10];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_10, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_10, fp);
-  charRead += fread(field3, 1, DNPBNCFG_OUTSTATIONSETSIIN14_SIZE1_10, fp);
-  charRead += fread(field4, 1, DNPBNCFG_AFTERLASTTIMESYNCOUTSTATIONSETSIIN14_SIZE1_10, fp);
-  charRead += fread(field5, 1, DNPBNCFG_WHENTIMEERROREXCEEDSOUTSTATIONSETSIIN14_SIZE1_10, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_10)
+    return TMWDEFS_FALSE;
 
-  readOK = (sectionSize == charRead);
+  _getULong(&pField, &fileValues->fieldsUsed1_10);
+  _getULong(&pField, &fileValues->specialControls1_10);
+  _getULong(&pField, &fileValues->outStationSetsIIN14_1_10);
+  _getULong(&pField, &fileValues->afterLastTimeSyncOutstationSetsIIN14_1_10);
+  _getULong(&pField, &fileValues->whenTimeErrExceedsOutstationSetsIIN14_1_10);
 
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_10);
-    tmwtarg_get32(field2, &fileValues->specialControls1_10);
-    tmwtarg_get32(field3, &fileValues->outStationSetsIIN14_1_10);
-    tmwtarg_get32(field4, &fileValues->afterLastTimeSyncOutstationSetsIIN14_1_10);
-    tmwtarg_get32(field5, &fileValues->whenTimeErrExceedsOutstationSetsIIN14_1_10);
-  }
-
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 
 /* function: dnpbncfg_readBinaryConfigSection1_11 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_11(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_11];
-  TMWTYPES_UCHAR field2[DNPBNCFG_OUTSTATIONLOCATION_SIZE1_11];
-  TMWTYPES_UCHAR field3[DNPBNCFG_OUTSTATIONID_SIZE1_11];
-  TMWTYPES_UCHAR field4[DNPBNCFG_OUTSTATIONNAME_SIZE1_11];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_11, fp);
-  charRead += fread(field2, 1, DNPBNCFG_OUTSTATIONLOCATION_SIZE1_11, fp);
-  charRead += fread(field3, 1, DNPBNCFG_OUTSTATIONID_SIZE1_11, fp);
-  charRead += fread(field4, 1, DNPBNCFG_OUTSTATIONNAME_SIZE1_11, fp);
-
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
-
-  readOK = (sectionSize == charRead);
-
-  if (readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_11);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_11)
+    return TMWDEFS_FALSE;
 
-    strncpy(fileValues->outstationLocation1_11, (const char *)field2, DNPBNCFG_OUTSTATIONLOCATION_SIZE1_11);
-    strncpy(fileValues->outstationId1_11, (const char *)field3, DNPBNCFG_OUTSTATIONID_SIZE1_11);
-    strncpy(fileValues->outstationName1_11, (const char *)field4, DNPBNCFG_OUTSTATIONNAME_SIZE1_11);
-  }
+  _getULong(&pField, &fileValues->fieldsUsed1_11);
+  _getString(&pField, fileValues->outstationLocation1_11, DNPBNCFG_OUTSTATIONLOCATION_SIZE1_11);
+  _getString(&pField, fileValues->outstationId1_11, DNPBNCFG_OUTSTATIONID_SIZE1_11);
+  _getString(&pField, fileValues->outstationName1_11, DNPBNCFG_OUTSTATIONNAME_SIZE1_11);
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_12 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_12(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_12];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_12];
-  TMWTYPES_UCHAR field3[DNPBNCFG_VERSIONOFSECUREAUTHENTICATIONSUPPORTED_SIZE1_12];
-  TMWTYPES_UCHAR field4[DNPBNCFG_MAXNUMBERUSERS_SIZE1_12];
-  TMWTYPES_UCHAR field5[DNPBNCFG_SECURITYRESPONSETIMEOUT_SIZE1_12];
-  TMWTYPES_UCHAR field6[DNPBNCFG_SESSIONKEYCHANGEINTERVAL_SIZE1_12];
-  TMWTYPES_UCHAR field7[DNPBNCFG_SESSIONKEYCHANGEMESSAGECOUNT_SIZE1_12];
-  TMWTYPES_UCHAR field8[DNPBNCFG_MAXERRORCOUNT_SIZE1_12];
-  TMWTYPES_UCHAR field9[DNPBNCFG_HMACALGORITHMREQUESTED_SIZE1_12];
-  TMWTYPES_UCHAR field10[DNPBNCFG_KEYWRAPALGORITHM_SIZE1_12];
-  TMWTYPES_UCHAR field11[DNPBNCFG_ADDITIONALCRITICALFCS_SIZE1_12];
-  TMWTYPES_UCHAR field12[DNPBNCFG_REMOTEKEYUPDATECHANGE_SIZE1_12];
-
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_12, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_12, fp);
-  charRead += fread(field3, 1, DNPBNCFG_VERSIONOFSECUREAUTHENTICATIONSUPPORTED_SIZE1_12, fp);
-  charRead += fread(field4, 1, DNPBNCFG_MAXNUMBERUSERS_SIZE1_12, fp);
-  charRead += fread(field5, 1, DNPBNCFG_SECURITYRESPONSETIMEOUT_SIZE1_12, fp);
-  charRead += fread(field6, 1, DNPBNCFG_SESSIONKEYCHANGEINTERVAL_SIZE1_12, fp);
-  charRead += fread(field7, 1, DNPBNCFG_SESSIONKEYCHANGEMESSAGECOUNT_SIZE1_12, fp);
-  charRead += fread(field8, 1, DNPBNCFG_MAXERRORCOUNT_SIZE1_12, fp);
-  charRead += fread(field9, 1, DNPBNCFG_HMACALGORITHMREQUESTED_SIZE1_12, fp);
-  charRead += fread(field10, 1, DNPBNCFG_KEYWRAPALGORITHM_SIZE1_12, fp);
-  charRead += fread(field11, 1, DNPBNCFG_ADDITIONALCRITICALFCS_SIZE1_12, fp);
+  const TMWTYPES_UCHAR *pField = pSection->pData;
+  TMWTYPES_ULONG expectedSize = DNPBNCFG_SECTION_SIZE1_12;
 
+  /* The last field is only present in the Nov2013 device profile or newer */
   if (xmlVersionIndex >= 2)
-    charRead += fread(field12, 1, DNPBNCFG_REMOTEKEYUPDATECHANGE_SIZE1_12, fp);    /* only read if Nov2013 device profile or newer */
+    expectedSize += DNPBNCFG_REMOTEKEYUPDATECHANGE_SIZE1_12;
 
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
-
-  readOK = (sectionSize == charRead);
-
-  if(readOK)
-  {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_12);
-    tmwtarg_get32(field2, &fileValues->specialControls1_12);
-    tmwtarg_get32(field3, &fileValues->versionSecureAuthSupported1_12);
-    tmwtarg_get32(field4, &fileValues->maxNumberUsers1_12);
-    tmwtarg_get32(field5, &fileValues->securityResponseTimeout1_12);
-    tmwtarg_get32(field6, &fileValues->sessionKeyChangeInterval1_12);
-    tmwtarg_get32(field7, &fileValues->sessionKeyChangeMessageCnt1_12);
-    tmwtarg_get32(field8, &fileValues->maxErrorCount1_12);
-    tmwtarg_get32(field9, &fileValues->hmacAlgorithmRequested1_12);
-    tmwtarg_get32(field10, &fileValues->keyWrapAlgorithm1_12);
-    tmwtarg_get32(field11, &fileValues->additionalCriticalFcs1_12);
-    if (xmlVersionIndex >= 2)
-      tmwtarg_get32(field11, &fileValues->remoteKeyUpdateChange1_12);
-  }
+  if(pSection->size != expectedSize)
+    return TMWDEFS_FALSE;
 
+  _getULong(&pField, &fileValues->fieldsUsed1_12);
+  _getULong(&pField, &fileValues->specialControls1_12);
+  _getULong(&pField, &fileValues->versionSecureAuthSupported1_12);
+  _getULong(&pField, &fileValues->maxNumberUsers1_12);
+  _getULong(&pField, &fileValues->securityResponseTimeout1_12);
+  _getULong(&pField, &fileValues->sessionKeyChangeInterval1_12);
+  _getULong(&pField, &fileValues->sessionKeyChangeMessageCnt1_12);
+  _getULong(&pField, &fileValues->maxErrorCount1_12);
+  _getULong(&pField, &fileValues->hmacAlgorithmRequested1_12);
+  _getULong(&pField, &fileValues->keyWrapAlgorithm1_12);
+  _getULong(&pField, &fileValues->additionalCriticalFcs1_12);
+  if (xmlVersionIndex >= 2)
+    _getULong(&pField, &fileValues->remoteKeyUpdateChange1_12);
 
-  return readOK;
+  return TMWDEFS_TRUE;
 }
 
 /* function: dnpbncfg_ReadBinaryConfigSection1_13 */
 static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigSection1_13(
-  FILE *fp,
-  TMWTYPES_USHORT xmlVersionIndex, 
+  const DNPBNCFG_SECTION *pSection,
+  TMWTYPES_USHORT xmlVersionIndex,
   DNPBNCFG_FILEVALUES *fileValues)
 {
-  size_t charRead;
-  TMWTYPES_ULONG sectionSize;
-  TMWTYPES_BOOL readOK;
-
-  TMWTYPES_UCHAR sectionSizeArray[DNPBNCFG_SECTION_SIZE_FIELD_SIZE];
-  TMWTYPES_UCHAR field1[DNPBNCFG_CONTROL_SIZE1_13];
-  TMWTYPES_UCHAR field2[DNPBNCFG_SPECIALCONTROL_SIZE1_13];
+  const TMWTYPES_UCHAR *pField = pSection->pData;
   TMWTARG_UNUSED_PARAM(xmlVersionIndex);
 
-  charRead = fread(sectionSizeArray, 1, DNPBNCFG_SECTION_SIZE_FIELD_SIZE, fp);
-  charRead = fread(field1, 1, DNPBNCFG_CONTROL_SIZE1_13, fp);
-  charRead += fread(field2, 1, DNPBNCFG_SPECIALCONTROL_SIZE1_13, fp);
+  if(pSection->size != DNPBNCFG_SECTION_SIZE1_13)
+    return TMWDEFS_FALSE;
 
-  tmwtarg_get32(sectionSizeArray, &sectionSize);
+  _getULong(&pField, &fileValues->fieldsUsed1_13);
+  _getULong(&pField, &fileValues->specialControls1_13);
 
-  readOK = (sectionSize == charRead);
+  return TMWDEFS_TRUE;
+}
 
-  if(readOK)
+/* function: dnpbncfg_ReadBinaryConfigPointList */
+static TMWTYPES_BOOL TMWDEFS_LOCAL dnpbncfg_ReadBinaryConfigPointList(
+  const DNPBNCFG_SECTION *pSection,
+  DNPBNCFG_FILEVALUES *fileValues)
+{
+  const TMWTYPES_UCHAR *pField = pSection->pData;
+  TMWTYPES_ULONG sectionId;
+  TMWTYPES_ULONG numRanges;
+  TMWTYPES_ULONG value;
+  TMWTYPES_ULONG i;
+
+  fileValues->numPointRanges = 0;
+
+  /* The point list section is optional */
+  if(pField == TMWDEFS_NULL)
+    return TMWDEFS_TRUE;
+
+  if(pSection->size < DNPBNCFG_SECTION_HEAD_SIZE_POINTLIST)
+    return TMWDEFS_FALSE;
+
+  _getULong(&pField, &sectionId);
+  _getULong(&pField, &numRanges);
+
+  if((numRanges > DNPBNCFG_MAX_POINT_RANGES)
+    || (pSection->size != DNPBNCFG_SECTION_HEAD_SIZE_POINTLIST + (numRanges * DNPBNCFG_RANGE_SIZE_POINTLIST)))
+    return TMWDEFS_FALSE;
+
+  for(i = 0; i < numRanges; i++)
   {
-    tmwtarg_get32(field1, &fileValues->fieldsUsed1_13);
-    tmwtarg_get32(field2, &fileValues->specialControls1_13);
-  }
+    DNPBNCFG_POINT_RANGE *pRange = &fileValues->pointRanges[i];
 
-  return readOK;
-}
+    _getULong(&pField, &value);
+    pRange->objectGroup = (TMWTYPES_UCHAR)value;
 
+    _getULong(&pField, &value);
+    if(value > 0xffff)
+      return TMWDEFS_FALSE;
+    pRange->quantity = (TMWTYPES_USHORT)value;
 
+    _getULong(&pField, &value);
+    pRange->classMask = (TMWDEFS_CLASS_MASK)value;
 
+    _getULong(&pField, &value);
+    pRange->flags = (TMWTYPES_UCHAR)value;
+  }
 
+  fileValues->numPointRanges = (TMWTYPES_USHORT)numRanges;
+  return TMWDEFS_TRUE;
+}
 
-TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_ReadBinaryConfigFile(
-  FILE *fp, 
+/* function: dnpbncfg_ReadBinaryConfig */
+TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_ReadBinaryConfig(
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length,
   DNPBNCFG_FILEVALUES *pBinFileValues,
   TMWTARG_BINFILE_VALS *pBinFileTargValues,
   TMWTYPES_USHORT *pXMLVersionIndex)
 {
+  DNPBNCFG_SECTION sections[DNPBNCFG_NUM_SECTIONS];
+  DNPBNCFG_SECTION pointList;
   TMWTYPES_BOOL success = TMWDEFS_FALSE;
 
   /* init control variables for available target values */
@@ -1068,56 +887,146 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_ReadBinaryConfigFile(
   pBinFileTargValues->useDestUdpPortForUnsol1_3_13 = TMWDEFS_FALSE;
   pBinFileTargValues->useDestUdpPortForResponses1_3_14 = TMWDEFS_FALSE;
 
+  pBinFileValues->numPointRanges = 0;
 
-  if (fp != NULL)
+  if ((pData != TMWDEFS_NULL) && _findSections(pData, length, sections, &pointList))
   {
-    success = dnpbncfg_ReadBinaryConfigHeader(fp, pBinFileValues, pXMLVersionIndex);
+    success = dnpbncfg_ReadBinaryConfigHeader(pData, pBinFileValues, pXMLVersionIndex);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_1(fp, *pXMLVersionIndex, pBinFileValues, pBinFileTargValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_1(&sections[0], *pXMLVersionIndex, pBinFileValues, pBinFileTargValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_2(fp, *pXMLVersionIndex, pBinFileValues, pBinFileTargValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_2(&sections[1], *pXMLVersionIndex, pBinFileValues, pBinFileTargValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_3(fp, *pXMLVersionIndex, pBinFileValues, pBinFileTargValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_3(&sections[2], *pXMLVersionIndex, pBinFileValues, pBinFileTargValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_4(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_4(&sections[3], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_5(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_5(&sections[4], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_6(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_6(&sections[5], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_7(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_7(&sections[6], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_8(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_8(&sections[7], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_9(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_9(&sections[8], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_10(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_10(&sections[9], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_11(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_11(&sections[10], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_12(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_12(&sections[11], *pXMLVersionIndex, pBinFileValues);
 
     if (success)
-      success = dnpbncfg_ReadBinaryConfigSection1_13(fp, *pXMLVersionIndex, pBinFileValues);
+      success = dnpbncfg_ReadBinaryConfigSection1_13(&sections[12], *pXMLVersionIndex, pBinFileValues);
 
-    fclose(fp);
+    if (success)
+      success = dnpbncfg_ReadBinaryConfigPointList(&pointList, pBinFileValues);
 
     if(success)
       pBinFileTargValues->binFileIsOutstation = pBinFileValues->isOutStation;
+  }
+
+  return success;
+}
+
+/* function: dnpbncfg_ReadBinaryConfigFile */
+TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_ReadBinaryConfigFile(
+  FILE *fp,
+  DNPBNCFG_FILEVALUES *pBinFileValues,
+  TMWTARG_BINFILE_VALS *pBinFileTargValues,
+  TMWTYPES_USHORT *pXMLVersionIndex)
+{
+  TMWTYPES_BOOL success = TMWDEFS_FALSE;
+  TMWTYPES_UCHAR *pData;
+  long start;
+  long end;
+
+  if (fp == NULL)
+    return TMWDEFS_FALSE;
+
+  /* Read the rest of the file in one go */
+  start = ftell(fp);
+  if ((start < 0) || (fseek(fp, 0, SEEK_END) != 0))
+    return TMWDEFS_FALSE;
+
+  end = ftell(fp);
+  if ((end <= start) || (fseek(fp, start, SEEK_SET) != 0))
+    return TMWDEFS_FALSE;
 
+  pData = (TMWTYPES_UCHAR *)tmwtarg_alloc((TMWTYPES_UINT)(end - start));
+  if (pData == TMWDEFS_NULL)
+    return TMWDEFS_FALSE;
+
+  if (fread(pData, 1, (size_t)(end - start), fp) == (size_t)(end - start))
+    success = dnpbncfg_ReadBinaryConfig(pData, (TMWTYPES_ULONG)(end - start), pBinFileValues, pBinFileTargValues, pXMLVersionIndex);
+
+  tmwtarg_free(pData);
+  return success;
+}
+
+/* function: dnpbncfg_LoadBinaryConfigFile */
+TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_LoadBinaryConfigFile(
+  const TMWTYPES_CHAR *pFileName,
+  DNPBNCFG_FILEVALUES *pBinFileValues,
+  TMWTARG_BINFILE_VALS *pBinFileTargValues,
+  TMWTYPES_USHORT *pXMLVersionIndex)
+{
+  TMWTYPES_BOOL success = TMWDEFS_FALSE;
+#if defined(TMW_LINUX_TARGET)
+  struct stat fileStat;
+  void *pData;
+  size_t length;
+  int fd;
+
+  fd = open(pFileName, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return TMWDEFS_FALSE;
+
+  if ((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0)
+    || ((TMWTYPES_ULONG)fileStat.st_size != (TMWTYPES_ULONG)(size_t)fileStat.st_size))
+  {
+    close(fd);
+    return TMWDEFS_FALSE;
+  }
+  length = (size_t)fileStat.st_size;
+
+  /* The mapping stays valid after the descriptor is closed */
+  pData = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (pData == MAP_FAILED)
+    return TMWDEFS_FALSE;
+
+  success = dnpbncfg_ReadBinaryConfig((const TMWTYPES_UCHAR *)pData, (TMWTYPES_ULONG)length, pBinFileValues, pBinFileTargValues, pXMLVersionIndex);
+
+  munmap(pData, length);
+#else
+  FILE *fp = NULL;
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+  fopen_s(&fp, pFileName, "rb");
+#else
+  fp = fopen(pFileName, "rb");
+#endif
+
+  if (fp != NULL)
+  {
+    success = dnpbncfg_ReadBinaryConfigFile(fp, pBinFileValues, pBinFileTargValues, pXMLVersionIndex);
+    fclose(fp);
   }
+#endif
 
   return success;
 }
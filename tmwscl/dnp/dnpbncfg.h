@@ -170,6 +170,24 @@
 #define DNPBNCFG_CONTROL_SIZE1_13             4
 #define DNPBNCFG_SPECIALCONTROL_SIZE1_13      4
 
+/*field size definitions for the point list section of the binary configuration file.
+ *This section is not part of the device profile. When present it follows section 1.13
+ *and lists the points to create as ranges of points with the same settings. */
+#define DNPBNCFG_SECTIONID_SIZE_POINTLIST     4
+#define DNPBNCFG_RANGECOUNT_SIZE_POINTLIST    4
+#define DNPBNCFG_OBJECTGROUP_SIZE_POINTLIST   4
+#define DNPBNCFG_QUANTITY_SIZE_POINTLIST      4
+#define DNPBNCFG_CLASSMASK_SIZE_POINTLIST     4
+#define DNPBNCFG_FLAGS_SIZE_POINTLIST         4
+
+/*value of the section id field of the point list section, "PNTL" */
+#define DNPBNCFG_SECTIONID_POINTLIST          0x4c544e50UL
+
+/*largest number of ranges that can be read from the point list section */
+#ifndef DNPBNCFG_MAX_POINT_RANGES
+#define DNPBNCFG_MAX_POINT_RANGES             64
+#endif
+
 /*field size definitions for the header of the binary configuration file */
 #define DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN  8
 
@@ -577,6 +595,16 @@
 #define SPCRTL_ENABLEDBROADCASTFUNCTFC24    0x02000000UL
 #define SPCRTL_ENABLEDBROADCASTFUNCTFC31    0x04000000UL
 
+/* One range of points read from the point list section. The points are
+ * created with the next free point numbers of the object group.
+ */
+typedef struct DnpBinConfigPointRange {
+  TMWTYPES_UCHAR objectGroup;
+  TMWTYPES_USHORT quantity;
+  TMWDEFS_CLASS_MASK classMask;
+  TMWTYPES_UCHAR flags;
+} DNPBNCFG_POINT_RANGE;
+
 typedef struct DnpBinConfigFileValues {
   TMWTYPES_BOOL isOutStation;
   TMWTYPES_UCHAR xmlVersion[DNPBNCFG_BIN_CONFIG_HEADER_FIELD_LEN];
@@ -705,6 +733,10 @@ typedef struct DnpBinConfigFileValues {
   /*Section 1.13 */
   TMWTYPES_ULONG fieldsUsed1_13;
   TMWTYPES_ULONG specialControls1_13;
+
+  /*Point list section */
+  TMWTYPES_USHORT numPointRanges;
+  DNPBNCFG_POINT_RANGE pointRanges[DNPBNCFG_MAX_POINT_RANGES];
   
 } DNPBNCFG_FILEVALUES;
 
@@ -714,12 +746,62 @@ extern "C" {
 #endif
 
 #if DNPCNFG_SUPPORT_BINCONFIG
+/* function: dnpbncfg_ReadBinaryConfig
+ * purpose: Decode a binary configuration file that is held in memory.
+ *  The sizes of all of the sections are checked against length before
+ *  any section is decoded.
+ * arguments:
+ *  pData - contents of the binary configuration file
+ *  length - number of bytes in pData
+ *  pBinFileValues - filled in with the values from the file
+ *  pTargBinFileValues - filled in with the target layer values from the file
+ *  pXMLVersion - set to the index of the device profile version of the file
+ * returns:
+ *  TMWDEFS_TRUE if the file was decoded
+ */
+TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_ReadBinaryConfig(
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length,
+  DNPBNCFG_FILEVALUES *pBinFileValues,
+  TMWTARG_BINFILE_VALS *pTargBinFileValues,
+  TMWTYPES_USHORT *pXMLVersion);
+
+/* function: dnpbncfg_ReadBinaryConfigFile
+ * purpose: Read the rest of an open binary configuration file with a
+ *  single read and decode it with dnpbncfg_ReadBinaryConfig. The caller
+ *  closes fp.
+ * arguments:
+ *  fp - binary configuration file opened for reading
+ *  pBinFileValues - filled in with the values from the file
+ *  pTargBinFileValues - filled in with the target layer values from the file
+ *  pXMLVersion - set to the index of the device profile version of the file
+ * returns:
+ *  TMWDEFS_TRUE if the file was decoded
+ */
 TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_ReadBinaryConfigFile(
   FILE *fp, 
   DNPBNCFG_FILEVALUES *pBinFileValues,
   TMWTARG_BINFILE_VALS *pTargBinFileValues,
   TMWTYPES_USHORT *pXMLVersion);
 
+/* function: dnpbncfg_LoadBinaryConfigFile
+ * purpose: Open a binary configuration file and decode it with
+ *  dnpbncfg_ReadBinaryConfig. On Linux the file is mapped into memory
+ *  rather than read.
+ * arguments:
+ *  pFileName - full path to the binary configuration file
+ *  pBinFileValues - filled in with the values from the file
+ *  pTargBinFileValues - filled in with the target layer values from the file
+ *  pXMLVersion - set to the index of the device profile version of the file
+ * returns:
+ *  TMWDEFS_TRUE if the file was decoded
+ */
+TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL dnpbncfg_LoadBinaryConfigFile(
+  const TMWTYPES_CHAR *pFileName,
+  DNPBNCFG_FILEVALUES *pBinFileValues,
+  TMWTARG_BINFILE_VALS *pTargBinFileValues,
+  TMWTYPES_USHORT *pXMLVersion);
+
 #endif
 
 #ifdef __cplusplus
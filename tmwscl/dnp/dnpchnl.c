@@ -360,8 +360,7 @@ static void _saveLastTxFragment(
       if(!pDNPSession->operateInV2Mode)
       {
         DNPCHNL *pDNPChnl = (DNPCHNL *)pTxData->pChannel;
-        memcpy(pDNPChnl->lastUnsolTxFragment, pTxData->pMsgBuf, pTxData->msgLength);
-        pDNPChnl->lastUnsolTxFragmentLength = pTxData->msgLength;
+        dnpchnl_holdTxData(&pDNPChnl->pLastUnsolTxFragment, pTxData);
         return;
       }
 #endif
@@ -373,13 +372,11 @@ static void _saveLastTxFragment(
       /* Check for broadcast request */
       if (pDNPSession != TMWDEFS_NULL)
       {
-        memcpy(pDNPSession->lastTxFragment, pTxData->pMsgBuf, pTxData->msgLength);
-        pDNPSession->lastTxFragmentLength = pTxData->msgLength;
+        dnpchnl_holdTxData(&pDNPSession->pLastTxFragment, pTxData);
     }
 #else 
       DNPCHNL *pDNPChnl = (DNPCHNL *)pTxData->pChannel;
-      memcpy(pDNPChnl->lastTxFragment, pTxData->pMsgBuf, pTxData->msgLength);
-      pDNPChnl->lastTxFragmentLength = pTxData->msgLength;
+      dnpchnl_holdTxData(&pDNPChnl->pLastTxFragment, pTxData);
 #endif
     }
   }
@@ -787,8 +784,8 @@ TMWCHNL * TMWDEFS_GLOBAL dnpchnl_openChannel(
 #if DNPCNFG_SUPPORT_AUTHENTICATION
     pChannel->directNoAckDelayTime = 500;
 #if !DNPCNFG_MULTI_SESSION_REQUESTS
-    pChannel->lastTxFragmentLength = 0;
-    pChannel->lastUnsolTxFragmentLength = 0;
+    pChannel->pLastTxFragment = TMWDEFS_NULL;
+    pChannel->pLastUnsolTxFragment = TMWDEFS_NULL;
 #endif
 #endif
 
@@ -1149,6 +1146,12 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL dnpchnl_closeChannel(
     }
   }
 
+#if DNPCNFG_SUPPORT_AUTHENTICATION && !DNPCNFG_MULTI_SESSION_REQUESTS
+  /* Release the last fragments sent */
+  dnpchnl_holdTxData(&pDNPChannel->pLastTxFragment, TMWDEFS_NULL);
+  dnpchnl_holdTxData(&pDNPChannel->pLastUnsolTxFragment, TMWDEFS_NULL);
+#endif
+
   /* Close link layer */
   if(dnplink_deleteChannel(pChannel) == TMWDEFS_FALSE)
   {
@@ -1696,3 +1699,27 @@ void TMWDEFS_GLOBAL dnpchnl_freeTxData(
     dnpmem_free(pTxData);
   }
 }
+
+/* function: dnpchnl_holdTxData */
+void TMWDEFS_GLOBAL dnpchnl_holdTxData(
+  DNPCHNL_TX_DATA **ppHeld,
+  TMWSESN_TX_DATA *pTxData)
+{
+  DNPCHNL_TX_DATA *pPrevious = *ppHeld;
+
+  /* Take the new reference first in case the same structure is held again */
+  if(pTxData != TMWDEFS_NULL)
+    ((DNPCHNL_TX_DATA *)pTxData)->referenceCount++;
+  *ppHeld = (DNPCHNL_TX_DATA *)pTxData;
+
+  if(pPrevious != TMWDEFS_NULL)
+  {
+    /* If someone else still owns it, just drop this reference. 
+     * dnpchnl_freeTxData would cancel its response timer.
+     */
+    if(pPrevious->referenceCount > 1)
+      pPrevious->referenceCount--;
+    else
+      dnpchnl_freeTxData((TMWSESN_TX_DATA *)pPrevious);
+  }
+}
@@ -174,6 +174,14 @@ typedef struct DNPChannelTransDataStruct {
 
 } DNPCHNL_TX_DATA;
 
+/* Message buffer and length of a transmit data structure held with
+ * dnpchnl_holdTxData, or TMWDEFS_NULL and 0 if nothing is held.
+ */
+#define DNPCHNL_HELD_MSGBUF(pHeld) \
+  (((pHeld) != TMWDEFS_NULL) ? (pHeld)->tmw.pMsgBuf : TMWDEFS_NULL)
+#define DNPCHNL_HELD_MSGLEN(pHeld) \
+  ((TMWTYPES_USHORT)(((pHeld) != TMWDEFS_NULL) ? (pHeld)->tmw.msgLength : 0))
+
 /* DNP3 Channel configuration structure. This structure contains 
  * configuration parameters that are specific to a DNP3 channel. 
  */
@@ -292,13 +300,11 @@ typedef struct {
   TMWTYPES_MILLISECONDS directNoAckDelayTime;
 
 #if !DNPCNFG_MULTI_SESSION_REQUESTS
-  TMWTYPES_USHORT lastTxFragmentLength;
-  TMWTYPES_USHORT lastUnsolTxFragmentLength;
-  /* lastUnsolTxFragment is only required if there is a slave session on this channel
-   * This could be removed if only supporting master sessions
+  /* Last fragments sent, held by reference using dnpchnl_holdTxData.
+   * pLastUnsolTxFragment is only used if there is a slave session on this channel
    */
-  TMWTYPES_UCHAR  lastUnsolTxFragment[DNPCNFG_MAX_TX_FRAGMENT_LENGTH];
-  TMWTYPES_UCHAR  lastTxFragment[DNPCNFG_MAX_TX_FRAGMENT_LENGTH];
+  DNPCHNL_TX_DATA *pLastUnsolTxFragment;
+  DNPCHNL_TX_DATA *pLastTxFragment;
 #endif
 
 #endif
@@ -555,6 +561,23 @@ extern "C" {
   TMWDEFS_SCL_API void TMWDEFS_GLOBAL dnpchnl_freeTxData(
     TMWSESN_TX_DATA *pTxData);
 
+  /* function: dnpchnl_holdTxData
+   * purpose: Keep a reference to a transmit data structure that has been
+   *  sent so its message buffer can be used again later without copying
+   *  it, for example the last fragment sent which is needed to calculate
+   *  a secure authentication MAC value. Any structure previously held in
+   *  *ppHeld is released.
+   * arguments:
+   *  ppHeld - pointer to the reference to update
+   *  pTxData - transmit data structure to hold, or TMWDEFS_NULL to only
+   *   release the current reference
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL dnpchnl_holdTxData(
+    DNPCHNL_TX_DATA **ppHeld,
+    TMWSESN_TX_DATA *pTxData);
+
   /* function: dnpchnl_processFragment
    * purpose: Process received fragment 
    * arguments:
@@ -76,6 +76,9 @@
  *   requires more if multiple requests are to be queued on master.
  *   if requests are sent automatically based on IIN bits, 1 is needed
  *   for each simultaneous request.
+ *  with secure authentication up to 2 more per session (per channel if
+ *   DNPCNFG_MULTI_SESSION_REQUESTS is not set) since the last fragments
+ *   sent are held for calculating MAC values instead of being copied.
  */
 #define DNPCNFG_NUMALLOC_CHNL_TX_DATAS        TMWCNFG_MAX_APPL_MSGS
 
@@ -101,6 +104,17 @@
 #define DNPCNFG_MAX_TX_FRAME_LENGTH 292
 #define DNPCNFG_MAX_RX_FRAME_LENGTH 292
 
+/* Define the number of buckets in the per channel table used by the link
+ * layer to find the session a received frame is addressed to. Sessions are
+ * hashed on their local (source) address so that channels with many
+ * sessions, such as multidrop serial lines or TCP concentrators, do not
+ * have to search every session for every received frame.
+ * This must be a power of 2.
+ */
+#ifndef DNPCNFG_LINK_SESSION_HASH_SIZE
+#define DNPCNFG_LINK_SESSION_HASH_SIZE 64
+#endif
+
 /* Define the maximum number of application layer data bytes in a 
  * transport layer fragment. The DNP3 specification recommends a value
  * of 2048 and requires that devices that support a larger fragment
@@ -135,7 +149,9 @@
 /* Define maximum number of files that can be opened simultaniously 
  * This is used for file transfer if Object 70 is supported
  */
+#ifndef DNPCNFG_MAX_FILES_OPEN
 #define DNPCNFG_MAX_FILES_OPEN 5
+#endif
 
 /* Define maximum number of bytes in an extended string 
  * This is used if Object 114 is supported. Object group 114 supports string
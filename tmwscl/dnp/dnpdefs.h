@@ -424,6 +424,11 @@ typedef TMWTYPES_UCHAR DNPDEFS_CROB_ST;
 #define DNPDEFS_CROB_ST_RESERVED         126 /* renamed by TB2014-002 */
 #define DNPDEFS_CROB_ST_UNDEFINED        127
 
+/* Not sent in a response, returned by sdnpdata_binOutOperate when the
+ * control will complete later, see sdnpsesn_controlComplete
+ */
+#define DNPDEFS_CROB_ST_ASYNC           0xfe
+
 /* Commanded state returned in Object Group 13 Binary Output command event */
 #define DNPDEFS_CROB_COMMANDED_STATE_OFF 0x00
 #define DNPDEFS_CROB_COMMANDED_STATE_ON  0x80
@@ -455,6 +460,11 @@ typedef TMWTYPES_UCHAR DNPDEFS_CTLSTAT;
 #define DNPDEFS_CTLSTAT_RESERVED         126 /* renamed by TB2014-002 */
 #define DNPDEFS_CTLSTAT_UNDEFINED        127
 
+/* Not sent in a response, returned by sdnpdata_anlgOutOperate when the
+ * control will complete later, see sdnpsesn_controlComplete
+ */
+#define DNPDEFS_CTLSTAT_ASYNC           0xfe
+
 /* The following definitions are not used by the SCL. They are currently 
  * only used by the SCADA Data Gateway.
  */
@@ -279,6 +279,22 @@ static void TMWDEFS_LOCAL _setCRC(
   return;
 }
 
+/* function: dnplink_computeCRC */
+TMWTYPES_USHORT TMWDEFS_GLOBAL dnplink_computeCRC(
+  TMWTYPES_UCHAR *pBuf,
+  TMWTYPES_USHORT length)
+{
+  return(_computeCRC(pBuf, length));
+}
+
+/* function: dnplink_checkCRC */
+TMWTYPES_BOOL TMWDEFS_GLOBAL dnplink_checkCRC(
+  TMWTYPES_UCHAR *pBuf,
+  TMWTYPES_USHORT count)
+{
+  return(_checkCRC(pBuf, count));
+}
+
 static void TMWDEFS_LOCAL _checkForData(
   DNPLINK_CONTEXT *pLinkContext,
   TMWSESN *pFirstSession)
@@ -457,6 +473,10 @@ static void TMWDEFS_LOCAL _retryFrame(
   {
     if(pLinkContext->retryCount++ < pLinkContext->maxRetries)
     {
+#if TMWCNFG_SUPPORT_METRICS
+      TMWMETR_INC(pLinkContext->tmw.pChannel->metrics.linkRetries);
+#endif
+
       /* Diagnostics */
       DNPDIAG_LINK_FRAME_SENT(
         pLinkContext->pTxDescriptor->pChannel,
@@ -519,6 +539,10 @@ static void TMWDEFS_LOCAL _retryFrame(
        */ 
       if(pLinkContext->retryCount++ < pLinkContext->maxRetries)
       {  
+#if TMWCNFG_SUPPORT_METRICS
+        TMWMETR_INC(pLinkContext->tmw.pChannel->metrics.linkRetries);
+#endif
+
         /* Diagnostics */
         DNPDIAG_LINK_FRAME_SENT(
           pSession->pChannel,
@@ -1117,26 +1141,147 @@ static void TMWDEFS_CALLBACK _rxFrameTimeout(
   pLinkContext->rxFrameOffset = 0;
 }
 
-/* function: _findSession
- * purpose: Check to see if this address is for an open session.
- *  If not check to see if user has registered callback function. If
- *  so call this and then check again to see if the session has been opened.
+/* function: _hashIndex
+ * purpose: return session hash bucket for a local link address
  * arguments:
+ *  address - local (source) link address of session
+ * returns:
+ *  index into pSessionHash
+ */
+static TMWTYPES_UINT TMWDEFS_LOCAL _hashIndex(
+  TMWTYPES_USHORT address)
+{
+  return((TMWTYPES_UINT)(address ^ (address >> 8)) & (DNPCNFG_LINK_SESSION_HASH_SIZE - 1));
+}
+
+/* function: _hashAddSession
+ * purpose: add session to the end of its session hash bucket
+ * arguments:
+ *  pLinkContext - link layer context
+ *  pSession - session to add
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _hashAddSession(
+  DNPLINK_CONTEXT *pLinkContext,
+  TMWSESN *pSession)
+{
+  DNPLINK_SESSION_INFO *pLinkSessionInfo = (DNPLINK_SESSION_INFO *)pSession->pLinkSession;
+  TMWSESN **ppNext;
+
+  pLinkSessionInfo->hashAddress = pSession->srcAddress;
+  pLinkSessionInfo->pNextHashSession = TMWDEFS_NULL;
+
+  ppNext = &pLinkContext->pSessionHash[_hashIndex(pSession->srcAddress)];
+  while(*ppNext != TMWDEFS_NULL)
+  {
+    ppNext = &((DNPLINK_SESSION_INFO *)(*ppNext)->pLinkSession)->pNextHashSession;
+  }
+  *ppNext = pSession;
+}
+
+/* function: _hashRemoveSession
+ * purpose: remove session from its session hash bucket
+ * arguments:
+ *  pLinkContext - link layer context
+ *  pSession - session to remove
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _hashRemoveSession(
+  DNPLINK_CONTEXT *pLinkContext,
+  TMWSESN *pSession)
+{
+  DNPLINK_SESSION_INFO *pLinkSessionInfo = (DNPLINK_SESSION_INFO *)pSession->pLinkSession;
+  TMWSESN **ppNext;
+
+  ppNext = &pLinkContext->pSessionHash[_hashIndex(pLinkSessionInfo->hashAddress)];
+  while(*ppNext != TMWDEFS_NULL)
+  {
+    if(*ppNext == pSession)
+    {
+      *ppNext = pLinkSessionInfo->pNextHashSession;
+      break;
+    }
+    ppNext = &((DNPLINK_SESSION_INFO *)(*ppNext)->pLinkSession)->pNextHashSession;
+  }
+  pLinkSessionInfo->pNextHashSession = TMWDEFS_NULL;
+}
+
+/* function: _hashRebuild
+ * purpose: rebuild session hash from the list of sessions on this channel,
+ *  keeping sessions in each bucket in the same order as the session list.
+ * arguments:
+ *  pLinkContext - link layer context
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _hashRebuild(
+  DNPLINK_CONTEXT *pLinkContext)
+{
+  TMWSESN *pSession = TMWDEFS_NULL;
+  int i;
+
+  for(i = 0; i < DNPCNFG_LINK_SESSION_HASH_SIZE; i++)
+  {
+    pLinkContext->pSessionHash[i] = TMWDEFS_NULL;
+  }
+
+  while((pSession = (TMWSESN *)tmwdlist_getAfter(
+    &pLinkContext->tmw.sessions, (TMWDLIST_MEMBER *)pSession)) != TMWDEFS_NULL)
+  {
+    _hashAddSession(pLinkContext, pSession);
+  }
+}
+
+/* function: _lookupSession
+ * purpose: Search the open sessions for one that matches the addresses in
+ *  a received frame. Frames addressed to a specific local address only need
+ *  to search that address's hash bucket. Requests to the self address can
+ *  match any session so those search the whole session list.
+ * arguments:
+ *  pLinkContext - link layer context
  *  srcAddress - source address from received frame
  *  destAddress - destination address from received frame
+ *  checkSelfResponse - if TMWDEFS_TRUE a session that sent a request to
+ *   the self address will accept a response from any source address
  * returns:
+ *  pointer to matching session or TMWDEFS_NULL
  */
-static TMWSESN * TMWDEFS_LOCAL _findSession(
-  void *pContext,
+static TMWSESN * TMWDEFS_LOCAL _lookupSession(
+  DNPLINK_CONTEXT *pLinkContext,
   TMWTYPES_USHORT srcAddress,
   TMWTYPES_USHORT destAddress,
-  TMWTYPES_UCHAR  control)
+  TMWTYPES_BOOL checkSelfResponse)
 {
   DNPSESN *pDNPSession;
-  DNPLINK_CONTEXT *pLinkContext = (DNPLINK_CONTEXT *)pContext;
   TMWSESN *pSession = TMWDEFS_NULL;
 
-  /* See if there is a session open for this address */
+  if(destAddress != DNPDEFS_SELF_ADDR)
+  {
+    pSession = pLinkContext->pSessionHash[_hashIndex(destAddress)];
+    while(pSession != TMWDEFS_NULL)
+    {
+      pDNPSession = (DNPSESN *)pSession;
+      if(pSession->srcAddress == destAddress)
+      {
+        if(!pDNPSession->validateSourceAddress || (pSession->destAddress == srcAddress))
+        {
+          return(pSession);
+        }
+
+        /* Check for response to self address request */
+        if(checkSelfResponse && (pSession->destAddress == DNPDEFS_SELF_ADDR))
+        {
+          pSession->destAddress = srcAddress;
+          return(pSession);
+        }
+      }
+      pSession = ((DNPLINK_SESSION_INFO *)pSession->pLinkSession)->pNextHashSession;
+    }
+    return(TMWDEFS_NULL);
+  }
+
   while((pSession = (TMWSESN *)tmwdlist_getAfter(
     &pLinkContext->tmw.sessions, (TMWDLIST_MEMBER *)pSession)) != TMWDEFS_NULL)
   {
@@ -1149,21 +1294,49 @@ static TMWSESN * TMWDEFS_LOCAL _findSession(
       }
 
       /* Check for response to self address request */
-      if(pSession->destAddress == DNPDEFS_SELF_ADDR) 
+      if(checkSelfResponse && (pSession->destAddress == DNPDEFS_SELF_ADDR))
       {
         pSession->destAddress = srcAddress;
         return(pSession);
       }
     }
+
     /* Check for request to self address */
-    if(pDNPSession->enableSelfAddress 
-      && (destAddress == DNPDEFS_SELF_ADDR))
+    if(pDNPSession->enableSelfAddress)
     { 
       if(!pDNPSession->validateSourceAddress || (pSession->destAddress == srcAddress))
         return(pSession);
     }
   }
 
+  return(TMWDEFS_NULL);
+}
+
+/* function: _findSession
+ * purpose: Check to see if this address is for an open session.
+ *  If not check to see if user has registered callback function. If
+ *  so call this and then check again to see if the session has been opened.
+ * arguments:
+ *  srcAddress - source address from received frame
+ *  destAddress - destination address from received frame
+ * returns:
+ */
+static TMWSESN * TMWDEFS_LOCAL _findSession(
+  void *pContext,
+  TMWTYPES_USHORT srcAddress,
+  TMWTYPES_USHORT destAddress,
+  TMWTYPES_UCHAR  control)
+{
+  DNPLINK_CONTEXT *pLinkContext = (DNPLINK_CONTEXT *)pContext;
+  TMWSESN *pSession;
+
+  /* See if there is a session open for this address */
+  pSession = _lookupSession(pLinkContext, srcAddress, destAddress, TMWDEFS_TRUE);
+  if(pSession != TMWDEFS_NULL)
+  {
+    return(pSession);
+  }
+
   /* If user has registered an auto open callback function call it now */
   if(pLinkContext->tmw.pChannel->pAutoOpenCallback != TMWDEFS_NULL)
   {
@@ -1204,28 +1377,7 @@ static TMWSESN * TMWDEFS_LOCAL _findSession(
 #endif
 
   /* Check again to see if session has been opened */
-  while((pSession = (TMWSESN *)tmwdlist_getAfter(
-    &pLinkContext->tmw.sessions, (TMWDLIST_MEMBER *)pSession)) != TMWDEFS_NULL)
-  {
-    pDNPSession = (DNPSESN *)pSession;
-    if(pSession->srcAddress == destAddress)
-    {
-      if(!pDNPSession->validateSourceAddress || (pSession->destAddress == srcAddress))
-      {
-        return(pSession);
-      }
-    }
-
-    /* Check for request to self address */
-    if(pDNPSession->enableSelfAddress 
-      && (destAddress == DNPDEFS_SELF_ADDR))
-    { 
-      if(!pDNPSession->validateSourceAddress || (pSession->destAddress == srcAddress))
-        return(pSession);
-    }
-  }
-
-  return(TMWDEFS_NULL);
+  return(_lookupSession(pLinkContext, srcAddress, destAddress, TMWDEFS_FALSE));
 }
 
 /* function: _updateMsg
@@ -2364,6 +2516,20 @@ void dnplink_startLinkStatusTimer(
   }
 }
 
+/* function: dnplink_updateSessionAddress */
+void TMWDEFS_GLOBAL dnplink_updateSessionAddress(
+  TMWSESN *pSession)
+{
+  DNPLINK_SESSION_INFO *pLinkSessionInfo = (DNPLINK_SESSION_INFO *)pSession->pLinkSession;
+
+  if((pLinkSessionInfo != TMWDEFS_NULL)
+    && (pLinkSessionInfo->hashAddress != pSession->srcAddress))
+  {
+    /* Rebuild rather than move the session so it stays in session list order */
+    _hashRebuild((DNPLINK_CONTEXT *)pSession->pChannel->pLinkContext);
+  }
+}
+
 /* function: _openSession
  * purpose: opens a new session on this channel
  * arguments:
@@ -2410,6 +2576,9 @@ static TMWTYPES_BOOL TMWDEFS_CALLBACK _openSession(
     return(TMWDEFS_FALSE);
   }
 
+  /* Add to session lookup table, session was added to end of session list */
+  _hashAddSession(pLinkContext, pSession);
+
   /* If channel is already open tell application layer we are online */
   if(pContext->isOpen)
   {
@@ -2476,6 +2645,9 @@ static TMWTYPES_BOOL TMWDEFS_CALLBACK _closeSession(
     tmwsesn_setOnline(pSession, TMWDEFS_FALSE);
   }
 
+  /* Remove from session lookup table */
+  _hashRemoveSession(pLinkContext, pSession);
+
   /* Protocol specific session shutdown */
   dnpmem_free(pSession->pLinkSession);
 
@@ -2596,6 +2768,7 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL dnplink_initChannel(
   pLinkContext->pRxSession = TMWDEFS_NULL;
   pLinkContext->rxState = DNP_LINK_STATE_IDLE;
   pLinkContext->pRxDiagContext = TMWDEFS_NULL;
+  _hashRebuild(pLinkContext);
 
 #if TMWCNFG_SUPPORT_RXCALLBACKS
   pLinkContext->pRxHeaderCallback = TMWDEFS_NULL;
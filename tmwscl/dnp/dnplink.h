@@ -188,6 +188,12 @@ typedef struct DNPLinkContext {
   TMWTYPES_USHORT        rxFrameOffset;
   TMWTYPES_UCHAR         pRxBlock[DNPLINK_BLOCK_SIZE];
 
+  /* Sessions on this channel hashed on their local (source) address,
+   * chained through DNPLINK_SESSION_INFO pNextHashSession in the same
+   * order they appear in tmw.sessions.
+   */
+  TMWSESN               *pSessionHash[DNPCNFG_LINK_SESSION_HASH_SIZE];
+
 #if TMWCNFG_SUPPORT_RXCALLBACKS
   DNPLINK_DIAG_HEADER_FUNC pRxHeaderCallback;
   void                    *pRxHeaderCallbackParam;
@@ -237,6 +243,12 @@ typedef struct {
   /* Timer to periodically send link status request */
   TMWTIMER linkStatusTimer;
 
+  /* Next session in the same session hash bucket and the local address
+   * this session was hashed on.
+   */
+  TMWSESN *pNextHashSession;
+  TMWTYPES_USHORT hashAddress;
+
 } DNPLINK_SESSION_INFO;
 
 
@@ -296,6 +308,17 @@ extern "C" {
   void TMWDEFS_GLOBAL dnplink_startLinkStatusTimer(
     TMWSESN *pSession);
 
+  /* function: dnplink_updateSessionAddress
+   * purpose: update the link layer session lookup table after the
+   *  source or destination address of an open session has been changed.
+   * arguments:
+   *  pSession - session
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL dnplink_updateSessionAddress(
+    TMWSESN *pSession);
+
   /* function: dnplink_deleteChannel
    * purpose: delete this channel, freeing all allocated memory and releasing
    *  resources. This is called by the SCL when closing a channel, it should 
@@ -389,6 +412,31 @@ extern "C" {
     TMWTYPES_USHORT numBytes,
     TMWTYPES_MILLISECONDS firstByteTime);
 
+  /* function: dnplink_computeCRC
+   * purpose: calculate the DNP3 CRC of a block of data, as used for
+   *  the link header and each block of user data
+   * arguments:
+   *  pBuf - buffer to calculate CRC for
+   *  length - number of bytes in buffer excluding CRC
+   * returns
+   *  CRC value, sent least significant byte first
+   */
+  TMWDEFS_SCL_API TMWTYPES_USHORT TMWDEFS_GLOBAL dnplink_computeCRC(
+    TMWTYPES_UCHAR *pBuf,
+    TMWTYPES_USHORT length);
+
+  /* function: dnplink_checkCRC
+   * purpose: check the 2 byte CRC at the end of a block of data
+   * arguments:
+   *  pBuf - buffer to check
+   *  count - number of bytes in buffer including CRC
+   * returns
+   *  TMWDEFS_TRUE if CRC is good, else TMWDEFS_FALSE
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL dnplink_checkCRC(
+    TMWTYPES_UCHAR *pBuf,
+    TMWTYPES_USHORT count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -87,5 +87,7 @@ void TMWDEFS_GLOBAL dnpsesn_closeSession(
 {
   pSession->pChannel->pTprt->pTprtCloseSession(
     pSession->pChannel->pTprtContext, (TMWSESN *)pSession);
+
+  tmwsesn_closeSession(pSession);
 }
 
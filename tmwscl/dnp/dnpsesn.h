@@ -102,9 +102,10 @@ typedef struct DNPSessionStruct {
    */
   DNPSESN_SAVE_UNSOL_FUNC   pSaveLastUnsolSentFunc;
 
-  /* If allowing simultaneous requests on multiple sessions on a channel */
-  TMWTYPES_USHORT lastTxFragmentLength;
-  TMWTYPES_UCHAR  lastTxFragment[DNPCNFG_MAX_TX_FRAGMENT_LENGTH];
+  /* If allowing simultaneous requests on multiple sessions on a channel,
+   * last fragment sent, held using dnpchnl_holdTxData
+   */
+  DNPCHNL_TX_DATA *pLastTxFragment;
 #endif
 #endif
 
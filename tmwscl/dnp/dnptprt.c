@@ -620,10 +620,25 @@ void TMWDEFS_GLOBAL dnptprt_parseFrame(
   pTprtSessionInfo->rxSequenceNumber = (TMWTYPES_UCHAR)
     ((pTprtSessionInfo->rxSequenceNumber + 1) & DNPDEFS_TH_SEQUENCE_MASK);
 
-  /* Copy received frame into receive fragment buffer and update length */
-  memcpy(pTprtSessionInfo->rxFragmentBuffer + pTprtSessionInfo->rxFragmentOffset,
-    pRxFrame->pMsgBuf + DNPDEFS_TH_SIZE, pRxFrame->msgLength - DNPDEFS_TH_SIZE);
+  if(((transportHeader & DNPDEFS_TH_FIRST) != 0)
+    && ((transportHeader & DNPDEFS_TH_FINAL) != 0)
+    && !pRxFrame->isBroadcast)
+  {
+    /* Single segment fragment, parse it where the link layer put it.
+     * The link receive buffer is not reused until this returns.
+     * Broadcast frames are passed to each session and are still copied
+     * since the application layer may modify a fragment in place.
+     */
+    pTprtSessionInfo->rxFragment.pMsgBuf = pRxFrame->pMsgBuf + DNPDEFS_TH_SIZE;
+  }
+  else
+  {
+    /* Copy received frame into receive fragment buffer */
+    memcpy(pTprtSessionInfo->rxFragmentBuffer + pTprtSessionInfo->rxFragmentOffset,
+      pRxFrame->pMsgBuf + DNPDEFS_TH_SIZE, pRxFrame->msgLength - DNPDEFS_TH_SIZE);
+  }
 
+  /* Update length */
   pTprtSessionInfo->rxFragmentOffset = (TMWTYPES_USHORT)
     (pTprtSessionInfo->rxFragmentOffset + pRxFrame->msgLength - DNPDEFS_TH_SIZE);
 
@@ -751,10 +766,25 @@ void TMWDEFS_GLOBAL dnptprt_parseFrame(
   pTprtSessionInfo->rxSequenceNumber = (TMWTYPES_UCHAR)
     ((pTprtSessionInfo->rxSequenceNumber + 1) & DNPDEFS_TH_SEQUENCE_MASK);
 
-  /* Copy received frame into receive fragment buffer and update length */
-  memcpy(pTprtContext->pRxFragmentBuffer + pTprtContext->rxFragmentOffset,
-    pRxFrame->pMsgBuf + DNPDEFS_TH_SIZE, pRxFrame->msgLength - DNPDEFS_TH_SIZE);
+  if(((transportHeader & DNPDEFS_TH_FIRST) != 0)
+    && ((transportHeader & DNPDEFS_TH_FINAL) != 0)
+    && !pRxFrame->isBroadcast)
+  {
+    /* Single segment fragment, parse it where the link layer put it.
+     * The link receive buffer is not reused until this returns.
+     * Broadcast frames are passed to each session and are still copied
+     * since the application layer may modify a fragment in place.
+     */
+    pTprtContext->rxFragment.pMsgBuf = pRxFrame->pMsgBuf + DNPDEFS_TH_SIZE;
+  }
+  else
+  {
+    /* Copy received frame into receive fragment buffer */
+    memcpy(pTprtContext->pRxFragmentBuffer + pTprtContext->rxFragmentOffset,
+      pRxFrame->pMsgBuf + DNPDEFS_TH_SIZE, pRxFrame->msgLength - DNPDEFS_TH_SIZE);
+  }
 
+  /* Update length */
   pTprtContext->rxFragmentOffset = (TMWTYPES_USHORT)
     (pTprtContext->rxFragmentOffset + pRxFrame->msgLength - DNPDEFS_TH_SIZE);
 
@@ -843,7 +873,11 @@ static void TMWDEFS_LOCAL _transmitNextFrame(
   /* Set frame header */
   pTprtSessionInfo->linkTxDescriptor.pMsgBuf[0] = transportHeader;
 
-  /* Copy user data into frame and update length */
+  /* Copy user data into frame and update length. The transport header
+   * has to sit directly in front of the segment, and the link layer
+   * copies the frame again to insert a CRC after every block, so the
+   * segment is not sent from the fragment in place.
+   */
   memcpy(pTprtSessionInfo->linkTxDescriptor.pMsgBuf + DNPDEFS_TH_SIZE,
     pTprtSessionInfo->pTxDescriptor->pMsgBuf + offset, bytesToTransmit);
 
@@ -909,7 +943,11 @@ static void TMWDEFS_LOCAL _transmitNextFrame(
   /* Set frame header */
   pTprtContext->linkTxDescriptor.pMsgBuf[0] = transportHeader;
 
-  /* Copy user data into frame and update length */
+  /* Copy user data into frame and update length. The transport header
+   * has to sit directly in front of the segment, and the link layer
+   * copies the frame again to insert a CRC after every block, so the
+   * segment is not sent from the fragment in place.
+   */
   memcpy(pTprtContext->linkTxDescriptor.pMsgBuf + DNPDEFS_TH_SIZE,
     pTprtContext->pTxDescriptor->pMsgBuf + offset, bytesToTransmit);
 
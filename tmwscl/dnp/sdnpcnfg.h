@@ -72,12 +72,21 @@
 #define SDNPCNFG_NUMALLOC_OBJECT120_EVENTS   TMWCNFG_MAX_EVENTS
 #define SDNPCNFG_NUMALLOC_OBJECT122_EVENTS   TMWCNFG_MAX_EVENTS
 
+/* Maximum number of files a session can have open for object 70 file
+ * transfer at the same time. Only one of them at a time can be waiting for
+ * an ASYNC database call or an event response, the others are held until
+ * the master sends a request with their handle. Set this to 1 to allow a
+ * single open file per session.
+ */
+#ifndef SDNPCNFG_OBJ70_MAX_OPEN_FILES
+#define SDNPCNFG_OBJ70_MAX_OPEN_FILES        4
+#endif
+
 /* Maximum number of simultaneous file tranfers that can be in progress 
  * which also determines the maximum number of file transfer events 
  * that can be queued at any time.
- * Currently on one per session is supported.
  */
-#define SDNPCNFG_NUMALLOC_OBJECT70_BLOCKS    TMWCNFG_MAX_SESSIONS
+#define SDNPCNFG_NUMALLOC_OBJECT70_BLOCKS    (TMWCNFG_MAX_SESSIONS * SDNPCNFG_OBJ70_MAX_OPEN_FILES)
 
 /* Determines the maximum number of controls allowed in a single request.
  * This applies to both Binary (CROB) and Analog Control outputs.     
@@ -93,6 +102,8 @@
  * used during generation of a device description XML file.
  * This buffer should be large enough to hold an indivisible block of
  * device description information. 
+ * It is also the size of the copy kept of a device description element
+ * that is split between two object 70 blocks.
  */
 #define SDNPCNFG_XML_SAVE_BUF_SIZE            4096
 
@@ -154,6 +165,12 @@
  */
 #define SDNPCNFG_NUMALLOC_SIM_UMEVENTS        100
 
+/* Specify the number of events that can be kept in shared event stores,
+ * see sdnpsevt.h. An event queued for several sessions is only counted once.
+ * Each store also holds on to its last maxEvents events.
+ */
+#define SDNPCNFG_NUMALLOC_SIM_SHARED_EVENTS   1000
+
 /* Specify the number of slave DNP simulated database Data Sets structures that 
  * can be allocated. These are only needed to simulate Data Set points.
  * These are not needed once an actual database is implemented.
@@ -182,4 +199,14 @@
  */
 #define SDNPCNFG_NUMALLOC_DEVICE_PROFILES     TMWCNFG_MAX_SESSIONS
 
+/* Set this to TMWDEFS_FALSE to remove support for operating binary and
+ * analog outputs from commands received over MQTT, see sdnpmqtt.h.
+ */
+#define SDNPCNFG_SUPPORT_MQTT_COMMANDS        TMWDEFS_TRUE
+
+/* Set this to TMWDEFS_FALSE to remove support for publishing point events
+ * to an MQTT broker over several connections, see sdnpmpub.h.
+ */
+#define SDNPCNFG_SUPPORT_MQTT_PUBLISHER       TMWDEFS_TRUE
+
 #endif /* SDNPCNFG_DEFINED */
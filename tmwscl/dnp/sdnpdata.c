@@ -39,6 +39,12 @@
 #if TMWCNFG_USE_SIMULATED_DB
 #include "tmwscl/dnp/sdnpsim.h"
 #include "tmwscl/dnp/sdnpfsim.h"
+#if TMWTARG_SUPPORT_SHM_DB
+#include "tmwscl/dnp/sdnpshm.h"
+#endif
+#if SDNPCNFG_USER_MANAGED_EVENTS
+#include "tmwscl/dnp/sdnpsevt.h"
+#endif
 #endif
 #include "tmwscl/dnp/sdnpo120.h"
 
@@ -81,6 +87,12 @@ void TMWDEFS_GLOBAL sdnpdata_close(
 {
 #if TMWCNFG_USE_SIMULATED_DB
   TMWTARG_UNUSED_PARAM(pHandle);
+#if TMWTARG_SUPPORT_SHM_DB
+  sdnpshm_detach(pHandle);
+#endif
+#if SDNPCNFG_USER_MANAGED_EVENTS
+  sdnpsevt_close(pHandle);
+#endif
   sdnpsim_close(pHandle);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_Close(pHandle);
@@ -392,6 +404,14 @@ void TMWDEFS_GLOBAL sdnpdata_binInRead(
 {
 #if TMWCNFG_USE_SIMULATED_DB
   TMWTYPES_BOOL value;
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_BIN_IN, &shmPoint))
+  {
+    *pFlags = shmPoint.flags;
+    return;
+  }
+#endif
   sdnpsim_binInRead(pPoint, &value, pFlags);
   *pFlags &= ~DNPDEFS_DBAS_FLAG_BINARY_ON;
   if(value) *pFlags |= DNPDEFS_DBAS_FLAG_BINARY_ON;
@@ -414,6 +434,18 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_binInChanged(
 {
 #if TMWCNFG_USE_SIMULATED_DB
   TMWTYPES_BOOL value;
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_BIN_IN, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      *pFlags = shmPoint.flags;
+    }
+    return(changed);
+  }
+#endif
   if(sdnpsim_binInChanged(pPoint, &value, pFlags))
   {
     *pFlags &= ~DNPDEFS_DBAS_FLAG_BINARY_ON;
@@ -588,6 +620,14 @@ void TMWDEFS_GLOBAL sdnpdata_binOutRead(
 {
 #if TMWCNFG_USE_SIMULATED_DB
   TMWTYPES_BOOL value;
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_BIN_OUT, &shmPoint))
+  {
+    *pFlags = shmPoint.flags;
+    return;
+  }
+#endif
   sdnpsim_binOutRead(pPoint, &value, pFlags);
   *pFlags &= ~DNPDEFS_DBAS_FLAG_BINARY_ON;
   if(value) *pFlags |= DNPDEFS_DBAS_FLAG_BINARY_ON;
@@ -609,6 +649,18 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_binOutChanged(
 {
 #if TMWCNFG_USE_SIMULATED_DB
   TMWTYPES_BOOL value;
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_BIN_OUT, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      *pFlags = shmPoint.flags;
+    }
+    return(changed);
+  }
+#endif
   if(sdnpsim_binOutChanged(pPoint, &value, pFlags))
   {
     *pFlags &= ~DNPDEFS_DBAS_FLAG_BINARY_ON;
@@ -1059,6 +1111,15 @@ void TMWDEFS_GLOBAL sdnpdata_binCntrRead(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_BIN_CNTR, &shmPoint))
+  {
+    *pValue = shmPoint.value.counter;
+    *pFlags = shmPoint.flags;
+    return;
+  }
+#endif
   sdnpsim_binCntrRead(pPoint, pValue, pFlags);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_BinCntrRead(pPoint, pValue, pFlags);
@@ -1079,6 +1140,19 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_binCntrChanged(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_BIN_CNTR, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      *pValue = shmPoint.value.counter;
+      *pFlags = shmPoint.flags;
+    }
+    return(changed);
+  }
+#endif
   return(sdnpsim_binCntrChanged(pPoint, pValue, pFlags));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(SDNPDatabaseWrapper_BinCntrChanged(pPoint, pValue, pFlags));
@@ -1297,6 +1371,16 @@ void TMWDEFS_GLOBAL sdnpdata_frznCntrRead(
   TMWDTIME *pTimeOfFreeze)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_FRZN_CNTR, &shmPoint))
+  {
+    *pValue = shmPoint.value.counter;
+    *pFlags = shmPoint.flags;
+    sdnpshm_getTime(&shmPoint, pTimeOfFreeze);
+    return;
+  }
+#endif
   sdnpsim_frznCntrRead(pPoint, pValue, pFlags, pTimeOfFreeze);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_FrznCntrRead(pPoint, pValue, pFlags, pTimeOfFreeze);
@@ -1318,6 +1402,19 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_frznCntrChanged(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_FRZN_CNTR, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      *pValue = shmPoint.value.counter;
+      *pFlags = shmPoint.flags;
+    }
+    return(changed);
+  }
+#endif
   return(sdnpsim_frznCntrChanged(pPoint, pValue, pFlags));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(SDNPDatabaseWrapper_FrznCntrChanged(pPoint, pValue, pFlags));
@@ -1506,6 +1603,14 @@ void TMWDEFS_GLOBAL sdnpdata_anlgInRead(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_ANLG_IN, &shmPoint))
+  {
+    sdnpshm_getAnalogValue(&shmPoint, pValue, pFlags);
+    return;
+  }
+#endif
   sdnpsim_anlgInRead(pPoint, pValue, pFlags);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_AnlgInRead(pPoint, pValue, pFlags);
@@ -1544,6 +1649,18 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_anlgInChanged(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_ANLG_IN, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      sdnpshm_getAnalogValue(&shmPoint, pValue, pFlags);
+    }
+    return(changed);
+  }
+#endif
   return(sdnpsim_anlgInChanged(pPoint, pValue, pFlags));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(SDNPDatabaseWrapper_AnlgInChanged(pPoint, pValue, pFlags));
@@ -1762,6 +1879,15 @@ void TMWDEFS_GLOBAL sdnpdata_frznAnlgInRead(
   TMWDTIME *pTimeOfFreeze)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_FRZN_ANLG_IN, &shmPoint))
+  {
+    sdnpshm_getAnalogValue(&shmPoint, pValue, pFlags);
+    sdnpshm_getTime(&shmPoint, pTimeOfFreeze);
+    return;
+  }
+#endif
   sdnpsim_frznAnlgInRead(pPoint, pValue, pFlags, pTimeOfFreeze);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_FrznAnlgInRead(pPoint, pValue, pFlags, pTimeOfFreeze);
@@ -1801,6 +1927,18 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_frznAnlgInChanged(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_FRZN_ANLG_IN, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      sdnpshm_getAnalogValue(&shmPoint, pValue, pFlags);
+    }
+    return(changed);
+  }
+#endif
   return(sdnpsim_frznAnlgInChanged(pPoint, pValue, pFlags));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(SDNPDatabaseWrapper_FrznAnlgInChanged(pPoint, pValue, pFlags));
@@ -2090,6 +2228,14 @@ void TMWDEFS_GLOBAL sdnpdata_anlgOutRead(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_ANLG_OUT, &shmPoint))
+  {
+    sdnpshm_getAnalogValue(&shmPoint, pValue, pFlags);
+    return;
+  }
+#endif
   sdnpsim_anlgOutRead(pPoint, pValue, pFlags);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_AnlgOutRead(pPoint, pValue, pFlags);
@@ -2110,6 +2256,18 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_anlgOutChanged(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_ANLG_OUT, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      sdnpshm_getAnalogValue(&shmPoint, pValue, pFlags);
+    }
+    return(changed);
+  }
+#endif
   return sdnpsim_anlgOutChanged(pPoint, pValue, pFlags);
 #elif TMWCNFG_USE_MANAGED_SCL
   return SDNPDatabaseWrapper_AnlgOutChanged(pPoint, pValue, pFlags);
@@ -2423,6 +2581,14 @@ void TMWDEFS_GLOBAL sdnpdata_dblInRead(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  if(sdnpshm_getPoint(pPoint, SDNPSHM_TYPE_DBL_IN, &shmPoint))
+  {
+    *pFlags = shmPoint.flags;
+    return;
+  }
+#endif
   sdnpsim_dblInRead(pPoint, pFlags);
 #elif TMWCNFG_USE_MANAGED_SCL
   SDNPDatabaseWrapper_DblInRead(pPoint, pFlags);
@@ -2442,6 +2608,18 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_dblInChanged(
   TMWTYPES_UCHAR *pFlags)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+#if TMWTARG_SUPPORT_SHM_DB
+  SDNPSHM_POINT shmPoint;
+  TMWTYPES_BOOL changed;
+  if(sdnpshm_getChangedPoint(pPoint, SDNPSHM_TYPE_DBL_IN, &changed, &shmPoint))
+  {
+    if(changed)
+    {
+      *pFlags = shmPoint.flags;
+    }
+    return(changed);
+  }
+#endif
   return(sdnpsim_dblInChanged(pPoint, pFlags));
  
 #elif TMWCNFG_USE_MANAGED_SCL
@@ -3373,6 +3551,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_umEventAdd(
   TMWDTIME *pTimeStamp)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+  SDNPSEVT_SESSION *pShared = sdnpsevt_getSession(pHandle, group);
+  if(pShared != TMWDEFS_NULL)
+    return(sdnpsevt_eventAdd(pShared, group, point, classMask, defaultVariation, flags, pValue, pTimeStamp));
   return(sdnpsim_umEventAdd(pHandle, group, point, classMask, defaultVariation, flags, pValue, pTimeStamp));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(sdnpsim_umEventAdd(pHandle, group, point, classMask, defaultVariation, flags, pValue, pTimeStamp));
@@ -3397,6 +3578,9 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL sdnpdata_umEventNotSentCount(
   TMWDEFS_CLASS_MASK classMask)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+  SDNPSEVT_SESSION *pShared = sdnpsevt_getSession(pHandle, group);
+  if(pShared != TMWDEFS_NULL)
+    return(sdnpsevt_eventNotSentCount(pShared, group, classMask));
   return(sdnpsim_umEventNotSentCount(pHandle, group, classMask));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(sdnpsim_umEventNotSentCount(pHandle, group, classMask));
@@ -3418,6 +3602,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_umEventGet(
   SDNPDATA_GET_EVENT *pEvent)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+  SDNPSEVT_SESSION *pShared = sdnpsevt_getSession(pHandle, group);
+  if(pShared != TMWDEFS_NULL)
+    return(sdnpsevt_eventGet(pShared, group, classMask, firstEvent, pEvent));
   return(sdnpsim_umEventGet(pHandle, group, classMask, firstEvent, pEvent));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(sdnpsim_umEventGet(pHandle, group, classMask, firstEvent, pEvent));
@@ -3439,7 +3626,11 @@ void TMWDEFS_GLOBAL sdnpdata_umEventSent(
   TMWTYPES_USHORT point)
 {
 #if TMWCNFG_USE_SIMULATED_DB
-  sdnpsim_umEventSent(pHandle, group, point);
+  SDNPSEVT_SESSION *pShared = sdnpsevt_getSession(pHandle, group);
+  if(pShared != TMWDEFS_NULL)
+    sdnpsevt_eventSent(pShared, group, point);
+  else
+    sdnpsim_umEventSent(pHandle, group, point);
 #elif TMWCNFG_USE_MANAGED_SCL
   sdnpsim_umEventSent(pHandle, group, point);
 #else
@@ -3456,6 +3647,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_umEventNotSent(
   TMWTYPES_UCHAR group)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+  SDNPSEVT_SESSION *pShared = sdnpsevt_getSession(pHandle, group);
+  if(pShared != TMWDEFS_NULL)
+    return(sdnpsevt_eventNotSent(pShared, group));
   return(sdnpsim_umEventNotSent(pHandle, group));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(sdnpsim_umEventNotSent(pHandle, group));
@@ -3473,6 +3667,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpdata_umEventRemove(
   TMWTYPES_UCHAR group)
 {
 #if TMWCNFG_USE_SIMULATED_DB
+  SDNPSEVT_SESSION *pShared = sdnpsevt_getSession(pHandle, group);
+  if(pShared != TMWDEFS_NULL)
+    return(sdnpsevt_eventRemove(pShared, group));
   return(sdnpsim_umEventRemove(pHandle, group));
 #elif TMWCNFG_USE_MANAGED_SCL
   return(sdnpsim_umEventRemove(pHandle, group));
@@ -420,7 +420,9 @@
    SDNPDATA_SUPPORT_OBJ50_V3)
 
 /* File Transfer */
+#ifndef SDNPDATA_SUPPORT_OBJ70
 #define SDNPDATA_SUPPORT_OBJ70    SDNPDATA_CNFG_LEVEL_TMW
+#endif
 
 /* Read IIN bit support */
 #define SDNPDATA_SUPPORT_OBJ80_READ SDNPDATA_CNFG_LEVEL3
@@ -1457,6 +1459,12 @@ extern "C" {
    *     is otherwise incapable of performing the request.
    *    DNPDEFS_CROB_ST_UNDEFINED - the request not accepted because of some 
    *     other undefined reason
+   *    DNPDEFS_CROB_ST_ASYNC - the control has been accepted and will
+   *     complete later, for example on a worker thread talking to slow
+   *     field I/O. The result must then be reported by calling
+   *     sdnpsesn_controlComplete with group 12 and the point number. The
+   *     operate response is held until then, but the channel is not. It
+   *     may also be reported before this function returns.
    */
   DNPDEFS_CROB_ST TMWDEFS_GLOBAL sdnpdata_binOutOperate(
     void *pPoint,
@@ -3284,6 +3292,10 @@ extern "C" {
    *     is otherwise incapable of performing the request.
    *    DNPDEFS_CTLSTAT_UNDEFINED - the request not accepted because of some 
    *     other undefined reason
+   *    DNPDEFS_CTLSTAT_ASYNC - the control has been accepted and will
+   *     complete later. The result must then be reported by calling
+   *     sdnpsesn_controlComplete with group 41 and the point number. It
+   *     may also be reported before this function returns.
    */
   DNPDEFS_CTLSTAT TMWDEFS_GLOBAL sdnpdata_anlgOutOperate(
     void *pPoint,
@@ -111,6 +111,8 @@ static const DNPDIAG_ERROR_ENTRY sdnpDiagErrorMsg[] = {
   {SDNPDIAG_AUTH_USEREXPIRED  ,  "Secure Authentication, User Role has expired" },
   {SDNPDIAG_AUTH_BADSIGNATURE ,  "Secure Authentication, Signature not verified" },
   {SDNPDIAG_CUSTOM1           ,  "Transmitting now" },
+  {SDNPDIAG_ASYNC_CTRL_TIMEOUT,  "Asynchronous control did not complete in time" },
+  {SDNPDIAG_ASYNC_CTRL_DISCARD,  "New request received, operate response waiting for controls discarded" },
 
 
   {SDNPDIAG_ERROR_ENUM_MAX    ,  ""}
@@ -105,6 +105,8 @@ typedef enum {
   SDNPDIAG_AUTH_USEREXPIRED,
   SDNPDIAG_AUTH_BADSIGNATURE,
   SDNPDIAG_CUSTOM1,
+  SDNPDIAG_ASYNC_CTRL_TIMEOUT,
+  SDNPDIAG_ASYNC_CTRL_DISCARD,
 
   /* This must be last entry */
   SDNPDIAG_ERROR_ENUM_MAX
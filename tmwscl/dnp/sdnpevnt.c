@@ -39,11 +39,33 @@
 #include "tmwscl/dnp/sdnpo088.h"
 #include "tmwscl/dnp/sdnpo115.h"
 #include "tmwscl/dnp/sdnpo120.h"
+#include "tmwscl/dnp/sdnpjrnl.h"
 #include "tmwscl/dnp/dnpstat.h"
 #include "tmwscl/dnp/dnpdtime.h"
 
 #include "tmwscl/utils/tmwtarg.h"
 
+#if TMWCNFG_SUPPORT_METRICS
+/* function: _eventsQueued
+ * purpose: Get the metrics gauge counting the queued events of a class
+ * arguments:
+ *  pSession - session the event is queued on
+ *  classMask - class of the event
+ * returns:
+ *  pointer to the gauge
+ */
+static TMWTYPES_ULONG * TMWDEFS_LOCAL _eventsQueued(
+  TMWSESN *pSession,
+  TMWDEFS_CLASS_MASK classMask)
+{
+  if(classMask & TMWDEFS_CLASS_MASK_ONE)
+    return(&pSession->metrics.eventsQueued[0]);
+  if(classMask & TMWDEFS_CLASS_MASK_TWO)
+    return(&pSession->metrics.eventsQueued[1]);
+  return(&pSession->metrics.eventsQueued[2]);
+}
+#endif
+
 /* function: sdnpevnt_init */
 void TMWDEFS_GLOBAL sdnpevnt_init(
   TMWTIMER *pTimer,
@@ -184,6 +206,12 @@ static SDNPEVNT * TMWDEFS_LOCAL _removeCorrectEvent(
   
   /* remove old event from queue, but keep the memory to be reused */
   tmwdlist_removeEntry(pDesc->pEventList, (TMWDLIST_MEMBER *)pOldEvent);
+#if TMWCNFG_SUPPORT_METRICS
+  TMWMETR_DEC(*_eventsQueued(pDesc->pSession, pOldEvent->classMask));
+#endif
+#if TMWTARG_SUPPORT_JOURNAL
+  sdnpjrnl_eventRemoved(pDesc->pSession, pDesc->group, pOldEvent, SDNPJRNL_REMOVED_OVERFLOW);
+#endif
 
   sdnpunsl_removeEvent(pSDNPSession, pOldEvent);
 
@@ -317,7 +345,6 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_addEvent(
 {
   TMWDEFS_EVENT_MODE eventMode;
   SDNPEVNT *pEvent = TMWDEFS_NULL;
-  SDNPEVNT *pOldEvent;
 
   /* If no class is specified, return failure, or else this event
    * will never get read from event queue 
@@ -377,6 +404,12 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_addEvent(
       {
         /* Yep, remove it, but keep the memory to be reused below */
         tmwdlist_removeEntry(pDesc->pEventList, (TMWDLIST_MEMBER *)pEvent);
+#if TMWCNFG_SUPPORT_METRICS
+        TMWMETR_DEC(*_eventsQueued(pSession, pEvent->classMask));
+#endif
+#if TMWTARG_SUPPORT_JOURNAL
+        sdnpjrnl_eventRemoved(pSession, pDesc->group, pEvent, SDNPJRNL_REMOVED_REPLACED);
+#endif
 
         sdnpunsl_removeEvent((SDNPSESN*)pSession, pEvent);
        
@@ -420,7 +453,12 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_addEvent(
    * or we could not allocate memory.
    */
   if(pEvent == TMWDEFS_NULL)
+  {
+#if TMWTARG_SUPPORT_JOURNAL
+    sdnpjrnl_eventDiscarded(pSession, pDesc->group, point, flags, pValue);
+#endif
     return(TMWDEFS_FALSE);
+  }
 
   /* Initialize new event */
   pEvent->point = point;
@@ -449,7 +487,25 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_addEvent(
   }
 
   /* Add event to queue in timeStamp order */
-  pOldEvent = (SDNPEVNT *)tmwdlist_getLast(pDesc->pEventList);
+  sdnpevnt_insertEvent(pSession, pDesc->pEventList, pEvent);
+#if TMWTARG_SUPPORT_JOURNAL
+  sdnpjrnl_eventAdded(pSession, pDesc->group, pEvent);
+#endif
+
+  /* If successful, update event status */
+  sdnpevnt_updateEvents(pSession, classMask);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpevnt_insertEvent */
+void TMWDEFS_GLOBAL sdnpevnt_insertEvent(
+  TMWSESN *pSession,
+  TMWDLIST *pEventList,
+  SDNPEVNT *pEvent)
+{
+  SDNPEVNT *pOldEvent;
+
+  pOldEvent = (SDNPEVNT *)tmwdlist_getLast(pEventList);
   if(pOldEvent != TMWDEFS_NULL)
   {
     /* If new event is newer than last event in queue, put at end of queue
@@ -462,7 +518,7 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_addEvent(
     } 
     else
     {
-      pOldEvent = (SDNPEVNT *)tmwdlist_getFirst(pDesc->pEventList);
+      pOldEvent = (SDNPEVNT *)tmwdlist_getFirst(pEventList);
       while(pOldEvent != TMWDEFS_NULL)
       {
         if(!tmwdtime_checkTimeOrder(&pOldEvent->timeStamp, &pEvent->timeStamp))
@@ -477,18 +533,34 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_addEvent(
   if(pOldEvent == TMWDEFS_NULL)
   {
     /* Yes, insert at end of queue */
-    tmwdlist_addEntry(pDesc->pEventList, (TMWDLIST_MEMBER *)pEvent);
+    tmwdlist_addEntry(pEventList, (TMWDLIST_MEMBER *)pEvent);
   }
   else
   {
     /* No, insert before next event entry */
-    tmwdlist_insertEntryBefore(pDesc->pEventList,
+    tmwdlist_insertEntryBefore(pEventList,
       (TMWDLIST_MEMBER *)pOldEvent, (TMWDLIST_MEMBER *)pEvent);
   }
+#if TMWCNFG_SUPPORT_METRICS
+  TMWMETR_INC(*_eventsQueued(pSession, pEvent->classMask));
+#else
+  TMWTARG_UNUSED_PARAM(pSession);
+#endif
+}
 
-  /* If successful, update event status */
-  sdnpevnt_updateEvents(pSession, classMask);
-  return(TMWDEFS_TRUE);
+/* function: sdnpevnt_deleteEvent */
+void TMWDEFS_GLOBAL sdnpevnt_deleteEvent(
+  TMWSESN *pSession,
+  TMWDLIST *pEventList,
+  SDNPEVNT *pEvent)
+{
+  tmwdlist_removeEntry(pEventList, (TMWDLIST_MEMBER *)pEvent);
+#if TMWCNFG_SUPPORT_METRICS
+  TMWMETR_DEC(*_eventsQueued(pSession, pEvent->classMask));
+#else
+  TMWTARG_UNUSED_PARAM(pSession);
+#endif
+  sdnpmem_free(pEvent);
 }
 
 /* function: sdnpevnt_updateEvents */
@@ -584,9 +656,11 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpevnt_cleanupEvents(
       if(deleteEvents)
       {
         DNPSTAT_SESN_EVENT_CONFIRM(pDesc->pSession, pDesc->group, pEvent->point);
+#if TMWTARG_SUPPORT_JOURNAL
+        sdnpjrnl_eventRemoved(pDesc->pSession, pDesc->group, pEvent, SDNPJRNL_REMOVED_CONFIRMED);
+#endif
 
-        tmwdlist_removeEntry(pDesc->pEventList, (TMWDLIST_MEMBER *)pEvent);
-        sdnpmem_free(pEvent);
+        sdnpevnt_deleteEvent(pDesc->pSession, pDesc->pEventList, pEvent);
       }
       else
       {
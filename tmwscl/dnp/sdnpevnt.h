@@ -53,6 +53,9 @@ typedef struct SDNPEventStruct {
   TMWDTIME timeStamp;
   TMWTYPES_BOOL getCurrentValue; /* for analog inputs only */
   TMWTYPES_BOOL eventSent;
+#if TMWTARG_SUPPORT_JOURNAL
+  TMWTYPES_ULONG journalId; /* identifies the event in the journal, see sdnpjrnl.h */
+#endif
 } SDNPEVNT;
 
 /* Structure used to store binary input events */
@@ -276,6 +279,18 @@ extern "C" {
     SDNPEVNT_DESC *pDesc,
     SDNPDATA_ADD_EVENT_VALUE *pValue);
   
+  /* function: sdnpevnt_insertEvent */
+  void TMWDEFS_GLOBAL sdnpevnt_insertEvent(
+    TMWSESN *pSession,
+    TMWDLIST *pEventList,
+    SDNPEVNT *pEvent);
+
+  /* function: sdnpevnt_deleteEvent */
+  void TMWDEFS_GLOBAL sdnpevnt_deleteEvent(
+    TMWSESN *pSession,
+    TMWDLIST *pEventList,
+    SDNPEVNT *pEvent);
+
   /* function: sdnpevnt_updateEvents */
   void TMWDEFS_GLOBAL sdnpevnt_updateEvents(
     TMWSESN *pSession,
@@ -126,14 +126,8 @@ void TMWDEFS_GLOBAL sdnpfsim_initDb(
   pFDBHandle->fileEventClass = TMWDEFS_CLASS_MASK_THREE;
 
 #if SDNPDATA_SUPPORT_XML
-  memset(pFDBHandle->xmlStaticDescriptionBuf,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
-  pFDBHandle->xmlStaticDescriptionBufLen = 0;
-  pFDBHandle->xmlStaticDescriptionBufIndex = 0;
-#endif
-
-#if SDNPDATA_SUPPORT_XML_STATIC
-  pFDBHandle->xmlStaticDescriptionBufOpen = TMWDEFS_FALSE;
-  pFDBHandle->xmlStaticDescriptionBufState = SDNPXML_SAVE_NOT_DONE;
+  pFDBHandle->xmlStaticDescriptionOpen = TMWDEFS_FALSE;
+  pFDBHandle->xmlStaticDescriptionState = SDNPXML_SAVE_NOT_DONE;
 #endif
 
   pFDBHandle->fileTestingMode = TMWSIM_TESTINGMODE_SUCCESS;
@@ -286,7 +280,8 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnpfsim_readFileInfo(
       pFDBHandle->fileDelayCount = 0;
   }
 
-  if(pFDBHandle->bInternalDriveInfo == TMWDEFS_TRUE)
+  if((pFDBHandle->bInternalDriveInfo == TMWDEFS_TRUE)
+    && (dnpFileHandle == SDNPFSIM_HANDLE))
   { 
     /* If SCL supports new shema, return that one */
     if(strstr(pFDBHandle->findFilename, DEVICE_PROFILE_XML2_FILE)!=0)
@@ -486,7 +481,8 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnpfsim_openFile(
       return(DNPDEFS_FILE_CMD_STAT_NOT_FOUND);
     }
     sdnpxml_saveDatabaseStaticInit(pSession);
-    pFDBHandle->xmlStaticDescriptionBufOpen = TMWDEFS_TRUE;  
+    pFDBHandle->xmlStaticDescriptionState = SDNPXML_SAVE_NOT_DONE;
+    pFDBHandle->xmlStaticDescriptionOpen = TMWDEFS_TRUE;  
 
     *pFileHandle = SDNPFSIM_HANDLE;
     *pType = DNPDEFS_FILE_TYPE_SIMPLE;
@@ -595,24 +591,18 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnpfsim_closeFile(
   }
 
 #if SDNPDATA_SUPPORT_XML
-  if(pFDBHandle->xmlStaticDescriptionBufOpen == TMWDEFS_TRUE)
+  if((pFDBHandle->xmlStaticDescriptionOpen == TMWDEFS_TRUE)
+    && (fileHandle == SDNPFSIM_HANDLE))
   {
-    /* Validate file state */
-    if(fileHandle != SDNPFSIM_HANDLE)
-      return(DNPDEFS_FILE_CMD_STAT_INV_HANDLE);
-    
-    memset(pFDBHandle->xmlStaticDescriptionBuf,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
-    pFDBHandle->xmlStaticDescriptionBufLen = 0;
-    pFDBHandle->xmlStaticDescriptionBufIndex = 0;
-    pFDBHandle->xmlStaticDescriptionBufState = SDNPXML_SAVE_NOT_DONE;
-    pFDBHandle->xmlStaticDescriptionBufOpen = TMWDEFS_FALSE;
+    pFDBHandle->xmlStaticDescriptionState = SDNPXML_SAVE_NOT_DONE;
+    pFDBHandle->xmlStaticDescriptionOpen = TMWDEFS_FALSE;
 
     /* Return success */
     return(DNPDEFS_FILE_CMD_STAT_SUCCESS);
   }
   else
 #endif
-  if (pFDBHandle->bInternalDriveInfo)
+  if ((pFDBHandle->bInternalDriveInfo) && (fileHandle == SDNPFSIM_HANDLE))
   { /* close for directory */
     pFDBHandle->bInternalDriveInfo = TMWDEFS_FALSE;
     return(DNPDEFS_FILE_CMD_STAT_SUCCESS);
@@ -659,61 +649,23 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnpfsim_readFile(
   }
   
 #if SDNPDATA_SUPPORT_XML
-  /* If this pointer is not NULL XML description "file" has been opened
-   * and xml description has been generated.
+  /* If the XML description "file" has been opened generate the next
+   * part of the description straight into the caller's block.
    */ 
-  if(pFDBHandle->xmlStaticDescriptionBufOpen == TMWDEFS_TRUE)
+  if((pFDBHandle->xmlStaticDescriptionOpen == TMWDEFS_TRUE)
+    && (fileHandle == SDNPFSIM_HANDLE))
   {
-    TMWTYPES_UINT memCpyLen;
+    TMWTYPES_ULONG length = 0;
 
-    /* Validate file state against request */
-    if(fileHandle != SDNPFSIM_HANDLE)
-      return(DNPDEFS_FILE_TFER_STAT_INV_HANDLE);
-
-    do 
+    if(pFDBHandle->xmlStaticDescriptionState != SDNPXML_SAVE_DONE)
     {
-      if (pFDBHandle->xmlStaticDescriptionBufLen == 0)
-      { 
-        pFDBHandle->xmlStaticDescriptionBufState = sdnpxml_saveDatabaseStatic(pSession, pFDBHandle->xmlStaticDescriptionBuf, SDNPCNFG_XML_SAVE_BUF_SIZE, &pFDBHandle->xmlStaticDescriptionBufLen);  
-        if(pFDBHandle->xmlStaticDescriptionBufState == SDNPXML_SAVE_FAILED)
-          return(DNPDEFS_FILE_TFER_STAT_MISC);
-      }
-
-      if((pFDBHandle->xmlStaticDescriptionBufIndex + pFDBHandle->blockSize) <= pFDBHandle->xmlStaticDescriptionBufLen)
-      {
-        memCpyLen = pFDBHandle->blockSize;
-        *pLast = TMWDEFS_FALSE;
-      }
-      else
-      {
-        memCpyLen = pFDBHandle->xmlStaticDescriptionBufLen - pFDBHandle->xmlStaticDescriptionBufIndex;
-        if (pFDBHandle->xmlStaticDescriptionBufState == SDNPXML_SAVE_DONE)
-        {
-          *pLast = TMWDEFS_TRUE;
-        }
-        else
-        {
-          *pLast = TMWDEFS_FALSE;
-        }
-      }
-      if (memCpyLen == 0)
-      {
-        pFDBHandle->xmlStaticDescriptionBufIndex = 0;
-        pFDBHandle->xmlStaticDescriptionBufLen = 0;
-        memset(pFDBHandle->xmlStaticDescriptionBuf,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
-      }
+      pFDBHandle->xmlStaticDescriptionState = sdnpxml_saveDatabaseStatic(pSession, (TMWTYPES_CHAR *)pBuf, pFDBHandle->blockSize, &length);
+      if(pFDBHandle->xmlStaticDescriptionState == SDNPXML_SAVE_FAILED)
+        return(DNPDEFS_FILE_TFER_STAT_MISC);
     }
-    while(memCpyLen == 0);
 
-    memcpy(pBuf, &pFDBHandle->xmlStaticDescriptionBuf[pFDBHandle->xmlStaticDescriptionBufIndex], memCpyLen);
-    pFDBHandle->xmlStaticDescriptionBufIndex += memCpyLen;
-    if (memCpyLen < pFDBHandle->blockSize)
-    {
-      pFDBHandle->xmlStaticDescriptionBufIndex = 0;
-      pFDBHandle->xmlStaticDescriptionBufLen = 0;
-      memset(pFDBHandle->xmlStaticDescriptionBuf,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
-    }
-    *pBytesRead = (TMWTYPES_USHORT)memCpyLen;
+    *pLast = (TMWTYPES_BOOL)(pFDBHandle->xmlStaticDescriptionState == SDNPXML_SAVE_DONE);
+    *pBytesRead = (TMWTYPES_USHORT)length;
   }
 #endif
   else
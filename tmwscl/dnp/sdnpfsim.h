@@ -43,7 +43,10 @@
 #if SDNPDATA_SUPPORT_OBJ70
 
 #if TMWCNFG_USE_SIMULATED_DB
-#define SDNPFSIM_HANDLE 0x12345678
+/* Handle of the simulated files, kept out of the range of sdnptarg
+ * handles since real files can be open on the session at the same time
+ */
+#define SDNPFSIM_HANDLE 0x12340000
 #define SDNPSIM_FILE_AUTH_SIZE          32
 
 
@@ -71,13 +74,9 @@ typedef struct SDNPFSimDatabaseStruct {
   TMWTYPES_CHAR      filePassword[SDNPSIM_FILE_AUTH_SIZE];
 
 #if SDNPDATA_SUPPORT_XML 
-  TMWTYPES_ULONG      xmlStaticDescriptionBufLen;
-  TMWTYPES_ULONG      xmlStaticDescriptionBufIndex;
-  TMWTYPES_BOOL       xmlStaticDescriptionBufOpen;
-  SDNPXML_SAVE_STATE  xmlStaticDescriptionBufState;
-
-  /* SPM, figure out how to use the one in the scl */
-  TMWTYPES_CHAR       xmlStaticDescriptionBuf[SDNPCNFG_XML_SAVE_BUF_SIZE];
+  /* The description is generated straight into each block that is read */
+  TMWTYPES_BOOL       xmlStaticDescriptionOpen;
+  SDNPXML_SAVE_STATE  xmlStaticDescriptionState;
 #endif
 } SDNPFSIM_DATABASE;
 
@@ -0,0 +1,1546 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+
+/* file: sdnpjrnl.c
+ * description: Journal of the DNP slave event queues and point values.
+ *  See sdnpjrnl.h.
+ *
+ *  The file starts with an 8 byte header, the magic number and version,
+ *  followed by records. Each record is a 2 byte length, a 1 byte type,
+ *  the body and a 4 byte CRC of the type and body. The length counts the
+ *  type and body. All values are stored least significant byte first.
+ */
+#include "tmwscl/dnp/sdnpjrnl.h"
+
+#if TMWTARG_SUPPORT_JOURNAL
+#include "tmwscl/utils/tmwdiag.h"
+#include "tmwscl/utils/tmwdlist.h"
+#include "tmwscl/dnp/dnpdefs.h"
+#include "tmwscl/dnp/dnpdtime.h"
+#include "tmwscl/dnp/dnputil.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpsesp.h"
+#include "tmwscl/dnp/sdnpdata.h"
+#include "tmwscl/dnp/sdnpmem.h"
+#include "tmwscl/dnp/sdnptarg.h"
+#if TMWCNFG_USE_SIMULATED_DB
+#include "tmwscl/utils/tmwsim.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#endif
+
+#define SDNPJRNL_MAGIC            0x4a574d54UL  /* "TMWJ" */
+#define SDNPJRNL_VERSION          1
+#define SDNPJRNL_HEADER_SIZE      8
+
+/* Record types */
+#define SDNPJRNL_RECORD_STATE     1  /* sequence number and overflow */
+#define SDNPJRNL_RECORD_POINT     2  /* value of a static point */
+#define SDNPJRNL_RECORD_ADD       3  /* event added to a queue */
+#define SDNPJRNL_RECORD_REMOVE    4  /* event removed from a queue */
+
+/* Length, type and CRC */
+#define SDNPJRNL_RECORD_OVERHEAD  7
+
+/* Fixed part of an added event and of an encoded analog value */
+#define SDNPJRNL_EVENT_SIZE       19
+#define SDNPJRNL_ANALOG_SIZE      13
+
+#define SDNPJRNL_MAX_RECORD \
+  (SDNPJRNL_RECORD_OVERHEAD + SDNPJRNL_EVENT_SIZE + 2 + DNPCNFG_MAX_EXT_STRING_LENGTH)
+
+/* Default number of bytes appended before a new checkpoint */
+#define SDNPJRNL_DEFAULT_CHECKPOINT_SIZE 1048576UL
+
+/* Size of the first checkpoint buffer, it is doubled as needed */
+#define SDNPJRNL_INITIAL_BUFFER   4096
+
+/* Checkpoint being built */
+typedef struct SDNPJrnlBufferStruct {
+  TMWTYPES_UCHAR *pBuf;
+  TMWTYPES_ULONG  length;
+  TMWTYPES_ULONG  size;
+  TMWTYPES_BOOL   failed;
+} SDNPJRNL_BUFFER;
+
+/* Event groups that are journaled, in the order they are checkpointed */
+static const TMWTYPES_UCHAR _eventGroups[] = {
+  DNPDEFS_OBJ_2_BIN_CHNG_EVENTS,
+  DNPDEFS_OBJ_4_DBL_CHNG_EVENTS,
+  DNPDEFS_OBJ_11_BIN_OUT_EVENTS,
+  DNPDEFS_OBJ_13_BIN_CMD_EVENTS,
+  DNPDEFS_OBJ_22_CNTR_EVENTS,
+  DNPDEFS_OBJ_23_FCTR_EVENTS,
+  DNPDEFS_OBJ_32_ANA_CHNG_EVENTS,
+  DNPDEFS_OBJ_33_FRZN_ANA_EVENTS,
+  DNPDEFS_OBJ_42_ANA_OUT_EVENTS,
+  DNPDEFS_OBJ_43_ANA_CMD_EVENTS,
+  DNPDEFS_OBJ_111_STRING_EVENTS,
+  DNPDEFS_OBJ_113_VTERM_EVENTS,
+  DNPDEFS_OBJ_115_EXT_STR_EVENTS
+};
+
+/* function: _crc32
+ *  CRC-32 as used by Ethernet and zip
+ */
+static TMWTYPES_ULONG TMWDEFS_LOCAL _crc32(
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  TMWTYPES_ULONG crc = 0xffffffffUL;
+  int bit;
+
+  while(length-- > 0)
+  {
+    crc ^= *pData++;
+    for(bit = 0; bit < 8; bit++)
+      crc = (crc >> 1) ^ (0xedb88320UL & (0UL - (crc & 1)));
+  }
+  return(crc ^ 0xffffffffUL);
+}
+
+/* function: _getJournal */
+static SDNPJRNL * TMWDEFS_LOCAL _getJournal(
+  TMWSESN *pSession)
+{
+  return((SDNPJRNL *)((SDNPSESN *)pSession)->pJournal);
+}
+
+/* function: _getQueue
+ *  Get the queue and configuration for an event group, returns
+ *  TMWDEFS_FALSE if the group is not journaled
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _getQueue(
+  SDNPSESN *pSDNPSession,
+  TMWTYPES_UCHAR group,
+  TMWDLIST **ppEventList,
+  TMWTYPES_USHORT *pMaxEvents,
+  SDNPMEM_ALLOC_TYPE *pMemType)
+{
+  switch(group)
+  {
+#if SDNPDATA_SUPPORT_OBJ2
+  case DNPDEFS_OBJ_2_BIN_CHNG_EVENTS:
+    *ppEventList = &pSDNPSession->obj2Events;
+    *pMaxEvents = pSDNPSession->binaryInputMaxEvents;
+    *pMemType = SDNPMEM_OBJECT2_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ4
+  case DNPDEFS_OBJ_4_DBL_CHNG_EVENTS:
+    *ppEventList = &pSDNPSession->obj4Events;
+    *pMaxEvents = pSDNPSession->doubleInputMaxEvents;
+    *pMemType = SDNPMEM_OBJECT4_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ11
+  case DNPDEFS_OBJ_11_BIN_OUT_EVENTS:
+    *ppEventList = &pSDNPSession->obj11Events;
+    *pMaxEvents = pSDNPSession->binaryOutputMaxEvents;
+    *pMemType = SDNPMEM_OBJECT11_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ13
+  case DNPDEFS_OBJ_13_BIN_CMD_EVENTS:
+    *ppEventList = &pSDNPSession->obj13Events;
+    *pMaxEvents = pSDNPSession->binaryOutCmdMaxEvents;
+    *pMemType = SDNPMEM_OBJECT13_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ22
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+    *ppEventList = &pSDNPSession->obj22Events;
+    *pMaxEvents = pSDNPSession->binaryCounterMaxEvents;
+    *pMemType = SDNPMEM_OBJECT22_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ23
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    *ppEventList = &pSDNPSession->obj23Events;
+    *pMaxEvents = pSDNPSession->frozenCounterMaxEvents;
+    *pMemType = SDNPMEM_OBJECT23_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ32
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+    *ppEventList = &pSDNPSession->obj32Events;
+    *pMaxEvents = pSDNPSession->analogInputMaxEvents;
+    *pMemType = SDNPMEM_OBJECT32_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ33
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+    *ppEventList = &pSDNPSession->obj33Events;
+    *pMaxEvents = pSDNPSession->frozenAnalogInMaxEvents;
+    *pMemType = SDNPMEM_OBJECT33_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ42
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+    *ppEventList = &pSDNPSession->obj42Events;
+    *pMaxEvents = pSDNPSession->analogOutputMaxEvents;
+    *pMemType = SDNPMEM_OBJECT42_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ43
+  case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+    *ppEventList = &pSDNPSession->obj43Events;
+    *pMaxEvents = pSDNPSession->analogOutCmdMaxEvents;
+    *pMemType = SDNPMEM_OBJECT43_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ111
+  case DNPDEFS_OBJ_111_STRING_EVENTS:
+    *ppEventList = &pSDNPSession->obj111Events;
+    *pMaxEvents = pSDNPSession->stringMaxEvents;
+    *pMemType = SDNPMEM_OBJECT111_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ113
+  case DNPDEFS_OBJ_113_VTERM_EVENTS:
+    *ppEventList = &pSDNPSession->obj113Events;
+    *pMaxEvents = pSDNPSession->virtualTerminalMaxEvents;
+    *pMemType = SDNPMEM_OBJECT113_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+#if SDNPDATA_SUPPORT_OBJ115
+  case DNPDEFS_OBJ_115_EXT_STR_EVENTS:
+    *ppEventList = &pSDNPSession->obj115Events;
+    *pMaxEvents = pSDNPSession->extStringMaxEvents;
+    *pMemType = SDNPMEM_OBJECT115_EVENT_TYPE;
+    return(TMWDEFS_TRUE);
+#endif
+  default:
+    TMWTARG_UNUSED_PARAM(pSDNPSession);
+    TMWTARG_UNUSED_PARAM(ppEventList);
+    TMWTARG_UNUSED_PARAM(pMaxEvents);
+    TMWTARG_UNUSED_PARAM(pMemType);
+    return(TMWDEFS_FALSE);
+  }
+}
+
+/* function: _writeAnalog
+ *  Encode an analog value in SDNPJRNL_ANALOG_SIZE bytes: the type, an 8
+ *  byte value and the 4 byte integer of the scaled types
+ */
+static void TMWDEFS_LOCAL _writeAnalog(
+  TMWTYPES_UCHAR *pBuf,
+  const TMWTYPES_ANALOG_VALUE *pValue)
+{
+  TMWTYPES_ULONG ulValue;
+
+  memset(pBuf, 0, SDNPJRNL_ANALOG_SIZE);
+  pBuf[0] = (TMWTYPES_UCHAR)pValue->type;
+  switch(pValue->type)
+  {
+  case TMWTYPES_ANALOG_TYPE_SHORT:
+    ulValue = (TMWTYPES_ULONG)(TMWTYPES_LONG)pValue->value.sval;
+    tmwtarg_store32(&ulValue, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_USHORT:
+    ulValue = pValue->value.usval;
+    tmwtarg_store32(&ulValue, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_LONG:
+    ulValue = (TMWTYPES_ULONG)pValue->value.lval;
+    tmwtarg_store32(&ulValue, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_ULONG:
+    tmwtarg_store32(&pValue->value.ulval, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_CHAR:
+    ulValue = (TMWTYPES_ULONG)(TMWTYPES_LONG)pValue->value.cval;
+    tmwtarg_store32(&ulValue, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_UCHAR:
+    ulValue = pValue->value.ucval;
+    tmwtarg_store32(&ulValue, pBuf + 1);
+    break;
+#if TMWCNFG_SUPPORT_FLOAT
+  case TMWTYPES_ANALOG_TYPE_SFLOAT:
+    tmwtarg_storeSFloat(&pValue->value.fval, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_SCALED:
+    tmwtarg_storeSFloat(&pValue->value.scaled.fval, pBuf + 1);
+    ulValue = (TMWTYPES_ULONG)pValue->value.scaled.lval;
+    tmwtarg_store32(&ulValue, pBuf + 9);
+    break;
+#endif
+#if TMWCNFG_SUPPORT_DOUBLE
+  case TMWTYPES_ANALOG_TYPE_DOUBLE:
+    tmwtarg_store64(&pValue->value.dval, pBuf + 1);
+    break;
+  case TMWTYPES_ANALOG_TYPE_DSCALED:
+    tmwtarg_store64(&pValue->value.dscaled.dval, pBuf + 1);
+    ulValue = (TMWTYPES_ULONG)pValue->value.dscaled.lval;
+    tmwtarg_store32(&ulValue, pBuf + 9);
+    break;
+#endif
+  default:
+    {
+      /* Other types are kept as an integer */
+      TMWTYPES_UCHAR flags;
+      pBuf[0] = (TMWTYPES_UCHAR)TMWTYPES_ANALOG_TYPE_LONG;
+      ulValue = (TMWTYPES_ULONG)dnputil_getAnalogValueLong((TMWTYPES_ANALOG_VALUE *)pValue, &flags);
+      tmwtarg_store32(&ulValue, pBuf + 1);
+    }
+    break;
+  }
+}
+
+/* function: _readAnalog
+ *  Decode an analog value written by _writeAnalog
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _readAnalog(
+  const TMWTYPES_UCHAR *pBuf,
+  TMWTYPES_ANALOG_VALUE *pValue)
+{
+  TMWTYPES_ULONG ulValue;
+
+  memset(pValue, 0, sizeof(TMWTYPES_ANALOG_VALUE));
+  pValue->type = (TMWTYPES_ANALOG_TYPE)pBuf[0];
+  tmwtarg_get32(pBuf + 1, &ulValue);
+  switch(pValue->type)
+  {
+  case TMWTYPES_ANALOG_TYPE_SHORT:
+    pValue->value.sval = (TMWTYPES_SHORT)(TMWTYPES_LONG)ulValue;
+    break;
+  case TMWTYPES_ANALOG_TYPE_USHORT:
+    pValue->value.usval = (TMWTYPES_USHORT)ulValue;
+    break;
+  case TMWTYPES_ANALOG_TYPE_LONG:
+    pValue->value.lval = (TMWTYPES_LONG)ulValue;
+    break;
+  case TMWTYPES_ANALOG_TYPE_ULONG:
+    pValue->value.ulval = ulValue;
+    break;
+  case TMWTYPES_ANALOG_TYPE_CHAR:
+    pValue->value.cval = (TMWTYPES_CHAR)(TMWTYPES_LONG)ulValue;
+    break;
+  case TMWTYPES_ANALOG_TYPE_UCHAR:
+    pValue->value.ucval = (TMWTYPES_UCHAR)ulValue;
+    break;
+#if TMWCNFG_SUPPORT_FLOAT
+  case TMWTYPES_ANALOG_TYPE_SFLOAT:
+    tmwtarg_getSFloat(pBuf + 1, &pValue->value.fval);
+    break;
+  case TMWTYPES_ANALOG_TYPE_SCALED:
+    tmwtarg_getSFloat(pBuf + 1, &pValue->value.scaled.fval);
+    tmwtarg_get32(pBuf + 9, &ulValue);
+    pValue->value.scaled.lval = (TMWTYPES_LONG)ulValue;
+    break;
+#endif
+#if TMWCNFG_SUPPORT_DOUBLE
+  case TMWTYPES_ANALOG_TYPE_DOUBLE:
+    tmwtarg_get64(pBuf + 1, &pValue->value.dval);
+    break;
+  case TMWTYPES_ANALOG_TYPE_DSCALED:
+    tmwtarg_get64(pBuf + 1, &pValue->value.dscaled.dval);
+    tmwtarg_get32(pBuf + 9, &ulValue);
+    pValue->value.dscaled.lval = (TMWTYPES_LONG)ulValue;
+    break;
+#endif
+  default:
+    return(TMWDEFS_FALSE);
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _finishRecord
+ *  Fill in the length, type and CRC of a record whose body has been
+ *  written at pRecord + 3, returns the length of the whole record
+ */
+static TMWTYPES_USHORT TMWDEFS_LOCAL _finishRecord(
+  TMWTYPES_UCHAR *pRecord,
+  TMWTYPES_UCHAR type,
+  TMWTYPES_USHORT bodyLength)
+{
+  TMWTYPES_USHORT length = (TMWTYPES_USHORT)(bodyLength + 1);
+  TMWTYPES_ULONG crc;
+
+  tmwtarg_store16(&length, pRecord);
+  pRecord[2] = type;
+  crc = _crc32(pRecord + 2, length);
+  tmwtarg_store32(&crc, pRecord + 2 + length);
+  return((TMWTYPES_USHORT)(length + SDNPJRNL_RECORD_OVERHEAD - 1));
+}
+
+/* function: _buildState */
+static TMWTYPES_USHORT TMWDEFS_LOCAL _buildState(
+  SDNPJRNL *pJournal,
+  TMWTYPES_UCHAR *pRecord)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pJournal->pSession;
+  TMWTYPES_UCHAR *pBody = pRecord + 3;
+
+  pBody[0] = pSDNPSession->unsolSequenceNumber;
+  pBody[1] = (TMWTYPES_UCHAR)(((pSDNPSession->iin & DNPDEFS_IIN_BUFFER_OVFL) != 0) ? 1 : 0);
+  tmwtarg_store32(&pJournal->nextEventId, pBody + 2);
+  return(_finishRecord(pRecord, SDNPJRNL_RECORD_STATE, 6));
+}
+
+/* function: _buildPoint */
+static TMWTYPES_USHORT TMWDEFS_LOCAL _buildPoint(
+  TMWTYPES_UCHAR *pRecord,
+  const SDNPJRNL_POINT *pPoint)
+{
+  TMWTYPES_UCHAR *pBody = pRecord + 3;
+  TMWTYPES_USHORT length = 4;
+
+  pBody[0] = pPoint->group;
+  tmwtarg_store16(&pPoint->point, pBody + 1);
+  pBody[3] = pPoint->flags;
+  switch(pPoint->group)
+  {
+  case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+  case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+    tmwtarg_store32(&pPoint->ulValue, pBody + length);
+    length += 4;
+    break;
+  case DNPDEFS_OBJ_30_ANA_INPUTS:
+  case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+  case DNPDEFS_OBJ_40_ANA_OUT_STATUSES:
+    _writeAnalog(pBody + length, &pPoint->analogValue);
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+  default:
+    break;
+  }
+  return(_finishRecord(pRecord, SDNPJRNL_RECORD_POINT, length));
+}
+
+/* function: _buildAdd
+ *  Returns 0 if the event group is not journaled
+ */
+static TMWTYPES_USHORT TMWDEFS_LOCAL _buildAdd(
+  TMWTYPES_UCHAR *pRecord,
+  TMWTYPES_UCHAR group,
+  SDNPEVNT *pEvent)
+{
+  TMWTYPES_UCHAR *pBody = pRecord + 3;
+  TMWTYPES_USHORT length = SDNPJRNL_EVENT_SIZE;
+  TMWTYPES_MS_SINCE_70 msSince70;
+
+  tmwtarg_store32(&pEvent->journalId, pBody);
+  pBody[4] = group;
+  tmwtarg_store16(&pEvent->point, pBody + 5);
+  pBody[7] = pEvent->flags;
+  pBody[8] = pEvent->classMask;
+  pBody[9] = pEvent->defaultVariation;
+  pBody[10] = (TMWTYPES_UCHAR)(pEvent->getCurrentValue ? 1 : 0);
+  dnpdtime_dateTimeToMSSince70(&msSince70, &pEvent->timeStamp);
+  dnpdtime_writeMsSince70(pBody + 11, &msSince70);
+  pBody[17] = (TMWTYPES_UCHAR)(pEvent->timeStamp.invalid ? 1 : 0);
+  pBody[18] = (TMWTYPES_UCHAR)pEvent->timeStamp.qualifier;
+
+  switch(group)
+  {
+#if SDNPDATA_SUPPORT_OBJ2
+  case DNPDEFS_OBJ_2_BIN_CHNG_EVENTS:
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ4
+  case DNPDEFS_OBJ_4_DBL_CHNG_EVENTS:
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ11
+  case DNPDEFS_OBJ_11_BIN_OUT_EVENTS:
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ13
+  case DNPDEFS_OBJ_13_BIN_CMD_EVENTS:
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ22
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+    tmwtarg_store32(&((SDNPEVNT_O022_EVENT *)pEvent)->value, pBody + length);
+    length += 4;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ23
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    tmwtarg_store32(&((SDNPEVNT_O023_EVENT *)pEvent)->value, pBody + length);
+    length += 4;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ32
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+    _writeAnalog(pBody + length, &((SDNPEVNT_O032_EVENT *)pEvent)->value);
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ33
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+    _writeAnalog(pBody + length, &((SDNPEVNT_O033_EVENT *)pEvent)->value);
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ42
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+    _writeAnalog(pBody + length, &((SDNPEVNT_O042_EVENT *)pEvent)->value);
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ43
+  case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+    _writeAnalog(pBody + length, &((SDNPEVNT_O043_EVENT *)pEvent)->value);
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ111 || SDNPDATA_SUPPORT_OBJ113
+#if SDNPDATA_SUPPORT_OBJ111
+  case DNPDEFS_OBJ_111_STRING_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ113
+  case DNPDEFS_OBJ_113_VTERM_EVENTS:
+#endif
+    {
+      SDNPEVNT_STRING *pString = (SDNPEVNT_STRING *)pEvent;
+      pBody[length++] = pString->strLength;
+      memcpy(pBody + length, pString->strBuf, pString->strLength);
+      length = (TMWTYPES_USHORT)(length + pString->strLength);
+    }
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ115
+  case DNPDEFS_OBJ_115_EXT_STR_EVENTS:
+    {
+      SDNPEVNT_EXT_STRING *pString = (SDNPEVNT_EXT_STRING *)pEvent;
+      tmwtarg_store16(&pString->strLength, pBody + length);
+      length += 2;
+      memcpy(pBody + length, pString->strBuf, pString->strLength);
+      length = (TMWTYPES_USHORT)(length + pString->strLength);
+    }
+    break;
+#endif
+  default:
+    return(0);
+  }
+  return(_finishRecord(pRecord, SDNPJRNL_RECORD_ADD, length));
+}
+
+/* function: _buildRemove */
+static TMWTYPES_USHORT TMWDEFS_LOCAL _buildRemove(
+  TMWTYPES_UCHAR *pRecord,
+  TMWTYPES_UCHAR group,
+  SDNPEVNT *pEvent,
+  TMWTYPES_UCHAR reason)
+{
+  TMWTYPES_UCHAR *pBody = pRecord + 3;
+
+  tmwtarg_store32(&pEvent->journalId, pBody);
+  pBody[4] = group;
+  pBody[5] = reason;
+  return(_finishRecord(pRecord, SDNPJRNL_RECORD_REMOVE, 6));
+}
+
+/* function: _bufferAppend */
+static void TMWDEFS_LOCAL _bufferAppend(
+  SDNPJRNL_BUFFER *pBuffer,
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  if(pBuffer->failed)
+    return;
+
+  if(pBuffer->length + length > pBuffer->size)
+  {
+    TMWTYPES_ULONG size = (pBuffer->size == 0) ? SDNPJRNL_INITIAL_BUFFER : pBuffer->size;
+    TMWTYPES_UCHAR *pBuf;
+
+    while(pBuffer->length + length > size)
+      size *= 2;
+
+    pBuf = (TMWTYPES_UCHAR *)tmwtarg_alloc((TMWTYPES_UINT)size);
+    if(pBuf == TMWDEFS_NULL)
+    {
+      pBuffer->failed = TMWDEFS_TRUE;
+      return;
+    }
+    if(pBuffer->pBuf != TMWDEFS_NULL)
+    {
+      memcpy(pBuf, pBuffer->pBuf, pBuffer->length);
+      tmwtarg_free(pBuffer->pBuf);
+    }
+    pBuffer->pBuf = pBuf;
+    pBuffer->size = size;
+  }
+
+  memcpy(pBuffer->pBuf + pBuffer->length, pData, length);
+  pBuffer->length += length;
+}
+
+/* function: _checkpointPoint */
+static void TMWDEFS_LOCAL _checkpointPoint(
+  SDNPJRNL_BUFFER *pBuffer,
+  TMWTYPES_UCHAR *pRecord,
+  const SDNPJRNL_POINT *pPoint)
+{
+  _bufferAppend(pBuffer, pRecord, _buildPoint(pRecord, pPoint));
+}
+
+/* function: _checkpointPoints
+ *  Add the value of every static point to a checkpoint
+ */
+static void TMWDEFS_LOCAL _checkpointPoints(
+  SDNPSESN *pSDNPSession,
+  SDNPJRNL_BUFFER *pBuffer,
+  TMWTYPES_UCHAR *pRecord)
+{
+  void *pDbHandle = pSDNPSession->pDbHandle;
+  SDNPJRNL_POINT point;
+  TMWTYPES_USHORT quantity;
+  void *pPoint;
+
+  memset(&point, 0, sizeof(point));
+  TMWTARG_UNUSED_PARAM(pDbHandle);
+  TMWTARG_UNUSED_PARAM(quantity);
+  TMWTARG_UNUSED_PARAM(pPoint);
+
+#if SDNPDATA_SUPPORT_OBJ1
+  point.group = DNPDEFS_OBJ_1_BIN_INPUTS;
+  quantity = sdnpdata_binInQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    if((pPoint = sdnpdata_binInGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_binInRead(pPoint, &point.flags);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ3
+  point.group = DNPDEFS_OBJ_3_DBL_INPUTS;
+  quantity = sdnpdata_dblInQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    if((pPoint = sdnpdata_dblInGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_dblInRead(pPoint, &point.flags);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ10
+  point.group = DNPDEFS_OBJ_10_BIN_OUT_STATUSES;
+  quantity = sdnpdata_binOutQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    if((pPoint = sdnpdata_binOutGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_binOutRead(pPoint, &point.flags);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ20
+  point.group = DNPDEFS_OBJ_20_RUNNING_CNTRS;
+  quantity = sdnpdata_binCntrQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    if((pPoint = sdnpdata_binCntrGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_binCntrRead(pPoint, &point.ulValue, &point.flags);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ21
+  point.group = DNPDEFS_OBJ_21_FROZEN_CNTRS;
+  quantity = sdnpdata_frznCntrQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    TMWDTIME timeOfFreeze;
+    if((pPoint = sdnpdata_frznCntrGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_frznCntrRead(pPoint, &point.ulValue, &point.flags, &timeOfFreeze);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ30
+  point.group = DNPDEFS_OBJ_30_ANA_INPUTS;
+  quantity = sdnpdata_anlgInQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    if((pPoint = sdnpdata_anlgInGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_anlgInRead(pPoint, &point.analogValue, &point.flags);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ31
+  point.group = DNPDEFS_OBJ_31_FRZN_ANA_INPUTS;
+  quantity = sdnpdata_frznAnlgInQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    TMWDTIME timeOfFreeze;
+    if((pPoint = sdnpdata_frznAnlgInGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_frznAnlgInRead(pPoint, &point.analogValue, &point.flags, &timeOfFreeze);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+#if SDNPDATA_SUPPORT_OBJ40
+  point.group = DNPDEFS_OBJ_40_ANA_OUT_STATUSES;
+  quantity = sdnpdata_anlgOutQuantity(pDbHandle);
+  for(point.point = 0; point.point < quantity; point.point++)
+  {
+    if((pPoint = sdnpdata_anlgOutGetPoint(pDbHandle, point.point)) == TMWDEFS_NULL)
+      continue;
+    sdnpdata_anlgOutRead(pPoint, &point.analogValue, &point.flags);
+    _checkpointPoint(pBuffer, pRecord, &point);
+  }
+#endif
+}
+
+/* function: _closeFile */
+static void TMWDEFS_LOCAL _closeFile(
+  SDNPJRNL *pJournal)
+{
+  if(pJournal->pFile != TMWDEFS_NULL)
+  {
+    sdnptarg_journalClose(pJournal->pFile);
+    pJournal->pFile = TMWDEFS_NULL;
+  }
+}
+
+/* function: _writeCheckpoint
+ *  Replace the journal with a checkpoint of the current state
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _writeCheckpoint(
+  SDNPJRNL *pJournal)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pJournal->pSession;
+  TMWTYPES_UCHAR record[SDNPJRNL_MAX_RECORD];
+  SDNPJRNL_BUFFER buffer;
+  TMWTYPES_ULONG magic = SDNPJRNL_MAGIC;
+  void *pFile;
+  unsigned int i;
+
+  memset(&buffer, 0, sizeof(buffer));
+
+  tmwtarg_store32(&magic, record);
+  record[4] = SDNPJRNL_VERSION;
+  record[5] = record[6] = record[7] = 0;
+  _bufferAppend(&buffer, record, SDNPJRNL_HEADER_SIZE);
+
+  /* Events are numbered again with each checkpoint, this also numbers
+   * any events queued before the journal was opened
+   */
+  pJournal->nextEventId = 0;
+  for(i = 0; i < sizeof(_eventGroups); i++)
+  {
+    TMWDLIST *pEventList;
+    TMWTYPES_USHORT maxEvents;
+    SDNPMEM_ALLOC_TYPE memType;
+    SDNPEVNT *pEvent;
+
+    if(!_getQueue(pSDNPSession, _eventGroups[i], &pEventList, &maxEvents, &memType))
+      continue;
+
+    pEvent = (SDNPEVNT *)tmwdlist_getFirst(pEventList);
+    while(pEvent != TMWDEFS_NULL)
+    {
+      pEvent->journalId = pJournal->nextEventId++;
+      _bufferAppend(&buffer, record, _buildAdd(record, _eventGroups[i], pEvent));
+      pEvent = (SDNPEVNT *)tmwdlist_getNext((TMWDLIST_MEMBER *)pEvent);
+    }
+  }
+
+  /* Replaying an event also sets its point to the event value, so the
+   * current point values follow the events they may be older than
+   */
+  _checkpointPoints(pSDNPSession, &buffer, record);
+
+  _bufferAppend(&buffer, record, _buildState(pJournal, record));
+
+  pFile = TMWDEFS_NULL;
+  if(!buffer.failed)
+    pFile = sdnptarg_journalReplace(pJournal->config.fileName, buffer.pBuf, buffer.length);
+
+  if(buffer.pBuf != TMWDEFS_NULL)
+    tmwtarg_free(buffer.pBuf);
+
+  /* The old handle may refer to a file that has already been replaced */
+  _closeFile(pJournal);
+  if(pFile == TMWDEFS_NULL)
+  {
+    TMWDIAG_ERROR("sdnpjrnl: unable to write journal checkpoint\n");
+    return(TMWDEFS_FALSE);
+  }
+
+  pJournal->pFile = pFile;
+  pJournal->appendedBytes = 0;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _appendRecord
+ *  Append a record, or write a checkpoint instead once checkpointSize
+ *  bytes have been appended. A checkpoint is only written when the
+ *  queues already reflect the record, so allowCheckpoint is
+ *  TMWDEFS_FALSE for records appended before an event is freed.
+ */
+static void TMWDEFS_LOCAL _appendRecord(
+  SDNPJRNL *pJournal,
+  const TMWTYPES_UCHAR *pRecord,
+  TMWTYPES_USHORT length,
+  TMWTYPES_BOOL allowCheckpoint)
+{
+  if(pJournal->pFile == TMWDEFS_NULL)
+    return;
+
+  if(allowCheckpoint
+    && (pJournal->appendedBytes + length > pJournal->config.checkpointSize))
+  {
+    (void)_writeCheckpoint(pJournal);
+    return;
+  }
+
+  if(!sdnptarg_journalAppend(pJournal->pFile, pRecord, length, pJournal->config.syncWrites))
+  {
+    /* Stop recording until a checkpoint is written */
+    TMWDIAG_ERROR("sdnpjrnl: unable to append to journal\n");
+    _closeFile(pJournal);
+    return;
+  }
+  pJournal->appendedBytes += length;
+}
+
+/* function: _restoreSimPoint
+ *  Default SDNPJRNL_RESTORE_POINT_FUNC, sets a point in the simulated
+ *  database
+ */
+static void TMWDEFS_LOCAL _restoreSimPoint(
+  void *pParam,
+  TMWSESN *pSession,
+  const SDNPJRNL_POINT *pPoint)
+{
+#if TMWCNFG_USE_SIMULATED_DB
+  void *pDbHandle = ((SDNPSESN *)pSession)->pDbHandle;
+  TMWSIM_POINT *pSimPoint = TMWDEFS_NULL;
+  TMWDEFS_CHANGE_REASON reason;
+  TMWTARG_UNUSED_PARAM(pParam);
+
+  switch(pPoint->group)
+  {
+  case DNPDEFS_OBJ_1_BIN_INPUTS:
+  case DNPDEFS_OBJ_10_BIN_OUT_STATUSES:
+    if(pPoint->group == DNPDEFS_OBJ_1_BIN_INPUTS)
+      pSimPoint = (TMWSIM_POINT *)sdnpsim_binInGetPoint(pDbHandle, pPoint->point);
+    else
+      pSimPoint = (TMWSIM_POINT *)sdnpsim_binOutGetPoint(pDbHandle, pPoint->point);
+    if(pSimPoint == TMWDEFS_NULL)
+      return;
+    tmwsim_setBinaryValue(pSimPoint,
+      (TMWTYPES_BOOL)((pPoint->flags & DNPDEFS_DBAS_FLAG_BINARY_ON) != 0), TMWDEFS_CHANGE_NONE);
+    tmwsim_setFlags(pSimPoint,
+      (TMWTYPES_UCHAR)(pPoint->flags & ~DNPDEFS_DBAS_FLAG_BINARY_ON), TMWDEFS_CHANGE_NONE);
+    break;
+
+  case DNPDEFS_OBJ_3_DBL_INPUTS:
+    pSimPoint = (TMWSIM_POINT *)sdnpsim_dblInGetPoint(pDbHandle, pPoint->point);
+    if(pSimPoint == TMWDEFS_NULL)
+      return;
+    tmwsim_setFlags(pSimPoint, pPoint->flags, TMWDEFS_CHANGE_NONE);
+    break;
+
+  case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+  case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+    if(pPoint->group == DNPDEFS_OBJ_20_RUNNING_CNTRS)
+      pSimPoint = (TMWSIM_POINT *)sdnpsim_binaryCounterGetPoint(pDbHandle, pPoint->point);
+    else
+      pSimPoint = (TMWSIM_POINT *)sdnpsim_frozenCounterGetPoint(pDbHandle, pPoint->point);
+    if(pSimPoint == TMWDEFS_NULL)
+      return;
+    tmwsim_setCounterValue(pSimPoint, pPoint->ulValue, TMWDEFS_CHANGE_NONE);
+    tmwsim_setFlags(pSimPoint, pPoint->flags, TMWDEFS_CHANGE_NONE);
+    break;
+
+  case DNPDEFS_OBJ_30_ANA_INPUTS:
+  case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+  case DNPDEFS_OBJ_40_ANA_OUT_STATUSES:
+    {
+      TMWTYPES_ANALOG_VALUE analogValue = pPoint->analogValue;
+#if TMWCNFG_SUPPORT_DOUBLE
+      TMWSIM_DATA_TYPE value = dnputil_getAnalogValueDouble(&analogValue);
+#elif TMWCNFG_SUPPORT_FLOAT
+      TMWTYPES_UCHAR flags; /* Temporary storage */
+      TMWSIM_DATA_TYPE value = dnputil_getAnalogValueFloat(&analogValue, &flags);
+#else
+      TMWTYPES_UCHAR flags; /* Temporary storage */
+      TMWSIM_DATA_TYPE value = dnputil_getAnalogValueLong(&analogValue, &flags);
+#endif
+      if(pPoint->group == DNPDEFS_OBJ_30_ANA_INPUTS)
+        pSimPoint = (TMWSIM_POINT *)sdnpsim_anlgInGetPoint(pDbHandle, pPoint->point);
+      else if(pPoint->group == DNPDEFS_OBJ_31_FRZN_ANA_INPUTS)
+        pSimPoint = (TMWSIM_POINT *)sdnpsim_frznAnlgInGetPoint(pDbHandle, pPoint->point);
+      else
+        pSimPoint = (TMWSIM_POINT *)sdnpsim_anlgOutGetPoint(pDbHandle, pPoint->point);
+      if(pSimPoint == TMWDEFS_NULL)
+        return;
+      tmwsim_setAnalogValue(pSimPoint, value, TMWDEFS_CHANGE_NONE);
+      tmwsim_setFlags(pSimPoint, pPoint->flags, TMWDEFS_CHANGE_NONE);
+    }
+    break;
+
+  default:
+    return;
+  }
+
+  /* The restored value is not a change to report */
+  (void)tmwsim_getChanged(pSimPoint, &reason);
+#else
+  TMWTARG_UNUSED_PARAM(pParam);
+  TMWTARG_UNUSED_PARAM(pSession);
+  TMWTARG_UNUSED_PARAM(pPoint);
+#endif
+}
+
+/* function: _restorePoint */
+static void TMWDEFS_LOCAL _restorePoint(
+  SDNPJRNL *pJournal,
+  const SDNPJRNL_POINT *pPoint)
+{
+  if(pJournal->config.pRestorePointFunc != TMWDEFS_NULL)
+    pJournal->config.pRestorePointFunc(pJournal->config.pRestorePointParam, pJournal->pSession, pPoint);
+  else
+    _restoreSimPoint(TMWDEFS_NULL, pJournal->pSession, pPoint);
+}
+
+/* function: _getEventPoint
+ *  Get the static point an event was generated for, with the value the
+ *  event sets it to. Returns TMWDEFS_FALSE if the event has no static
+ *  point to restore.
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _getEventPoint(
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT pointNumber,
+  TMWTYPES_UCHAR flags,
+  TMWTYPES_ULONG ulValue,
+  const TMWTYPES_ANALOG_VALUE *pAnalogValue,
+  SDNPJRNL_POINT *pPoint)
+{
+  memset(pPoint, 0, sizeof(SDNPJRNL_POINT));
+  pPoint->point = pointNumber;
+  pPoint->flags = flags;
+
+  switch(group)
+  {
+  case DNPDEFS_OBJ_2_BIN_CHNG_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_1_BIN_INPUTS;
+    break;
+  case DNPDEFS_OBJ_4_DBL_CHNG_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_3_DBL_INPUTS;
+    break;
+  case DNPDEFS_OBJ_11_BIN_OUT_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_10_BIN_OUT_STATUSES;
+    break;
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_20_RUNNING_CNTRS;
+    pPoint->ulValue = ulValue;
+    break;
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_21_FROZEN_CNTRS;
+    pPoint->ulValue = ulValue;
+    break;
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_30_ANA_INPUTS;
+    pPoint->analogValue = *pAnalogValue;
+    break;
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_31_FRZN_ANA_INPUTS;
+    pPoint->analogValue = *pAnalogValue;
+    break;
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+    pPoint->group = DNPDEFS_OBJ_40_ANA_OUT_STATUSES;
+    pPoint->analogValue = *pAnalogValue;
+    break;
+  default:
+    /* Command and string events have no static point to restore */
+    return(TMWDEFS_FALSE);
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _restoreEventPoint
+ *  Set the static point an event was generated for to the event value
+ */
+static void TMWDEFS_LOCAL _restoreEventPoint(
+  SDNPJRNL *pJournal,
+  TMWTYPES_UCHAR group,
+  SDNPEVNT *pEvent)
+{
+  const TMWTYPES_ANALOG_VALUE *pAnalogValue = TMWDEFS_NULL;
+  TMWTYPES_ULONG ulValue = 0;
+  SDNPJRNL_POINT point;
+
+  switch(group)
+  {
+#if SDNPDATA_SUPPORT_OBJ22
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+    ulValue = ((SDNPEVNT_O022_EVENT *)pEvent)->value;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ23
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    ulValue = ((SDNPEVNT_O023_EVENT *)pEvent)->value;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ32
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+    pAnalogValue = &((SDNPEVNT_O032_EVENT *)pEvent)->value;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ33
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+    pAnalogValue = &((SDNPEVNT_O033_EVENT *)pEvent)->value;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ42
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+    pAnalogValue = &((SDNPEVNT_O042_EVENT *)pEvent)->value;
+    break;
+#endif
+  default:
+    break;
+  }
+
+  if(_getEventPoint(group, pEvent->point, pEvent->flags, ulValue, pAnalogValue, &point))
+    _restorePoint(pJournal, &point);
+}
+
+/* function: _replayAdd */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _replayAdd(
+  SDNPJRNL *pJournal,
+  const TMWTYPES_UCHAR *pBody,
+  TMWTYPES_USHORT bodyLength)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pJournal->pSession;
+  TMWTYPES_MS_SINCE_70 msSince70;
+  TMWTYPES_USHORT maxEvents;
+  SDNPMEM_ALLOC_TYPE memType;
+  TMWDLIST *pEventList;
+  TMWTYPES_USHORT length = SDNPJRNL_EVENT_SIZE;
+  TMWTYPES_UCHAR group;
+  SDNPEVNT *pEvent;
+
+  if(bodyLength < SDNPJRNL_EVENT_SIZE)
+    return(TMWDEFS_FALSE);
+
+  group = pBody[4];
+  if(!_getQueue(pSDNPSession, group, &pEventList, &maxEvents, &memType))
+  {
+    /* Not supported by this configuration */
+    return(TMWDEFS_TRUE);
+  }
+
+  pEvent = (SDNPEVNT *)sdnpmem_alloc(memType);
+  if(pEvent == TMWDEFS_NULL)
+  {
+    pJournal->overflow = TMWDEFS_TRUE;
+    return(TMWDEFS_TRUE);
+  }
+
+  tmwtarg_get32(pBody, &pEvent->journalId);
+  tmwtarg_get16(pBody + 5, &pEvent->point);
+  pEvent->flags = pBody[7];
+  pEvent->classMask = pBody[8];
+  pEvent->defaultVariation = pBody[9];
+  pEvent->getCurrentValue = (TMWTYPES_BOOL)(pBody[10] != 0);
+  pEvent->eventSent = TMWDEFS_FALSE;
+  pEvent->pSession = pJournal->pSession;
+  dnpdtime_readMsSince70(&msSince70, pBody + 11);
+  dnpdtime_msSince70ToDateTime(&pEvent->timeStamp, &msSince70);
+  pEvent->timeStamp.invalid = (TMWTYPES_BOOL)(pBody[17] != 0);
+  pEvent->timeStamp.qualifier = (TMWDTIME_QUAL)pBody[18];
+  pEvent->timeStamp.pSession = pJournal->pSession;
+
+  switch(group)
+  {
+#if SDNPDATA_SUPPORT_OBJ22
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ23
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ22 || SDNPDATA_SUPPORT_OBJ23
+    if(bodyLength < length + 4)
+      break;
+    /* Object 22 and 23 events have the same layout */
+    tmwtarg_get32(pBody + length, &((SDNPEVNT_O022_EVENT *)pEvent)->value);
+    length += 4;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ32
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ33
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ42
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ43
+  case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ32 || SDNPDATA_SUPPORT_OBJ33 || SDNPDATA_SUPPORT_OBJ42 || SDNPDATA_SUPPORT_OBJ43
+    if((bodyLength < length + SDNPJRNL_ANALOG_SIZE)
+      || !_readAnalog(pBody + length, &((SDNPEVNT_O032_EVENT *)pEvent)->value))
+    {
+      length = 0;
+      break;
+    }
+    /* Analog events have the same layout */
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ111
+  case DNPDEFS_OBJ_111_STRING_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ113
+  case DNPDEFS_OBJ_113_VTERM_EVENTS:
+#endif
+#if SDNPDATA_SUPPORT_OBJ111 || SDNPDATA_SUPPORT_OBJ113
+    {
+      SDNPEVNT_STRING *pString = (SDNPEVNT_STRING *)pEvent;
+      if(bodyLength < length + 1)
+        break;
+      pString->strLength = pBody[length++];
+      if(bodyLength < length + pString->strLength)
+        break;
+      memcpy(pString->strBuf, pBody + length, pString->strLength);
+      length = (TMWTYPES_USHORT)(length + pString->strLength);
+    }
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ115
+  case DNPDEFS_OBJ_115_EXT_STR_EVENTS:
+    {
+      SDNPEVNT_EXT_STRING *pString = (SDNPEVNT_EXT_STRING *)pEvent;
+      if(bodyLength < length + 2)
+        break;
+      tmwtarg_get16(pBody + length, &pString->strLength);
+      length += 2;
+      if((pString->strLength > DNPCNFG_MAX_EXT_STRING_LENGTH)
+        || (bodyLength < length + pString->strLength))
+        break;
+      memcpy(pString->strBuf, pBody + length, pString->strLength);
+      length = (TMWTYPES_USHORT)(length + pString->strLength);
+    }
+    break;
+#endif
+  default:
+    break;
+  }
+
+  if(length != bodyLength)
+  {
+    sdnpmem_free(pEvent);
+    return(TMWDEFS_FALSE);
+  }
+
+  /* The queue may have been made smaller since the journal was written */
+  if((maxEvents != 0) && (tmwdlist_size(pEventList) >= maxEvents))
+  {
+    sdnpevnt_deleteEvent(pJournal->pSession, pEventList,
+      (SDNPEVNT *)tmwdlist_getFirst(pEventList));
+    pJournal->overflow = TMWDEFS_TRUE;
+  }
+
+  sdnpevnt_insertEvent(pJournal->pSession, pEventList, pEvent);
+  _restoreEventPoint(pJournal, group, pEvent);
+
+  if(pEvent->journalId >= pJournal->nextEventId)
+    pJournal->nextEventId = pEvent->journalId + 1;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _replayRemove */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _replayRemove(
+  SDNPJRNL *pJournal,
+  const TMWTYPES_UCHAR *pBody,
+  TMWTYPES_USHORT bodyLength)
+{
+  TMWTYPES_USHORT maxEvents;
+  SDNPMEM_ALLOC_TYPE memType;
+  TMWDLIST *pEventList;
+  TMWTYPES_ULONG id;
+  SDNPEVNT *pEvent;
+
+  if(bodyLength != 6)
+    return(TMWDEFS_FALSE);
+
+  if(pBody[5] == SDNPJRNL_REMOVED_OVERFLOW)
+    pJournal->overflow = TMWDEFS_TRUE;
+
+  if(!_getQueue((SDNPSESN *)pJournal->pSession, pBody[4], &pEventList, &maxEvents, &memType))
+    return(TMWDEFS_TRUE);
+
+  /* Events are usually removed from the front of the queue */
+  tmwtarg_get32(pBody, &id);
+  pEvent = (SDNPEVNT *)tmwdlist_getFirst(pEventList);
+  while(pEvent != TMWDEFS_NULL)
+  {
+    if(pEvent->journalId == id)
+    {
+      sdnpevnt_deleteEvent(pJournal->pSession, pEventList, pEvent);
+      break;
+    }
+    pEvent = (SDNPEVNT *)tmwdlist_getNext((TMWDLIST_MEMBER *)pEvent);
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _replayPoint */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _replayPoint(
+  SDNPJRNL *pJournal,
+  const TMWTYPES_UCHAR *pBody,
+  TMWTYPES_USHORT bodyLength)
+{
+  SDNPJRNL_POINT point;
+  TMWTYPES_USHORT length = 4;
+
+  if(bodyLength < length)
+    return(TMWDEFS_FALSE);
+
+  memset(&point, 0, sizeof(point));
+  point.group = pBody[0];
+  tmwtarg_get16(pBody + 1, &point.point);
+  point.flags = pBody[3];
+  switch(point.group)
+  {
+  case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+  case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+    if(bodyLength < length + 4)
+      return(TMWDEFS_FALSE);
+    tmwtarg_get32(pBody + length, &point.ulValue);
+    length += 4;
+    break;
+  case DNPDEFS_OBJ_30_ANA_INPUTS:
+  case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+  case DNPDEFS_OBJ_40_ANA_OUT_STATUSES:
+    if((bodyLength < length + SDNPJRNL_ANALOG_SIZE)
+      || !_readAnalog(pBody + length, &point.analogValue))
+      return(TMWDEFS_FALSE);
+    length += SDNPJRNL_ANALOG_SIZE;
+    break;
+  default:
+    break;
+  }
+
+  if(length != bodyLength)
+    return(TMWDEFS_FALSE);
+
+  _restorePoint(pJournal, &point);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _replayState */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _replayState(
+  SDNPJRNL *pJournal,
+  const TMWTYPES_UCHAR *pBody,
+  TMWTYPES_USHORT bodyLength)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pJournal->pSession;
+  TMWTYPES_ULONG nextEventId;
+
+  if(bodyLength != 6)
+    return(TMWDEFS_FALSE);
+
+  pSDNPSession->unsolSequenceNumber = pBody[0];
+  if(pBody[1] != 0)
+    pJournal->overflow = TMWDEFS_TRUE;
+  tmwtarg_get32(pBody + 2, &nextEventId);
+  if(nextEventId > pJournal->nextEventId)
+    pJournal->nextEventId = nextEventId;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _replay
+ *  Replay the records in a journal file, stopping at the first record
+ *  that is incomplete or damaged
+ */
+static void TMWDEFS_LOCAL _replay(
+  SDNPJRNL *pJournal,
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  TMWTYPES_ULONG offset = SDNPJRNL_HEADER_SIZE;
+  TMWTYPES_ULONG magic;
+
+  if(length < SDNPJRNL_HEADER_SIZE)
+    return;
+
+  tmwtarg_get32(pData, &magic);
+  if((magic != SDNPJRNL_MAGIC) || (pData[4] != SDNPJRNL_VERSION))
+  {
+    TMWDIAG_ERROR("sdnpjrnl: journal file is not recognized, ignoring it\n");
+    return;
+  }
+
+  while(offset + SDNPJRNL_RECORD_OVERHEAD <= length)
+  {
+    TMWTYPES_USHORT recordLength;
+    TMWTYPES_ULONG crc;
+    TMWTYPES_BOOL valid;
+
+    tmwtarg_get16(pData + offset, &recordLength);
+    if((recordLength == 0)
+      || (offset + recordLength + SDNPJRNL_RECORD_OVERHEAD - 1 > length))
+      break;
+
+    tmwtarg_get32(pData + offset + 2 + recordLength, &crc);
+    if(crc != _crc32(pData + offset + 2, recordLength))
+      break;
+
+    switch(pData[offset + 2])
+    {
+    case SDNPJRNL_RECORD_STATE:
+      valid = _replayState(pJournal, pData + offset + 3, (TMWTYPES_USHORT)(recordLength - 1));
+      break;
+    case SDNPJRNL_RECORD_POINT:
+      valid = _replayPoint(pJournal, pData + offset + 3, (TMWTYPES_USHORT)(recordLength - 1));
+      break;
+    case SDNPJRNL_RECORD_ADD:
+      valid = _replayAdd(pJournal, pData + offset + 3, (TMWTYPES_USHORT)(recordLength - 1));
+      break;
+    case SDNPJRNL_RECORD_REMOVE:
+      valid = _replayRemove(pJournal, pData + offset + 3, (TMWTYPES_USHORT)(recordLength - 1));
+      break;
+    default:
+      valid = TMWDEFS_FALSE;
+      break;
+    }
+    if(!valid)
+      break;
+
+    offset += recordLength + SDNPJRNL_RECORD_OVERHEAD - 1;
+  }
+
+  if(offset < length)
+    TMWDIAG_ERROR("sdnpjrnl: ignoring incomplete record at the end of the journal\n");
+}
+
+/* function: sdnpjrnl_initConfig */
+void TMWDEFS_GLOBAL sdnpjrnl_initConfig(
+  SDNPJRNL_CONFIG *pConfig)
+{
+  memset(pConfig, 0, sizeof(SDNPJRNL_CONFIG));
+  pConfig->checkpointSize = SDNPJRNL_DEFAULT_CHECKPOINT_SIZE;
+  pConfig->syncWrites = TMWDEFS_FALSE;
+  pConfig->pRestorePointFunc = TMWDEFS_NULL;
+  pConfig->pRestorePointParam = TMWDEFS_NULL;
+}
+
+/* function: sdnpjrnl_open */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpjrnl_open(
+  TMWSESN *pSession,
+  const SDNPJRNL_CONFIG *pConfig)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPJRNL *pJournal;
+  TMWTYPES_UCHAR *pData;
+  TMWTYPES_ULONG length;
+  TMWTYPES_BOOL status;
+  unsigned int i;
+
+  if((pSession == TMWDEFS_NULL)
+    || (pSDNPSession->pJournal != TMWDEFS_NULL)
+#if SDNPCNFG_USER_MANAGED_EVENTS
+    || pSDNPSession->userManagedEvents
+#endif
+    || (pConfig->fileName[0] == '\0'))
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  pJournal = (SDNPJRNL *)tmwtarg_alloc(sizeof(SDNPJRNL));
+  if(pJournal == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  memset(pJournal, 0, sizeof(SDNPJRNL));
+  pJournal->pSession = pSession;
+  pJournal->config = *pConfig;
+  pJournal->config.fileName[SDNPJRNL_MAX_FILE_NAME - 1] = '\0';
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+
+  pData = sdnptarg_journalRead(pJournal->config.fileName, &length);
+  if(pData != TMWDEFS_NULL)
+  {
+    _replay(pJournal, pData, length);
+    tmwtarg_free(pData);
+
+    /* Report the restored events */
+    for(i = 0; i < sizeof(_eventGroups); i++)
+    {
+      TMWDLIST *pEventList;
+      TMWTYPES_USHORT maxEvents;
+      SDNPMEM_ALLOC_TYPE memType;
+      SDNPEVNT *pEvent;
+
+      if(!_getQueue(pSDNPSession, _eventGroups[i], &pEventList, &maxEvents, &memType))
+        continue;
+
+      pEvent = (SDNPEVNT *)tmwdlist_getFirst(pEventList);
+      while(pEvent != TMWDEFS_NULL)
+      {
+        sdnpevnt_updateEvents(pSession, pEvent->classMask);
+        pEvent = (SDNPEVNT *)tmwdlist_getNext((TMWDLIST_MEMBER *)pEvent);
+      }
+    }
+
+    if(pJournal->overflow)
+      pSDNPSession->iin |= DNPDEFS_IIN_BUFFER_OVFL;
+  }
+
+  pSDNPSession->pJournal = pJournal;
+  status = _writeCheckpoint(pJournal);
+
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+  return(status);
+}
+
+/* function: sdnpjrnl_checkpoint */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpjrnl_checkpoint(
+  TMWSESN *pSession)
+{
+  SDNPJRNL *pJournal = _getJournal(pSession);
+  TMWTYPES_BOOL status;
+
+  if(pJournal == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  status = _writeCheckpoint(pJournal);
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+  return(status);
+}
+
+/* function: sdnpjrnl_close */
+void TMWDEFS_GLOBAL sdnpjrnl_close(
+  TMWSESN *pSession)
+{
+  SDNPJRNL *pJournal = _getJournal(pSession);
+
+  if(pJournal == TMWDEFS_NULL)
+    return;
+
+  (void)_writeCheckpoint(pJournal);
+  _closeFile(pJournal);
+
+  ((SDNPSESN *)pSession)->pJournal = TMWDEFS_NULL;
+  tmwtarg_free(pJournal);
+}
+
+/* function: sdnpjrnl_eventAdded */
+void TMWDEFS_GLOBAL sdnpjrnl_eventAdded(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  SDNPEVNT *pEvent)
+{
+  SDNPJRNL *pJournal = _getJournal(pSession);
+  TMWTYPES_UCHAR record[SDNPJRNL_MAX_RECORD];
+  TMWTYPES_USHORT length;
+
+  if(pJournal == TMWDEFS_NULL)
+    return;
+
+  pEvent->journalId = pJournal->nextEventId++;
+
+  length = _buildAdd(record, group, pEvent);
+  if(length != 0)
+    _appendRecord(pJournal, record, length, TMWDEFS_TRUE);
+}
+
+/* function: sdnpjrnl_eventDiscarded */
+void TMWDEFS_GLOBAL sdnpjrnl_eventDiscarded(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_UCHAR flags,
+  SDNPDATA_ADD_EVENT_VALUE *pValue)
+{
+  SDNPJRNL *pJournal = _getJournal(pSession);
+  TMWTYPES_UCHAR record[SDNPJRNL_MAX_RECORD];
+  const TMWTYPES_ANALOG_VALUE *pAnalogValue = TMWDEFS_NULL;
+  TMWTYPES_ULONG ulValue = 0;
+  SDNPJRNL_POINT eventPoint;
+
+  if(pJournal == TMWDEFS_NULL)
+    return;
+
+  switch(group)
+  {
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    ulValue = pValue->ulValue;
+    break;
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+    pAnalogValue = pValue->analogPtr;
+    break;
+  default:
+    break;
+  }
+
+  /* Without an event to replay, journal the value it would have set */
+  if(_getEventPoint(group, point, flags, ulValue, pAnalogValue, &eventPoint))
+    _appendRecord(pJournal, record, _buildPoint(record, &eventPoint), TMWDEFS_TRUE);
+}
+
+/* function: sdnpjrnl_eventRemoved */
+void TMWDEFS_GLOBAL sdnpjrnl_eventRemoved(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  SDNPEVNT *pEvent,
+  TMWTYPES_UCHAR reason)
+{
+  SDNPJRNL *pJournal = _getJournal(pSession);
+  TMWTYPES_UCHAR record[SDNPJRNL_RECORD_OVERHEAD + 6];
+  TMWDLIST *pEventList;
+  TMWTYPES_USHORT maxEvents;
+  SDNPMEM_ALLOC_TYPE memType;
+
+  if((pJournal == TMWDEFS_NULL)
+    || !_getQueue((SDNPSESN *)pSession, group, &pEventList, &maxEvents, &memType))
+  {
+    return;
+  }
+
+  /* A confirmed event is still queued when this is called */
+  _appendRecord(pJournal, record, _buildRemove(record, group, pEvent, reason), TMWDEFS_FALSE);
+}
+
+/* function: sdnpjrnl_sequenceChanged */
+void TMWDEFS_GLOBAL sdnpjrnl_sequenceChanged(
+  TMWSESN *pSession)
+{
+  SDNPJRNL *pJournal = _getJournal(pSession);
+  TMWTYPES_UCHAR record[SDNPJRNL_RECORD_OVERHEAD + 6];
+
+  if(pJournal == TMWDEFS_NULL)
+    return;
+
+  _appendRecord(pJournal, record, _buildState(pJournal, record), TMWDEFS_TRUE);
+}
+
+#endif /* TMWTARG_SUPPORT_JOURNAL */
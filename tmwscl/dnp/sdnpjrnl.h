@@ -0,0 +1,281 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+
+/* file: sdnpjrnl.h
+ * description: Journal of the DNP slave event queues and point values.
+ *  When an outstation restarts every event that has not been confirmed
+ *  by its master is lost, so each master must run an integrity poll to
+ *  learn the current values again. If many outstations restart at once,
+ *  after an upgrade for example, those polls arrive together. A journal
+ *  keeps the events queued by the SCL for a session, the values and
+ *  flags of its points and its unsolicited sequence number in a local
+ *  file, so a restarted outstation resumes with its event backlog.
+ *
+ *  The file begins with a checkpoint of the whole state and then has a
+ *  record appended for each event queued or removed from a queue. Each
+ *  record has a length and a CRC, so when the journal is replayed a
+ *  record that was only partly written when the process stopped is
+ *  recognized and it and anything after it is ignored. Records are
+ *  written with a single write each, so they survive the process being
+ *  killed, and are flushed to the disk as well if syncWrites is set.
+ *  Once checkpointSize bytes of records have been appended, a new
+ *  checkpoint replaces the file.
+ *
+ *  Point values are written to each checkpoint from the database, and
+ *  between checkpoints the value and flags in each event are taken as the
+ *  new value of the point. Changes to points that do not generate events
+ *  are therefore only kept when the next checkpoint is written.
+ *
+ *  Binary input, double bit input, binary output, counter, frozen
+ *  counter, analog input, frozen analog input and analog output events,
+ *  binary and analog output command events and string, virtual terminal
+ *  and extended string events are journaled. Data set and secure
+ *  authentication events, and events of sessions using user managed
+ *  events, are not.
+ */
+#ifndef SDNPJRNL_DEFINED
+#define SDNPJRNL_DEFINED
+
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwsesn.h"
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/dnp/sdnpevnt.h"
+
+#if TMWTARG_SUPPORT_JOURNAL
+
+/* Longest journal file name, including the terminating null */
+#define SDNPJRNL_MAX_FILE_NAME     256
+
+/* Why an event was removed from a queue */
+#define SDNPJRNL_REMOVED_CONFIRMED 0  /* confirmed by the master */
+#define SDNPJRNL_REMOVED_OVERFLOW  1  /* discarded since the queue was full */
+#define SDNPJRNL_REMOVED_REPLACED  2  /* replaced by a newer event for the
+                                       * point, most recent event mode */
+
+/* A point value restored from the journal */
+typedef struct SDNPJrnlPointStruct {
+  /* Static object group of the point
+   *  DNPDEFS_OBJ_1_BIN_INPUTS, DNPDEFS_OBJ_3_DBL_INPUTS,
+   *  DNPDEFS_OBJ_10_BIN_OUT_STATUSES, DNPDEFS_OBJ_20_RUNNING_CNTRS,
+   *  DNPDEFS_OBJ_21_FROZEN_CNTRS, DNPDEFS_OBJ_30_ANA_INPUTS,
+   *  DNPDEFS_OBJ_31_FRZN_ANA_INPUTS or DNPDEFS_OBJ_40_ANA_OUT_STATUSES
+   */
+  TMWTYPES_UCHAR  group;
+  TMWTYPES_USHORT point;
+
+  /* Flags, including the state of binary and double bit points */
+  TMWTYPES_UCHAR  flags;
+
+  /* Value of counters */
+  TMWTYPES_ULONG  ulValue;
+
+  /* Value of analog points */
+  TMWTYPES_ANALOG_VALUE analogValue;
+} SDNPJRNL_POINT;
+
+/* function: SDNPJRNL_RESTORE_POINT_FUNC
+ * purpose: Set the value of a point from the journal. Called while the
+ *  journal is replayed by sdnpjrnl_open, in the order the values were
+ *  journaled, so a point may be set more than once. This must not
+ *  generate an event for the point.
+ * arguments:
+ *  pParam - pRestorePointParam from the configuration
+ *  pSession - session the journal belongs to
+ *  pPoint - point value
+ * returns:
+ *  void
+ */
+typedef void (*SDNPJRNL_RESTORE_POINT_FUNC)(
+  void *pParam,
+  TMWSESN *pSession,
+  const SDNPJRNL_POINT *pPoint);
+
+/* Journal configuration */
+typedef struct SDNPJrnlConfigStruct {
+  /* Journal file */
+  TMWTYPES_CHAR fileName[SDNPJRNL_MAX_FILE_NAME];
+
+  /* Number of bytes of records appended after which a new checkpoint
+   * is written
+   */
+  TMWTYPES_ULONG checkpointSize;
+
+  /* Flush each record to the disk before continuing, so the journal also
+   * survives a power failure. Otherwise records are only flushed to the
+   * disk with each checkpoint.
+   */
+  TMWTYPES_BOOL syncWrites;
+
+  /* Function called to set the value of each point. If this is
+   * TMWDEFS_NULL the points of the simulated database are set, or point
+   * values are not restored if the simulated database is not used.
+   */
+  SDNPJRNL_RESTORE_POINT_FUNC pRestorePointFunc;
+  void *pRestorePointParam;
+} SDNPJRNL_CONFIG;
+
+/* Journal of one session */
+typedef struct SDNPJrnlStruct {
+  TMWSESN *pSession;
+  SDNPJRNL_CONFIG config;
+
+  /* Handle from sdnptarg_journalReplace, TMWDEFS_NULL if the journal
+   * could not be written and is waiting for a new checkpoint
+   */
+  void *pFile;
+
+  /* Identifier given to the next event queued */
+  TMWTYPES_ULONG nextEventId;
+
+  /* Number of bytes appended since the last checkpoint */
+  TMWTYPES_ULONG appendedBytes;
+
+  /* An event was discarded since a queue was full */
+  TMWTYPES_BOOL overflow;
+} SDNPJRNL;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnpjrnl_initConfig
+   * purpose: Initialize a journal configuration to the defaults
+   * arguments:
+   *  pConfig - configuration to initialize
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpjrnl_initConfig(
+    SDNPJRNL_CONFIG *pConfig);
+
+  /* function: sdnpjrnl_open
+   * purpose: Replay a session's journal, if the file exists, and keep
+   *  journaling the session in it. The events in the journal are queued
+   *  again, the points are set to their journaled values and a new
+   *  checkpoint is written. Call this after opening the session and
+   *  adding its points to the database, before any events are added.
+   *  The journal is closed by sdnpsesn_closeSession.
+   * arguments:
+   *  pSession - session opened with userManagedEvents TMWDEFS_FALSE
+   *  pConfig - journal configuration
+   * returns:
+   *  TMWDEFS_TRUE if the journal was replayed and the checkpoint written
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpjrnl_open(
+    TMWSESN *pSession,
+    const SDNPJRNL_CONFIG *pConfig);
+
+  /* function: sdnpjrnl_checkpoint
+   * purpose: Write a new checkpoint of a session's events, points and
+   *  sequence number now, for example after changing many points that do
+   *  not generate events. If a record could not be appended the journal
+   *  stops recording until a checkpoint is written successfully.
+   * arguments:
+   *  pSession - session opened with sdnpjrnl_open
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpjrnl_checkpoint(
+    TMWSESN *pSession);
+
+  /* function: sdnpjrnl_close
+   * purpose: Write a final checkpoint and close a session's journal.
+   *  Called by sdnpsesn_closeSession.
+   * arguments:
+   *  pSession - session
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpjrnl_close(
+    TMWSESN *pSession);
+
+  /* function: sdnpjrnl_eventAdded
+   * purpose: Journal an event added to one of a session's queues.
+   *  Called by sdnpevnt_addEvent.
+   * arguments:
+   *  pSession - session
+   *  group - object group of the event
+   *  pEvent - event
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpjrnl_eventAdded(
+    TMWSESN *pSession,
+    TMWTYPES_UCHAR group,
+    SDNPEVNT *pEvent);
+
+  /* function: sdnpjrnl_eventDiscarded
+   * purpose: Journal the point value of an event that was not queued
+   *  because its queue was full. Called by sdnpevnt_addEvent.
+   * arguments:
+   *  pSession - session
+   *  group - object group of the event
+   *  point - point number
+   *  flags - flags of the event
+   *  pValue - value of the event
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpjrnl_eventDiscarded(
+    TMWSESN *pSession,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point,
+    TMWTYPES_UCHAR flags,
+    SDNPDATA_ADD_EVENT_VALUE *pValue);
+
+  /* function: sdnpjrnl_eventRemoved
+   * purpose: Journal an event removed from one of a session's queues.
+   * arguments:
+   *  pSession - session
+   *  group - object group of the event
+   *  pEvent - event
+   *  reason - SDNPJRNL_REMOVED_CONFIRMED, SDNPJRNL_REMOVED_OVERFLOW or
+   *   SDNPJRNL_REMOVED_REPLACED
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpjrnl_eventRemoved(
+    TMWSESN *pSession,
+    TMWTYPES_UCHAR group,
+    SDNPEVNT *pEvent,
+    TMWTYPES_UCHAR reason);
+
+  /* function: sdnpjrnl_sequenceChanged
+   * purpose: Journal a new unsolicited sequence number. Called by
+   *  sdnpunsl when it builds an unsolicited response.
+   * arguments:
+   *  pSession - session
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpjrnl_sequenceChanged(
+    TMWSESN *pSession);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TMWTARG_SUPPORT_JOURNAL */
+#endif /* SDNPJRNL_DEFINED */
@@ -48,6 +48,7 @@
 #include "tmwscl/dnp/sdnpo113.h"
 #if TMWCNFG_USE_SIMULATED_DB
 #include "tmwscl/dnp/sdnpsim.h"
+#include "tmwscl/dnp/sdnpsevt.h"
 #endif
 #if SDNPDATA_SUPPORT_OBJ120
 #include "tmwscl/dnp/sdnpauth.h"
@@ -205,6 +206,11 @@ typedef struct{
   TMWMEM_HEADER               header;
   SDNPSIM_EVENT               databuf;
 } SDNPMEM_SIM_UMEVENT;
+
+typedef struct{
+  TMWMEM_HEADER               header;
+  SDNPSEVT_PAYLOAD            databuf;
+} SDNPMEM_SIM_SHARED_EVENT;
 #endif
 
 #if SDNPDATA_SUPPORT_DATASETS
@@ -309,6 +315,7 @@ static const TMWTYPES_CHAR *_nameTable[SDNPMEM_ALLOC_TYPE_MAX] = {
   , "SDNPSIM_DATABASE"
 #if SDNPCNFG_USER_MANAGED_EVENTS
   , "SDNPSIM_UMEVENT"
+  , "SDNPSEVT_PAYLOAD"
 #endif
 #if SDNPDATA_SUPPORT_DATASETS
   , "SDNPSIM_DATASET_PROTO" 
@@ -388,6 +395,7 @@ static SDNPMEM_AUTH_USER        sdnpmem_authUsers[SDNPCNFG_NUMALLOC_AUTH_USERS];
 static SDNPMEM_SIM_DATABASE     sdnpmem_simDbases[SDNPCNFG_NUMALLOC_SIM_DATABASES];
 #if SDNPCNFG_USER_MANAGED_EVENTS
 static SDNPMEM_SIM_UMEVENT      sdnpmem_simUMEvents[SDNPCNFG_NUMALLOC_SIM_UMEVENTS];
+static SDNPMEM_SIM_SHARED_EVENT sdnpmem_simSharedEvents[SDNPCNFG_NUMALLOC_SIM_SHARED_EVENTS];
 #endif
 #if SDNPDATA_SUPPORT_DATASETS
 static SDNPMEM_SIM_DATASET_PROTO  sdnpmem_simDatasetProtos[SDNPCNFG_NUMALLOC_SIM_DATASETS];
@@ -468,6 +476,7 @@ static void TMWDEFS_LOCAL _initConfig(
   pConfig->numSimDbases       = SDNPCNFG_NUMALLOC_SIM_DATABASES;
 #if SDNPCNFG_USER_MANAGED_EVENTS
   pConfig->numSimUMEvents     = SDNPCNFG_NUMALLOC_SIM_UMEVENTS;
+  pConfig->numSimSharedEvents = SDNPCNFG_NUMALLOC_SIM_SHARED_EVENTS;
 #endif
 #if SDNPDATA_SUPPORT_DATASETS
   pConfig->numSimDatasets     = SDNPCNFG_NUMALLOC_SIM_DATASETS;
@@ -625,6 +634,8 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmem_init(
 #if SDNPCNFG_USER_MANAGED_EVENTS
   if(!tmwmem_lowInit(_sdnpmemAllocTable, SDNPMEM_SIM_UMEVENT_TYPE,     pConfig->numSimUMEvents,     sizeof(SDNPMEM_SIM_UMEVENT),     TMWDEFS_NULL))
     return TMWDEFS_FALSE;
+  if(!tmwmem_lowInit(_sdnpmemAllocTable, SDNPMEM_SIM_SHARED_EVENT_TYPE, pConfig->numSimSharedEvents, sizeof(SDNPMEM_SIM_SHARED_EVENT), TMWDEFS_NULL))
+    return TMWDEFS_FALSE;
 #endif
 #if SDNPDATA_SUPPORT_DATASETS
   if(!tmwmem_lowInit(_sdnpmemAllocTable, SDNPMEM_SIM_DSET_PROTO_TYPE,  pConfig->numSimDatasets,    sizeof(SDNPMEM_SIM_DATASET_PROTO), TMWDEFS_NULL))
@@ -728,6 +739,8 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmem_init(
 #if SDNPCNFG_USER_MANAGED_EVENTS
   if(!tmwmem_lowInit(_sdnpmemAllocTable, SDNPMEM_SIM_UMEVENT_TYPE,     SDNPCNFG_NUMALLOC_SIM_UMEVENTS,     sizeof(SDNPMEM_SIM_UMEVENT),     (TMWTYPES_UCHAR *)sdnpmem_simUMEvents))
     return TMWDEFS_FALSE;
+  if(!tmwmem_lowInit(_sdnpmemAllocTable, SDNPMEM_SIM_SHARED_EVENT_TYPE, SDNPCNFG_NUMALLOC_SIM_SHARED_EVENTS, sizeof(SDNPMEM_SIM_SHARED_EVENT), (TMWTYPES_UCHAR *)sdnpmem_simSharedEvents))
+    return TMWDEFS_FALSE;
 #endif
 #if SDNPDATA_SUPPORT_DATASETS
   if(!tmwmem_lowInit(_sdnpmemAllocTable, SDNPMEM_SIM_DSET_PROTO_TYPE,   SDNPCNFG_NUMALLOC_SIM_DATASETS,    sizeof(SDNPMEM_SIM_DATASET_PROTO), (TMWTYPES_UCHAR *)sdnpmem_simDatasetProtos))
@@ -97,6 +97,7 @@ typedef enum SdnpMemAllocType {
   SDNPMEM_SIM_DATABASE_TYPE,
 #if SDNPCNFG_USER_MANAGED_EVENTS
   SDNPMEM_SIM_UMEVENT_TYPE,
+  SDNPMEM_SIM_SHARED_EVENT_TYPE,
 #endif
 #if SDNPDATA_SUPPORT_DATASETS
   SDNPMEM_SIM_DSET_PROTO_TYPE,
@@ -162,6 +163,11 @@ typedef struct {
    * event queues implemented in the simulated database.
    */
   TMWTYPES_UINT numSimUMEvents;
+  /* Specify number of events that can be kept in shared event stores,
+   * see sdnpsevt.h. Each event is counted once however many sessions
+   * it was queued for.
+   */
+  TMWTYPES_UINT numSimSharedEvents;
   /* Specify number of simulated Slave DNP Data Set structures that can be 
    * allocated. These are not needed once your actual database is implemented.
    */
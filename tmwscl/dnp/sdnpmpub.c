@@ -0,0 +1,472 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+
+/* file: sdnpmpub.c
+ * description: Point values published to an MQTT broker over several
+ *  connections. See sdnpmpub.h.
+ */
+#include "tmwscl/dnp/sdnpmpub.h"
+
+#if SDNPCNFG_SUPPORT_MQTT_PUBLISHER
+#include "tmwscl/dnp/dnpdtime.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpsesp.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/* Defaults */
+#define SDNPMPUB_DEFAULT_SEND_BUFFER_SIZE  8192
+#define SDNPMPUB_DEFAULT_RECV_BUFFER_SIZE  256
+#define SDNPMPUB_DEFAULT_KEEP_ALIVE        400
+#define SDNPMPUB_DEFAULT_SYNC_INTERVAL     10
+#define SDNPMPUB_DEFAULT_RECONNECT_DELAY   5000
+
+/* Longest point event topic and message, including the terminating null */
+#define SDNPMPUB_MAX_TOPIC_LEN    (SDNPMPUB_MAX_PREFIX_LEN + 24)
+#define SDNPMPUB_MAX_MESSAGE_LEN  80
+
+/* Largest PUBLISH fixed header, topic length and packet identifier */
+#define SDNPMPUB_PUBLISH_OVERHEAD 9
+
+/* Space a connection's thread may take between a publisher checking for
+ * room and queueing its message, for a PINGREQ or a PUBREL
+ */
+#define SDNPMPUB_SPARE_SPACE      (4 + sizeof(struct mqtt_queued_message))
+
+/* function: _hashTopic
+ *  FNV-1a hash of a topic
+ */
+static TMWTYPES_ULONG TMWDEFS_LOCAL _hashTopic(
+  const TMWTYPES_CHAR *pTopic)
+{
+  TMWTYPES_ULONG hash = 2166136261UL;
+
+  while(*pTopic != '\0')
+  {
+    hash ^= (TMWTYPES_UCHAR)*pTopic++;
+    hash = (hash * 16777619UL) & 0xffffffffUL;
+  }
+
+  return(hash);
+}
+
+/* function: _publishCallback
+ *  Nothing is subscribed to, so nothing is received
+ */
+static void _publishCallback(
+  void **ppState,
+  struct mqtt_response_publish *pPublish)
+{
+  TMWTARG_UNUSED_PARAM(ppState);
+  TMWTARG_UNUSED_PARAM(pPublish);
+}
+
+/* function: _reconnect
+ *  Called by mqtt_sync, with the client locked, to open the connection
+ *  and whenever it fails. If the connection is not opened the client
+ *  stays in its error state and this is called again on the next sync.
+ */
+static void _reconnect(
+  struct mqtt_client *pClient,
+  void **ppState)
+{
+  SDNPMPUB_CONNECTION *pConnection = (SDNPMPUB_CONNECTION *)*ppState;
+  SDNPMPUB_CONFIG *pConfig = &pConnection->pPublisher->config;
+  TMWTYPES_CHAR clientId[SDNPMPUB_MAX_CLIENT_ID_LEN + 8];
+  TMWTYPES_MILLISECONDS now = tmwtarg_getMSTime();
+
+  pConnection->stats.connected = 0;
+
+  /* Do not hammer a broker that is down */
+  if(pConnection->attempted
+    && ((TMWTYPES_MILLISECONDS)(now - pConnection->lastAttempt) < pConfig->reconnectDelay))
+  {
+    return;
+  }
+  pConnection->attempted = TMWDEFS_TRUE;
+  pConnection->lastAttempt = now;
+  pConnection->stats.connects++;
+
+  if(pConnection->socketOpen)
+  {
+    pConfig->pCloseFunc(pConfig->pCallbackParam, pConnection->socketfd);
+    pConnection->socketOpen = TMWDEFS_FALSE;
+  }
+
+  pConnection->socketfd = pConfig->pOpenFunc(pConfig->pCallbackParam, pConnection->index);
+  if(pConnection->socketfd == (mqtt_pal_socket_handle)-1)
+    return;
+  pConnection->socketOpen = TMWDEFS_TRUE;
+
+  /* Messages queued on the old connection are dropped */
+  mqtt_reinit(pClient, pConnection->socketfd,
+    pConnection->pSendBuffer, pConfig->sendBufferSize,
+    pConnection->pRecvBuffer, pConfig->recvBufferSize);
+
+  if(pConfig->clientId[0] != '\0')
+    snprintf(clientId, sizeof(clientId), "%s-%u", pConfig->clientId, pConnection->index);
+  else
+    clientId[0] = '\0';
+
+  /* Unlocks the client */
+  mqtt_connect(pClient, clientId, TMWDEFS_NULL, TMWDEFS_NULL, 0, TMWDEFS_NULL, TMWDEFS_NULL,
+    MQTT_CONNECT_CLEAN_SESSION, pConfig->keepAlive);
+}
+
+/* function: _syncConnection */
+static void TMWDEFS_LOCAL _syncConnection(
+  SDNPMPUB_CONNECTION *pConnection)
+{
+  /* Errors are handled by _reconnect on the next call */
+  mqtt_sync(&pConnection->client);
+
+  MQTT_PAL_MUTEX_LOCK(&pConnection->client.mutex);
+  pConnection->stats.connected = (pConnection->client.error == MQTT_OK) ? 1 : 0;
+  MQTT_PAL_MUTEX_UNLOCK(&pConnection->client.mutex);
+}
+
+#if TMWCNFG_SUPPORT_THREADS
+/* function: _connectionThread */
+static TMW_ThreadDecl _connectionThread(
+  TMW_ThreadArg pArg)
+{
+  SDNPMPUB_CONNECTION *pConnection = (SDNPMPUB_CONNECTION *)pArg;
+
+  while(pConnection->threadState == TMWTARG_THREAD_RUNNING)
+  {
+    _syncConnection(pConnection);
+    tmwtarg_sleep(pConnection->pPublisher->config.syncInterval);
+  }
+  pConnection->threadState = TMWTARG_THREAD_EXITED;
+
+  return((TMW_ThreadPtr)TMWDEFS_NULL);
+}
+#endif
+
+/* function: _openConnection */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _openConnection(
+  SDNPMPUB *pPublisher,
+  TMWTYPES_UINT index)
+{
+  SDNPMPUB_CONNECTION *pConnection = &pPublisher->connections[index];
+
+  pConnection->pPublisher = pPublisher;
+  pConnection->index = index;
+  pConnection->socketfd = (mqtt_pal_socket_handle)-1;
+
+  pConnection->pSendBuffer = (TMWTYPES_UCHAR *)tmwtarg_alloc(pPublisher->config.sendBufferSize);
+  pConnection->pRecvBuffer = (TMWTYPES_UCHAR *)tmwtarg_alloc(pPublisher->config.recvBufferSize);
+  if((pConnection->pSendBuffer == TMWDEFS_NULL)
+    || (pConnection->pRecvBuffer == TMWDEFS_NULL))
+  {
+    if(pConnection->pSendBuffer != TMWDEFS_NULL)
+      tmwtarg_free(pConnection->pSendBuffer);
+    if(pConnection->pRecvBuffer != TMWDEFS_NULL)
+      tmwtarg_free(pConnection->pRecvBuffer);
+    return(TMWDEFS_FALSE);
+  }
+
+  TMWTARG_LOCK_INIT(&pConnection->lock);
+
+  /* Connected by _reconnect on the first sync */
+  mqtt_init_reconnect(&pConnection->client, _reconnect, pConnection, _publishCallback);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _closeConnection */
+static void TMWDEFS_LOCAL _closeConnection(
+  SDNPMPUB_CONNECTION *pConnection)
+{
+  SDNPMPUB_CONFIG *pConfig = &pConnection->pPublisher->config;
+
+#if TMWCNFG_SUPPORT_THREADS
+  if(pConnection->threadState == TMWTARG_THREAD_RUNNING)
+  {
+    pConnection->threadState = TMWTARG_THREAD_EXITING;
+    while(pConnection->threadState > TMWTARG_THREAD_EXITED)
+      tmwtarg_sleep(pConfig->syncInterval);
+  }
+#endif
+
+  if(pConnection->socketOpen)
+  {
+    /* Send what is queued, then tell the broker we are leaving */
+    if(mqtt_disconnect(&pConnection->client) == MQTT_OK)
+      __mqtt_send(&pConnection->client);
+
+    pConfig->pCloseFunc(pConfig->pCallbackParam, pConnection->socketfd);
+    pConnection->socketOpen = TMWDEFS_FALSE;
+  }
+
+  TMWTARG_LOCK_DELETE(&pConnection->lock);
+  tmwtarg_free(pConnection->pSendBuffer);
+  tmwtarg_free(pConnection->pRecvBuffer);
+}
+
+/* function: sdnpmpub_initConfig */
+void TMWDEFS_GLOBAL sdnpmpub_initConfig(
+  SDNPMPUB_CONFIG *pConfig)
+{
+  memset(pConfig, 0, sizeof(SDNPMPUB_CONFIG));
+  pConfig->numConnections = 4;
+  strcpy(pConfig->topicPrefix, "dnp");
+  pConfig->qos = MQTT_PUBLISH_QOS_0;
+  pConfig->keepAlive = SDNPMPUB_DEFAULT_KEEP_ALIVE;
+  pConfig->sendBufferSize = SDNPMPUB_DEFAULT_SEND_BUFFER_SIZE;
+  pConfig->recvBufferSize = SDNPMPUB_DEFAULT_RECV_BUFFER_SIZE;
+  pConfig->syncInterval = SDNPMPUB_DEFAULT_SYNC_INTERVAL;
+  pConfig->reconnectDelay = SDNPMPUB_DEFAULT_RECONNECT_DELAY;
+  pConfig->startThreads = TMWCNFG_SUPPORT_THREADS ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+}
+
+/* function: sdnpmpub_create */
+SDNPMPUB * TMWDEFS_GLOBAL sdnpmpub_create(
+  const SDNPMPUB_CONFIG *pConfig)
+{
+  SDNPMPUB *pPublisher;
+  TMWTYPES_UINT i;
+
+  if((pConfig->numConnections == 0)
+    || (pConfig->numConnections > SDNPMPUB_MAX_CONNECTIONS)
+    || (pConfig->pOpenFunc == TMWDEFS_NULL)
+    || (pConfig->pCloseFunc == TMWDEFS_NULL))
+  {
+    return(TMWDEFS_NULL);
+  }
+
+  pPublisher = (SDNPMPUB *)tmwtarg_alloc(sizeof(SDNPMPUB));
+  if(pPublisher == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  memset(pPublisher, 0, sizeof(SDNPMPUB));
+  pPublisher->config = *pConfig;
+  pPublisher->config.clientId[SDNPMPUB_MAX_CLIENT_ID_LEN - 1] = '\0';
+  pPublisher->config.topicPrefix[SDNPMPUB_MAX_PREFIX_LEN - 1] = '\0';
+
+  for(i = 0; i < pConfig->numConnections; i++)
+  {
+    if(!_openConnection(pPublisher, i))
+    {
+      /* Only close the connections that were opened */
+      pPublisher->config.numConnections = i;
+      sdnpmpub_destroy(pPublisher);
+      return(TMWDEFS_NULL);
+    }
+  }
+
+#if TMWCNFG_SUPPORT_THREADS
+  if(pPublisher->config.startThreads)
+  {
+    for(i = 0; i < pConfig->numConnections; i++)
+    {
+      SDNPMPUB_CONNECTION *pConnection = &pPublisher->connections[i];
+      pConnection->threadState = TMWTARG_THREAD_RUNNING;
+      TMW_ThreadCreate(&pConnection->threadId, _connectionThread,
+        (TMW_ThreadArg)pConnection, 0, 0);
+    }
+  }
+#endif
+
+  return(pPublisher);
+}
+
+/* function: sdnpmpub_destroy */
+void TMWDEFS_GLOBAL sdnpmpub_destroy(
+  SDNPMPUB *pPublisher)
+{
+  TMWTYPES_UINT i;
+
+  if(pPublisher == TMWDEFS_NULL)
+    return;
+
+  for(i = 0; i < pPublisher->config.numConnections; i++)
+    _closeConnection(&pPublisher->connections[i]);
+
+  tmwtarg_free(pPublisher);
+}
+
+/* function: sdnpmpub_connectionIndex */
+TMWTYPES_UINT TMWDEFS_GLOBAL sdnpmpub_connectionIndex(
+  SDNPMPUB *pPublisher,
+  const TMWTYPES_CHAR *pTopic)
+{
+  return((TMWTYPES_UINT)(_hashTopic(pTopic) % pPublisher->config.numConnections));
+}
+
+/* function: sdnpmpub_publish */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmpub_publish(
+  SDNPMPUB *pPublisher,
+  const TMWTYPES_CHAR *pTopic,
+  const void *pMessage,
+  TMWTYPES_UINT size)
+{
+  SDNPMPUB_CONNECTION *pConnection;
+  struct mqtt_client *pClient;
+  TMWTYPES_BOOL queued = TMWDEFS_FALSE;
+  TMWTYPES_BOOL online;
+  enum MQTTErrors status;
+  size_t needed;
+  size_t space;
+
+  pConnection = &pPublisher->connections[sdnpmpub_connectionIndex(pPublisher, pTopic)];
+  pClient = &pConnection->client;
+  needed = SDNPMPUB_PUBLISH_OVERHEAD + strlen(pTopic) + size + SDNPMPUB_SPARE_SPACE;
+
+  TMWTARG_LOCK_SECTION(&pConnection->lock);
+
+  /* A full send buffer is an error the client only leaves by reconnecting,
+   * so check for room first rather than let mqtt_publish fail
+   */
+  MQTT_PAL_MUTEX_LOCK(&pClient->mutex);
+  online = (pClient->error == MQTT_OK) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+  if(online && (pClient->mq.curr_sz < needed))
+    mqtt_mq_clean(&pClient->mq);
+  space = pClient->mq.curr_sz;
+  MQTT_PAL_MUTEX_UNLOCK(&pClient->mutex);
+
+  if(!online)
+  {
+    pConnection->stats.droppedOffline++;
+  }
+  else if(space < needed)
+  {
+    pConnection->stats.dropped++;
+  }
+  else
+  {
+    status = mqtt_publish(pClient, pTopic, pMessage, size, pPublisher->config.qos);
+    if(status == MQTT_OK)
+    {
+      pConnection->stats.published++;
+      queued = TMWDEFS_TRUE;
+    }
+    else if(status == MQTT_ERROR_SEND_BUFFER_IS_FULL)
+    {
+      /* The connection's thread took the spare space after all */
+      MQTT_PAL_MUTEX_LOCK(&pClient->mutex);
+      if(pClient->error == MQTT_ERROR_SEND_BUFFER_IS_FULL)
+        pClient->error = MQTT_OK;
+      MQTT_PAL_MUTEX_UNLOCK(&pClient->mutex);
+      pConnection->stats.dropped++;
+    }
+    else
+    {
+      pConnection->stats.droppedOffline++;
+    }
+  }
+
+  TMWTARG_UNLOCK_SECTION(&pConnection->lock);
+  return(queued);
+}
+
+/* function: sdnpmpub_sync */
+void TMWDEFS_GLOBAL sdnpmpub_sync(
+  SDNPMPUB *pPublisher)
+{
+  TMWTYPES_UINT i;
+
+  for(i = 0; i < pPublisher->config.numConnections; i++)
+    _syncConnection(&pPublisher->connections[i]);
+}
+
+/* function: sdnpmpub_getStats */
+void TMWDEFS_GLOBAL sdnpmpub_getStats(
+  SDNPMPUB *pPublisher,
+  TMWTYPES_UINT index,
+  SDNPMPUB_STATS *pStats)
+{
+  TMWTYPES_UINT i;
+
+  if(index < pPublisher->config.numConnections)
+  {
+    *pStats = pPublisher->connections[index].stats;
+    return;
+  }
+
+  memset(pStats, 0, sizeof(SDNPMPUB_STATS));
+  for(i = 0; i < pPublisher->config.numConnections; i++)
+  {
+    SDNPMPUB_STATS *pConnectionStats = &pPublisher->connections[i].stats;
+    pStats->published += pConnectionStats->published;
+    pStats->dropped += pConnectionStats->dropped;
+    pStats->droppedOffline += pConnectionStats->droppedOffline;
+    pStats->connects += pConnectionStats->connects;
+    pStats->connected += pConnectionStats->connected;
+  }
+}
+
+/* function: sdnpmpub_attachSession */
+void TMWDEFS_GLOBAL sdnpmpub_attachSession(
+  TMWSESN *pSession,
+  SDNPMPUB *pPublisher)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  pSDNPSession->pMqttPublisher = pPublisher;
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+}
+
+/* function: sdnpmpub_pointEvent */
+void TMWDEFS_GLOBAL sdnpmpub_pointEvent(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_DOUBLE value,
+  TMWTYPES_UCHAR flags,
+  const TMWDTIME *pTimeStamp)
+{
+  SDNPMPUB *pPublisher = (SDNPMPUB *)((SDNPSESN *)pSession)->pMqttPublisher;
+  TMWTYPES_CHAR topic[SDNPMPUB_MAX_TOPIC_LEN];
+  TMWTYPES_CHAR message[SDNPMPUB_MAX_MESSAGE_LEN];
+  int length;
+
+  if(pPublisher == TMWDEFS_NULL)
+    return;
+
+  snprintf(topic, sizeof(topic), "%s/%u/%u/%u",
+    pPublisher->config.topicPrefix, pSession->srcAddress, group, point);
+
+  if(pTimeStamp != TMWDEFS_NULL)
+  {
+    TMWTYPES_MS_SINCE_70 msSince70;
+    TMWTYPES_UINT64 ms;
+
+    dnpdtime_dateTimeToMSSince70(&msSince70, pTimeStamp);
+    ms = ((TMWTYPES_UINT64)msSince70.mostSignificant << 16) | msSince70.leastSignificant;
+    length = snprintf(message, sizeof(message), "value=%.15g flags=%u time=%llu",
+      value, flags, (unsigned long long)ms);
+  }
+  else
+  {
+    length = snprintf(message, sizeof(message), "value=%.15g flags=%u", value, flags);
+  }
+
+  if((length > 0) && ((size_t)length < sizeof(message)))
+    sdnpmpub_publish(pPublisher, topic, message, (TMWTYPES_UINT)length);
+}
+
+#endif /* SDNPCNFG_SUPPORT_MQTT_PUBLISHER */
@@ -0,0 +1,321 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+
+/* file: sdnpmpub.h
+ * description: Point values published to an MQTT broker over several
+ *  connections.
+ *  A single MQTT client has one socket and one send buffer, so every
+ *  session publishing through it waits on the same lock, and one slow
+ *  broker connection or a full send buffer holds up all of them. A
+ *  publisher spreads its topics over up to SDNPMPUB_MAX_CONNECTIONS
+ *  independent connections to the broker, each with its own client,
+ *  buffers and socket, and with TMWCNFG_SUPPORT_THREADS its own thread
+ *  sending and receiving for it.
+ *
+ *  Each topic is always published on the same connection, chosen by a
+ *  hash of the topic, so the messages of one topic reach the broker in
+ *  the order they were published. Messages of different topics may be
+ *  reordered.
+ *
+ *  Publishing never waits for the network. A message that does not fit
+ *  in the send buffer of its connection, or that is published while the
+ *  connection is down, is dropped and counted.
+ *
+ *  The application supplies functions to open and close the socket of a
+ *  connection, and the publisher reconnects through them, no more often
+ *  than reconnectDelay, when a connection fails. Sessions attached with
+ *  sdnpmpub_attachSession publish their analog input events (object 32)
+ *  as
+ *     <topicPrefix>/<session address>/32/<point>
+ *  with a message
+ *     value=12.5 flags=1 time=1603110000123
+ *  where time is milliseconds since 1970, and the application can
+ *  publish anything else with sdnpmpub_publish.
+ */
+#ifndef SDNPMPUB_DEFINED
+#define SDNPMPUB_DEFINED
+
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwsesn.h"
+#include "tmwscl/utils/tmwdtime.h"
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/dnp/sdnpcnfg.h"
+
+#if SDNPCNFG_SUPPORT_MQTT_PUBLISHER
+#include <mqtt.h>
+
+/* Most broker connections of one publisher */
+#define SDNPMPUB_MAX_CONNECTIONS   16
+
+/* Longest topic prefix and client id, including the terminating null */
+#define SDNPMPUB_MAX_PREFIX_LEN    64
+#define SDNPMPUB_MAX_CLIENT_ID_LEN 48
+
+/* Open a socket connected to the broker for connection index, returns
+ * (mqtt_pal_socket_handle)-1 if it could not be opened. The socket must
+ * be non-blocking, as for mqtt_init.
+ */
+typedef mqtt_pal_socket_handle (*SDNPMPUB_OPEN_FUNC)(
+  void *pParam,
+  TMWTYPES_UINT index);
+
+/* Close a socket returned by the open function */
+typedef void (*SDNPMPUB_CLOSE_FUNC)(
+  void *pParam,
+  mqtt_pal_socket_handle socketfd);
+
+/* Publisher configuration */
+typedef struct SDNPMPubConfigStruct {
+  /* Number of broker connections, 1 to SDNPMPUB_MAX_CONNECTIONS */
+  TMWTYPES_UINT numConnections;
+
+  /* Client id of the connections, followed by -<index>. If empty each
+   * connection is given an id by the broker.
+   */
+  TMWTYPES_CHAR clientId[SDNPMPUB_MAX_CLIENT_ID_LEN];
+
+  /* First level of the topics point events are published on */
+  TMWTYPES_CHAR topicPrefix[SDNPMPUB_MAX_PREFIX_LEN];
+
+  /* MQTT_PUBLISH_QOS_0, MQTT_PUBLISH_QOS_1 or MQTT_PUBLISH_QOS_2 */
+  TMWTYPES_UCHAR qos;
+
+  /* MQTT keep alive of each connection, in seconds */
+  TMWTYPES_USHORT keepAlive;
+
+  /* Size of the send and receive buffers of each connection. The send
+   * buffer holds the messages that have not been sent yet, and with QoS
+   * 1 or 2 those that have not been acknowledged.
+   */
+  TMWTYPES_UINT sendBufferSize;
+  TMWTYPES_UINT recvBufferSize;
+
+  /* How often the thread of each connection sends and receives */
+  TMWTYPES_MILLISECONDS syncInterval;
+
+  /* Shortest time between attempts to connect a connection */
+  TMWTYPES_MILLISECONDS reconnectDelay;
+
+  /* Start a thread for each connection. If this is TMWDEFS_FALSE, or
+   * TMWCNFG_SUPPORT_THREADS is not set, the application must call
+   * sdnpmpub_sync instead.
+   */
+  TMWTYPES_BOOL startThreads;
+
+  /* Functions to open and close the socket of a connection */
+  SDNPMPUB_OPEN_FUNC pOpenFunc;
+  SDNPMPUB_CLOSE_FUNC pCloseFunc;
+  void *pCallbackParam;
+} SDNPMPUB_CONFIG;
+
+/* Counters of one connection, or of all of them */
+typedef struct SDNPMPubStatsStruct {
+  /* Messages queued to be sent */
+  TMWTYPES_ULONG published;
+
+  /* Messages dropped because the send buffer was full */
+  TMWTYPES_ULONG dropped;
+
+  /* Messages dropped because the connection was down */
+  TMWTYPES_ULONG droppedOffline;
+
+  /* Attempts to connect, including the first */
+  TMWTYPES_ULONG connects;
+
+  /* Connections currently accepted by the broker */
+  TMWTYPES_ULONG connected;
+} SDNPMPUB_STATS;
+
+/* One broker connection */
+typedef struct SDNPMPubConnectionStruct {
+  struct SDNPMPubStruct *pPublisher;
+  TMWTYPES_UINT index;
+
+  struct mqtt_client client;
+  TMWTYPES_UCHAR *pSendBuffer;
+  TMWTYPES_UCHAR *pRecvBuffer;
+
+  /* Socket returned by the open function, closed on the next reconnect */
+  mqtt_pal_socket_handle socketfd;
+  TMWTYPES_BOOL socketOpen;
+
+  /* When the last attempt to connect was made */
+  TMWTYPES_BOOL attempted;
+  TMWTYPES_MILLISECONDS lastAttempt;
+
+  /* Serializes the publishers of this connection, so the space checked
+   * for a message is still free when it is queued
+   */
+  TMWDEFS_RESOURCE_LOCK lock;
+
+  SDNPMPUB_STATS stats;
+
+#if TMWCNFG_SUPPORT_THREADS
+  TMW_ThreadId threadId;
+  volatile TMWTARG_THREAD_STATE threadState;
+#endif
+} SDNPMPUB_CONNECTION;
+
+/* A publisher */
+typedef struct SDNPMPubStruct {
+  SDNPMPUB_CONFIG config;
+  SDNPMPUB_CONNECTION connections[SDNPMPUB_MAX_CONNECTIONS];
+} SDNPMPUB;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnpmpub_initConfig
+   * purpose: Initialize a publisher configuration to the defaults
+   * arguments:
+   *  pConfig - configuration to initialize
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmpub_initConfig(
+    SDNPMPUB_CONFIG *pConfig);
+
+  /* function: sdnpmpub_create
+   * purpose: Create a publisher and start connecting to the broker. The
+   *  connections are opened by their threads, or by sdnpmpub_sync.
+   * arguments:
+   *  pConfig - publisher configuration, pOpenFunc and pCloseFunc must be
+   *   set
+   * returns:
+   *  The publisher, or TMWDEFS_NULL if it could not be created
+   */
+  TMWDEFS_SCL_API SDNPMPUB * TMWDEFS_GLOBAL sdnpmpub_create(
+    const SDNPMPUB_CONFIG *pConfig);
+
+  /* function: sdnpmpub_destroy
+   * purpose: Stop the threads, close the sockets and free a publisher.
+   *  Detach every session from it first.
+   * arguments:
+   *  pPublisher - publisher returned by sdnpmpub_create
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmpub_destroy(
+    SDNPMPUB *pPublisher);
+
+  /* function: sdnpmpub_publish
+   * purpose: Queue a message on the connection the topic belongs to.
+   *  This does not wait for the network and may be called from any
+   *  thread.
+   * arguments:
+   *  pPublisher - publisher
+   *  pTopic - topic to publish on
+   *  pMessage - message
+   *  size - size of the message in bytes
+   * returns:
+   *  TMWDEFS_TRUE if the message was queued, TMWDEFS_FALSE if it was
+   *  dropped
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmpub_publish(
+    SDNPMPUB *pPublisher,
+    const TMWTYPES_CHAR *pTopic,
+    const void *pMessage,
+    TMWTYPES_UINT size);
+
+  /* function: sdnpmpub_connectionIndex
+   * purpose: Get the connection a topic is published on
+   * arguments:
+   *  pPublisher - publisher
+   *  pTopic - topic
+   * returns:
+   *  index of the connection
+   */
+  TMWDEFS_SCL_API TMWTYPES_UINT TMWDEFS_GLOBAL sdnpmpub_connectionIndex(
+    SDNPMPUB *pPublisher,
+    const TMWTYPES_CHAR *pTopic);
+
+  /* function: sdnpmpub_sync
+   * purpose: Send and receive on every connection, reconnecting those
+   *  that failed. Only needed when the publisher has no threads.
+   * arguments:
+   *  pPublisher - publisher
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmpub_sync(
+    SDNPMPUB *pPublisher);
+
+  /* function: sdnpmpub_getStats
+   * purpose: Get the counters of a connection, or the sum over all of
+   *  them
+   * arguments:
+   *  pPublisher - publisher
+   *  index - connection index, or SDNPMPUB_MAX_CONNECTIONS for all
+   *  pStats - returns the counters
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmpub_getStats(
+    SDNPMPUB *pPublisher,
+    TMWTYPES_UINT index,
+    SDNPMPUB_STATS *pStats);
+
+  /* function: sdnpmpub_attachSession
+   * purpose: Publish the point events of a session, or stop publishing
+   *  them
+   * arguments:
+   *  pSession - session
+   *  pPublisher - publisher, or TMWDEFS_NULL to detach the session
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmpub_attachSession(
+    TMWSESN *pSession,
+    SDNPMPUB *pPublisher);
+
+  /* function: sdnpmpub_pointEvent
+   * purpose: Publish an event of a session attached to a publisher.
+   *  Called by the xxx_addEvent functions, does nothing if the session is
+   *  not attached.
+   * arguments:
+   *  pSession - session the event was added to
+   *  group - DNP object group of the event
+   *  point - point number
+   *  value - value of the point
+   *  flags - DNP flags of the point
+   *  pTimeStamp - time of the event, or TMWDEFS_NULL
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpmpub_pointEvent(
+    TMWSESN *pSession,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point,
+    TMWTYPES_DOUBLE value,
+    TMWTYPES_UCHAR flags,
+    const TMWDTIME *pTimeStamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDNPCNFG_SUPPORT_MQTT_PUBLISHER */
+#endif /* SDNPMPUB_DEFINED */
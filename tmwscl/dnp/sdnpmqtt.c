@@ -0,0 +1,679 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+
+/* file: sdnpmqtt.c
+ * description: Binary and analog output commands received over MQTT.
+ *  See sdnpmqtt.h.
+ */
+#include "tmwscl/dnp/sdnpmqtt.h"
+
+#if SDNPCNFG_SUPPORT_MQTT_COMMANDS
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/dnp/dnpdefs.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpsesp.h"
+#include "tmwscl/dnp/sdnpdata.h"
+#include "tmwscl/dnp/sdnputil.h"
+#include "tmwscl/dnp/sdnpo011.h"
+#include "tmwscl/dnp/sdnpo043.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Default time to wait for the result of an ASYNC control */
+#define SDNPMQTT_DEFAULT_ASYNC_TIMEOUT 10000
+
+/* Longest value of a name=value pair */
+#define SDNPMQTT_MAX_VALUE_LEN         32
+
+/* Names accepted for the control code of a binary output command */
+typedef struct {
+  const TMWTYPES_CHAR *pName;
+  TMWTYPES_UCHAR controlCode;
+} SDNPMQTT_CODE_NAME;
+
+static const SDNPMQTT_CODE_NAME _codeNames[] = {
+  {"pulse_on",  DNPDEFS_CROB_CTRL_PULSE_ON},
+  {"pulse_off", DNPDEFS_CROB_CTRL_PULSE_OFF},
+  {"latch_on",  DNPDEFS_CROB_CTRL_LATCH_ON},
+  {"latch_off", DNPDEFS_CROB_CTRL_LATCH_OFF},
+  {"close",     DNPDEFS_CROB_CTRL_PAIRED_CLOSE | DNPDEFS_CROB_CTRL_PULSE_ON},
+  {"trip",      DNPDEFS_CROB_CTRL_PAIRED_TRIP | DNPDEFS_CROB_CTRL_PULSE_ON}
+};
+
+/* function: _getMqtt */
+static SDNPMQTT * TMWDEFS_LOCAL _getMqtt(
+  TMWSESN *pSession)
+{
+  return((SDNPMQTT *)((SDNPSESN *)pSession)->pMqttCommands);
+}
+
+/* function: _getField
+ *  Copy the value of name=value from a command, returns TMWDEFS_FALSE if
+ *  the command does not have the field or its value is too long
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _getField(
+  const TMWTYPES_CHAR *pCommand,
+  const TMWTYPES_CHAR *pName,
+  TMWTYPES_CHAR *pValue,
+  TMWTYPES_UINT valueSize)
+{
+  size_t nameLen = strlen(pName);
+  const TMWTYPES_CHAR *p = pCommand;
+
+  while(*p != '\0')
+  {
+    const TMWTYPES_CHAR *pEnd;
+
+    while(*p == ' ')
+      p++;
+
+    pEnd = p;
+    while((*pEnd != ' ') && (*pEnd != '\0'))
+      pEnd++;
+
+    if(((size_t)(pEnd - p) > nameLen)
+      && (strncmp(p, pName, nameLen) == 0)
+      && (p[nameLen] == '='))
+    {
+      size_t len = (size_t)(pEnd - p) - nameLen - 1;
+      if(len >= valueSize)
+        return(TMWDEFS_FALSE);
+
+      memcpy(pValue, p + nameLen + 1, len);
+      pValue[len] = '\0';
+      return(TMWDEFS_TRUE);
+    }
+
+    p = pEnd;
+  }
+
+  return(TMWDEFS_FALSE);
+}
+
+/* function: _getULong
+ *  Get an unsigned decimal number from a command, defaultValue if the
+ *  field is not present. Returns TMWDEFS_FALSE if the value is not a number or
+ *  more than maxValue.
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _getULong(
+  const TMWTYPES_CHAR *pCommand,
+  const TMWTYPES_CHAR *pName,
+  TMWTYPES_ULONG defaultValue,
+  TMWTYPES_ULONG maxValue,
+  TMWTYPES_ULONG *pValue)
+{
+  TMWTYPES_CHAR buf[SDNPMQTT_MAX_VALUE_LEN];
+  TMWTYPES_CHAR *pEnd;
+  unsigned long value;
+
+  if(!_getField(pCommand, pName, buf, sizeof(buf)))
+  {
+    *pValue = defaultValue;
+    return(TMWDEFS_TRUE);
+  }
+
+  if((buf[0] < '0') || (buf[0] > '9'))
+    return(TMWDEFS_FALSE);
+
+  value = strtoul(buf, &pEnd, 10);
+  if((*pEnd != '\0') || (value > maxValue))
+    return(TMWDEFS_FALSE);
+
+  *pValue = (TMWTYPES_ULONG)value;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _addReply
+ *  Queue a reply to be published by sdnpmqtt_sync, called with the
+ *  channel locked
+ */
+static void TMWDEFS_LOCAL _addReply(
+  SDNPMQTT *pMqtt,
+  const SDNPMQTT_REPLY *pReply)
+{
+  TMWTYPES_UINT index;
+
+  if(pMqtt->config.replyTopic[0] == '\0')
+    return;
+
+  if(pMqtt->numReplies == SDNPMQTT_MAX_REPLIES)
+  {
+    pMqtt->repliesDropped++;
+    return;
+  }
+
+  index = (pMqtt->firstReply + pMqtt->numReplies) % SDNPMQTT_MAX_REPLIES;
+  pMqtt->replies[index] = *pReply;
+  pMqtt->numReplies++;
+}
+
+/* function: _addFeedback
+ *  Add the event for an output that was operated successfully
+ */
+static void TMWDEFS_LOCAL _addFeedback(
+  SDNPMQTT *pMqtt,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_ANALOG_VALUE *pValue)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pMqtt->pSession;
+  TMWDTIME timeStamp;
+
+  TMWTARG_UNUSED_PARAM(pSDNPSession);
+  TMWTARG_UNUSED_PARAM(group);
+  TMWTARG_UNUSED_PARAM(point);
+  TMWTARG_UNUSED_PARAM(pValue);
+  TMWTARG_UNUSED_PARAM(timeStamp);
+
+#if SDNPDATA_SUPPORT_OBJ11
+  if((group == DNPDEFS_OBJ_12_BIN_OUT_CTRLS) && pMqtt->config.binOutFeedback)
+  {
+    void *pPoint = sdnpdata_binOutGetPoint(pSDNPSession->pDbHandle, point);
+    if(pPoint != TMWDEFS_NULL)
+    {
+      TMWTYPES_UCHAR flags;
+      sdnpdata_binOutRead(pPoint, &flags);
+      sdnputil_getDateTime(pMqtt->pSession, &timeStamp);
+      sdnpo011_addEvent(pMqtt->pSession, point, flags, &timeStamp);
+    }
+  }
+#endif
+
+#if SDNPDATA_SUPPORT_OBJ43
+  if((group == DNPDEFS_OBJ_41_ANA_OUT_CTRLS) && pMqtt->config.anlgOutFeedback)
+  {
+    sdnputil_getDateTime(pMqtt->pSession, &timeStamp);
+    sdnpo043_addEvent(pMqtt->pSession, point, pValue, DNPDEFS_CTLSTAT_SUCCESS, &timeStamp);
+  }
+#endif
+}
+
+/* function: _completed
+ *  Reply to a command and add its event if it succeeded
+ */
+static void TMWDEFS_LOCAL _completed(
+  SDNPMQTT *pMqtt,
+  SDNPMQTT_REPLY *pReply,
+  TMWTYPES_ANALOG_VALUE *pValue)
+{
+  if(pReply->status == DNPDEFS_CTLSTAT_SUCCESS)
+    _addFeedback(pMqtt, pReply->group, pReply->point, pValue);
+
+  _addReply(pMqtt, pReply);
+}
+
+/* function: _waitForResult
+ *  Remember a command the database returned ASYNC for
+ */
+static void TMWDEFS_LOCAL _waitForResult(
+  SDNPMQTT *pMqtt,
+  SDNPMQTT_REPLY *pReply,
+  TMWTYPES_ANALOG_VALUE *pValue)
+{
+  TMWTYPES_UINT i;
+
+  for(i = 0; i < SDNPMQTT_MAX_PENDING; i++)
+  {
+    SDNPMQTT_PENDING *pPending = &pMqtt->pending[i];
+    if(!pPending->inUse)
+    {
+      pPending->inUse = TMWDEFS_TRUE;
+      pPending->reply = *pReply;
+      pPending->value = *pValue;
+      pPending->startTime = tmwtarg_getMSTime();
+      pMqtt->numPending++;
+      return;
+    }
+  }
+}
+
+/* function: _binOutCommand
+ *  Operate a binary output, called with the channel locked
+ */
+static void TMWDEFS_LOCAL _binOutCommand(
+  SDNPMQTT *pMqtt,
+  const TMWTYPES_CHAR *pCommand,
+  SDNPMQTT_REPLY *pReply)
+{
+  TMWTYPES_ANALOG_VALUE value;
+  TMWTYPES_CHAR buf[SDNPMQTT_MAX_VALUE_LEN];
+  TMWTYPES_ULONG point, count, onTime, offTime;
+  TMWTYPES_ULONG controlCode = DNPDEFS_CROB_CTRL_NUL;
+  void *pPoint;
+  TMWTYPES_UINT i;
+
+  value.type = TMWTYPES_ANALOG_TYPE_LONG;
+  value.value.lval = 0;
+
+  if(!_getField(pCommand, "point", buf, sizeof(buf))
+    || !_getULong(pCommand, "point", 0, 0xffff, &point)
+    || !_getField(pCommand, "code", buf, sizeof(buf))
+    || !_getULong(pCommand, "count", 1, 0xff, &count)
+    || !_getULong(pCommand, "on", 0, 0xffffffffUL, &onTime)
+    || !_getULong(pCommand, "off", 0, 0xffffffffUL, &offTime))
+  {
+    pReply->status = DNPDEFS_CROB_ST_FORMAT_ERROR;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+  pReply->point = (TMWTYPES_USHORT)point;
+
+  for(i = 0; i < sizeof(_codeNames) / sizeof(_codeNames[0]); i++)
+  {
+    if(strcmp(buf, _codeNames[i].pName) == 0)
+    {
+      controlCode = _codeNames[i].controlCode;
+      break;
+    }
+  }
+
+  if((i == sizeof(_codeNames) / sizeof(_codeNames[0]))
+    && !_getULong(pCommand, "code", 0, 0xff, &controlCode))
+  {
+    pReply->status = DNPDEFS_CROB_ST_FORMAT_ERROR;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+
+#if SDNPDATA_SUPPORT_OBJ12
+  pPoint = sdnpdata_binOutGetPoint(((SDNPSESN *)pMqtt->pSession)->pDbHandle, pReply->point);
+#else
+  pPoint = TMWDEFS_NULL;
+#endif
+  if(pPoint == TMWDEFS_NULL)
+  {
+    pReply->status = DNPDEFS_CROB_ST_NOT_SUPPORTED;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+
+  /* Do not start a control whose result could not be waited for */
+  if(pMqtt->numPending == SDNPMQTT_MAX_PENDING)
+  {
+    pReply->status = DNPDEFS_CROB_ST_PROC_LIMITED;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+
+#if SDNPDATA_SUPPORT_OBJ12
+  pReply->status = sdnpdata_binOutOperate(pPoint, (TMWTYPES_UCHAR)controlCode,
+    (TMWTYPES_UCHAR)count, onTime, offTime);
+#endif
+
+  if(pReply->status == DNPDEFS_CROB_ST_ASYNC)
+    _waitForResult(pMqtt, pReply, &value);
+  else
+    _completed(pMqtt, pReply, &value);
+}
+
+/* function: _anlgOutCommand
+ *  Operate an analog output, called with the channel locked
+ */
+static void TMWDEFS_LOCAL _anlgOutCommand(
+  SDNPMQTT *pMqtt,
+  const TMWTYPES_CHAR *pCommand,
+  SDNPMQTT_REPLY *pReply)
+{
+  TMWTYPES_ANALOG_VALUE value;
+  TMWTYPES_CHAR buf[SDNPMQTT_MAX_VALUE_LEN];
+  TMWTYPES_CHAR *pEnd;
+  TMWTYPES_ULONG point;
+  double dval;
+  void *pPoint;
+
+  if(!_getField(pCommand, "point", buf, sizeof(buf))
+    || !_getULong(pCommand, "point", 0, 0xffff, &point)
+    || !_getField(pCommand, "value", buf, sizeof(buf)))
+  {
+    pReply->status = DNPDEFS_CTLSTAT_FORMAT_ERROR;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+  pReply->point = (TMWTYPES_USHORT)point;
+
+  dval = strtod(buf, &pEnd);
+  if((pEnd == buf) || (*pEnd != '\0'))
+  {
+    pReply->status = DNPDEFS_CTLSTAT_FORMAT_ERROR;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+
+  if((dval >= TMWDEFS_LONG_MIN) && (dval <= TMWDEFS_LONG_MAX)
+    && (dval == (double)(TMWTYPES_LONG)dval))
+  {
+    value.type = TMWTYPES_ANALOG_TYPE_LONG;
+    value.value.lval = (TMWTYPES_LONG)dval;
+  }
+  else
+  {
+#if TMWCNFG_SUPPORT_DOUBLE
+    value.type = TMWTYPES_ANALOG_TYPE_DOUBLE;
+    value.value.dval = dval;
+#elif TMWCNFG_SUPPORT_FLOAT
+    value.type = TMWTYPES_ANALOG_TYPE_SFLOAT;
+    value.value.fval = (TMWTYPES_SFLOAT)dval;
+#else
+    pReply->status = DNPDEFS_CTLSTAT_NOT_SUPPORTED;
+    _addReply(pMqtt, pReply);
+    return;
+#endif
+  }
+
+#if SDNPDATA_SUPPORT_OBJ41
+  pPoint = sdnpdata_anlgOutGetPoint(((SDNPSESN *)pMqtt->pSession)->pDbHandle, pReply->point);
+#else
+  pPoint = TMWDEFS_NULL;
+#endif
+  if(pPoint == TMWDEFS_NULL)
+  {
+    pReply->status = DNPDEFS_CTLSTAT_NOT_SUPPORTED;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+
+  /* Do not start a control whose result could not be waited for */
+  if(pMqtt->numPending == SDNPMQTT_MAX_PENDING)
+  {
+    pReply->status = DNPDEFS_CTLSTAT_PROC_LIMITED;
+    _addReply(pMqtt, pReply);
+    return;
+  }
+
+#if SDNPDATA_SUPPORT_OBJ41
+  pReply->status = sdnpdata_anlgOutOperate(pPoint, &value);
+#endif
+
+  if(pReply->status == DNPDEFS_CTLSTAT_ASYNC)
+    _waitForResult(pMqtt, pReply, &value);
+  else
+    _completed(pMqtt, pReply, &value);
+}
+
+/* function: _topicIs */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _topicIs(
+  const TMWTYPES_CHAR *pTopic,
+  struct mqtt_response_publish *pPublish)
+{
+  return((pTopic[0] != '\0')
+    && (strlen(pTopic) == pPublish->topic_name_size)
+    && (memcmp(pTopic, pPublish->topic_name, pPublish->topic_name_size) == 0));
+}
+
+/* function: _publishCallback
+ *  Called by mqtt_sync for each message received on a command topic
+ */
+static void _publishCallback(
+  void **ppState,
+  struct mqtt_response_publish *pPublish)
+{
+  SDNPMQTT *pMqtt = *(SDNPMQTT **)ppState;
+  TMWTYPES_CHAR command[SDNPMQTT_MAX_COMMAND_LEN];
+  SDNPMQTT_REPLY reply;
+  size_t size = pPublish->application_message_size;
+
+  /* Closed with sdnpmqtt_close */
+  if(pMqtt == TMWDEFS_NULL)
+    return;
+
+  memset(&reply, 0, sizeof(reply));
+  if(_topicIs(pMqtt->config.binOutTopic, pPublish))
+    reply.group = DNPDEFS_OBJ_12_BIN_OUT_CTRLS;
+  else if(_topicIs(pMqtt->config.anlgOutTopic, pPublish))
+    reply.group = DNPDEFS_OBJ_41_ANA_OUT_CTRLS;
+  else
+    return;
+
+  /* Publishers often include the terminating null */
+  if((size > 0) && (((const TMWTYPES_CHAR *)pPublish->application_message)[size - 1] == '\0'))
+    size--;
+
+  TMWTARG_LOCK_SECTION(&pMqtt->pSession->pChannel->lock);
+
+  if(size >= sizeof(command))
+  {
+    reply.status = DNPDEFS_CTLSTAT_FORMAT_ERROR;
+    _addReply(pMqtt, &reply);
+  }
+  else
+  {
+    memcpy(command, pPublish->application_message, size);
+    command[size] = '\0';
+
+    if(!_getField(command, "id", reply.id, sizeof(reply.id)))
+      reply.id[0] = '\0';
+
+    if(reply.group == DNPDEFS_OBJ_12_BIN_OUT_CTRLS)
+      _binOutCommand(pMqtt, command, &reply);
+    else
+      _anlgOutCommand(pMqtt, command, &reply);
+  }
+
+  TMWTARG_UNLOCK_SECTION(&pMqtt->pSession->pChannel->lock);
+}
+
+/* function: sdnpmqtt_initConfig */
+void TMWDEFS_GLOBAL sdnpmqtt_initConfig(
+  SDNPMQTT_CONFIG *pConfig)
+{
+  memset(pConfig, 0, sizeof(SDNPMQTT_CONFIG));
+  strcpy(pConfig->binOutTopic, "dnp/command/binout");
+  strcpy(pConfig->anlgOutTopic, "dnp/command/anlgout");
+  strcpy(pConfig->replyTopic, "dnp/command/reply");
+  pConfig->qos = MQTT_PUBLISH_QOS_0;
+  pConfig->binOutFeedback = TMWDEFS_TRUE;
+  pConfig->anlgOutFeedback = TMWDEFS_TRUE;
+  pConfig->asyncTimeout = SDNPMQTT_DEFAULT_ASYNC_TIMEOUT;
+}
+
+/* function: sdnpmqtt_open */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmqtt_open(
+  TMWSESN *pSession,
+  struct mqtt_client *pClient,
+  const SDNPMQTT_CONFIG *pConfig)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPMQTT *pMqtt;
+  int maxQos;
+
+  if((pSession == TMWDEFS_NULL)
+    || (pClient == TMWDEFS_NULL)
+    || (pSDNPSession->pMqttCommands != TMWDEFS_NULL))
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  pMqtt = (SDNPMQTT *)tmwtarg_alloc(sizeof(SDNPMQTT));
+  if(pMqtt == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  memset(pMqtt, 0, sizeof(SDNPMQTT));
+  pMqtt->pSession = pSession;
+  pMqtt->pClient = pClient;
+  pMqtt->config = *pConfig;
+  pMqtt->config.binOutTopic[SDNPMQTT_MAX_TOPIC_LEN - 1] = '\0';
+  pMqtt->config.anlgOutTopic[SDNPMQTT_MAX_TOPIC_LEN - 1] = '\0';
+  pMqtt->config.replyTopic[SDNPMQTT_MAX_TOPIC_LEN - 1] = '\0';
+  maxQos = (pMqtt->config.qos & MQTT_PUBLISH_QOS_MASK) >> 1;
+
+  pClient->publish_response_callback = _publishCallback;
+  pClient->publish_response_callback_state = pMqtt;
+
+  if(((pMqtt->config.binOutTopic[0] != '\0')
+      && (mqtt_subscribe(pClient, pMqtt->config.binOutTopic, maxQos) != MQTT_OK))
+    || ((pMqtt->config.anlgOutTopic[0] != '\0')
+      && (mqtt_subscribe(pClient, pMqtt->config.anlgOutTopic, maxQos) != MQTT_OK)))
+  {
+    pClient->publish_response_callback_state = TMWDEFS_NULL;
+    tmwtarg_free(pMqtt);
+    return(TMWDEFS_FALSE);
+  }
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  pSDNPSession->pMqttCommands = pMqtt;
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpmqtt_sync */
+enum MQTTErrors TMWDEFS_GLOBAL sdnpmqtt_sync(
+  TMWSESN *pSession)
+{
+  SDNPMQTT_REPLY replies[SDNPMQTT_MAX_REPLIES];
+  TMWTYPES_UINT numReplies = 0;
+  TMWTYPES_MILLISECONDS now;
+  enum MQTTErrors status;
+  SDNPMQTT *pMqtt;
+  TMWTYPES_UINT i;
+
+  pMqtt = _getMqtt(pSession);
+  if(pMqtt == TMWDEFS_NULL)
+    return(MQTT_ERROR_NULLPTR);
+
+  /* Commands are carried out by _publishCallback */
+  status = mqtt_sync(pMqtt->pClient);
+  if(status != MQTT_OK)
+    return(status);
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+
+  /* Give up on ASYNC controls that did not complete in time */
+  if(pMqtt->numPending != 0)
+  {
+    now = tmwtarg_getMSTime();
+    for(i = 0; i < SDNPMQTT_MAX_PENDING; i++)
+    {
+      SDNPMQTT_PENDING *pPending = &pMqtt->pending[i];
+      if(pPending->inUse
+        && ((TMWTYPES_MILLISECONDS)(now - pPending->startTime) >= pMqtt->config.asyncTimeout))
+      {
+        pPending->inUse = TMWDEFS_FALSE;
+        pPending->reply.status = DNPDEFS_CTLSTAT_HARDWARE_ERROR;
+        _addReply(pMqtt, &pPending->reply);
+        pMqtt->numPending--;
+      }
+    }
+  }
+
+  /* Take the replies, they are published without the channel locked
+   * since mqtt_sync locks the client before the channel
+   */
+  while(pMqtt->numReplies != 0)
+  {
+    replies[numReplies++] = pMqtt->replies[pMqtt->firstReply];
+    pMqtt->firstReply = (pMqtt->firstReply + 1) % SDNPMQTT_MAX_REPLIES;
+    pMqtt->numReplies--;
+  }
+
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+
+  if(numReplies == 0)
+    return(MQTT_OK);
+
+  for(i = 0; i < numReplies; i++)
+  {
+    TMWTYPES_CHAR message[SDNPMQTT_MAX_ID_LEN + 48];
+    int length;
+
+    length = snprintf(message, sizeof(message), "id=%s group=%u point=%u status=%u",
+      replies[i].id, replies[i].group, replies[i].point, replies[i].status);
+
+    status = mqtt_publish(pMqtt->pClient, pMqtt->config.replyTopic,
+      message, (size_t)length, pMqtt->config.qos);
+    if(status != MQTT_OK)
+      return(status);
+  }
+
+  /* Send the replies now rather than on the next call */
+  if(__mqtt_send(pMqtt->pClient) < 0)
+    return(pMqtt->pClient->error);
+
+  return(MQTT_OK);
+}
+
+/* function: sdnpmqtt_getRepliesDropped */
+TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpmqtt_getRepliesDropped(
+  TMWSESN *pSession)
+{
+  SDNPMQTT *pMqtt = _getMqtt(pSession);
+  TMWTYPES_ULONG repliesDropped;
+
+  if(pMqtt == TMWDEFS_NULL)
+    return(0);
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  repliesDropped = pMqtt->repliesDropped;
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+  return(repliesDropped);
+}
+
+/* function: sdnpmqtt_close */
+void TMWDEFS_GLOBAL sdnpmqtt_close(
+  TMWSESN *pSession)
+{
+  SDNPMQTT *pMqtt = _getMqtt(pSession);
+
+  if(pMqtt == TMWDEFS_NULL)
+    return;
+
+  pMqtt->pClient->publish_response_callback_state = TMWDEFS_NULL;
+  ((SDNPSESN *)pSession)->pMqttCommands = TMWDEFS_NULL;
+  tmwtarg_free(pMqtt);
+}
+
+/* function: sdnpmqtt_controlComplete */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmqtt_controlComplete(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_UCHAR status)
+{
+  SDNPMQTT *pMqtt = _getMqtt(pSession);
+  TMWTYPES_UINT i;
+
+  if((pMqtt == TMWDEFS_NULL) || (pMqtt->numPending == 0))
+    return(TMWDEFS_FALSE);
+
+  for(i = 0; i < SDNPMQTT_MAX_PENDING; i++)
+  {
+    SDNPMQTT_PENDING *pPending = &pMqtt->pending[i];
+    if(pPending->inUse
+      && (pPending->reply.group == group)
+      && (pPending->reply.point == point))
+    {
+      pPending->inUse = TMWDEFS_FALSE;
+      pPending->reply.status = status;
+      pMqtt->numPending--;
+      _completed(pMqtt, &pPending->reply, &pPending->value);
+      return(TMWDEFS_TRUE);
+    }
+  }
+
+  return(TMWDEFS_FALSE);
+}
+
+#endif /* SDNPCNFG_SUPPORT_MQTT_COMMANDS */
@@ -0,0 +1,253 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+
+/* file: sdnpmqtt.h
+ * description: Binary and analog output commands received over MQTT.
+ *  A gateway that already talks to an MQTT broker can have commands for
+ *  a DNP slave session published to it there, without running a second
+ *  protocol stack. Each command is carried out on the session's database
+ *  as a direct operate of a binary output (object 12) or an analog
+ *  output (object 41) would be, and its result is published on a reply
+ *  topic.
+ *
+ *  Commands are text, a list of name=value pairs separated by spaces.
+ *  A binary output command published on binOutTopic looks like
+ *     point=3 code=pulse_on count=1 on=500 off=500 id=42
+ *  where code is pulse_on, pulse_off, latch_on, latch_off, close, trip or
+ *  a DNPDEFS_CROB_CTRL_XXX control code as a number. count, on and off
+ *  default to 1, 0 and 0. An analog output command published on
+ *  anlgOutTopic looks like
+ *     point=2 value=12.5 id=43
+ *  A value without a fraction is operated as a long, otherwise as a
+ *  double. id is optional and copied into the reply, which is published
+ *  on replyTopic as
+ *     id=42 group=12 point=3 status=0
+ *  with the DNPDEFS_CROB_ST_XXX or DNPDEFS_CTLSTAT_XXX status of the
+ *  control. Commands that cannot be parsed are answered with
+ *  FORMAT_ERROR.
+ *
+ *  After a successful command a binary output event (object 11) with the
+ *  new state of the output or an analog output command event (object
+ *  43) with the value operated is added, unless binOutFeedback or
+ *  anlgOutFeedback is cleared, so masters of the session see the change
+ *  as well.
+ *
+ *  The application owns the MQTT client. It connects the client to the
+ *  broker, calls sdnpmqtt_open, and from then on calls sdnpmqtt_sync
+ *  instead of mqtt_sync. Commands are carried out from within
+ *  sdnpmqtt_sync, with the channel locked. If the database returns ASYNC
+ *  the reply is published once the result is reported with
+ *  sdnpsesn_controlComplete, or with HARDWARE_ERROR after asyncTimeout.
+ */
+#ifndef SDNPMQTT_DEFINED
+#define SDNPMQTT_DEFINED
+
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwsesn.h"
+#include "tmwscl/dnp/sdnpcnfg.h"
+
+#if SDNPCNFG_SUPPORT_MQTT_COMMANDS
+#include <mqtt.h>
+
+/* Longest topic, including the terminating null */
+#define SDNPMQTT_MAX_TOPIC_LEN     128
+
+/* Longest command id copied into a reply, including the terminating null */
+#define SDNPMQTT_MAX_ID_LEN        32
+
+/* Longest command accepted */
+#define SDNPMQTT_MAX_COMMAND_LEN   256
+
+/* Replies waiting to be published and ASYNC commands waiting for their
+ * results. Replies that do not fit are dropped and counted, see
+ * sdnpmqtt_getRepliesDropped.
+ */
+#define SDNPMQTT_MAX_REPLIES       32
+#define SDNPMQTT_MAX_PENDING       16
+
+/* MQTT command configuration */
+typedef struct SDNPMqttConfigStruct {
+  /* Topic binary output commands are published on, empty if binary
+   * outputs are not operated
+   */
+  TMWTYPES_CHAR binOutTopic[SDNPMQTT_MAX_TOPIC_LEN];
+
+  /* Topic analog output commands are published on, empty if analog
+   * outputs are not operated
+   */
+  TMWTYPES_CHAR anlgOutTopic[SDNPMQTT_MAX_TOPIC_LEN];
+
+  /* Topic the results are published on, empty if no replies are sent */
+  TMWTYPES_CHAR replyTopic[SDNPMQTT_MAX_TOPIC_LEN];
+
+  /* MQTT_PUBLISH_QOS_0, MQTT_PUBLISH_QOS_1 or MQTT_PUBLISH_QOS_2, used to
+   * subscribe to the command topics and to publish the replies
+   */
+  TMWTYPES_UCHAR qos;
+
+  /* Add a binary output event with the new state of each binary output
+   * operated. Set this to TMWDEFS_FALSE if the database adds these events
+   * itself when an output changes, as the simulated database does.
+   */
+  TMWTYPES_BOOL binOutFeedback;
+
+  /* Add an analog output command event for each analog output operated */
+  TMWTYPES_BOOL anlgOutFeedback;
+
+  /* How long to wait for sdnpsesn_controlComplete after the database
+   * returned ASYNC before replying with HARDWARE_ERROR
+   */
+  TMWTYPES_MILLISECONDS asyncTimeout;
+} SDNPMQTT_CONFIG;
+
+/* A reply waiting to be published */
+typedef struct SDNPMqttReplyStruct {
+  TMWTYPES_CHAR   id[SDNPMQTT_MAX_ID_LEN];
+  TMWTYPES_UCHAR  group;
+  TMWTYPES_USHORT point;
+  TMWTYPES_UCHAR  status;
+} SDNPMQTT_REPLY;
+
+/* A command the database returned ASYNC for */
+typedef struct SDNPMqttPendingStruct {
+  TMWTYPES_BOOL   inUse;
+  SDNPMQTT_REPLY  reply;
+  TMWTYPES_ANALOG_VALUE value;
+  TMWTYPES_MILLISECONDS startTime;
+} SDNPMQTT_PENDING;
+
+/* MQTT commands of one session */
+typedef struct SDNPMqttStruct {
+  TMWSESN *pSession;
+  struct mqtt_client *pClient;
+  SDNPMQTT_CONFIG config;
+
+  /* Replies in the order the commands completed, protected by the
+   * channel lock
+   */
+  SDNPMQTT_REPLY replies[SDNPMQTT_MAX_REPLIES];
+  TMWTYPES_UINT firstReply;
+  TMWTYPES_UINT numReplies;
+
+  /* Replies dropped because the queue was full */
+  TMWTYPES_ULONG repliesDropped;
+
+  SDNPMQTT_PENDING pending[SDNPMQTT_MAX_PENDING];
+  TMWTYPES_UINT numPending;
+} SDNPMQTT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnpmqtt_initConfig
+   * purpose: Initialize an MQTT command configuration to the defaults
+   * arguments:
+   *  pConfig - configuration to initialize
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmqtt_initConfig(
+    SDNPMQTT_CONFIG *pConfig);
+
+  /* function: sdnpmqtt_open
+   * purpose: Start receiving commands for a session. The client's
+   *  publish callback is replaced and the command topics are subscribed
+   *  to, so the client must not be used for anything else that receives
+   *  publishes. The subscriptions are sent by the next sdnpmqtt_sync.
+   * arguments:
+   *  pSession - session to operate the outputs of
+   *  pClient - client connected to the broker with mqtt_connect
+   *  pConfig - MQTT command configuration
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmqtt_open(
+    TMWSESN *pSession,
+    struct mqtt_client *pClient,
+    const SDNPMQTT_CONFIG *pConfig);
+
+  /* function: sdnpmqtt_sync
+   * purpose: Receive and carry out commands, and publish the replies.
+   *  Call this periodically, or when the client's socket is readable,
+   *  in place of mqtt_sync. It must not be called with the channel
+   *  locked.
+   * arguments:
+   *  pSession - session opened with sdnpmqtt_open
+   * returns:
+   *  MQTT_OK or the error returned by mqtt_sync
+   */
+  TMWDEFS_SCL_API enum MQTTErrors TMWDEFS_GLOBAL sdnpmqtt_sync(
+    TMWSESN *pSession);
+
+  /* function: sdnpmqtt_getRepliesDropped
+   * purpose: Number of replies dropped because more than
+   *  SDNPMQTT_MAX_REPLIES commands completed between two calls to
+   *  sdnpmqtt_sync. Raise SDNPMQTT_MAX_REPLIES or call sdnpmqtt_sync
+   *  more often if this is not zero.
+   * arguments:
+   *  pSession - session opened with sdnpmqtt_open
+   * returns:
+   *  number of replies dropped since sdnpmqtt_open
+   */
+  TMWDEFS_SCL_API TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpmqtt_getRepliesDropped(
+    TMWSESN *pSession);
+
+  /* function: sdnpmqtt_close
+   * purpose: Stop receiving commands for a session. The client is left
+   *  connected and subscribed; stop calling sdnpmqtt_sync before calling
+   *  this. Called by sdnpsesn_closeSession.
+   * arguments:
+   *  pSession - session
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpmqtt_close(
+    TMWSESN *pSession);
+
+  /* function: sdnpmqtt_controlComplete
+   * purpose: Reply to a command the database returned ASYNC for. Called
+   *  by sdnpsesn_controlComplete, with the channel locked, for results
+   *  the session was not holding a response for.
+   * arguments:
+   *  pSession - session
+   *  group - 12 or 41
+   *  point - point number of the control
+   *  status - DNPDEFS_CTLSTAT_XXX status of the control
+   * returns:
+   *  TMWDEFS_TRUE if a command was waiting for this result
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpmqtt_controlComplete(
+    TMWSESN *pSession,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point,
+    TMWTYPES_UCHAR status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDNPCNFG_SUPPORT_MQTT_COMMANDS */
+#endif /* SDNPMQTT_DEFINED */
@@ -290,6 +290,10 @@ TMWTYPES_BOOL TMWDEFS_CALLBACK sdnpo012_opObj12v1(
       }
     }
 
+    /* The database will report the result later */
+    if(localStatus == DNPDEFS_CROB_ST_ASYNC)
+      localStatus = sdnpsesn_deferControl(pSession, pResponse, DNPDEFS_OBJ_12_BIN_OUT_CTRLS, point);
+
     /* Store status into response */
     pResponse->pMsgBuf[pResponse->msgLength++] = localStatus;
 
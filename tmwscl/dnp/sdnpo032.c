@@ -30,16 +30,15 @@
 #include "tmwscl/dnp/dnpdiag.h"
 #include "tmwscl/dnp/sdnpdiag.h"
 #include "tmwscl/utils/tmwtarg.h"
-#include <mqtt.h>
-#include "templates/posix_sockets.h"
 #include "tmwscl/dnp/dnpdefs.h"
 #include "tmwscl/dnp/dnpdtime.h"
+#include "tmwscl/dnp/dnputil.h"
 #include "tmwscl/dnp/sdnpdata.h"
 #include "tmwscl/dnp/sdnputil.h"
 #include "tmwscl/dnp/sdnpmem.h"
 #include "tmwscl/dnp/sdnpunsl.h"
 #include "tmwscl/dnp/sdnpo032.h"
-// #include "twmscl/utils/twmtypes.h"
+#include "tmwscl/dnp/sdnpmpub.h"
 
 #if SDNPDATA_SUPPORT_OBJ32
 /* function: _setVariationInfo() */
@@ -716,11 +715,6 @@ void TMWDEFS_GLOBAL sdnpo032_addEvent(
 
   TMWTARG_LOCK_SECTION(pLock);
 
-  struct mqtt_client client;
-  void publish_callback(void **unused, struct mqtt_response_publish *published);
-  void *client_refresher(void *client);
-  void exit_example(int status, int sockfd, pthread_t *client_daemon);
-
   /* Get point event belongs to */
   pPoint = sdnpdata_anlgInGetPoint(pSDNPSession->pDbHandle, point);
 
@@ -730,91 +724,12 @@ void TMWDEFS_GLOBAL sdnpo032_addEvent(
     value.analogPtr = pValue;
 
     sdnpevnt_addEvent(pSession, point, flags, eventClass, pTimeStamp, &desc, &value);
-    
-    const char addr[] = "192.168.197.195";
-    const char port[] = "1883";
-
-    // const char str[] = "A";
-    // char buffer[20];
-    // sprintf(buffer,"%ls_%d", str,point);
-    char topic [] = "datetime";
-
-    int sockfd;
-    const char *client_id = NULL;
-    // uint8_t *sendbuf;
-    // uint8_t *recvbuf;
-    /* Create an anonymous session */
-
-    /* Ensure we have a clean session */
-    uint8_t connect_flags = MQTT_CONNECT_CLEAN_SESSION;
-    uint8_t sendbuf[2048]; /* sendbuf should be large enough to hold multiple whole mqtt messages */
-    uint8_t recvbuf[1024]; /* recvbuf should be large enough any whole mqtt message expected to be received */
-
-
-    int open_nb_socket(const char *addr, const char *port);
-
-    /* open the non-blocking TCP socket (connecting to the broker) */
-    sockfd = open_nb_socket(addr, port);
-
-    if (sockfd == -1)
-    {
-      perror("Failed to open socket: ");
-      exit_example(EXIT_FAILURE, sockfd, NULL);
-    }
-
-    mqtt_init(&client, sockfd, sendbuf, sizeof(sendbuf), recvbuf, sizeof(recvbuf), publish_callback);
-    /* Send connection request to the broker. */
-
-    mqtt_connect(&client, client_id, NULL, NULL, 0, NULL, NULL, connect_flags, 400);
-
-    /* check that we don't have any errors */
-    if (client.error != MQTT_OK)
-    {
-      fprintf(stderr, "error: %s\n", mqtt_error_str(client.error));
-      exit_example(EXIT_FAILURE, sockfd, NULL);
-    }
-
-    /* start a thread to refresh the client (handle egress and ingree client traffic) */
-    pthread_t client_daemon;
-    if (pthread_create(&client_daemon, NULL, client_refresher, &client))
-    {
-      fprintf(stderr, "Failed to start client daemon.\n");
-      exit_example(EXIT_FAILURE, sockfd, NULL);
-    }
 
-    enum MQTTErrors mqtt_sync(struct mqtt_client * client);
-    const char *mqtt_error_str(enum MQTTErrors error);
-
-   int val = 1;
-    while (val)
-    {
-      val=0;
-      /* print a message */
-      char application_message[1024];
-      TMWTYPES_ANALOG_VALUE analogValue=*pValue;
-      analogValue.type = TMWTYPES_ANALOG_TYPE_DOUBLE;
-
-      printf("value of publish MQTT___________________%lf\n",analogValue.value.dval);
-
-      double trash_buf = analogValue.value.dval;
-      snprintf(application_message, sizeof(application_message), " %s", trash_buf);
-      mqtt_publish(&client, topic, application_message, strlen(application_message) + 1, MQTT_PUBLISH_QOS_0);  
-      
-      /* check for errors */
-
-      if (client.error != MQTT_OK)
-      {
-        fprintf(stderr, "error: %s\n", mqtt_error_str(client.error));
-        exit_example(EXIT_FAILURE, sockfd, &client_daemon);
-      }
-    }
-
-    /* disconnect */
-    // printf("\n%s disconnecting from %s\n", argv[0], addr);
-    sleep(1);
-
-    /* exit */
-    // exit_example(EXIT_SUCCESS, sockfd, &client_daemon);
+#if SDNPCNFG_SUPPORT_MQTT_PUBLISHER
+    /* Publish it too if the session is attached to a publisher */
+    sdnpmpub_pointEvent(pSession, DNPDEFS_OBJ_32_ANA_CHNG_EVENTS, point,
+      dnputil_getAnalogValueDouble(pValue), flags, pTimeStamp);
+#endif
   }
   else
   {
@@ -824,30 +739,6 @@ void TMWDEFS_GLOBAL sdnpo032_addEvent(
   TMWTARG_UNLOCK_SECTION(pLock);
 }
 
-void exit_example(int status, int sockfd, pthread_t *client_daemon)
-{
-  if (sockfd != -1)
-    close(sockfd);
-  if (client_daemon != NULL)
-    pthread_cancel(*client_daemon);
-  exit(status);
-}
-
-void publish_callback(void **unused, struct mqtt_response_publish *published)
-{
-  // printf("This is an publish callback event handler");
-}
-
-void *client_refresher(void *client)
-{
-  while (1)
-  {
-    mqtt_sync((struct mqtt_client *)client);
-    usleep(100000U);
-  }
-  return NULL;
-}
-
 /* function: sdnpo032_countEvents */
 TMWTYPES_USHORT TMWDEFS_GLOBAL sdnpo032_countEvents(
     TMWSESN *pSession,
@@ -263,6 +263,10 @@ TMWTYPES_BOOL TMWDEFS_CALLBACK sdnpo041_opObj41v1(
       }
     }
 
+    /* The database will report the result later */
+    if(localStatus == DNPDEFS_CTLSTAT_ASYNC)
+      localStatus = sdnpsesn_deferControl(pSession, pResponse, DNPDEFS_OBJ_41_ANA_OUT_CTRLS, point);
+
     /* Store status into response */
     pResponse->pMsgBuf[pResponse->msgLength++] = localStatus;
 
@@ -507,6 +511,10 @@ TMWTYPES_BOOL TMWDEFS_CALLBACK sdnpo041_opObj41v2(
       }
     }
 
+    /* The database will report the result later */
+    if(localStatus == DNPDEFS_CTLSTAT_ASYNC)
+      localStatus = sdnpsesn_deferControl(pSession, pResponse, DNPDEFS_OBJ_41_ANA_OUT_CTRLS, point);
+
     /* Store status into response */
     pResponse->pMsgBuf[pResponse->msgLength++] = localStatus;
 
@@ -750,6 +758,10 @@ TMWTYPES_BOOL TMWDEFS_CALLBACK sdnpo041_opObj41v3(
       }
     }
 
+    /* The database will report the result later */
+    if(localStatus == DNPDEFS_CTLSTAT_ASYNC)
+      localStatus = sdnpsesn_deferControl(pSession, pResponse, DNPDEFS_OBJ_41_ANA_OUT_CTRLS, point);
+
     /* Store status into response */
     pResponse->pMsgBuf[pResponse->msgLength++] = localStatus;
 
@@ -994,6 +1006,10 @@ TMWTYPES_BOOL TMWDEFS_CALLBACK sdnpo041_opObj41v4(
       }
     }
 
+    /* The database will report the result later */
+    if(localStatus == DNPDEFS_CTLSTAT_ASYNC)
+      localStatus = sdnpsesn_deferControl(pSession, pResponse, DNPDEFS_OBJ_41_ANA_OUT_CTRLS, point);
+
     /* Store status into response */
     pResponse->pMsgBuf[pResponse->msgLength++] = localStatus;
 
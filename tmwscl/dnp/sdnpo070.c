@@ -249,6 +249,230 @@ static void TMWDEFS_CALLBACK _fileTimeout(
   }
 }
 
+/* function: _sameFile
+ * purpose: Determine if a file control block is for the named file
+ * arguments:
+ *  pObj70FileCtrl - file control block, may be TMWDEFS_NULL
+ *  pFilename - name of file
+ *  filenameLength - length of name
+ * returns:
+ *  TMWDEFS_TRUE if the names match
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _sameFile(
+  SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl,
+  const TMWTYPES_CHAR *pFilename,
+  TMWTYPES_USHORT filenameLength)
+{
+  return((TMWTYPES_BOOL)((pObj70FileCtrl != TMWDEFS_NULL)
+    && (pObj70FileCtrl->filenameLength == filenameLength)
+    && !memcmp(pFilename, pObj70FileCtrl->filename, filenameLength)));
+}
+
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+/* function: _heldFileTimeout
+ * purpose: Close held files that the master has not used within the
+ *  file transfer timeout. There is no event to report this, further
+ *  requests for the handle will get an invalid handle status.
+ * arguments:
+ *  pCallbackParam - pointer to session
+ * returns:
+ *  void
+ */
+static void TMWDEFS_CALLBACK _heldFileTimeout(
+  void *pCallbackParam)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pCallbackParam;
+  TMWSESN  *pSession = (TMWSESN*)pSDNPSession;
+  int i;
+
+  /* All held files share this callback, only the expired timers are inactive */
+  for(i = 0; i < SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1; i++)
+  {
+    SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl =
+      (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70HeldFileCtrl[i];
+
+    if((pObj70FileCtrl != TMWDEFS_NULL)
+      && !tmwtimer_isActive(&pObj70FileCtrl->fileTransferTimer))
+    {
+      SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_FILE_TO);
+      sdnpdata_closeFile(pSession, pObj70FileCtrl->handle);
+      sdnpmem_free(pObj70FileCtrl);
+      pSDNPSession->pObj70HeldFileCtrl[i] = TMWDEFS_NULL;
+    }
+  }
+}
+
+/* function: _canHoldFileCtrl
+ * purpose: Determine if a file control block is an open file with no
+ *  database call or event response pending, so it can be held while
+ *  the master uses another file.
+ * arguments:
+ *  pObj70FileCtrl - file control block
+ * returns:
+ *  TMWDEFS_TRUE if it can be held
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _canHoldFileCtrl(
+  SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl)
+{
+  if((pObj70FileCtrl->handle == 0)
+    || (pObj70FileCtrl->retryState != SDNPO070_FILE_RETRY_IDLE)
+    || (pObj70FileCtrl->eventState != SDNPO070_EVENT_STAT_NOTREADY)
+    || pObj70FileCtrl->xferComplete)
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+#if SDNPDATA_SUPPORT_XML2
+  /* The device profile is generated from state kept in the session */
+  if(pObj70FileCtrl->xml2DeviceProfileOpen)
+  {
+    return(TMWDEFS_FALSE);
+  }
+#endif
+
+  return(TMWDEFS_TRUE);
+}
+#endif
+
+/* function: _holdFileCtrl
+ * purpose: Make room for a new file control block by holding the
+ *  current one, if it can be held and there is a free held entry.
+ * arguments:
+ *  pSDNPSession - pointer to session
+ * returns:
+ *  TMWDEFS_TRUE if there is no current file control block
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _holdFileCtrl(
+  SDNPSESN *pSDNPSession)
+{
+  SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl =
+    (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  TMWSESN *pSession = (TMWSESN *)pSDNPSession;
+  int i;
+#endif
+
+  if(pObj70FileCtrl == TMWDEFS_NULL)
+  {
+    return(TMWDEFS_TRUE);
+  }
+
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  if(_canHoldFileCtrl(pObj70FileCtrl))
+  {
+    for(i = 0; i < SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1; i++)
+    {
+      if(pSDNPSession->pObj70HeldFileCtrl[i] == TMWDEFS_NULL)
+      {
+        pSDNPSession->pObj70HeldFileCtrl[i] = pObj70FileCtrl;
+        pSDNPSession->pObj70FileCtrl = TMWDEFS_NULL;
+
+        tmwtimer_start(&pObj70FileCtrl->fileTransferTimer,
+          pSDNPSession->fileTransferTimeout, pSession->pChannel, _heldFileTimeout, pSession);
+        return(TMWDEFS_TRUE);
+      }
+    }
+  }
+#endif
+
+  return(TMWDEFS_FALSE);
+}
+
+/* function: _selectFileCtrl
+ * purpose: Make the held file with this handle the current file control
+ *  block, holding the current one in its place. Nothing changes if the
+ *  handle is not held or the current file control block cannot be held,
+ *  the request is then checked against the current one as before.
+ * arguments:
+ *  pSDNPSession - pointer to session
+ *  handle - file handle from the request
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _selectFileCtrl(
+  SDNPSESN *pSDNPSession,
+  TMWTYPES_ULONG handle)
+{
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  TMWSESN *pSession = (TMWSESN *)pSDNPSession;
+  SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl =
+    (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
+  int i;
+
+  if((handle == 0)
+    || ((pObj70FileCtrl != TMWDEFS_NULL)
+      && ((pObj70FileCtrl->handle == handle) || !_canHoldFileCtrl(pObj70FileCtrl))))
+  {
+    return;
+  }
+
+  for(i = 0; i < SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1; i++)
+  {
+    SDNPO070_FILE_CONTROL_BLOCK *pHeldFileCtrl =
+      (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70HeldFileCtrl[i];
+
+    if((pHeldFileCtrl != TMWDEFS_NULL) && (pHeldFileCtrl->handle == handle))
+    {
+      pSDNPSession->pObj70HeldFileCtrl[i] = pObj70FileCtrl;
+      if(pObj70FileCtrl != TMWDEFS_NULL)
+      {
+        tmwtimer_start(&pObj70FileCtrl->fileTransferTimer,
+          pSDNPSession->fileTransferTimeout, pSession->pChannel, _heldFileTimeout, pSession);
+      }
+
+      pSDNPSession->pObj70FileCtrl = pHeldFileCtrl;
+      tmwtimer_start(&pHeldFileCtrl->fileTransferTimer,
+        pSDNPSession->fileTransferTimeout, pSession->pChannel, _fileTimeout, pSession);
+      return;
+    }
+  }
+#else
+  TMWTARG_UNUSED_PARAM(pSDNPSession);
+  TMWTARG_UNUSED_PARAM(handle);
+#endif
+}
+
+/* function: _closeHeldFile
+ * purpose: Close a held file that the master is opening again.
+ *  (Master SHOULD have sent an abort request, but clearly he is done.)
+ * arguments:
+ *  pSDNPSession - pointer to session
+ *  pFilename - name of file being opened
+ *  filenameLength - length of name
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _closeHeldFile(
+  SDNPSESN *pSDNPSession,
+  const TMWTYPES_CHAR *pFilename,
+  TMWTYPES_USHORT filenameLength)
+{
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  TMWSESN *pSession = (TMWSESN *)pSDNPSession;
+  int i;
+
+  for(i = 0; i < SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1; i++)
+  {
+    SDNPO070_FILE_CONTROL_BLOCK *pHeldFileCtrl =
+      (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70HeldFileCtrl[i];
+
+    if(_sameFile(pHeldFileCtrl, pFilename, filenameLength))
+    {
+      tmwtimer_cancel(&pHeldFileCtrl->fileTransferTimer);
+      sdnpdata_closeFile(pSession, pHeldFileCtrl->handle);
+      sdnpmem_free(pHeldFileCtrl);
+      pSDNPSession->pObj70HeldFileCtrl[i] = TMWDEFS_NULL;
+
+      SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_FILE_AUTO_CLOSE);
+    }
+  }
+#else
+  TMWTARG_UNUSED_PARAM(pSDNPSession);
+  TMWTARG_UNUSED_PARAM(pFilename);
+  TMWTARG_UNUSED_PARAM(filenameLength);
+#endif
+}
+
 /* function: _openFileRetryCmd 
  * purpose: Call sdnpdata function to see if database open function
  *  is complete.
@@ -1092,6 +1316,15 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _processOpenRequest(
   pRxFragment->offset = pRxFragment->offset + filenameLength;
   filename[filenameLength] = '\0';
 
+  /* Hold the current file open while this one is transferred, unless this
+   * is a reopen of the current file which is handled below
+   */
+  if(!_sameFile((SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl, filename, filenameLength))
+  {
+    _closeHeldFile(pSDNPSession, filename, filenameLength);
+    _holdFileCtrl(pSDNPSession);
+  }
+
   pObj70FileCtrl = _allocateFileCtrl(pSDNPSession);
   
   if(pObj70FileCtrl == TMWDEFS_NULL)
@@ -1100,8 +1333,7 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _processOpenRequest(
     SDNPO070_FILE_CONTROL_BLOCK *pOldFileCtrl = (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
     if(pOldFileCtrl != TMWDEFS_NULL)
     { 
-      if((pOldFileCtrl->filenameLength == filenameLength)
-        &&(!memcmp(filename, pOldFileCtrl->filename, filenameLength)))
+      if(_sameFile(pOldFileCtrl, filename, filenameLength))
       { 
         /* Close the file, so it can be reopened below */
         _closeFile(pSession, pOldFileCtrl->handle);
@@ -1287,6 +1519,10 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _processCloseRequest(
 
   DNPDIAG_SHOW_FILE_CLOSE(pSession, handle, requestId);
 
+  /* The file may be held while another one is transferred */
+  _selectFileCtrl(pSDNPSession, handle);
+  pObj70FileCtrl = (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
+
   /* If there is not a transfer in progress */
   if(pObj70FileCtrl == TMWDEFS_NULL)
   {
@@ -1400,6 +1636,9 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _processAbortRequest(
     /* Log error but continue */
   }
 
+  _selectFileCtrl(pSDNPSession, handle);
+  pObj70FileCtrl = (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
+
   if(pObj70FileCtrl == TMWDEFS_NULL)
   {
     status = DNPDEFS_FILE_CMD_STAT_INV_HANDLE;
@@ -1539,9 +1778,8 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _processDeleteRequest(
 
   pObj70FileCtrl = TMWDEFS_NULL;
 
-  /* If the file control block is in use, just say no */
-  /* When multiple file control blocks are supported this would change */
-  if(pSDNPSession->pObj70FileCtrl != TMWDEFS_NULL)
+  /* If the file control block is in use and cannot be held, just say no */
+  if(!_holdFileCtrl(pSDNPSession))
   {
     status = DNPDEFS_FILE_CMD_STAT_TOO_MANY;
   }
@@ -1812,6 +2050,7 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _processGetInfoRequest(
   pRxFragment->offset = pRxFragment->offset + filenameLength;
   filename[copyLength] = '\0';
 
+  _holdFileCtrl((SDNPSESN *)pSession);
   pObj70FileCtrl = _allocateFileCtrl((SDNPSESN *)pSession);
   if(pObj70FileCtrl != TMWDEFS_NULL)
   {
@@ -2234,6 +2473,9 @@ SDNPSESN_READ_STATUS TMWDEFS_CALLBACK sdnpo070_readObj70(
     if(qualifier != SDNPSESN_QUAL_BUILD_RESPONSE)
       return(SDNPSESN_READ_COMPLETE);
 
+    _selectFileCtrl(pSDNPSession, handle);
+    pObj70FileCtrl = (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
+
     /* If there is not a transfer in progress, try to allocate a control block 
      * for sending the response
      */
@@ -2498,6 +2740,9 @@ TMWTYPES_BOOL TMWDEFS_CALLBACK sdnpo070_writeObj70(
 
   status = DNPDEFS_FILE_TFER_STAT_SUCCESS;
 
+  _selectFileCtrl(pSDNPSession, handle);
+  pObj70FileCtrl = (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
+
   if(pObj70FileCtrl == TMWDEFS_NULL)
   {
     status = DNPDEFS_FILE_TFER_STAT_NOT_OPEN;
@@ -2617,8 +2862,8 @@ void TMWDEFS_GLOBAL sdnpo070_fileCmdComplete(
   TMWDEFS_RESOURCE_LOCK *pLock = &pSession->pChannel->lock;
 #endif
 
-  /* Since only one file transfer per session is currently supported
-   * ignore the handle 
+  /* Only the current file control block can be waiting on the database,
+   * held files have no command pending, so ignore the handle
    */
   TMWTARG_UNUSED_PARAM(handle);
 
@@ -1209,9 +1209,9 @@ static void TMWDEFS_LOCAL _sendChallengeV1ReplyV2(
       pAuthInfo->MACAlgorithmRcvd, &pUserContext->monitorSessionKey,
       pRxFragment->pMsgBuf, pRxFragment->msgLength,
 #if DNPCNFG_MULTI_SESSION_REQUESTS
-      pSDNPSession->lastUnsolTxFragment, pSDNPSession->lastUnsolTxFragmentLength,
+      DNPCHNL_HELD_MSGBUF(pSDNPSession->pLastUnsolTxFragment), DNPCHNL_HELD_MSGLEN(pSDNPSession->pLastUnsolTxFragment),
 #else
-      pDNPChannel->lastUnsolTxFragment, pDNPChannel->lastUnsolTxFragmentLength,
+      DNPCHNL_HELD_MSGBUF(pDNPChannel->pLastUnsolTxFragment), DNPCHNL_HELD_MSGLEN(pDNPChannel->pLastUnsolTxFragment),
 #endif
       &pResponse->pMsgBuf[pResponse->msgLength], &length);
   }
@@ -1221,9 +1221,9 @@ static void TMWDEFS_LOCAL _sendChallengeV1ReplyV2(
       pAuthInfo->MACAlgorithmRcvd, &pUserContext->monitorSessionKey,
       pRxFragment->pMsgBuf, pRxFragment->msgLength,
 #if DNPCNFG_MULTI_SESSION_REQUESTS
-      pSDNPSession->dnp.lastTxFragment, pSDNPSession->dnp.lastTxFragmentLength,
+      DNPCHNL_HELD_MSGBUF(pSDNPSession->dnp.pLastTxFragment), DNPCHNL_HELD_MSGLEN(pSDNPSession->dnp.pLastTxFragment),
 #else
-      pDNPChannel->lastTxFragment, pDNPChannel->lastTxFragmentLength,
+      DNPCHNL_HELD_MSGBUF(pDNPChannel->pLastTxFragment), DNPCHNL_HELD_MSGLEN(pDNPChannel->pLastTxFragment),
 #endif
       &pResponse->pMsgBuf[pResponse->msgLength], &length);
   }
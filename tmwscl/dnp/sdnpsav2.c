@@ -818,9 +818,9 @@ static void TMWDEFS_LOCAL _sendChallengeReply(
     pInfo->MACAlgorithmRcvd, &pUserContext->monitorSessionKeyV2, 
     pRxFragment->pMsgBuf, pRxFragment->msgLength,
 #if DNPCNFG_MULTI_SESSION_REQUESTS
-    pSDNPSession->dnp.lastTxFragment, pSDNPSession->dnp.lastTxFragmentLength,
+    DNPCHNL_HELD_MSGBUF(pSDNPSession->dnp.pLastTxFragment), DNPCHNL_HELD_MSGLEN(pSDNPSession->dnp.pLastTxFragment),
 #else
-    pDNPChannel->lastTxFragment, pDNPChannel->lastTxFragmentLength,
+    DNPCHNL_HELD_MSGBUF(pDNPChannel->pLastTxFragment), DNPCHNL_HELD_MSGLEN(pDNPChannel->pLastTxFragment),
 #endif
     &pResponse->pMsgBuf[pResponse->msgLength], &length);
   
@@ -81,6 +81,8 @@
 #include "tmwscl/dnp/sdnpo114.h"
 #include "tmwscl/dnp/sdnpo115.h"
 #include "tmwscl/dnp/sdnpo120.h"
+#include "tmwscl/dnp/sdnpjrnl.h"
+#include "tmwscl/dnp/sdnpmqtt.h"
 #if DNPCNFG_SUPPORT_AUTHENTICATION
 #if SDNPCNFG_SUPPORT_SA_VERSION5
 #include "tmwscl/dnp/sdnpsa.h"  
@@ -763,6 +765,123 @@ static void TMWDEFS_GLOBAL _sendResponse(
   }
 }
 
+/* function: _discardAsyncControlResponse
+ * purpose: Free an operate response that is waiting for controls to 
+ *  complete. Results reported for those controls later are ignored.
+ * arguments:
+ *  pSDNPSession - session
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _discardAsyncControlResponse(
+  SDNPSESN *pSDNPSession)
+{
+  tmwtimer_cancel(&pSDNPSession->asyncControlTimer);
+
+  if(pSDNPSession->pAsyncControlResponse != TMWDEFS_NULL)
+  {
+    dnpchnl_freeTxData(pSDNPSession->pAsyncControlResponse);
+    pSDNPSession->pAsyncControlResponse = TMWDEFS_NULL;
+  }
+  pSDNPSession->numAsyncControls = 0;
+  pSDNPSession->asyncControlsPending = 0;
+}
+
+/* function: _sendAsyncControlResponse
+ * purpose: Send an operate response that was waiting for controls to
+ *  complete
+ * arguments:
+ *  pSession - session
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _sendAsyncControlResponse(
+  TMWSESN *pSession)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  TMWSESN_TX_DATA *pResponse = pSDNPSession->pAsyncControlResponse;
+
+  tmwtimer_cancel(&pSDNPSession->asyncControlTimer);
+  pSDNPSession->pAsyncControlResponse = TMWDEFS_NULL;
+  pSDNPSession->numAsyncControls = 0;
+  pSDNPSession->asyncControlsPending = 0;
+
+  _sendResponse(pSession, TMWDEFS_FALSE, &pSDNPSession->lastRcvdRequest, pResponse);
+}
+
+/* function: _asyncControlTimeout
+ * purpose: Send the operate response when the database has not reported
+ *  the result of all of its controls within asyncControlTimeout
+ * arguments:
+ *  pCallbackParam - pointer to user specified callback parameter, points
+ *   to session.
+ * returns:
+ *  void
+ */
+static void TMWDEFS_CALLBACK _asyncControlTimeout(
+  void *pCallbackParam)
+{
+  TMWSESN *pSession = (TMWSESN *)pCallbackParam;
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  int index;
+
+  if(pSDNPSession->pAsyncControlResponse == TMWDEFS_NULL)
+    return;
+
+  for(index = 0; index < pSDNPSession->numAsyncControls; index++)
+  {
+    SDNPSESN_ASYNC_CONTROL *pControl = &pSDNPSession->asyncControls[index];
+    if(pControl->pending)
+    {
+      SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_ASYNC_CTRL_TIMEOUT);
+      pSDNPSession->pAsyncControlResponse->pMsgBuf[pControl->statusOffset] = DNPDEFS_CTLSTAT_HARDWARE_ERROR;
+      pControl->pending = TMWDEFS_FALSE;
+    }
+  }
+  pSDNPSession->asyncControlsPending = 0;
+
+  _processNextMessage(pSession);
+}
+
+/* function: _deferControlResponse
+ * purpose: Hold an operate response if the database is still executing
+ *  any of its controls
+ * arguments:
+ *  pSession - session the operate request was received on
+ *  noResp - no response will be sent for this request
+ *  pResponse - operate response
+ * returns:
+ *  TMWDEFS_TRUE if the response is held until its controls complete
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _deferControlResponse(
+  TMWSESN *pSession,
+  TMWTYPES_BOOL noResp,
+  TMWSESN_TX_DATA *pResponse)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+
+  /* Results reported from now on complete the held response */
+  pSDNPSession->executingControls = TMWDEFS_FALSE;
+  pSDNPSession->earlyControl.pending = TMWDEFS_FALSE;
+
+  /* There is nothing to wait for if no response will be sent */
+  if((pSDNPSession->asyncControlsPending == 0)
+    || noResp || pSDNPSession->lastRcvdRequest.isBroadcast)
+  {
+    pSDNPSession->pAsyncControlResponse = TMWDEFS_NULL;
+    pSDNPSession->numAsyncControls = 0;
+    pSDNPSession->asyncControlsPending = 0;
+    return(TMWDEFS_FALSE);
+  }
+
+  pSDNPSession->pAsyncControlResponse = pResponse;
+  tmwtimer_start(&pSDNPSession->asyncControlTimer,
+    pSDNPSession->asyncControlTimeout, pSession->pChannel,
+    _asyncControlTimeout, pSession);
+
+  return(TMWDEFS_TRUE);
+}
+
 
 /* function: _sendNullResponse */
 static TMWTYPES_BOOL TMWDEFS_LOCAL _sendNullResponse(
@@ -1121,6 +1240,14 @@ static void TMWDEFS_CALLBACK _processNextMessage(
   if(pSDNPSession->dnp.pCurrentMessage != TMWDEFS_NULL)
     return;
 
+  /* Send an operate response once all of its controls have completed */
+  if((pSDNPSession->pAsyncControlResponse != TMWDEFS_NULL)
+    && (pSDNPSession->asyncControlsPending == 0))
+  {
+    _sendAsyncControlResponse(pSession);
+    return;
+  }
+
   /* See if we have a pending request to process */
   if(pSDNPSession->pendingRequest)
   {
@@ -1297,6 +1424,22 @@ static TMWTYPES_BOOL TMWDEFS_CALLBACK _processFragment(
     dnpchnl_cancelFragment(pSDNPSession->dnp.pCurrentMessage);
   }
 
+  /* If an operate response is waiting for controls to complete, a retry
+   * of that request will be answered by it. Any other request replaces it.
+   * lastRcvdRequest still holds the operate request at this point.
+   */
+  if(pSDNPSession->pAsyncControlResponse != TMWDEFS_NULL)
+  {
+    if((pRxFragment->msgLength == pSDNPSession->lastRcvdRequest.msgLength)
+      && (memcmp(pRxFragment->pMsgBuf, pSDNPSession->lastRcvdRequest.pMsgBuf, pRxFragment->msgLength) == 0))
+    {
+      return(TMWDEFS_TRUE);
+    }
+
+    SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_ASYNC_CTRL_DISCARD);
+    _discardAsyncControlResponse(pSDNPSession);
+  }
+
   /* Parse application header into lastRcvdRequest*/
   sdnputil_parseApplHeader(pRxFragment, pSDNPSession);
 
@@ -1445,6 +1588,10 @@ static void TMWDEFS_CALLBACK _processError(
     /* if it timed out on the queue */
     pSDNPSession->unsolQueued = TMWDEFS_FALSE;
 
+#if TMWCNFG_SUPPORT_METRICS
+    TMWMETR_INC(pSession->metrics.unsolRetries);
+#endif
+
     /* Yep, no longer waiting for confirm */
     pSDNPSession->unsolWaitingForConfirm = TMWDEFS_FALSE;
 #if SDNPDATA_SUPPORT_IDENT_UNSOL_RETRY
@@ -1711,6 +1858,10 @@ static void TMWDEFS_CALLBACK _afterTxCallback(
 #endif
     pTxData->txFlags |= TMWSESN_TXFLAGS_NO_RESPONSE;
 
+#if TMWCNFG_SUPPORT_METRICS
+    pSession->metrics.unsolSentTime = tmwtarg_getMSTime();
+#endif
+
     /* Start unsolicited confirmation timeout */
     tmwtimer_start(&pSDNPSession->unsolRetryTimer, 
       pSDNPSession->unsolConfirmTimeout,
@@ -1931,6 +2082,11 @@ static void TMWDEFS_LOCAL _processConfirm(
         /* Cancel retry timer since we have received a valid confirmation */
         tmwtimer_cancel(&pSDNPSession->unsolRetryTimer);
 
+#if TMWCNFG_SUPPORT_METRICS
+        tmwmetr_observe(&pSession->metrics.unsolConfirmLatency,
+          tmwtarg_getMSTime() - pSession->metrics.unsolSentTime);
+#endif
+
 #if SDNPDATA_SUPPORT_OBJ120 
         /* tell authentication that the confirm was received */
         sdnpauth_applConfirm(pSDNPSession);
@@ -2610,6 +2766,10 @@ static void TMWDEFS_LOCAL _processOperateRequest(
   /* Don't process this message again even from afterTxCallback */
   pSDNPSession->pendingRequest = TMWDEFS_FALSE;
 
+  /* Until _deferControlResponse, see sdnpsesn_controlComplete */
+  pSDNPSession->executingControls = TMWDEFS_TRUE;
+  pSDNPSession->earlyControl.pending = TMWDEFS_FALSE;
+
   /* Process operate request */
   while(pRxMessage->offset < pRxMessage->msgLength)
   {
@@ -2670,6 +2830,10 @@ static void TMWDEFS_LOCAL _processOperateRequest(
     }
   }
 
+  /* Hold the response while the database is still executing controls */
+  if(_deferControlResponse(pSession, TMWDEFS_FALSE, pResponse))
+    return;
+
   /* Send response */
   
   _sendResponse(pSession, TMWDEFS_FALSE, pRxMessage, pResponse);
@@ -2733,6 +2897,10 @@ static void TMWDEFS_LOCAL _processDirectOperateRequest(
   /* Don't process this message again even from afterTxCallback */
   pSDNPSession->pendingRequest = TMWDEFS_FALSE;
 
+  /* Until _deferControlResponse, see sdnpsesn_controlComplete */
+  pSDNPSession->executingControls = TMWDEFS_TRUE;
+  pSDNPSession->earlyControl.pending = TMWDEFS_FALSE;
+
   while(pRxMessage->offset < pRxMessage->msgLength)
   {
     if(!dnputil_parseObjectHeader(pRxMessage, 0, &header))
@@ -2790,6 +2958,10 @@ static void TMWDEFS_LOCAL _processDirectOperateRequest(
   /* If reply required, send it */
   noResp = (TMWTYPES_BOOL)((pRxMessage->fc == DNPDEFS_FC_DIRECT_OP_NOACK) ? TMWDEFS_TRUE : TMWDEFS_FALSE);
 
+  /* Hold the response while the database is still executing controls */
+  if(_deferControlResponse(pSession, noResp, pResponse))
+    return;
+
   /* Send response */
 
   _sendResponse(pSession, noResp, pRxMessage, pResponse);
@@ -3813,6 +3985,7 @@ void TMWDEFS_GLOBAL sdnpsesn_initConfig(
 
   pConfig->allowMultiCROBRequests = TMWDEFS_TRUE;
   pConfig->maxControlRequests = SDNPCNFG_MAX_CONTROL_REQUESTS;
+  pConfig->asyncControlTimeout = TMWDEFS_SECONDS(3);
   pConfig->enabledBroadcastWrites = 0xf;
   pConfig->enabledBroadcastFCs = 0xffffffff;
   pConfig->enabledFCs = 0xffffffff;
@@ -4037,14 +4210,29 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_applyBinaryFileValues(
     void *pIoConfig,
     SDNPSESN_CONFIG *pSesnConfig)
 {
-  FILE *configfp;
+  return(sdnpsesn_applyBinaryFileValuesEx(pFileName, pDNPConfig,
+    pLinkConfig, pIoConfig, pSesnConfig, TMWDEFS_NULL));
+}
+
+/* function: sdnpsesn_applyBinaryFileValuesEx */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_applyBinaryFileValuesEx(
+    char * pFileName,
+    DNPCHNL_CONFIG *pDNPConfig,
+    DNPLINK_CONFIG *pLinkConfig, 
+    void *pIoConfig,
+    SDNPSESN_CONFIG *pSesnConfig,
+    DNPBNCFG_FILEVALUES *pBinFileValues)
+{
   TMWTYPES_BOOL isChannelSerial;
   TMWTYPES_BOOL success;
   TMWTYPES_USHORT xmlVersionIndex;
   DNPBNCFG_FILEVALUES binFileValues;
   TMWTARG_BINFILE_VALS binFileTargValues;
 
-  configfp = NULL;
+  /* Read into the caller's structure so it can create the listed points */
+  if(pBinFileValues == TMWDEFS_NULL)
+    pBinFileValues = &binFileValues;
+
   xmlVersionIndex = 0;
   isChannelSerial = TMWDEFS_FALSE;
   success = TMWDEFS_FALSE;
@@ -4052,30 +4240,16 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_applyBinaryFileValues(
   tmwtarg_initBinFileValues(&binFileTargValues);
   binFileTargValues.sessionIsOutstation = TMWDEFS_TRUE;
 
-
-#if defined(_MSC_VER) && !defined(_WIN32_WCE)
-#if _MSC_VER >= 1400
-  fopen_s(&configfp, pFileName, "rb"); 
-#else
-  configfp = fopen(pFileName, "rb");
-#endif
-#endif
-
-  if(configfp != NULL)
-  {
-    success = dnpbncfg_ReadBinaryConfigFile(configfp, &binFileValues, &binFileTargValues, &xmlVersionIndex);
-
-    fclose(configfp);
-  }
+  success = dnpbncfg_LoadBinaryConfigFile(pFileName, pBinFileValues, &binFileTargValues, &xmlVersionIndex);
 
   if(success)
     success = tmwtarg_applyBinFileTargValues(pIoConfig, &binFileTargValues, &isChannelSerial);
 
   if(success)
-    success = sdnpsesn_getBinFileSessionValues(pSesnConfig, &binFileValues, isChannelSerial, xmlVersionIndex);
+    success = sdnpsesn_getBinFileSessionValues(pSesnConfig, pBinFileValues, isChannelSerial, xmlVersionIndex);
 
   if(success)
-    success = dnpchnl_getBinFileChannelValues(pDNPConfig, pLinkConfig, &binFileValues, TMWDEFS_TRUE);
+    success = dnpchnl_getBinFileChannelValues(pDNPConfig, pLinkConfig, pBinFileValues, TMWDEFS_TRUE);
 
 
   return success;
@@ -4086,8 +4260,7 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_applyBinaryFileValues(
 void TMWDEFS_CALLBACK _saveLastUnsolSent(TMWSESN *pSession, TMWSESN_TX_DATA *pTxData)
 {
   SDNPSESN *pSDNPSession = (SDNPSESN*)pSession;
-  memcpy(pSDNPSession->lastUnsolTxFragment, pTxData->pMsgBuf, pTxData->msgLength);
-  pSDNPSession->lastUnsolTxFragmentLength = pTxData->msgLength;
+  dnpchnl_holdTxData(&pSDNPSession->pLastUnsolTxFragment, pTxData);
 }
 #endif
 
@@ -4170,6 +4343,16 @@ TMWSESN * TMWDEFS_GLOBAL sdnpsesn_openSession(
     return(TMWDEFS_NULL);
   }
 
+#if TMWTARG_SUPPORT_JOURNAL
+  pSDNPSession->pJournal = TMWDEFS_NULL;
+#endif
+#if SDNPCNFG_SUPPORT_MQTT_COMMANDS
+  pSDNPSession->pMqttCommands = TMWDEFS_NULL;
+#endif
+#if SDNPCNFG_SUPPORT_MQTT_PUBLISHER
+  pSDNPSession->pMqttPublisher = TMWDEFS_NULL;
+#endif
+
   /* Initialize unsolicited event processing */
   pSDNPSession->unsolNumRetries = 0;
   pSDNPSession->unsolEventsReady = TMWDEFS_FALSE;
@@ -4202,6 +4385,12 @@ TMWSESN * TMWDEFS_GLOBAL sdnpsesn_openSession(
   pSDNPSession->selectBufferLength = 0;
   pSDNPSession->selectSequenceNumber = 0;
 
+  pSDNPSession->pAsyncControlResponse = TMWDEFS_NULL;
+  pSDNPSession->numAsyncControls = 0;
+  pSDNPSession->asyncControlsPending = 0;
+  pSDNPSession->executingControls = TMWDEFS_FALSE;
+  pSDNPSession->earlyControl.pending = TMWDEFS_FALSE;
+
   /* Current response message outstanding */
   pSDNPSession->dnp.pCurrentMessage = TMWDEFS_NULL;
 
@@ -4220,11 +4409,16 @@ TMWSESN * TMWDEFS_GLOBAL sdnpsesn_openSession(
 
   /* Initialize timers */
   tmwtimer_init(&pSDNPSession->selectTimer);
+  tmwtimer_init(&pSDNPSession->asyncControlTimer);
   tmwtimer_init(&pSDNPSession->unsolRetryTimer);
   tmwtimer_init(&pSDNPSession->clockValidTimer);
 
 #if SDNPDATA_SUPPORT_OBJ70
   pSDNPSession->pObj70FileCtrl = TMWDEFS_NULL;
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  for(i = 0; i < SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1; i++)
+    pSDNPSession->pObj70HeldFileCtrl[i] = TMWDEFS_NULL;
+#endif
 #endif
 
   /* Initialize pending read request buffer */
@@ -4250,8 +4444,8 @@ TMWSESN * TMWDEFS_GLOBAL sdnpsesn_openSession(
   }
 
 #if DNPCNFG_MULTI_SESSION_REQUESTS
-  pSDNPSession->dnp.lastTxFragmentLength = 0;
-  pSDNPSession->lastUnsolTxFragmentLength = 0;
+  pSDNPSession->dnp.pLastTxFragment = TMWDEFS_NULL;
+  pSDNPSession->pLastUnsolTxFragment = TMWDEFS_NULL;
 #endif
 #endif
   
@@ -4295,6 +4489,8 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_modifySession(
     pSession->destAddress = pConfig->destination;
   }
 
+  dnplink_updateSessionAddress(pSession);
+
   if((configMask & SDNPSESN_CONFIG_UNSOL_ALLOWED) != 0)
   {
     pSDNPSession->unsolAllowed = pConfig->unsolAllowed;
@@ -4400,6 +4596,7 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_getSessionConfig(
   pConfig->coldRestartDelay        = pSDNPSession->coldRestartDelay;
   pConfig->allowMultiCROBRequests  = pSDNPSession->allowMultiCROBRequests;
   pConfig->maxControlRequests      = pSDNPSession->maxControlRequests;
+  pConfig->asyncControlTimeout     = pSDNPSession->asyncControlTimeout;
   pConfig->enabledBroadcastWrites  = pSDNPSession->enabledBroadcastWrites;
   pConfig->enabledBroadcastFCs     = pSDNPSession->enabledBroadcastFCs;
   pConfig->enabledFCs              = pSDNPSession->enabledFCs;
@@ -4564,6 +4761,7 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_setSessionConfig(
   pSession->active             = pConfig->active;
   pSession->srcAddress         = pConfig->source;
   pSession->destAddress        = pConfig->destination;
+  dnplink_updateSessionAddress(pSession);
   pSession->pStatCallbackFunc  = pConfig->pStatCallback;
   pSession->pStatCallbackParam = pConfig->pStatCallbackParam;
   
@@ -4590,6 +4788,7 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_setSessionConfig(
     pSDNPSession->maxControlRequests = SDNPCNFG_MAX_CONTROL_REQUESTS;
   else
     pSDNPSession->maxControlRequests   = pConfig->maxControlRequests;
+  pSDNPSession->asyncControlTimeout    = pConfig->asyncControlTimeout;
   pSDNPSession->enabledBroadcastFCs    = pConfig->enabledBroadcastFCs;
   pSDNPSession->enabledBroadcastWrites = pConfig->enabledBroadcastWrites;
   pSDNPSession->enabledFCs             = pConfig->enabledFCs;
@@ -4849,6 +5048,21 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_closeSession(
   }
 #endif
 
+#if DNPCNFG_SUPPORT_AUTHENTICATION && DNPCNFG_MULTI_SESSION_REQUESTS
+  /* Release the last fragments sent */
+  dnpchnl_holdTxData(&pSDNPSession->dnp.pLastTxFragment, TMWDEFS_NULL);
+  dnpchnl_holdTxData(&pSDNPSession->pLastUnsolTxFragment, TMWDEFS_NULL);
+#endif
+
+#if TMWTARG_SUPPORT_JOURNAL
+  /* Write the final checkpoint while the events are still queued */
+  sdnpjrnl_close(pSession);
+#endif
+
+#if SDNPCNFG_SUPPORT_MQTT_COMMANDS
+  sdnpmqtt_close(pSession);
+#endif
+
   /* Cancel report by exception processing for this session */
   sdnprbe_close(pSession);
 
@@ -4864,6 +5078,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_closeSession(
   /* Select timer */
   tmwtimer_cancel(&pSDNPSession->selectTimer);
 
+  /* Operate response waiting for controls to complete */
+  _discardAsyncControlResponse(pSDNPSession);
+
 #if SDNPDATA_SUPPORT_OBJ70
   if(pSDNPSession->pObj70FileCtrl != TMWDEFS_NULL)
   {
@@ -4874,6 +5091,23 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_closeSession(
     tmwtimer_cancel(&pObj70FileCtrl->retryTimer);
     sdnpmem_free(pObj70FileCtrl);
   }
+
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  /* Held files are not waiting on the database, close them now */
+  for(i = 0; i < SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1; i++)
+  {
+    if(pSDNPSession->pObj70HeldFileCtrl[i] != TMWDEFS_NULL)
+    {
+      SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl =
+        (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70HeldFileCtrl[i];
+
+      tmwtimer_cancel(&pObj70FileCtrl->fileTransferTimer);
+      sdnpdata_closeFile(pSession, pObj70FileCtrl->handle);
+      sdnpmem_free(pObj70FileCtrl);
+      pSDNPSession->pObj70HeldFileCtrl[i] = TMWDEFS_NULL;
+    }
+  }
+#endif
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ120
@@ -4919,6 +5153,119 @@ SDNPSESN_READ_FUNC TMWDEFS_GLOBAL sdnpsesn_getStaticReadFunc(
   return(TMWDEFS_NULL);
 } 
 
+/* function: sdnpsesn_deferControl */
+TMWTYPES_UCHAR TMWDEFS_GLOBAL sdnpsesn_deferControl(
+  TMWSESN *pSession,
+  TMWSESN_TX_DATA *pResponse,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPSESN_ASYNC_CONTROL *pControl;
+
+  /* The database may have reported the result before returning ASYNC */
+  pControl = &pSDNPSession->earlyControl;
+  if(pControl->pending
+    && (pControl->group == group)
+    && (pControl->point == point))
+  {
+    pControl->pending = TMWDEFS_FALSE;
+    return(pControl->status);
+  }
+
+  if(pSDNPSession->numAsyncControls >= SDNPCNFG_MAX_CONTROL_REQUESTS)
+    return(DNPDEFS_CTLSTAT_UNDEFINED);
+
+  /* The status byte will be stored at the current end of the response */
+  pControl = &pSDNPSession->asyncControls[pSDNPSession->numAsyncControls++];
+  pControl->group = group;
+  pControl->point = point;
+  pControl->statusOffset = pResponse->msgLength;
+  pControl->pending = TMWDEFS_TRUE;
+  pSDNPSession->asyncControlsPending++;
+
+  /* The response is held if this is still pending once the request has
+   * been executed, see _deferControlResponse
+   */
+  pSDNPSession->pAsyncControlResponse = pResponse;
+
+  return(DNPDEFS_CTLSTAT_SUCCESS);
+}
+
+/* function: sdnpsesn_controlComplete */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_controlComplete(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_UCHAR status)
+{
+#if TMWCNFG_SUPPORT_THREADS
+  TMWDEFS_RESOURCE_LOCK *pLock;
+#endif
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  TMWTYPES_BOOL found = TMWDEFS_FALSE;
+  int i;
+
+#if TMWCNFG_SUPPORT_THREADS
+  /* Lock channel */
+  pLock = &pSession->pChannel->lock;
+  TMWTARG_LOCK_SECTION(pLock);
+#endif
+
+  if(pSDNPSession->pAsyncControlResponse != TMWDEFS_NULL)
+  {
+    for(i = 0; i < pSDNPSession->numAsyncControls; i++)
+    {
+      SDNPSESN_ASYNC_CONTROL *pControl = &pSDNPSession->asyncControls[i];
+      if(pControl->pending
+        && (pControl->group == group)
+        && (pControl->point == point))
+      {
+        pSDNPSession->pAsyncControlResponse->pMsgBuf[pControl->statusOffset] = status;
+        sdnputil_updateIINAfterSelOp(pSession, status);
+        pControl->pending = TMWDEFS_FALSE;
+        pSDNPSession->asyncControlsPending--;
+        found = TMWDEFS_TRUE;
+        break;
+      }
+    }
+
+    /* Send the response once the last control has completed, unless the
+     * rest of the request is still being executed
+     */
+    if(found && (pSDNPSession->asyncControlsPending == 0)
+      && !pSDNPSession->executingControls)
+      _processNextMessage(pSession);
+  }
+
+#if SDNPCNFG_SUPPORT_MQTT_COMMANDS
+  /* Otherwise it may be a command received over MQTT */
+  if(!found)
+    found = sdnpmqtt_controlComplete(pSession, group, point, status);
+#endif
+
+  /* Called from inside sdnpdata_binOutOperate or sdnpdata_anlgOutOperate,
+   * before the control was deferred. Keep the result for
+   * sdnpsesn_deferControl.
+   */
+  if(!found && pSDNPSession->executingControls
+    && !pSDNPSession->earlyControl.pending)
+  {
+    pSDNPSession->earlyControl.group = group;
+    pSDNPSession->earlyControl.point = point;
+    pSDNPSession->earlyControl.status = status;
+    pSDNPSession->earlyControl.pending = TMWDEFS_TRUE;
+    found = TMWDEFS_TRUE;
+  }
+
+#if TMWCNFG_SUPPORT_THREADS
+  /* Unlock channel */
+  TMWTARG_UNLOCK_SECTION(pLock);
+#endif
+
+  return(found);
+}
+
 #if DNPCNFG_SUPPORT_BINCONFIG
 TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_getBinFileSessionValues(
    SDNPSESN_CONFIG *pSesnConfig,
@@ -342,6 +342,14 @@ typedef struct SDNPSessionConfigStruct {
    * is set to TMWDEFS_FALSE this won't matter for CROBs.
    */
   TMWTYPES_UCHAR maxControlRequests;
+
+  /* Maximum time to wait for controls that sdnpdata_binOutOperate or
+   * sdnpdata_anlgOutOperate returned as ASYNC before sending the operate
+   * response anyway. Controls that have not completed by then are
+   * reported with status DNPDEFS_CTLSTAT_HARDWARE_ERROR. This should be
+   * less than the response timeout configured in the master.
+   */
+  TMWTYPES_MILLISECONDS asyncControlTimeout;
   
   /* Bit mask indicating which Writes are enabled for broadcast requests if
    * broadcast Write is enabled
@@ -709,7 +717,8 @@ extern "C" {
    *  The user should call this routing to initialize these data structures
    *  and then modify the desired fields before calling dnpchnl_openChannel
    *  to actually open the desired channel and sdnpsesn_openSession to open a session
-   *  on the channel.
+   *  on the channel. Points listed in the file are not created here, see
+   *  sdnpsesn_applyBinaryFileValuesEx.
    * arguments:
    *  pFileName - full path to the DNP3 binary configuration file
    *  pDNPConfig - pointer to DNP channel configuration, note that some
@@ -728,6 +737,26 @@ extern "C" {
     void *pIOConfig,
     SDNPSESN_CONFIG *pSesnConfig);
 
+  /* function: sdnpsesn_applyBinaryFileValuesEx
+   * purpose: Same as sdnpsesn_applyBinaryFileValues, but also returns the
+   *  values read from the file, so the points in its point list can be
+   *  created with sdnpsim_addBinFilePoints without reading it again.
+   * arguments:
+   *  pFileName, pDNPConfig, pLinkConfig, pIOConfig, pSesnConfig - see
+   *   sdnpsesn_applyBinaryFileValues
+   *  pBinFileValues - if not TMWDEFS_NULL, filled in with the values read
+   *   from the file, including the point ranges in its point list
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */ 
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_applyBinaryFileValuesEx (
+    char * pFileName, 
+    DNPCHNL_CONFIG *pDNPConfig,
+    DNPLINK_CONFIG *pLinkConfig, 
+    void *pIOConfig,
+    SDNPSESN_CONFIG *pSesnConfig,
+    DNPBNCFG_FILEVALUES *pBinFileValues);
+
   /* function: sdnpsesn_getSessionConfig
    * purpose:  Get current configuration from a currently open session
    * arguments:
@@ -785,6 +814,36 @@ extern "C" {
   TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpsesn_restartClockValidTime(
     TMWSESN *pSession);
 
+  /* function: sdnpsesn_controlComplete
+   * purpose: Report the result of a control that sdnpdata_binOutOperate
+   *  or sdnpdata_anlgOutOperate returned as ASYNC. This may be called
+   *  from another thread. The operate response is sent once every
+   *  control in the request has completed, or when asyncControlTimeout
+   *  expires. While the response is waiting the session keeps sending
+   *  unsolicited responses and the channel keeps servicing its other
+   *  sessions. A new request from the master other than a retry of the
+   *  same request discards the waiting response.
+   *  It may also be called from inside sdnpdata_binOutOperate or
+   *  sdnpdata_anlgOutOperate before that returns ASYNC. The result is
+   *  then kept until the control is deferred, and is sent in the
+   *  response as if the control had completed synchronously.
+   * arguments:
+   *  pSession - session the operate request was received on
+   *  group - object group of the control, 12 for binary outputs or
+   *   41 for analog outputs
+   *  point - point number of the control
+   *  status - DNPDEFS_CTLSTAT_XXX status of the control
+   * returns:
+   *  TMWDEFS_TRUE if the control was waiting for this result or the
+   *  result was kept for a control being executed,
+   *  TMWDEFS_FALSE if the response was already sent or discarded
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsesn_controlComplete(
+    TMWSESN *pSession,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point,
+    TMWTYPES_UCHAR status);
+
   /* function: sdnpsesn_addAuthUser
    * purpose: Add a Secure Authentication User
    * arguments:
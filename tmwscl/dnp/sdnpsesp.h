@@ -38,6 +38,7 @@
 #include "tmwscl/dnp/sdnpcnfg.h"
 #include "tmwscl/dnp/sdnpxml.h"
 #include "tmwscl/dnp/sdnpxml2.h"
+#include "tmwscl/dnp/sdnpxmlw.h"
 #include "tmwscl/utils/tmwchnl.h"
 #include "tmwscl/dnp/dnpbncfg.h"
 
@@ -76,6 +77,17 @@ typedef struct {
   TMWDEFS_CLASS_MASK classMask;
 } UNSOL_DELAY_TIMER;
 
+/* A control in the current operate request that the database is
+ * still executing
+ */
+typedef struct {
+  TMWTYPES_UCHAR group;
+  TMWTYPES_USHORT point;
+  TMWTYPES_USHORT statusOffset;
+  TMWTYPES_UCHAR status;
+  TMWTYPES_BOOL pending;
+} SDNPSESN_ASYNC_CONTROL;
+
 /* This size is large enough for binary output Obj 12 Var 1 
  * and for analog outputs Obj 41 Variations 1-4 
  * for datasets this needs to be large enough to hold a dataset 
@@ -129,6 +141,7 @@ typedef struct SDNPSessionStruct {
   
   TMWTYPES_BOOL allowMultiCROBRequests;
   TMWTYPES_UCHAR maxControlRequests;
+  TMWTYPES_MILLISECONDS asyncControlTimeout;
 
   TMWTYPES_BOOL recordedCurrentTime;
   TMWTYPES_MILLISECONDS recordCurrentTime;
@@ -376,6 +389,21 @@ typedef struct SDNPSessionStruct {
   /* Database Handle */
   void *pDbHandle;
 
+#if TMWTARG_SUPPORT_JOURNAL
+  /* Journal of the event queues and point values, see sdnpjrnl.h */
+  void *pJournal;
+#endif
+
+#if SDNPCNFG_SUPPORT_MQTT_COMMANDS
+  /* Commands received over MQTT, see sdnpmqtt.h */
+  void *pMqttCommands;
+#endif
+
+#if SDNPCNFG_SUPPORT_MQTT_PUBLISHER
+  /* Publisher point events are published on, see sdnpmpub.h */
+  void *pMqttPublisher;
+#endif
+
   /* Last sequence number received from remote device */
   TMWTYPES_UCHAR recvSequenceNumber;
 
@@ -397,6 +425,22 @@ typedef struct SDNPSessionStruct {
   TMWTYPES_USHORT selectBufferLength;
   TMWTYPES_UCHAR selectSequenceNumber;
 
+  /* Operate response waiting for controls the database completes
+   * asynchronously, see sdnpsesn_controlComplete
+   */
+  TMWSESN_TX_DATA *pAsyncControlResponse;
+  TMWTYPES_UCHAR numAsyncControls;
+  TMWTYPES_UCHAR asyncControlsPending;
+  SDNPSESN_ASYNC_CONTROL asyncControls[SDNPCNFG_MAX_CONTROL_REQUESTS];
+  TMWTIMER asyncControlTimer;
+
+  /* Set while the controls in an operate request are being executed. A
+   * result the database reports for a control before its operate function
+   * has returned ASYNC is kept in earlyControl until it is deferred.
+   */
+  TMWTYPES_BOOL executingControls;
+  SDNPSESN_ASYNC_CONTROL earlyControl;
+
   /* Buffer to hold current request */
   TMWTYPES_BOOL  duplicateRequestRcvd;
   TMWTYPES_BOOL  pendingRequest;
@@ -446,6 +490,13 @@ typedef struct SDNPSessionStruct {
 #if SDNPDATA_SUPPORT_OBJ70
   /* File transfer control block */
   void *pObj70FileCtrl;
+
+#if SDNPCNFG_OBJ70_MAX_OPEN_FILES > 1
+  /* Control blocks of the other open files, held while pObj70FileCtrl
+   * is processing requests for a different handle
+   */
+  void *pObj70HeldFileCtrl[SDNPCNFG_OBJ70_MAX_OPEN_FILES - 1];
+#endif
 #endif
   
 #if SDNPDATA_KEEP_LAST_RESPONSE
@@ -492,9 +543,10 @@ typedef struct SDNPSessionStruct {
   void           *pAuthenticationInfo;
 
 #if DNPCNFG_MULTI_SESSION_REQUESTS
-  /* If allowing simultaneous requests on multiple sessions on a channel */
-  TMWTYPES_USHORT lastUnsolTxFragmentLength;
-  TMWTYPES_UCHAR  lastUnsolTxFragment[DNPCNFG_MAX_TX_FRAGMENT_LENGTH];
+  /* If allowing simultaneous requests on multiple sessions on a channel,
+   * last unsolicited fragment sent, held using dnpchnl_holdTxData
+   */
+  DNPCHNL_TX_DATA *pLastUnsolTxFragment;
 #endif
 
 #endif
@@ -516,15 +568,19 @@ typedef struct SDNPSessionStruct {
    */
   TMWTYPES_UCHAR         xml2CurIndent;
   TMWTYPES_ULONG         xml2BufferLen;
-  TMWTYPES_ULONG         xml2BufferIndex;
   SDNPXML2_SAVE_STATE    xml2BufferState;
   SDNPXML2_SAVE_STATE    xml2SaveState;
   SDNPXML2_SAVE_SUBSTATE xml2SaveSubState;
   TMWTYPES_USHORT        xml2CurSavePointNum;
   TMWTYPES_UCHAR         xml2CurSaveElemNum;
 
-  /* buffer used for building XML output */
-  TMWTYPES_CHAR         *pXml2Buffer;
+  /* writes the XML output into the caller's buffer */
+  SDNPXMLW_STREAM        xml2Stream;
+
+  /* part of an element that did not fit in the last block */
+  TMWTYPES_CHAR          xml2Carry[SDNPCNFG_XML_SAVE_BUF_SIZE];
+
+  /* buffer used by sdnpxml2_saveDatabaseToFile */
   TMWTYPES_CHAR          xml2Buffer[SDNPCNFG_XML_SAVE_BUF_SIZE];
 #endif
 
@@ -607,6 +663,31 @@ extern "C" {
      TMWTYPES_UCHAR group,
      TMWTYPES_UCHAR variation);
 
+  /* function: sdnpsesn_deferControl
+   * purpose: Called by the operate functions when the database returned
+   *  ASYNC for a control. Remembers where the status of this control is
+   *  stored in the response so it can be filled in by
+   *  sdnpsesn_controlComplete. The response is then not sent until all
+   *  of the deferred controls in it have completed. If the database
+   *  already reported the result from inside its operate function, that
+   *  result is returned and nothing is deferred.
+   * arguments:
+   *  pSession - session the operate request was received on
+   *  pResponse - response being built, the status of this control
+   *   will be stored at pResponse->msgLength
+   *  group - object group of the control, 12 or 41
+   *  point - point number of the control
+   * returns: 
+   *  status to store in the response for now, DNPDEFS_CTLSTAT_SUCCESS,
+   *  the result already reported for this control, or
+   *  DNPDEFS_CTLSTAT_UNDEFINED if the control could not be deferred
+   */
+   TMWTYPES_UCHAR TMWDEFS_GLOBAL sdnpsesn_deferControl(
+     TMWSESN *pSession,
+     TMWSESN_TX_DATA *pResponse,
+     TMWTYPES_UCHAR group,
+     TMWTYPES_USHORT point);
+
    /* function: sdnpsesn_getBinFileSessionValues
    * purpose: Read session values from a struct holding values
    * read from a binary dnp config file.
@@ -0,0 +1,728 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: sdnpsevt.c
+ * description: Event storage shared by several DNP slave sessions.
+ *  See sdnpsevt.h.
+ */
+#include "tmwscl/dnp/sdnpsevt.h"
+
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/dnp/dnpdefs.h"
+#include "tmwscl/dnp/sdnpmem.h"
+#include "tmwscl/dnp/sdnpsesn.h"
+#include "tmwscl/dnp/sdnpo002.h"
+#include "tmwscl/dnp/sdnpo004.h"
+#include "tmwscl/dnp/sdnpo011.h"
+#include "tmwscl/dnp/sdnpo013.h"
+#include "tmwscl/dnp/sdnpo022.h"
+#include "tmwscl/dnp/sdnpo023.h"
+#include "tmwscl/dnp/sdnpo032.h"
+#include "tmwscl/dnp/sdnpo033.h"
+#include "tmwscl/dnp/sdnpo042.h"
+#include "tmwscl/dnp/sdnpo043.h"
+#include "tmwscl/utils/tmwsim.h"
+#include "tmwscl/dnp/sdnpsim.h"
+
+/* Object groups kept in the store, in queue order */
+static const TMWTYPES_UCHAR _sharedGroups[SDNPSEVT_NUM_GROUPS] = {
+  DNPDEFS_OBJ_2_BIN_CHNG_EVENTS,
+  DNPDEFS_OBJ_4_DBL_CHNG_EVENTS,
+  DNPDEFS_OBJ_11_BIN_OUT_EVENTS,
+  DNPDEFS_OBJ_13_BIN_CMD_EVENTS,
+  DNPDEFS_OBJ_22_CNTR_EVENTS,
+  DNPDEFS_OBJ_23_FCTR_EVENTS,
+  DNPDEFS_OBJ_32_ANA_CHNG_EVENTS,
+  DNPDEFS_OBJ_33_FRZN_ANA_EVENTS,
+  DNPDEFS_OBJ_42_ANA_OUT_EVENTS,
+  DNPDEFS_OBJ_43_ANA_CMD_EVENTS
+};
+
+/* Number of events a session takes from the store log at a time */
+#define SDNPSEVT_READ_BATCH 16
+
+/* function: _getSharedGroup
+ *  Get the queue index for an object group, or -1 if the group is not
+ *  kept in the store
+ */
+static int TMWDEFS_LOCAL _getSharedGroup(
+  TMWTYPES_UCHAR group)
+{
+  int i;
+  for(i = 0; i < SDNPSEVT_NUM_GROUPS; i++)
+  {
+    if(_sharedGroups[i] == group)
+      return(i);
+  }
+  return(-1);
+}
+
+/* function: _getQueue
+ *  Get the queue for an object group, or TMWDEFS_NULL if the group is
+ *  not kept in the store
+ */
+static SDNPSEVT_QUEUE * TMWDEFS_LOCAL _getQueue(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group)
+{
+  int index = _getSharedGroup(group);
+  if(index < 0)
+    return(TMWDEFS_NULL);
+  return(&pShared->queues[index]);
+}
+
+/* function: _storeValue
+ *  Copy the value of an event into a payload
+ */
+static void TMWDEFS_LOCAL _storeValue(
+  SDNPSEVT_PAYLOAD *pPayload,
+  TMWTYPES_UCHAR group,
+  SDNPDATA_ADD_EVENT_VALUE *pValue)
+{
+  switch(group)
+  {
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    pPayload->value.ulValue = pValue->ulValue;
+    break;
+
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+  case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+    pPayload->value.analogValue = *pValue->analogPtr;
+    break;
+
+  default:
+    pPayload->value.ulValue = 0;
+    break;
+  }
+}
+
+/* function: _allocPayload */
+static SDNPSEVT_PAYLOAD * TMWDEFS_LOCAL _allocPayload(
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_UCHAR flags,
+  SDNPDATA_ADD_EVENT_VALUE *pValue,
+  TMWDTIME *pTimeStamp)
+{
+  SDNPSEVT_PAYLOAD *pPayload;
+
+  pPayload = (SDNPSEVT_PAYLOAD *)sdnpmem_alloc(SDNPMEM_SIM_SHARED_EVENT_TYPE);
+  if(pPayload == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  pPayload->refCount = 1;
+  pPayload->group = group;
+  pPayload->point = point;
+  pPayload->flags = flags;
+  pPayload->timeStamp = *pTimeStamp;
+  _storeValue(pPayload, group, pValue);
+  return(pPayload);
+}
+
+/* function: _addRef */
+static void TMWDEFS_LOCAL _addRef(
+  SDNPSEVT_STORE *pStore,
+  SDNPSEVT_PAYLOAD *pPayload)
+{
+  TMWTARG_LOCK_SECTION(&pStore->refLock);
+  pPayload->refCount++;
+  TMWTARG_UNLOCK_SECTION(&pStore->refLock);
+}
+
+/* function: _release
+ *  Release a reference to an event, freeing it with the last reference
+ */
+static void TMWDEFS_LOCAL _release(
+  SDNPSEVT_STORE *pStore,
+  SDNPSEVT_PAYLOAD *pPayload)
+{
+  TMWTYPES_ULONG refCount;
+
+  TMWTARG_LOCK_SECTION(&pStore->refLock);
+  refCount = --pPayload->refCount;
+  TMWTARG_UNLOCK_SECTION(&pStore->refLock);
+
+  if(refCount == 0)
+    sdnpmem_free(pPayload);
+}
+
+/* function: _addToSession
+ *  Add an event to one session through the SCL
+ */
+static void TMWDEFS_LOCAL _addToSession(
+  TMWSESN *pSession,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_UCHAR flags,
+  SDNPDATA_ADD_EVENT_VALUE *pValue,
+  TMWDTIME *pTimeStamp)
+{
+  TMWTARG_UNUSED_PARAM(pSession);
+  TMWTARG_UNUSED_PARAM(point);
+  TMWTARG_UNUSED_PARAM(flags);
+  TMWTARG_UNUSED_PARAM(pValue);
+  TMWTARG_UNUSED_PARAM(pTimeStamp);
+  switch(group)
+  {
+#if SDNPDATA_SUPPORT_OBJ2
+  case DNPDEFS_OBJ_2_BIN_CHNG_EVENTS:
+    sdnpo002_addEvent(pSession, point, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ4
+  case DNPDEFS_OBJ_4_DBL_CHNG_EVENTS:
+    sdnpo004_addEvent(pSession, point, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ11
+  case DNPDEFS_OBJ_11_BIN_OUT_EVENTS:
+    sdnpo011_addEvent(pSession, point, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ13
+  case DNPDEFS_OBJ_13_BIN_CMD_EVENTS:
+    sdnpo013_addEvent(pSession, point, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ22
+  case DNPDEFS_OBJ_22_CNTR_EVENTS:
+    sdnpo022_addEvent(pSession, point, pValue->ulValue, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ23
+  case DNPDEFS_OBJ_23_FCTR_EVENTS:
+    sdnpo023_addEvent(pSession, point, pValue->ulValue, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ32
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+    sdnpo032_addEvent(pSession, point, pValue->analogPtr, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ33
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+    sdnpo033_addEvent(pSession, point, pValue->analogPtr, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ42
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+    sdnpo042_addEvent(pSession, point, pValue->analogPtr, flags, pTimeStamp);
+    break;
+#endif
+#if SDNPDATA_SUPPORT_OBJ43
+  case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+    sdnpo043_addEvent(pSession, point, pValue->analogPtr, flags, pTimeStamp);
+    break;
+#endif
+  }
+}
+
+/* function: _addFromLog
+ *  Add an event read from the store log to a session through the SCL.
+ *  sdnpsevt_eventAdd recognizes the event and shares it.
+ */
+static void TMWDEFS_LOCAL _addFromLog(
+  SDNPSEVT_SESSION *pShared,
+  SDNPSEVT_PAYLOAD *pPayload)
+{
+  SDNPDATA_ADD_EVENT_VALUE value;
+
+  switch(pPayload->group)
+  {
+  case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+  case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+  case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+  case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+    value.analogPtr = &pPayload->value.analogValue;
+    break;
+
+  default:
+    value.ulValue = pPayload->value.ulValue;
+    break;
+  }
+
+  pShared->pPending = pPayload;
+  pShared->pPendingTime = &pPayload->timeStamp;
+  _addToSession(pShared->pSession, pPayload->group, pPayload->point,
+    pPayload->flags, &value, &pPayload->timeStamp);
+  pShared->pPending = TMWDEFS_NULL;
+  pShared->pPendingTime = TMWDEFS_NULL;
+}
+
+/* function: _readLog
+ *  Add the events added to the store since the session last read the
+ *  log. Called with the channel lock held.
+ */
+static void TMWDEFS_LOCAL _readLog(
+  SDNPSEVT_SESSION *pShared)
+{
+  SDNPSEVT_STORE *pStore = pShared->pStore;
+  SDNPSEVT_PAYLOAD *pPayloads[SDNPSEVT_READ_BATCH];
+  TMWTYPES_USHORT count;
+  TMWTYPES_USHORT i;
+
+  do
+  {
+    /* Take references to a batch of events under the store lock, and
+     * add them without it so sdnpsevt_addEvent is never held up by a
+     * session
+     */
+    count = 0;
+    TMWTARG_LOCK_SECTION(&pStore->lock);
+    if((TMWTYPES_ULONG)(pStore->nextSequence - pShared->readSequence) > pStore->maxEvents)
+    {
+      /* The oldest events were overwritten before this session read them */
+      pShared->readSequence = pStore->nextSequence - pStore->maxEvents;
+      ((SDNPSESN *)pShared->pSession)->iin |= DNPDEFS_IIN_BUFFER_OVFL;
+    }
+    while((count < SDNPSEVT_READ_BATCH)
+      && (pShared->readSequence != pStore->nextSequence))
+    {
+      SDNPSEVT_PAYLOAD *pPayload = pStore->pLog[pShared->readSequence % pStore->maxEvents];
+      _addRef(pStore, pPayload);
+      pPayloads[count++] = pPayload;
+      pShared->readSequence++;
+    }
+    TMWTARG_UNLOCK_SECTION(&pStore->lock);
+
+    for(i = 0; i < count; i++)
+    {
+      _addFromLog(pShared, pPayloads[i]);
+      _release(pStore, pPayloads[i]);
+    }
+  } while(count == SDNPSEVT_READ_BATCH);
+}
+
+/* function: _checkTimeout */
+static void TMWDEFS_CALLBACK _checkTimeout(
+  void *pCallbackParam)
+{
+  SDNPSEVT_SESSION *pShared = (SDNPSEVT_SESSION *)pCallbackParam;
+
+  _readLog(pShared);
+  tmwtimer_start(&pShared->checkTimer, pShared->pStore->checkPeriod,
+    pShared->pSession->pChannel, _checkTimeout, pShared);
+}
+
+/* function: sdnpsevt_create */
+SDNPSEVT_STORE * TMWDEFS_GLOBAL sdnpsevt_create(
+  TMWTYPES_USHORT maxEvents,
+  TMWTYPES_MILLISECONDS checkPeriod)
+{
+  SDNPSEVT_STORE *pStore;
+
+  if(maxEvents == 0)
+    return(TMWDEFS_NULL);
+
+  pStore = (SDNPSEVT_STORE *)tmwtarg_alloc(sizeof(SDNPSEVT_STORE)
+    + maxEvents * sizeof(SDNPSEVT_PAYLOAD *));
+  if(pStore == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  pStore->pLog = (SDNPSEVT_PAYLOAD **)(pStore + 1);
+  memset(pStore->pLog, 0, maxEvents * sizeof(SDNPSEVT_PAYLOAD *));
+  pStore->nextSequence = 0;
+  pStore->maxEvents = maxEvents;
+  pStore->checkPeriod = (checkPeriod == 0) ? 1 : checkPeriod;
+  TMWTARG_LOCK_INIT(&pStore->lock);
+  TMWTARG_LOCK_INIT(&pStore->refLock);
+  return(pStore);
+}
+
+/* function: sdnpsevt_destroy */
+void TMWDEFS_GLOBAL sdnpsevt_destroy(
+  SDNPSEVT_STORE *pStore)
+{
+  TMWTYPES_USHORT i;
+
+  if(pStore == TMWDEFS_NULL)
+    return;
+
+  for(i = 0; i < pStore->maxEvents; i++)
+  {
+    if(pStore->pLog[i] != TMWDEFS_NULL)
+      _release(pStore, pStore->pLog[i]);
+  }
+
+  TMWTARG_LOCK_DELETE(&pStore->refLock);
+  TMWTARG_LOCK_DELETE(&pStore->lock);
+  tmwtarg_free(pStore);
+}
+
+/* function: sdnpsevt_attach */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_attach(
+  SDNPSEVT_STORE *pStore,
+  TMWSESN *pSession)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPSIM_DATABASE *pSimDb;
+  SDNPSEVT_SESSION *pShared;
+  SDNPSEVT_REF *pRefs;
+  int i;
+
+  if((pStore == TMWDEFS_NULL)
+    || (pSDNPSession == TMWDEFS_NULL)
+    || !pSDNPSession->userManagedEvents)
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  pSimDb = (SDNPSIM_DATABASE *)pSDNPSession->pDbHandle;
+  if((pSimDb == TMWDEFS_NULL) || (pSimDb->pSharedEvents != TMWDEFS_NULL))
+    return(TMWDEFS_FALSE);
+
+  pShared = (SDNPSEVT_SESSION *)tmwtarg_alloc(sizeof(SDNPSEVT_SESSION)
+    + SDNPSEVT_NUM_GROUPS * pStore->maxEvents * sizeof(SDNPSEVT_REF));
+  if(pShared == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  memset(pShared, 0, sizeof(SDNPSEVT_SESSION));
+  pShared->pSession = pSession;
+  pShared->pStore = pStore;
+  tmwtimer_init(&pShared->checkTimer);
+
+  pRefs = (SDNPSEVT_REF *)(pShared + 1);
+  for(i = 0; i < SDNPSEVT_NUM_GROUPS; i++)
+  {
+    pShared->queues[i].pRefs = pRefs;
+    pRefs += pStore->maxEvents;
+  }
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  TMWTARG_LOCK_SECTION(&pStore->lock);
+  pShared->readSequence = pStore->nextSequence;
+  TMWTARG_UNLOCK_SECTION(&pStore->lock);
+
+  pSimDb->pSharedEvents = pShared;
+  tmwtimer_start(&pShared->checkTimer, pStore->checkPeriod,
+    pSession->pChannel, _checkTimeout, pShared);
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _freeSession
+ *  Release the events of a session and stop reading the store log.
+ *  Called with the channel lock held.
+ */
+static void TMWDEFS_LOCAL _freeSession(
+  SDNPSIM_DATABASE *pSimDb,
+  SDNPSEVT_SESSION *pShared)
+{
+  int i;
+
+  tmwtimer_cancel(&pShared->checkTimer);
+  pSimDb->pSharedEvents = TMWDEFS_NULL;
+  for(i = 0; i < SDNPSEVT_NUM_GROUPS; i++)
+  {
+    SDNPSEVT_QUEUE *pQueue = &pShared->queues[i];
+    TMWTYPES_USHORT j;
+    for(j = 0; j < pQueue->count; j++)
+      _release(pShared->pStore, pQueue->pRefs[j].pPayload);
+  }
+  tmwtarg_free(pShared);
+}
+
+/* function: sdnpsevt_detach */
+void TMWDEFS_GLOBAL sdnpsevt_detach(
+  TMWSESN *pSession)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPSIM_DATABASE *pSimDb;
+
+  if(pSDNPSession == TMWDEFS_NULL)
+    return;
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  pSimDb = (SDNPSIM_DATABASE *)pSDNPSession->pDbHandle;
+  if((pSimDb != TMWDEFS_NULL) && (pSimDb->pSharedEvents != TMWDEFS_NULL))
+    _freeSession(pSimDb, (SDNPSEVT_SESSION *)pSimDb->pSharedEvents);
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+}
+
+/* function: sdnpsevt_close */
+void TMWDEFS_GLOBAL sdnpsevt_close(
+  void *pDbHandle)
+{
+  SDNPSIM_DATABASE *pSimDb = (SDNPSIM_DATABASE *)pDbHandle;
+
+  if((pSimDb == TMWDEFS_NULL) || (pSimDb->pSharedEvents == TMWDEFS_NULL))
+    return;
+
+  _freeSession(pSimDb, (SDNPSEVT_SESSION *)pSimDb->pSharedEvents);
+}
+
+/* function: sdnpsevt_addEvent */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_addEvent(
+  SDNPSEVT_STORE *pStore,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWTYPES_UCHAR flags,
+  SDNPDATA_ADD_EVENT_VALUE *pValue,
+  TMWDTIME *pTimeStamp)
+{
+  SDNPSEVT_PAYLOAD *pPayload;
+  SDNPSEVT_PAYLOAD *pOldPayload;
+  SDNPSEVT_PAYLOAD **pEntry;
+  SDNPDATA_ADD_EVENT_VALUE noValue;
+
+  if((pStore == TMWDEFS_NULL) || (_getSharedGroup(group) < 0))
+    return(TMWDEFS_FALSE);
+
+  if(pValue == TMWDEFS_NULL)
+  {
+    noValue.ulValue = 0;
+    pValue = &noValue;
+  }
+
+  /* The log holds this reference until the entry is overwritten */
+  pPayload = _allocPayload(group, point, flags, pValue, pTimeStamp);
+  if(pPayload == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  TMWTARG_LOCK_SECTION(&pStore->lock);
+  pEntry = &pStore->pLog[pStore->nextSequence % pStore->maxEvents];
+  pOldPayload = *pEntry;
+  *pEntry = pPayload;
+  pStore->nextSequence++;
+  TMWTARG_UNLOCK_SECTION(&pStore->lock);
+
+  /* Sessions still reading the old event hold their own references */
+  if(pOldPayload != TMWDEFS_NULL)
+    _release(pStore, pOldPayload);
+
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpsevt_update */
+void TMWDEFS_GLOBAL sdnpsevt_update(
+  TMWSESN *pSession)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPSIM_DATABASE *pSimDb;
+
+  if(pSDNPSession == TMWDEFS_NULL)
+    return;
+
+  TMWTARG_LOCK_SECTION(&pSession->pChannel->lock);
+  pSimDb = (SDNPSIM_DATABASE *)pSDNPSession->pDbHandle;
+  if((pSimDb != TMWDEFS_NULL) && (pSimDb->pSharedEvents != TMWDEFS_NULL))
+    _readLog((SDNPSEVT_SESSION *)pSimDb->pSharedEvents);
+  TMWTARG_UNLOCK_SECTION(&pSession->pChannel->lock);
+}
+
+/* function: sdnpsevt_getSession */
+SDNPSEVT_SESSION * TMWDEFS_GLOBAL sdnpsevt_getSession(
+  void *pDbHandle,
+  TMWTYPES_UCHAR group)
+{
+  SDNPSEVT_SESSION *pShared = (SDNPSEVT_SESSION *)((SDNPSIM_DATABASE *)pDbHandle)->pSharedEvents;
+
+  if((pShared == TMWDEFS_NULL) || (_getQueue(pShared, group) == TMWDEFS_NULL))
+    return(TMWDEFS_NULL);
+
+  return(pShared);
+}
+
+/* function: sdnpsevt_eventAdd */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventAdd(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point,
+  TMWDEFS_CLASS_MASK classMask,
+  TMWTYPES_UCHAR defaultVariation,
+  TMWTYPES_UCHAR flags,
+  SDNPDATA_ADD_EVENT_VALUE *pValue,
+  TMWDTIME *pTimeStamp)
+{
+  SDNPSEVT_QUEUE *pQueue = _getQueue(pShared, group);
+  SDNPSEVT_PAYLOAD *pPayload = pShared->pPending;
+  SDNPSEVT_REF *pRef;
+
+  if((pQueue == TMWDEFS_NULL)
+    || (pQueue->count >= pShared->pStore->maxEvents))
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  /* The SCL passes the event read from the store log straight through,
+   * so share it. Events added to this session alone get their own copy.
+   */
+  if((pPayload != TMWDEFS_NULL)
+    && (pPayload->group == group)
+    && (pPayload->point == point)
+    && (pShared->pPendingTime == pTimeStamp))
+  {
+    _addRef(pShared->pStore, pPayload);
+    pShared->pPending = TMWDEFS_NULL;
+  }
+  else
+  {
+    pPayload = _allocPayload(group, point, flags, pValue, pTimeStamp);
+    if(pPayload == TMWDEFS_NULL)
+      return(TMWDEFS_FALSE);
+  }
+
+  pRef = &pQueue->pRefs[pQueue->count++];
+  pRef->pPayload = pPayload;
+  pRef->classMask = classMask;
+  pRef->defaultVariation = defaultVariation;
+  pRef->eventSent = TMWDEFS_FALSE;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpsevt_eventNotSentCount */
+TMWTYPES_USHORT TMWDEFS_GLOBAL sdnpsevt_eventNotSentCount(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group,
+  TMWDEFS_CLASS_MASK classMask)
+{
+  SDNPSEVT_QUEUE *pQueue = _getQueue(pShared, group);
+  TMWTYPES_USHORT count = 0;
+  TMWTYPES_USHORT i;
+
+  if(pQueue == TMWDEFS_NULL)
+    return(0);
+
+  for(i = 0; i < pQueue->count; i++)
+  {
+    if((pQueue->pRefs[i].classMask & classMask)
+      && !pQueue->pRefs[i].eventSent)
+    {
+      count++;
+    }
+  }
+  return(count);
+}
+
+/* function: sdnpsevt_eventGet */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventGet(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group,
+  TMWDEFS_CLASS_MASK classMask,
+  TMWTYPES_BOOL firstEvent,
+  SDNPDATA_GET_EVENT *pEvent)
+{
+  SDNPSEVT_QUEUE *pQueue = _getQueue(pShared, group);
+
+  if(firstEvent)
+    pShared->getIndex = 0;
+
+  if(pQueue == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  while(pShared->getIndex < pQueue->count)
+  {
+    SDNPSEVT_REF *pRef = &pQueue->pRefs[pShared->getIndex++];
+    if(pRef->classMask & classMask)
+    {
+      SDNPSEVT_PAYLOAD *pPayload = pRef->pPayload;
+
+      pShared->pLastRef = pRef;
+      pEvent->classMask        = pRef->classMask;
+      pEvent->defaultVariation = pRef->defaultVariation;
+      pEvent->flags            = pPayload->flags;
+      pEvent->point            = pPayload->point;
+      pEvent->timeStamp        = pPayload->timeStamp;
+      switch(group)
+      {
+      case DNPDEFS_OBJ_22_CNTR_EVENTS:
+      case DNPDEFS_OBJ_23_FCTR_EVENTS:
+        pEvent->value.ulValue = pPayload->value.ulValue;
+        break;
+
+      case DNPDEFS_OBJ_32_ANA_CHNG_EVENTS:
+      case DNPDEFS_OBJ_33_FRZN_ANA_EVENTS:
+      case DNPDEFS_OBJ_42_ANA_OUT_EVENTS:
+      case DNPDEFS_OBJ_43_ANA_CMD_EVENTS:
+        pEvent->value.analogValue = pPayload->value.analogValue;
+        break;
+      }
+      return(TMWDEFS_TRUE);
+    }
+  }
+  return(TMWDEFS_FALSE);
+}
+
+/* function: sdnpsevt_eventSent */
+void TMWDEFS_GLOBAL sdnpsevt_eventSent(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group,
+  TMWTYPES_USHORT point)
+{
+  TMWTARG_UNUSED_PARAM(group);
+  TMWTARG_UNUSED_PARAM(point);
+  if(pShared->pLastRef != TMWDEFS_NULL)
+    pShared->pLastRef->eventSent = TMWDEFS_TRUE;
+}
+
+/* function: sdnpsevt_eventNotSent */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventNotSent(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group)
+{
+  SDNPSEVT_QUEUE *pQueue = _getQueue(pShared, group);
+  TMWTYPES_USHORT i;
+
+  if(pQueue == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  for(i = 0; i < pQueue->count; i++)
+    pQueue->pRefs[i].eventSent = TMWDEFS_FALSE;
+
+  return((TMWTYPES_BOOL)(pQueue->count >= pShared->pStore->maxEvents));
+}
+
+/* function: sdnpsevt_eventRemove */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventRemove(
+  SDNPSEVT_SESSION *pShared,
+  TMWTYPES_UCHAR group)
+{
+  SDNPSEVT_QUEUE *pQueue = _getQueue(pShared, group);
+  TMWTYPES_USHORT count = 0;
+  TMWTYPES_USHORT i;
+
+  if(pQueue == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  /* Keep the events not yet confirmed in order */
+  for(i = 0; i < pQueue->count; i++)
+  {
+    if(pQueue->pRefs[i].eventSent)
+      _release(pShared->pStore, pQueue->pRefs[i].pPayload);
+    else
+      pQueue->pRefs[count++] = pQueue->pRefs[i];
+  }
+  pQueue->count = count;
+  pShared->pLastRef = TMWDEFS_NULL;
+
+  return((TMWTYPES_BOOL)(pQueue->count >= pShared->pStore->maxEvents));
+}
+
+#endif /* SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB */
@@ -0,0 +1,337 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: sdnpsevt.h
+ * description: Event storage shared by several DNP slave sessions.
+ *  When several masters poll the same outstation, for example a SCADA
+ *  master, a historian and a backup master, each session needs its own
+ *  event queue since each master reads and confirms events on its own.
+ *  Normally every event is copied into the queue of every session. A
+ *  shared event store instead keeps each event once with a reference
+ *  count, and gives each session a queue of small references that hold
+ *  the session's class, default variation and sent state for the event.
+ *  The event is freed when every session has removed it.
+ *
+ *  Adding an event only appends it to a log kept by the store, so memory
+ *  and the cost of adding an event no longer grow with the number of
+ *  masters. Each session reads the new events from the log on its own
+ *  channel, from a timer started by sdnpsevt_attach or when the
+ *  application calls sdnpsevt_update, and queues them through the
+ *  normal sdnpoXXX_addEvent path with its own class assignment and
+ *  unsolicited responses.
+ *
+ *  The store is used through the user managed event interface of the
+ *  simulated database, so SDNPCNFG_USER_MANAGED_EVENTS must be
+ *  TMWDEFS_TRUE and the sessions must be opened with userManagedEvents
+ *  set to TMWDEFS_TRUE. Binary
+ *  input, double bit input, binary output, counter, frozen counter,
+ *  analog input, frozen analog input and analog output events, and the
+ *  binary and analog output command events, are kept in the store.
+ *  Other user managed events are still passed to the database.
+ *
+ *  Used together with sdnpshm for point values, one database can serve
+ *  any number of sessions.
+ */
+#ifndef SDNPSEVT_DEFINED
+#define SDNPSEVT_DEFINED
+
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwsesn.h"
+#include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/dnp/sdnpcnfg.h"
+#include "tmwscl/dnp/sdnpdata.h"
+
+#if SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB
+
+/* Number of event object groups kept in the store */
+#define SDNPSEVT_NUM_GROUPS 10
+
+/* An event, shared by the queues of every session it was added to */
+typedef struct SDNPSEvtPayloadStruct {
+  /* Number of session queues, and the store log, holding this event */
+  TMWTYPES_ULONG  refCount;
+  TMWTYPES_USHORT point;
+  TMWTYPES_UCHAR  group;
+  TMWTYPES_UCHAR  flags;
+  TMWDTIME        timeStamp;
+  union {
+    TMWTYPES_ULONG        ulValue;
+    TMWTYPES_ANALOG_VALUE analogValue;
+  } value;
+} SDNPSEVT_PAYLOAD;
+
+/* A session's reference to an event */
+typedef struct SDNPSEvtRefStruct {
+  SDNPSEVT_PAYLOAD  *pPayload;
+  TMWDEFS_CLASS_MASK classMask;
+  TMWTYPES_UCHAR     defaultVariation;
+  TMWTYPES_BOOL      eventSent;
+} SDNPSEVT_REF;
+
+/* A session's event queue for one object group, oldest event first */
+typedef struct SDNPSEvtQueueStruct {
+  SDNPSEVT_REF   *pRefs;
+  TMWTYPES_USHORT count;
+} SDNPSEVT_QUEUE;
+
+struct SDNPSEvtStoreStruct;
+
+/* The events of one session attached to a store. Protected by the
+ * session's channel lock.
+ */
+typedef struct SDNPSEvtSessionStruct {
+  TMWSESN *pSession;
+  struct SDNPSEvtStoreStruct *pStore;
+
+  /* Sequence number of the next event to read from the store log */
+  TMWTYPES_ULONG readSequence;
+
+  /* Reads new events from the store log */
+  TMWTIMER checkTimer;
+
+  SDNPSEVT_QUEUE queues[SDNPSEVT_NUM_GROUPS];
+
+  /* Position of sdnpsevt_eventGet in the queue it last read */
+  TMWTYPES_USHORT getIndex;
+  SDNPSEVT_REF   *pLastRef;
+
+  /* Event being read from the store log, and the time stamp it was
+   * passed to the SCL with
+   */
+  SDNPSEVT_PAYLOAD *pPending;
+  TMWDTIME         *pPendingTime;
+} SDNPSEVT_SESSION;
+
+/* Shared event store */
+typedef struct SDNPSEvtStoreStruct {
+  /* The last maxEvents events added, in a circular buffer indexed by
+   * sequence number
+   */
+  SDNPSEVT_PAYLOAD **pLog;
+
+  /* Sequence number the next event added will get */
+  TMWTYPES_ULONG nextSequence;
+
+  /* Maximum number of events of each group queued for a session, and
+   * the number of events kept in the log
+   */
+  TMWTYPES_USHORT maxEvents;
+
+  /* How often each session reads new events from the log */
+  TMWTYPES_MILLISECONDS checkPeriod;
+
+#if TMWCNFG_SUPPORT_THREADS
+  /* Protects the log. A session's channel lock may be held when this
+   * is taken, but never the other way round.
+   */
+  TMWDEFS_RESOURCE_LOCK lock;
+  /* Protects the event reference counts. No other lock is taken
+   * while this is held.
+   */
+  TMWDEFS_RESOURCE_LOCK refLock;
+#endif
+} SDNPSEVT_STORE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnpsevt_create
+   * purpose: Create a shared event store.
+   * arguments:
+   *  maxEvents - maximum number of events of each object group queued
+   *   for each session. If a session's queue is full new events for it
+   *   are discarded and the session sets IIN2.3 (event buffer overflow).
+   *   This is also the number of events the store keeps for sessions
+   *   that have not read them yet. A session that falls further behind
+   *   loses the oldest of them and sets IIN2.3.
+   *  checkPeriod - how often, in milliseconds, each session reads new
+   *   events from the store
+   * returns:
+   *  pointer to the store or TMWDEFS_NULL on failure
+   */
+  TMWDEFS_SCL_API SDNPSEVT_STORE * TMWDEFS_GLOBAL sdnpsevt_create(
+    TMWTYPES_USHORT maxEvents,
+    TMWTYPES_MILLISECONDS checkPeriod);
+
+  /* function: sdnpsevt_destroy
+   * purpose: Free a shared event store. All sessions must have been
+   *  detached.
+   * arguments:
+   *  pStore - store returned by sdnpsevt_create
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpsevt_destroy(
+    SDNPSEVT_STORE *pStore);
+
+  /* function: sdnpsevt_attach
+   * purpose: Keep the events of a session in a shared event store.
+   *  Call this after opening the session and before any events are
+   *  added to it. The session gets the events added to the store from
+   *  now on. Sessions may be attached and detached while other threads
+   *  are adding events to the store.
+   * arguments:
+   *  pStore - store returned by sdnpsevt_create
+   *  pSession - session opened with userManagedEvents TMWDEFS_TRUE
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_attach(
+    SDNPSEVT_STORE *pStore,
+    TMWSESN *pSession);
+
+  /* function: sdnpsevt_detach
+   * purpose: Stop using a shared event store for a session, discarding
+   *  any events still queued for it. Closing the session also does
+   *  this.
+   * arguments:
+   *  pSession - session attached with sdnpsevt_attach
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpsevt_detach(
+    TMWSESN *pSession);
+
+  /* function: sdnpsevt_close
+   * purpose: Detach the session using a database from its shared event
+   *  store, if it is still attached. Called by sdnpdata_close with the
+   *  channel lock held.
+   * arguments:
+   *  pDbHandle - database handle of the session
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpsevt_close(
+    void *pDbHandle);
+
+  /* function: sdnpsevt_addEvent
+   * purpose: Add an event to every session attached to a store. The
+   *  event is stored once and appended to the store log. Each session
+   *  then adds it through its normal sdnpoXXX_addEvent function, so
+   *  each session applies its own point class, default variation and
+   *  triggers its own unsolicited responses.
+   *  This takes no channel lock, so it may be called from any thread
+   *  and does not wait for the sessions.
+   * arguments:
+   *  pStore - store returned by sdnpsevt_create
+   *  group - object group of the event
+   *   DNPDEFS_OBJ_2_BIN_CHNG_EVENTS  or
+   *   DNPDEFS_OBJ_4_DBL_CHNG_EVENTS  or
+   *   DNPDEFS_OBJ_11_BIN_OUT_EVENTS  or
+   *   DNPDEFS_OBJ_13_BIN_CMD_EVENTS  or
+   *   DNPDEFS_OBJ_22_CNTR_EVENTS     or
+   *   DNPDEFS_OBJ_23_FCTR_EVENTS     or
+   *   DNPDEFS_OBJ_32_ANA_CHNG_EVENTS or
+   *   DNPDEFS_OBJ_33_FRZN_ANA_EVENTS or
+   *   DNPDEFS_OBJ_42_ANA_OUT_EVENTS  or
+   *   DNPDEFS_OBJ_43_ANA_CMD_EVENTS
+   *  point - point number
+   *  flags - flags, or the status for command events
+   *  pValue - value for counter events in ulValue, or analog events in
+   *   analogPtr, TMWDEFS_NULL for the other groups
+   *  pTimeStamp - time of the event
+   * returns:
+   *  TMWDEFS_TRUE if the event was added to the store
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_addEvent(
+    SDNPSEVT_STORE *pStore,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point,
+    TMWTYPES_UCHAR flags,
+    SDNPDATA_ADD_EVENT_VALUE *pValue,
+    TMWDTIME *pTimeStamp);
+
+  /* function: sdnpsevt_update
+   * purpose: Queue the events added to the store since the session last
+   *  read them, without waiting for its check timer. Takes the channel
+   *  lock of the session.
+   * arguments:
+   *  pSession - session attached with sdnpsevt_attach
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpsevt_update(
+    TMWSESN *pSession);
+
+  /* function: sdnpsevt_getSession
+   * purpose: Get the shared events of a session, if the group is kept in
+   *  a shared event store. Used by the sdnpdata_umEventXXX functions to
+   *  decide whether to use the functions below.
+   * arguments:
+   *  pDbHandle - database handle of the session
+   *  group - object group
+   * returns:
+   *  shared events of the session or TMWDEFS_NULL
+   */
+  SDNPSEVT_SESSION * TMWDEFS_GLOBAL sdnpsevt_getSession(
+    void *pDbHandle,
+    TMWTYPES_UCHAR group);
+
+  /* The following functions implement the sdnpdata_umEventXXX functions
+   * of the same name for a session attached to a store. See sdnpdata.h.
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventAdd(
+    SDNPSEVT_SESSION *pShared,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point,
+    TMWDEFS_CLASS_MASK classMask,
+    TMWTYPES_UCHAR defaultVariation,
+    TMWTYPES_UCHAR flags,
+    SDNPDATA_ADD_EVENT_VALUE *pValue,
+    TMWDTIME *pTimeStamp);
+
+  TMWTYPES_USHORT TMWDEFS_GLOBAL sdnpsevt_eventNotSentCount(
+    SDNPSEVT_SESSION *pShared,
+    TMWTYPES_UCHAR group,
+    TMWDEFS_CLASS_MASK classMask);
+
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventGet(
+    SDNPSEVT_SESSION *pShared,
+    TMWTYPES_UCHAR group,
+    TMWDEFS_CLASS_MASK classMask,
+    TMWTYPES_BOOL firstEvent,
+    SDNPDATA_GET_EVENT *pEvent);
+
+  void TMWDEFS_GLOBAL sdnpsevt_eventSent(
+    SDNPSEVT_SESSION *pShared,
+    TMWTYPES_UCHAR group,
+    TMWTYPES_USHORT point);
+
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventNotSent(
+    SDNPSEVT_SESSION *pShared,
+    TMWTYPES_UCHAR group);
+
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsevt_eventRemove(
+    SDNPSEVT_SESSION *pShared,
+    TMWTYPES_UCHAR group);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDNPCNFG_USER_MANAGED_EVENTS && TMWCNFG_USE_SIMULATED_DB */
+#endif /* SDNPSEVT_DEFINED */
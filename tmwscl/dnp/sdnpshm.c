@@ -0,0 +1,557 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: sdnpshm.c
+ * description: Shared memory point values for the DNP slave database.
+ *  See sdnpshm.h for the region layout.
+ */
+#include "tmwscl/dnp/sdnpshm.h"
+
+#if TMWTARG_SUPPORT_SHM_DB
+#include "tmwscl/dnp/dnpdefs.h"
+#include "tmwscl/dnp/dnpdtime.h"
+#if TMWCNFG_USE_SIMULATED_DB
+#include "tmwscl/utils/tmwsim.h"
+#include "tmwscl/dnp/sdnpsim.h"
+#endif
+
+/* Per database state for an attached region */
+typedef struct SDNPShmContextStruct {
+  SDNPSHM_HEADER *pHeader;
+  SDNPSHM_POINT  *pTable[SDNPSHM_NUM_TYPES];
+  TMWTYPES_ULONG  quantity[SDNPSHM_NUM_TYPES];
+
+  /* Sequence of each point when it was last reported as changed */
+  TMWTYPES_ULONG *pReported[SDNPSHM_NUM_TYPES];
+} SDNPSHM_CONTEXT;
+
+/* function: _getShmPoint
+ *  Get a point in a region, or TMWDEFS_NULL if it does not exist
+ */
+static SDNPSHM_POINT * TMWDEFS_LOCAL _getShmPoint(
+  const void *pRegion,
+  SDNPSHM_TYPE type,
+  TMWTYPES_USHORT pointNumber)
+{
+  const SDNPSHM_HEADER *pHeader = (const SDNPSHM_HEADER *)pRegion;
+
+  if((type >= SDNPSHM_NUM_TYPES)
+    || (pointNumber >= pHeader->table[type].quantity))
+  {
+    return(TMWDEFS_NULL);
+  }
+
+  return((SDNPSHM_POINT *)((TMWTYPES_UCHAR *)pRegion + pHeader->table[type].offset) + pointNumber);
+}
+
+/* function: _timeToMs
+ *  Convert a time stamp to the region representation
+ */
+static TMWTYPES_UINT64 TMWDEFS_LOCAL _timeToMs(
+  const TMWDTIME *pTimeStamp)
+{
+  TMWTYPES_MS_SINCE_70 msSince70;
+
+  if((pTimeStamp == TMWDEFS_NULL) || pTimeStamp->invalid)
+    return(0);
+
+  dnpdtime_dateTimeToMSSince70(&msSince70, pTimeStamp);
+  return(((TMWTYPES_UINT64)msSince70.mostSignificant << 16) | msSince70.leastSignificant);
+}
+
+/* function: _readShmPoint
+ *  Copy a point, retrying while the writer is updating it
+ */
+static void TMWDEFS_LOCAL _readShmPoint(
+  const SDNPSHM_POINT *pShmPoint,
+  SDNPSHM_POINT *pCopy)
+{
+  TMWTYPES_ULONG sequence;
+  int retries = 0;
+
+  for(;;)
+  {
+    sequence = pShmPoint->sequence;
+    TMWTARG_MEMORY_BARRIER();
+
+    pCopy->flags = pShmPoint->flags;
+    pCopy->value = pShmPoint->value;
+    pCopy->msSince70 = pShmPoint->msSince70;
+
+    TMWTARG_MEMORY_BARRIER();
+    if(((sequence & 1) == 0) && (sequence == pShmPoint->sequence))
+      break;
+
+    if(++retries >= SDNPSHM_MAX_READ_RETRIES)
+    {
+      /* Writer stopped part way through an update */
+      pCopy->flags = (TMWTYPES_UCHAR)((pCopy->flags & ~DNPDEFS_DBAS_FLAG_ON_LINE) | DNPDEFS_DBAS_FLAG_COMM_LOST);
+      break;
+    }
+
+    if(retries >= SDNPSHM_SPIN_RETRIES)
+      TMWTARG_YIELD();
+  }
+
+  pCopy->sequence = sequence;
+}
+
+/* function: _readChangedShmPoint
+ *  Copy a point if it was updated since lastSequence
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _readChangedShmPoint(
+  const SDNPSHM_POINT *pShmPoint,
+  TMWTYPES_ULONG *pLastSequence,
+  SDNPSHM_POINT *pCopy)
+{
+  /* Unchanged points only cost a read of their sequence */
+  if(pShmPoint->sequence == *pLastSequence)
+    return(TMWDEFS_FALSE);
+
+  _readShmPoint(pShmPoint, pCopy);
+
+  /* A writer that found nothing to change puts the old sequence back */
+  if(pCopy->sequence == *pLastSequence)
+    return(TMWDEFS_FALSE);
+
+  *pLastSequence = pCopy->sequence;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _writeShmPoint
+ *  Update a point if its value or flags changed
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _writeShmPoint(
+  SDNPSHM_POINT *pShmPoint,
+  TMWTYPES_UCHAR flags,
+  TMWTYPES_DOUBLE analog,
+  TMWTYPES_ULONG counter,
+  TMWTYPES_BOOL isAnalog,
+  const TMWDTIME *pTimeStamp)
+{
+  TMWTYPES_UINT64 msSince70 = _timeToMs(pTimeStamp);
+  TMWTYPES_ULONG sequence;
+  TMWTYPES_BOOL changed;
+  int retries = 0;
+
+  /* Take the point by making its sequence odd. Writers only wait for
+   * another writer updating the same point, never for readers.
+   */
+  for(;;)
+  {
+    sequence = pShmPoint->sequence & ~1UL;
+    if(TMWTARG_COMPARE_AND_SWAP(&pShmPoint->sequence, sequence, sequence + 1))
+      break;
+
+    if(++retries >= SDNPSHM_SPIN_RETRIES)
+      TMWTARG_YIELD();
+  }
+
+  changed = (sequence == 0)
+    || (pShmPoint->flags != flags)
+    || (isAnalog ? (pShmPoint->value.analog != analog) : (pShmPoint->value.counter != counter));
+
+  if(changed)
+  {
+    pShmPoint->flags = flags;
+    if(isAnalog)
+      pShmPoint->value.analog = analog;
+    else
+      pShmPoint->value.counter = counter;
+    pShmPoint->msSince70 = msSince70;
+    sequence += 2;
+  }
+
+  TMWTARG_MEMORY_BARRIER();
+  pShmPoint->sequence = sequence;
+  return(changed);
+}
+
+/* function: sdnpshm_regionSize */
+TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpshm_regionSize(
+  const TMWTYPES_ULONG *pQuantities)
+{
+  TMWTYPES_ULONG size = sizeof(SDNPSHM_HEADER);
+  int type;
+
+  for(type = 0; type < SDNPSHM_NUM_TYPES; type++)
+    size += pQuantities[type] * sizeof(SDNPSHM_POINT);
+
+  return(size);
+}
+
+/* function: sdnpshm_format */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_format(
+  void *pRegion,
+  TMWTYPES_ULONG size,
+  const TMWTYPES_ULONG *pQuantities)
+{
+  SDNPSHM_HEADER *pHeader = (SDNPSHM_HEADER *)pRegion;
+  TMWTYPES_ULONG offset;
+  int type;
+
+  if((pRegion == TMWDEFS_NULL)
+    || (size < sdnpshm_regionSize(pQuantities)))
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  memset(pRegion, 0, size);
+
+  pHeader->version = SDNPSHM_VERSION;
+  pHeader->size = size;
+  pHeader->pointSize = sizeof(SDNPSHM_POINT);
+
+  offset = sizeof(SDNPSHM_HEADER);
+  for(type = 0; type < SDNPSHM_NUM_TYPES; type++)
+  {
+    pHeader->table[type].offset = offset;
+    pHeader->table[type].quantity = pQuantities[type];
+    offset += pQuantities[type] * sizeof(SDNPSHM_POINT);
+  }
+
+  /* Readers check the magic number, so set it last */
+  TMWTARG_MEMORY_BARRIER();
+  pHeader->magic = SDNPSHM_MAGIC;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpshm_validate */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_validate(
+  const void *pRegion,
+  TMWTYPES_ULONG size)
+{
+  const SDNPSHM_HEADER *pHeader = (const SDNPSHM_HEADER *)pRegion;
+  int type;
+
+  if((pRegion == TMWDEFS_NULL)
+    || (size < sizeof(SDNPSHM_HEADER))
+    || (pHeader->magic != SDNPSHM_MAGIC)
+    || (pHeader->version != SDNPSHM_VERSION)
+    || (pHeader->pointSize != sizeof(SDNPSHM_POINT))
+    || (pHeader->size > size))
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  for(type = 0; type < SDNPSHM_NUM_TYPES; type++)
+  {
+    const SDNPSHM_TABLE *pTable = &pHeader->table[type];
+    if((pTable->offset < sizeof(SDNPSHM_HEADER))
+      || ((pTable->offset % sizeof(TMWTYPES_UINT64)) != 0)
+      || (pTable->offset > pHeader->size)
+      || (pTable->quantity > (pHeader->size - pTable->offset) / sizeof(SDNPSHM_POINT)))
+    {
+      return(TMWDEFS_FALSE);
+    }
+  }
+
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpshm_alloc */
+void * TMWDEFS_GLOBAL sdnpshm_alloc(
+  const TMWTYPES_ULONG *pQuantities,
+  TMWTYPES_ULONG *pSize)
+{
+  TMWTYPES_ULONG size = sdnpshm_regionSize(pQuantities);
+  void *pRegion = tmwtarg_alloc(size);
+
+  if(pRegion == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  sdnpshm_format(pRegion, size, pQuantities);
+  *pSize = size;
+  return(pRegion);
+}
+
+/* function: sdnpshm_free */
+void TMWDEFS_GLOBAL sdnpshm_free(
+  void *pRegion)
+{
+  tmwtarg_free(pRegion);
+}
+
+/* function: sdnpshm_setBinary */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_setBinary(
+  void *pRegion,
+  SDNPSHM_TYPE type,
+  TMWTYPES_USHORT pointNumber,
+  TMWTYPES_UCHAR flags,
+  const TMWDTIME *pTimeStamp)
+{
+  SDNPSHM_POINT *pShmPoint = _getShmPoint(pRegion, type, pointNumber);
+  if(pShmPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  return(_writeShmPoint(pShmPoint, flags, 0.0, 0, TMWDEFS_FALSE, pTimeStamp));
+}
+
+/* function: sdnpshm_setCounter */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_setCounter(
+  void *pRegion,
+  SDNPSHM_TYPE type,
+  TMWTYPES_USHORT pointNumber,
+  TMWTYPES_ULONG value,
+  TMWTYPES_UCHAR flags,
+  const TMWDTIME *pTimeStamp)
+{
+  SDNPSHM_POINT *pShmPoint = _getShmPoint(pRegion, type, pointNumber);
+  if(pShmPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  return(_writeShmPoint(pShmPoint, flags, 0.0, value, TMWDEFS_FALSE, pTimeStamp));
+}
+
+/* function: sdnpshm_setAnalog */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_setAnalog(
+  void *pRegion,
+  SDNPSHM_TYPE type,
+  TMWTYPES_USHORT pointNumber,
+  TMWTYPES_DOUBLE value,
+  TMWTYPES_UCHAR flags,
+  const TMWDTIME *pTimeStamp)
+{
+  SDNPSHM_POINT *pShmPoint = _getShmPoint(pRegion, type, pointNumber);
+  if(pShmPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  return(_writeShmPoint(pShmPoint, flags, value, 0, TMWDEFS_TRUE, pTimeStamp));
+}
+
+/* function: sdnpshm_read */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_read(
+  const void *pRegion,
+  SDNPSHM_TYPE type,
+  TMWTYPES_USHORT pointNumber,
+  SDNPSHM_POINT *pPoint)
+{
+  SDNPSHM_POINT *pShmPoint = _getShmPoint(pRegion, type, pointNumber);
+  if(pShmPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  _readShmPoint(pShmPoint, pPoint);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpshm_readChanged */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_readChanged(
+  const void *pRegion,
+  SDNPSHM_TYPE type,
+  TMWTYPES_USHORT pointNumber,
+  TMWTYPES_ULONG *pLastSequence,
+  SDNPSHM_POINT *pPoint)
+{
+  SDNPSHM_POINT *pShmPoint = _getShmPoint(pRegion, type, pointNumber);
+  if(pShmPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  return(_readChangedShmPoint(pShmPoint, pLastSequence, pPoint));
+}
+
+#if TMWCNFG_USE_SIMULATED_DB
+/* function: _getContextPoint
+ *  Find the region point for a simulated database point
+ */
+static SDNPSHM_POINT * TMWDEFS_LOCAL _getContextPoint(
+  void *pPoint,
+  SDNPSHM_TYPE type,
+  SDNPSHM_CONTEXT **ppContext)
+{
+  TMWSIM_POINT *pSimPoint = (TMWSIM_POINT *)pPoint;
+  SDNPSIM_DATABASE *pDbHandle = (SDNPSIM_DATABASE *)pSimPoint->pDbHandle;
+  SDNPSHM_CONTEXT *pContext = (SDNPSHM_CONTEXT *)pDbHandle->pShmContext;
+
+  if((pContext == TMWDEFS_NULL)
+    || (pSimPoint->pointNumber >= pContext->quantity[type]))
+  {
+    return(TMWDEFS_NULL);
+  }
+
+  *ppContext = pContext;
+  return(pContext->pTable[type] + pSimPoint->pointNumber);
+}
+
+/* function: sdnpshm_attach */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_attach(
+  void *pDbHandle,
+  void *pRegion,
+  TMWTYPES_ULONG size)
+{
+  SDNPSIM_DATABASE *pSimDb = (SDNPSIM_DATABASE *)pDbHandle;
+  SDNPSHM_HEADER *pHeader = (SDNPSHM_HEADER *)pRegion;
+  SDNPSHM_CONTEXT *pContext;
+  TMWTYPES_ULONG total = 0;
+  TMWTYPES_ULONG *pReported;
+  TMWTYPES_ULONG i;
+  int type;
+
+  if((pSimDb == TMWDEFS_NULL)
+    || !sdnpshm_validate(pRegion, size))
+  {
+    return(TMWDEFS_FALSE);
+  }
+
+  for(type = 0; type < SDNPSHM_NUM_TYPES; type++)
+    total += pHeader->table[type].quantity;
+
+  pContext = (SDNPSHM_CONTEXT *)tmwtarg_alloc(sizeof(SDNPSHM_CONTEXT) + total * sizeof(TMWTYPES_ULONG));
+  if(pContext == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  pContext->pHeader = pHeader;
+  pReported = (TMWTYPES_ULONG *)(pContext + 1);
+  for(type = 0; type < SDNPSHM_NUM_TYPES; type++)
+  {
+    pContext->pTable[type] = (SDNPSHM_POINT *)((TMWTYPES_UCHAR *)pRegion + pHeader->table[type].offset);
+    pContext->quantity[type] = pHeader->table[type].quantity;
+    pContext->pReported[type] = pReported;
+
+    /* Only changes from now on generate events */
+    for(i = 0; i < pContext->quantity[type]; i++)
+      pReported[i] = pContext->pTable[type][i].sequence & ~1UL;
+
+    pReported += pContext->quantity[type];
+  }
+
+  sdnpshm_detach(pDbHandle);
+  pSimDb->pShmContext = pContext;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpshm_detach */
+void TMWDEFS_GLOBAL sdnpshm_detach(
+  void *pDbHandle)
+{
+  SDNPSIM_DATABASE *pSimDb = (SDNPSIM_DATABASE *)pDbHandle;
+
+  if(pSimDb->pShmContext != TMWDEFS_NULL)
+  {
+    tmwtarg_free(pSimDb->pShmContext);
+    pSimDb->pShmContext = TMWDEFS_NULL;
+  }
+}
+
+/* function: sdnpshm_getPoint */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_getPoint(
+  void *pPoint,
+  SDNPSHM_TYPE type,
+  SDNPSHM_POINT *pShmPoint)
+{
+  SDNPSHM_CONTEXT *pContext;
+  SDNPSHM_POINT *pRegionPoint = _getContextPoint(pPoint, type, &pContext);
+
+  if(pRegionPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  _readShmPoint(pRegionPoint, pShmPoint);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpshm_getChangedPoint */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_getChangedPoint(
+  void *pPoint,
+  SDNPSHM_TYPE type,
+  TMWTYPES_BOOL *pChanged,
+  SDNPSHM_POINT *pShmPoint)
+{
+  SDNPSHM_CONTEXT *pContext;
+  SDNPSHM_POINT *pRegionPoint = _getContextPoint(pPoint, type, &pContext);
+  TMWTYPES_ULONG *pReported;
+
+  if(pRegionPoint == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  pReported = &pContext->pReported[type][pRegionPoint - pContext->pTable[type]];
+  *pChanged = _readChangedShmPoint(pRegionPoint, pReported, pShmPoint);
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpshm_getAnalogValue */
+void TMWDEFS_GLOBAL sdnpshm_getAnalogValue(
+  const SDNPSHM_POINT *pShmPoint,
+  TMWTYPES_ANALOG_VALUE *pValue,
+  TMWTYPES_UCHAR *pFlags)
+{
+  TMWTYPES_DOUBLE value = pShmPoint->value.analog;
+
+  *pFlags = pShmPoint->flags;
+
+#if TMWCNFG_SUPPORT_DOUBLE
+  pValue->type = TMWTYPES_ANALOG_TYPE_DOUBLE;
+  pValue->value.dval = value;
+#elif TMWCNFG_SUPPORT_FLOAT
+  pValue->type = TMWTYPES_ANALOG_TYPE_SFLOAT;
+  if(value <= TMWDEFS_SFLOAT_MIN)
+  {
+    pValue->value.fval = TMWDEFS_SFLOAT_MIN;
+    *pFlags |= DNPDEFS_DBAS_FLAG_OVER_RANGE;
+  }
+  else if(value > TMWDEFS_SFLOAT_MAX)
+  {
+    pValue->value.fval = TMWDEFS_SFLOAT_MAX;
+    *pFlags |= DNPDEFS_DBAS_FLAG_OVER_RANGE;
+  }
+  else
+  {
+    pValue->value.fval = (TMWTYPES_SFLOAT)value;
+  }
+#else
+  pValue->type = TMWTYPES_ANALOG_TYPE_LONG;
+  if(value < TMWDEFS_LONG_MIN)
+  {
+    pValue->value.lval = TMWDEFS_LONG_MIN;
+    *pFlags |= DNPDEFS_DBAS_FLAG_OVER_RANGE;
+  }
+  else if(value > TMWDEFS_LONG_MAX)
+  {
+    pValue->value.lval = TMWDEFS_LONG_MAX;
+    *pFlags |= DNPDEFS_DBAS_FLAG_OVER_RANGE;
+  }
+  else
+  {
+    pValue->value.lval = (TMWTYPES_LONG)value;
+  }
+#endif
+}
+
+/* function: sdnpshm_getTime */
+void TMWDEFS_GLOBAL sdnpshm_getTime(
+  const SDNPSHM_POINT *pShmPoint,
+  TMWDTIME *pTimeStamp)
+{
+  TMWTYPES_MS_SINCE_70 msSince70;
+
+  msSince70.mostSignificant = (TMWTYPES_ULONG)(pShmPoint->msSince70 >> 16);
+  msSince70.leastSignificant = (TMWTYPES_USHORT)(pShmPoint->msSince70 & 0xffff);
+  dnpdtime_msSince70ToDateTime(pTimeStamp, &msSince70);
+
+  if(pShmPoint->msSince70 == 0)
+    pTimeStamp->invalid = TMWDEFS_TRUE;
+}
+#endif /* TMWCNFG_USE_SIMULATED_DB */
+
+#endif /* TMWTARG_SUPPORT_SHM_DB */
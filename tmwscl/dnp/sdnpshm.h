@@ -0,0 +1,412 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: sdnpshm.h
+ * description: Shared memory point values for the DNP slave database.
+ *  Point values, flags and timestamps can be kept in a memory region
+ *  shared between processes instead of in the simulated database tables.
+ *  A data acquisition process updates the region directly with the
+ *  sdnpshm_set functions, and each outstation process attaches the region
+ *  to its session databases so the sdnpdata read and changed callbacks for
+ *  these point types return the values from the region. The simulated
+ *  database still holds the point configuration, such as event classes,
+ *  default variations and descriptions, so the points must also exist
+ *  there with the same point numbers.
+ *
+ *  The region layout is fixed so it can be written by code that does not
+ *  use the SCL. All fields are in host byte order.
+ *
+ *   offset 0    SDNPSHM_HEADER (80 bytes)
+ *   table[type].offset  table[type].quantity SDNPSHM_POINT entries
+ *
+ *  Each SDNPSHM_POINT is 24 bytes:
+ *   offset 0    sequence, incremented before and after each update so it
+ *               is odd while the point is being written
+ *   offset 4    DNP3 flags, for binary and double bit inputs and binary
+ *               outputs the state is in the flags (0x80, 0x40)
+ *   offset 8    value, a double for analog types or a 32 bit unsigned
+ *               value in the first 4 bytes for counters
+ *   offset 16   time of the last update, 64 bit milliseconds since 1970
+ *               UTC, or 0 if not known
+ *
+ *  Writers take a point by making its sequence odd with a compare and
+ *  swap, so several acquisition threads may update the same point.
+ *  Readers never take a lock and never block a writer, they retry if the
+ *  sequence was odd or changed while they were reading. This lets the
+ *  outstation build static responses and scan for changes while field
+ *  updates continue.
+ *
+ *  The same layout can also be used within a single process, see
+ *  sdnpshm_alloc.
+ */
+#ifndef SDNPSHM_DEFINED
+#define SDNPSHM_DEFINED
+
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwtypes.h"
+#include "tmwscl/utils/tmwdtime.h"
+#include "tmwscl/utils/tmwtarg.h"
+
+#if TMWTARG_SUPPORT_SHM_DB
+
+#ifndef TMWTARG_MEMORY_BARRIER
+#error TMWTARG_MEMORY_BARRIER must be defined in tmwtargos.h to support TMWTARG_SUPPORT_SHM_DB
+#endif
+#ifndef TMWTARG_COMPARE_AND_SWAP
+#error TMWTARG_COMPARE_AND_SWAP must be defined in tmwtargos.h to support TMWTARG_SUPPORT_SHM_DB
+#endif
+#ifndef TMWTARG_YIELD
+#error TMWTARG_YIELD must be defined in tmwtargos.h to support TMWTARG_SUPPORT_SHM_DB
+#endif
+
+#define SDNPSHM_MAGIC    0x4d485344UL  /* "DSHM" */
+#define SDNPSHM_VERSION  1
+
+/* Number of times a reader or writer retries a point that another thread
+ * is writing before it yields, so a writer that was preempted part way
+ * through an update can finish it.
+ */
+#define SDNPSHM_SPIN_RETRIES 64
+
+/* Number of times a reader retries a point that is being written before
+ * it gives up and reports the point as COMM_LOST, in case the writer died
+ * in the middle of an update.
+ */
+#define SDNPSHM_MAX_READ_RETRIES 10000
+
+/* Point types kept in the region, also the index into the header tables */
+typedef enum SDNPShmTypeEnum {
+  SDNPSHM_TYPE_BIN_IN = 0,
+  SDNPSHM_TYPE_DBL_IN,
+  SDNPSHM_TYPE_BIN_OUT,
+  SDNPSHM_TYPE_BIN_CNTR,
+  SDNPSHM_TYPE_FRZN_CNTR,
+  SDNPSHM_TYPE_ANLG_IN,
+  SDNPSHM_TYPE_FRZN_ANLG_IN,
+  SDNPSHM_TYPE_ANLG_OUT,
+  SDNPSHM_NUM_TYPES
+} SDNPSHM_TYPE;
+
+typedef struct SDNPShmTableStruct {
+  /* Offset of the first point from the start of the region */
+  TMWTYPES_ULONG offset;
+  /* Number of points, point numbers 0 to quantity-1 */
+  TMWTYPES_ULONG quantity;
+} SDNPSHM_TABLE;
+
+typedef struct SDNPShmHeaderStruct {
+  /* SDNPSHM_MAGIC, written last when the region is formatted */
+  TMWTYPES_ULONG magic;
+  TMWTYPES_ULONG version;
+  /* Total size of the region in bytes */
+  TMWTYPES_ULONG size;
+  /* sizeof(SDNPSHM_POINT) */
+  TMWTYPES_ULONG pointSize;
+  SDNPSHM_TABLE  table[SDNPSHM_NUM_TYPES];
+} SDNPSHM_HEADER;
+
+typedef struct SDNPShmPointStruct {
+  volatile TMWTYPES_ULONG sequence;
+  TMWTYPES_UCHAR  flags;
+  TMWTYPES_UCHAR  reserved[3];
+  union {
+    TMWTYPES_DOUBLE analog;
+    TMWTYPES_ULONG  counter;
+  } value;
+  TMWTYPES_UINT64 msSince70;
+} SDNPSHM_POINT;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnpshm_regionSize
+   * purpose: Get the number of bytes needed for a region holding the
+   *  specified number of points of each type.
+   * arguments:
+   *  pQuantities - number of points of each type, indexed by SDNPSHM_TYPE
+   * returns:
+   *  size of the region in bytes
+   */
+  TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpshm_regionSize(
+    const TMWTYPES_ULONG *pQuantities);
+
+  /* function: sdnpshm_format
+   * purpose: Initialize the header and clear all the points of a new
+   *  region. This is normally called by the process that creates the
+   *  region, before any outstation attaches it.
+   * arguments:
+   *  pRegion - start of the region
+   *  size - size of the region, at least sdnpshm_regionSize(pQuantities)
+   *  pQuantities - number of points of each type, indexed by SDNPSHM_TYPE
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_format(
+    void *pRegion,
+    TMWTYPES_ULONG size,
+    const TMWTYPES_ULONG *pQuantities);
+
+  /* function: sdnpshm_validate
+   * purpose: Check that a region has been formatted with a layout this
+   *  code understands and that its tables fit in size bytes.
+   * arguments:
+   *  pRegion - start of the region
+   *  size - size of the region in bytes
+   * returns:
+   *  TMWDEFS_TRUE if the region is valid
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_validate(
+    const void *pRegion,
+    TMWTYPES_ULONG size);
+
+  /* function: sdnpshm_alloc
+   * purpose: Allocate and format a region in process memory, for when
+   *  the acquisition threads and the outstation are in the same process.
+   * arguments:
+   *  pQuantities - number of points of each type, indexed by SDNPSHM_TYPE
+   *  pSize - returns the size of the region in bytes
+   * returns:
+   *  pointer to the start of the region or TMWDEFS_NULL on failure
+   */
+  void * TMWDEFS_GLOBAL sdnpshm_alloc(
+    const TMWTYPES_ULONG *pQuantities,
+    TMWTYPES_ULONG *pSize);
+
+  /* function: sdnpshm_free
+   * purpose: Free a region returned by sdnpshm_alloc. Any databases using
+   *  it must have been detached first.
+   * arguments:
+   *  pRegion - start of the region
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpshm_free(
+    void *pRegion);
+
+  /* function: sdnpshm_setBinary
+   * purpose: Update a binary input, double bit input or binary output
+   *  status point. The state is part of the flags.
+   * arguments:
+   *  pRegion - start of a valid region
+   *  type - SDNPSHM_TYPE_BIN_IN, SDNPSHM_TYPE_DBL_IN or SDNPSHM_TYPE_BIN_OUT
+   *  pointNumber - point to update
+   *  flags - DNP3 flags including the state
+   *  pTimeStamp - time of the change, or TMWDEFS_NULL if not known
+   * returns:
+   *  TMWDEFS_TRUE if the point changed, TMWDEFS_FALSE if it does not exist
+   *  or already had these flags
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_setBinary(
+    void *pRegion,
+    SDNPSHM_TYPE type,
+    TMWTYPES_USHORT pointNumber,
+    TMWTYPES_UCHAR flags,
+    const TMWDTIME *pTimeStamp);
+
+  /* function: sdnpshm_setCounter
+   * purpose: Update a binary counter or frozen counter point. For a frozen
+   *  counter pTimeStamp is the time of freeze.
+   * arguments:
+   *  pRegion - start of a valid region
+   *  type - SDNPSHM_TYPE_BIN_CNTR or SDNPSHM_TYPE_FRZN_CNTR
+   *  pointNumber - point to update
+   *  value - new counter value
+   *  flags - DNP3 flags
+   *  pTimeStamp - time of the change, or TMWDEFS_NULL if not known
+   * returns:
+   *  TMWDEFS_TRUE if the point changed, TMWDEFS_FALSE if it does not exist
+   *  or already had this value and flags
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_setCounter(
+    void *pRegion,
+    SDNPSHM_TYPE type,
+    TMWTYPES_USHORT pointNumber,
+    TMWTYPES_ULONG value,
+    TMWTYPES_UCHAR flags,
+    const TMWDTIME *pTimeStamp);
+
+  /* function: sdnpshm_setAnalog
+   * purpose: Update an analog input, frozen analog input or analog output
+   *  status point. For a frozen analog input pTimeStamp is the time of
+   *  freeze.
+   * arguments:
+   *  pRegion - start of a valid region
+   *  type - SDNPSHM_TYPE_ANLG_IN, SDNPSHM_TYPE_FRZN_ANLG_IN or
+   *   SDNPSHM_TYPE_ANLG_OUT
+   *  pointNumber - point to update
+   *  value - new value
+   *  flags - DNP3 flags
+   *  pTimeStamp - time of the change, or TMWDEFS_NULL if not known
+   * returns:
+   *  TMWDEFS_TRUE if the point changed, TMWDEFS_FALSE if it does not exist
+   *  or already had this value and flags
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_setAnalog(
+    void *pRegion,
+    SDNPSHM_TYPE type,
+    TMWTYPES_USHORT pointNumber,
+    TMWTYPES_DOUBLE value,
+    TMWTYPES_UCHAR flags,
+    const TMWDTIME *pTimeStamp);
+
+  /* function: sdnpshm_read
+   * purpose: Get a consistent copy of a point from a region.
+   * arguments:
+   *  pRegion - start of a valid region
+   *  type - point type
+   *  pointNumber - point to read
+   *  pPoint - returns the point
+   * returns:
+   *  TMWDEFS_TRUE if the point exists
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_read(
+    const void *pRegion,
+    SDNPSHM_TYPE type,
+    TMWTYPES_USHORT pointNumber,
+    SDNPSHM_POINT *pPoint);
+
+  /* function: sdnpshm_readChanged
+   * purpose: Get a consistent copy of a point if it has been updated
+   *  since it was last read with this function. Points that have not
+   *  changed only cost one read of their sequence.
+   * arguments:
+   *  pRegion - start of a valid region
+   *  type - point type
+   *  pointNumber - point to read
+   *  pLastSequence - sequence of the point when it was last returned,
+   *   initialize to 0, updated when the point has changed
+   *  pPoint - returns the point if it changed
+   * returns:
+   *  TMWDEFS_TRUE if the point exists and has changed
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_readChanged(
+    const void *pRegion,
+    SDNPSHM_TYPE type,
+    TMWTYPES_USHORT pointNumber,
+    TMWTYPES_ULONG *pLastSequence,
+    SDNPSHM_POINT *pPoint);
+
+#if TMWCNFG_USE_SIMULATED_DB
+  /* function: sdnpshm_attach
+   * purpose: Have a session's simulated database get the values of its
+   *  binary, double bit, counter, frozen counter, analog, frozen analog
+   *  and output status points from a shared region. Points numbered beyond
+   *  the quantity in the region keep using the simulated database values.
+   *  Points that change after this call are reported as changed by the
+   *  sdnpdata changed callbacks so events are generated for them if the
+   *  session scans for changes.
+   * arguments:
+   *  pDbHandle - database handle, pSDNPSession->pDbHandle
+   *  pRegion - start of a valid region, must stay mapped until detached
+   *  size - size of the region in bytes
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_attach(
+    void *pDbHandle,
+    void *pRegion,
+    TMWTYPES_ULONG size);
+
+  /* function: sdnpshm_detach
+   * purpose: Stop using a shared region for a database's point values.
+   *  This is called when the database is closed.
+   * arguments:
+   *  pDbHandle - database handle
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpshm_detach(
+    void *pDbHandle);
+
+  /* function: sdnpshm_getPoint
+   * purpose: Called by the sdnpdata read callbacks to get the value of a
+   *  simulated database point from the attached region.
+   * arguments:
+   *  pPoint - simulated database point
+   *  type - point type
+   *  pShmPoint - returns the point from the region
+   * returns:
+   *  TMWDEFS_TRUE if the point is in an attached region
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_getPoint(
+    void *pPoint,
+    SDNPSHM_TYPE type,
+    SDNPSHM_POINT *pShmPoint);
+
+  /* function: sdnpshm_getChangedPoint
+   * purpose: Called by the sdnpdata changed callbacks to find out whether
+   *  a point in the attached region has been updated since it was last
+   *  reported as changed.
+   * arguments:
+   *  pPoint - simulated database point
+   *  type - point type
+   *  pChanged - returns TMWDEFS_TRUE if the point changed
+   *  pShmPoint - returns the point from the region if it changed
+   * returns:
+   *  TMWDEFS_TRUE if the point is in an attached region
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpshm_getChangedPoint(
+    void *pPoint,
+    SDNPSHM_TYPE type,
+    TMWTYPES_BOOL *pChanged,
+    SDNPSHM_POINT *pShmPoint);
+
+  /* function: sdnpshm_getAnalogValue
+   * purpose: Convert the value of an analog point from the region to the
+   *  representation the SCL uses, the same way the simulated database does.
+   * arguments:
+   *  pShmPoint - point from the region
+   *  pValue - returns the value
+   *  pFlags - returns the flags, OVER_RANGE is set if the value had to be
+   *   limited
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpshm_getAnalogValue(
+    const SDNPSHM_POINT *pShmPoint,
+    TMWTYPES_ANALOG_VALUE *pValue,
+    TMWTYPES_UCHAR *pFlags);
+
+  /* function: sdnpshm_getTime
+   * purpose: Convert the time of a point from the region.
+   * arguments:
+   *  pShmPoint - point from the region
+   *  pTimeStamp - returns the time
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpshm_getTime(
+    const SDNPSHM_POINT *pShmPoint,
+    TMWDTIME *pTimeStamp);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TMWTARG_SUPPORT_SHM_DB */
+#endif /* SDNPSHM_DEFINED */
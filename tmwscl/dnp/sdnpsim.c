@@ -562,6 +562,8 @@ void * TMWDEFS_GLOBAL sdnpsim_init(
     pDbHandle->pSDNPSession = (SDNPSESN *)pSession;
     pDbHandle->pUpdateCallback = TMWDEFS_NULL;
     pDbHandle->pUpdateCallbackParam = TMWDEFS_NULL;
+    pDbHandle->pShmContext = TMWDEFS_NULL;
+    pDbHandle->pSharedEvents = TMWDEFS_NULL;
     
     /* Start here so in this simulated database we are less likely to 
      * overwrite existing user numbers. This would need to be done better in 
@@ -659,6 +661,212 @@ void TMWDEFS_GLOBAL sdnpsim_addSecStats(
 #endif
 }
 
+/* function: _pointTable
+ * purpose: Get the table of an object group supported by sdnpsim_addPoints
+ */
+static TMWSIM_TABLE_HEAD *_pointTable(
+  SDNPSIM_DATABASE *pDbHandle,
+  TMWTYPES_UCHAR objectGroup)
+{
+  switch(objectGroup)
+  {
+  case DNPDEFS_OBJ_1_BIN_INPUTS:
+    return(&pDbHandle->binaryInputs);
+  case DNPDEFS_OBJ_3_DBL_INPUTS:
+    return(&pDbHandle->doubleInputs);
+  case DNPDEFS_OBJ_10_BIN_OUTS:
+    return(&pDbHandle->binaryOutputs);
+  case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+    return(&pDbHandle->binaryCounters);
+  case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+    return(&pDbHandle->frozenCounters);
+  case DNPDEFS_OBJ_30_ANA_INPUTS:
+    return(&pDbHandle->analogInputs);
+  case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+    return(&pDbHandle->frozenAnalogInputs);
+  case DNPDEFS_OBJ_40_ANA_OUT_STATUSES:
+    return(&pDbHandle->analogOutputs);
+  default:
+    return(TMWDEFS_NULL);
+  }
+}
+
+/* function: _setPointInit
+ * purpose: Apply the settings given to sdnpsim_addPoints to a point
+ */
+static void _setPointInit(
+  TMWSIM_POINT *pPoint,
+  TMWTYPES_UCHAR objectGroup,
+  const SDNPSIM_POINT_INIT *pInit)
+{
+  pPoint->classMask = pInit->classMask;
+  pPoint->flags = pInit->flags;
+
+  switch(objectGroup)
+  {
+  case DNPDEFS_OBJ_1_BIN_INPUTS:
+  case DNPDEFS_OBJ_10_BIN_OUTS:
+    pPoint->data.binary.value = (pInit->value != 0) ? TMWDEFS_TRUE : TMWDEFS_FALSE;
+    break;
+  case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+  case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+    pPoint->data.counter.value = (TMWTYPES_ULONG)pInit->value;
+    break;
+  case DNPDEFS_OBJ_30_ANA_INPUTS:
+  case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+  case DNPDEFS_OBJ_40_ANA_OUT_STATUSES:
+    pPoint->data.analog.value = (TMWSIM_DATA_TYPE)pInit->value;
+    break;
+  default:
+    /* Double bit inputs hold their value in flags */
+    break;
+  }
+}
+
+/* function: sdnpsim_addPoints */
+void * TMWDEFS_GLOBAL sdnpsim_addPoints(
+  void *pHandle,
+  TMWTYPES_UCHAR objectGroup,
+  TMWTYPES_USHORT quantity,
+  const SDNPSIM_POINT_INIT *pDefaults,
+  const SDNPSIM_POINT_OVERRIDE *pOverrides,
+  TMWTYPES_USHORT numOverrides)
+{
+  SDNPSIM_DATABASE *pDbHandle = (SDNPSIM_DATABASE *)pHandle;
+  TMWSIM_TABLE_HEAD *pTable = _pointTable(pDbHandle, objectGroup);
+  TMWSIM_POINT pointTemplate;
+  TMWSIM_POINT *pFirst;
+  TMWSIM_POINT *pPoint;
+  TMWTYPES_ULONG firstPointNum;
+  TMWTYPES_USHORT i;
+
+  if((pTable == TMWDEFS_NULL) || (quantity == 0))
+    return(TMWDEFS_NULL);
+
+  /* Point numbers are 16 bits */
+  firstPointNum = tmwsim_tableSize(pTable);
+  if(firstPointNum + quantity > 0x10000UL)
+    return(TMWDEFS_NULL);
+
+  for(i = 0; i < numOverrides; i++)
+  {
+    if(pOverrides[i].offset >= quantity)
+      return(TMWDEFS_NULL);
+  }
+
+  /* Set up one point the way the sdnpsim_addXxx function of the group
+   * does and copy it into every point of the range
+   */
+  memset(&pointTemplate, 0, sizeof(pointTemplate));
+  switch(objectGroup)
+  {
+  case DNPDEFS_OBJ_1_BIN_INPUTS:
+    tmwsim_initBinary(&pointTemplate, pHandle, firstPointNum);
+    pointTemplate.defaultEventVariation = 3;
+    pointTemplate.defaultStaticVariation = 1;
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_SOE;
+    break;
+  case DNPDEFS_OBJ_3_DBL_INPUTS:
+    tmwsim_initDoubleBinary(&pointTemplate, pHandle, firstPointNum);
+    pointTemplate.defaultEventVariation = 3;
+    pointTemplate.defaultStaticVariation = 1;
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_SOE;
+    break;
+  case DNPDEFS_OBJ_10_BIN_OUTS:
+    tmwsim_initBinary(&pointTemplate, pHandle, firstPointNum);
+    pointTemplate.defaultStaticVariation = 2;
+    pointTemplate.defaultEventVariation = 1;
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_SOE;
+    pointTemplate.data.binary.control = 0xff;
+    break;
+  case DNPDEFS_OBJ_20_RUNNING_CNTRS:
+    tmwsim_initCounter(&pointTemplate, pHandle, firstPointNum);
+    pointTemplate.defaultStaticVariation = 5;  /* 32 bit without flag */
+    pointTemplate.defaultEventVariation = 1;   /* 32 bit with flag */ 
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_MOST_RECENT;
+    break;
+  case DNPDEFS_OBJ_21_FROZEN_CNTRS:
+    tmwsim_initCounter(&pointTemplate, pHandle, firstPointNum);
+    pointTemplate.defaultStaticVariation = 9; /* 32 bit without flag */
+    pointTemplate.defaultEventVariation = 1;  /* 32 bit with flag */
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_SOE;
+    break;
+  case DNPDEFS_OBJ_30_ANA_INPUTS:
+    tmwsim_initAnalog(&pointTemplate, pHandle, firstPointNum, TMWSIM_DATA_MIN, TMWSIM_DATA_MAX, 0, 0);
+    pointTemplate.defaultStaticVariation = 3;
+    pointTemplate.defaultEventVariation = 1;
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_MOST_RECENT;
+    pointTemplate.data.analog.defaultDeadbandVariation = 2;
+    break;
+  case DNPDEFS_OBJ_31_FRZN_ANA_INPUTS:
+    tmwsim_initAnalog(&pointTemplate, pHandle, firstPointNum, TMWSIM_DATA_MIN, TMWSIM_DATA_MAX, 0, 0);
+    pointTemplate.defaultStaticVariation = 5; /* 32 bit without flag */
+    pointTemplate.defaultEventVariation = 1;  /* 32 bit with flag */
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_SOE;
+    break;
+  default: /* DNPDEFS_OBJ_40_ANA_OUT_STATUSES */
+    tmwsim_initAnalog(&pointTemplate, pHandle, firstPointNum, TMWSIM_DATA_MIN, TMWSIM_DATA_MAX, 0, 0);
+    pointTemplate.defaultStaticVariation = 2;
+    pointTemplate.defaultEventVariation = 2;
+    pointTemplate.eventMode = (TMWTYPES_UCHAR)TMWDEFS_EVENT_MODE_SOE;
+    break;
+  }
+
+  pointTemplate.pSCLHandle = (void*)pDbHandle->pSDNPSession;
+  sdnputil_getDateTime((TMWSESN*)pointTemplate.pSCLHandle, &pointTemplate.timeStamp);
+  _setPointInit(&pointTemplate, objectGroup, pDefaults);
+
+  pFirst = tmwsim_tableAddRange(pTable, firstPointNum, quantity, &pointTemplate);
+  if(pFirst == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  for(i = 0; i < numOverrides; i++)
+  {
+    pPoint = tmwsim_tableFindPoint(pTable, firstPointNum + pOverrides[i].offset);
+    if(pPoint != TMWDEFS_NULL)
+      _setPointInit(pPoint, objectGroup, &pOverrides[i].init);
+  }
+
+  pPoint = pFirst;
+  for(i = 0; (i < quantity) && (pPoint != TMWDEFS_NULL); i++)
+  {
+    _callCallback(pPoint, TMWSIM_POINT_ADD, objectGroup, 
+      (TMWTYPES_USHORT)tmwsim_getPointNumber(pPoint));
+    pPoint = tmwsim_tableGetNextPoint(pTable, pPoint);
+  }
+
+  return(pFirst);
+}
+
+#if DNPCNFG_SUPPORT_BINCONFIG
+/* function: sdnpsim_addBinFilePoints */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsim_addBinFilePoints(
+  void *pHandle,
+  const DNPBNCFG_FILEVALUES *pBinFileValues)
+{
+  TMWTYPES_USHORT i;
+
+  for(i = 0; i < pBinFileValues->numPointRanges; i++)
+  {
+    const DNPBNCFG_POINT_RANGE *pRange = &pBinFileValues->pointRanges[i];
+    SDNPSIM_POINT_INIT init;
+
+    if(pRange->quantity == 0)
+      continue;
+
+    init.classMask = pRange->classMask;
+    init.flags = pRange->flags;
+    init.value = 0;
+    if(sdnpsim_addPoints(pHandle, pRange->objectGroup, pRange->quantity,
+      &init, TMWDEFS_NULL, 0) == TMWDEFS_NULL)
+    {
+      return(TMWDEFS_FALSE);
+    }
+  }
+  return(TMWDEFS_TRUE);
+}
+#endif
+
 /* Set update callback and parameter */
 void sdnpsim_setCallback(
   void *pHandle,
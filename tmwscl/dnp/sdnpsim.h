@@ -41,6 +41,7 @@
 #include "tmwscl/dnp/dnpcnfg.h" 
 #include "tmwscl/dnp/sdnpsesn.h" 
 #include "tmwscl/dnp/sdnpfsim.h" 
+#include "tmwscl/dnp/dnpbncfg.h"
 
 #define SDNPSIM_CROB_CTRL SDNPDATA_CROB_CTRL
 
@@ -203,6 +204,24 @@ typedef struct {
   TMWTYPES_USHORT  userPublicKeyLength;
 
 } SDNPSIM_AUTHUSER;
+
+/* Initial settings of points added by sdnpsim_addPoints */
+typedef struct {
+  TMWDEFS_CLASS_MASK classMask;
+  TMWTYPES_UCHAR flags;
+
+  /* Value of the point, nonzero is on for binary inputs and outputs.
+   * Not used for double bit inputs, whose value is held in flags.
+   */
+  TMWTYPES_DOUBLE value;
+} SDNPSIM_POINT_INIT;
+
+/* Settings of one point of a range that differ from the defaults */
+typedef struct {
+  /* Offset of the point from the first point of the range */
+  TMWTYPES_USHORT offset;
+  SDNPSIM_POINT_INIT init;
+} SDNPSIM_POINT_OVERRIDE;
   
 
 /* Define simulated database context */
@@ -266,6 +285,12 @@ typedef struct SDNPSimDatabaseStruct {
   TMWDEFS_CLASS_MASK authClassMask;
   TMWDLIST authUsers;
 
+  /* Shared memory point values, see sdnpshm_attach */
+  void *pShmContext;
+
+  /* Events kept in a shared event store, see sdnpsevt_attach */
+  void *pSharedEvents;
+
   /* Manged SCL database handle*/
   void *managedDBhandle;
   
@@ -276,6 +301,10 @@ typedef struct SDNPSimDatabaseStruct {
   SDNPXML_SAVE_STATE  xmlSaveState;
   TMWTYPES_USHORT     xmlCurSavePointNum;
   TMWTYPES_UCHAR      xmlCurSaveDAVariation; 
+  SDNPXMLW_STREAM     xmlStream;
+
+  /* part of an element that did not fit in the last block */
+  TMWTYPES_CHAR       xmlCarry[SDNPCNFG_XML_SAVE_BUF_SIZE];
 #endif
 
 } SDNPSIM_DATABASE;
@@ -355,6 +384,56 @@ extern "C" {
   TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpsim_addSecStats(
     void *pHandle);
 
+  /* function: sdnpsim_addPoints
+   * purpose: Add a range of points to the end of an object group, all
+   *  with the same settings except for those listed in pOverrides. The
+   *  points are set up as by the sdnpsim_addXxx function of the group,
+   *  but are allocated together with tmwsim_tableAddRange, which is much
+   *  faster than adding tens of thousands of points one at a time.
+   * arguments:
+   *  pHandle - handle to database returned from sdnpsim_init
+   *  objectGroup - DNPDEFS_OBJ_1_BIN_INPUTS, DNPDEFS_OBJ_3_DBL_INPUTS,
+   *   DNPDEFS_OBJ_10_BIN_OUTS, DNPDEFS_OBJ_20_RUNNING_CNTRS,
+   *   DNPDEFS_OBJ_21_FROZEN_CNTRS, DNPDEFS_OBJ_30_ANA_INPUTS,
+   *   DNPDEFS_OBJ_31_FRZN_ANA_INPUTS or DNPDEFS_OBJ_40_ANA_OUT_STATUSES
+   *  quantity - number of points to add
+   *  pDefaults - settings of the points
+   *  pOverrides - settings of individual points, TMWDEFS_NULL if none
+   *  numOverrides - number of entries in pOverrides
+   * returns:
+   *  pointer to the first point added, the others follow it
+   *  TMWDEFS_NULL if the object group is not supported, an override is
+   *   outside the range, the group would exceed 65536 points or the points
+   *   could not be allocated, in which case no points were added
+   */
+  TMWDEFS_SCL_API void * TMWDEFS_GLOBAL sdnpsim_addPoints(
+    void *pHandle,
+    TMWTYPES_UCHAR objectGroup,
+    TMWTYPES_USHORT quantity,
+    const SDNPSIM_POINT_INIT *pDefaults,
+    const SDNPSIM_POINT_OVERRIDE *pOverrides,
+    TMWTYPES_USHORT numOverrides);
+
+#if DNPCNFG_SUPPORT_BINCONFIG
+  /* function: sdnpsim_addBinFilePoints
+   * purpose: Create the points listed in the point list section of a 
+   *  binary configuration file read with dnpbncfg_LoadBinaryConfigFile or
+   *  sdnpsesn_applyBinaryFileValuesEx.
+   *  Each range is added after the points already in its object group,
+   *  call sdnpsim_clear first to replace the default points.
+   * arguments:
+   *  pHandle - handle to database returned from sdnpsim_init
+   *  pBinFileValues - values read from the binary configuration file
+   * returns:
+   *  TMWDEFS_TRUE if all of the points were created, TMWDEFS_FALSE if a
+   *  range has an object group that is not supported or a point could
+   *  not be allocated
+   */
+  TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpsim_addBinFilePoints(
+    void *pHandle,
+    const DNPBNCFG_FILEVALUES *pBinFileValues);
+#endif
+
   /* function: sdnpsim_enablePoint */
   TMWDEFS_SCL_API void TMWDEFS_GLOBAL sdnpsim_enablePoint(
     void *pPoint,
@@ -269,4 +269,134 @@ extern "C" {
 
 #endif /* TMWTARG_SUPPORT_FILEIO */
 
+#if TMWTARG_SUPPORT_SHM_DB
+#include "tmwscl/utils/tmwtarg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnptarg_shmCreate
+   * purpose: Create, or replace, a named shared memory region for
+   *  sdnpshm point values and map it into this process. The region is
+   *  filled with zeros.
+   * arguments:
+   *  pName - name of the region, the same name must be passed to
+   *   sdnptarg_shmOpen by the processes that use it
+   *  size - size of the region in bytes, see sdnpshm_regionSize
+   * returns:
+   *  pointer to the start of the region or TMWDEFS_NULL on failure
+   */
+  void * TMWDEFS_GLOBAL sdnptarg_shmCreate(
+    const TMWTYPES_CHAR *pName,
+    TMWTYPES_ULONG size);
+
+  /* function: sdnptarg_shmOpen
+   * purpose: Map an existing named shared memory region into this process.
+   * arguments:
+   *  pName - name of the region
+   *  pSize - returns the size of the region in bytes
+   * returns:
+   *  pointer to the start of the region or TMWDEFS_NULL on failure
+   */
+  void * TMWDEFS_GLOBAL sdnptarg_shmOpen(
+    const TMWTYPES_CHAR *pName,
+    TMWTYPES_ULONG *pSize);
+
+  /* function: sdnptarg_shmClose
+   * purpose: Unmap a region returned by sdnptarg_shmCreate or
+   *  sdnptarg_shmOpen. The region itself remains until it is removed
+   *  from the system, so field data survives an outstation restart.
+   * arguments:
+   *  pRegion - start of the region
+   *  size - size of the region in bytes
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnptarg_shmClose(
+    void *pRegion,
+    TMWTYPES_ULONG size);
+
+#ifdef __cplusplus
+}
+;
+#endif
+
+#endif /* TMWTARG_SUPPORT_SHM_DB */
+
+#if TMWTARG_SUPPORT_JOURNAL
+#include "tmwscl/utils/tmwtarg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnptarg_journalRead
+   * purpose: Read the whole of a journal file written by sdnpjrnl.
+   * arguments:
+   *  pName - name of the journal file
+   *  pLength - returns the length of the file in bytes
+   * returns:
+   *  pointer to the contents, allocated with tmwtarg_alloc, which the
+   *  caller frees with tmwtarg_free, or TMWDEFS_NULL if the file does not
+   *  exist or could not be read
+   */
+  TMWTYPES_UCHAR * TMWDEFS_GLOBAL sdnptarg_journalRead(
+    const TMWTYPES_CHAR *pName,
+    TMWTYPES_ULONG *pLength);
+
+  /* function: sdnptarg_journalReplace
+   * purpose: Replace the contents of a journal file with a checkpoint and
+   *  open it so records can be appended to it. If the process or the
+   *  system stops at any point the file must hold either its old contents
+   *  or the whole checkpoint, so the checkpoint should be written to a
+   *  temporary file, flushed to the disk and renamed over pName.
+   * arguments:
+   *  pName - name of the journal file
+   *  pData - checkpoint
+   *  length - length of the checkpoint in bytes
+   * returns:
+   *  handle to pass to sdnptarg_journalAppend, or TMWDEFS_NULL on failure
+   */
+  void * TMWDEFS_GLOBAL sdnptarg_journalReplace(
+    const TMWTYPES_CHAR *pName,
+    const TMWTYPES_UCHAR *pData,
+    TMWTYPES_ULONG length);
+
+  /* function: sdnptarg_journalAppend
+   * purpose: Append a record to a journal file. The record should be
+   *  written with a single write so that, if the process is killed, the
+   *  operating system holds either all of it or none of it.
+   * arguments:
+   *  pHandle - handle returned by sdnptarg_journalReplace
+   *  pData - record
+   *  length - length of the record in bytes
+   *  sync - TMWDEFS_TRUE if the record must also reach the disk before
+   *   this returns, so it survives a power failure
+   * returns:
+   *  TMWDEFS_TRUE if successful
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnptarg_journalAppend(
+    void *pHandle,
+    const TMWTYPES_UCHAR *pData,
+    TMWTYPES_ULONG length,
+    TMWTYPES_BOOL sync);
+
+  /* function: sdnptarg_journalClose
+   * purpose: Close a journal file opened by sdnptarg_journalReplace
+   * arguments:
+   *  pHandle - handle returned by sdnptarg_journalReplace
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnptarg_journalClose(
+    void *pHandle);
+
+#ifdef __cplusplus
+}
+;
+#endif
+
+#endif /* TMWTARG_SUPPORT_JOURNAL */
+
 #endif /* SDNPTARG_DEFINED */
@@ -58,6 +58,7 @@
 #include "tmwscl/dnp/sdnpsesn.h"
 #include "tmwscl/dnp/sdnpunsl.h"
 #include "tmwscl/dnp/sdnpdata.h"
+#include "tmwscl/dnp/sdnpjrnl.h"
 #if DNPCNFG_SUPPORT_AUTHENTICATION
 #include "tmwscl/dnp/sdnpauth.h"
 #endif
@@ -171,6 +172,9 @@ static void TMWDEFS_LOCAL _initializeResponse(
   /* Increment sequence number */
   pSDNPSession->unsolSequenceNumber =
     sdnputil_nextSequenceNumber(pSDNPSession->unsolSequenceNumber);
+#if TMWTARG_SUPPORT_JOURNAL
+  sdnpjrnl_sequenceChanged((TMWSESN *)pSDNPSession);
+#endif
 
   DNPDIAG_BUILD_MESSAGE(pResponse->pChannel, (TMWSESN*)pSDNPSession, pResponse->pMsgDescription); 
   
@@ -1228,6 +1228,11 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL sdnputil_parseApplHeader(
   pSDNPSession->notDuplicateEligible = TMWDEFS_FALSE;
 #endif
 
+  /* The request is copied, not referenced in place. It is compared with
+   * the next request to find duplicates, and it may be processed after
+   * the receive buffer has been reused, when the channel is busy or a
+   * response takes more than one fragment.
+   */
   dnputil_parseApplHeader(pRxFragment, &pSDNPSession->lastRcvdRequest, TMWDEFS_TRUE);
  
   return(TMWDEFS_TRUE);
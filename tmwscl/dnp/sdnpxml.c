@@ -35,211 +35,175 @@
 #include "tmwscl/dnp/sdnputil.h"
 #include "tmwscl/dnp/sdnpcnfg.h"
 #include "tmwscl/dnp/sdnpdiag.h"
+#include "tmwscl/dnp/sdnpxmlw.h"
 
 #if TMWCNFG_USE_SIMULATED_DB
 #include "tmwscl/dnp/sdnpsim.h"
 
 #if SDNPDATA_SUPPORT_XML
 
-/* function: _appendStringLen */
-static TMWTYPES_CHAR * TMWDEFS_GLOBAL _appendStringLen(
-  TMWTYPES_CHAR  *pStr1, 
-  TMWTYPES_CHAR  *pStr2,
-  TMWTYPES_ULONG *curLen,
-  TMWTYPES_BOOL   bGetLen)
+/* function: _appendString */
+static void TMWDEFS_LOCAL _appendString(
+  SDNPXMLW_STREAM *pStream,
+  TMWTYPES_CHAR   *pStr)
 {
-  TMWTYPES_CHAR *result;
-  TMWTYPES_ULONG length;
-
-  if (bGetLen == TMWDEFS_FALSE)
-  {
-    result = strcat(pStr1, pStr2);
-    return result;
-  }
-  else
-  {
-    length = (TMWTYPES_ULONG)strlen(pStr2) + *curLen;
-    *curLen = length;
-  }
-  return TMWDEFS_NULL;
+  sdnpxmlw_write(pStream, pStr, (TMWTYPES_ULONG)strlen(pStr));
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildHeader(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildHeader(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "<?xml version=\"1.0\"?>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "<tmw:dnpdata\n", curLen, bGetLen);
-  result = _appendStringLen(result, " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n", curLen, bGetLen);
-  result = _appendStringLen(result, " xmlns:tmw=\"http://www.TriangleMicroWorks.com/TestHarness/Schemas/dnpdata\">\n", curLen, bGetLen);
-  result = _appendStringLen(result, " <device>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <deviceAttributeGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "<?xml version=\"1.0\"?>\n");
+  _appendString(pStream, "<tmw:dnpdata\n");
+  _appendString(pStream, " xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n");
+  _appendString(pStream, " xmlns:tmw=\"http://www.TriangleMicroWorks.com/TestHarness/Schemas/dnpdata\">\n");
+  _appendString(pStream, " <device>\n");
+  _appendString(pStream, "  <deviceAttributeGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </authSecStatGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, " </device>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "</tmw:dnpdata>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </authSecStatGroup>\n");
+  _appendString(pStream, " </device>\n");
+  _appendString(pStream, "</tmw:dnpdata>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDeviceAttrTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDeviceAttrTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </deviceAttributeGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <binaryInputGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </deviceAttributeGroup>\n");
+  _appendString(pStream, "  <binaryInputGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinInTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinInTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </binaryInputGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <doubleBitInputGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </binaryInputGroup>\n");
+  _appendString(pStream, "  <doubleBitInputGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDblBitInTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDblBitInTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </doubleBitInputGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <binaryOutputControlGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </doubleBitInputGroup>\n");
+  _appendString(pStream, "  <binaryOutputControlGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinOutTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinOutTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </binaryOutputControlGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <binaryOutputStatusGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </binaryOutputControlGroup>\n");
+  _appendString(pStream, "  <binaryOutputStatusGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinOutStatusTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinOutStatusTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </binaryOutputStatusGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <binaryCounterGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </binaryOutputStatusGroup>\n");
+  _appendString(pStream, "  <binaryCounterGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinCounterTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinCounterTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "   </binaryCounterGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <frozenCounterGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "   </binaryCounterGroup>\n");
+  _appendString(pStream, "  <frozenCounterGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrozenCounterTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildFrozenCounterTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "   </frozenCounterGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <analogInputGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "   </frozenCounterGroup>\n");
+  _appendString(pStream, "  <analogInputGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogInTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </analogInputGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <frznAnalogInputGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </analogInputGroup>\n");
+  _appendString(pStream, "  <frznAnalogInputGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrznAnalogInTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildFrznAnalogInTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </frznAnalogInputGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <analogInputDeadbandGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </frznAnalogInputGroup>\n");
+  _appendString(pStream, "  <analogInputDeadbandGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInDbandTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogInDbandTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </analogInputDeadbandGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <analogOutputControlGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </analogInputDeadbandGroup>\n");
+  _appendString(pStream, "  <analogOutputControlGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogOutTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </analogOutputControlGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <analogOutputStatusGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </analogOutputControlGroup>\n");
+  _appendString(pStream, "  <analogOutputStatusGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutStatusTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogOutStatusTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </analogOutputStatusGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <dataSetProtoGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </analogOutputStatusGroup>\n");
+  _appendString(pStream, "  <dataSetProtoGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetProtoTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetProtoTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </dataSetProtoGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <dataSetDescrGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </dataSetProtoGroup>\n");
+  _appendString(pStream, "  <dataSetDescrGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDescrTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDescrTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </dataSetDescrGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <dataSetDataGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </dataSetDescrGroup>\n");
+  _appendString(pStream, "  <dataSetDataGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDataTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDataTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </dataSetDataGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <stringGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </dataSetDataGroup>\n");
+  _appendString(pStream, "  <stringGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildStringTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildStringTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </stringGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <virtualTerminalGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </stringGroup>\n");
+  _appendString(pStream, "  <virtualTerminalGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildVtermTail(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildVtermTail(SDNPXMLW_STREAM *pStream)
 {
-  result = _appendStringLen(result, "  </virtualTerminalGroup>\n", curLen, bGetLen);
-  result = _appendStringLen(result, "  <authSecStatGroup>\n", curLen, bGetLen);
-  return result;
+  _appendString(pStream, "  </virtualTerminalGroup>\n");
+  _appendString(pStream, "  <authSecStatGroup>\n");
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _putBoolField(TMWTYPES_CHAR *result, TMWTYPES_CHAR *prefix, TMWTYPES_CHAR *name, TMWTYPES_BOOL flag, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _putBoolField(SDNPXMLW_STREAM *pStream, TMWTYPES_CHAR *prefix, TMWTYPES_CHAR *name, TMWTYPES_BOOL flag)
 {
   TMWTYPES_CHAR buf[128];
   tmwtarg_snprintf(buf, sizeof(buf), "%s<%s>%s</%s>\n", prefix, name, flag ? "true" : "false", name);
-  return _appendStringLen(result, buf, curLen, bGetLen);
+  _appendString(pStream, buf);
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _putClass(TMWTYPES_CHAR *result, TMWDEFS_CLASS_MASK mask, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _putClass(SDNPXMLW_STREAM *pStream, TMWDEFS_CLASS_MASK mask)
 {
-  result = _putBoolField(result, "    ", "notInClass0", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_NOTCLASS0), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "class1Events", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_ONE), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "class2Events", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_TWO), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "class3Events", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_THREE), curLen, bGetLen);
-  return result;
+  _putBoolField(pStream, "    ", "notInClass0", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_NOTCLASS0));
+  _putBoolField(pStream, "    ", "class1Events", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_ONE));
+  _putBoolField(pStream, "    ", "class2Events", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_TWO));
+  _putBoolField(pStream, "    ", "class3Events", TMWDEFS_TOBOOL(mask, TMWDEFS_CLASS_MASK_THREE));
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _putControl(TMWTYPES_CHAR *result, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _putControl(SDNPXMLW_STREAM *pStream)
 {
-  result = _putBoolField(result, "    ", "supportSelectOperate", TMWDEFS_TRUE, curLen, bGetLen);
-  result = _putBoolField(result, "    ", "supportDirectOperate", TMWDEFS_TRUE, curLen, bGetLen);
-  result = _putBoolField(result, "    ", "supportDirectOperateNoAck", TMWDEFS_TRUE, curLen, bGetLen);
-  return result;
+  _putBoolField(pStream, "    ", "supportSelectOperate", TMWDEFS_TRUE);
+  _putBoolField(pStream, "    ", "supportDirectOperate", TMWDEFS_TRUE);
+  _putBoolField(pStream, "    ", "supportDirectOperateNoAck", TMWDEFS_TRUE);
 }
 
 #if SDNPDATA_SUPPORT_OBJ12
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _putBinControl(TMWTYPES_CHAR *result, SDNPDATA_CROB_CTRL mask, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _putBinControl(SDNPXMLW_STREAM *pStream, SDNPDATA_CROB_CTRL mask)
 {
-  result = _putBoolField(result, "    ", "supportPulseOn", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_PULSE_ON), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "supportPulseOff", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_PULSE_OFF), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "supportLatchOn", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_LATCH_ON), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "supportLatchOff", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_LATCH_OFF), curLen, bGetLen);
-  result = _putBoolField(result, "    ", "supportTripClose", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_PAIRED_CLOSE), curLen, bGetLen);
-  return result;
+  _putBoolField(pStream, "    ", "supportPulseOn", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_PULSE_ON));
+  _putBoolField(pStream, "    ", "supportPulseOff", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_PULSE_OFF));
+  _putBoolField(pStream, "    ", "supportLatchOn", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_LATCH_ON));
+  _putBoolField(pStream, "    ", "supportLatchOff", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_LATCH_OFF));
+  _putBoolField(pStream, "    ", "supportTripClose", TMWDEFS_TOBOOL(mask, SDNPDATA_CROB_CTRL_PAIRED_CLOSE));
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ3
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _putDblBitValue(TMWTYPES_CHAR *result, TMWTYPES_UCHAR state, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _putDblBitValue(SDNPXMLW_STREAM *pStream, TMWTYPES_UCHAR state)
 {
   TMWTYPES_CHAR buf[128];
 
@@ -259,73 +223,10 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _putDblBitValue(TMWTYPES_CHAR *result, TMWT
       break;
   }
 
-  return _appendStringLen(result, buf, curLen, bGetLen);
+  _appendString(pStream, buf);
 }
 #endif
 
-#if SDNPDATA_SUPPORT_OBJ0
-static void TMWDEFS_LOCAL _toDeviceAttOutData(DNPDATA_ATTRIBUTE_VALUE *pValue, TMWTYPES_UCHAR *pOut, int *pLength)
-{
-  int length = 0; 
-  TMWTYPES_CHAR tempBuf[256];
-
-  switch(pValue->type)
-  {
-    case DNPDEFS_ATTRIBUTE_TYPE_VSTR:   
-      length = pValue->length;
-      if(length+1 > *pLength)
-        length = (*pLength)-1;  
-      if ( length ) {
-        memcpy(tempBuf, pValue->value.pStrValue, length); 
-      } else {
-        tempBuf[0] = NULL;
-      }
-      break;  
-    case DNPDEFS_ATTRIBUTE_TYPE_UINT:    
-      length = tmwtarg_snprintf(tempBuf, *pLength, "%u",pValue->value.uintValue);
-      break;
-    case DNPDEFS_ATTRIBUTE_TYPE_INT:  
-      length = tmwtarg_snprintf(tempBuf, *pLength, "%d",pValue->value.intValue); 
-      break;
-    case DNPDEFS_ATTRIBUTE_TYPE_FLT:  
-      if(pValue->length == 4)
-        length = tmwtarg_snprintf(tempBuf, *pLength, "%g",pValue->value.fltValue.sfltValue);  
-      else
-        length = tmwtarg_snprintf(tempBuf, *pLength, "%g",pValue->value.fltValue.doubleValue);  
-      break; 
-      
-    case DNPDEFS_ATTRIBUTE_TYPE_DNP3TIME:
-        tmwdiag_time2string(&pValue->value.timeValue, TMWDEFS_TIME_FORMAT_56, tempBuf, sizeof(tempBuf), TMWDEFS_FALSE);
-        length = tmwtarg_snprintf(tempBuf, *pLength, "%s", tempBuf); 
-        break;
-
-    case DNPDEFS_ATTRIBUTE_TYPE_OSTR:  
-    case DNPDEFS_ATTRIBUTE_TYPE_BSTR:  
-      {   
-        int j;
-        int len = 0;
-        /* Make sure it fits */
-        length = pValue->length;
-        if(length+1 > *pLength)
-          length = (*pLength)-1;  
-        for(j=0; j< length; j++)
-          len += tmwtarg_snprintf((tempBuf + len), sizeof(tempBuf)-len, "%02x ", pValue->value.pStrValue[j]);
-        length = len;
-      }
-      break;
-    default:
-      length = 0; 
-      break;
-  }  
-
-  *pLength = length;
-  if(length > 0)
-  {
-    memcpy(pOut, tempBuf, length);
-    *(pOut+length) = 0;
-  }
-}
-
 static TMWTYPES_BOOL _hasXmlSyntax(TMWTYPES_CHAR *origString, TMWTYPES_CHAR *escString, size_t maxEscLen)
 {
   /* The characters &, <, & > cannot be used in their literal form so they must be escaped. */
@@ -381,6 +282,7 @@ static void _xmlFormatDesc(TMWTYPES_CHAR *desc, TMWTYPES_CHAR *buf, size_t bufSi
   tmwtarg_snprintf(buf, (TMWTYPES_UINT)bufSize, "    <description>%s</description>\n", desc);
 }
 
+#if SDNPDATA_SUPPORT_OBJ110
 static void _xmlFormatValue(TMWTYPES_CHAR *value, TMWTYPES_CHAR *buf, size_t bufSize)
 {
   /* Use a large buffer that should handle most strings that will not */
@@ -393,8 +295,72 @@ static void _xmlFormatValue(TMWTYPES_CHAR *value, TMWTYPES_CHAR *buf, size_t buf
   }
   tmwtarg_snprintf(buf, (TMWTYPES_UINT)bufSize, "    <value>%s</value>\n", value);
 }
+#endif
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDeviceAttrPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_UCHAR *pVariation, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+#if SDNPDATA_SUPPORT_OBJ0
+static void TMWDEFS_LOCAL _toDeviceAttOutData(DNPDATA_ATTRIBUTE_VALUE *pValue, TMWTYPES_UCHAR *pOut, int *pLength)
+{
+  int length = 0; 
+  TMWTYPES_CHAR tempBuf[256];
+
+  switch(pValue->type)
+  {
+    case DNPDEFS_ATTRIBUTE_TYPE_VSTR:   
+      length = pValue->length;
+      if(length+1 > *pLength)
+        length = (*pLength)-1;  
+      if ( length ) {
+        memcpy(tempBuf, pValue->value.pStrValue, length); 
+      } else {
+        tempBuf[0] = NULL;
+      }
+      break;  
+    case DNPDEFS_ATTRIBUTE_TYPE_UINT:    
+      length = tmwtarg_snprintf(tempBuf, *pLength, "%u",pValue->value.uintValue);
+      break;
+    case DNPDEFS_ATTRIBUTE_TYPE_INT:  
+      length = tmwtarg_snprintf(tempBuf, *pLength, "%d",pValue->value.intValue); 
+      break;
+    case DNPDEFS_ATTRIBUTE_TYPE_FLT:  
+      if(pValue->length == 4)
+        length = tmwtarg_snprintf(tempBuf, *pLength, "%g",pValue->value.fltValue.sfltValue);  
+      else
+        length = tmwtarg_snprintf(tempBuf, *pLength, "%g",pValue->value.fltValue.doubleValue);  
+      break; 
+      
+    case DNPDEFS_ATTRIBUTE_TYPE_DNP3TIME:
+        tmwdiag_time2string(&pValue->value.timeValue, TMWDEFS_TIME_FORMAT_56, tempBuf, sizeof(tempBuf), TMWDEFS_FALSE);
+        length = tmwtarg_snprintf(tempBuf, *pLength, "%s", tempBuf); 
+        break;
+
+    case DNPDEFS_ATTRIBUTE_TYPE_OSTR:  
+    case DNPDEFS_ATTRIBUTE_TYPE_BSTR:  
+      {   
+        int j;
+        int len = 0;
+        /* Make sure it fits */
+        length = pValue->length;
+        if(length+1 > *pLength)
+          length = (*pLength)-1;  
+        for(j=0; j< length; j++)
+          len += tmwtarg_snprintf((tempBuf + len), sizeof(tempBuf)-len, "%02x ", pValue->value.pStrValue[j]);
+        length = len;
+      }
+      break;
+    default:
+      length = 0; 
+      break;
+  }  
+
+  *pLength = length;
+  if(length > 0)
+  {
+    memcpy(pOut, tempBuf, length);
+    *(pOut+length) = 0;
+  }
+}
+
+static void TMWDEFS_LOCAL _buildDeviceAttrPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_UCHAR *pVariation)
 {
   TMWTYPES_UCHAR variation;
   TMWTYPES_UCHAR nextVariation;
@@ -413,9 +379,9 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDeviceAttrPoint(TMWTYPES_CHAR *result
 
     if(variation == 0)
     {
-      result = _appendStringLen(result, "   <deviceAttribute>\n", curLen, bGetLen);
+      _appendString(pStream, "   <deviceAttribute>\n");
       tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
 
     if(sdnpdata_deviceAttrNext(pPoint, variation, &nextVariation, &property)) 
@@ -431,25 +397,25 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDeviceAttrPoint(TMWTYPES_CHAR *result
       {
         sdnpdata_deviceAttrRead(pAttribute, &data);
 
-        result = _appendStringLen(result, "    <deviceAttributeElement>\n", curLen, bGetLen);
+        _appendString(pStream, "    <deviceAttributeElement>\n");
 
         tmwtarg_snprintf(buf, sizeof(buf), "     <variation>%d</variation>\n", variation);
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 
         tmwtarg_snprintf(buf, sizeof(buf), "     <property>%d</property>\n", property);
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 
         tmwtarg_snprintf(buf, sizeof(buf), "     <dataType>%d</dataType>\n", data.type);
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 
         tmwtarg_snprintf(buf, sizeof(buf), "     <length>%d</length>\n", data.length);
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 
         desc = tmwsim_getDescription((TMWSIM_POINT*)pAttribute);
         if(desc && (strlen(desc) > 0))
         {
           _xmlFormatDesc(desc, buf, sizeof(buf));
-          result = _appendStringLen(result, buf, curLen, bGetLen);
+          _appendString(pStream, buf);
         }
 
         len = 256;
@@ -457,9 +423,9 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDeviceAttrPoint(TMWTYPES_CHAR *result
         if(len > 0)
         {
           tmwtarg_snprintf(buf, sizeof(buf), "     <value>%s</value>\n", value);
-          result = _appendStringLen(result, buf, curLen, bGetLen);
+          _appendString(pStream, buf);
         }
-        result = _appendStringLen(result, "    </deviceAttributeElement>\n", curLen, bGetLen);
+        _appendString(pStream, "    </deviceAttributeElement>\n");
       }
     }
     else 
@@ -468,13 +434,11 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDeviceAttrPoint(TMWTYPES_CHAR *result
 
       /* See if there are any more device attribute points */
       pPoint = sdnpdata_deviceAttrGetPoint(pDbHandle, pointNum+1);
-      result = _appendStringLen(result, "   </deviceAttribute>\n", curLen, bGetLen);
+      _appendString(pStream, "   </deviceAttribute>\n");
     }
   }
    
   *pVariation = nextVariation;
-
-  return result;
 }
 #endif
 
@@ -501,7 +465,7 @@ static TMWTYPES_CHAR * _eventModeString(TMWDEFS_EVENT_MODE reportingMode)
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ1
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinInPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinInPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -517,54 +481,53 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinInPoint(TMWTYPES_CHAR *result, voi
     desc = sdnpdata_binInGetDescription(pPoint);
     classMask = sdnpdata_binInEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <binaryInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   <binaryInput>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
-
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "chatterFilter", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CHATTER), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "state", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_BINARY_ON), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _putClass(pStream, classMask);
+
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "chatterFilter", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CHATTER));
+    _putBoolField(pStream, "     ", "state", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_BINARY_ON));
+    _appendString(pStream, "    </flags>\n");
 
     /* enabled.  I currently can't get the point if it is not enabled. */ 
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_binInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_binInDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_binInEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
 /* Add to xml ? PointTime */
 
-    result = _appendStringLen(result, "   </binaryInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   </binaryInput>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ3
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDblBitInPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -580,52 +543,51 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDblBitInPoint(TMWTYPES_CHAR *result,
     desc = sdnpdata_dblInGetDescription(pPoint);
     classMask = sdnpdata_dblInEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <doubleBitInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   <doubleBitInput>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
-
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "chatterFilter", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CHATTER), curLen, bGetLen);
-    result = _putDblBitValue(result, flags, curLen,  bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _putClass(pStream, classMask);
+
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "chatterFilter", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CHATTER));
+    _putDblBitValue(pStream, flags);
+    _appendString(pStream, "    </flags>\n");
  
     /* enabled.  I currently can't get the point if it is not enabled. */ 
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_dblInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_dblInDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_dblInEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "   </doubleBitInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   </doubleBitInput>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ12
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinOutPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -642,32 +604,31 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinOutPoint(TMWTYPES_CHAR *result, vo
     desc = sdnpdata_binOutGetDescription(pPoint);
     ctrlMask = sdnpdata_binOutGetControlMask(pPoint);
 
-    result = _appendStringLen(result, "   <binaryOutputControl>\n", curLen, bGetLen);
+    _appendString(pStream, "   <binaryOutputControl>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putControl(result, curLen, bGetLen);
-    result = _putBinControl(result, ctrlMask, curLen, bGetLen);
+    _putControl(pStream);
+    _putBinControl(pStream, ctrlMask);
 
     classMask = sdnpdata_binOutCmdEventClass(pPoint); 
     
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
-    result = _appendStringLen(result, "   </binaryOutputControl>\n", curLen, bGetLen);
+    _appendString(pStream, "   </binaryOutputControl>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ10
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinOutStatusPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinOutStatusPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -684,48 +645,47 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinOutStatusPoint(TMWTYPES_CHAR *resu
     classMask = sdnpdata_binOutEventClass(pPoint);
     desc = sdnpdata_binOutGetDescription(pPoint);
 
-    result = _appendStringLen(result, "   <binaryOutputStatus>\n", curLen, bGetLen);
+    _appendString(pStream, "   <binaryOutputStatus>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "state", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_BINARY_ON), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "state", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_BINARY_ON));
+    _appendString(pStream, "    </flags>\n");
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_binOutEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_binOutDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_binOutEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
-    result = _appendStringLen(result, "   </binaryOutputStatus>\n", curLen, bGetLen);
+    _appendString(pStream, "   </binaryOutputStatus>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ20
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinCounterPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinCounterPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -741,53 +701,52 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildBinCounterPoint(TMWTYPES_CHAR *result
     sdnpdata_binCntrRead(pPoint, &value, &flags);
     classMask = sdnpdata_binCntrEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <binaryCounter>\n", curLen, bGetLen);
+    _appendString(pStream, "   <binaryCounter>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
-
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "rollover", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CNTR_ROLLOVER), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "discontinuity", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _putClass(pStream, classMask);
+
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "rollover", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CNTR_ROLLOVER));
+    _putBoolField(pStream, "     ", "discontinuity", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK));
+    _appendString(pStream, "    </flags>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "     <value>%u</value>\n", value);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_binCntrEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_binCntrDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT    
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_binCntrEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "  </binaryCounter>\n", curLen, bGetLen);
+    _appendString(pStream, "  </binaryCounter>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ21
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrozenCounterPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildFrozenCounterPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -804,53 +763,52 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrozenCounterPoint(TMWTYPES_CHAR *res
     sdnpdata_frznCntrRead(pPoint, &value, &flags, &timeOfFreeze);
     classMask = sdnpdata_frznCntrEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <frozenCounter>\n", curLen, bGetLen);
+    _appendString(pStream, "   <frozenCounter>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
-
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "rollover", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CNTR_ROLLOVER), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "discontinuity", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _putClass(pStream, classMask);
+
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "rollover", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CNTR_ROLLOVER));
+    _putBoolField(pStream, "     ", "discontinuity", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK));
+    _appendString(pStream, "    </flags>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "     <value>%u</value>\n", value);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_frznCntrEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_frznCntrDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
    
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_frznCntrEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "  </frozenCounter>\n", curLen, bGetLen);
+    _appendString(pStream, "  </frozenCounter>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ30
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -866,28 +824,28 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInPoint(TMWTYPES_CHAR *result,
     sdnpdata_anlgInRead(pPoint, &value, &flags);
     classMask = sdnpdata_anlgInEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <analogInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   <analogInput>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
-
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "overRange", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVER_RANGE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "referenceCheck", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _putClass(pStream, classMask);
+
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "overRange", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVER_RANGE));
+    _putBoolField(pStream, "     ", "referenceCheck", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK));
+    _appendString(pStream, "    </flags>\n");
 
 #if TMWCNFG_SUPPORT_DOUBLE
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%g</value>\n", dnputil_getAnalogValueDouble(&value));
@@ -896,29 +854,28 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInPoint(TMWTYPES_CHAR *result,
 #else
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%d</value>\n", dnputil_getAnalogValueLong(&value,&flags));
 #endif
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_anlgInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_anlgInDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
    
 #if  SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_anlgInEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "   </analogInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   </analogInput>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ31
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrznAnalogInPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildFrznAnalogInPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -935,28 +892,28 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrznAnalogInPoint(TMWTYPES_CHAR *resu
     sdnpdata_frznAnlgInRead(pPoint, &value, &flags, &timeOfFreeze);
     classMask = sdnpdata_frznAnlgInEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <frznAnalogInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   <frznAnalogInput>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if (desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
 
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "overRange", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVER_RANGE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "referenceCheck", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "overRange", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVER_RANGE));
+    _putBoolField(pStream, "     ", "referenceCheck", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK));
+    _appendString(pStream, "    </flags>\n");
 
 #if TMWCNFG_SUPPORT_DOUBLE
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%g</value>\n", dnputil_getAnalogValueDouble(&value));
@@ -965,29 +922,28 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildFrznAnalogInPoint(TMWTYPES_CHAR *resu
 #else
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%d</value>\n", dnputil_getAnalogValueLong(&value, &flags));
 #endif
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_frznAnlgInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_frznAnlgInDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_frznAnlgInEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "   </frznAnalogInput>\n", curLen, bGetLen);
+    _appendString(pStream, "   </frznAnalogInput>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ34
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInDBandPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogInDBandPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -1000,15 +956,15 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInDBandPoint(TMWTYPES_CHAR *res
     desc = sdnpdata_anlgInDBandGetDescription(pPoint);
     sdnpdata_anlgInDBandRead(pPoint, &value);
 
-    result = _appendStringLen(result, "   <analogInputDeadband>\n", curLen, bGetLen);
+    _appendString(pStream, "   <analogInputDeadband>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
 #if TMWCNFG_SUPPORT_DOUBLE
@@ -1021,19 +977,18 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogInDBandPoint(TMWTYPES_CHAR *res
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%d</value>\n", dnputil_getAnalogValueLong(&value,&flags));
     }
 #endif
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
     
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_anlgInDbandDefVar(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
-    result = _appendStringLen(result, "   </analogInputDeadband>\n", curLen, bGetLen);
+    _appendString(pStream, "   </analogInputDeadband>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ40 || SDNPDATA_SUPPORT_OBJ41
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -1048,31 +1003,30 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutPoint(TMWTYPES_CHAR *result,
     desc = sdnpdata_anlgOutGetDescription(pPoint);
     sdnpdata_anlgOutRead(pPoint, &value, &flags);
 
-    result = _appendStringLen(result, "   <analogOutputControl>\n", curLen, bGetLen);
+    _appendString(pStream, "   <analogOutputControl>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putControl(result, curLen, bGetLen);
+    _putControl(pStream);
 
     classMask = sdnpdata_anlgOutCmdEventClass(pPoint); 
     
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
-    result = _appendStringLen(result, "   </analogOutputControl>\n", curLen, bGetLen);
+    _appendString(pStream, "   </analogOutputControl>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ40
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutStatusPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogOutStatusPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -1088,28 +1042,28 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutStatusPoint(TMWTYPES_CHAR *r
     sdnpdata_anlgOutRead(pPoint, &value, &flags);
     classMask = sdnpdata_anlgOutEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <analogOutputStatus>\n", curLen, bGetLen);
+    _appendString(pStream, "   <analogOutputStatus>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
 
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
     
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "overRange", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVER_RANGE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "referenceCheck", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "overRange", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVER_RANGE));
+    _putBoolField(pStream, "     ", "referenceCheck", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK));
+    _appendString(pStream, "    </flags>\n");
 
 #if TMWCNFG_SUPPORT_DOUBLE
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%g</value>\n", dnputil_getAnalogValueDouble(&value));
@@ -1118,24 +1072,23 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAnalogOutStatusPoint(TMWTYPES_CHAR *r
 #else
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%d</value>\n", dnputil_getAnalogValueLong(&value,&flags));
 #endif
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_anlgOutEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_anlgOutDefVariation(pPoint));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_anlgOutEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "   </analogOutputStatus>\n", curLen, bGetLen);
+    _appendString(pStream, "   </analogOutputStatus>\n");
   }
-  return result;
 }
 #endif
 		
@@ -1293,7 +1246,7 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _toDatasetOutData(DNPDATA_DATASET_VALUE *pDat
   return hexValues;
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetProtoPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetProtoPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -1310,16 +1263,16 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetProtoPoint(TMWTYPES_CHAR *resu
 
     pDescrElems = sdnpdata_datasetProtoRead(pPoint, &numberElems, (TMWTYPES_UCHAR*)&uuid);  
  
-    result = _appendStringLen(result, "   <dataSetProtoData>\n", curLen, bGetLen);
+    _appendString(pStream, "   <dataSetProtoData>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
     
     desc = sdnpdata_datasetGetDescription(pPoint);
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
 
     len = 0;
@@ -1327,35 +1280,34 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetProtoPoint(TMWTYPES_CHAR *resu
       len += tmwtarg_snprintf((char *)name+len, sizeof(name)-len, "%02x ", uuid[i]);
     
     tmwtarg_snprintf(buf, sizeof(buf), "    <uuid>%s</uuid>\n", name);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     for(i=0; i<numberElems; i++ )
     {
-      result = _appendStringLen(result, "    <dataSetDescrElement>\n", curLen, bGetLen);
+      _appendString(pStream, "    <dataSetDescrElement>\n");
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <descrElemType>%s</descrElemType>\n", _toDescrType(pDescrElems[i].descrElemType));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <dataType>%s</dataType>\n", _toDataType(pDescrElems[i].dataTypeCode));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <maxDataLength>%d</maxDataLength>\n", pDescrElems[i].maxDataLength);
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
       
       _toDatasetOutData(&pDescrElems[i].ancillaryValue, DNPDEFS_DATASET_TYPE_VSTR, name, 256);
       tmwtarg_snprintf(buf, sizeof(buf), "     <value>%s</value>\n", name);
 
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
-      result = _appendStringLen(result, "    </dataSetDescrElement>\n", curLen, bGetLen); 
+      _appendString(pStream, "    </dataSetDescrElement>\n"); 
     }
 
-    result = _appendStringLen(result, "   </dataSetProtoData>\n", curLen, bGetLen);
+    _appendString(pStream, "   </dataSetProtoData>\n");
   }
-  return result;
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDescrPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDescrPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint;
   TMWTYPES_CHAR *desc;
@@ -1375,36 +1327,36 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDescrPoint(TMWTYPES_CHAR *resu
     pDescrElems = sdnpdata_datasetDescrReadCont(pPoint, &numberElems);
     classMask = sdnpdata_datasetDescrEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <dataSetDescrData>\n", curLen, bGetLen);
+    _appendString(pStream, "   <dataSetDescrData>\n");
 
     desc = sdnpdata_datasetGetDescription(pPoint);
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
     sdnpdata_datasetDescrReadChars(pPoint, &characteristics);
     tmwtarg_snprintf(buf, sizeof(buf), "    <characteristics>%d</characteristics>\n", characteristics);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     for(i=0; i<numberElems; i++ )
     {
-      result = _appendStringLen(result, "    <dataSetDescrElement>\n", curLen, bGetLen);
+      _appendString(pStream, "    <dataSetDescrElement>\n");
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <descrElemType>%s</descrElemType>\n", _toDescrType(pDescrElems[i].descrElemType));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <dataType>%s</dataType>\n", _toDataType(pDescrElems[i].dataTypeCode));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <maxDataLength>%d</maxDataLength>\n", pDescrElems[i].maxDataLength);
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
   
       if(pDescrElems[i].descrElemType == DNPDEFS_DATASET_DESCR_UUID
         || pDescrElems[i].descrElemType == DNPDEFS_DATASET_DESCR_PTYP)
@@ -1417,29 +1369,28 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDescrPoint(TMWTYPES_CHAR *resu
         _toDatasetOutData(&pDescrElems[i].ancillaryValue, DNPDEFS_DATASET_TYPE_VSTR, name, 256);
         tmwtarg_snprintf(buf, sizeof(buf), "     <value>%s</value>\n", name); 
       }
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
-      result = _appendStringLen(result, "    </dataSetDescrElement>\n", curLen, bGetLen); 
+      _appendString(pStream, "    </dataSetDescrElement>\n"); 
     }
  
     pIndexElems = sdnpdata_datasetDescrReadIndex(pPoint, &numberElems); 
 
     for(i=0; i<numberElems; i++ )
     {
-      result = _appendStringLen(result, "    <dataSetPointIndexAttribute>\n", curLen, bGetLen);
+      _appendString(pStream, "    <dataSetPointIndexAttribute>\n");
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <pointType>%d</pointType>\n", pIndexElems[i].pointType);
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <pointIndex>%d</pointIndex>\n", pIndexElems[i].pointIndex);
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
  
-      result = _appendStringLen(result, "    </dataSetPointIndexAttribute>\n", curLen, bGetLen); 
+      _appendString(pStream, "    </dataSetPointIndexAttribute>\n"); 
     }
 
-    result = _appendStringLen(result, "   </dataSetDescrData>\n", curLen, bGetLen);
+    _appendString(pStream, "   </dataSetDescrData>\n");
   }
-  return result;
 }
 
 static void TMWDEFS_LOCAL _datasetDescrExpanded(void *pDbHandle, TMWTYPES_USHORT pointNum, DNPDEFS_DATASET_TYPE_CODE *pDataTypeArray)
@@ -1496,7 +1447,7 @@ static void TMWDEFS_LOCAL _datasetDescrExpanded(void *pDbHandle, TMWTYPES_USHORT
   } 
 }
 
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDataPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDataPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[2048];
   void *pPoint;
@@ -1513,36 +1464,35 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildDatasetDataPoint(TMWTYPES_CHAR *resul
     pDataElems = sdnpdata_datasetRead(pPoint, &numberElems, &timeStamp);
     _datasetDescrExpanded(pDbHandle, pointNum, dataTypeArray);
 
-    result = _appendStringLen(result, "   <dataSetData>\n", curLen, bGetLen);
+    _appendString(pStream, "   <dataSetData>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     for(i=0; i<numberElems; i++ )
     {
-      result = _appendStringLen(result, "    <dataSetElement>\n", curLen, bGetLen);
+      _appendString(pStream, "    <dataSetElement>\n");
 
       tmwtarg_snprintf(buf, sizeof(buf), "     <length>%d</length>\n", pDataElems[i].length);
-      result = _appendStringLen(result, buf, curLen, bGetLen); 
+      _appendString(pStream, buf); 
 
       if(_toDatasetOutData(&pDataElems[i], dataTypeArray[i], dataBuf, 2020))
         tmwtarg_snprintf(buf, sizeof(buf), "     <hexValue>%s</hexValue>\n", dataBuf);
       else
         tmwtarg_snprintf(buf, sizeof(buf), "     <value>%s</value>\n", dataBuf);  
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
    
-      result = _appendStringLen(result, "    </dataSetElement>\n", curLen, bGetLen); 
+      _appendString(pStream, "    </dataSetElement>\n"); 
     }
 
-    result = _appendStringLen(result, "   </dataSetData>\n", curLen, bGetLen);
+    _appendString(pStream, "   </dataSetData>\n");
   }
-  return result;
 }
 #endif
 
 
 #if SDNPDATA_SUPPORT_OBJ110
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildStringPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildStringPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint;
   TMWTYPES_BOOL isExtendedString;
@@ -1562,31 +1512,31 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildStringPoint(TMWTYPES_CHAR *result, vo
     sdnpdata_strRead(pPoint, sizeof(strBuf), strBuf, &strLength);
     classMask = sdnpdata_strEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <stringData>\n", curLen, bGetLen);
+    _appendString(pStream, "   <stringData>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
 
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
     strBuf[strLength] = '\0';
     _xmlFormatValue((TMWTYPES_CHAR *)strBuf, buf, sizeof(buf));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
-    result = _putBoolField(result, "    ", "extended", isExtendedString, curLen, bGetLen);
+    _putBoolField(pStream, "    ", "extended", isExtendedString);
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_strEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "   </stringData>\n", curLen, bGetLen);
+    _appendString(pStream, "   </stringData>\n");
   }
 #if SDNPDATA_SUPPORT_OBJ114
   else
@@ -1618,51 +1568,50 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildStringPoint(TMWTYPES_CHAR *result, vo
 
         classMask = sdnpdata_extStrEventClass(pPoint);
 
-        result = _appendStringLen(result, "   <stringData>\n", curLen, bGetLen);
+        _appendString(pStream, "   <stringData>\n");
 
         tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 
         if (desc && (strlen(desc) > 0))
         {
           _xmlFormatDesc(desc, buf, sizeof(buf));
-          result = _appendStringLen(result, buf, curLen, bGetLen);
+          _appendString(pStream, buf);
         }
 
-        result = _putClass(result, classMask, curLen, bGetLen);
+        _putClass(pStream, classMask);
 
         ptr[strLength] = '\0';
         _xmlFormatValue((TMWTYPES_CHAR *)ptr, buf, sizeof(buf));
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 
-        result = _putBoolField(result, "    ", "extended", isExtendedString, curLen, bGetLen);
+        _putBoolField(pStream, "    ", "extended", isExtendedString);
         if (isExtendedString)
         {
-          result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-          result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-          result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-          result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-          result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-          result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-          result = _putBoolField(result, "     ", "overflow", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVERFLOW), curLen, bGetLen);
-          result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+          _appendString(pStream, "    <flags>\n");
+          _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+          _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+          _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+          _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+          _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+          _putBoolField(pStream, "     ", "overflow", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_OVERFLOW));
+          _appendString(pStream, "    </flags>\n");
         }
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
         tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_extStrEventMode(pPoint)));
-        result = _appendStringLen(result, buf, curLen, bGetLen);
+        _appendString(pStream, buf);
 #endif
 
-        result = _appendStringLen(result, "   </stringData>\n", curLen, bGetLen);
+        _appendString(pStream, "   </stringData>\n");
       }
   }
 #endif
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ112
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildVtermPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildVtermPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[320];
   void *pPoint;
@@ -1678,31 +1627,30 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildVtermPoint(TMWTYPES_CHAR *result, voi
     sdnpdata_vtermRead(pPoint, sizeof(strBuf), strBuf, &strLength);
     classMask = sdnpdata_vtermEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <virtualTerminal>\n", curLen, bGetLen);
+    _appendString(pStream, "   <virtualTerminal>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
+    _putClass(pStream, classMask);
 
     strBuf[strLength] = '\0';
     tmwtarg_snprintf(buf, sizeof(buf), "    <value>%s</value>\n", strBuf);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
-    result = _appendStringLen(result, "   </virtualTerminal>\n", curLen, bGetLen);
+    _appendString(pStream, "   </virtualTerminal>\n");
   }
-  return result;
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ120 && SDNPCNFG_SUPPORT_SA_VERSION5
-static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAuthSecStatPoint(TMWTYPES_CHAR *result, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAuthSecStatPoint(SDNPXMLW_STREAM *pStream, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   TMWTYPES_CHAR buf[256];
   void *pPoint;
@@ -1718,65 +1666,63 @@ static TMWTYPES_CHAR * TMWDEFS_LOCAL _buildAuthSecStatPoint(TMWTYPES_CHAR *resul
     sdnpdata_authSecStatRead(pPoint, &value, &flags);
     classMask = sdnpdata_authSecStatEventClass(pPoint);
 
-    result = _appendStringLen(result, "   <authSecStat>\n", curLen, bGetLen);
+    _appendString(pStream, "   <authSecStat>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "    <pointNumber>%d</pointNumber>\n", pointNum);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
     
-    result = _appendStringLen(result, "    <fromOS>true</fromOS>\n", curLen, bGetLen); 
+    _appendString(pStream, "    <fromOS>true</fromOS>\n"); 
 
     if(desc && (strlen(desc) > 0))
     {
       _xmlFormatDesc(desc, buf, sizeof(buf));
-      result = _appendStringLen(result, buf, curLen, bGetLen);
+      _appendString(pStream, buf);
     }
     
-    result = _putClass(result, classMask, curLen, bGetLen);
-
-    result = _appendStringLen(result, "    <flags>\n", curLen, bGetLen);
-    result = _putBoolField(result, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "rollover", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CNTR_ROLLOVER), curLen, bGetLen);
-    result = _putBoolField(result, "     ", "discontinuity", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK), curLen, bGetLen);
-    result = _appendStringLen(result, "    </flags>\n", curLen, bGetLen);
+    _putClass(pStream, classMask);
+
+    _appendString(pStream, "    <flags>\n");
+    _putBoolField(pStream, "     ", "online", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_ON_LINE));
+    _putBoolField(pStream, "     ", "restart", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_RESTART));
+    _putBoolField(pStream, "     ", "commLost", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_COMM_LOST));
+    _putBoolField(pStream, "     ", "remoteForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REMOTE_FORCED));
+    _putBoolField(pStream, "     ", "localForced", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_LOCAL_FORCED));
+    _putBoolField(pStream, "     ", "rollover", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_CNTR_ROLLOVER));
+    _putBoolField(pStream, "     ", "discontinuity", TMWDEFS_TOBOOL(flags, DNPDEFS_DBAS_FLAG_REFERENCE_CHK));
+    _appendString(pStream, "    </flags>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "     <value>%u</value>\n", value);
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <defaultEventVariation>%d</defaultEventVariation>\n", sdnpdata_authSecStatEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
     /*tmwtarg_snprintf(buf, sizeof(buf), "    <defaultStaticVariation>%d</defaultStaticVariation>\n", sdnpdata_authSecStatDefVariation(pPoint));
-     *result = _appendStringLen(result, buf, curLen, bGetLen);
+     *_appendString(pStream, buf);
      */
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     tmwtarg_snprintf(buf, sizeof(buf), "    <eventMode>%s</eventMode>\n", _eventModeString(sdnpdata_authSecStatEventMode(pPoint)));
-    result = _appendStringLen(result, buf, curLen, bGetLen);
+    _appendString(pStream, buf);
 #endif
 
-    result = _appendStringLen(result, "  </authSecStat>\n", curLen, bGetLen);
+    _appendString(pStream, "  </authSecStat>\n");
   }
-  return result;
 }
 #endif
 
-/* routine: sdnpxml_saveDatabaseStatic */
-SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession, TMWTYPES_CHAR *result, TMWTYPES_ULONG maxLen, TMWTYPES_ULONG *bufLen)
+/* function: _saveDatabase
+ *  write the profile from the current save state into pStream until it is
+ *  complete or pStream is full, each element is written in a single pass
+ */
+static SDNPXML_SAVE_STATE TMWDEFS_LOCAL _saveDatabase(SDNPSESN *pSDNPSession, SDNPXMLW_STREAM *pStream)
 {
-  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
   SDNPSIM_DATABASE *pSimDatabase = (SDNPSIM_DATABASE *)pSDNPSession->pDbHandle;
   TMWTYPES_BOOL loopControl;
-  TMWTYPES_ULONG curLen;
   TMWTYPES_USHORT numPoints;
   TMWTYPES_USHORT pointNum;
-   
-  curLen=0;
 
   /* Loop till a break is reached */
   loopControl = TMWDEFS_TRUE;
@@ -1785,13 +1731,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
     switch (pSimDatabase->xmlSaveState)
     {
     case SDNPXML_SAVE_HEADER:
-      _buildHeader(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildHeader(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildHeader(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DEVICE_ATTR;
       continue;
       break;
@@ -1804,15 +1749,15 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
         TMWTYPES_UCHAR variation = pSimDatabase->xmlCurSaveDAVariation;
         do
         { 
-          _buildDeviceAttrPoint(result,pSDNPSession->pDbHandle, pointNum, &variation, &curLen, TMWDEFS_TRUE);
-          if (curLen>=maxLen)
+          /* variation gets advanced in _buildDeviceAttrPoint, it is only stored
+           * once the element is complete so a partial element is built again
+           */
+          sdnpxmlw_startElement(pStream);
+          _buildDeviceAttrPoint(pStream, pSDNPSession->pDbHandle, pointNum, &variation);
+          if(!sdnpxmlw_endElement(pStream))
           {
             return SDNPXML_SAVE_NOT_DONE;
           }
-          /* variation gets advanced in _buildDeviceAttrPoint, set it back to read and store that variation */
-          variation = pSimDatabase->xmlCurSaveDAVariation;
-          result = _buildDeviceAttrPoint(result,pSDNPSession->pDbHandle, pointNum, &variation, &curLen, TMWDEFS_FALSE);
-          *bufLen = curLen;
           pSimDatabase->xmlCurSavePointNum = pointNum;
           pSimDatabase->xmlCurSaveDAVariation = variation;
         } while (variation != 255);
@@ -1820,7 +1765,6 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
         pSimDatabase->xmlCurSaveDAVariation = 0;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DEVICE_ATTR_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -1829,13 +1773,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_DEVICE_ATTR_TAIL:
-      _buildDeviceAttrTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDeviceAttrTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildDeviceAttrTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_IN;
       continue;
       break;
@@ -1845,16 +1788,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_binInQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildBinInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildBinInPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildBinInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_IN_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -1862,13 +1803,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_BIN_IN_TAIL:
-      _buildBinInTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildBinInTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildBinInTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DBL_IN;
       continue;
       break;
@@ -1878,16 +1818,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_dblInQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildDblBitInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDblBitInPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildDblBitInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DBL_IN_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -1895,13 +1833,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_DBL_IN_TAIL:
-      _buildDblBitInTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDblBitInTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildDblBitInTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_OUT;
       continue;
       break;
@@ -1911,16 +1848,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_binOutQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildBinOutPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildBinOutPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildBinOutPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_OUT_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -1928,13 +1863,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_BIN_OUT_TAIL:
-      _buildBinOutTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildBinOutTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildBinOutTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_OUT_STATUS;
       continue;
       break;
@@ -1944,16 +1878,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_binOutQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildBinOutStatusPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildBinOutStatusPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildBinOutStatusPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_OUT_STATUS_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -1961,13 +1893,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_BIN_OUT_STATUS_TAIL:
-      _buildBinOutStatusTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildBinOutStatusTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildBinOutStatusTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_COUNTER;
       continue;
       break;
@@ -1977,16 +1908,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildBinCounterPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildBinCounterPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildBinCounterPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_BIN_COUNTER_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -1994,13 +1923,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_BIN_COUNTER_TAIL:
-      _buildBinCounterTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildBinCounterTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildBinCounterTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_FROZEN_COUNTER;
       continue;
       break;
@@ -2010,16 +1938,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildFrozenCounterPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildFrozenCounterPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildFrozenCounterPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_FROZEN_COUNTER_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2027,13 +1953,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_FROZEN_COUNTER_TAIL:
-      _buildFrozenCounterTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildFrozenCounterTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildFrozenCounterTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_IN;
       continue;
       break;
@@ -2043,16 +1968,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildAnalogInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAnalogInPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildAnalogInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_IN_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2060,13 +1983,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_ANALOG_IN_TAIL:
-      _buildAnalogInTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogInTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildAnalogInTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_FRZNANALOG_IN;
       continue;
       break;
@@ -2076,16 +1998,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints = sdnpdata_frznAnlgInQuantity(pSDNPSession->pDbHandle);
       for (pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildFrznAnalogInPoint(result, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen >= maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildFrznAnalogInPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildFrznAnalogInPoint(result, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum + 1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_FRZNANALOG_IN_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2093,13 +2013,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_FRZNANALOG_IN_TAIL:
-      _buildFrznAnalogInTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen >= maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildFrznAnalogInTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildFrznAnalogInTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_IN_DB;
       continue;
       break;
@@ -2109,16 +2028,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildAnalogInDBandPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAnalogInDBandPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildAnalogInDBandPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_IN_DB_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2126,13 +2043,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_ANALOG_IN_DB_TAIL:
-      _buildAnalogInDbandTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogInDbandTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildAnalogInDbandTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_OUT;
       continue;
       break;
@@ -2142,16 +2058,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildAnalogOutPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAnalogOutPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildAnalogOutPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_OUT_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2159,13 +2073,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_ANALOG_OUT_TAIL:
-      _buildAnalogOutTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogOutTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildAnalogOutTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_OUT_STATUS;
       continue;
       break;
@@ -2175,16 +2088,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildAnalogOutStatusPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAnalogOutStatusPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildAnalogOutStatusPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_ANALOG_OUT_STATUS_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2192,13 +2103,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_ANALOG_OUT_STATUS_TAIL:
-      _buildAnalogOutStatusTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogOutStatusTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildAnalogOutStatusTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DATASET_PROTO;
       continue;
       break;
@@ -2208,23 +2118,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_datasetProtoQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildDatasetProtoPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDatasetProtoPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
-          /* If this data set descriptor is too big to fit in the buffer, skip it */
-          if(*bufLen == 0)
-          {
-            SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_XML_SIZE_ERROR);
-            curLen = *bufLen;
-            continue;
-          }
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildDatasetProtoPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DATASET_PROTO_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2232,13 +2133,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_DATASET_PROTO_TAIL:
-      _buildDatasetProtoTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetProtoTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildDatasetProtoTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DATASET_DESCR;
       continue;
       break; 
@@ -2248,23 +2148,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_datasetDescrQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildDatasetDescrPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDatasetDescrPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
-          /* If this data set descriptor is too big to fit in the buffer, skip it */
-          if(*bufLen == 0)
-          {
-            SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_XML_SIZE_ERROR);
-            curLen = *bufLen;
-            continue;
-          }
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildDatasetDescrPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DATASET_DESCR_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2272,13 +2163,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_DATASET_DESCR_TAIL:
-      _buildDatasetDescrTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetDescrTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildDatasetDescrTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DATASET_DATA;
       continue;
       break; 
@@ -2288,23 +2178,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_datasetQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildDatasetDataPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDatasetDataPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
-          /* If this data set descriptor is too big to fit in the buffer, skip it */
-          if(*bufLen == 0)
-          {
-            SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_XML_SIZE_ERROR);
-            curLen = *bufLen;
-            continue;
-          }
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildDatasetDataPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_DATASET_DATA_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2312,13 +2193,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_DATASET_DATA_TAIL:
-      _buildDatasetDataTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetDataTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildDatasetDataTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_STRING;
       continue;
       break; 
@@ -2328,16 +2208,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_strQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildStringPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildStringPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildStringPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_STRING_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2345,13 +2223,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_STRING_TAIL:
-      _buildStringTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildStringTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildStringTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_VTERM;
       continue;
       break;
@@ -2361,16 +2238,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_vtermQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildVtermPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildVtermPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildVtermPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_VTERM_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2378,13 +2253,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       break;
 
     case SDNPXML_SAVE_VTERM_TAIL:
-      _buildVtermTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildVtermTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildVtermTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
 #if SDNPCNFG_SUPPORT_SA_VERSION5
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_AUTHSECSTAT;
 #else
@@ -2399,16 +2273,14 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
       numPoints= sdnpdata_authSecStatQuantity(pSDNPSession->pDbHandle);
       for(pointNum = pSimDatabase->xmlCurSavePointNum; pointNum < numPoints; pointNum++)
       {
-        _buildAuthSecStatPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_TRUE);
-        if (curLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAuthSecStatPoint(pStream, pSDNPSession->pDbHandle, pointNum);
+        if(!sdnpxmlw_endElement(pStream))
         {
           return SDNPXML_SAVE_NOT_DONE;
         }
-        result = _buildAuthSecStatPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, TMWDEFS_FALSE);
-        *bufLen = curLen;
         pSimDatabase->xmlCurSavePointNum = pointNum+1;
       }
-      *bufLen = curLen;
 #endif
       pSimDatabase->xmlSaveState = SDNPXML_SAVE_TAIL;
       pSimDatabase->xmlCurSavePointNum = 0;
@@ -2417,13 +2289,12 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
 #endif
 
     case SDNPXML_SAVE_TAIL:
-      _buildTail(result, &curLen, TMWDEFS_TRUE);
-      if (curLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildTail(pStream);
+      if(!sdnpxmlw_endElement(pStream))
       {
         return SDNPXML_SAVE_NOT_DONE;
       }
-      result = _buildTail(result, &curLen, TMWDEFS_FALSE);
-      *bufLen = curLen;
       return SDNPXML_SAVE_DONE;
       break;
     }
@@ -2431,178 +2302,52 @@ SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession,
   return(SDNPXML_SAVE_DONE);
 }
 
-TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpxml_saveDatabaseStaticGetSize(TMWSESN *pSession)
+/* routine: sdnpxml_saveDatabaseStatic */
+SDNPXML_SAVE_STATE TMWDEFS_GLOBAL sdnpxml_saveDatabaseStatic(TMWSESN *pSession, TMWTYPES_CHAR *result, TMWTYPES_ULONG maxLen, TMWTYPES_ULONG *bufLen)
 {
   SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
-  TMWTYPES_BOOL bGetLen = TMWDEFS_TRUE;
-  TMWTYPES_ULONG curLen=0;
-  TMWTYPES_USHORT numPoints;
-  TMWTYPES_USHORT pointNum;
-  TMWTYPES_CHAR *result=TMWDEFS_NULL;
-
-  if(pSDNPSession == TMWDEFS_NULL)
-    return(SDNPXML_SAVE_FAILED);
-
-  _buildHeader(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ0
-  numPoints= sdnpdata_deviceAttrQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    TMWTYPES_UCHAR variation = 0;
-    do
-    {
-      _buildDeviceAttrPoint(result,pSDNPSession->pDbHandle, pointNum, &variation, &curLen, bGetLen);
-    } while (variation != 255);
-  }
-#endif
-  _buildDeviceAttrTail(result, &curLen, bGetLen);
-
-#if SDNPDATA_SUPPORT_OBJ1
-  numPoints= sdnpdata_binInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildBinInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildBinInTail(result, &curLen, bGetLen);
+  SDNPSIM_DATABASE *pSimDatabase = (SDNPSIM_DATABASE *)pSDNPSession->pDbHandle;
+  SDNPXML_SAVE_STATE state;
 
-#if SDNPDATA_SUPPORT_OBJ3
-  numPoints= sdnpdata_dblInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildDblBitInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildDblBitInTail(result, &curLen, bGetLen);
+  sdnpxmlw_setBuffer(&pSimDatabase->xmlStream, result, maxLen);
+  state = _saveDatabase(pSDNPSession, &pSimDatabase->xmlStream);
+  *bufLen = pSimDatabase->xmlStream.length;
+  return(state);
+}
 
-#if SDNPDATA_SUPPORT_OBJ12
-  numPoints= sdnpdata_binOutQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    result = _buildBinOutPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildBinOutTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ10
-  numPoints= sdnpdata_binOutQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildBinOutStatusPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildBinOutStatusTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ20
-  numPoints= sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildBinCounterPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildBinCounterTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ21
-  numPoints= sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildFrozenCounterPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildFrozenCounterTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ30
-  numPoints= sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildAnalogInPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildAnalogInTail(result, &curLen, bGetLen);
+/* routine: sdnpxml_saveDatabaseStaticGetSize */
+TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpxml_saveDatabaseStaticGetSize(TMWSESN *pSession)
+{
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPSIM_DATABASE *pSimDatabase;
+  SDNPXML_SAVE_STATE saveState;
+  TMWTYPES_USHORT savePointNum;
+  TMWTYPES_UCHAR saveDAVariation;
+  SDNPXMLW_STREAM stream;
 
-#if SDNPDATA_SUPPORT_OBJ31
-  numPoints = sdnpdata_frznAnlgInQuantity(pSDNPSession->pDbHandle);
-  for (pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildFrznAnalogInPoint(result, pSDNPSession->pDbHandle, pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildFrznAnalogInTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ34
-  numPoints= sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildAnalogInDBandPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildAnalogInDbandTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ40 || SDNPDATA_SUPPORT_OBJ41
-  numPoints= sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildAnalogOutPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildAnalogOutTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ40
-  numPoints= sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildAnalogOutStatusPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildAnalogOutStatusTail(result, &curLen, bGetLen);
+  if(pSDNPSession == TMWDEFS_NULL)
+    return(0);
 
-#if SDNPDATA_SUPPORT_DATASETS
-  numPoints= sdnpdata_datasetProtoQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildDatasetProtoPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  } 
-#endif
-  _buildDatasetProtoTail(result, &curLen, bGetLen);
+  /* Run the writer over the whole profile without a buffer to count its
+   * length, leaving any save in progress as it was
+   */
+  pSimDatabase = (SDNPSIM_DATABASE *)pSDNPSession->pDbHandle;
+  saveState = pSimDatabase->xmlSaveState;
+  savePointNum = pSimDatabase->xmlCurSavePointNum;
+  saveDAVariation = pSimDatabase->xmlCurSaveDAVariation;
 
-#if SDNPDATA_SUPPORT_DATASETS
-  numPoints= sdnpdata_datasetDescrQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildDatasetDescrPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  } 
-#endif
-  _buildDatasetDescrTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_DATASETS
-  numPoints= sdnpdata_datasetQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildDatasetDataPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  } 
-#endif
-  _buildDatasetDataTail(result, &curLen, bGetLen);
+  pSimDatabase->xmlSaveState = SDNPXML_SAVE_HEADER;
+  pSimDatabase->xmlCurSavePointNum = 0;
+  pSimDatabase->xmlCurSaveDAVariation = 0;
+  sdnpxmlw_init(&stream, TMWDEFS_NULL, 0);
+  sdnpxmlw_setBuffer(&stream, TMWDEFS_NULL, 0);
+  _saveDatabase(pSDNPSession, &stream);
 
-#if SDNPDATA_SUPPORT_OBJ110
-  numPoints= sdnpdata_strQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildStringPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildStringTail(result, &curLen, bGetLen);
-  
-#if SDNPDATA_SUPPORT_OBJ112
-  numPoints= sdnpdata_vtermQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildVtermPoint(result,pSDNPSession->pDbHandle,pointNum, &curLen, bGetLen);
-  }
-#endif
-  _buildTail(result, &curLen, TMWDEFS_TRUE);
+  pSimDatabase->xmlSaveState = saveState;
+  pSimDatabase->xmlCurSavePointNum = savePointNum;
+  pSimDatabase->xmlCurSaveDAVariation = saveDAVariation;
 
-  return(curLen);
+  return(stream.length);
 }
 
 void TMWDEFS_GLOBAL sdnpxml_saveDatabaseStaticInit(TMWSESN *pSession)
@@ -2613,6 +2358,7 @@ void TMWDEFS_GLOBAL sdnpxml_saveDatabaseStaticInit(TMWSESN *pSession)
   pSimDatabase->xmlCurSavePointNum = 0;
   pSimDatabase->xmlCurSaveDAVariation = 0;
   pSimDatabase->xmlSaveState = SDNPXML_SAVE_HEADER;
+  sdnpxmlw_init(&pSimDatabase->xmlStream, pSimDatabase->xmlCarry, SDNPCNFG_XML_SAVE_BUF_SIZE);
 }
 
 #endif /* SDNPCNFG_SUPPORT_XML */
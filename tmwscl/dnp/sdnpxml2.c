@@ -37,6 +37,7 @@
 #include "tmwscl/dnp/sdnpxml2.h" 
 #include "tmwscl/dnp/sdnpo070.h"
 #include "tmwscl/dnp/sdnpdiag.h"
+#include "tmwscl/dnp/sdnpxmlw.h"
 #if DNPCNFG_SUPPORT_AUTHENTICATION
 #include "tmwscl/dnp/sdnpauth.h"
 #endif
@@ -46,284 +47,281 @@
 #define SDNPXML_KEYWRAP_PER_USER (TMWTYPES_UCHAR)-1
 
 /* function: _appendString */
-static void TMWDEFS_GLOBAL _appendString(
+static void TMWDEFS_LOCAL _appendString(
   SDNPSESN *pSDNPSession,
-  TMWTYPES_CHAR  *pStr2,
-  TMWTYPES_ULONG *curLen,
-  TMWTYPES_BOOL   bGetLen)
+  TMWTYPES_CHAR  *pStr2)
 {
-  TMWTYPES_UINT length;
-  TMWTYPES_INT i;
-  length = *curLen;
+  SDNPXMLW_STREAM *pStream = &pSDNPSession->xml2Stream;
 
-  if (bGetLen == TMWDEFS_FALSE)
-  { 
-    for(i=0; i<pSDNPSession->xml2CurIndent;i++)
-    {
-      int j;
-      for(j=0; j<pSDNPSession->xml2IndentSize; j++)
-        pSDNPSession->pXml2Buffer[length++] = (TMWTYPES_CHAR)0x20; 
-    }
-    /* null terminate after indent was added */
-    pSDNPSession->pXml2Buffer[length] = (TMWTYPES_CHAR)0;
+  sdnpxmlw_writeSpaces(pStream, (TMWTYPES_ULONG)(pSDNPSession->xml2CurIndent*pSDNPSession->xml2IndentSize));
+  sdnpxmlw_write(pStream, pStr2, (TMWTYPES_ULONG)strlen(pStr2));
+} 
 
-    strcat(pSDNPSession->pXml2Buffer, pStr2);
-  }
-  else
+/* function: _endElement
+ *  finish an element, if it did not fit put the indent back to where the
+ *  element started so it is built the same way in the next block
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _endElement(
+  SDNPSESN *pSDNPSession,
+  TMWTYPES_UCHAR saveIndent)
+{
+  if(!sdnpxmlw_endElement(&pSDNPSession->xml2Stream))
   {
-    length += (pSDNPSession->xml2CurIndent*pSDNPSession->xml2IndentSize);
+    pSDNPSession->xml2CurIndent = saveIndent;
+    return(TMWDEFS_FALSE);
   }
-  *curLen = length + (TMWTYPES_ULONG)strlen(pStr2);
-} 
+  return(TMWDEFS_TRUE);
+}
+
 
 /* _valueString */
-static void _valueString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _valueString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[512];
   if((pValue != TMWDEFS_NULL) && (*pValue != 0))
   {
     tmwtarg_snprintf(buf, sizeof(buf), "<%s>%s</%s>\n", pName, pValue, pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);  
+    _appendString(pSDNPSession, buf);  
   }
 }
 
 /* _currentValueString */
-static void _currentValueString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[300];
 
   if(pName != TMWDEFS_NULL)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
  
   tmwtarg_snprintf(buf, sizeof(buf), "<currentValue>%s</currentValue>\n", pValue);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen);  
+  _appendString(pSDNPSession, buf);  
   pSDNPSession->xml2CurIndent--;
 
   if(pName != TMWDEFS_NULL)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
 }
 
 /* _currentValueNameString */
-static void _currentValueNameString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValueName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueNameString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValueName, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[512]; 
 
   if(pName != TMWDEFS_NULL)
   { 
     tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
  
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<currentValue>\n");  
 
   tmwtarg_snprintf(buf, sizeof(buf), "<%s>%s</%s>\n", pValueName, pValue, pValueName);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen);  
+  _appendString(pSDNPSession, buf);  
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</currentValue>\n");  
 
   if(pName != TMWDEFS_NULL)
   { 
     tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
 }
 
 /* _currentValueValueString */
-static void _currentValueValueString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueValueString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue)
 {
-  _currentValueNameString(pSDNPSession, pName, "value", pValue, curLen, bGetLen); 
+  _currentValueNameString(pSDNPSession, pName, "value", pValue); 
 }
  
 /* _currentValueNameDecimalString */
-static void _currentValueNameDecimalString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValueName, TMWTYPES_ULONG value, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueNameDecimalString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValueName, TMWTYPES_ULONG value)
 {  
   TMWTYPES_CHAR buf[512]; 
 
   if(pName != TMWDEFS_NULL)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   } 
   
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<currentValue>\n");  
 
   tmwtarg_snprintf(buf, sizeof(buf), "<%s>%d</%s>\n", pValueName, value, pValueName);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen);  
+  _appendString(pSDNPSession, buf);  
 
     pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</currentValue>\n");
 
   if(pName != TMWDEFS_NULL)
   { 
     tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
 }
 
 #if SDNPDATA_SUPPORT_OBJ10  
 #if TMWCNFG_SUPPORT_DOUBLE
 /* _currentValueNameFloatString */
-static void _currentValueNameFloatString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValueName, TMWTYPES_DOUBLE value, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueNameFloatString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValueName, TMWTYPES_DOUBLE value)
 {  
   TMWTYPES_CHAR buf[512]; 
 
   if(pName != TMWDEFS_NULL)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   } 
   
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<currentValue>\n");  
 
   tmwtarg_snprintf(buf, sizeof(buf), "<%s>%g</%s>\n", pValueName, value, pValueName);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen);  
+  _appendString(pSDNPSession, buf);  
 
     pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</currentValue>\n");
 
   if(pName != TMWDEFS_NULL)
   { 
     tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
 }
 #endif
 #endif
 
 /* _currentValueDecimalString */
-static void _currentValueDecimalString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_ULONG value, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueDecimalString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_ULONG value)
 {
-  _currentValueNameDecimalString(pSDNPSession, pName, "value", value, curLen, bGetLen);
+  _currentValueNameDecimalString(pSDNPSession, pName, "value", value);
 }
 
 /* _valueOther */
-static void _valueOther(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _valueOther(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[300];
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<other>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<other>\n"); 
  
   tmwtarg_snprintf(buf, sizeof(buf), "<explanation>%s</explanation>\n", pValue);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</other>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</other>\n");  
   pSDNPSession->xml2CurIndent--;
 }
 
 /* _currentValueOther */
-static void _currentValueOther(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueOther(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[300];
 
   if(pName != TMWDEFS_NULL)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);;
-    _appendString(pSDNPSession, buf, curLen, bGetLen); 
+    _appendString(pSDNPSession, buf); 
   }
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<currentValue>\n"); 
  
-  _valueOther(pSDNPSession, pValue, curLen, bGetLen);
+  _valueOther(pSDNPSession, pValue);
 
-  _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</currentValue>\n"); 
   
   if(pName != TMWDEFS_NULL)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);;
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, buf, curLen, bGetLen); 
+    _appendString(pSDNPSession, buf); 
   }
 }
 
 /* _currentValueCustom */
-static void _currentValueCustom(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueCustom(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[300];
   
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<currentValue>\n"); 
 
   tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);;
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
 
   tmwtarg_snprintf(buf, sizeof(buf), "<explanation>%s</explanation>\n", pValue);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
 
   tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);;
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</currentValue>\n"); 
   pSDNPSession->xml2CurIndent--;
 }
 
 /* _currentValueConfigCustom, both notConfigurableCustomType and configurableCustomeType */
-static void _currentValueConfigCustom(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _currentValueConfigCustom(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_CHAR *pValue)
 {
   TMWTYPES_CHAR buf[300];
   
   tmwtarg_snprintf(buf, sizeof(buf), "<%s>\n", pName);;
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<currentValue>\n"); 
   
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<other>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<other>\n"); 
 
   tmwtarg_snprintf(buf, sizeof(buf), "<description>%s</description>\n", pValue);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</other>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</other>\n"); 
   pSDNPSession->xml2CurIndent--;
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</currentValue>\n"); 
   pSDNPSession->xml2CurIndent--;
 
   tmwtarg_snprintf(buf, sizeof(buf), "</%s>\n", pName);;
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
   
 }
 
 /* function: _boolString */
-static void _boolString(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen, TMWTYPES_CHAR *pName, TMWTYPES_BOOL value)
+static void _boolString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_BOOL value)
 {
   TMWTYPES_CHAR buf[512];
   tmwtarg_snprintf(buf, sizeof(buf), "<%s>%s</%s>\n", pName, value ? "true" : "false", pName);
-   _appendString(pSDNPSession, buf, curLen, bGetLen);
+   _appendString(pSDNPSession, buf);
 } 
 
 /* function: _assertedString */
-static void _assertedString(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen, TMWTYPES_CHAR *pName, SDNPDATA_XML_ASSERTEDTYPE value)
+static void _assertedString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, SDNPDATA_XML_ASSERTEDTYPE value)
 {
   TMWTYPES_CHAR buf[256];
   if(value == SDNPDATA_XML_ASSERTED_ASSERTED)
@@ -333,17 +331,17 @@ static void _assertedString(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWT
   else
     return;
 
-  _appendString(pSDNPSession, buf, curLen, bGetLen);
+  _appendString(pSDNPSession, buf);
 } 
 
 /* function: _emptyElementString */
-static void _emptyElementString(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen, TMWTYPES_CHAR *pName, TMWTYPES_BOOL value)
+static void _emptyElementString(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, TMWTYPES_BOOL value)
 {
   TMWTYPES_CHAR buf[256];
   if(value)
   {
     tmwtarg_snprintf(buf, sizeof(buf), "<%s />\n", pName);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
   }
 } 
  
@@ -852,7 +850,7 @@ static TMWTYPES_CHAR * _variationString(TMWTYPES_UCHAR value)
 }
 
 
-static void  _pointListDefinition(SDNPSESN *pSDNPSession, DNPDEFS_OBJ_GROUP_ID objectGroup, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void  _pointListDefinition(SDNPSESN *pSDNPSession, DNPDEFS_OBJ_GROUP_ID objectGroup)
 {
   TMWTYPES_CHAR *pName;
   TMWTYPES_CHAR buf[100];
@@ -879,25 +877,25 @@ static void  _pointListDefinition(SDNPSESN *pSDNPSession, DNPDEFS_OBJ_GROUP_ID o
   }
   
   tmwtarg_snprintf(buf, sizeof(buf), "<%s />\n", pName);;
-  _appendString(pSDNPSession, buf, curLen, bGetLen); 
+  _appendString(pSDNPSession, buf); 
 }
 
 /* outstationPerformance _timingPerformanceType */
-static void _timingPerformanceType(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, SDNPDATA_TIMINGPERFORMANCETYPE *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _timingPerformanceType(SDNPSESN *pSDNPSession, TMWTYPES_CHAR *pName, SDNPDATA_TIMINGPERFORMANCETYPE *pValue)
 { 
   if(pValue->type == SDNPDATA_XML_TIMINGPERFVALUE)
   { 
-    _currentValueDecimalString(pSDNPSession, pName, pValue->value.value, curLen, bGetLen);   
+    _currentValueDecimalString(pSDNPSession, pName, pValue->value.value);   
   }
 
   else if(pValue->type == SDNPDATA_XML_TIMINGPERFOTHER)
   { 
-    _currentValueConfigCustom(pSDNPSession, pName,  pValue->value.other, curLen, bGetLen);
+    _currentValueConfigCustom(pSDNPSession, pName,  pValue->value.other);
   }  
 }
 
 /*  deviceConfig xmlFile */
-static void _xmlFileString(SDNPSESN *pSDNPSession, SDNPDATA_XMLFILETYPE *pValue, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _xmlFileString(SDNPSESN *pSDNPSession, SDNPDATA_XMLFILETYPE *pValue)
 { 
   /* note
      readAccess 
@@ -908,106 +906,106 @@ static void _xmlFileString(SDNPSESN *pSDNPSession, SDNPDATA_XMLFILETYPE *pValue,
  
   if(pValue->filename[0] != 0)
   {
-    _appendString(pSDNPSession, "<xmlFile>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<xmlFile>\n");  
 
     pSDNPSession->xml2CurIndent++;
-     _valueString(pSDNPSession, "note", pValue->note, curLen, bGetLen); 
-    _boolString(pSDNPSession, curLen, bGetLen, "readAccess", pValue->readAccess);
-    _boolString(pSDNPSession, curLen, bGetLen, "writeAccess", pValue->writeAccess);
-     _valueString(pSDNPSession, "filename", pValue->filename, curLen, bGetLen); 
-     _valueString(pSDNPSession, "description", pValue->description, curLen, bGetLen); 
+     _valueString(pSDNPSession, "note", pValue->note); 
+    _boolString(pSDNPSession, "readAccess", pValue->readAccess);
+    _boolString(pSDNPSession, "writeAccess", pValue->writeAccess);
+     _valueString(pSDNPSession, "filename", pValue->filename); 
+     _valueString(pSDNPSession, "description", pValue->description); 
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</xmlFile>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</xmlFile>\n");  
   }
 }
  
 /* function: _buildDocHeader */
-static void TMWDEFS_LOCAL _buildDocHeader(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDocHeader(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n", curLen, bGetLen);
-  _appendString(pSDNPSession, "<?xml-stylesheet type=\"text/xsl\" href=\"DNP3DeviceProfileApril2016.xslt\" media=\"screen\"?>\n", curLen, bGetLen);  
-  _appendString(pSDNPSession, "<DNP3DeviceProfileDocument schemaVersion=\"2.11.00\" xmlns=\"http://www.dnp3.org/DNP3/DeviceProfile/April2016\"\n", curLen, bGetLen);
-  _appendString(pSDNPSession, "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n", curLen, bGetLen); 
-  _appendString(pSDNPSession, "xsi:schemaLocation=\"http://www.dnp3.org/DNP3/DeviceProfile/April2016 DNP3DeviceProfileApril2016.xsd\">\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n");
+  _appendString(pSDNPSession, "<?xml-stylesheet type=\"text/xsl\" href=\"DNP3DeviceProfileApril2016.xslt\" media=\"screen\"?>\n");  
+  _appendString(pSDNPSession, "<DNP3DeviceProfileDocument schemaVersion=\"2.11.00\" xmlns=\"http://www.dnp3.org/DNP3/DeviceProfile/April2016\"\n");
+  _appendString(pSDNPSession, "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"); 
+  _appendString(pSDNPSession, "xsi:schemaLocation=\"http://www.dnp3.org/DNP3/DeviceProfile/April2016 DNP3DeviceProfileApril2016.xsd\">\n");
   pSDNPSession->xml2CurIndent++;
 
   /* Added documentType in schema 2.11 */
-  _appendString(pSDNPSession, "<documentHeader>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<documentHeader>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<documentDescription>Generated by Outstation</documentDescription>\n", curLen, bGetLen);
-  _appendString(pSDNPSession, "<documentType>Configuration</documentType>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<documentDescription>Generated by Outstation</documentDescription>\n");
+  _appendString(pSDNPSession, "<documentType>Configuration</documentType>\n");
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</documentHeader>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</documentHeader>\n");
 
-  _appendString(pSDNPSession, "<referenceDevice>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<referenceDevice>\n");
 }
  
 /* function: _buildDocTail */
-static void TMWDEFS_LOCAL _buildDocTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDocTail(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</referenceDevice>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</referenceDevice>\n");
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</DNP3DeviceProfileDocument>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</DNP3DeviceProfileDocument>\n");
 }
 
 /* function: _buildConfigurationHeader */
-static void TMWDEFS_LOCAL _buildConfigurationHeader(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildConfigurationHeader(SDNPSESN *pSDNPSession)
 {  
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
 }
 
 /* function: _buildConfigurationTail */
-static void TMWDEFS_LOCAL _buildConfigurationTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildConfigurationTail(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 }
 
 /* function: _buildDatabaseHeader */
-static void TMWDEFS_LOCAL _buildDatabaseHeader(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatabaseHeader(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "<database>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<database>\n");
 }
 
 /* function: _buildDatabaseTail */
-static void TMWDEFS_LOCAL _buildDatabaseTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatabaseTail(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "</database>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</database>\n");
 }
 
 /* function: _buildDataPointsListHeader */
-static void TMWDEFS_LOCAL _buildDataPointsListHeader(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDataPointsListHeader(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "<dataPointsList>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<dataPointsList>\n");
 }
 
 /* function: _buildDataPointsListTail */
-static void TMWDEFS_LOCAL _buildDataPointsListTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDataPointsListTail(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "</dataPointsList>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</dataPointsList>\n");
 }
 
 /* function: _putInputPointType */
-static void _putInputPointType(SDNPSESN *pSDNPSession, TMWDEFS_CLASS_MASK classMask, TMWTYPES_BOOL class0, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _putInputPointType(SDNPSESN *pSDNPSession, TMWDEFS_CLASS_MASK classMask, TMWTYPES_BOOL class0)
 {
-  _valueString(pSDNPSession, "changeEventClass", _classMaskString(classMask), curLen, bGetLen);  
-  _valueString(pSDNPSession, "includedInClass0Response", _class0ResponseString(class0), curLen, bGetLen);   
+  _valueString(pSDNPSession, "changeEventClass", _classMaskString(classMask));  
+  _valueString(pSDNPSession, "includedInClass0Response", _class0ResponseString(class0));   
 }
 
 /* function: _putOutputPointType */
-static void _putOutputPointType(SDNPSESN *pSDNPSession, TMWDEFS_CLASS_MASK eventClassMask, TMWDEFS_CLASS_MASK cmdClassMask, TMWTYPES_BOOL class0, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _putOutputPointType(SDNPSESN *pSDNPSession, TMWDEFS_CLASS_MASK eventClassMask, TMWDEFS_CLASS_MASK cmdClassMask, TMWTYPES_BOOL class0)
 { 
-  _valueString(pSDNPSession, "changeEventClass", _classMaskString(eventClassMask), curLen, bGetLen);  
-  _valueString(pSDNPSession, "commandEventClass", _classMaskString(cmdClassMask), curLen, bGetLen);  
-  _valueString(pSDNPSession, "includedInClass0Response", _class0ResponseString(class0), curLen, bGetLen);   
+  _valueString(pSDNPSession, "changeEventClass", _classMaskString(eventClassMask));  
+  _valueString(pSDNPSession, "commandEventClass", _classMaskString(cmdClassMask));  
+  _valueString(pSDNPSession, "includedInClass0Response", _class0ResponseString(class0));   
  }
 
 #if SDNPDATA_SUPPORT_OBJ1
 /* function: _buildBinInPoint */
-static void TMWDEFS_LOCAL _buildBinInPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinInPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint;
   SDNPDATA_XML_BININPOINTCONFIG *pConfig;
@@ -1027,11 +1025,11 @@ static void TMWDEFS_LOCAL _buildBinInPoint(SDNPSESN *pSDNPSession, void *pDbHand
     classMask = sdnpdata_binInEventClass(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<binaryInput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<binaryInput>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
  
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetBinInPointConfig(pPoint, &config))
@@ -1039,13 +1037,13 @@ static void TMWDEFS_LOCAL _buildBinInPoint(SDNPSESN *pSDNPSession, void *pDbHand
       pConfig = &config;
 
       /* name */   
-      _valueString(pSDNPSession, "name", pConfig->name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", pConfig->name);   
     }
     else
       pConfig = TMWDEFS_NULL;
 
     /* description */ 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);   
+    _valueString(pSDNPSession, "description", pDesc);   
 
     /* inputPointType contains changeEventClass and includedInClass0Response */
 #if SDNPDATA_SUPPORT_CLASS0_POINT
@@ -1054,59 +1052,59 @@ static void TMWDEFS_LOCAL _buildBinInPoint(SDNPSESN *pSDNPSession, void *pDbHand
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _putInputPointType(pSDNPSession, classMask, pointInClass0, curLen, bGetLen);
+    _putInputPointType(pSDNPSession, classMask, pointInClass0);
 #else
-    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_1_BIN_INPUTS), curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_1_BIN_INPUTS));  
 #endif
 
     if(pSDNPSession->obj01DefaultVariation == 0) 
     {
-      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_binInDefVariation(pPoint)), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_binInDefVariation(pPoint)));
     }
     else
     {
-      _valueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj01DefaultVariation), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj01DefaultVariation));
     }
 
 #if SDNPDATA_SUPPORT_OBJ2
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     if(pSDNPSession->obj02DefaultVariation == 0) 
     { 
-      _valueString(pSDNPSession, "defaultEventVariation", _variationString(sdnpdata_binInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultEventVariation", _variationString(sdnpdata_binInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL))); 
     }
     else
     {
-      _valueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj02DefaultVariation), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj02DefaultVariation));
     }
 #endif
 #endif
 
     if(pConfig != TMWDEFS_NULL)
     {
-      _valueString(pSDNPSession, "nameState0", pConfig->nameState0, curLen, bGetLen);
-      _valueString(pSDNPSession, "nameState1", pConfig->nameState1, curLen, bGetLen);
+      _valueString(pSDNPSession, "nameState0", pConfig->nameState0);
+      _valueString(pSDNPSession, "nameState1", pConfig->nameState1);
     }
 
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
     if(pSDNPSession->xml2WriteDnpData)
     {
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
 
        pSDNPSession->xml2CurIndent++;
-      _valueString(pSDNPSession, "state", _binStateString(flags), curLen, bGetLen);
+      _valueString(pSDNPSession, "state", _binStateString(flags));
 
       tmwtarg_snprintf(buf, sizeof(buf), "<quality>%d</quality>\n", flags&0x7f);  
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
       
       /* NotSupported timestamp */
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</binaryInput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</binaryInput>\n");
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -1114,7 +1112,7 @@ static void TMWDEFS_LOCAL _buildBinInPoint(SDNPSESN *pSDNPSession, void *pDbHand
 
 #if SDNPDATA_SUPPORT_OBJ3
 /* function: _buildDblBitInPoint */
-static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint;
   SDNPDATA_XML_DBLINPOINTCONFIG *pConfig;
@@ -1134,11 +1132,11 @@ static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPSESN *pSDNPSession, void *pDbH
     classMask = sdnpdata_dblInEventClass(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<doubleBitInput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<doubleBitInput>\n");
 
     pSDNPSession->xml2CurIndent++;
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
-    _appendString(pSDNPSession, buf, curLen, bGetLen); 
+    _appendString(pSDNPSession, buf); 
     
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetDblInPointConfig(pPoint, &config))
@@ -1146,13 +1144,13 @@ static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPSESN *pSDNPSession, void *pDbH
       pConfig = &config;
 
       /* name */   
-      _valueString(pSDNPSession, "name", pConfig->name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", pConfig->name);   
     }
     else
       pConfig = TMWDEFS_NULL;
 
     /* description */ 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);   
+    _valueString(pSDNPSession, "description", pDesc);   
     
     /* inputPointType contains changeEventClass and includedInClass0Response */ 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
@@ -1161,61 +1159,61 @@ static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPSESN *pSDNPSession, void *pDbH
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _putInputPointType(pSDNPSession, classMask, pointInClass0, curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, pointInClass0);  
 #else
-    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_3_DBL_INPUTS), curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_3_DBL_INPUTS));  
 #endif
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     if(pSDNPSession->obj03DefaultVariation == 0) 
     { 
-      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_dblInDefVariation(pPoint)), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_dblInDefVariation(pPoint))); 
     }
     else
     {
-      _valueString(pSDNPSession, "defaultStaticVariation", _variationGroupString(pSDNPSession->obj03DefaultVariation), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultStaticVariation", _variationGroupString(pSDNPSession->obj03DefaultVariation));
     } 
 #if SDNPDATA_SUPPORT_OBJ4
     if(pSDNPSession->obj04DefaultVariation == 0) 
     { 
-      _valueString(pSDNPSession, "defaultEventVariation", _variationString(sdnpdata_dblInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultEventVariation", _variationString(sdnpdata_dblInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL))); 
     }
     else
     {
-      _valueString(pSDNPSession, "defaultEventVariation", _variationGroupString(pSDNPSession->obj04DefaultVariation), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultEventVariation", _variationGroupString(pSDNPSession->obj04DefaultVariation)); 
     }
 #endif
 #endif
 
     if(pConfig != TMWDEFS_NULL)
     {
-      _valueString(pSDNPSession, "nameState0", pConfig->nameState0, curLen, bGetLen);
-      _valueString(pSDNPSession, "nameState1", pConfig->nameState1, curLen, bGetLen);
-      _valueString(pSDNPSession, "nameState2", pConfig->nameState2, curLen, bGetLen); 
-      _valueString(pSDNPSession, "nameState3", pConfig->nameState3, curLen, bGetLen);
+      _valueString(pSDNPSession, "nameState0", pConfig->nameState0);
+      _valueString(pSDNPSession, "nameState1", pConfig->nameState1);
+      _valueString(pSDNPSession, "nameState2", pConfig->nameState2); 
+      _valueString(pSDNPSession, "nameState3", pConfig->nameState3);
     }
 
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
     if(pSDNPSession->xml2WriteDnpData)
     {
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
 
       tmwtarg_snprintf(buf, sizeof(buf), "<state>%d</state>\n", (flags&0xc0)>>6);
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<quality>%d</quality>\n", flags&0x3f);  
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
      
       /* NotSupported timestamp */
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</doubleBitInput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</doubleBitInput>\n");
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -1223,7 +1221,7 @@ static void TMWDEFS_LOCAL _buildDblBitInPoint(SDNPSESN *pSDNPSession, void *pDbH
 
 #if SDNPDATA_SUPPORT_OBJ10 
 /* function: _buildBinOutPoint */
-static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint; 
   SDNPDATA_XML_BINOUTPOINTCONFIG *pConfig;
@@ -1250,11 +1248,11 @@ static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHan
     classMask2 = sdnpdata_binOutCmdEventClass(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<binaryOutput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<binaryOutput>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
       
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetBinOutPointConfig(pPoint, &config))
@@ -1262,13 +1260,13 @@ static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHan
       pConfig = &config;
 
       /* name */   
-      _valueString(pSDNPSession, "name", pConfig->name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", pConfig->name);   
     }
     else
       pConfig = TMWDEFS_NULL;
 
     /* description */ 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);   
+    _valueString(pSDNPSession, "description", pDesc);   
 
     /* outputPointType contains changeEventClass, commandEventClass, includedInClass0Response*/
 #if SDNPDATA_SUPPORT_CLASS0_POINT
@@ -1277,40 +1275,40 @@ static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHan
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _putOutputPointType(pSDNPSession, classMask1, classMask2, pointInClass0, curLen, bGetLen);  
+    _putOutputPointType(pSDNPSession, classMask1, classMask2, pointInClass0);  
 #else
-    _putOutputPointType(pSDNPSession, classMask1, classMask2, _class0Response(pSDNPSession, DNPDEFS_OBJ_10_BIN_OUT_STATUSES), curLen, bGetLen);  
+    _putOutputPointType(pSDNPSession, classMask1, classMask2, _class0Response(pSDNPSession, DNPDEFS_OBJ_10_BIN_OUT_STATUSES));  
 #endif
 
     if(pSDNPSession->obj10DefaultVariation == 0) 
     {
-      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_binOutDefVariation(pPoint)), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_binOutDefVariation(pPoint)));
     }
     else
     {
-      _valueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj10DefaultVariation), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj10DefaultVariation));
     }
 
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
 #if SDNPDATA_SUPPORT_OBJ11
     if(pSDNPSession->obj11DefaultVariation == 0) 
     {
-      _valueString(pSDNPSession, "defaultChangeEventVariation",  _variationString(sdnpdata_binOutEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen);   
+      _valueString(pSDNPSession, "defaultChangeEventVariation",  _variationString(sdnpdata_binOutEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)));   
     }
     else
     {
-      _valueString(pSDNPSession, "defaultChangeEventVariation",  _variationGroupString(pSDNPSession->obj11DefaultVariation), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultChangeEventVariation",  _variationGroupString(pSDNPSession->obj11DefaultVariation));
     }
 #endif
     
 #if SDNPDATA_SUPPORT_OBJ13
     if(pSDNPSession->obj13DefaultVariation == 0) 
     {
-      _valueString(pSDNPSession, "defaultCommandEventVariation", _variationString(sdnpdata_binOutCmdEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen);   
+      _valueString(pSDNPSession, "defaultCommandEventVariation", _variationString(sdnpdata_binOutCmdEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)));   
     }
     else
     {
-      _valueString(pSDNPSession, "defaultCommandEventVariation",  _variationGroupString(pSDNPSession->obj13DefaultVariation), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultCommandEventVariation",  _variationGroupString(pSDNPSession->obj13DefaultVariation));
     }
 #endif
 #endif
@@ -1318,68 +1316,68 @@ static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHan
     if(pConfig != TMWDEFS_NULL)
     {
       tmwtarg_snprintf(buf, sizeof(buf), "<minimumPulseWidth>%g</minimumPulseWidth>\n", pConfig->minimumPulseWidth);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<maximumPulseWidth>%g</maximumPulseWidth>\n", pConfig->maximumPulseWidth);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
     }
 
-    _appendString(pSDNPSession, "<supportedControlOperations>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<supportedControlOperations>\n");
     pSDNPSession->xml2CurIndent++;
 
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportSelectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_SELOP));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportDirectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIROP));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportDirectOperateNoAck", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIRNOACK));
+    _emptyElementString(pSDNPSession, "supportSelectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_SELOP));
+    _emptyElementString(pSDNPSession, "supportDirectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIROP));
+    _emptyElementString(pSDNPSession, "supportDirectOperateNoAck", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIRNOACK));
 
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportPulseOn", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PULSE_ON));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportPulseOff", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PULSE_OFF));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportLatchOn", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_LATCH_ON));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportLatchOff", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_LATCH_OFF));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportTrip", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PAIRED_TRIP));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportClose", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PAIRED_CLOSE));
+    _emptyElementString(pSDNPSession, "supportPulseOn", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PULSE_ON));
+    _emptyElementString(pSDNPSession, "supportPulseOff", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PULSE_OFF));
+    _emptyElementString(pSDNPSession, "supportLatchOn", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_LATCH_ON));
+    _emptyElementString(pSDNPSession, "supportLatchOff", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_LATCH_OFF));
+    _emptyElementString(pSDNPSession, "supportTrip", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PAIRED_TRIP));
+    _emptyElementString(pSDNPSession, "supportClose", TMWDEFS_TOBOOL(ctrlMask, SDNPDATA_CROB_CTRL_PAIRED_CLOSE));
 
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "countGreaterThanOne", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_MORE_ONE));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "cancelCurrentOperation", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_SEL_CANCEL));
+    _emptyElementString(pSDNPSession, "countGreaterThanOne", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_MORE_ONE));
+    _emptyElementString(pSDNPSession, "cancelCurrentOperation", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_SEL_CANCEL));
  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</supportedControlOperations>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</supportedControlOperations>\n");
      
     tmwtarg_snprintf(buf, sizeof(buf), "<maxTimeSelectOperate>%d</maxTimeSelectOperate>\n", pSDNPSession->selectTimeout);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     if(pConfig != TMWDEFS_NULL)
     {
-      _valueString(pSDNPSession, "nameState0", pConfig->nameState0, curLen, bGetLen);    
-      _valueString(pSDNPSession, "nameState1", pConfig->nameState1, curLen, bGetLen);    
+      _valueString(pSDNPSession, "nameState0", pConfig->nameState0);    
+      _valueString(pSDNPSession, "nameState1", pConfig->nameState1);    
     }
 
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
     if(pSDNPSession->xml2WriteDnpData)
     {
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
  
       pSDNPSession->xml2CurIndent++;
-      _valueString(pSDNPSession, "state",_binStateString(flags), curLen, bGetLen);
+      _valueString(pSDNPSession, "state",_binStateString(flags));
 
       tmwtarg_snprintf(buf, sizeof(buf), "<quality>%d</quality>\n", flags&0x3f);  
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
       
       /* NotSupported timestamp */
 
       /* control */ 
       tmwtarg_snprintf(buf, sizeof(buf), "<control>%d</control>\n", pConfig->control);  
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       /* status */ 
-      _valueString(pSDNPSession, "status", _toControlStatus(pConfig->status), curLen, bGetLen);     
+      _valueString(pSDNPSession, "status", _toControlStatus(pConfig->status));     
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</binaryOutput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</binaryOutput>\n");
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -1387,7 +1385,7 @@ static void TMWDEFS_LOCAL _buildBinOutPoint(SDNPSESN *pSDNPSession, void *pDbHan
    
 #if SDNPDATA_SUPPORT_OBJ20 
 /* function: _buildCounterPoint */
-static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint; 
   void *pFrznPoint; 
@@ -1409,11 +1407,11 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
     classMask = sdnpdata_binCntrEventClass(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<counter>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<counter>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetCntrPointConfig(pPoint, &config))
@@ -1421,22 +1419,22 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
       pConfig = &config;
 
       /* name */   
-      _valueString(pSDNPSession, "name", pConfig->name, curLen, bGetLen);    
+      _valueString(pSDNPSession, "name", pConfig->name);    
     }
     else
       pConfig = TMWDEFS_NULL;
 
     /* description */ 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);   
+    _valueString(pSDNPSession, "description", pDesc);   
     
     if(pSDNPSession->obj20DefaultVariation == 0)
     {
-      _valueString(pSDNPSession, "defaultCounterStaticVariation", _variationString(sdnpdata_binCntrDefVariation(pPoint)), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultCounterStaticVariation", _variationString(sdnpdata_binCntrDefVariation(pPoint))); 
     }
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
     if(pSDNPSession->obj22DefaultVariation == 0)
     {
-      _valueString(pSDNPSession, "defaultCounterEventVariation", _variationString(sdnpdata_binCntrEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultCounterEventVariation", _variationString(sdnpdata_binCntrEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL))); 
     }
 #endif
 
@@ -1446,45 +1444,45 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _valueString(pSDNPSession, "countersIncludedInClass0", _class0ResponseString(pointInClass0), curLen, bGetLen);   
+    _valueString(pSDNPSession, "countersIncludedInClass0", _class0ResponseString(pointInClass0));   
 #else
-    _valueString(pSDNPSession, "countersIncludedInClass0", _class0ResponseString(_class0Response(pSDNPSession, DNPDEFS_OBJ_20_RUNNING_CNTRS)), curLen, bGetLen);    
+    _valueString(pSDNPSession, "countersIncludedInClass0", _class0ResponseString(_class0Response(pSDNPSession, DNPDEFS_OBJ_20_RUNNING_CNTRS)));    
 #endif
 
-    _valueString(pSDNPSession, "counterEventClass", _classMaskString(classMask), curLen, bGetLen);  
+    _valueString(pSDNPSession, "counterEventClass", _classMaskString(classMask));  
 
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
     /* schema 2.11 added counterEventReportMode */
     if (pSDNPSession->binaryCounterEventMode == TMWDEFS_EVENT_MODE_PER_POINT)
     {
-      _valueString(pSDNPSession, "counterEventReportMode", _anlgReportingModeString(sdnpdata_binCntrEventMode(pPoint)), curLen, bGetLen);
+      _valueString(pSDNPSession, "counterEventReportMode", _anlgReportingModeString(sdnpdata_binCntrEventMode(pPoint)));
     }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ21
     pFrznPoint = sdnpdata_frznCntrGetPoint(pDbHandle, pointNum); 
-    _boolString(pSDNPSession, curLen, bGetLen, "frozenCounterExists", (pFrznPoint != TMWDEFS_NULL) ? TMWDEFS_TRUE:TMWDEFS_FALSE);
+    _boolString(pSDNPSession, "frozenCounterExists", (pFrznPoint != TMWDEFS_NULL) ? TMWDEFS_TRUE:TMWDEFS_FALSE);
 
     if(pFrznPoint != TMWDEFS_NULL)
     {
       if(pSDNPSession->obj21DefaultVariation == 0)
       {
-        _valueString(pSDNPSession, "defaultFrozenCounterStaticVariation", _variationString(sdnpdata_frznCntrDefVariation(pFrznPoint)), curLen, bGetLen);   
+        _valueString(pSDNPSession, "defaultFrozenCounterStaticVariation", _variationString(sdnpdata_frznCntrDefVariation(pFrznPoint)));   
       }
       else
       {
-        _valueString(pSDNPSession, "defaultFrozenCounterStaticVariation",  _variationGroupString(pSDNPSession->obj21DefaultVariation), curLen, bGetLen); 
+        _valueString(pSDNPSession, "defaultFrozenCounterStaticVariation",  _variationGroupString(pSDNPSession->obj21DefaultVariation)); 
       }
 
 #if SDNPDATA_SUPPORT_OBJ23
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
       if(pSDNPSession->obj23DefaultVariation == 0)
       {
-        _valueString(pSDNPSession, "defaultFrozenCounterEventVariation", _variationString(sdnpdata_frznCntrEventDefVariation(pFrznPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen); 
+        _valueString(pSDNPSession, "defaultFrozenCounterEventVariation", _variationString(sdnpdata_frznCntrEventDefVariation(pFrznPoint, TMWDEFS_CLASS_MASK_ALL))); 
       }
       else
       {
-        _valueString(pSDNPSession, "defaultFrozenCounterEventVariation",  _variationGroupString(pSDNPSession->obj23DefaultVariation), curLen, bGetLen); 
+        _valueString(pSDNPSession, "defaultFrozenCounterEventVariation",  _variationGroupString(pSDNPSession->obj23DefaultVariation)); 
       }
 #endif
 #endif
@@ -1495,19 +1493,19 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
       {
         pointInClass0 = TMWDEFS_TRUE;
       }
-      _valueString(pSDNPSession, "frozenCountersIncludedInClass0", _class0ResponseString(pointInClass0), curLen, bGetLen);   
+      _valueString(pSDNPSession, "frozenCountersIncludedInClass0", _class0ResponseString(pointInClass0));   
 #else
-      _valueString(pSDNPSession, "frozenCountersIncludedInClass0", _class0ResponseString(_class0Response(pSDNPSession, DNPDEFS_OBJ_21_FROZEN_CNTRS)), curLen, bGetLen);    
+      _valueString(pSDNPSession, "frozenCountersIncludedInClass0", _class0ResponseString(_class0Response(pSDNPSession, DNPDEFS_OBJ_21_FROZEN_CNTRS)));    
 #endif
       
 #if SDNPDATA_SUPPORT_OBJ23
-      _valueString(pSDNPSession, "frozenCounterEventClass", _classMaskString(classMask), curLen, bGetLen);  
+      _valueString(pSDNPSession, "frozenCounterEventClass", _classMaskString(classMask));  
 #endif
 #if SDNPDATA_SUPPORT_EVENT_MODE_POINT
       /* schema 2.11 added frozenCounterEventReportMode */
       if (pSDNPSession->frozenCounterEventMode == TMWDEFS_EVENT_MODE_PER_POINT)
       {
-        _valueString(pSDNPSession, "frozenCounterEventReportMode", _anlgReportingModeString(sdnpdata_frznCntrEventMode(pFrznPoint)), curLen, bGetLen);
+        _valueString(pSDNPSession, "frozenCounterEventReportMode", _anlgReportingModeString(sdnpdata_frznCntrEventMode(pFrznPoint)));
       }
 #endif
 
@@ -1515,26 +1513,26 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
 #endif
      
     tmwtarg_snprintf(buf, sizeof(buf), "<counterRollOver>%u</counterRollOver>\n", pConfig->counterRollOver);
-    _appendString(pSDNPSession, buf, curLen, bGetLen); 
+    _appendString(pSDNPSession, buf); 
 
     /* schema 2.11 added reportCounterValueChangeEvents */
     if (sdnpdata_frznCntrEventClass(pFrznPoint))
     {
-      _valueString(pSDNPSession, "reportCounterValueChangeEvents", "<yes />", curLen, bGetLen);
+      _valueString(pSDNPSession, "reportCounterValueChangeEvents", "<yes />");
     }
 
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
     if(pSDNPSession->xml2WriteDnpData)
     {
       TMWDTIME timeOfFreeze;
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
 
       tmwtarg_snprintf(buf, sizeof(buf), "<runningCounterValue>%d</runningCounterValue>\n", value);
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<runningCounterQuality>%d</runningCounterQuality>\n", flags);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       /* NotSupported runningCounterTimestamp */
       
@@ -1542,21 +1540,21 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
       sdnpdata_frznCntrRead(pFrznPoint, &value, &flags, &timeOfFreeze);
       
       tmwtarg_snprintf(buf, sizeof(buf), "<frozenCounterValue>%d</frozenCounterValue>\n", value);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
       
       tmwtarg_snprintf(buf, sizeof(buf), "<frozenCounterQuality>%d</frozenCounterQuality>\n", flags);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       /* NotSupported frozenCounterTimestamp */ 
 #endif
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</counter>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</counter>\n");
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -1564,7 +1562,7 @@ static void TMWDEFS_LOCAL _buildCounterPoint(SDNPSESN *pSDNPSession, void *pDbHa
  
 #if SDNPDATA_SUPPORT_OBJ30
 /* function: _buildAnalogInPoint */
-static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 {
   void *pPoint; 
   SDNPDATA_XML_ANLGINPOINTCONFIG *pConfig;
@@ -1585,11 +1583,11 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
     classMask = sdnpdata_anlgInEventClass(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<analogInput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<analogInput>\n");
  
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetAnlgInPointConfig(pPoint, &config))
@@ -1597,13 +1595,13 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
       pConfig = &config;
 
       /* name */   
-      _valueString(pSDNPSession, "name", pConfig->name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", pConfig->name);   
     }
     else
       pConfig = TMWDEFS_NULL;
 
     /* description */ 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);   
+    _valueString(pSDNPSession, "description", pDesc);   
 
     /* inputPointType contains changeEventClass and includedInClass0Response */ 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
@@ -1612,28 +1610,28 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _putInputPointType(pSDNPSession, classMask, pointInClass0, curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, pointInClass0);  
 #else
-    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_30_ANA_INPUTS), curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_30_ANA_INPUTS));  
 #endif
     
     if(pSDNPSession->obj30DefaultVariation == 0)
     {
-      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_anlgInDefVariation(pPoint)), curLen, bGetLen);    
+      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_anlgInDefVariation(pPoint)));    
     }
     else
     {
-      _valueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj30DefaultVariation), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj30DefaultVariation)); 
     }
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
 #if SDNPDATA_SUPPORT_OBJ32
     if(pSDNPSession->obj32DefaultVariation == 0)
     {
-      _valueString(pSDNPSession, "defaultEventVariation", _variationString(sdnpdata_anlgInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultEventVariation", _variationString(sdnpdata_anlgInEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)));
     }
     else
     {      
-      _valueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj32DefaultVariation), curLen, bGetLen);  
+      _valueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj32DefaultVariation));  
     }
 #endif
 
@@ -1650,30 +1648,30 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
       if (pConfig->minIntTransmittedValue != pConfig->maxIntTransmittedValue)
       {
         tmwtarg_snprintf(buf, sizeof(buf), "<minIntegerTransmittedValue>%d</minIntegerTransmittedValue>\n", pConfig->minIntTransmittedValue);
-        _appendString(pSDNPSession, buf, curLen, bGetLen);
+        _appendString(pSDNPSession, buf);
 
         tmwtarg_snprintf(buf, sizeof(buf), "<maxIntegerTransmittedValue>%d</maxIntegerTransmittedValue>\n", pConfig->maxIntTransmittedValue);
-        _appendString(pSDNPSession, buf, curLen, bGetLen);
+        _appendString(pSDNPSession, buf);
       }
       else
       {
         tmwtarg_snprintf(buf, sizeof(buf), "<minFloatTransmittedValue>%g</minFloatTransmittedValue>\n", pConfig->minFloatTransmittedValue);
-        _appendString(pSDNPSession, buf, curLen, bGetLen);
+        _appendString(pSDNPSession, buf);
 
         tmwtarg_snprintf(buf, sizeof(buf), "<maxFloatTransmittedValue>%g</maxFloatTransmittedValue>\n", pConfig->maxFloatTransmittedValue);
-        _appendString(pSDNPSession, buf, curLen, bGetLen);
+        _appendString(pSDNPSession, buf);
       }
 
       tmwtarg_snprintf(buf, sizeof(buf), "<scaleOffset>%g</scaleOffset>\n", pConfig->scaleOffset);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<scaleFactor>%g</scaleFactor>\n", pConfig->scaleFactor);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<resolution>%g</resolution>\n", pConfig->resolution);
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
-      _valueString(pSDNPSession, "units", pConfig->units, curLen, bGetLen);
+      _valueString(pSDNPSession, "units", pConfig->units);
     }
   
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
@@ -1689,7 +1687,7 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
       TMWTYPES_ULONG ulvalue;
       ulvalue = dnputil_getAnalogValueLong(&value, &flags);
 #endif
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
  
 #if TMWCNFG_SUPPORT_DOUBLE
       tmwtarg_snprintf(buf, sizeof(buf), "<value>%g</value>\n", dvalue);
@@ -1700,21 +1698,21 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
 #endif
 
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<quality>%d</quality>\n", flags&0x3f);  
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
       
       /* NotSupported timestamp */
       /* NotSupported deadband frozenAnalogValue frozenAnalogQuality frozenAnalogTimestamp */
          
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</analogInput>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</analogInput>\n");  
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -1722,7 +1720,7 @@ static void TMWDEFS_LOCAL _buildAnalogInPoint(SDNPSESN *pSDNPSession, void *pDbH
  
 #if SDNPDATA_SUPPORT_OBJ40
 /* function: _buildAnalogOutPoint */
-static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 { 
   void *pPoint; 
   SDNPDATA_XML_ANLGOUTPOINTCONFIG *pConfig;
@@ -1747,11 +1745,11 @@ static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDb
     supportMask = sdnpdata_anlgOutGetSupCtrl(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<analogOutput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<analogOutput>\n");
  
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetAnlgOutPointConfig(pPoint, &config))
@@ -1759,13 +1757,13 @@ static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDb
       pConfig = &config;
 
       /* name */   
-      _valueString(pSDNPSession, "name", pConfig->name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", pConfig->name);   
     }
     else
       pConfig = TMWDEFS_NULL;
 
     /* description */ 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);   
+    _valueString(pSDNPSession, "description", pDesc);   
  
     /* outputPointType contains changeEventClass, commandEventClass, includedInClass0Response*/
 #if SDNPDATA_SUPPORT_CLASS0_POINT
@@ -1774,67 +1772,67 @@ static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDb
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _putOutputPointType(pSDNPSession, classMask1, classMask2, pointInClass0, curLen, bGetLen);  
+    _putOutputPointType(pSDNPSession, classMask1, classMask2, pointInClass0);  
 #else
-    _putOutputPointType(pSDNPSession, classMask1, classMask2, _class0Response(pSDNPSession, DNPDEFS_OBJ_40_ANA_OUT_STATUSES), curLen, bGetLen);  
+    _putOutputPointType(pSDNPSession, classMask1, classMask2, _class0Response(pSDNPSession, DNPDEFS_OBJ_40_ANA_OUT_STATUSES));  
 #endif
 
     if(pSDNPSession->obj40DefaultVariation == 0)
-      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_anlgOutDefVariation(pPoint)), curLen, bGetLen);
+      _valueString(pSDNPSession, "defaultStaticVariation", _variationString(sdnpdata_anlgOutDefVariation(pPoint)));
     
 #if SDNPDATA_SUPPORT_EVENT_VAR_POINT
 #if SDNPDATA_SUPPORT_OBJ42 
     if(pSDNPSession->obj42DefaultVariation == 0)
     {
-      _valueString(pSDNPSession, "defaultChangeEventVariation", _variationString(sdnpdata_anlgOutEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultChangeEventVariation", _variationString(sdnpdata_anlgOutEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL))); 
     }
     else
     {
-      _valueString(pSDNPSession, "defaultChangeEventVariation",   _variationGroupString(pSDNPSession->obj42DefaultVariation), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultChangeEventVariation",   _variationGroupString(pSDNPSession->obj42DefaultVariation)); 
     }
 #endif
     
 #if SDNPDATA_SUPPORT_OBJ43
     if(pSDNPSession->obj43DefaultVariation == 0)
     {
-      _valueString(pSDNPSession, "defaultCommandEventVariation", _variationString(sdnpdata_anlgOutCmdEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)), curLen, bGetLen);  
+      _valueString(pSDNPSession, "defaultCommandEventVariation", _variationString(sdnpdata_anlgOutCmdEventDefVariation(pPoint, TMWDEFS_CLASS_MASK_ALL)));  
     }
     else
     {
-      _valueString(pSDNPSession, "defaultCommandEventVariation",   _variationGroupString(pSDNPSession->obj43DefaultVariation), curLen, bGetLen); 
+      _valueString(pSDNPSession, "defaultCommandEventVariation",   _variationGroupString(pSDNPSession->obj43DefaultVariation)); 
     }
 #endif
 #endif
 
     tmwtarg_snprintf(buf, sizeof(buf), "<maxTimeSelectOperate>%d</maxTimeSelectOperate>\n", pSDNPSession->selectTimeout);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
-    _appendString(pSDNPSession, "<supportedControlOperations>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<supportedControlOperations>\n");
     pSDNPSession->xml2CurIndent++;
 
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportSelectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_SELOP));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportDirectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIROP));
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "supportDirectOperateNoAck", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIRNOACK));
+    _emptyElementString(pSDNPSession, "supportSelectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_SELOP));
+    _emptyElementString(pSDNPSession, "supportDirectOperate", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIROP));
+    _emptyElementString(pSDNPSession, "supportDirectOperateNoAck", TMWDEFS_TOBOOL(supportMask, SDNPDATA_XML_SUP_DIRNOACK));
  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</supportedControlOperations>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</supportedControlOperations>\n");
  
     tmwtarg_snprintf(buf, sizeof(buf), "<minTransmittedValue>%g</minTransmittedValue>\n", pConfig->minTransmittedValue);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     tmwtarg_snprintf(buf, sizeof(buf), "<maxTransmittedValue>%g</maxTransmittedValue>\n", pConfig->maxTransmittedValue);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     tmwtarg_snprintf(buf, sizeof(buf), "<scaleOffset>%g</scaleOffset>\n", pConfig->scaleOffset);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     tmwtarg_snprintf(buf, sizeof(buf), "<scaleFactor>%g</scaleFactor>\n", pConfig->scaleFactor);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     tmwtarg_snprintf(buf, sizeof(buf), "<resolution>%g</resolution>\n", pConfig->resolution);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
-    _valueString(pSDNPSession, "units", pConfig->units, curLen, bGetLen);
+    _valueString(pSDNPSession, "units", pConfig->units);
  
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
     if(pSDNPSession->xml2WriteDnpData)
@@ -1849,7 +1847,7 @@ static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDb
       TMWTYPES_ULONG ulvalue;
       ulvalue = dnputil_getAnalogValueLong(&value, &flags);
 #endif
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
  
 #if TMWCNFG_SUPPORT_DOUBLE
       tmwtarg_snprintf(buf, sizeof(buf), "<value>%g</value>\n", dvalue);
@@ -1860,22 +1858,22 @@ static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDb
 #endif
  
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
 
       tmwtarg_snprintf(buf, sizeof(buf), "<quality>%d</quality>\n", flags&0x3f);  
-      _appendString(pSDNPSession, buf, curLen, bGetLen);
+      _appendString(pSDNPSession, buf);
       
       /* NotSupported timestamp */
       /* NotSupported control */ 
       /* NotSupported status */
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</analogOutput>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</analogOutput>\n");
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -1883,7 +1881,7 @@ static void TMWDEFS_LOCAL _buildAnalogOutPoint(SDNPSESN *pSDNPSession, void *pDb
 
 #if SDNPDATA_SUPPORT_OBJ70
 /* function: _buildFilePoint */
-static TMWTYPES_BOOL TMWDEFS_LOCAL _buildFilePoint(SDNPSESN *pSDNPSession, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static TMWTYPES_BOOL TMWDEFS_LOCAL _buildFilePoint(SDNPSESN *pSDNPSession, TMWTYPES_USHORT pointNum)
 {
   SDNPDATA_XML_PERFILECONFIG config;
 
@@ -1894,21 +1892,21 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _buildFilePoint(SDNPSESN *pSDNPSession, TMWTY
     if(config.filename[0] !=0)
     {
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, "<sequentialFile>\n", curLen, bGetLen); 
+      _appendString(pSDNPSession, "<sequentialFile>\n"); 
 
       pSDNPSession->xml2CurIndent++;
-      _valueString(pSDNPSession, "fileName", config.filename, curLen, bGetLen);     
+      _valueString(pSDNPSession, "fileName", config.filename);     
 
-      _valueString(pSDNPSession, "eventClass", _classMaskString(config.eventClass), curLen, bGetLen);     
+      _valueString(pSDNPSession, "eventClass", _classMaskString(config.eventClass));     
             
-      _boolString(pSDNPSession, curLen, bGetLen, "readAuthenticateRequired",  config.readAuthenticateRequired);
-      _boolString(pSDNPSession, curLen, bGetLen, "writeAuthenticateRequired",  config.writeAuthenticateRequired);
-      _boolString(pSDNPSession, curLen, bGetLen, "deleteAuthenticateRequired",  config.deleteAuthenticateRequired);
+      _boolString(pSDNPSession, "readAuthenticateRequired",  config.readAuthenticateRequired);
+      _boolString(pSDNPSession, "writeAuthenticateRequired",  config.writeAuthenticateRequired);
+      _boolString(pSDNPSession, "deleteAuthenticateRequired",  config.deleteAuthenticateRequired);
    
-      _valueString(pSDNPSession, "description", config.description, curLen, bGetLen);   
+      _valueString(pSDNPSession, "description", config.description);   
       
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</sequentialFile>\n", curLen, bGetLen); 
+      _appendString(pSDNPSession, "</sequentialFile>\n"); 
       pSDNPSession->xml2CurIndent--;
     }
     return TMWDEFS_TRUE;
@@ -2090,7 +2088,7 @@ static TMWTYPES_BOOL TMWDEFS_LOCAL _toDatasetOutData(DNPDATA_DATASET_VALUE *pDat
 }
 
 /* function: _buildDatasetProtoStart */ 
-static void TMWDEFS_LOCAL _buildDatasetProtoStart(SDNPSESN *pSDNPSession, void *pProtoPoint, TMWTYPES_UCHAR *pUUID, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetProtoStart(SDNPSESN *pSDNPSession, void *pProtoPoint, TMWTYPES_UCHAR *pUUID, TMWTYPES_USHORT pointNum)
 { 
   int i;
   int len; 
@@ -2098,40 +2096,40 @@ static void TMWDEFS_LOCAL _buildDatasetProtoStart(SDNPSESN *pSDNPSession, void *
   TMWTYPES_CHAR buf[256];
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<datasetPrototype>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<datasetPrototype>\n");
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /* prototypeDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_85_DATASET_PROTO, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_85_DATASET_PROTO);
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
       
-  _appendString(pSDNPSession, "<prototype>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<prototype>\n"); 
 
   tmwtarg_snprintf(buf, sizeof(buf), "<id>%d</id>\n", pointNum);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen);
+  _appendString(pSDNPSession, buf);
   
   len = 0;
   for(i=0; i< 16; i++)
     len += tmwtarg_snprintf((char *)buf+len, sizeof(buf)-len, "%02x ", pUUID[i]);
   
-  _valueString(pSDNPSession, "uuid", (TMWTYPES_CHAR*)buf, curLen, bGetLen);
+  _valueString(pSDNPSession, "uuid", (TMWTYPES_CHAR*)buf);
 
   /* description, mandatory*/ 
   pDesc = sdnpdata_datasetGetDescription(pProtoPoint);  
   if((pDesc == TMWDEFS_NULL) || (*pDesc == 0))
-    _valueString(pSDNPSession, "description", "description", curLen, bGetLen); 
+    _valueString(pSDNPSession, "description", "description"); 
   else
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);
+    _valueString(pSDNPSession, "description", pDesc);
 }
 
 /* function: _buildDatasetProtoElem */
-static void TMWDEFS_LOCAL _buildDatasetProtoElem(SDNPSESN *pSDNPSession, DNPDATA_DATASET_DESCR_ELEM *pDescrElems, TMWTYPES_USHORT elemNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetProtoElem(SDNPSESN *pSDNPSession, DNPDATA_DATASET_DESCR_ELEM *pDescrElems, TMWTYPES_USHORT elemNum)
 { 
   TMWTYPES_CHAR buf[128];
   TMWTYPES_UCHAR name[256];
@@ -2143,7 +2141,7 @@ static void TMWDEFS_LOCAL _buildDatasetProtoElem(SDNPSESN *pSDNPSession, DNPDATA
     if(pDescrElems[0].descrElemType == DNPDEFS_DATASET_DESCR_NSPC)
     {
       _toDatasetOutData(&pDescrElems[0].ancillaryValue, DNPDEFS_DATASET_TYPE_VSTR, name, 256);
-      _valueString(pSDNPSession, "namespace", (TMWTYPES_CHAR*)name, curLen, bGetLen);
+      _valueString(pSDNPSession, "namespace", (TMWTYPES_CHAR*)name);
       return;
     }
   }
@@ -2153,36 +2151,36 @@ static void TMWDEFS_LOCAL _buildDatasetProtoElem(SDNPSESN *pSDNPSession, DNPDATA
     if(pDescrElems[1].descrElemType == DNPDEFS_DATASET_DESCR_NAME)
     {
       _toDatasetOutData(&pDescrElems[1].ancillaryValue, DNPDEFS_DATASET_TYPE_VSTR, name, 256);
-      _valueString(pSDNPSession, "name", (TMWTYPES_CHAR*)name, curLen, bGetLen);
+      _valueString(pSDNPSession, "name", (TMWTYPES_CHAR*)name);
       return;
     }
   }  
-  _appendString(pSDNPSession,"<dataElement>\n", curLen, bGetLen);
+  _appendString(pSDNPSession,"<dataElement>\n");
 
   pSDNPSession->xml2CurIndent++;
-  _valueString(pSDNPSession, "elemTypeCode", _toDescrType(pDescrElems[elemNum].descrElemType), curLen, bGetLen);     
+  _valueString(pSDNPSession, "elemTypeCode", _toDescrType(pDescrElems[elemNum].descrElemType));     
 
-  _valueString(pSDNPSession, "dataType", _toDataType(pDescrElems[elemNum].dataTypeCode), curLen, bGetLen);
+  _valueString(pSDNPSession, "dataType", _toDataType(pDescrElems[elemNum].dataTypeCode));
 
   tmwtarg_snprintf(buf, sizeof(buf), "<maxDataLength>%d</maxDataLength>\n", pDescrElems[elemNum].maxDataLength);
-  _appendString(pSDNPSession, buf, curLen, bGetLen);
+  _appendString(pSDNPSession, buf);
   
   _toDatasetOutData(&pDescrElems[elemNum].ancillaryValue, DNPDEFS_DATASET_TYPE_VSTR, name, 256);
   
-  _valueString(pSDNPSession, "elementName", (TMWTYPES_CHAR*)name, curLen, bGetLen);
+  _valueString(pSDNPSession, "elementName", (TMWTYPES_CHAR*)name);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</dataElement>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</dataElement>\n"); 
 }
   
 /* function: _buildDatasetProtoEnd */
-static void TMWDEFS_LOCAL _buildDatasetProtoEnd(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetProtoEnd(SDNPSESN *pSDNPSession)
 { 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</prototype>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</prototype>\n"); 
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</datasetPrototype>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</datasetPrototype>\n");
   pSDNPSession->xml2CurIndent--;
 }
   
@@ -2242,47 +2240,47 @@ static void TMWDEFS_LOCAL _datasetDescrExpanded(void *pDbHandle, TMWTYPES_USHORT
 }
 
 /* function: _buildDatasetDescrStart */
-static void TMWDEFS_LOCAL _buildDatasetDescrStart(SDNPSESN *pSDNPSession, void *pDescrPoint, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDescrStart(SDNPSESN *pSDNPSession, void *pDescrPoint, TMWTYPES_USHORT pointNum)
 { 
   TMWTYPES_CHAR *pDesc;
   TMWTYPES_CHAR buf[256];
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<datasetDescriptor>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<datasetDescriptor>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
 
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_86_DATASET_DESCR, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_86_DATASET_DESCR);
 
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
   /* 
     description
   */
    
-  _appendString(pSDNPSession, "<descriptor>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<descriptor>\n");
 
   tmwtarg_snprintf(buf, sizeof(buf), "<id>%d</id>\n", pointNum);
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, buf, curLen, bGetLen);
+  _appendString(pSDNPSession, buf);
 
   /* description, mandatory*/
   pDesc = sdnpdata_datasetGetDescription(pDescrPoint);  
   if((pDesc == TMWDEFS_NULL) || (*pDesc == 0))
-    _valueString(pSDNPSession, "description", "description", curLen, bGetLen); 
+    _valueString(pSDNPSession, "description", "description"); 
   else
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);  
+    _valueString(pSDNPSession, "description", pDesc);  
   
   /* properties is only a capability */
   /* changeEventClass is only a capability */
   /* class0ResponseMode is only a capability */
 
-  _appendString(pSDNPSession, "<datasetElements>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<datasetElements>\n");
   
   pSDNPSession->xml2CurIndent++;
 }
  
 /* function: _buildDatasetDescrElem */
-static void TMWDEFS_LOCAL _buildDatasetDescrElem(SDNPSESN *pSDNPSession, DNPDATA_DATASET_DESCR_ELEM *pDescrElems, TMWTYPES_UCHAR elemNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDescrElem(SDNPSESN *pSDNPSession, DNPDATA_DATASET_DESCR_ELEM *pDescrElems, TMWTYPES_UCHAR elemNum)
 { 
   TMWTYPES_UCHAR name[256];
   TMWTYPES_CHAR buf[256];
@@ -2291,39 +2289,39 @@ static void TMWDEFS_LOCAL _buildDatasetDescrElem(SDNPSESN *pSDNPSession, DNPDATA
   if((elemNum == 0) && (pDescrElems[0].descrElemType == DNPDEFS_DATASET_DESCR_NAME))
   {
     _toDatasetOutData(&pDescrElems[0].ancillaryValue, DNPDEFS_DATASET_TYPE_OSTR, name, 256);
-    _valueString(pSDNPSession, "name", (TMWTYPES_CHAR*)name, curLen, bGetLen); 
+    _valueString(pSDNPSession, "name", (TMWTYPES_CHAR*)name); 
     return;
   }
 
-  _appendString(pSDNPSession, "<dataSetElement>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<dataSetElement>\n");
  
   /* We do not have a description per element, other than the name. */
 
   if(pDescrElems[elemNum].descrElemType == DNPDEFS_DATASET_DESCR_PTYP)
   {
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<prototypeElement>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<prototypeElement>\n");
       
     pSDNPSession->xml2CurIndent++;
     _toDatasetOutData(&pDescrElems[elemNum].ancillaryValue, DNPDEFS_DATASET_TYPE_OSTR, name, 256);
     tmwtarg_snprintf(buf, sizeof(buf), "<uuid>%s</uuid>\n", name);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</prototypeElement>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</prototypeElement>\n");
   }
   else /*dataElement */
   {
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<dataElement>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<dataElement>\n");
 
     pSDNPSession->xml2CurIndent++; 
-    _valueString(pSDNPSession, "elemTypeCode", _toDescrType(pDescrElems[elemNum].descrElemType), curLen, bGetLen);  
+    _valueString(pSDNPSession, "elemTypeCode", _toDescrType(pDescrElems[elemNum].descrElemType));  
 
-    _valueString(pSDNPSession, "dataType", _toDataType(pDescrElems[elemNum].dataTypeCode), curLen, bGetLen);  
+    _valueString(pSDNPSession, "dataType", _toDataType(pDescrElems[elemNum].dataTypeCode));  
 
     tmwtarg_snprintf(buf, sizeof(buf), "<maxDataLength>%d</maxDataLength>\n", pDescrElems[elemNum].maxDataLength);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     if(pDescrElems[elemNum].descrElemType == DNPDEFS_DATASET_DESCR_UUID
       || pDescrElems[elemNum].descrElemType == DNPDEFS_DATASET_DESCR_PTYP)
@@ -2337,20 +2335,20 @@ static void TMWDEFS_LOCAL _buildDatasetDescrElem(SDNPSESN *pSDNPSession, DNPDATA
       tmwtarg_snprintf(buf, sizeof(buf), "<elementName>%s</elementName>\n", name); 
     }
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</dataElement>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</dataElement>\n");
     pSDNPSession->xml2CurIndent--;
   }  
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</dataSetElement>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</dataSetElement>\n");
 
 }  
 
 /* function: _buildDatasetDescrIndex */
-static void TMWDEFS_LOCAL _buildDatasetDescrIndex(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDescrIndex(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 { 
   int i;
   void *pPoint; 
@@ -2363,32 +2361,32 @@ static void TMWDEFS_LOCAL _buildDatasetDescrIndex(SDNPSESN *pSDNPSession, void *
     return;
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</datasetElements>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</datasetElements>\n");
 
   pIndexElems = sdnpdata_datasetDescrReadIndex(pPoint, &numberElems); 
   for(i=0; i<numberElems; i++ )
   {
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<pointIndexAttribute>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<pointIndexAttribute>\n");
 
     tmwtarg_snprintf(buf, sizeof(buf), "<groupNumber>%d</groupNumber>\n", pIndexElems[i].pointType);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     tmwtarg_snprintf(buf, sizeof(buf), "<pointIndex>%d</pointIndex>\n", pIndexElems[i].pointIndex);
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</pointIndexAttribute>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</pointIndexAttribute>\n"); 
     pSDNPSession->xml2CurIndent--;
   }
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</descriptor>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</descriptor>\n");
 }  
   
   /* function: _buildDatasetDescrData */
-static void TMWDEFS_LOCAL _buildDatasetDescrData(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDatasetDescrData(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 { 
   void *pPoint; 
 
@@ -2397,7 +2395,7 @@ static void TMWDEFS_LOCAL _buildDatasetDescrData(SDNPSESN *pSDNPSession, void *p
     return;
 
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
-  _appendString(pSDNPSession, "<datasetPoint>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<datasetPoint>\n");
   pPoint = sdnpdata_datasetGetPoint(pDbHandle, pointNum); 
   if(pPoint != TMWDEFS_NULL)
   {
@@ -2414,23 +2412,23 @@ static void TMWDEFS_LOCAL _buildDatasetDescrData(SDNPSESN *pSDNPSession, void *p
       if(pSDNPSession->xml2WriteDnpData)
       {
         pSDNPSession->xml2CurIndent++;
-        _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+        _appendString(pSDNPSession, "<dnpData>\n");
 
         pSDNPSession->xml2CurIndent++;
         /*TBD This is not correct  */  
-        _valueString(pSDNPSession, _toDataType(dataTypeArray[i]), "0", curLen, bGetLen);  
+        _valueString(pSDNPSession, _toDataType(dataTypeArray[i]), "0");  
         pSDNPSession->xml2CurIndent--;
 
-        _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen); 
+        _appendString(pSDNPSession, "</dnpData>\n"); 
         pSDNPSession->xml2CurIndent--;
       }
     }
   }
-  _appendString(pSDNPSession, "</datasetPoint>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</datasetPoint>\n");
 #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</datasetDescriptor>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</datasetDescriptor>\n"); 
   pSDNPSession->xml2CurIndent--;
 }  
 #endif
@@ -2439,7 +2437,7 @@ static void TMWDEFS_LOCAL _buildDatasetDescrData(SDNPSESN *pSDNPSession, void *p
 
 #if SDNPDATA_SUPPORT_OBJ110
 /* function: _buildOctetStringPoint */
-static void TMWDEFS_LOCAL _buildOctetStringPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildOctetStringPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 { void *pPoint;
   TMWTYPES_BOOL extendedString;
   TMWTYPES_UCHAR strLength;
@@ -2467,21 +2465,21 @@ static void TMWDEFS_LOCAL _buildOctetStringPoint(SDNPSESN *pSDNPSession, void *p
     classMask = sdnpdata_strEventClass(pPoint);
 
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<octetString>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<octetString>\n");
  
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
     
     /* name */   
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetStringPointConfig(pPoint, &config))
     {
       /* name */   
-      _valueString(pSDNPSession, "name", config.name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", config.name);   
     }
 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen);  
+    _valueString(pSDNPSession, "description", pDesc);  
  
     /* inputPointType contains changeEventClass and includedInClass0Response */ 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
@@ -2490,46 +2488,46 @@ static void TMWDEFS_LOCAL _buildOctetStringPoint(SDNPSESN *pSDNPSession, void *p
     {
       pointInClass0 = TMWDEFS_TRUE;
     }
-    _putInputPointType(pSDNPSession, classMask, pointInClass0, curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, pointInClass0);  
 #else
-    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_110_STRING_DATA), curLen, bGetLen);  
+    _putInputPointType(pSDNPSession, classMask, _class0Response(pSDNPSession, DNPDEFS_OBJ_110_STRING_DATA));  
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ114 
     if(extendedString)
-      _valueString(pSDNPSession, "groupNumberUsed", (TMWTYPES_CHAR *)"g114", curLen, bGetLen);
+      _valueString(pSDNPSession, "groupNumberUsed", (TMWTYPES_CHAR *)"g114");
     else
-      _valueString(pSDNPSession, "groupNumberUsed", (TMWTYPES_CHAR *)"g110", curLen, bGetLen);
+      _valueString(pSDNPSession, "groupNumberUsed", (TMWTYPES_CHAR *)"g110");
 #else
     /* New in schema 2.10, corrected in 2.11 */
-    _valueString(pSDNPSession, "groupNumberUsed", (TMWTYPES_CHAR *)"g110", curLen, bGetLen); 
+    _valueString(pSDNPSession, "groupNumberUsed", (TMWTYPES_CHAR *)"g110"); 
 #endif
 				
 #if SDNPDATA_SUPPORT_XML2_DNPDATA
     if(pSDNPSession->xml2WriteDnpData)
     {
-      _appendString(pSDNPSession, "<dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<dnpData>\n");
 
       /* Null terminate string */
       strBuf[strLength]='\0'; 
       
       pSDNPSession->xml2CurIndent++; 
-      _valueString(pSDNPSession, "value", (TMWTYPES_CHAR *)strBuf, curLen, bGetLen);  
+      _valueString(pSDNPSession, "value", (TMWTYPES_CHAR *)strBuf);  
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</dnpData>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</dnpData>\n");
     }
 #endif
      
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</octetString>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</octetString>\n"); 
     pSDNPSession->xml2CurIndent--;
   }
 }
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ112
-static void TMWDEFS_LOCAL _buildVirtualTerminalPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildVirtualTerminalPoint(SDNPSESN *pSDNPSession, void *pDbHandle, TMWTYPES_USHORT pointNum)
 { 
   void *pPoint; 
   TMWTYPES_UCHAR strLength;
@@ -2548,26 +2546,26 @@ static void TMWDEFS_LOCAL _buildVirtualTerminalPoint(SDNPSESN *pSDNPSession, voi
     classMask = sdnpdata_vtermEventClass(pPoint);
   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<virtualTerminal>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<virtualTerminal>\n");
  
     tmwtarg_snprintf(buf, sizeof(buf), "<index>%d</index>\n", pointNum);
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, buf, curLen, bGetLen);
+    _appendString(pSDNPSession, buf);
     
     /* name */   
     memset(&config, 0, sizeof(config));
     if(sdnpdata_XmlGetVtermPointConfig(pPoint, &config))
     {
       /* name */   
-      _valueString(pSDNPSession, "name", config.name, curLen, bGetLen);   
+      _valueString(pSDNPSession, "name", config.name);   
     }
 
-    _valueString(pSDNPSession, "description", pDesc, curLen, bGetLen); 
+    _valueString(pSDNPSession, "description", pDesc); 
  
-    _valueString(pSDNPSession, "changeEventClass", _classMaskString(classMask), curLen, bGetLen);   
+    _valueString(pSDNPSession, "changeEventClass", _classMaskString(classMask));   
  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</virtualTerminal>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</virtualTerminal>\n"); 
     pSDNPSession->xml2CurIndent--;
   }
 }
@@ -2684,7 +2682,7 @@ static char * TMWDEFS_LOCAL _toAsymMethodString(TMWTYPES_UCHAR type)
 #endif
 
 /* referenceDevice/configuration/deviceConfig */
-static void TMWDEFS_LOCAL _buildDeviceConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildDeviceConfig(SDNPSESN *pSDNPSession)
 { 
   int i;
   SDNPDATA_XML_DEVICECONFIG *pDeviceConfig; 
@@ -2696,7 +2694,7 @@ static void TMWDEFS_LOCAL _buildDeviceConfig(SDNPSESN *pSDNPSession, TMWTYPES_UL
   memset(pDeviceConfig, 0, sizeof(SDNPDATA_XML_DEVICECONFIG));
   
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<deviceConfig>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<deviceConfig>\n"); 
 
 	/*  deviceFunction 
       vendorName
@@ -2716,175 +2714,175 @@ static void TMWDEFS_LOCAL _buildDeviceConfig(SDNPSESN *pSDNPSession, TMWTYPES_UL
   if(sdnpdata_XmlGetDeviceConfig(pSDNPSession->pDbHandle, pDeviceConfig))
   { 
     pSDNPSession->xml2CurIndent++;
-    _currentValueString(pSDNPSession, "deviceFunction",  "<outstation />", curLen, bGetLen);   
+    _currentValueString(pSDNPSession, "deviceFunction",  "<outstation />");   
      
-    _currentValueValueString(pSDNPSession, "vendorName", pDeviceConfig->vendorName, curLen, bGetLen);   
-    _currentValueValueString(pSDNPSession, "deviceName", pDeviceConfig->deviceName, curLen, bGetLen);   
-    _currentValueValueString(pSDNPSession, "hardwareVersion", pDeviceConfig->hardwareVersion, curLen, bGetLen);   
-    _currentValueValueString(pSDNPSession, "softwareVersion", pDeviceConfig->softwareVersion, curLen, bGetLen);
-    _currentValueDecimalString(pSDNPSession, "documentVersionNumber", pDeviceConfig->documentVersionNumber, curLen, bGetLen);      
+    _currentValueValueString(pSDNPSession, "vendorName", pDeviceConfig->vendorName);   
+    _currentValueValueString(pSDNPSession, "deviceName", pDeviceConfig->deviceName);   
+    _currentValueValueString(pSDNPSession, "hardwareVersion", pDeviceConfig->hardwareVersion);   
+    _currentValueValueString(pSDNPSession, "softwareVersion", pDeviceConfig->softwareVersion);
+    _currentValueDecimalString(pSDNPSession, "documentVersionNumber", pDeviceConfig->documentVersionNumber);      
 
 
     /* outstation containing a sequence of none level1..level4 */
-    _appendString(pSDNPSession, "<dnpLevelSupported>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<dnpLevelSupported>\n");  
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<outStation>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<outStation>\n");  
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "none", pDeviceConfig->dnpLevelSupported.none);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "level1", pDeviceConfig->dnpLevelSupported.level1);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "level2", pDeviceConfig->dnpLevelSupported.level2);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "level3", pDeviceConfig->dnpLevelSupported.level3);
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "level4", pDeviceConfig->dnpLevelSupported.level4);
+    _emptyElementString(pSDNPSession, "none", pDeviceConfig->dnpLevelSupported.none);  
+    _emptyElementString(pSDNPSession, "level1", pDeviceConfig->dnpLevelSupported.level1);  
+    _emptyElementString(pSDNPSession, "level2", pDeviceConfig->dnpLevelSupported.level2);  
+    _emptyElementString(pSDNPSession, "level3", pDeviceConfig->dnpLevelSupported.level3);
+    _emptyElementString(pSDNPSession, "level4", pDeviceConfig->dnpLevelSupported.level4);
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</outStation>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</outStation>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</dnpLevelSupported>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</dnpLevelSupported>\n");  
 
 
-    _appendString(pSDNPSession, "<supportedFunctionBlocks>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<supportedFunctionBlocks>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
 
     
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "selfAddressReservation", pSDNPSession->dnp.enableSelfAddress);   
+    _emptyElementString(pSDNPSession, "selfAddressReservation", pSDNPSession->dnp.enableSelfAddress);   
 #if SDNPDATA_SUPPORT_DATASETS
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dataSets", TMWDEFS_TRUE);   
+    _emptyElementString(pSDNPSession, "dataSets", TMWDEFS_TRUE);   
 #endif
 #if SDNPDATA_SUPPORT_OBJ70
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "fileTransfer", TMWDEFS_TRUE);  
+    _emptyElementString(pSDNPSession, "fileTransfer", TMWDEFS_TRUE);  
 #endif
 #if SDNPDATA_SUPPORT_OBJ112
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "virtualTerminal", TMWDEFS_TRUE);   
+    _emptyElementString(pSDNPSession, "virtualTerminal", TMWDEFS_TRUE);   
 #endif
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "mappingToIEC61850ObjectModels", pDeviceConfig->supportedFunctionBlocks.mappingToIEC61850ObjectModels);   
+    _emptyElementString(pSDNPSession, "mappingToIEC61850ObjectModels", pDeviceConfig->supportedFunctionBlocks.mappingToIEC61850ObjectModels);   
 #if SDNPDATA_SUPPORT_OBJ91
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC31ActivateConfiguration", TMWDEFS_TRUE);   
+    _emptyElementString(pSDNPSession, "FC31ActivateConfiguration", TMWDEFS_TRUE);   
 #endif
 #if SDNPDATA_SUPPORT_OBJ120
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "secureAuthentication", TMWDEFS_TRUE);   
+    _emptyElementString(pSDNPSession, "secureAuthentication", TMWDEFS_TRUE);   
 #endif
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</supportedFunctionBlocks>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</supportedFunctionBlocks>\n");  
 
 
-    _appendString(pSDNPSession, "<notableAdditions>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<notableAdditions>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<currentValue>\n");   
     pSDNPSession->xml2CurIndent++;
     for(i=0; i<SDNPXML_MAX_NOTABLEADDITIONS; i++)
     {
-      _valueString(pSDNPSession, "note", pDeviceConfig->notableAdditions[i].note, curLen, bGetLen);
+      _valueString(pSDNPSession, "note", pDeviceConfig->notableAdditions[i].note);
     } 
     for(i=0; i<SDNPXML_MAX_NOTABLEADDITIONS; i++)
     {
-      _valueString(pSDNPSession, "notableAddition", pDeviceConfig->notableAdditions[i].notableAddition, curLen, bGetLen);
+      _valueString(pSDNPSession, "notableAddition", pDeviceConfig->notableAdditions[i].notableAddition);
     }
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</notableAdditions>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</notableAdditions>\n");  
 
 
-    _appendString(pSDNPSession, "<configurationMethods>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<configurationMethods>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<currentValue>\n");   
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "xmlViaFileTransfer", pDeviceConfig->configurationMethods.xmlViaFileTransfer);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "xmlViaOtherTransportMechanism", pDeviceConfig->configurationMethods.xmlViaOtherTransportMechanism);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "terminal", pDeviceConfig->configurationMethods.terminal);   
+    _emptyElementString(pSDNPSession, "xmlViaFileTransfer", pDeviceConfig->configurationMethods.xmlViaFileTransfer);   
+    _emptyElementString(pSDNPSession, "xmlViaOtherTransportMechanism", pDeviceConfig->configurationMethods.xmlViaOtherTransportMechanism);   
+    _emptyElementString(pSDNPSession, "terminal", pDeviceConfig->configurationMethods.terminal);   
     /* "software" */   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "proprietaryFileViaFileTransfer", pDeviceConfig->configurationMethods.proprietaryFileViaFileTransfer);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "proprietaryFileViaOtherTransportMechanism", pDeviceConfig->configurationMethods.proprietaryFileViaOtherTransportMechanism);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "direct", pDeviceConfig->configurationMethods.direct);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "factory", pDeviceConfig->configurationMethods.factory);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "protocol", pDeviceConfig->configurationMethods.protocol);   
+    _emptyElementString(pSDNPSession, "proprietaryFileViaFileTransfer", pDeviceConfig->configurationMethods.proprietaryFileViaFileTransfer);   
+    _emptyElementString(pSDNPSession, "proprietaryFileViaOtherTransportMechanism", pDeviceConfig->configurationMethods.proprietaryFileViaOtherTransportMechanism);  
+    _emptyElementString(pSDNPSession, "direct", pDeviceConfig->configurationMethods.direct);   
+    _emptyElementString(pSDNPSession, "factory", pDeviceConfig->configurationMethods.factory);   
+    _emptyElementString(pSDNPSession, "protocol", pDeviceConfig->configurationMethods.protocol);   
     /* other */
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</configurationMethods>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</configurationMethods>\n");  
 
-    _appendString(pSDNPSession, "<onlineXmlFileNames>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<onlineXmlFileNames>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);    
+    _appendString(pSDNPSession, "<currentValue>\n");    
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPReadSupported", pDeviceConfig->onlineXmlFileNames.dnpDPReadSupported);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPCapReadSupported", pDeviceConfig->onlineXmlFileNames.dnpDPReadSupported);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPCfgReadSupported", pDeviceConfig->onlineXmlFileNames.dnpDPCfgReadSupported);    
+    _emptyElementString(pSDNPSession, "dnpDPReadSupported", pDeviceConfig->onlineXmlFileNames.dnpDPReadSupported);  
+    _emptyElementString(pSDNPSession, "dnpDPCapReadSupported", pDeviceConfig->onlineXmlFileNames.dnpDPReadSupported);   
+    _emptyElementString(pSDNPSession, "dnpDPCfgReadSupported", pDeviceConfig->onlineXmlFileNames.dnpDPCfgReadSupported);    
 		
     for(i=0; i<SDNPXML_MAX_XMLFILENAMES; i++)
     {
-      _xmlFileString(pSDNPSession, &pDeviceConfig->onlineXmlFileNames.xmlFile[i], curLen, bGetLen); 
+      _xmlFileString(pSDNPSession, &pDeviceConfig->onlineXmlFileNames.xmlFile[i]); 
     } 
     for(i=0; i<SDNPXML_MAX_XMLFILENAMES; i++)
     {
-      _valueString(pSDNPSession, "note", pDeviceConfig->onlineXmlFileNames.note[i], curLen, bGetLen); 
+      _valueString(pSDNPSession, "note", pDeviceConfig->onlineXmlFileNames.note[i]); 
     }
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</onlineXmlFileNames>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</onlineXmlFileNames>\n");  
  
-    _appendString(pSDNPSession, "<offlineXmlFileNames>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<offlineXmlFileNames>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<currentValue>\n"); 
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPReadSupported", pDeviceConfig->offlineXmlFileNames.dnpDPReadSupported);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPWriteSupported", pDeviceConfig->offlineXmlFileNames.dnpDPWriteSupported);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPCapReadSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCapReadSupported);    
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPCapWriteSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCapWriteSupported);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPCfgReadSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCfgReadSupported);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dnpDPCfgWriteSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCfgWriteSupported);   
+    _emptyElementString(pSDNPSession, "dnpDPReadSupported", pDeviceConfig->offlineXmlFileNames.dnpDPReadSupported);  
+    _emptyElementString(pSDNPSession, "dnpDPWriteSupported", pDeviceConfig->offlineXmlFileNames.dnpDPWriteSupported);   
+    _emptyElementString(pSDNPSession, "dnpDPCapReadSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCapReadSupported);    
+    _emptyElementString(pSDNPSession, "dnpDPCapWriteSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCapWriteSupported);   
+    _emptyElementString(pSDNPSession, "dnpDPCfgReadSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCfgReadSupported);   
+    _emptyElementString(pSDNPSession, "dnpDPCfgWriteSupported", pDeviceConfig->offlineXmlFileNames.dnpDPCfgWriteSupported);   
 	
     for(i=0; i<SDNPXML_MAX_XMLFILENAMES; i++)
     {
-      _xmlFileString(pSDNPSession, &pDeviceConfig->offlineXmlFileNames.xmlFile[i], curLen, bGetLen); 
+      _xmlFileString(pSDNPSession, &pDeviceConfig->offlineXmlFileNames.xmlFile[i]); 
     } 
     for(i=0; i<SDNPXML_MAX_XMLFILENAMES; i++)
     {
-      _valueString(pSDNPSession, "note", pDeviceConfig->offlineXmlFileNames.note[i], curLen, bGetLen); 
+      _valueString(pSDNPSession, "note", pDeviceConfig->offlineXmlFileNames.note[i]); 
     }
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</offlineXmlFileNames>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "</offlineXmlFileNames>\n");
     
-    _appendString(pSDNPSession, "<connectionsSupported>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<connectionsSupported>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "serial", pDeviceConfig->connectionsSupported.serial);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "network", pDeviceConfig->connectionsSupported.network);   
+    _emptyElementString(pSDNPSession, "serial", pDeviceConfig->connectionsSupported.serial);   
+    _emptyElementString(pSDNPSession, "network", pDeviceConfig->connectionsSupported.network);   
     pSDNPSession->xml2CurIndent--;
     for(i=0; i<SDNPXML_MAX_OTHERCONNECTIONS; i++)
     {
       if(pDeviceConfig->connectionsSupported.other[i][0] != 0)
-        _valueOther(pSDNPSession, pDeviceConfig->connectionsSupported.other[i], curLen, bGetLen);
+        _valueOther(pSDNPSession, pDeviceConfig->connectionsSupported.other[i]);
     }
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</connectionsSupported>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</connectionsSupported>\n");  
   }
 
   /* NotSupported conformanceTesting */
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</deviceConfig>\n", curLen, bGetLen);   
+  _appendString(pSDNPSession, "</deviceConfig>\n");   
 
   sdnpmem_free(pDeviceConfig);
 }
 
 /* referenceDevice/configuration/serialConfig */
-static void TMWDEFS_LOCAL _buildSerialConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildSerialConfig(SDNPSESN *pSDNPSession)
 {
   SDNPDATA_XML_SERIALCONFIG *pSerialConfig;
  
@@ -2902,100 +2900,100 @@ static void TMWDEFS_LOCAL _buildSerialConfig(SDNPSESN *pSDNPSession, TMWTYPES_UL
   if(pSerialConfig == TMWDEFS_NULL)
     return;
 
-  _appendString(pSDNPSession, "<serialConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<serialConfig>\n");  
  
   memset(pSerialConfig, 0, sizeof(SDNPDATA_XML_SERIALCONFIG));
   if(sdnpdata_XmlGetSerialConfig(pSDNPSession->pDbHandle, pSerialConfig))
   {
     pSDNPSession->xml2CurIndent++;
-    _currentValueValueString(pSDNPSession, "portName", pSerialConfig->portName, curLen, bGetLen);
+    _currentValueValueString(pSDNPSession, "portName", pSerialConfig->portName);
   
     if(pSerialConfig->serialParameters.type == SDNPDATA_XML_SERIALPARAMASYNC)
     {
-      _currentValueString(pSDNPSession, "serialParameters", "<asynchronous />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "serialParameters", "<asynchronous />");
     }
     else if(pSerialConfig->serialParameters.type == SDNPDATA_XML_SERIALPARAMOTHER)
     {
-      _currentValueOther(pSDNPSession, "serialParameters", pSerialConfig->serialParameters.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "serialParameters", pSerialConfig->serialParameters.other);
     }
 
-   _currentValueDecimalString(pSDNPSession, "baudRate", pSerialConfig->baudRate, curLen, bGetLen);   
+   _currentValueDecimalString(pSDNPSession, "baudRate", pSerialConfig->baudRate);   
 
-   _appendString(pSDNPSession, "<flowControl>\n", curLen, bGetLen);
+   _appendString(pSDNPSession, "<flowControl>\n");
     pSDNPSession->xml2CurIndent++;
-   _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);
+   _appendString(pSDNPSession, "<currentValue>\n");
    if(pSerialConfig->flowControl.none)
    {
      pSDNPSession->xml2CurIndent++;
-     _appendString(pSDNPSession, "<none />\n", curLen, bGetLen);
-     _appendString(pSDNPSession, "<rs232Options />\n", curLen, bGetLen);
-     _appendString(pSDNPSession, "<rs422Options />\n", curLen, bGetLen); 
-     _appendString(pSDNPSession, "<rs485Options />\n", curLen, bGetLen); 
+     _appendString(pSDNPSession, "<none />\n");
+     _appendString(pSDNPSession, "<rs232Options />\n");
+     _appendString(pSDNPSession, "<rs422Options />\n"); 
+     _appendString(pSDNPSession, "<rs485Options />\n"); 
    }
    else
    {
-     _appendString(pSDNPSession, "<rs232Options>\n", curLen, bGetLen);
+     _appendString(pSDNPSession, "<rs232Options>\n");
 
       pSDNPSession->xml2CurIndent++;
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "assertsRTSBeforeTx", pSerialConfig->flowControl.rs232Options.assertsRTSBeforeTx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "assertsDTRBeforeTx", pSerialConfig->flowControl.rs232Options.assertsDTRBeforeTx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "assertsRTSBeforeRx", pSerialConfig->flowControl.rs232Options.assertsRTSBeforeRx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "assertsDTRBeforeRx", pSerialConfig->flowControl.rs232Options.assertsDTRBeforeRx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "alwaysAssertsRTS", pSerialConfig->flowControl.rs232Options.alwaysAssertsRTS); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "alwaysAssertsDTR", pSerialConfig->flowControl.rs232Options.alwaysAssertsDTR); 
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresCTSBeforeTx", pSerialConfig->flowControl.rs232Options.requiresCTSBeforeTx);
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresDCDBeforeTx", pSerialConfig->flowControl.rs232Options.requiresDCDBeforeTx);
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresDSRBeforeTx", pSerialConfig->flowControl.rs232Options.requiresDSRBeforeTx);
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresRIBeforeTx", pSerialConfig->flowControl.rs232Options.requiresRIBeforeTx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "rxInactive", pSerialConfig->flowControl.rs232Options.rxInactive); 
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresCTSBeforeRx", pSerialConfig->flowControl.rs232Options.requiresCTSBeforeRx); 
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresDCDBeforeRx", pSerialConfig->flowControl.rs232Options.requiresDCDBeforeRx); 
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresDSRBeforeRx", pSerialConfig->flowControl.rs232Options.requiresDSRBeforeRx); 
-     _assertedString(pSDNPSession, curLen, bGetLen, "requiresRIBeforeRx", pSerialConfig->flowControl.rs232Options.requiresRIBeforeRx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "alwaysIgnoresCTS", pSerialConfig->flowControl.rs232Options.alwaysIgnoresCTS); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "alwaysIgnoresDCD", pSerialConfig->flowControl.rs232Options.alwaysIgnoresDCD); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "alwaysIgnoresDSR", pSerialConfig->flowControl.rs232Options.alwaysIgnoresDSR); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "alwaysIgnoresRI", pSerialConfig->flowControl.rs232Options.alwaysIgnoresRI); 
+     _emptyElementString(pSDNPSession, "assertsRTSBeforeTx", pSerialConfig->flowControl.rs232Options.assertsRTSBeforeTx); 
+     _emptyElementString(pSDNPSession, "assertsDTRBeforeTx", pSerialConfig->flowControl.rs232Options.assertsDTRBeforeTx); 
+     _emptyElementString(pSDNPSession, "assertsRTSBeforeRx", pSerialConfig->flowControl.rs232Options.assertsRTSBeforeRx); 
+     _emptyElementString(pSDNPSession, "assertsDTRBeforeRx", pSerialConfig->flowControl.rs232Options.assertsDTRBeforeRx); 
+     _emptyElementString(pSDNPSession, "alwaysAssertsRTS", pSerialConfig->flowControl.rs232Options.alwaysAssertsRTS); 
+     _emptyElementString(pSDNPSession, "alwaysAssertsDTR", pSerialConfig->flowControl.rs232Options.alwaysAssertsDTR); 
+     _assertedString(pSDNPSession, "requiresCTSBeforeTx", pSerialConfig->flowControl.rs232Options.requiresCTSBeforeTx);
+     _assertedString(pSDNPSession, "requiresDCDBeforeTx", pSerialConfig->flowControl.rs232Options.requiresDCDBeforeTx);
+     _assertedString(pSDNPSession, "requiresDSRBeforeTx", pSerialConfig->flowControl.rs232Options.requiresDSRBeforeTx);
+     _assertedString(pSDNPSession, "requiresRIBeforeTx", pSerialConfig->flowControl.rs232Options.requiresRIBeforeTx); 
+     _emptyElementString(pSDNPSession, "rxInactive", pSerialConfig->flowControl.rs232Options.rxInactive); 
+     _assertedString(pSDNPSession, "requiresCTSBeforeRx", pSerialConfig->flowControl.rs232Options.requiresCTSBeforeRx); 
+     _assertedString(pSDNPSession, "requiresDCDBeforeRx", pSerialConfig->flowControl.rs232Options.requiresDCDBeforeRx); 
+     _assertedString(pSDNPSession, "requiresDSRBeforeRx", pSerialConfig->flowControl.rs232Options.requiresDSRBeforeRx); 
+     _assertedString(pSDNPSession, "requiresRIBeforeRx", pSerialConfig->flowControl.rs232Options.requiresRIBeforeRx); 
+     _emptyElementString(pSDNPSession, "alwaysIgnoresCTS", pSerialConfig->flowControl.rs232Options.alwaysIgnoresCTS); 
+     _emptyElementString(pSDNPSession, "alwaysIgnoresDCD", pSerialConfig->flowControl.rs232Options.alwaysIgnoresDCD); 
+     _emptyElementString(pSDNPSession, "alwaysIgnoresDSR", pSerialConfig->flowControl.rs232Options.alwaysIgnoresDSR); 
+     _emptyElementString(pSDNPSession, "alwaysIgnoresRI", pSerialConfig->flowControl.rs232Options.alwaysIgnoresRI); 
   			  
      if(pSerialConfig->flowControl.rs232Options.other[0] != 0)
      {
-       _valueOther(pSDNPSession, pSerialConfig->flowControl.rs232Options.other, curLen, bGetLen);
+       _valueOther(pSDNPSession, pSerialConfig->flowControl.rs232Options.other);
      }
 
       pSDNPSession->xml2CurIndent--;
-     _appendString(pSDNPSession, "</rs232Options>\n", curLen, bGetLen);  
+     _appendString(pSDNPSession, "</rs232Options>\n");  
 
-     _appendString(pSDNPSession, "<rs422Options>\n", curLen, bGetLen); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "requiresIndicationBeforeRx", pSerialConfig->flowControl.rs422Options.requiresIndicationBeforeRx); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "assertsControlBeforeTx", pSerialConfig->flowControl.rs422Options.assertsControlBeforeTx); 
+     _appendString(pSDNPSession, "<rs422Options>\n"); 
+     _emptyElementString(pSDNPSession, "requiresIndicationBeforeRx", pSerialConfig->flowControl.rs422Options.requiresIndicationBeforeRx); 
+     _emptyElementString(pSDNPSession, "assertsControlBeforeTx", pSerialConfig->flowControl.rs422Options.assertsControlBeforeTx); 
      if(pSerialConfig->flowControl.rs422Options.other[0] != 0)
      {
-       _valueOther(pSDNPSession, pSerialConfig->flowControl.rs422Options.other, curLen, bGetLen);
+       _valueOther(pSDNPSession, pSerialConfig->flowControl.rs422Options.other);
      }
-     _appendString(pSDNPSession, "</rs422Options>\n", curLen, bGetLen);
+     _appendString(pSDNPSession, "</rs422Options>\n");
       
-     _appendString(pSDNPSession, "<rs485Options>\n", curLen, bGetLen); 
-     _emptyElementString(pSDNPSession, curLen, bGetLen, "requiresRxInactiveBeforeTx", pSerialConfig->flowControl.rs485Options.requiresRxInactiveBeforeTx);
+     _appendString(pSDNPSession, "<rs485Options>\n"); 
+     _emptyElementString(pSDNPSession, "requiresRxInactiveBeforeTx", pSerialConfig->flowControl.rs485Options.requiresRxInactiveBeforeTx);
      if(pSerialConfig->flowControl.rs485Options.other[0] != 0)
      {
-       _valueOther(pSDNPSession, pSerialConfig->flowControl.rs485Options.other, curLen, bGetLen);
+       _valueOther(pSDNPSession, pSerialConfig->flowControl.rs485Options.other);
      }
-     _appendString(pSDNPSession, "</rs485Options>\n", curLen, bGetLen);
+     _appendString(pSDNPSession, "</rs485Options>\n");
    }
 
    pSDNPSession->xml2CurIndent--;
-   _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+   _appendString(pSDNPSession, "</currentValue>\n");  
    pSDNPSession->xml2CurIndent--;
-   _appendString(pSDNPSession, "</flowControl>\n", curLen, bGetLen);  
+   _appendString(pSDNPSession, "</flowControl>\n");  
 
     /* linkStatusInterval */
    if(pSDNPSession->dnp.linkStatusPeriod == 0)
    {
-     _currentValueString(pSDNPSession, "linkStatusInterval", "<notSupported />", curLen, bGetLen);  
+     _currentValueString(pSDNPSession, "linkStatusInterval", "<notSupported />");  
    }
    else
    {
-     _currentValueDecimalString(pSDNPSession, "linkStatusInterval", pSDNPSession->dnp.linkStatusPeriod, curLen, bGetLen);   
+     _currentValueDecimalString(pSDNPSession, "linkStatusInterval", pSDNPSession->dnp.linkStatusPeriod);   
    }
 
 
@@ -3003,66 +3001,66 @@ static void TMWDEFS_LOCAL _buildSerialConfig(SDNPSESN *pSDNPSession, TMWTYPES_UL
    if(!pSerialConfig->supportsCollisionAvoidance.supported)
    {
      pSDNPSession->xml2CurIndent++;
-    _currentValueString(pSDNPSession, "supportsCollisionAvoidance", "<no />", curLen, bGetLen);
+    _currentValueString(pSDNPSession, "supportsCollisionAvoidance", "<no />");
      pSDNPSession->xml2CurIndent--;
    }
    else
    {  
-     _appendString(pSDNPSession, "<supportsCollisionAvoidance>\n", curLen, bGetLen); 
-     _currentValueCustom(pSDNPSession, "yes", pSerialConfig->supportsCollisionAvoidance.yes, curLen, bGetLen);
-     _appendString(pSDNPSession, "</supportsCollisionAvoidance>\n", curLen, bGetLen);
+     _appendString(pSDNPSession, "<supportsCollisionAvoidance>\n"); 
+     _currentValueCustom(pSDNPSession, "yes", pSerialConfig->supportsCollisionAvoidance.yes);
+     _appendString(pSDNPSession, "</supportsCollisionAvoidance>\n");
    } 
 
 
    /* interCharacterTimeout */
    if(pSerialConfig->interCharacterTimeout.type == SDNPDATA_XML_INTERCHARNOTCHECKED)
    {
-     _currentValueString(pSDNPSession, "interCharacterTimeout", "<notChecked />", curLen, bGetLen); 
+     _currentValueString(pSDNPSession, "interCharacterTimeout", "<notChecked />"); 
    }
    else if(pSerialConfig->interCharacterTimeout.type == SDNPDATA_XML_INTERCHARNOGAPPERM)
    {
-     _currentValueString(pSDNPSession, "interCharacterTimeout", "<noGapPermitted />", curLen, bGetLen);  
+     _currentValueString(pSDNPSession, "interCharacterTimeout", "<noGapPermitted />");  
    }
    else if(pSerialConfig->interCharacterTimeout.type == SDNPDATA_XML_INTERCHARVALUEBIT)
    { 
-     _currentValueNameDecimalString(pSDNPSession, "interCharacterTimeout", "valueBitTimes", pSerialConfig->interCharacterTimeout.value.value, curLen, bGetLen);    
+     _currentValueNameDecimalString(pSDNPSession, "interCharacterTimeout", "valueBitTimes", pSerialConfig->interCharacterTimeout.value.value);    
    }
    else if(pSerialConfig->interCharacterTimeout.type == SDNPDATA_XML_INTERCHARVALUEMILL)
    { 
-     _currentValueNameDecimalString(pSDNPSession, "interCharacterTimeout", "valueMilliseconds", pSerialConfig->interCharacterTimeout.value.value, curLen, bGetLen);    
+     _currentValueNameDecimalString(pSDNPSession, "interCharacterTimeout", "valueMilliseconds", pSerialConfig->interCharacterTimeout.value.value);    
    }
    else if(pSerialConfig->interCharacterTimeout.type == SDNPDATA_XML_INTERCHARVARIABLE)
    {
-     _appendString(pSDNPSession, "<interCharacterTimeout>\n", curLen, bGetLen); 
-     _currentValueOther(pSDNPSession, "variable", pSerialConfig->interCharacterTimeout.value.variable, curLen, bGetLen);
+     _appendString(pSDNPSession, "<interCharacterTimeout>\n"); 
+     _currentValueOther(pSDNPSession, "variable", pSerialConfig->interCharacterTimeout.value.variable);
      pSDNPSession->xml2CurIndent--;
-     _appendString(pSDNPSession, "</interCharacterTimeout>\n", curLen, bGetLen);
+     _appendString(pSDNPSession, "</interCharacterTimeout>\n");
    } 
 
 
    /* interCharacterGap */
    if(pSerialConfig->interCharacterGap.type == SDNPDATA_XML_INTERCHARGAPNONE)
    { 
-     _currentValueString(pSDNPSession, "interCharacterGap",  "<none />", curLen, bGetLen);
+     _currentValueString(pSDNPSession, "interCharacterGap",  "<none />");
    }
    else if(pSerialConfig->interCharacterGap.type == SDNPDATA_XML_INTERCHARGAPMAXBIT)
    {      
-     _currentValueNameDecimalString(pSDNPSession, "interCharacterGap", "maximumBitTimes", pSerialConfig->interCharacterGap.value, curLen, bGetLen);
+     _currentValueNameDecimalString(pSDNPSession, "interCharacterGap", "maximumBitTimes", pSerialConfig->interCharacterGap.value);
    }
    else if(pSerialConfig->interCharacterGap.type == SDNPDATA_XML_INTERCHARGAPMAXMILL)
    { 
-     _currentValueNameDecimalString(pSDNPSession, "interCharacterGap", "maximumMilliseconds", pSerialConfig->interCharacterGap.value, curLen, bGetLen);
+     _currentValueNameDecimalString(pSDNPSession, "interCharacterGap", "maximumMilliseconds", pSerialConfig->interCharacterGap.value);
    }
   }
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</serialConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</serialConfig>\n");  
 
   sdnpmem_free(pSerialConfig);
 }
 
 /* referenceDevice/configuration/networkConfig */
-static void TMWDEFS_LOCAL _buildNetworkConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildNetworkConfig(SDNPSESN *pSDNPSession)
 {
   int i;
   SDNPDATA_XML_NETWORKCONFIG *pNetworkConfig;
@@ -3091,112 +3089,112 @@ static void TMWDEFS_LOCAL _buildNetworkConfig(SDNPSESN *pSDNPSession, TMWTYPES_U
   if(pNetworkConfig == TMWDEFS_NULL)
     return;
 
-  _appendString(pSDNPSession, "<networkConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<networkConfig>\n");  
 
   memset(pNetworkConfig, 0, sizeof(SDNPDATA_XML_NETWORKCONFIG));
   if(sdnpdata_XmlGetNetworkConfig(pSDNPSession->pDbHandle, pNetworkConfig))
   {
     /* portName */
     pSDNPSession->xml2CurIndent++;
-    _currentValueValueString(pSDNPSession, "portName", pNetworkConfig->portName, curLen, bGetLen);
+    _currentValueValueString(pSDNPSession, "portName", pNetworkConfig->portName);
 
     /* typeOfEndPoint */
-    _currentValueString(pSDNPSession, "typeOfEndPoint", _typeOfEndPointString(pNetworkConfig->typeOfEndPoint), curLen, bGetLen);
+    _currentValueString(pSDNPSession, "typeOfEndPoint", _typeOfEndPointString(pNetworkConfig->typeOfEndPoint));
 
     /* ipAddress */
-    _currentValueNameString(pSDNPSession, "ipAddress", "address", pNetworkConfig->ipAddress, curLen, bGetLen);
+    _currentValueNameString(pSDNPSession, "ipAddress", "address", pNetworkConfig->ipAddress);
  
     /* subnetMask */
-    _currentValueNameString(pSDNPSession, "subnetMask", "mask", pNetworkConfig->subnetMask, curLen, bGetLen);
+    _currentValueNameString(pSDNPSession, "subnetMask", "mask", pNetworkConfig->subnetMask);
  
     /* gatewayIPAddress */
-    _currentValueNameString(pSDNPSession, "gatewayIPAddress", "address", pNetworkConfig->gatewayIPAddress, curLen, bGetLen);
+    _currentValueNameString(pSDNPSession, "gatewayIPAddress", "address", pNetworkConfig->gatewayIPAddress);
 
  
     /* tcpConnectionEstablishment */ 
     if(pNetworkConfig->tcpConnectionEstablishment.type == SDNPDATA_XML_TCPOTHER)
     {     
-      _currentValueOther(pSDNPSession, "tcpConnectionEstablishment", pNetworkConfig->tcpConnectionEstablishment.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "tcpConnectionEstablishment", pNetworkConfig->tcpConnectionEstablishment.other);
     }
     else
     {
-      _currentValueString(pSDNPSession, "tcpConnectionEstablishment", _tcpConnectionEstabString(pNetworkConfig->tcpConnectionEstablishment.type), curLen, bGetLen);
+      _currentValueString(pSDNPSession, "tcpConnectionEstablishment", _tcpConnectionEstabString(pNetworkConfig->tcpConnectionEstablishment.type));
     }
     
 
     /* ipAddressOfRemoteDevice */
-    _appendString(pSDNPSession, "<ipAddressOfRemoteDevice>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<ipAddressOfRemoteDevice>\n");  
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
     for(i=0; i<SDNPXML_MAX_IPADDRESSES;i++)
     {
-      _valueString(pSDNPSession, "address", pNetworkConfig->ipAddressOfRemoteDevice[i], curLen, bGetLen);
+      _valueString(pSDNPSession, "address", pNetworkConfig->ipAddressOfRemoteDevice[i]);
     }
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</ipAddressOfRemoteDevice>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</ipAddressOfRemoteDevice>\n");  
 
     /* tcpListenPort */
     if(pNetworkConfig->tcpListenPort.notApplicable)
     {
-      _currentValueString(pSDNPSession, "tcpListenPort", "<notApplicable />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "tcpListenPort", "<notApplicable />");
     }
     else
     {
-      _currentValueDecimalString(pSDNPSession, "tcpListenPort", pNetworkConfig->tcpListenPort.value, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "tcpListenPort", pNetworkConfig->tcpListenPort.value);
     }
 
     /* tcpPortOfRemoteDevice */ 
     if(pNetworkConfig->tcpPortOfRemoteDevice.notApplicable)
     {
-      _currentValueString(pSDNPSession, "tcpPortOfRemoteDevice", "<notApplicable />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "tcpPortOfRemoteDevice", "<notApplicable />");
     }
     else
     {
-      _currentValueDecimalString(pSDNPSession, "tcpPortOfRemoteDevice", pNetworkConfig->tcpPortOfRemoteDevice.value, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "tcpPortOfRemoteDevice", pNetworkConfig->tcpPortOfRemoteDevice.value);
     }
 
     /* tcpKeepAliveTimer */
-    _currentValueDecimalString(pSDNPSession, "tcpKeepAliveTimer", pSDNPSession->dnp.linkStatusPeriod, curLen, bGetLen);   
+    _currentValueDecimalString(pSDNPSession, "tcpKeepAliveTimer", pSDNPSession->dnp.linkStatusPeriod);   
 
 
     /* localUDPPort */
     if(pNetworkConfig->localUDPPort.letSystemChoose)
     {
-      _currentValueString(pSDNPSession, "localUDPPort",  "<letSystemChoose />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "localUDPPort",  "<letSystemChoose />");
     }
     else
     {
-      _currentValueDecimalString(pSDNPSession, "localUDPPort", pNetworkConfig->localUDPPort.value, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "localUDPPort", pNetworkConfig->localUDPPort.value);
     }
 
     /* destinationUDPPort (Masters Only) */
-    /*_currentValueDecimalString(pSDNPSession, "destinationUDPPort", pNetworkConfig->destinationUDPPort, curLen, bGetLen);   */
+    /*_currentValueDecimalString(pSDNPSession, "destinationUDPPort", pNetworkConfig->destinationUDPPort);   */
 
     /* udpPortForUnsolicitedNullResponses */
     if(pNetworkConfig->udpPortForUnsolicitedNullResponses.none)
     {
-      _currentValueString(pSDNPSession, "udpPortForUnsolicitedNullResponses",  "<none />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "udpPortForUnsolicitedNullResponses",  "<none />");
     }
     else
     {
-      _currentValueDecimalString(pSDNPSession, "udpPortForUnsolicitedNullResponses", pNetworkConfig->udpPortForUnsolicitedNullResponses.value, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "udpPortForUnsolicitedNullResponses", pNetworkConfig->udpPortForUnsolicitedNullResponses.value);
     }
 
     /* udpPortForResponses */
     if(pNetworkConfig->udpPortForResponses.type == SDNPDATA_XML_UDPNONE)
     {
-      _currentValueString(pSDNPSession, "udpPortForResponses",  "<none />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "udpPortForResponses",  "<none />");
     }
     else if(pNetworkConfig->udpPortForResponses.type == SDNPDATA_XML_UDPUSESOURCE)
     {
-      _currentValueString(pSDNPSession, "udpPortForResponses",  "<useSourcePortNumber />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "udpPortForResponses",  "<useSourcePortNumber />");
     }
     else if(pNetworkConfig->udpPortForResponses.type == SDNPDATA_XML_UDPVALUE)
     {
-      _currentValueDecimalString(pSDNPSession, "udpPortForResponses", pNetworkConfig->udpPortForResponses.value, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "udpPortForResponses", pNetworkConfig->udpPortForResponses.value);
     }
 
     /* multipleOutstationConnections is a master only value */ 
@@ -3204,48 +3202,48 @@ static void TMWDEFS_LOCAL _buildNetworkConfig(SDNPSESN *pSDNPSession, TMWTYPES_U
     /* multipleMasterConnections */
     if(pNetworkConfig->multipleMasterConnections.notSupported)
     {
-      _currentValueString(pSDNPSession, "multipleMasterConnections",  "<notSupported />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "multipleMasterConnections",  "<notSupported />");
     }
     else
     {  
-      _appendString(pSDNPSession, "<multipleMasterConnections>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<multipleMasterConnections>\n");
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<currentValue>\n");
       pSDNPSession->xml2CurIndent++;
-      _emptyElementString(pSDNPSession, curLen, bGetLen, "basedOnIPAddress", pNetworkConfig->multipleMasterConnections.basedOnIPAddress); 
-      _emptyElementString(pSDNPSession, curLen, bGetLen, "basedOnIPPortNumber", pNetworkConfig->multipleMasterConnections.basedOnIPPortNumber); 
-      _emptyElementString(pSDNPSession, curLen, bGetLen, "browsingForStaticData", pNetworkConfig->multipleMasterConnections.browsingForStaticData); 
+      _emptyElementString(pSDNPSession, "basedOnIPAddress", pNetworkConfig->multipleMasterConnections.basedOnIPAddress); 
+      _emptyElementString(pSDNPSession, "basedOnIPPortNumber", pNetworkConfig->multipleMasterConnections.basedOnIPPortNumber); 
+      _emptyElementString(pSDNPSession, "browsingForStaticData", pNetworkConfig->multipleMasterConnections.browsingForStaticData); 
  
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</currentValue>\n");
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</multipleMasterConnections>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</multipleMasterConnections>\n");
     }
 
 
     /* timeSynchronization */
     if(pNetworkConfig->timeSynchronization.type == SDNPDATA_XML_TIMESYNCOTHER)
     { 
-      _currentValueOther(pSDNPSession, "timeSynchronization", pNetworkConfig->timeSynchronization.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "timeSynchronization", pNetworkConfig->timeSynchronization.other);
     }
     else
     {
-      _currentValueString(pSDNPSession, "timeSynchronization", _timeSynchronizationString(pNetworkConfig->timeSynchronization.type), curLen, bGetLen);
+      _currentValueString(pSDNPSession, "timeSynchronization", _timeSynchronizationString(pNetworkConfig->timeSynchronization.type));
     }				 
   }
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</networkConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</networkConfig>\n");  
   
   sdnpmem_free(pNetworkConfig);
 }
 
 /* referenceDevice/configuration/linkConfig */
-static void TMWDEFS_LOCAL _buildLinkConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildLinkConfig(SDNPSESN *pSDNPSession)
 {
   DNPLINK_CONTEXT *pLinkContext = (DNPLINK_CONTEXT*)pSDNPSession->dnp.tmw.pChannel->pLinkContext;
  
-  _appendString(pSDNPSession, "<linkConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<linkConfig>\n");  
   pSDNPSession->xml2CurIndent++;
   
   /*
@@ -3260,44 +3258,44 @@ static void TMWDEFS_LOCAL _buildLinkConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULON
     maxReceivedFrameSize
   */
     
-  _currentValueDecimalString(pSDNPSession, "dataLinkAddress", pSDNPSession->dnp.tmw.srcAddress, curLen, bGetLen);   
+  _currentValueDecimalString(pSDNPSession, "dataLinkAddress", pSDNPSession->dnp.tmw.srcAddress);   
 
   if(pSDNPSession->dnp.validateSourceAddress) 
-    _currentValueString(pSDNPSession, "sourceAddressValidation", "<alwaysSingleAddress />", curLen, bGetLen);  
+    _currentValueString(pSDNPSession, "sourceAddressValidation", "<alwaysSingleAddress />");  
   else
-    _currentValueString(pSDNPSession, "sourceAddressValidation", "<never />", curLen, bGetLen);  
+    _currentValueString(pSDNPSession, "sourceAddressValidation", "<never />");  
     
-  _currentValueDecimalString(pSDNPSession, "expectedSourceAddress", pSDNPSession->dnp.tmw.destAddress, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "expectedSourceAddress", pSDNPSession->dnp.tmw.destAddress);  
 
-  _currentValueString(pSDNPSession, "selfAddressSupport", _yesNoString(pSDNPSession->dnp.enableSelfAddress), curLen, bGetLen);   
+  _currentValueString(pSDNPSession, "selfAddressSupport", _yesNoString(pSDNPSession->dnp.enableSelfAddress));   
    
   if(pLinkContext->confirmMode == TMWDEFS_LINKCNFM_SOMETIMES)
   { 
-    _appendString(pSDNPSession, "<sendsConfirmedUserDataFrames>\n", curLen, bGetLen);   
-    _currentValueCustom(pSDNPSession, "sometimes", "Only for multiframe message fragment", curLen, bGetLen);
-    _appendString(pSDNPSession, "</sendsConfirmedUserDataFrames>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<sendsConfirmedUserDataFrames>\n");   
+    _currentValueCustom(pSDNPSession, "sometimes", "Only for multiframe message fragment");
+    _appendString(pSDNPSession, "</sendsConfirmedUserDataFrames>\n");   
   }
   else
-  _currentValueString(pSDNPSession, "sendsConfirmedUserDataFrames", _linkConfirmModeString(pLinkContext->confirmMode), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "sendsConfirmedUserDataFrames", _linkConfirmModeString(pLinkContext->confirmMode)); 
   
-  _currentValueDecimalString(pSDNPSession, "linkLayerConfirmTimeout", pLinkContext->confirmTimeout, curLen, bGetLen); 
+  _currentValueDecimalString(pSDNPSession, "linkLayerConfirmTimeout", pLinkContext->confirmTimeout); 
  
-  _currentValueDecimalString(pSDNPSession, "maxDataLinkRetries", pLinkContext->maxRetries, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxDataLinkRetries", pLinkContext->maxRetries);  
  
-  _currentValueDecimalString(pSDNPSession, "maxTransmittedFrameSize", pLinkContext->txFrameSize, curLen, bGetLen);   
+  _currentValueDecimalString(pSDNPSession, "maxTransmittedFrameSize", pLinkContext->txFrameSize);   
  
-  _currentValueDecimalString(pSDNPSession, "maxReceivedFrameSize", pLinkContext->rxFrameSize, curLen, bGetLen);   
+  _currentValueDecimalString(pSDNPSession, "maxReceivedFrameSize", pLinkContext->rxFrameSize);   
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</linkConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</linkConfig>\n");  
 }
 
 /* referenceDevice/configuration/applConfig */
-static void TMWDEFS_LOCAL _buildApplConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildApplConfig(SDNPSESN *pSDNPSession)
 {
   DNPCHNL *pDNPChannel = (DNPCHNL*)pSDNPSession->dnp.tmw.pChannel;
  
-  _appendString(pSDNPSession, "<applConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<applConfig>\n");  
   pSDNPSession->xml2CurIndent++;
   
   /* 
@@ -3312,30 +3310,30 @@ static void TMWDEFS_LOCAL _buildApplConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULON
     controlStatusCodesSupported (2.09)
   */
    
-  _currentValueDecimalString(pSDNPSession, "maxTransmittedFragmentSize", pDNPChannel->txFragmentSize, curLen, bGetLen);   
+  _currentValueDecimalString(pSDNPSession, "maxTransmittedFragmentSize", pDNPChannel->txFragmentSize);   
   
-  _currentValueDecimalString(pSDNPSession, "maxFileTransferTransmittedFragmentSize", pDNPChannel->txFragmentSize, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxFileTransferTransmittedFragmentSize", pDNPChannel->txFragmentSize);  
  
-  _currentValueDecimalString(pSDNPSession, "maxReceivedFragmentSize", pDNPChannel->rxFragmentSize, curLen, bGetLen);   
+  _currentValueDecimalString(pSDNPSession, "maxReceivedFragmentSize", pDNPChannel->rxFragmentSize);   
   
   /* No fragmentTimeout, there is a frame timeout */
  
-  _currentValueDecimalString(pSDNPSession, "maxObjectsInCROBControlRequest", pSDNPSession->maxControlRequests, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxObjectsInCROBControlRequest", pSDNPSession->maxControlRequests);  
    
-  _currentValueDecimalString(pSDNPSession, "maxObjectsInAnalogOutputControlRequest", pSDNPSession->maxControlRequests, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxObjectsInAnalogOutputControlRequest", pSDNPSession->maxControlRequests);  
     
-  _currentValueDecimalString(pSDNPSession, "maxObjectsInDataSetsControlRequest", DNPCNFG_MAX_DATASET_CTRLS, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxObjectsInDataSetsControlRequest", DNPCNFG_MAX_DATASET_CTRLS);  
      
-  _currentValueString(pSDNPSession, "supportsMixedObjectGroupsInControlRequest", _yesNoString(pSDNPSession->allowMultiCROBRequests), curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "supportsMixedObjectGroupsInControlRequest", _yesNoString(pSDNPSession->allowMultiCROBRequests));  
   
   /* New in schema 2.09 controlStatusCodesSupported, has no currentValues section */  
  
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</applConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</applConfig>\n");  
 }
 
 /* referenceDevice/configuration/outstationConfig */
-static void TMWDEFS_LOCAL _buildOutstationConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildOutstationConfig(SDNPSESN *pSDNPSession)
 {   
   SDNPDATA_XML_OUTSTATIONCONFIG *pOutstationConfig; 
 
@@ -3345,7 +3343,7 @@ static void TMWDEFS_LOCAL _buildOutstationConfig(SDNPSESN *pSDNPSession, TMWTYPE
 
   memset(pOutstationConfig, 0, sizeof(SDNPDATA_XML_OUTSTATIONCONFIG));
   
-  _appendString(pSDNPSession, "<outstationConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<outstationConfig>\n");  
  
   if(sdnpdata_XmlGetOutstationConfig(pSDNPSession->pDbHandle, pOutstationConfig))
   {
@@ -3366,118 +3364,118 @@ static void TMWDEFS_LOCAL _buildOutstationConfig(SDNPSESN *pSDNPSession, TMWTYPE
     */
 
     /* applicationLayerConfirmTimeout */
-    _currentValueDecimalString(pSDNPSession, "applicationLayerConfirmTimeout", pSDNPSession->applConfirmTimeout, curLen, bGetLen);  
+    _currentValueDecimalString(pSDNPSession, "applicationLayerConfirmTimeout", pSDNPSession->applConfirmTimeout);  
 
     /* timeSyncRequired */
-    _appendString(pSDNPSession, "<timeSyncRequired>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<timeSyncRequired>\n");   
     if(pOutstationConfig->timeSyncRequired.type == SDNPDATA_XML_TIMESYNCREQWITHIN)
     {  
-      _currentValueNameDecimalString(pSDNPSession, TMWDEFS_NULL, "withinSecondsOfIIN14", pOutstationConfig->timeSyncRequired.value, curLen, bGetLen);
+      _currentValueNameDecimalString(pSDNPSession, TMWDEFS_NULL, "withinSecondsOfIIN14", pOutstationConfig->timeSyncRequired.value);
     }
     else if(pOutstationConfig->timeSyncRequired.type == SDNPDATA_XML_TIMESYNCREQPERIOD)
     { 
-      _currentValueNameDecimalString(pSDNPSession, TMWDEFS_NULL, "periodically", pOutstationConfig->timeSyncRequired.value, curLen, bGetLen);
+      _currentValueNameDecimalString(pSDNPSession, TMWDEFS_NULL, "periodically", pOutstationConfig->timeSyncRequired.value);
     }
     else
     {
-      _currentValueString(pSDNPSession, TMWDEFS_NULL, "<never />", curLen, bGetLen);  
+      _currentValueString(pSDNPSession, TMWDEFS_NULL, "<never />");  
     }
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</timeSyncRequired>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</timeSyncRequired>\n");  
     
  
     /* deviceTroubleBit */
     if(pOutstationConfig->deviceTroubleBit.type == SDNPDATA_XML_DEVICETROUBLENEVER)
     {   
-      _currentValueString(pSDNPSession, "deviceTroubleBit", "<neverUsed />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "deviceTroubleBit", "<neverUsed />");
     }
     else if(pOutstationConfig->deviceTroubleBit.type == SDNPDATA_XML_DEVICETROUBLEREASON)
     {
-      _appendString(pSDNPSession, "<deviceTroubleBit>\n", curLen, bGetLen);   
-      _currentValueCustom(pSDNPSession, "reasonForSetting", pOutstationConfig->deviceTroubleBit.reasonForSetting, curLen, bGetLen); 
-      _appendString(pSDNPSession, "</deviceTroubleBit>\n", curLen, bGetLen);   
+      _appendString(pSDNPSession, "<deviceTroubleBit>\n");   
+      _currentValueCustom(pSDNPSession, "reasonForSetting", pOutstationConfig->deviceTroubleBit.reasonForSetting); 
+      _appendString(pSDNPSession, "</deviceTroubleBit>\n");   
     } 
 
 
     /* fileHandleTimeout */ 
 #if SDNPDATA_SUPPORT_OBJ70
-    _currentValueDecimalString(pSDNPSession, "fileHandleTimeout", pSDNPSession->fileTransferTimeout, curLen, bGetLen);  
+    _currentValueDecimalString(pSDNPSession, "fileHandleTimeout", pSDNPSession->fileTransferTimeout);  
 #else
-    _currentValueString(pSDNPSession, "fileHandleTimeout", "<notApplicable />\n", curLen, bGetLen);   
+    _currentValueString(pSDNPSession, "fileHandleTimeout", "<notApplicable />\n");   
 #endif
 
 
     /* eventBufferOverflowBehavior */
-    _appendString(pSDNPSession, "<eventBufferOverflowBehavior>\n", curLen, bGetLen);    
+    _appendString(pSDNPSession, "<eventBufferOverflowBehavior>\n");    
     if(pOutstationConfig->eventBufferOverflowBehavior.type == SDNPDATA_XML_EVENT_OTHER)
     {
-       _currentValueCustom(pSDNPSession, "other", pOutstationConfig->eventBufferOverflowBehavior.other, curLen, bGetLen);  
+       _currentValueCustom(pSDNPSession, "other", pOutstationConfig->eventBufferOverflowBehavior.other);  
     }
     else
     {
-      _currentValueString(pSDNPSession, TMWDEFS_NULL, _eventOverflowBehaviorString(pOutstationConfig->eventBufferOverflowBehavior.type), curLen, bGetLen);   
+      _currentValueString(pSDNPSession, TMWDEFS_NULL, _eventOverflowBehaviorString(pOutstationConfig->eventBufferOverflowBehavior.type));   
     }
-    _appendString(pSDNPSession, "</eventBufferOverflowBehavior>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</eventBufferOverflowBehavior>\n");  
 
     /* eventBufferOrganization */
-    /* was _currentValueString(pSDNPSession, "eventBufferOrganization", pOutstationConfig->eventBufferOrganization, curLen, bGetLen);  */
-    _currentValueString(pSDNPSession, "eventBufferOrganization", "<perObjectGroup />", curLen, bGetLen); 
+    /* was _currentValueString(pSDNPSession, "eventBufferOrganization", pOutstationConfig->eventBufferOrganization);  */
+    _currentValueString(pSDNPSession, "eventBufferOrganization", "<perObjectGroup />"); 
 
     /* sendsMultiFragmentResponses */
-    _currentValueString(pSDNPSession, "sendsMultiFragmentResponses", _yesNoString(pSDNPSession->multiFragRespAllowed), curLen, bGetLen); 
+    _currentValueString(pSDNPSession, "sendsMultiFragmentResponses", _yesNoString(pSDNPSession->multiFragRespAllowed)); 
       
     /* requestsLastFragmentConfirmation */
-    _appendString(pSDNPSession, "<requestsLastFragmentConfirmation>\n", curLen, bGetLen);   
-    _currentValueCustom(pSDNPSession, "sometimes", "When fragment contains events", curLen, bGetLen); 
-    _appendString(pSDNPSession, "</requestsLastFragmentConfirmation>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<requestsLastFragmentConfirmation>\n");   
+    _currentValueCustom(pSDNPSession, "sometimes", "When fragment contains events"); 
+    _appendString(pSDNPSession, "</requestsLastFragmentConfirmation>\n");   
     
 
     /* settingsPreservedThroughDeviceRestart */
-    _appendString(pSDNPSession, "<settingsPreservedThroughDeviceRestart>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<settingsPreservedThroughDeviceRestart>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<currentValue>\n"); 
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "assignClass", pOutstationConfig->settingsPreservedThroughDeviceReset.assignClass);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "analogDeadbands", pOutstationConfig->settingsPreservedThroughDeviceReset.analogDeadbands);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dataSetPrototypes", pOutstationConfig->settingsPreservedThroughDeviceReset.dataSetPrototypes);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "dataSetDescriptors", pOutstationConfig->settingsPreservedThroughDeviceReset.dataSetDescriptors);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC31ActivateConfiguration", pOutstationConfig->settingsPreservedThroughDeviceReset.FC31ActivateConfiguration); 
+    _emptyElementString(pSDNPSession, "assignClass", pOutstationConfig->settingsPreservedThroughDeviceReset.assignClass);  
+    _emptyElementString(pSDNPSession, "analogDeadbands", pOutstationConfig->settingsPreservedThroughDeviceReset.analogDeadbands);  
+    _emptyElementString(pSDNPSession, "dataSetPrototypes", pOutstationConfig->settingsPreservedThroughDeviceReset.dataSetPrototypes);  
+    _emptyElementString(pSDNPSession, "dataSetDescriptors", pOutstationConfig->settingsPreservedThroughDeviceReset.dataSetDescriptors);  
+    _emptyElementString(pSDNPSession, "FC31ActivateConfiguration", pOutstationConfig->settingsPreservedThroughDeviceReset.FC31ActivateConfiguration); 
     pSDNPSession->xml2CurIndent--; 
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</settingsPreservedThroughDeviceRestart>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</settingsPreservedThroughDeviceRestart>\n");  
    
     /* configurationSignatureSupported */ 
-    _currentValueString(pSDNPSession, "configurationSignatureSupported", "<notSupported />", curLen, bGetLen);  
+    _currentValueString(pSDNPSession, "configurationSignatureSupported", "<notSupported />");  
       
     /* requestsApplicationConfirmation */ 
-    _appendString(pSDNPSession, "<requestsApplicationConfirmation>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<requestsApplicationConfirmation>\n");
 	  pSDNPSession->xml2CurIndent++;
-	  _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);
+	  _appendString(pSDNPSession, "<currentValue>\n");
 	  pSDNPSession->xml2CurIndent++;
  
-   _valueString(pSDNPSession, "eventResponses",  _yesNoString(TMWDEFS_TRUE), curLen, bGetLen); 
-   _valueString(pSDNPSession, "nonFinalFragments",  _yesNoString(pSDNPSession->multiFragConfirm), curLen, bGetLen);  
+   _valueString(pSDNPSession, "eventResponses",  _yesNoString(TMWDEFS_TRUE)); 
+   _valueString(pSDNPSession, "nonFinalFragments",  _yesNoString(pSDNPSession->multiFragConfirm));  
    
    pSDNPSession->xml2CurIndent--;
-   _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);
+   _appendString(pSDNPSession, "</currentValue>\n");
    pSDNPSession->xml2CurIndent--;
-   _appendString(pSDNPSession, "</requestsApplicationConfirmation>\n", curLen, bGetLen);
+   _appendString(pSDNPSession, "</requestsApplicationConfirmation>\n");
 
    /* supportsDNP3ClockManagement */
-   _currentValueString(pSDNPSession, "supportsDNP3ClockManagement", _yesNoString(TMWDEFS_TRUE), curLen, bGetLen);
+   _currentValueString(pSDNPSession, "supportsDNP3ClockManagement", _yesNoString(TMWDEFS_TRUE));
   }
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</outstationConfig>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</outstationConfig>\n");
   
   sdnpmem_free(pOutstationConfig);
 }
 
 /* referenceDevice/configuration/unsolicitedConfig */
-static void TMWDEFS_LOCAL _buildUnsolicitedConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildUnsolicitedConfig(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "<unsolicitedConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<unsolicitedConfig>\n");  
   pSDNPSession->xml2CurIndent++;
   
   /*
@@ -3487,26 +3485,26 @@ static void TMWDEFS_LOCAL _buildUnsolicitedConfig(SDNPSESN *pSDNPSession, TMWTYP
     maxUnsolicitedRetries
   */
 
-  _currentValueString(pSDNPSession, "supportsUnsolicitedReporting", (pSDNPSession->unsolAllowed ? "<on />" : "<off />"), curLen, bGetLen);  
-  _currentValueDecimalString(pSDNPSession, "masterDataLinkAddress", pSDNPSession->dnp.tmw.destAddress, curLen, bGetLen);  
-  _currentValueDecimalString(pSDNPSession, "unsolicitedResponseConfirmationTimeout", pSDNPSession->applConfirmTimeout, curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "supportsUnsolicitedReporting", (pSDNPSession->unsolAllowed ? "<on />" : "<off />"));  
+  _currentValueDecimalString(pSDNPSession, "masterDataLinkAddress", pSDNPSession->dnp.tmw.destAddress);  
+  _currentValueDecimalString(pSDNPSession, "unsolicitedResponseConfirmationTimeout", pSDNPSession->applConfirmTimeout);  
 
   /* Determine whether to indicate infinite, or the value of max. unsolMaxRetries is number of retries before switching to offline retry value */
   if(pSDNPSession->unsolOfflineRetryDelay != TMWDEFS_DAYS(31))
-    _currentValueString(pSDNPSession, "maxUnsolicitedRetries",  "<infinite />", curLen, bGetLen);   
+    _currentValueString(pSDNPSession, "maxUnsolicitedRetries",  "<infinite />");   
   else
-    _currentValueDecimalString(pSDNPSession, "maxUnsolicitedRetries", pSDNPSession->unsolMaxRetries, curLen, bGetLen); 
+    _currentValueDecimalString(pSDNPSession, "maxUnsolicitedRetries", pSDNPSession->unsolMaxRetries); 
  
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</unsolicitedConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</unsolicitedConfig>\n");  
 
 }
 
 /* referenceDevice/configuration/unsolicitedResponseTriggerConditions */
-static void TMWDEFS_LOCAL _buildUnsolTriggerConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildUnsolTriggerConfig(SDNPSESN *pSDNPSession)
 {
  
-  _appendString(pSDNPSession, "<unsolicitedResponseTriggerConditions>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<unsolicitedResponseTriggerConditions>\n");  
   pSDNPSession->xml2CurIndent++;
   
   /* 
@@ -3522,24 +3520,24 @@ static void TMWDEFS_LOCAL _buildUnsolTriggerConfig(SDNPSESN *pSDNPSession, TMWTY
     otherTriggerConditions
   */
 
-  _currentValueDecimalString(pSDNPSession, "numberOfClassOneEvents", pSDNPSession->unsolMaxEvents[0], curLen, bGetLen);  
-  _currentValueDecimalString(pSDNPSession, "numberOfClassTwoEvents", pSDNPSession->unsolMaxEvents[1], curLen, bGetLen);  
-  _currentValueDecimalString(pSDNPSession, "numberOfClassThreeEvents", pSDNPSession->unsolMaxEvents[2], curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "numberOfClassOneEvents", pSDNPSession->unsolMaxEvents[0]);  
+  _currentValueDecimalString(pSDNPSession, "numberOfClassTwoEvents", pSDNPSession->unsolMaxEvents[1]);  
+  _currentValueDecimalString(pSDNPSession, "numberOfClassThreeEvents", pSDNPSession->unsolMaxEvents[2]);  
   /* totalNumberOfClassEvents */
-  _currentValueDecimalString(pSDNPSession, "holdTimeAfterClassOneEvent", pSDNPSession->unsolMaxDelay[0], curLen, bGetLen);  
-  _currentValueDecimalString(pSDNPSession, "holdTimeAfterClassTwoEvent", pSDNPSession->unsolMaxDelay[1], curLen, bGetLen);  
-  _currentValueDecimalString(pSDNPSession, "holdTimeAfterClassThreeEvent", pSDNPSession->unsolMaxDelay[2], curLen, bGetLen); 
+  _currentValueDecimalString(pSDNPSession, "holdTimeAfterClassOneEvent", pSDNPSession->unsolMaxDelay[0]);  
+  _currentValueDecimalString(pSDNPSession, "holdTimeAfterClassTwoEvent", pSDNPSession->unsolMaxDelay[1]);  
+  _currentValueDecimalString(pSDNPSession, "holdTimeAfterClassThreeEvent", pSDNPSession->unsolMaxDelay[2]); 
   /* holdTimeAfterAnyEvent */
-  _currentValueString(pSDNPSession, "retriggerHoldTimer", "<notRetriggeredForEachNewEvent />", curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "retriggerHoldTimer", "<notRetriggeredForEachNewEvent />");  
 
   /* otherTriggerConditions */
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</unsolicitedResponseTriggerConditions>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</unsolicitedResponseTriggerConditions>\n");
 } 
 
 /* referenceDevice/configuration/outstationPerformance */
-static void TMWDEFS_LOCAL _buildOutperformConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildOutperformConfig(SDNPSESN *pSDNPSession)
 {
   SDNPDATA_XML_OUTSTATIONPERFORM *pOutstationPerformConfig; 
 
@@ -3549,7 +3547,7 @@ static void TMWDEFS_LOCAL _buildOutperformConfig(SDNPSESN *pSDNPSession, TMWTYPE
 
   memset(pOutstationPerformConfig, 0, sizeof(SDNPDATA_XML_OUTSTATIONPERFORM));
  
-  _appendString(pSDNPSession, "<outstationPerformance>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<outstationPerformance>\n"); 
   
   if(sdnpdata_XmlGetOutstationPerform(pSDNPSession->pDbHandle, pOutstationPerformConfig))
   {
@@ -3565,63 +3563,63 @@ static void TMWDEFS_LOCAL _buildOutperformConfig(SDNPSESN *pSDNPSession, TMWTYPE
       nonBinaryOrDoubleBitEventError
     */
 
-    _timingPerformanceType(pSDNPSession, "maxTimeBaseDrift", &pOutstationPerformConfig->maxTimeBaseDrift, curLen, bGetLen);
+    _timingPerformanceType(pSDNPSession, "maxTimeBaseDrift", &pOutstationPerformConfig->maxTimeBaseDrift);
     
     if(pOutstationPerformConfig->outstationSetsIIN14.never)
     {
-      _currentValueString(pSDNPSession, "outstationSetsIIN14",  "<never />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "outstationSetsIIN14",  "<never />");
     }
     else
     {    
       TMWTYPES_CHAR buf[128];
 
-      _appendString(pSDNPSession, "<outstationSetsIIN14>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<outstationSetsIIN14>\n");
       pSDNPSession->xml2CurIndent++;
-      _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<currentValue>\n");
       pSDNPSession->xml2CurIndent++;
-      _emptyElementString(pSDNPSession, curLen, bGetLen, "atStartup", pOutstationPerformConfig->outstationSetsIIN14.atStartup);  
+      _emptyElementString(pSDNPSession, "atStartup", pOutstationPerformConfig->outstationSetsIIN14.atStartup);  
 
       if(pOutstationPerformConfig->outstationSetsIIN14.periodically != 0)
       {
         tmwtarg_snprintf(buf, sizeof(buf), "<periodically>%d</periodically>\n", pOutstationPerformConfig->outstationSetsIIN14.periodically); 
-        _appendString(pSDNPSession, buf, curLen, bGetLen); 
+        _appendString(pSDNPSession, buf); 
       }
       if(pOutstationPerformConfig->outstationSetsIIN14.afterLastTimeSync != 0)
       {
         tmwtarg_snprintf(buf, sizeof(buf), "<afterLastTimeSync>%d</afterLastTimeSync>\n", pOutstationPerformConfig->outstationSetsIIN14.afterLastTimeSync); 
-        _appendString(pSDNPSession, buf, curLen, bGetLen);  
+        _appendString(pSDNPSession, buf);  
       }
       if(pOutstationPerformConfig->outstationSetsIIN14.whenTimeErrorExceeds != 0)
       {
         tmwtarg_snprintf(buf, sizeof(buf), "<whenTimeErrorExceeds>%d</whenTimeErrorExceeds>\n", pOutstationPerformConfig->outstationSetsIIN14.whenTimeErrorExceeds); 
-        _appendString(pSDNPSession, buf, curLen, bGetLen);  
+        _appendString(pSDNPSession, buf);  
       }
 
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</currentValue>\n");
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</outstationSetsIIN14>\n", curLen, bGetLen);
-    }
-    _timingPerformanceType(pSDNPSession, "referenceErrorViaDNP", &pOutstationPerformConfig->referenceErrorViaDNP, curLen, bGetLen);
-    _timingPerformanceType(pSDNPSession, "delayMeasurementError", &pOutstationPerformConfig->delayMeasurementError, curLen, bGetLen);
-    _timingPerformanceType(pSDNPSession, "responseTime", &pOutstationPerformConfig->responseTime, curLen, bGetLen);
-    _timingPerformanceType(pSDNPSession, "startupToIIN14", &pOutstationPerformConfig->startupToIIN14, curLen, bGetLen);
-    _timingPerformanceType(pSDNPSession, "binaryOrDoubleBitEventError", &pOutstationPerformConfig->binaryOrDoubleBitEventError, curLen, bGetLen);
-    _timingPerformanceType(pSDNPSession, "nonBinaryOrDoubleBitEventError", &pOutstationPerformConfig->nonBinaryOrDoubleBitEventError, curLen, bGetLen);
+      _appendString(pSDNPSession, "</outstationSetsIIN14>\n");
+    }
+    _timingPerformanceType(pSDNPSession, "referenceErrorViaDNP", &pOutstationPerformConfig->referenceErrorViaDNP);
+    _timingPerformanceType(pSDNPSession, "delayMeasurementError", &pOutstationPerformConfig->delayMeasurementError);
+    _timingPerformanceType(pSDNPSession, "responseTime", &pOutstationPerformConfig->responseTime);
+    _timingPerformanceType(pSDNPSession, "startupToIIN14", &pOutstationPerformConfig->startupToIIN14);
+    _timingPerformanceType(pSDNPSession, "binaryOrDoubleBitEventError", &pOutstationPerformConfig->binaryOrDoubleBitEventError);
+    _timingPerformanceType(pSDNPSession, "nonBinaryOrDoubleBitEventError", &pOutstationPerformConfig->nonBinaryOrDoubleBitEventError);
   }
  
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</outstationPerformance>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</outstationPerformance>\n");  
 
   sdnpmem_free(pOutstationPerformConfig);
 }
 
 /* referenceDevice/configuration/fieldConfig */
-static void TMWDEFS_LOCAL _buildFieldConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildFieldConfig(SDNPSESN *pSDNPSession)
 {
   SDNPDATA_XML_FIELDCONFIG fieldConfig; 
 
-  _appendString(pSDNPSession, "<fieldConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "<fieldConfig>\n");  
   pSDNPSession->xml2CurIndent++;
 
   memset(&fieldConfig, 0, sizeof(fieldConfig));
@@ -3634,20 +3632,20 @@ static void TMWDEFS_LOCAL _buildFieldConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULO
       deviceSerialNumber
     */ 
    
-    _currentValueString(pSDNPSession, "outstationLocation", fieldConfig.outstationLocation, curLen, bGetLen);  
-    _currentValueString(pSDNPSession, "outstationId", fieldConfig.outstationId, curLen, bGetLen);  
-    _currentValueString(pSDNPSession, "outstationName", fieldConfig.outstationName, curLen, bGetLen);  
-    _currentValueString(pSDNPSession, "deviceSerialNumber", fieldConfig.deviceSerialNumber, curLen, bGetLen);   
+    _currentValueString(pSDNPSession, "outstationLocation", fieldConfig.outstationLocation);  
+    _currentValueString(pSDNPSession, "outstationId", fieldConfig.outstationId);  
+    _currentValueString(pSDNPSession, "outstationName", fieldConfig.outstationName);  
+    _currentValueString(pSDNPSession, "deviceSerialNumber", fieldConfig.deviceSerialNumber);   
 
     /* NotSupported secondaryOperatorName primaryOperatorName systemName ownerName */
   }
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</fieldConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</fieldConfig>\n");  
 }
      
 /* referenceDevice/configuration/securityConfig */
-static void TMWDEFS_LOCAL _buildSecurityConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildSecurityConfig(SDNPSESN *pSDNPSession)
 {
 #if SDNPDATA_SUPPORT_OBJ120
   SDNPAUTH_INFO *pAuthInfo = TMWDEFS_NULL;
@@ -3664,7 +3662,7 @@ static void TMWDEFS_LOCAL _buildSecurityConfig(SDNPSESN *pSDNPSession, TMWTYPES_
   
   memset(pSecurityConfig, 0, sizeof(SDNPDATA_XML_SECURITYCONFIG));
 
-  _appendString(pSDNPSession, "<securityConfig>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<securityConfig>\n"); 
   pSDNPSession->xml2CurIndent++;
 
   /*
@@ -3708,27 +3706,27 @@ static void TMWDEFS_LOCAL _buildSecurityConfig(SDNPSESN *pSDNPSession, TMWTYPES_
         maxErrorCount = pAuthInfo->maxErrorCount;
     }
 #endif
-    _currentValueNameDecimalString(pSDNPSession, "secureAuthenticationSupported", "version", version, curLen, bGetLen);
-    _currentValueNameDecimalString(pSDNPSession, "maxNumberUsers", "maxUsers", maxUsers, curLen, bGetLen);
+    _currentValueNameDecimalString(pSDNPSession, "secureAuthenticationSupported", "version", version);
+    _currentValueNameDecimalString(pSDNPSession, "maxNumberUsers", "maxUsers", maxUsers);
     if (pAuthInfo != TMWDEFS_NULL)
     {
-      _currentValueDecimalString(pSDNPSession, "securityResponseTimeout", pAuthInfo->replyTimeout, curLen, bGetLen);
-      _currentValueString(pSDNPSession, "acceptsAggressiveMode", _yesNoString(pAuthInfo->aggressiveModeSupport), curLen, bGetLen);
-      _currentValueString(pSDNPSession, "issuesAggressiveMode", _yesNoString(pAuthInfo->aggressiveModeSupport), curLen, bGetLen);
-      _currentValueDecimalString(pSDNPSession, "sessionKeyChangeInterval", (pAuthInfo->keyChangeInterval / 1000), curLen, bGetLen);
-      _currentValueDecimalString(pSDNPSession, "sessionKeyChangeMessageCount", pAuthInfo->maxKeyChangeCount, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "securityResponseTimeout", pAuthInfo->replyTimeout);
+      _currentValueString(pSDNPSession, "acceptsAggressiveMode", _yesNoString(pAuthInfo->aggressiveModeSupport));
+      _currentValueString(pSDNPSession, "issuesAggressiveMode", _yesNoString(pAuthInfo->aggressiveModeSupport));
+      _currentValueDecimalString(pSDNPSession, "sessionKeyChangeInterval", (pAuthInfo->keyChangeInterval / 1000));
+      _currentValueDecimalString(pSDNPSession, "sessionKeyChangeMessageCount", pAuthInfo->maxKeyChangeCount);
 
-      _currentValueDecimalString(pSDNPSession, "maxErrorCount", maxErrorCount, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "maxErrorCount", maxErrorCount);
 
-      _currentValueString(pSDNPSession, "macAlgorithmRequested", _toMACString(pAuthInfo->MACAlgorithm), curLen, bGetLen);
+      _currentValueString(pSDNPSession, "macAlgorithmRequested", _toMACString(pAuthInfo->MACAlgorithm));
     }
 #if SDNPCNFG_SUPPORT_SA_VERSION2
     if(pSDNPSession->dnp.operateInV2Mode)
-      _currentValueString(pSDNPSession, "keyWrapAlgorithm",  _toKeyWrapString(DNPAUTH_KEYWRAP_AES128), curLen, bGetLen);  
+      _currentValueString(pSDNPSession, "keyWrapAlgorithm",  _toKeyWrapString(DNPAUTH_KEYWRAP_AES128));  
     else
-      _currentValueString(pSDNPSession, "keyWrapAlgorithm",  _toKeyWrapString((TMWTYPES_UCHAR)SDNPXML_KEYWRAP_PER_USER), curLen, bGetLen);  
+      _currentValueString(pSDNPSession, "keyWrapAlgorithm",  _toKeyWrapString((TMWTYPES_UCHAR)SDNPXML_KEYWRAP_PER_USER));  
 #else
-    _currentValueString(pSDNPSession, "keyWrapAlgorithm",  _toKeyWrapString((TMWTYPES_UCHAR)SDNPXML_KEYWRAP_PER_USER), curLen, bGetLen);  
+    _currentValueString(pSDNPSession, "keyWrapAlgorithm",  _toKeyWrapString((TMWTYPES_UCHAR)SDNPXML_KEYWRAP_PER_USER));  
 #endif
 #endif
   if(sdnpdata_XmlGetSecurityConfig(pSDNPSession->pDbHandle, pSecurityConfig))
@@ -3737,236 +3735,236 @@ static void TMWDEFS_LOCAL _buildSecurityConfig(SDNPSESN *pSDNPSession, TMWTYPES_
     /* TLSCipherSuites */ 
     if(pSecurityConfig->TLSCipherSuites.type == SDNPDATA_XML_TLSOTHER)
     {     
-      _currentValueOther(pSDNPSession, "TLSCipherSuites", pSecurityConfig->TLSCipherSuites.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "TLSCipherSuites", pSecurityConfig->TLSCipherSuites.other);
     }
     else
     {
-      _currentValueString(pSDNPSession, "TLSCipherSuites", _tlsCipherString(pSecurityConfig->TLSCipherSuites.type), curLen, bGetLen);
+      _currentValueString(pSDNPSession, "TLSCipherSuites", _tlsCipherString(pSecurityConfig->TLSCipherSuites.type));
     }
 
     /* changeCipherRequestTimeout */
     if(pSecurityConfig->changeCipherRequestTimeout.type == SDNPDATA_XML_SECURITYVALUENA)
     {
       /* "notApplicable" */ 
-      _currentValueString(pSDNPSession, "changeCipherRequestTimeout", "<notApplicable />", curLen, bGetLen);  
+      _currentValueString(pSDNPSession, "changeCipherRequestTimeout", "<notApplicable />");  
     }
     else if(pSecurityConfig->changeCipherRequestTimeout.type == SDNPDATA_XML_SECURITYVALUEVALUE)
     {
       /* value */
-      _currentValueDecimalString(pSDNPSession, "changeCipherRequestTimeout", pSecurityConfig->changeCipherRequestTimeout.value.value, curLen, bGetLen);  
+      _currentValueDecimalString(pSDNPSession, "changeCipherRequestTimeout", pSecurityConfig->changeCipherRequestTimeout.value.value);  
     }
     else if(pSecurityConfig->changeCipherRequestTimeout.type == SDNPDATA_XML_SECURITYVALUEOTHER)
     {
       /* other */
-      _currentValueOther(pSDNPSession, "changeCipherRequestTimeout", pSecurityConfig->changeCipherRequestTimeout.value.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "changeCipherRequestTimeout", pSecurityConfig->changeCipherRequestTimeout.value.other);
     }
    
     /* numberCASupported */
-    _currentValueDecimalString(pSDNPSession, "numberCASupported", pSecurityConfig->numberCASupported, curLen, bGetLen);  
+    _currentValueDecimalString(pSDNPSession, "numberCASupported", pSecurityConfig->numberCASupported);  
 
 
     /* certificateRevocationCheckTime */
     if(pSecurityConfig->certificateRevocationCheckTime.type == SDNPDATA_XML_SECURITYVALUENA)
     {
       /* "notApplicable" */ 
-      _currentValueString(pSDNPSession, "certificateRevocationCheckTime", "<notApplicable />", curLen, bGetLen);  
+      _currentValueString(pSDNPSession, "certificateRevocationCheckTime", "<notApplicable />");  
     }
     else if(pSecurityConfig->certificateRevocationCheckTime.type == SDNPDATA_XML_SECURITYVALUEVALUE)
     {
       /* value */
-      _currentValueDecimalString(pSDNPSession, "certificateRevocationCheckTime", pSecurityConfig->certificateRevocationCheckTime.value.value, curLen, bGetLen);  
+      _currentValueDecimalString(pSDNPSession, "certificateRevocationCheckTime", pSecurityConfig->certificateRevocationCheckTime.value.value);  
     }
     else if(pSecurityConfig->certificateRevocationCheckTime.type == SDNPDATA_XML_SECURITYVALUEOTHER)
     {
       /* other */
-      _currentValueOther(pSDNPSession, "certificateRevocationCheckTime", pSecurityConfig->certificateRevocationCheckTime.value.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "certificateRevocationCheckTime", pSecurityConfig->certificateRevocationCheckTime.value.other);
     }
     
 #if SDNPDATA_SUPPORT_OBJ120
     /* additionalCriticalFCs*/
-    _appendString(pSDNPSession, "<additionalCriticalFCs>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<additionalCriticalFCs>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC0", pSecurityConfig->additionalCriticalFCs.FC0);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC1", pSecurityConfig->additionalCriticalFCs.FC1);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC7", pSecurityConfig->additionalCriticalFCs.FC7);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC8", pSecurityConfig->additionalCriticalFCs.FC8);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC9", pSecurityConfig->additionalCriticalFCs.FC9);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC10", pSecurityConfig->additionalCriticalFCs.FC10);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC11", pSecurityConfig->additionalCriticalFCs.FC11);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC12", pSecurityConfig->additionalCriticalFCs.FC12);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC22", pSecurityConfig->additionalCriticalFCs.FC22);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC23", pSecurityConfig->additionalCriticalFCs.FC23);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC25", pSecurityConfig->additionalCriticalFCs.FC25);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC26", pSecurityConfig->additionalCriticalFCs.FC26);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC27", pSecurityConfig->additionalCriticalFCs.FC27);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC28", pSecurityConfig->additionalCriticalFCs.FC28);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC30", pSecurityConfig->additionalCriticalFCs.FC30);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC129", pSecurityConfig->additionalCriticalFCs.FC129);  
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "FC130", pSecurityConfig->additionalCriticalFCs.FC130);  
+    _emptyElementString(pSDNPSession, "FC0", pSecurityConfig->additionalCriticalFCs.FC0);   
+    _emptyElementString(pSDNPSession, "FC1", pSecurityConfig->additionalCriticalFCs.FC1);   
+    _emptyElementString(pSDNPSession, "FC7", pSecurityConfig->additionalCriticalFCs.FC7);   
+    _emptyElementString(pSDNPSession, "FC8", pSecurityConfig->additionalCriticalFCs.FC8);   
+    _emptyElementString(pSDNPSession, "FC9", pSecurityConfig->additionalCriticalFCs.FC9);   
+    _emptyElementString(pSDNPSession, "FC10", pSecurityConfig->additionalCriticalFCs.FC10);   
+    _emptyElementString(pSDNPSession, "FC11", pSecurityConfig->additionalCriticalFCs.FC11);   
+    _emptyElementString(pSDNPSession, "FC12", pSecurityConfig->additionalCriticalFCs.FC12);   
+    _emptyElementString(pSDNPSession, "FC22", pSecurityConfig->additionalCriticalFCs.FC22);   
+    _emptyElementString(pSDNPSession, "FC23", pSecurityConfig->additionalCriticalFCs.FC23);  
+    _emptyElementString(pSDNPSession, "FC25", pSecurityConfig->additionalCriticalFCs.FC25);  
+    _emptyElementString(pSDNPSession, "FC26", pSecurityConfig->additionalCriticalFCs.FC26);  
+    _emptyElementString(pSDNPSession, "FC27", pSecurityConfig->additionalCriticalFCs.FC27);  
+    _emptyElementString(pSDNPSession, "FC28", pSecurityConfig->additionalCriticalFCs.FC28);  
+    _emptyElementString(pSDNPSession, "FC30", pSecurityConfig->additionalCriticalFCs.FC30);  
+    _emptyElementString(pSDNPSession, "FC129", pSecurityConfig->additionalCriticalFCs.FC129);  
+    _emptyElementString(pSDNPSession, "FC130", pSecurityConfig->additionalCriticalFCs.FC130);  
     
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</additionalCriticalFCs>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</additionalCriticalFCs>\n");  
   
 
     /* otherCriticalFragments */
-    _appendString(pSDNPSession, "<otherCriticalFragments>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<otherCriticalFragments>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<currentValue>\n");   
     pSDNPSession->xml2CurIndent++;
     for(i=0; i<SDNPXML_MAX_CRITICALFRAGMENTS; i++)
     {
-      _valueString(pSDNPSession, "note", pSecurityConfig->otherCriticalFragments[i].note, curLen, bGetLen); 
+      _valueString(pSDNPSession, "note", pSecurityConfig->otherCriticalFragments[i].note); 
     }
     for(i=0; i<SDNPXML_MAX_CRITICALFRAGMENTS; i++)
     {
-      _valueString(pSDNPSession, "criticalFragments", pSecurityConfig->otherCriticalFragments[i].criticalFragment, curLen, bGetLen);  
+      _valueString(pSDNPSession, "criticalFragments", pSecurityConfig->otherCriticalFragments[i].criticalFragment);  
     }
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</otherCriticalFragments>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</otherCriticalFragments>\n");  
 
     /* remoteUpdateKeyChangeSupported*/
-    _appendString(pSDNPSession, "<remoteUpdateKeyChangeSupported>\n", curLen, bGetLen);   
+    _appendString(pSDNPSession, "<remoteUpdateKeyChangeSupported>\n");   
     pSDNPSession->xml2CurIndent++;
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
 
     /* bySymmetricCryptography changed in 2.09 */ 
-    _valueString(pSDNPSession, "bySymmetricCryptography",  _toSymMethodString(pSecurityConfig->remoteUpdateKeyChangeSupported.symmetricCrypto), curLen, bGetLen);  
+    _valueString(pSDNPSession, "bySymmetricCryptography",  _toSymMethodString(pSecurityConfig->remoteUpdateKeyChangeSupported.symmetricCrypto));  
     
     /* byAsymmetricCryptography changed in 2.09 */ 
-    _valueString(pSDNPSession, "byAsymmetricCryptography",  _toAsymMethodString(pSecurityConfig->remoteUpdateKeyChangeSupported.asymmetricCrypto), curLen, bGetLen); 
+    _valueString(pSDNPSession, "byAsymmetricCryptography",  _toAsymMethodString(pSecurityConfig->remoteUpdateKeyChangeSupported.asymmetricCrypto)); 
  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</remoteUpdateKeyChangeSupported>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</remoteUpdateKeyChangeSupported>\n");  
 
     /* permitUserCredentialExpiry new in  2.09 */
-    _currentValueString(pSDNPSession, "permitUserCredentialExpiry", _yesNoString(pSecurityConfig->permitUserCredentialExpiry), curLen, bGetLen); 
+    _currentValueString(pSDNPSession, "permitUserCredentialExpiry", _yesNoString(pSecurityConfig->permitUserCredentialExpiry)); 
 
     /* secureAuthenticationEnabled new in  2.11 */
-    _currentValueString(pSDNPSession, "secureAuthenticationEnabled", (pSDNPSession->authenticationEnabled ? "<on />" : "<off />"), curLen, bGetLen);
+    _currentValueString(pSDNPSession, "secureAuthenticationEnabled", (pSDNPSession->authenticationEnabled ? "<on />" : "<off />"));
 
 #if SDNPCNFG_SUPPORT_SA_VERSION5
     if (pAuthInfo != TMWDEFS_NULL)
     {
       /* challengeDataLength new in  2.11 */
-      _currentValueDecimalString(pSDNPSession, "challengeDataLength", pAuthInfo->randomChallengeDataLength, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "challengeDataLength", pAuthInfo->randomChallengeDataLength);
 
       /* maxStatisticCounts new in  2.11 */;
-      _appendString(pSDNPSession, "<maxStatisticCounts>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<maxStatisticCounts>\n");
 
       pSDNPSession->xml2CurIndent++;
-      _currentValueDecimalString(pSDNPSession, "maxAuthenticationFailures", pAuthInfo->maxAuthenticationFailures, curLen, bGetLen);
-      _currentValueDecimalString(pSDNPSession, "maxReplyTimeouts", pAuthInfo->maxReplyTimeouts, curLen, bGetLen);
-      _currentValueDecimalString(pSDNPSession, "maxAuthenticationRekeys", pAuthInfo->maxAuthenticationRekeys, curLen, bGetLen);
-      _currentValueDecimalString(pSDNPSession, "maxErrorMessagesSent", pAuthInfo->maxErrorMessagesSent, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "maxAuthenticationFailures", pAuthInfo->maxAuthenticationFailures);
+      _currentValueDecimalString(pSDNPSession, "maxReplyTimeouts", pAuthInfo->maxReplyTimeouts);
+      _currentValueDecimalString(pSDNPSession, "maxAuthenticationRekeys", pAuthInfo->maxAuthenticationRekeys);
+      _currentValueDecimalString(pSDNPSession, "maxErrorMessagesSent", pAuthInfo->maxErrorMessagesSent);
       /* maxKeysDueToRestarts is on master only */ 
 
       pSDNPSession->xml2CurIndent--;
 
-      _appendString(pSDNPSession, "</maxStatisticCounts>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</maxStatisticCounts>\n");
     }
 
 #else
     /* challengeDataLength new in  2.11 */
-    _currentValueDecimalString(pSDNPSession, "challengeDataLength", 4, curLen, bGetLen);
+    _currentValueDecimalString(pSDNPSession, "challengeDataLength", 4);
 #endif
 
 #endif
   }
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</securityConfig>\n", curLen, bGetLen);  
+  _appendString(pSDNPSession, "</securityConfig>\n");  
 
   sdnpmem_free(pSecurityConfig);
 }
 
 /* referenceDevice/configuration/broadcastConfig */
-static void TMWDEFS_LOCAL _buildBroadcastConfig(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void TMWDEFS_LOCAL _buildBroadcastConfig(SDNPSESN *pSDNPSession)
 {
   TMWTYPES_CHAR *pEnabledString;
 
-  _appendString(pSDNPSession, "<broadcastConfig>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<broadcastConfig>\n");
   pSDNPSession->xml2CurIndent++;
   
-  _currentValueString(pSDNPSession, "broadcastFunctionalitySupported", _enabledString(pSDNPSession->enabledBroadcastFCs != 0), curLen, bGetLen);   
+  _currentValueString(pSDNPSession, "broadcastFunctionalitySupported", _enabledString(pSDNPSession->enabledBroadcastFCs != 0));   
    
-  _appendString(pSDNPSession, "<broadcastFunctionalityFC2Supported>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<broadcastFunctionalityFC2Supported>\n"); 
   pSDNPSession->xml2CurIndent++; 
 
   pEnabledString = _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_WRITE) 
       && (pSDNPSession->enabledBroadcastWrites & SDNPSESN_ENABLE_WRITE_CLOCK));
-  _currentValueString(pSDNPSession, "writeClock", pEnabledString, curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "writeClock", pEnabledString);  
   
   pEnabledString = _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_WRITE) 
       && (pSDNPSession->enabledBroadcastWrites & SDNPSESN_ENABLE_WRITE_LRTIME));
-  _currentValueString(pSDNPSession, "writeLastRecordedTime", pEnabledString, curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "writeLastRecordedTime", pEnabledString);  
 
   pEnabledString = _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_WRITE) 
       && (pSDNPSession->enabledBroadcastWrites & SDNPSESN_ENABLE_WRITE_CRESTART));
-  _currentValueString(pSDNPSession, "clearRestart", pEnabledString, curLen, bGetLen);
+  _currentValueString(pSDNPSession, "clearRestart", pEnabledString);
 
   pEnabledString = _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_WRITE) 
       && (pSDNPSession->enabledBroadcastWrites & SDNPSESN_ENABLE_WRITE_OTHER));
-  _currentValueString(pSDNPSession, "writeAnyOther", pEnabledString, curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "writeAnyOther", pEnabledString);  
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</broadcastFunctionalityFC2Supported>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</broadcastFunctionalityFC2Supported>\n"); 
    
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC5Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_DIRECT_OP) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC6Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_DIRECT_OP_NOACK) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC7Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC8Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_NOACK) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC9Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_CLEAR) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC10Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_CLEAR_NOACK) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC11Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_TIME) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC12Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_TIME_NOACK) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC13Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_COLD_RESTART) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC14Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_WARM_RESTART) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC15Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_INIT_DATA) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC16Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_INIT_APP) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC17Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_START_APP) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC18Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_STOP_APP) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC19Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_SAVE_CONFIG) != 0), curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC5Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_DIRECT_OP) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC6Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_DIRECT_OP_NOACK) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC7Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC8Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_NOACK) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC9Supported",  _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_CLEAR) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC10Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_CLEAR_NOACK) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC11Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_TIME) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC12Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_FRZ_TIME_NOACK) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC13Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_COLD_RESTART) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC14Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_WARM_RESTART) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC15Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_INIT_DATA) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC16Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_INIT_APP) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC17Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_START_APP) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC18Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_STOP_APP) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC19Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_SAVE_CONFIG) != 0));  
   
   pEnabledString = _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_ENABLE_UNSOL) != 0);
-  _appendString(pSDNPSession, "<broadcastFunctionalityFC20Supported>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<broadcastFunctionalityFC20Supported>\n"); 
   pSDNPSession->xml2CurIndent++;
-  _currentValueString(pSDNPSession, "byEventClass", pEnabledString, curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "byAnyOther", "<disabled />", curLen, bGetLen);   
+  _currentValueString(pSDNPSession, "byEventClass", pEnabledString);  
+  _currentValueString(pSDNPSession, "byAnyOther", "<disabled />");   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</broadcastFunctionalityFC20Supported>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</broadcastFunctionalityFC20Supported>\n"); 
   
   pEnabledString = _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_DISABLE_UNSOL) != 0);
-  _appendString(pSDNPSession, "<broadcastFunctionalityFC21Supported>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<broadcastFunctionalityFC21Supported>\n"); 
   pSDNPSession->xml2CurIndent++;
-  _currentValueString(pSDNPSession, "byEventClass", pEnabledString, curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "byAnyOther", "<disabled />", curLen, bGetLen);   
+  _currentValueString(pSDNPSession, "byEventClass", pEnabledString);  
+  _currentValueString(pSDNPSession, "byAnyOther", "<disabled />");   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</broadcastFunctionalityFC21Supported>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</broadcastFunctionalityFC21Supported>\n"); 
   
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC22Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_ASSIGN_CLASS) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC24Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_RECORD_CTIME) != 0), curLen, bGetLen);  
-  _currentValueString(pSDNPSession, "broadcastFunctionalityFC31Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_ACTIVATE_CONFIG) != 0), curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC22Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_ASSIGN_CLASS) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC24Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_RECORD_CTIME) != 0));  
+  _currentValueString(pSDNPSession, "broadcastFunctionalityFC31Supported", _enabledString((pSDNPSession->enabledBroadcastFCs & SDNPSESN_ENABLE_FC_ACTIVATE_CONFIG) != 0));  
    
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</broadcastConfig>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</broadcastConfig>\n"); 
 }       
 
 #if SDNPDATA_SUPPORT_OBJ1 
-static void _buildBinaryInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildBinaryInputGroup(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<binaryInputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<binaryInputGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
  
    /* 
@@ -3977,75 +3975,75 @@ static void _buildBinaryInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLe
      eventBufferPerObjectGroup (2.09)
    */
 
-  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj01DefaultVariation), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj01DefaultVariation));
 #if SDNPDATA_SUPPORT_OBJ2
-  _currentValueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj02DefaultVariation), curLen, bGetLen);
-  _currentValueString(pSDNPSession, "eventReportingMode",  _reportingModeString(pSDNPSession->binaryInputEventMode), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj02DefaultVariation));
+  _currentValueString(pSDNPSession, "eventReportingMode",  _reportingModeString(pSDNPSession->binaryInputEventMode));
 #endif
   
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_1_BIN_INPUTS)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_1_BIN_INPUTS)));
 #endif
   
 #if SDNPDATA_SUPPORT_OBJ2
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryInputMaxEvents, curLen, bGetLen);
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryInputMaxEvents);
 #endif
  
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</binaryInputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</binaryInputGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildBinaryInputPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildBinaryInputPoints(SDNPSESN *pSDNPSession)
 {
   TMWTYPES_USHORT numPoints;
  
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<binaryInputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<binaryInputPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
  
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_1_BIN_INPUTS, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_1_BIN_INPUTS);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   numPoints = sdnpdata_binInQuantity(pSDNPSession->pDbHandle);
   if(numPoints>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildBinaryInputPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildBinaryInputPointsTail(SDNPSESN *pSDNPSession)
 {
  
   if(sdnpdata_binInQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
      
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</binaryInputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</binaryInputPoints>\n");
   pSDNPSession->xml2CurIndent--;
 }
 #endif /* SDNPDATA_SUPPORT_OBJ1 */
 
 #if SDNPDATA_SUPPORT_OBJ3  
-static void _buildDoubleBitInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildDoubleBitInputGroup(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<doubleBitInputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<doubleBitInputGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
  
    /* defaultStaticVariation
@@ -4055,73 +4053,73 @@ static void _buildDoubleBitInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *cu
       eventBufferPerObjectGroup (2.09)
     */
 
-  _currentValueString(pSDNPSession, "defaultStaticVariation", _variationGroupString(pSDNPSession->obj03DefaultVariation), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultStaticVariation", _variationGroupString(pSDNPSession->obj03DefaultVariation));
 #if SDNPDATA_SUPPORT_OBJ4
-  _currentValueString(pSDNPSession, "defaultEventVariation", _variationGroupString(pSDNPSession->obj04DefaultVariation), curLen, bGetLen);
-  _currentValueString(pSDNPSession, "eventReportingMode", _reportingModeString(pSDNPSession->doubleInputEventMode), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultEventVariation", _variationGroupString(pSDNPSession->obj04DefaultVariation));
+  _currentValueString(pSDNPSession, "eventReportingMode", _reportingModeString(pSDNPSession->doubleInputEventMode)); 
 #endif
 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_3_DBL_INPUTS)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_3_DBL_INPUTS)));
 #endif
   
 #if SDNPDATA_SUPPORT_OBJ4
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->doubleInputMaxEvents, curLen, bGetLen);
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->doubleInputMaxEvents);
 #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</doubleBitInputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</doubleBitInputGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildDoubleBitInputPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildDoubleBitInputPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<doubleBitInputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<doubleBitInputPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
  
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_3_DBL_INPUTS, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_3_DBL_INPUTS);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_dblInQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildDoubleBitInputPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildDoubleBitInputPointsTail(SDNPSESN *pSDNPSession)
 {
   if(sdnpdata_dblInQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
      
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</doubleBitInputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</doubleBitInputPoints>\n");
   pSDNPSession->xml2CurIndent--;
 }
 #endif /* SDNPDATA_SUPPORT_OBJ3 */
 
 #if SDNPDATA_SUPPORT_OBJ10  
-static void _buildBinaryOutputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildBinaryOutputGroup(SDNPSESN *pSDNPSession)
 {
   SDNPDATA_XML_BINOUTGROUPCONFIG binOutGroupConfig;
  
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<binaryOutputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<binaryOutputGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
    
   /*	 
@@ -4144,129 +4142,129 @@ static void _buildBinaryOutputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curL
     /* minimumPulseTime */
     if(binOutGroupConfig.minimumPulseTime.type == SDNPDATA_XML_PULSEVALUEPERPOINT)
     {
-      _currentValueString(pSDNPSession, "minimumPulseTime",  "<basedOnPointIndex />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "minimumPulseTime",  "<basedOnPointIndex />");
     }
     else 
     { 
 #if TMWCNFG_SUPPORT_DOUBLE
-      _currentValueNameFloatString(pSDNPSession, "minimumPulseTime", "fixed", binOutGroupConfig.minimumPulseTime.fixedPulseValue, curLen, bGetLen);
+      _currentValueNameFloatString(pSDNPSession, "minimumPulseTime", "fixed", binOutGroupConfig.minimumPulseTime.fixedPulseValue);
 #else
-      _currentValueNameDecimalString(pSDNPSession, "minimumPulseTime", "fixed", binOutGroupConfig.minimumPulseTime.fixedPulseValue, curLen, bGetLen);
+      _currentValueNameDecimalString(pSDNPSession, "minimumPulseTime", "fixed", binOutGroupConfig.minimumPulseTime.fixedPulseValue);
 #endif
     }
 
     /* maximumPulseTime */
     if(binOutGroupConfig.maximumPulseTime.type == SDNPDATA_XML_PULSEVALUEPERPOINT)
     {
-      _currentValueString(pSDNPSession, "maximumPulseTime",  "<basedOnPointIndex />", curLen, bGetLen);
+      _currentValueString(pSDNPSession, "maximumPulseTime",  "<basedOnPointIndex />");
     }
     else
     {
 #if TMWCNFG_SUPPORT_DOUBLE
-      _currentValueNameFloatString(pSDNPSession, "maximumPulseTime", "fixed", binOutGroupConfig.maximumPulseTime.fixedPulseValue, curLen, bGetLen);
+      _currentValueNameFloatString(pSDNPSession, "maximumPulseTime", "fixed", binOutGroupConfig.maximumPulseTime.fixedPulseValue);
 #else
-      _currentValueNameDecimalString(pSDNPSession, "maximumPulseTime", "fixed", binOutGroupConfig.maximumPulseTime.fixedPulseValue, curLen, bGetLen);
+      _currentValueNameDecimalString(pSDNPSession, "maximumPulseTime", "fixed", binOutGroupConfig.maximumPulseTime.fixedPulseValue);
 #endif
     }
   }
 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_10_BIN_OUT_STATUSES)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_10_BIN_OUT_STATUSES)));
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ13
   if(binOutGroupConfig.commandEvents == SDNPDATA_XML_COMMANDEVENTSUCCESS)
   {
-    _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<onSuccess />", curLen, bGetLen);  
+    _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<onSuccess />");  
   }
   else if(binOutGroupConfig.commandEvents == SDNPDATA_XML_COMMANDEVENTALL)
   {
-    _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<allControlAttempts />", curLen, bGetLen);  
+    _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<allControlAttempts />");  
   }
   else
 #endif
-  _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<never />", curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<never />");  
 
-  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj10DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj10DefaultVariation)); 
 #if SDNPDATA_SUPPORT_OBJ11
-  _currentValueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj11DefaultVariation), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj11DefaultVariation));
 #endif
 #if SDNPDATA_SUPPORT_OBJ13
-  _currentValueString(pSDNPSession, "defaultCommandEventVariation",  _variationGroupString(pSDNPSession->obj13DefaultVariation), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultCommandEventVariation",  _variationGroupString(pSDNPSession->obj13DefaultVariation));
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ11
-  _currentValueString(pSDNPSession, "changeEventReportingMode",  _reportingModeString(pSDNPSession->binaryOutputEventMode), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "changeEventReportingMode",  _reportingModeString(pSDNPSession->binaryOutputEventMode));
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ13
-  _currentValueString(pSDNPSession, "commandEventReportingMode",  _reportingModeString(pSDNPSession->binaryOutCmdEventMode), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "commandEventReportingMode",  _reportingModeString(pSDNPSession->binaryOutCmdEventMode));
 #endif
 
-  _currentValueDecimalString(pSDNPSession, "maxTimeBetweenSelectAndOperate", pSDNPSession->selectTimeout, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxTimeBetweenSelectAndOperate", pSDNPSession->selectTimeout);  
   
 #if SDNPDATA_SUPPORT_OBJ11
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryOutputMaxEvents, curLen, bGetLen);     
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryOutputMaxEvents);     
 #endif
   
 #if SDNPDATA_SUPPORT_OBJ13
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "commandEventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryOutCmdMaxEvents, curLen, bGetLen);    
+  _currentValueNameDecimalString(pSDNPSession, "commandEventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryOutCmdMaxEvents);    
 #endif 
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</binaryOutputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</binaryOutputGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildBinaryOutputPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildBinaryOutputPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<binaryOutputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<binaryOutputPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
    
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_10_BIN_OUT_STATUSES, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_10_BIN_OUT_STATUSES);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_binOutQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildBinaryOutputPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildBinaryOutputPointsTail(SDNPSESN *pSDNPSession)
 {
   if(sdnpdata_binOutQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</binaryOutputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</binaryOutputPoints>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ10 */
 
 #if SDNPDATA_SUPPORT_OBJ20  
-static void _buildCounterGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildCounterGroup(SDNPSESN *pSDNPSession)
 {
   SDNPDATA_XML_COUNTERGROUPCONFIG cntrGroupConfig;
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<counterGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<counterGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /*	 
@@ -4285,33 +4283,33 @@ static void _buildCounterGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, T
     reportValueChangeCounterEvents (2.10)
   */
   
-  _currentValueString(pSDNPSession, "defaultCounterStaticVariation",  _variationGroupString(pSDNPSession->obj20DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultCounterStaticVariation",  _variationGroupString(pSDNPSession->obj20DefaultVariation)); 
 #if SDNPDATA_SUPPORT_OBJ22
-  _currentValueString(pSDNPSession, "defaultCounterEventVariation",  _variationGroupString(pSDNPSession->obj22DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultCounterEventVariation",  _variationGroupString(pSDNPSession->obj22DefaultVariation)); 
 #endif
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "counterClass0ResponseMode",   "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "counterClass0ResponseMode",   "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "counterClass0ResponseMode",   _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_20_RUNNING_CNTRS)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "counterClass0ResponseMode",   _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_20_RUNNING_CNTRS)));
 #endif
 #if SDNPDATA_SUPPORT_OBJ22
-  _currentValueString(pSDNPSession, "counterEventReportingMode",  _anlgReportingModeString(pSDNPSession->binaryCounterEventMode), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "counterEventReportingMode",  _anlgReportingModeString(pSDNPSession->binaryCounterEventMode));
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ21
-  _currentValueString(pSDNPSession, "defaultFrozenCounterStaticVariation",  _variationGroupString(pSDNPSession->obj21DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultFrozenCounterStaticVariation",  _variationGroupString(pSDNPSession->obj21DefaultVariation)); 
 #if SDNPDATA_SUPPORT_OBJ23
-  _currentValueString(pSDNPSession, "defaultFrozenCounterEventVariation",  _variationGroupString(pSDNPSession->obj23DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultFrozenCounterEventVariation",  _variationGroupString(pSDNPSession->obj23DefaultVariation)); 
 #endif
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "frozenCounterClass0ResponseMode",   "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "frozenCounterClass0ResponseMode",   "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "frozenCounterClass0ResponseMode",  _class0ResponseValue( _class0Response(pSDNPSession, DNPDEFS_OBJ_21_FROZEN_CNTRS)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "frozenCounterClass0ResponseMode",  _class0ResponseValue( _class0Response(pSDNPSession, DNPDEFS_OBJ_21_FROZEN_CNTRS)));
 #endif
 #endif
 
 #if SDNPDATA_SUPPORT_OBJ23
-  _currentValueString(pSDNPSession, "frozenCounterEventReportingMode",  _reportingModeString(pSDNPSession->frozenCounterEventMode), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "frozenCounterEventReportingMode",  _reportingModeString(pSDNPSession->frozenCounterEventMode)); 
 #endif
  
   memset(&cntrGroupConfig, 0, sizeof(cntrGroupConfig));
@@ -4319,91 +4317,91 @@ static void _buildCounterGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, T
   {
     if(cntrGroupConfig.counterRollOver.type == SDNPDATA_XML_CNTRROLLOVERVALUE)
     {
-      _currentValueDecimalString(pSDNPSession, "counterRollOver", cntrGroupConfig.counterRollOver.value, curLen, bGetLen);
+      _currentValueDecimalString(pSDNPSession, "counterRollOver", cntrGroupConfig.counterRollOver.value);
     }
     else if(cntrGroupConfig.counterRollOver.type == SDNPDATA_XML_CNTRROLLOVEROTHER)
     { 
-      _currentValueCustom(pSDNPSession, "counterRollOver", cntrGroupConfig.counterRollOver.other, curLen, bGetLen);
+      _currentValueCustom(pSDNPSession, "counterRollOver", cntrGroupConfig.counterRollOver.other);
     }
     else
     {
-      _currentValueString(pSDNPSession, "counterRollOver", _cntrRolloverString(cntrGroupConfig.counterRollOver.type), curLen, bGetLen);
+      _currentValueString(pSDNPSession, "counterRollOver", _cntrRolloverString(cntrGroupConfig.counterRollOver.type));
     }
 
     if(cntrGroupConfig.countersFrozen.type == SDNPDATA_XML_CNTRFROZENOTHER)
     {
-      _currentValueOther(pSDNPSession, "countersFrozen", cntrGroupConfig.countersFrozen.other, curLen, bGetLen);
+      _currentValueOther(pSDNPSession, "countersFrozen", cntrGroupConfig.countersFrozen.other);
     }
     else
     {
-      _currentValueString(pSDNPSession, "countersFrozen", _cntrFrozenString(cntrGroupConfig.countersFrozen.type), curLen, bGetLen);
+      _currentValueString(pSDNPSession, "countersFrozen", _cntrFrozenString(cntrGroupConfig.countersFrozen.type));
     }
   }
  
 #if SDNPDATA_SUPPORT_OBJ22
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryCounterMaxEvents, curLen, bGetLen);  
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->binaryCounterMaxEvents);  
 #endif
   
 #if SDNPDATA_SUPPORT_OBJ23
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "frozenEventBufferPerObjectGroup", "numEvents", pSDNPSession->frozenCounterMaxEvents, curLen, bGetLen);    
+  _currentValueNameDecimalString(pSDNPSession, "frozenEventBufferPerObjectGroup", "numEvents", pSDNPSession->frozenCounterMaxEvents);    
 #endif
 
   /* New in schema 2.10 reportValueChangeCounterEvents */
-  _currentValueString(pSDNPSession, "reportValueChangeCounterEvents", "<no />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "reportValueChangeCounterEvents", "<no />");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</counterGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</counterGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildCounterPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildCounterPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<counterPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<counterPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_20_RUNNING_CNTRS, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_20_RUNNING_CNTRS);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildCounterPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildCounterPointsTail(SDNPSESN *pSDNPSession)
 {
   if(sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
     
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</counterPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</counterPoints>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ20 */
 
 #if SDNPDATA_SUPPORT_OBJ30  
-static void _buildAnalogInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildAnalogInputGroup(SDNPSESN *pSDNPSession)
 {
   SDNPDATA_XML_ANLGINGROUPCONFIG *pConfig;
   SDNPDATA_XML_ANLGINGROUPCONFIG config;
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<analogInputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<analogInputGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
  /*  
     defaultStaticVariation
@@ -4416,16 +4414,16 @@ static void _buildAnalogInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLe
     frozenEventBufferPerObjectGroup (2.09)
     */
  
-  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj30DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj30DefaultVariation)); 
 #if SDNPDATA_SUPPORT_OBJ32
-  _currentValueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj32DefaultVariation), curLen, bGetLen); 
-  _currentValueString(pSDNPSession, "analogEventReportingMode",  _anlgReportingModeString(pSDNPSession->analogInputEventMode), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultEventVariation",  _variationGroupString(pSDNPSession->obj32DefaultVariation)); 
+  _currentValueString(pSDNPSession, "analogEventReportingMode",  _anlgReportingModeString(pSDNPSession->analogInputEventMode));
 #endif
 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "analogInputClass0ResponseMode",   "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "analogInputClass0ResponseMode",   "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "analogInputClass0ResponseMode",   _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_30_ANA_INPUTS)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "analogInputClass0ResponseMode",   _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_30_ANA_INPUTS)));
 #endif
   
   memset(&config, 0, sizeof(config));
@@ -4435,41 +4433,41 @@ static void _buildAnalogInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLe
     /* analogDeadbandAssignments */
     if(pConfig->analogDeadbandAssignments.type == SDNPDATA_XML_DDBNDASSIGNOTHER)
     {
-      _appendString(pSDNPSession, "<analogDeadbandAssignments>\n", curLen, bGetLen);
-      _currentValueCustom(pSDNPSession, "other", pConfig->analogDeadbandAssignments.other, curLen, bGetLen);
+      _appendString(pSDNPSession, "<analogDeadbandAssignments>\n");
+      _currentValueCustom(pSDNPSession, "other", pConfig->analogDeadbandAssignments.other);
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</analogDeadbandAssignments>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</analogDeadbandAssignments>\n");
     }  
     else
     {  
-      _currentValueString(pSDNPSession, "analogDeadbandAssignments", _deadbandAssignString(pConfig->analogDeadbandAssignments.type), curLen, bGetLen); 
+      _currentValueString(pSDNPSession, "analogDeadbandAssignments", _deadbandAssignString(pConfig->analogDeadbandAssignments.type)); 
     }
 
     /* analogDeadbandAlgorithm */
     if(pConfig->analogDeadbandAlgorithm.type == SDNPDATA_XML_DDBNDALGOOTHER)
     {
-      _appendString(pSDNPSession, "<analogDeadbandAlgorithm>\n", curLen, bGetLen);
-      _currentValueCustom(pSDNPSession, "other", pConfig->analogDeadbandAlgorithm.other, curLen, bGetLen);
+      _appendString(pSDNPSession, "<analogDeadbandAlgorithm>\n");
+      _currentValueCustom(pSDNPSession, "other", pConfig->analogDeadbandAlgorithm.other);
       pSDNPSession->xml2CurIndent--;
-      _appendString(pSDNPSession, "</analogDeadbandAlgorithm>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "</analogDeadbandAlgorithm>\n");
     }  
     else
     {  
-      _currentValueString(pSDNPSession, "analogDeadbandAlgorithm", _deadbandAlgorithmString(pConfig->analogDeadbandAlgorithm.type), curLen, bGetLen); 
+      _currentValueString(pSDNPSession, "analogDeadbandAlgorithm", _deadbandAlgorithmString(pConfig->analogDeadbandAlgorithm.type)); 
     }
 
 #if SDNPDATA_SUPPORT_OBJ31 
-    _currentValueString(pSDNPSession, "defaultFrozenAnalogInputStaticVariation", _variationGroupString(pSDNPSession->obj31DefaultVariation), curLen, bGetLen);
+    _currentValueString(pSDNPSession, "defaultFrozenAnalogInputStaticVariation", _variationGroupString(pSDNPSession->obj31DefaultVariation));
 #if SDNPDATA_SUPPORT_OBJ33
-    _currentValueString(pSDNPSession, "defaultFrozenAnalogInputEventVariation", _variationGroupString(pSDNPSession->obj33DefaultVariation), curLen, bGetLen);
+    _currentValueString(pSDNPSession, "defaultFrozenAnalogInputEventVariation", _variationGroupString(pSDNPSession->obj33DefaultVariation));
 #endif
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-    _currentValueString(pSDNPSession, "frozenAnalogInputClass0ResponseMode", "<basedOnPointIndex />", curLen, bGetLen);
+    _currentValueString(pSDNPSession, "frozenAnalogInputClass0ResponseMode", "<basedOnPointIndex />");
 #else
-    _currentValueString(pSDNPSession, "frozenAnalogInputClass0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_33_ANA_INPUTS)), curLen, bGetLen);
+    _currentValueString(pSDNPSession, "frozenAnalogInputClass0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_33_ANA_INPUTS)));
 #endif
 #if SDNPDATA_SUPPORT_OBJ33
-    _currentValueString(pSDNPSession, "frozenAnalogEventReportingMode", _reportingModeString(pSDNPSession->frozenAnalogInEventMode), curLen, bGetLen);
+    _currentValueString(pSDNPSession, "frozenAnalogEventReportingMode", _reportingModeString(pSDNPSession->frozenAnalogInEventMode));
 #endif
 #endif
 
@@ -4477,62 +4475,62 @@ static void _buildAnalogInputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLe
   
 #if SDNPDATA_SUPPORT_OBJ32
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->analogInputMaxEvents, curLen, bGetLen);     
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->analogInputMaxEvents);     
 #endif
 
   /* New in schema 2.09 */
 #if SDNPDATA_SUPPORT_OBJ33
-  _currentValueNameDecimalString(pSDNPSession, "frozenEventBufferPerObjectGroup", "numEvents", pSDNPSession->frozenAnalogInMaxEvents, curLen, bGetLen);
+  _currentValueNameDecimalString(pSDNPSession, "frozenEventBufferPerObjectGroup", "numEvents", pSDNPSession->frozenAnalogInMaxEvents);
 #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
   
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</analogInputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</analogInputGroup>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 
-static void _buildAnalogInputPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildAnalogInputPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<analogInputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<analogInputPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_30_ANA_INPUTS, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_30_ANA_INPUTS);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 } 
 
-static void _buildAnalogInputPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildAnalogInputPointsTail(SDNPSESN *pSDNPSession)
 {
   if(sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
     
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</analogInputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</analogInputPoints>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ30 */
 
 #if SDNPDATA_SUPPORT_OBJ40  
-static void _buildAnalogOutputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildAnalogOutputGroup(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<analogOutputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<analogOutputGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /*	 
@@ -4548,90 +4546,90 @@ static void _buildAnalogOutputGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curL
     commandEventBufferPerObjectGroup (2.09)
     */
 
-  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj40DefaultVariation), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "defaultStaticVariation",  _variationGroupString(pSDNPSession->obj40DefaultVariation));
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue( _class0Response(pSDNPSession, DNPDEFS_OBJ_40_ANA_OUT_STATUSES)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue( _class0Response(pSDNPSession, DNPDEFS_OBJ_40_ANA_OUT_STATUSES)));
 #endif
-  _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<onSuccess />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "outputCommandEventObjects",  "<onSuccess />");
 #if SDNPDATA_SUPPORT_OBJ42
-  _currentValueString(pSDNPSession, "defaultChangeEventVariation",   _variationGroupString(pSDNPSession->obj42DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultChangeEventVariation",   _variationGroupString(pSDNPSession->obj42DefaultVariation)); 
 #endif
 #if SDNPDATA_SUPPORT_OBJ43
-  _currentValueString(pSDNPSession, "defaultCommandEventVariation",   _variationGroupString(pSDNPSession->obj43DefaultVariation), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "defaultCommandEventVariation",   _variationGroupString(pSDNPSession->obj43DefaultVariation)); 
 #endif
  
 #if SDNPDATA_SUPPORT_OBJ42
-  _currentValueString(pSDNPSession, "changeEventReportingMode",  _reportingModeString(pSDNPSession->analogOutputEventMode), curLen, bGetLen); 
+  _currentValueString(pSDNPSession, "changeEventReportingMode",  _reportingModeString(pSDNPSession->analogOutputEventMode)); 
 #endif
 #if SDNPDATA_SUPPORT_OBJ43
-  _currentValueString(pSDNPSession, "commandEventReportingMode",  _reportingModeString(pSDNPSession->analogOutCmdEventMode), curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "commandEventReportingMode",  _reportingModeString(pSDNPSession->analogOutCmdEventMode));  
 #endif
   
   /* maxTimeBetweenSelectAndOperate */
-  _currentValueDecimalString(pSDNPSession, "maxTimeBetweenSelectAndOperate", pSDNPSession->selectTimeout, curLen, bGetLen);  
+  _currentValueDecimalString(pSDNPSession, "maxTimeBetweenSelectAndOperate", pSDNPSession->selectTimeout);  
  
 #if SDNPDATA_SUPPORT_OBJ42
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->analogOutputMaxEvents, curLen, bGetLen);   
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->analogOutputMaxEvents);   
 #endif  
   
 #if SDNPDATA_SUPPORT_OBJ43
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "commandEventBufferPerObjectGroup", "numEvents", pSDNPSession->analogOutCmdMaxEvents, curLen, bGetLen);     
+  _currentValueNameDecimalString(pSDNPSession, "commandEventBufferPerObjectGroup", "numEvents", pSDNPSession->analogOutCmdMaxEvents);     
 #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</analogOutputGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</analogOutputGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildAnalogOutputPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildAnalogOutputPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<analogOutputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<analogOutputPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_40_ANA_OUT_STATUSES, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_40_ANA_OUT_STATUSES);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildAnalogOutputPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildAnalogOutputPointsTail(SDNPSESN *pSDNPSession)
 { 
   if(sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
     
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</analogOutputPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</analogOutputPoints>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ40 */
 
 #if SDNPDATA_SUPPORT_OBJ70 
-static void _buildSequentialFileTransfer(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildSequentialFileTransfer(SDNPSESN *pSDNPSession)
 { 
   SDNPDATA_XML_FILECONFIG config;
 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<sequentialFileTransfer>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<sequentialFileTransfer>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<configuration>\n"); 
  
   pSDNPSession->xml2CurIndent++; 
 
@@ -4651,113 +4649,113 @@ static void _buildSequentialFileTransfer(SDNPSESN *pSDNPSession, TMWTYPES_ULONG
     /* fileAuthentication */
     if(config.fileAuthentication.type == SDNPDATA_XML_FILESOMETIMES)
     {
-      _appendString(pSDNPSession, "<fileAuthentication>\n", curLen, bGetLen);
-      _currentValueCustom(pSDNPSession, "sometimes", config.fileAuthentication.sometimes, curLen, bGetLen);
-      _appendString(pSDNPSession, "</fileAuthentication>\n", curLen, bGetLen);
+      _appendString(pSDNPSession, "<fileAuthentication>\n");
+      _currentValueCustom(pSDNPSession, "sometimes", config.fileAuthentication.sometimes);
+      _appendString(pSDNPSession, "</fileAuthentication>\n");
     }  
     else
     { 
       if(config.fileAuthentication.type == SDNPDATA_XML_FILENEVER)
       {
-        _currentValueString(pSDNPSession, "fileAuthentication", "<never />", curLen, bGetLen); 
+        _currentValueString(pSDNPSession, "fileAuthentication", "<never />"); 
       }
       else if(config.fileAuthentication.type == SDNPDATA_XML_FILEALWAYS)
       {
-        _currentValueString(pSDNPSession, "fileAuthentication", "<always />", curLen, bGetLen); 
+        _currentValueString(pSDNPSession, "fileAuthentication", "<always />"); 
       }
     }
 
     /* fileAppendMode */ 
     if(config.fileAppendMode.type == SDNPDATA_XML_FILESOMETIMES)
     {
-      _appendString(pSDNPSession, "<fileAppendMode>\n", curLen, bGetLen);
-      _currentValueCustom(pSDNPSession, "sometimes", config.fileAppendMode.sometimes, curLen, bGetLen);
-      _appendString(pSDNPSession, "</fileAppendMode>\n", curLen, bGetLen); 
+      _appendString(pSDNPSession, "<fileAppendMode>\n");
+      _currentValueCustom(pSDNPSession, "sometimes", config.fileAppendMode.sometimes);
+      _appendString(pSDNPSession, "</fileAppendMode>\n"); 
     }  
     else
     { 
       if(config.fileAppendMode.type == SDNPDATA_XML_FILENEVER)
       {
-        _currentValueString(pSDNPSession, "fileAppendMode", "<never />", curLen, bGetLen); 
+        _currentValueString(pSDNPSession, "fileAppendMode", "<never />"); 
       }
       else if(config.fileAppendMode.type == SDNPDATA_XML_FILEALWAYS)
       {
-        _currentValueString(pSDNPSession, "fileAppendMode", "<always />", curLen, bGetLen); 
+        _currentValueString(pSDNPSession, "fileAppendMode", "<always />"); 
       }
     }
 
     /* permissionsSupport */
-    _appendString(pSDNPSession, "<permissionsSupport>\n", curLen, bGetLen);
+    _appendString(pSDNPSession, "<permissionsSupport>\n");
     pSDNPSession->xml2CurIndent++;
 
-    _appendString(pSDNPSession, "<currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "<currentValue>\n");  
     pSDNPSession->xml2CurIndent++;
 
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "ownerReadAllowed", config.permissionsSupport.ownerReadAllowed);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "ownerWriteAllowed", config.permissionsSupport.ownerWriteAllowed);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "ownerExecuteAllowed", config.permissionsSupport.ownerExecuteAllowed);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "groupReadAllowed", config.permissionsSupport.groupReadAllowed);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "groupWriteAllowed", config.permissionsSupport.groupWriteAllowed);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "groupExecuteAllowed", config.permissionsSupport.groupExecuteAllowed);   
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "worldReadAllowed", config.permissionsSupport.worldReadAllowed);    
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "worldWriteAllowed", config.permissionsSupport.worldWriteAllowed);    
-    _emptyElementString(pSDNPSession, curLen, bGetLen, "worldExecuteAllowed", config.permissionsSupport.worldExecuteAllowed);
+    _emptyElementString(pSDNPSession, "ownerReadAllowed", config.permissionsSupport.ownerReadAllowed);   
+    _emptyElementString(pSDNPSession, "ownerWriteAllowed", config.permissionsSupport.ownerWriteAllowed);   
+    _emptyElementString(pSDNPSession, "ownerExecuteAllowed", config.permissionsSupport.ownerExecuteAllowed);   
+    _emptyElementString(pSDNPSession, "groupReadAllowed", config.permissionsSupport.groupReadAllowed);   
+    _emptyElementString(pSDNPSession, "groupWriteAllowed", config.permissionsSupport.groupWriteAllowed);   
+    _emptyElementString(pSDNPSession, "groupExecuteAllowed", config.permissionsSupport.groupExecuteAllowed);   
+    _emptyElementString(pSDNPSession, "worldReadAllowed", config.permissionsSupport.worldReadAllowed);    
+    _emptyElementString(pSDNPSession, "worldWriteAllowed", config.permissionsSupport.worldWriteAllowed);    
+    _emptyElementString(pSDNPSession, "worldExecuteAllowed", config.permissionsSupport.worldExecuteAllowed);
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</currentValue>\n", curLen, bGetLen);  
+    _appendString(pSDNPSession, "</currentValue>\n");  
 
     pSDNPSession->xml2CurIndent--;
-    _appendString(pSDNPSession, "</permissionsSupport>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</permissionsSupport>\n"); 
 
     /* multipleBlocksInFragment */
-    _currentValueString(pSDNPSession, "multipleBlocksInFragment", _yesNoString(TMWDEFS_FALSE), curLen, bGetLen); 
+    _currentValueString(pSDNPSession, "multipleBlocksInFragment", _yesNoString(TMWDEFS_FALSE)); 
 
     /* maxOpenFiles */ 
-    _currentValueDecimalString(pSDNPSession, "maxOpenFiles", 1, curLen, bGetLen);   
+    _currentValueDecimalString(pSDNPSession, "maxOpenFiles", 1);   
   }
   #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
   
-  _appendString(pSDNPSession, "</sequentialFileTransfer>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</sequentialFileTransfer>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildSequentialFiles(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildSequentialFiles(SDNPSESN *pSDNPSession)
 { 
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<sequentialFiles>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<sequentialFiles>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<configuration>\n"); 
  
   pSDNPSession->xml2CurIndent++; 
 
   /* fileListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_70_FILE_IDENTIFIER, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_70_FILE_IDENTIFIER);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
   
-  _appendString(pSDNPSession, "<files>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "<files>\n"); 
 }
 
-static void _buildSequentialFilesTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildSequentialFilesTail(SDNPSESN *pSDNPSession)
 {
-  _appendString(pSDNPSession, "</files>\n", curLen, bGetLen); 
+  _appendString(pSDNPSession, "</files>\n"); 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</sequentialFiles>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</sequentialFiles>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ70 */
 
 #if SDNPDATA_SUPPORT_OBJ110
-static void _buildOctetStringGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildOctetStringGroup(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<octetStringGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<octetStringGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /*
@@ -4768,76 +4766,76 @@ static void _buildOctetStringGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLe
   */
   
 #if SDNPDATA_SUPPORT_OBJ111
-  _currentValueString(pSDNPSession, "eventReportingMode", _reportingModeString(pSDNPSession->stringEventMode), curLen, bGetLen);  
+  _currentValueString(pSDNPSession, "eventReportingMode", _reportingModeString(pSDNPSession->stringEventMode));  
 #endif
 
 #if SDNPDATA_SUPPORT_CLASS0_POINT
-  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", "<basedOnPointIndex />");
 #else
-  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_110_STRING_DATA)), curLen, bGetLen);
+  _currentValueString(pSDNPSession, "class0ResponseMode", _class0ResponseValue(_class0Response(pSDNPSession, DNPDEFS_OBJ_110_STRING_DATA)));
 #endif
  
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->stringMaxEvents, curLen, bGetLen);   
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->stringMaxEvents);   
 
 #if SDNPDATA_SUPPORT_OBJ111
 #if SDNPDATA_SUPPORT_OBJ114
   /* New in schema 2.10 */
-  _currentValueString(pSDNPSession, "objectGroupSelection", "<basedOnPointIndex />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "objectGroupSelection", "<basedOnPointIndex />");
 #else
    /* New in schema 2.10 */
-  _currentValueString(pSDNPSession, "objectGroupSelection", "<fixedGroup110 />", curLen, bGetLen);
+  _currentValueString(pSDNPSession, "objectGroupSelection", "<fixedGroup110 />");
 #endif
 #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</octetStringGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</octetStringGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
  
-static void _buildOctetStringPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildOctetStringPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<octetStringPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<octetStringPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_110_STRING_DATA, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_110_STRING_DATA);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_strQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildOctetStringPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildOctetStringPointsTail(SDNPSESN *pSDNPSession)
 {
   if(sdnpdata_strQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
     
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</octetStringPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</octetStringPoints>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ110 */
 
 #if SDNPDATA_SUPPORT_OBJ112
-static void _buildVirtualTerminalGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildVirtualTerminalGroup(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<virtualTerminalGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<virtualTerminalGroup>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
   
   /*
@@ -4845,86 +4843,57 @@ static void _buildVirtualTerminalGroup(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *c
    */
 #if SDNPDATA_SUPPORT_OBJ113
   /* New in schema 2.09 */
-  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->virtualTerminalMaxEvents, curLen, bGetLen);
+  _currentValueNameDecimalString(pSDNPSession, "eventBufferPerObjectGroup", "numEvents", pSDNPSession->virtualTerminalMaxEvents);
 #endif
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</virtualTerminalGroup>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</virtualTerminalGroup>\n");
   pSDNPSession->xml2CurIndent--;
 }
 
-static void _buildVirtualTerminalPoints(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildVirtualTerminalPoints(SDNPSESN *pSDNPSession)
 {
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<virtualTerminalPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<virtualTerminalPoints>\n");
   pSDNPSession->xml2CurIndent++;
-  _appendString(pSDNPSession, "<configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "<configuration>\n");
   pSDNPSession->xml2CurIndent++;
 
   
   /* pointListDefinition */
-  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_112_VTERM_OUTPUT, curLen, bGetLen);
+  _pointListDefinition(pSDNPSession, DNPDEFS_OBJ_112_VTERM_OUTPUT);
 
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</configuration>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</configuration>\n");
 
   if(sdnpdata_vtermQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "<dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "<dataPoints>\n"); 
   }
 }
 
-static void _buildVirtualTerminalPointsTail(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *curLen, TMWTYPES_BOOL bGetLen)
+static void _buildVirtualTerminalPointsTail(SDNPSESN *pSDNPSession)
 {
   if(sdnpdata_vtermQuantity(pSDNPSession->pDbHandle)>0)
   {
-    _appendString(pSDNPSession, "</dataPoints>\n", curLen, bGetLen); 
+    _appendString(pSDNPSession, "</dataPoints>\n"); 
   }
     
   pSDNPSession->xml2CurIndent--;
-  _appendString(pSDNPSession, "</virtualTerminalPoints>\n", curLen, bGetLen);
+  _appendString(pSDNPSession, "</virtualTerminalPoints>\n");
   pSDNPSession->xml2CurIndent--;
 } 
 #endif /* SDNPDATA_SUPPORT_OBJ112 */
 
 #if SDNPDATA_SUPPORT_DATASETS
 
-/* routine: _buildDatasetProtoGetLen */
-void _buildDatasetProtoGetLen(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen)
-{ 
-  TMWTYPES_USHORT pointNum; 
-  TMWTYPES_USHORT numPoints;
-
-  numPoints = sdnpdata_datasetProtoQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
-  {  
-    TMWTYPES_UCHAR elemNum; 
-    TMWTYPES_UCHAR  numElems;   
-    DNPDATA_DATASET_DESCR_ELEM *pDescrElems; 
-    TMWTYPES_UCHAR uuid[16];
-
-    void *pProtoPoint = sdnpdata_datasetProtoGetPoint(pSDNPSession->pDbHandle, pointNum); 
-    if(pProtoPoint == TMWDEFS_NULL)
-      continue;
-        
-    pDescrElems = sdnpdata_datasetProtoRead(pProtoPoint, &numElems, (TMWTYPES_UCHAR*)&uuid);  
-    _buildDatasetProtoStart(pSDNPSession, pProtoPoint, uuid, pointNum, pCurLen, TMWDEFS_TRUE); 
-
-    for(elemNum = 0; elemNum < numElems; elemNum++)
-    { 
-      _buildDatasetProtoElem(pSDNPSession, pDescrElems, elemNum, pCurLen, TMWDEFS_TRUE); 
-    }
-
-    _buildDatasetProtoEnd(pSDNPSession, pCurLen, TMWDEFS_TRUE); 
-  }
-}
-
 /* function: _buildDatasetProto */
-void _buildDatasetProto(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPES_ULONG *pTestLen, TMWTYPES_ULONG maxLen)
+static void _buildDatasetProto(SDNPSESN *pSDNPSession)
 { 
+  SDNPXMLW_STREAM *pStream = &pSDNPSession->xml2Stream;
   TMWTYPES_UCHAR  saveIndent;
   TMWTYPES_USHORT pointNum; 
   TMWTYPES_USHORT numPoints;
@@ -4945,11 +4914,10 @@ void _buildDatasetProto(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
     if(pSDNPSession->xml2SaveSubState == SDNPXML2_SAVE_DATASETSTART)
     {
       saveIndent = pSDNPSession->xml2CurIndent;
-      _buildDatasetProtoStart(pSDNPSession, pProtoPoint, uuid, pointNum, pTestLen, TMWDEFS_TRUE); 
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (*pTestLen<maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetProtoStart(pSDNPSession, pProtoPoint, uuid, pointNum);
+      if(_endElement(pSDNPSession, saveIndent))
       {
-        _buildDatasetProtoStart(pSDNPSession, pProtoPoint, uuid, pointNum, pCurLen, TMWDEFS_FALSE); 
         pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETELEM;
       }
       else
@@ -4962,17 +4930,16 @@ void _buildDatasetProto(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
       for(elemNum = pSDNPSession->xml2CurSaveElemNum; elemNum < numElems; elemNum++)
       { 
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildDatasetProtoElem(pSDNPSession, pDescrElems, elemNum, pTestLen, TMWDEFS_TRUE); 
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (*pTestLen<maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDatasetProtoElem(pSDNPSession, pDescrElems, elemNum);
+        if(_endElement(pSDNPSession, saveIndent))
         {
-          _buildDatasetProtoElem(pSDNPSession, pDescrElems, elemNum, pCurLen, TMWDEFS_FALSE); 
           pSDNPSession->xml2CurSaveElemNum++;
         }
         else
           break;
       }
-      if (*pTestLen>=maxLen)
+      if(pStream->full)
         break;
 
       pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETEND;
@@ -4982,11 +4949,11 @@ void _buildDatasetProto(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
     if(pSDNPSession->xml2SaveSubState == SDNPXML2_SAVE_DATASETEND)
     { 
       saveIndent = pSDNPSession->xml2CurIndent;
-      _buildDatasetProtoEnd(pSDNPSession, pTestLen, TMWDEFS_TRUE); 
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (*pTestLen<maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetProtoEnd(pSDNPSession);
+      if(_endElement(pSDNPSession, saveIndent))
       {
-        _buildDatasetProtoEnd(pSDNPSession, pCurLen, TMWDEFS_FALSE);
+        pSDNPSession->xml2CurSavePointNum = pointNum+1;
         pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETSTART;
       }
       else
@@ -4995,39 +4962,10 @@ void _buildDatasetProto(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
   }
 }
 
-/* routine: _buildDatasetDescrGetLen */
-void _buildDatasetDescrGetLen(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen)
-{ 
-  TMWTYPES_USHORT pointNum;
-  TMWTYPES_USHORT numPoints = sdnpdata_datasetDescrQuantity(pSDNPSession->pDbHandle);
-      
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {  
-    DNPDATA_DATASET_DESCR_ELEM *pDescrElems; 
-    TMWTYPES_UCHAR elemNum; 
-    TMWTYPES_UCHAR numElems;  
-
-    void *pDescrPoint = sdnpdata_datasetDescrGetPoint(pSDNPSession->pDbHandle, pointNum); 
-    if(pDescrPoint == TMWDEFS_NULL)
-      continue;
-
-    _buildDatasetDescrStart(pSDNPSession, pDescrPoint, pointNum, pCurLen, TMWDEFS_TRUE); 
-   
-    pDescrElems = sdnpdata_datasetDescrReadCont(pDescrPoint, &numElems);
-    for(elemNum = 0; elemNum < numElems; elemNum++)
-    { 
-      _buildDatasetDescrElem(pSDNPSession, pDescrElems, elemNum, pCurLen, TMWDEFS_TRUE); 
-    }
-
-    _buildDatasetDescrIndex(pSDNPSession,pSDNPSession->pDbHandle, pointNum, pCurLen, TMWDEFS_TRUE); 
-    
-    _buildDatasetDescrData(pSDNPSession,pSDNPSession->pDbHandle, pointNum, pCurLen, TMWDEFS_TRUE); 
-  }
-}
-
 /* routine: _buildDatasetDescr */
-void _buildDatasetDescr(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPES_ULONG *pTestLen, TMWTYPES_ULONG maxLen)
+static void _buildDatasetDescr(SDNPSESN *pSDNPSession)
 { 
+  SDNPXMLW_STREAM *pStream = &pSDNPSession->xml2Stream;
   TMWTYPES_UCHAR  saveIndent;
   TMWTYPES_USHORT  pointNum;
   TMWTYPES_USHORT numPoints = sdnpdata_datasetDescrQuantity(pSDNPSession->pDbHandle);
@@ -5041,11 +4979,10 @@ void _buildDatasetDescr(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
     if(pSDNPSession->xml2SaveSubState == SDNPXML2_SAVE_DATASETSTART)
     {
       saveIndent = pSDNPSession->xml2CurIndent;
-      _buildDatasetDescrStart(pSDNPSession, pDescrPoint, pointNum, pTestLen, TMWDEFS_TRUE); 
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (*pTestLen<maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetDescrStart(pSDNPSession, pDescrPoint, pointNum);
+      if(_endElement(pSDNPSession, saveIndent))
       {
-        _buildDatasetDescrStart(pSDNPSession, pDescrPoint, pointNum, pCurLen, TMWDEFS_FALSE); 
         pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETELEM;
       }
       else
@@ -5061,17 +4998,16 @@ void _buildDatasetDescr(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
       for(elemNum = pSDNPSession->xml2CurSaveElemNum; elemNum < numElems; elemNum++)
       { 
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildDatasetDescrElem(pSDNPSession, pDescrElems, elemNum, pTestLen, TMWDEFS_TRUE); 
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (*pTestLen<maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDatasetDescrElem(pSDNPSession, pDescrElems, elemNum);
+        if(_endElement(pSDNPSession, saveIndent))
         {
-          _buildDatasetDescrElem(pSDNPSession, pDescrElems, elemNum, pCurLen, TMWDEFS_FALSE); 
           pSDNPSession->xml2CurSaveElemNum++;
         }
         else
           break;
       }
-      if (*pTestLen>=maxLen)
+      if(pStream->full)
         break;
 
       pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETINDEX;
@@ -5081,11 +5017,10 @@ void _buildDatasetDescr(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
     if(pSDNPSession->xml2SaveSubState == SDNPXML2_SAVE_DATASETINDEX)
     {
       saveIndent = pSDNPSession->xml2CurIndent;
-      _buildDatasetDescrIndex(pSDNPSession,pSDNPSession->pDbHandle, pointNum, pTestLen, TMWDEFS_TRUE); 
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (*pTestLen<maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetDescrIndex(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+      if(_endElement(pSDNPSession, saveIndent))
       {
-        _buildDatasetDescrIndex(pSDNPSession,pSDNPSession->pDbHandle, pointNum, pCurLen, TMWDEFS_FALSE);
         pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETDATA;
       }
       else
@@ -5094,11 +5029,10 @@ void _buildDatasetDescr(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
     if(pSDNPSession->xml2SaveSubState == SDNPXML2_SAVE_DATASETDATA)
     {
       saveIndent = pSDNPSession->xml2CurIndent;
-      _buildDatasetDescrData(pSDNPSession,pSDNPSession->pDbHandle, pointNum, pTestLen, TMWDEFS_TRUE); 
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (*pTestLen<maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDatasetDescrData(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+      if(_endElement(pSDNPSession, saveIndent))
       {
-        _buildDatasetDescrData(pSDNPSession,pSDNPSession->pDbHandle, pointNum, pCurLen, TMWDEFS_FALSE); 
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
         pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETSTART;
       }
@@ -5109,31 +5043,17 @@ void _buildDatasetDescr(SDNPSESN *pSDNPSession, TMWTYPES_ULONG *pCurLen, TMWTYPE
 }
 #endif  /* SDNPDATA_SUPPORT_DATASETS */
 
-/* routine: sdnpxml2_saveDatabase */
-SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWTYPES_CHAR *pBuffer, TMWTYPES_ULONG maxLen)
+/* function: _saveDatabase
+ *  write the device profile from the current save state into the session
+ *  stream until it is complete or the stream is full
+ */
+static SDNPXML2_SAVE_STATE TMWDEFS_LOCAL _saveDatabase(SDNPSESN *pSDNPSession)
 {
-  SDNPSESN *pSDNPSession;
-  SDNPXML2_SAVE_STATE prevState;
-  SDNPXML2_SAVE_SUBSTATE prevSubState;
+  SDNPXMLW_STREAM *pStream = &pSDNPSession->xml2Stream;
   TMWTYPES_UCHAR  saveIndent;
   TMWTYPES_USHORT numPoints;
   TMWTYPES_USHORT pointNum; 
-  TMWTYPES_USHORT prevPointNum;
-  TMWTYPES_UCHAR  prevElemNum;
   TMWTYPES_BOOL   loopControl = TMWDEFS_TRUE;
-  TMWTYPES_ULONG  curLen=0;
-  TMWTYPES_ULONG  testLen=0;
-
-  pSDNPSession = (SDNPSESN *)pSession;
-  pSDNPSession->pXml2Buffer = pBuffer;
-
-  if(pSDNPSession == TMWDEFS_NULL)
-    return(SDNPXML2_SAVE_FAILED);
-
-  prevState = pSDNPSession->xml2SaveState;
-  prevPointNum = pSDNPSession->xml2CurSavePointNum;
-  prevElemNum = pSDNPSession->xml2CurSaveElemNum;
-  prevSubState = pSDNPSession->xml2SaveSubState;
 
   /* Loop till a break is reached */
   while(loopControl)
@@ -5142,85 +5062,78 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
     switch (pSDNPSession->xml2SaveState)
     {
     case SDNPXML2_SAVE_DOC_HEADER:
-      _buildDocHeader(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDocHeader(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildDocHeader(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_CONFIG_HEAD;
       continue;
       break;
       
     case SDNPXML2_SAVE_CONFIG_HEAD:
-      _buildConfigurationHeader(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildConfigurationHeader(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildConfigurationHeader(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_CONFIG; 
       continue;
       break;
 
     case SDNPXML2_SAVE_CONFIG:
-      _buildDeviceConfig(pSDNPSession, &testLen, TMWDEFS_TRUE); 
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDeviceConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDeviceConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_SERIALCONFIG;
       continue;
       break;
 
     case SDNPXML2_SAVE_SERIALCONFIG: 
-      _buildSerialConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
+      sdnpxmlw_startElement(pStream);
+      _buildSerialConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildSerialConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_NETWORKCONFIG;
       continue;
       break;
 
     case SDNPXML2_SAVE_NETWORKCONFIG:
-      _buildNetworkConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildNetworkConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildNetworkConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_LINKCONFIG;
       continue;
       break;
 
     case SDNPXML2_SAVE_LINKCONFIG:  
-      _buildLinkConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildLinkConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildLinkConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_APPLCONFIG;
       continue;
       break;
 
     case SDNPXML2_SAVE_APPLCONFIG:
-     _buildApplConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
-        break;
-      }
-      _buildApplConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
+     sdnpxmlw_startElement(pStream);
+     _buildApplConfig(pSDNPSession);
+     if(!_endElement(pSDNPSession, saveIndent))
+     {
+       break;
+     }
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_OUTSTATIONCONFIG;
       continue;
       break;
@@ -5228,122 +5141,112 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       /* skip masterConfig */
 
     case SDNPXML2_SAVE_OUTSTATIONCONFIG:
-      _buildOutstationConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildOutstationConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildOutstationConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_UNSOLCONFIG; 
       continue;
       break;
 
     case SDNPXML2_SAVE_UNSOLCONFIG:
-      _buildUnsolicitedConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildUnsolicitedConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildUnsolicitedConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_UNSOLTRIGGERCONFIG; 
       continue;
       break;
 
     case SDNPXML2_SAVE_UNSOLTRIGGERCONFIG:
-      _buildUnsolTriggerConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildUnsolTriggerConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildUnsolTriggerConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_OUTPERFORMCONFIG; 
       continue;
       break;
 
     case SDNPXML2_SAVE_OUTPERFORMCONFIG:
-      _buildOutperformConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildOutperformConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildOutperformConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_FIELDCONFIG; 
       continue;
       break;
 
     case SDNPXML2_SAVE_FIELDCONFIG:
-      _buildFieldConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildFieldConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildFieldConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_SECURITYCONFIG; 
       continue;
       break;
 
     case SDNPXML2_SAVE_SECURITYCONFIG:
-      _buildSecurityConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildSecurityConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildSecurityConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BROADCASTCONFIG; 
       continue;
       break;
       
     case SDNPXML2_SAVE_BROADCASTCONFIG:
-      _buildBroadcastConfig(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildBroadcastConfig(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildBroadcastConfig(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_CONFIG_TAIL; 
       continue;
       break;
       
     case SDNPXML2_SAVE_CONFIG_TAIL:
-      _buildConfigurationTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildConfigurationTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildConfigurationTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DATABASE_HEAD;
       continue;
       break;
 
     case SDNPXML2_SAVE_DATABASE_HEAD:
-      _buildDatabaseHeader(pSDNPSession,  &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDatabaseHeader(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDatabaseHeader(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BIN_IN;
       continue;
       break;
 
     case SDNPXML2_SAVE_BIN_IN:
 #if SDNPDATA_SUPPORT_OBJ1
-      _buildBinaryInputGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildBinaryInputGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildBinaryInputGroup(pSDNPSession, &curLen, TMWDEFS_FALSE);
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DBL_IN;
@@ -5352,13 +5255,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
     case SDNPXML2_SAVE_DBL_IN:
 #if SDNPDATA_SUPPORT_OBJ3  
-      _buildDoubleBitInputGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDoubleBitInputGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDoubleBitInputGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
       
@@ -5369,13 +5271,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_BIN_OUT:
 #if SDNPDATA_SUPPORT_OBJ10  
-      _buildBinaryOutputGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildBinaryOutputGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildBinaryOutputGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BIN_COUNTER;
@@ -5384,13 +5285,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_BIN_COUNTER:
 #if SDNPDATA_SUPPORT_OBJ20  
-      _buildCounterGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildCounterGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildCounterGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_ANALOG_IN;
@@ -5399,13 +5299,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_ANALOG_IN:
 #if SDNPDATA_SUPPORT_OBJ30  
-      _buildAnalogInputGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogInputGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildAnalogInputGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_ANALOG_OUT;
@@ -5414,13 +5313,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
  case SDNPXML2_SAVE_ANALOG_OUT:
 #if SDNPDATA_SUPPORT_OBJ40  
-      _buildAnalogOutputGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogOutputGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildAnalogOutputGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_FILE;
@@ -5429,14 +5327,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
  case SDNPXML2_SAVE_FILE:
 #if SDNPDATA_SUPPORT_OBJ70 
-      _buildSequentialFileTransfer(pSDNPSession, &testLen, TMWDEFS_TRUE);
-
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildSequentialFileTransfer(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildSequentialFileTransfer(pSDNPSession, &curLen, TMWDEFS_FALSE); 
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_STRING;
       continue;
@@ -5444,13 +5340,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
  case SDNPXML2_SAVE_STRING:
 #if SDNPDATA_SUPPORT_OBJ110
-      _buildOctetStringGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildOctetStringGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildOctetStringGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_VTERM;
@@ -5459,13 +5354,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
  case SDNPXML2_SAVE_VTERM:
 #if SDNPDATA_SUPPORT_OBJ112
-      _buildVirtualTerminalGroup(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildVirtualTerminalGroup(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildVirtualTerminalGroup(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DATABASE_TAIL;
@@ -5473,38 +5367,35 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       break;
 
     case SDNPXML2_SAVE_DATABASE_TAIL:
-      _buildDatabaseTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDatabaseTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDatabaseTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DATAPOINTS_LIST_HEAD;
       continue;
       break;
        
     case SDNPXML2_SAVE_DATAPOINTS_LIST_HEAD:
-      _buildDataPointsListHeader(pSDNPSession,  &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDataPointsListHeader(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDataPointsListHeader(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BIN_IN_POINTS_HEAD;
       continue;
       break;
 
     case SDNPXML2_SAVE_BIN_IN_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ1
-      _buildBinaryInputPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildBinaryInputPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildBinaryInputPoints(pSDNPSession, &curLen, TMWDEFS_FALSE);
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BIN_IN_POINTS;
@@ -5517,16 +5408,15 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildBinInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildBinInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildBinInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5538,13 +5428,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
     case SDNPXML2_SAVE_BIN_IN_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ1
-      _buildBinaryInputPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildBinaryInputPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildBinaryInputPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5554,13 +5443,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
     case SDNPXML2_SAVE_DBL_IN_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ3  
-      _buildDoubleBitInputPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDoubleBitInputPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDoubleBitInputPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DBL_IN_POINTS;
@@ -5573,17 +5461,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildDblBitInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildDblBitInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildDblBitInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
         
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5595,13 +5482,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_DBL_IN_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ3
-      _buildDoubleBitInputPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDoubleBitInputPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildDoubleBitInputPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
       
@@ -5612,13 +5498,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_BIN_OUT_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ10  
-      _buildBinaryOutputPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildBinaryOutputPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildBinaryOutputPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BIN_OUT_POINTS;
@@ -5631,17 +5516,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildBinOutPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildBinOutPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildBinOutPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
         
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5653,13 +5537,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_BIN_OUT_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ10
-      _buildBinaryOutputPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildBinaryOutputPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildBinaryOutputPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5669,13 +5552,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_BIN_COUNTER_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ20  
-      _buildCounterPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildCounterPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildCounterPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_BIN_COUNTER_POINTS;
@@ -5688,17 +5570,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildCounterPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildCounterPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildCounterPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
         
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5710,13 +5591,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_BIN_COUNTER_POINTS_TAIL: 
 #if SDNPDATA_SUPPORT_OBJ20
-      _buildCounterPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildCounterPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildCounterPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5726,13 +5606,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_ANALOG_IN_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ30  
-      _buildAnalogInputPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogInputPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildAnalogInputPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_ANALOG_IN_POINTS;
@@ -5745,17 +5624,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildAnalogInPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAnalogInPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildAnalogInPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
         
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5767,13 +5645,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_ANALOG_IN_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ30
-      _buildAnalogInputPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogInputPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
-      } 
-      _buildAnalogInputPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
+      }
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5783,13 +5660,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
  case SDNPXML2_SAVE_ANALOG_OUT_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ40  
-      _buildAnalogOutputPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogOutputPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildAnalogOutputPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_ANALOG_OUT_POINTS;
@@ -5802,17 +5678,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildAnalogOutPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildAnalogOutPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildAnalogOutPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
         
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5824,13 +5699,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_ANALOG_OUT_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ40
-      _buildAnalogOutputPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildAnalogOutputPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildAnalogOutputPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5840,14 +5714,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
  case SDNPXML2_SAVE_FILES_HEAD:
 #if SDNPDATA_SUPPORT_OBJ70 
-      _buildSequentialFiles(pSDNPSession, &testLen, TMWDEFS_TRUE);
-
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildSequentialFiles(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildSequentialFiles(pSDNPSession, &curLen, TMWDEFS_FALSE); 
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_FILES;
       continue;
@@ -5857,20 +5729,20 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 #if SDNPDATA_SUPPORT_OBJ70
       pointNum = pSDNPSession->xml2CurSavePointNum;
       saveIndent = pSDNPSession->xml2CurIndent;
-      while(_buildFilePoint(pSDNPSession, pointNum, &testLen, TMWDEFS_TRUE))
+      sdnpxmlw_startElement(pStream);
+      while(_buildFilePoint(pSDNPSession, pointNum))
       {
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildFilePoint(pSDNPSession, pointNum, &curLen, TMWDEFS_FALSE);
         
         saveIndent = pSDNPSession->xml2CurIndent;
         pointNum++;
         pSDNPSession->xml2CurSavePointNum = pointNum;
+        sdnpxmlw_startElement(pStream);
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5882,13 +5754,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_FILES_TAIL:
 #if SDNPDATA_SUPPORT_OBJ70
-      _buildSequentialFilesTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildSequentialFilesTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildSequentialFilesTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5898,13 +5769,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
   
  case SDNPXML2_SAVE_STRING_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ110
-      _buildOctetStringPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildOctetStringPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildOctetStringPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_STRING_POINTS;
@@ -5917,17 +5787,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       { 
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildOctetStringPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum,  &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildOctetStringPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-        _buildOctetStringPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum,  &curLen, TMWDEFS_FALSE);
   
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5939,13 +5808,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_STRING_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ110
-      _buildOctetStringPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildOctetStringPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildOctetStringPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif
@@ -5955,13 +5823,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       
  case SDNPXML2_SAVE_VTERM_POINTS_HEAD:
 #if SDNPDATA_SUPPORT_OBJ112
-      _buildVirtualTerminalPoints(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildVirtualTerminalPoints(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildVirtualTerminalPoints(pSDNPSession, &curLen, TMWDEFS_FALSE); 
       
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_VTERM_POINTS;
@@ -5974,17 +5841,16 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       for(pointNum = pSDNPSession->xml2CurSavePointNum; pointNum < numPoints; pointNum++)
       {
         saveIndent = pSDNPSession->xml2CurIndent;
-        _buildVirtualTerminalPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &testLen, TMWDEFS_TRUE);
-        pSDNPSession->xml2CurIndent = saveIndent;
-        if (testLen>=maxLen)
+        sdnpxmlw_startElement(pStream);
+        _buildVirtualTerminalPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum);
+        if(!_endElement(pSDNPSession, saveIndent))
         {
           break;
         }
-       _buildVirtualTerminalPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_FALSE);
 
         pSDNPSession->xml2CurSavePointNum = pointNum+1;
       }
-      if (testLen>=maxLen)
+      if(pStream->full)
       {
         break;
       }
@@ -5996,13 +5862,12 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_VTERM_POINTS_TAIL:
 #if SDNPDATA_SUPPORT_OBJ112   
-      _buildVirtualTerminalPointsTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildVirtualTerminalPointsTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildVirtualTerminalPointsTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       /* For safety, always set it back to 2 */
       pSDNPSession->xml2CurIndent = 2;
 #endif 
@@ -6012,8 +5877,8 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_DATASET_PROTO:
 #if SDNPDATA_SUPPORT_DATASETS
-      _buildDatasetProto(pSDNPSession, &curLen, &testLen, maxLen); 
-      if(testLen>=maxLen)
+      _buildDatasetProto(pSDNPSession); 
+      if(pStream->full)
         break;
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DATASET_DESCR;
@@ -6023,8 +5888,8 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
 
     case SDNPXML2_SAVE_DATASET_DESCR:
 #if SDNPDATA_SUPPORT_DATASETS
-      _buildDatasetDescr(pSDNPSession, &curLen, &testLen, maxLen); 
-      if(testLen>=maxLen)
+      _buildDatasetDescr(pSDNPSession); 
+      if(pStream->full)
         break;
 #endif
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DATAPOINTS_LIST_TAIL;
@@ -6032,27 +5897,23 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       continue;
     
     case SDNPXML2_SAVE_DATAPOINTS_LIST_TAIL:
-      _buildDataPointsListTail(pSDNPSession,  &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen) 
-      { 
+      sdnpxmlw_startElement(pStream);
+      _buildDataPointsListTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
+      {
         break;
       }
-      _buildDataPointsListTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
       pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DOC_TAIL;
       continue;
       break;
 
     case SDNPXML2_SAVE_DOC_TAIL:
-      _buildDocTail(pSDNPSession, &testLen, TMWDEFS_TRUE);
-      pSDNPSession->xml2CurIndent = saveIndent;
-      if (testLen>=maxLen)
+      sdnpxmlw_startElement(pStream);
+      _buildDocTail(pSDNPSession);
+      if(!_endElement(pSDNPSession, saveIndent))
       {
         break;
       }
-      _buildDocTail(pSDNPSession, &curLen, TMWDEFS_FALSE);
-      
-      pSDNPSession->xml2BufferLen = curLen;
       return SDNPXML2_SAVE_DONE;
       break;
       
@@ -6060,18 +5921,11 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
       return SDNPXML2_SAVE_FAILED;
     }
 
-    pSDNPSession->xml2BufferLen = curLen;
-    if (testLen >= maxLen)
+    /* The block is full, the element that did not fit is finished in
+     * the next block
+     */
+    if(pStream->full)
     {
-      if((prevState == pSDNPSession->xml2SaveState)
-        &&(prevSubState == pSDNPSession->xml2SaveSubState)
-        &&(prevPointNum == pSDNPSession->xml2CurSavePointNum)
-        &&(prevElemNum == pSDNPSession->xml2CurSaveElemNum))
-      {
-        /* since this single object won't fit by itself, return failure */
-        SDNPDIAG_ERROR(pSession->pChannel, pSession, SDNPDIAG_XML_SIZE_ERROR);
-        return SDNPXML2_SAVE_FAILED;
-      }
       return SDNPXML2_SAVE_NOT_DONE;
     }
   }
@@ -6079,200 +5933,40 @@ SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWT
   return SDNPXML2_SAVE_DONE;
 }
 
-TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpxml2_saveDatabaseGetSize(TMWSESN *pSession)
+/* routine: sdnpxml2_saveDatabase */
+SDNPXML2_SAVE_STATE TMWDEFS_GLOBAL sdnpxml2_saveDatabase(TMWSESN *pSession, TMWTYPES_CHAR *pBuffer, TMWTYPES_ULONG maxLen)
 {
-  SDNPSESN *pSDNPSession;
-  TMWTYPES_ULONG curLen;
-  TMWTYPES_USHORT numPoints;
-  TMWTYPES_USHORT pointNum;
-
-  pSDNPSession = (SDNPSESN *)pSession;
-  pSDNPSession->xml2CurIndent = 0;
-  pSDNPSession->xml2CurSavePointNum = 0;
-  pSDNPSession->xml2CurSaveElemNum = 0;
-  curLen=0;
-
-  _buildDocHeader(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  _buildConfigurationHeader(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-
-  _buildDeviceConfig(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-  
-  _buildSerialConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  
-  _buildNetworkConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  
-  _buildLinkConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  
-  _buildApplConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  
-  _buildOutstationConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  
-  _buildUnsolicitedConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
- 
-  _buildUnsolTriggerConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  _buildOutperformConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
- 
-  _buildFieldConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
- 
-  _buildSecurityConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-     
-  _buildBroadcastConfig(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  _buildConfigurationTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  
-  _buildDatabaseHeader(pSDNPSession,  &curLen, TMWDEFS_TRUE);
-    
-#if SDNPDATA_SUPPORT_OBJ1
-  _buildBinaryInputGroup(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-  
-#if SDNPDATA_SUPPORT_OBJ3  
-  _buildDoubleBitInputGroup(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ10 
-  _buildBinaryOutputGroup(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ20  
-  _buildCounterGroup(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ30
-  _buildAnalogInputGroup(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ40  
-  _buildAnalogOutputGroup(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ70 
-  _buildSequentialFileTransfer(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ110  
-  _buildOctetStringGroup(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-#endif
-  
-#if SDNPDATA_SUPPORT_OBJ112  
-  _buildVirtualTerminalGroup(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-#endif
-
-  _buildDatabaseTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  _buildDataPointsListHeader(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-#if SDNPDATA_SUPPORT_OBJ1
-  _buildBinaryInputPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  numPoints = sdnpdata_binInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildBinInPoint(pSDNPSession,  pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-  }
-  _buildBinaryInputPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ3  
-  _buildDoubleBitInputPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  numPoints = sdnpdata_dblInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildDblBitInPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-  }
-  _buildDoubleBitInputPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-  
-#if SDNPDATA_SUPPORT_OBJ10 
-  _buildBinaryOutputPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  numPoints = sdnpdata_binOutQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildBinOutPoint(pSDNPSession,pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-  }
-  _buildBinaryOutputPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ20  
-  _buildCounterPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  numPoints = sdnpdata_binCntrQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildCounterPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE); 
-  }
-  _buildCounterPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ30
-  _buildAnalogInputPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-
-  numPoints = sdnpdata_anlgInQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildAnalogInPoint(pSDNPSession,  pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-  }
-  _buildAnalogInputPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ40  
-  _buildAnalogOutputPoints(pSDNPSession, &curLen, TMWDEFS_TRUE);
-  numPoints = sdnpdata_anlgOutQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildAnalogOutPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-  }
-  _buildAnalogOutputPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ70 
-  _buildSequentialFiles(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-
-  pointNum = 0;
-  while(_buildFilePoint(pSDNPSession, pointNum, &curLen, TMWDEFS_TRUE))
-  {
-    pointNum++;
-  }
-      
-  _buildSequentialFilesTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ110  
-  _buildOctetStringPoints(pSDNPSession, &curLen, TMWDEFS_TRUE); 
-
-  numPoints = sdnpdata_strQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  { 
-    _buildOctetStringPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE);
-  }
-
-  _buildOctetStringPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
-
-#if SDNPDATA_SUPPORT_OBJ112  
-  _buildVirtualTerminalPoints(pSDNPSession, &curLen, TMWDEFS_TRUE); 
+  SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
+  SDNPXML2_SAVE_STATE state;
 
-  numPoints = sdnpdata_vtermQuantity(pSDNPSession->pDbHandle);
-  for(pointNum = 0; pointNum < numPoints; pointNum++)
-  {
-    _buildVirtualTerminalPoint(pSDNPSession, pSDNPSession->pDbHandle, pointNum, &curLen, TMWDEFS_TRUE); 
-  }
+  if(pSDNPSession == TMWDEFS_NULL)
+    return(SDNPXML2_SAVE_FAILED);
 
-  _buildVirtualTerminalPointsTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
-#endif
+  sdnpxmlw_setBuffer(&pSDNPSession->xml2Stream, pBuffer, maxLen);
+  state = _saveDatabase(pSDNPSession);
+  pSDNPSession->xml2BufferLen = pSDNPSession->xml2Stream.length;
+  return(state);
+}
 
-#if SDNPDATA_SUPPORT_DATASETS
-  _buildDatasetProtoGetLen(pSDNPSession, &curLen);
-  _buildDatasetDescrGetLen(pSDNPSession, &curLen);
-#endif
+/* routine: sdnpxml2_saveDatabaseGetSize */
+TMWTYPES_ULONG TMWDEFS_GLOBAL sdnpxml2_saveDatabaseGetSize(TMWSESN *pSession)
+{
+  SDNPSESN *pSDNPSession;
+  TMWTYPES_UCHAR indentSize;
 
-  _buildDataPointsListTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
+  pSDNPSession = (SDNPSESN *)pSession;
 
-  _buildDocTail(pSDNPSession, &curLen, TMWDEFS_TRUE);
+  /* Run the writer over the whole profile without a buffer to count its
+   * length. This leaves the session ready to generate the profile from
+   * the start.
+   */
+  indentSize = pSDNPSession->xml2IndentSize;
+  sdnpxml2_saveDatabaseInit(pSession);
+  pSDNPSession->xml2IndentSize = indentSize;
+  sdnpxmlw_setBuffer(&pSDNPSession->xml2Stream, TMWDEFS_NULL, 0);
+  _saveDatabase(pSDNPSession);
 
-  return(curLen);
+  return(pSDNPSession->xml2Stream.length);
 }
 
 void TMWDEFS_GLOBAL sdnpxml2_saveDatabaseInit(TMWSESN *pSession)
@@ -6281,11 +5975,12 @@ void TMWDEFS_GLOBAL sdnpxml2_saveDatabaseInit(TMWSESN *pSession)
   pSDNPSession->xml2IndentSize = 0;
   pSDNPSession->xml2CurIndent = 0;
   pSDNPSession->xml2BufferLen = 0;
-  pSDNPSession->xml2BufferIndex = 0;
+  pSDNPSession->xml2BufferState = SDNPXML2_SAVE_NOT_DONE;
   pSDNPSession->xml2CurSavePointNum = 0;
   pSDNPSession->xml2CurSaveElemNum = 0;
   pSDNPSession->xml2SaveState = SDNPXML2_SAVE_DOC_HEADER;
   pSDNPSession->xml2SaveSubState = SDNPXML2_SAVE_DATASETSTART;
+  sdnpxmlw_init(&pSDNPSession->xml2Stream, pSDNPSession->xml2Carry, SDNPCNFG_XML_SAVE_BUF_SIZE);
 } 
 
 /* function: sdnpxml2_openDeviceProfile */
@@ -6354,7 +6049,6 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnpxml2_readDeviceProfile(
   TMWTYPES_UCHAR *pBuf)
 {
 #if SDNPDATA_SUPPORT_OBJ70
-  TMWTYPES_UINT memCpyLen;
   SDNPSESN *pSDNPSession = (SDNPSESN *)pSession;
   SDNPO070_FILE_CONTROL_BLOCK *pObj70FileCtrl = (SDNPO070_FILE_CONTROL_BLOCK *)pSDNPSession->pObj70FileCtrl;
 
@@ -6362,52 +6056,19 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnpxml2_readDeviceProfile(
   if(fileHandle != pObj70FileCtrl->handle)
     return(DNPDEFS_FILE_TFER_STAT_INV_HANDLE);
 
-  do 
+  /* Generate the next part of the profile straight into the block */
+  pSDNPSession->xml2BufferLen = 0;
+  if(pSDNPSession->xml2BufferState != SDNPXML2_SAVE_DONE)
   {
-    if (pSDNPSession->xml2BufferLen == 0)
-    {
-      /* For File Transfer read of Device Profile, set indent size to zero */
-      pSDNPSession->xml2IndentSize = 0; 
-      pSDNPSession->xml2BufferState = sdnpxml2_saveDatabase(pSession, pSDNPSession->xml2Buffer, SDNPCNFG_XML_SAVE_BUF_SIZE);
-      if(pSDNPSession->xml2BufferState == SDNPXML2_SAVE_FAILED)
-        return(DNPDEFS_FILE_TFER_STAT_MISC);
-    }
-
-    if((pSDNPSession->xml2BufferIndex + pObj70FileCtrl->maxBlockSize) <= pSDNPSession->xml2BufferLen)
-    {
-      memCpyLen = pObj70FileCtrl->maxBlockSize;
-      *pLast = TMWDEFS_FALSE;
-    }
-    else
-    {
-      memCpyLen = pSDNPSession->xml2BufferLen - pSDNPSession->xml2BufferIndex;
-      if (pSDNPSession->xml2BufferState == SDNPXML2_SAVE_DONE)
-      {
-        *pLast = TMWDEFS_TRUE;
-      }
-      else
-      {
-        *pLast = TMWDEFS_FALSE;
-      }
-    }
-    if (memCpyLen == 0)
-    {
-      pSDNPSession->xml2BufferIndex = 0;
-      pSDNPSession->xml2BufferLen = 0;
-      memset(pSDNPSession->xml2Buffer,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
-    }
+    /* For File Transfer read of Device Profile, set indent size to zero */
+    pSDNPSession->xml2IndentSize = 0; 
+    pSDNPSession->xml2BufferState = sdnpxml2_saveDatabase(pSession, (TMWTYPES_CHAR *)pBuf, pObj70FileCtrl->maxBlockSize);
+    if(pSDNPSession->xml2BufferState == SDNPXML2_SAVE_FAILED)
+      return(DNPDEFS_FILE_TFER_STAT_MISC);
   }
-  while(memCpyLen == 0);
 
-  memcpy(pBuf, &pSDNPSession->xml2Buffer[pSDNPSession->xml2BufferIndex], memCpyLen);
-  pSDNPSession->xml2BufferIndex += memCpyLen;
-  if (memCpyLen < pObj70FileCtrl->maxBlockSize)
-  {
-    pSDNPSession->xml2BufferIndex = 0;
-    pSDNPSession->xml2BufferLen = 0;
-    memset(pSDNPSession->xml2Buffer,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
-  }
-  *pBytesRead = (TMWTYPES_USHORT)memCpyLen; 
+  *pLast = (TMWTYPES_BOOL)(pSDNPSession->xml2BufferState == SDNPXML2_SAVE_DONE);
+  *pBytesRead = (TMWTYPES_USHORT)pSDNPSession->xml2BufferLen; 
 
   /* Return success */
   return(DNPDEFS_FILE_TFER_STAT_SUCCESS);
@@ -6429,9 +6090,7 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnpxml2_closeDeviceProfile(
   if(fileHandle != pObj70FileCtrl->handle)
     return(DNPDEFS_FILE_CMD_STAT_INV_HANDLE);
   
-  memset(pSDNPSession->xml2Buffer,0,SDNPCNFG_XML_SAVE_BUF_SIZE);
   pSDNPSession->xml2BufferLen = 0;
-  pSDNPSession->xml2BufferIndex = 0;
   pSDNPSession->xml2BufferState = SDNPXML2_SAVE_NOT_DONE;
   pObj70FileCtrl->xml2DeviceProfileOpen = TMWDEFS_FALSE;
 
@@ -6480,8 +6139,8 @@ TMWTYPES_BOOL sdnpxml2_saveDatabaseToFile(TMWSESN *pSession, char *pFileName)
 
     else if(state == SDNPXML2_SAVE_NOT_DONE)
     {
-      /* Write this to a file, buffer contains a null terminated string. */
-      if(DNPDEFS_FILE_TFER_STAT_SUCCESS != sdnpdata_writeFile(pSession, handle, TMWDEFS_FALSE, (TMWTYPES_USHORT)strlen(pSDNPSession->xml2Buffer), (TMWTYPES_UCHAR *)pSDNPSession->xml2Buffer)) 
+      /* Write this to a file, xml2BufferLen bytes were generated. */
+      if(DNPDEFS_FILE_TFER_STAT_SUCCESS != sdnpdata_writeFile(pSession, handle, TMWDEFS_FALSE, (TMWTYPES_USHORT)pSDNPSession->xml2BufferLen, (TMWTYPES_UCHAR *)pSDNPSession->xml2Buffer)) 
       {
         status = TMWDEFS_FALSE;
         break;
@@ -6489,8 +6148,8 @@ TMWTYPES_BOOL sdnpxml2_saveDatabaseToFile(TMWSESN *pSession, char *pFileName)
     }
     else /* SDNPXML2_SAVE_DONE */
     {
-      /* Write this to a file, buffer contains a null terminated string. */
-      if(DNPDEFS_FILE_TFER_STAT_SUCCESS != sdnpdata_writeFile(pSession, handle, TMWDEFS_TRUE, (TMWTYPES_USHORT)strlen(pSDNPSession->xml2Buffer), (TMWTYPES_UCHAR *)pSDNPSession->xml2Buffer)) 
+      /* Write this to a file, xml2BufferLen bytes were generated. */
+      if(DNPDEFS_FILE_TFER_STAT_SUCCESS != sdnpdata_writeFile(pSession, handle, TMWDEFS_TRUE, (TMWTYPES_USHORT)pSDNPSession->xml2BufferLen, (TMWTYPES_UCHAR *)pSDNPSession->xml2Buffer)) 
       {
         status = TMWDEFS_FALSE;
       }
@@ -144,6 +144,9 @@ extern "C" {
    * purpose: Generate standard Device Profile in xml format into buffer provided.
    *  sdnpxml2_saveDatabaseInit() should be called before calling this function 
    *  repeatedly until it returns SDNPXML2_SAVE_FAILED or SDNPXML2_SAVE_DONE.
+   *  Each call fills the buffer, an element that does not fit is continued
+   *  in the next call. The number of bytes generated is left in 
+   *  pSDNPSession->xml2BufferLen, the buffer is not null terminated.
    *  This may be called directly by the outstation/slave application if 
    *   sdnpxml2_saveDatabaseToFile does not meet your needs.
    * arguments:
@@ -0,0 +1,247 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: sdnpxmlw.c
+ * description: Streaming writer for device profile generation.
+ *  See sdnpxmlw.h.
+ */
+#include "tmwscl/dnp/sdnpdata.h"
+#include "tmwscl/dnp/sdnpxmlw.h"
+
+#if SDNPDATA_SUPPORT_XML || SDNPDATA_SUPPORT_XML2
+#include <string.h>
+
+/* function: _skip */
+static TMWTYPES_ULONG TMWDEFS_LOCAL _skip(
+  SDNPXMLW_STREAM *pStream,
+  TMWTYPES_ULONG length)
+{
+  TMWTYPES_ULONG skip = 0;
+
+  /* Skip the part of the element that was sent in an earlier block */
+  if(pStream->elementOffset < pStream->resumeOffset)
+  {
+    skip = pStream->resumeOffset - pStream->elementOffset;
+    if(skip > length)
+      skip = length;
+    pStream->elementOffset += skip;
+  }
+  return(skip);
+}
+
+/* function: _room */
+static TMWTYPES_ULONG TMWDEFS_LOCAL _room(
+  SDNPXMLW_STREAM *pStream,
+  TMWTYPES_ULONG length)
+{
+  TMWTYPES_ULONG room = pStream->maxLength - pStream->length;
+
+  /* Without a block the stream only counts the length of the profile */
+  if(pStream->pBuf == TMWDEFS_NULL)
+    return(length);
+
+  if(length > room)
+  {
+    pStream->full = TMWDEFS_TRUE;
+    length = room;
+  }
+  return(length);
+}
+
+/* function: _keep
+ * purpose: Keep the text of the current element that did not fit in the
+ *  block, so the next block is sent from this copy
+ */
+static void TMWDEFS_LOCAL _keep(
+  SDNPXMLW_STREAM *pStream,
+  const TMWTYPES_CHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  TMWTYPES_ULONG room = pStream->maxCarry - pStream->carryLength;
+
+  if(!pStream->keeping)
+    return;
+
+  if(length > room)
+  {
+    /* The rest of the element is generated again in the next block */
+    pStream->carryAll = TMWDEFS_FALSE;
+    length = room;
+  }
+  if(length == 0)
+    return;
+
+  if(pStream->carryLength == 0)
+    pStream->carryStart = pStream->elementOffset;
+  memcpy(pStream->pCarry + pStream->carryLength, pData, length);
+  pStream->carryLength += length;
+}
+
+/* function: _send
+ * purpose: Write as much of the kept text of the current element as fits
+ *  in the block
+ */
+static void TMWDEFS_LOCAL _send(
+  SDNPXMLW_STREAM *pStream)
+{
+  TMWTYPES_ULONG offset = pStream->resumeOffset - pStream->carryStart;
+  TMWTYPES_ULONG length = pStream->carryLength - offset;
+  TMWTYPES_ULONG room = pStream->maxLength - pStream->length;
+
+  if(length > room)
+    length = room;
+  memcpy(pStream->pBuf + pStream->length, pStream->pCarry + offset, length);
+  pStream->length += length;
+  pStream->resumeOffset += length;
+
+  if(pStream->resumeOffset < pStream->carryStart + pStream->carryLength)
+  {
+    /* Still more than one block, ignore the text generated this time */
+    pStream->full = TMWDEFS_TRUE;
+    pStream->replay = TMWDEFS_TRUE;
+    return;
+  }
+
+  /* If the copy holds the rest of the element ignore the text generated
+   * this time, otherwise write the text that comes after the copy
+   */
+  pStream->replay = pStream->carryAll;
+  pStream->carryLength = 0;
+}
+
+/* function: sdnpxmlw_init */
+void TMWDEFS_GLOBAL sdnpxmlw_init(
+  SDNPXMLW_STREAM *pStream,
+  TMWTYPES_CHAR *pCarry,
+  TMWTYPES_ULONG maxCarry)
+{
+  pStream->pBuf = TMWDEFS_NULL;
+  pStream->maxLength = 0;
+  pStream->length = 0;
+  pStream->elementOffset = 0;
+  pStream->resumeOffset = 0;
+  pStream->full = TMWDEFS_FALSE;
+  pStream->pCarry = pCarry;
+  pStream->maxCarry = (pCarry == TMWDEFS_NULL) ? 0 : maxCarry;
+  pStream->carryStart = 0;
+  pStream->carryLength = 0;
+  pStream->carryAll = TMWDEFS_FALSE;
+  pStream->keeping = TMWDEFS_FALSE;
+  pStream->replay = TMWDEFS_FALSE;
+}
+
+/* function: sdnpxmlw_setBuffer */
+void TMWDEFS_GLOBAL sdnpxmlw_setBuffer(
+  SDNPXMLW_STREAM *pStream,
+  TMWTYPES_CHAR *pBuf,
+  TMWTYPES_ULONG maxLength)
+{
+  pStream->pBuf = pBuf;
+  pStream->maxLength = maxLength;
+  pStream->length = 0;
+}
+
+/* function: sdnpxmlw_startElement */
+void TMWDEFS_GLOBAL sdnpxmlw_startElement(
+  SDNPXMLW_STREAM *pStream)
+{
+  pStream->elementOffset = 0;
+  pStream->full = TMWDEFS_FALSE;
+  pStream->keeping = TMWDEFS_FALSE;
+  pStream->replay = TMWDEFS_FALSE;
+
+  /* Send the element that was split from the copy kept when it was
+   * first generated, since the values in it may have changed since
+   */
+  if((pStream->carryLength > 0) && (pStream->pBuf != TMWDEFS_NULL))
+    _send(pStream);
+
+  /* Keep a copy of whatever does not fit in this block */
+  if(pStream->carryLength == 0)
+  {
+    pStream->keeping = TMWDEFS_TRUE;
+    pStream->carryAll = TMWDEFS_TRUE;
+  }
+}
+
+/* function: sdnpxmlw_endElement */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpxmlw_endElement(
+  SDNPXMLW_STREAM *pStream)
+{
+  if(pStream->full)
+  {
+    /* Resume after the part of the element that is in this block */
+    if(!pStream->replay)
+      pStream->resumeOffset = pStream->elementOffset;
+    return(TMWDEFS_FALSE);
+  }
+  pStream->resumeOffset = 0;
+  pStream->carryLength = 0;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnpxmlw_write */
+void TMWDEFS_GLOBAL sdnpxmlw_write(
+  SDNPXMLW_STREAM *pStream,
+  const TMWTYPES_CHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  TMWTYPES_ULONG skip;
+  TMWTYPES_ULONG count;
+
+  if(pStream->replay)
+    return;
+
+  skip = _skip(pStream, length);
+  length -= skip;
+  count = _room(pStream, length);
+  if(count > 0)
+  {
+    if(pStream->pBuf != TMWDEFS_NULL)
+      memcpy(pStream->pBuf + pStream->length, pData + skip, count);
+    pStream->length += count;
+    pStream->elementOffset += count;
+  }
+  if(count < length)
+    _keep(pStream, pData + skip + count, length - count);
+}
+
+/* function: sdnpxmlw_writeSpaces */
+void TMWDEFS_GLOBAL sdnpxmlw_writeSpaces(
+  SDNPXMLW_STREAM *pStream,
+  TMWTYPES_ULONG count)
+{
+  static const TMWTYPES_CHAR spaces[] = "                ";
+
+  while(count > sizeof(spaces) - 1)
+  {
+    sdnpxmlw_write(pStream, spaces, sizeof(spaces) - 1);
+    count -= sizeof(spaces) - 1;
+  }
+  sdnpxmlw_write(pStream, spaces, count);
+}
+
+#endif /* SDNPDATA_SUPPORT_XML || SDNPDATA_SUPPORT_XML2 */
@@ -0,0 +1,172 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: sdnpxmlw.h
+ * description: This file is intended for internal SCL use only.
+ *  Streaming writer used by sdnpxml.c and sdnpxml2.c to generate a device
+ *  profile straight into the blocks of an object 70 file transfer.
+ *
+ *  The profile is generated as a sequence of elements, a point or a
+ *  group header for example. Each call to the generator is given the
+ *  caller's block and writes elements into it until the block is full.
+ *  An element that does not fit is written up to the end of the block,
+ *  the rest of its text is kept in the stream's carry buffer, and the
+ *  generator stops with its state still on that element. On the next
+ *  call the kept text is written at the start of the new block and the
+ *  text generated for the element this time is ignored. Nothing is
+ *  generated twice to find its length first, and an element that spans
+ *  blocks is sent as it was when it was first generated, even if the
+ *  values in it have changed since.
+ *
+ *  Only an element whose remainder is longer than the carry buffer is
+ *  sent partly from text generated again, the part after the copy.
+ */
+#ifndef SDNPXMLW_DEFINED
+#define SDNPXMLW_DEFINED
+
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwtypes.h"
+
+typedef struct SDNPXMLWStreamStruct {
+  /* Block being written by the current call */
+  TMWTYPES_CHAR  *pBuf;
+  TMWTYPES_ULONG  maxLength;
+  TMWTYPES_ULONG  length;
+
+  /* Bytes of the current element that are in this or an earlier block */
+  TMWTYPES_ULONG  elementOffset;
+
+  /* Bytes of the current element sent in earlier blocks */
+  TMWTYPES_ULONG  resumeOffset;
+
+  /* The current element did not fit in this block */
+  TMWTYPES_BOOL   full;
+
+  /* Text of the current element that did not fit in an earlier block,
+   * carryStart is its offset in the element
+   */
+  TMWTYPES_CHAR  *pCarry;
+  TMWTYPES_ULONG  maxCarry;
+  TMWTYPES_ULONG  carryStart;
+  TMWTYPES_ULONG  carryLength;
+
+  /* The carry buffer holds all of the rest of the current element */
+  TMWTYPES_BOOL   carryAll;
+
+  /* Text that does not fit in this block is copied to the carry buffer */
+  TMWTYPES_BOOL   keeping;
+
+  /* The current element is sent from the carry buffer, ignore its text */
+  TMWTYPES_BOOL   replay;
+} SDNPXMLW_STREAM;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: sdnpxmlw_init
+   * purpose: Prepare a stream to write a profile from the start
+   * arguments:
+   *  pStream - stream to initialize
+   *  pCarry - buffer that holds the part of an element that did not fit
+   *   in a block, or TMWDEFS_NULL if the stream only counts the length
+   *  maxCarry - size of pCarry
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpxmlw_init(
+    SDNPXMLW_STREAM *pStream,
+    TMWTYPES_CHAR *pCarry,
+    TMWTYPES_ULONG maxCarry);
+
+  /* function: sdnpxmlw_setBuffer
+   * purpose: Give the stream the block to write in the current call
+   * arguments:
+   *  pStream - stream
+   *  pBuf - block to write, or TMWDEFS_NULL to only count the length
+   *   of the profile in pStream->length
+   *  maxLength - size of the block
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpxmlw_setBuffer(
+    SDNPXMLW_STREAM *pStream,
+    TMWTYPES_CHAR *pBuf,
+    TMWTYPES_ULONG maxLength);
+
+  /* function: sdnpxmlw_startElement
+   * purpose: Start generating an element
+   * arguments:
+   *  pStream - stream
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpxmlw_startElement(
+    SDNPXMLW_STREAM *pStream);
+
+  /* function: sdnpxmlw_endElement
+   * purpose: Finish generating an element
+   * arguments:
+   *  pStream - stream
+   * returns:
+   *  TMWDEFS_TRUE if the whole element has been written, TMWDEFS_FALSE if
+   *  the block is full and the generator must stay on the element, the
+   *  rest of it is sent in the next call
+   */
+  TMWTYPES_BOOL TMWDEFS_GLOBAL sdnpxmlw_endElement(
+    SDNPXMLW_STREAM *pStream);
+
+  /* function: sdnpxmlw_write
+   * purpose: Write text for the current element
+   * arguments:
+   *  pStream - stream
+   *  pData - text to write
+   *  length - number of bytes to write
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpxmlw_write(
+    SDNPXMLW_STREAM *pStream,
+    const TMWTYPES_CHAR *pData,
+    TMWTYPES_ULONG length);
+
+  /* function: sdnpxmlw_writeSpaces
+   * purpose: Write spaces for the current element, used for indentation
+   * arguments:
+   *  pStream - stream
+   *  count - number of spaces to write
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL sdnpxmlw_writeSpaces(
+    SDNPXMLW_STREAM *pStream,
+    TMWTYPES_ULONG count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SDNPXMLW_DEFINED */
@@ -269,6 +269,165 @@ static void TEST__framing__publish(void** state) {
     assert_true(memcmp(response->application_message, "0123456789", 10) == 0);
 }
 
+static void TEST__framing__connect5(void** state) {
+    uint8_t buf[256];
+    ssize_t rv;
+    const uint8_t correct_bytes[] = {
+        (MQTT_CONTROL_CONNECT << 4) | 0, 33,
+        0, 4, 'M', 'Q', 'T', 'T', MQTT_PROTOCOL_LEVEL_5, MQTT_CONNECT_CLEAN_SESSION, 0, 120u,
+        16, MQTT_PROP_SESSION_EXPIRY_INTERVAL, 0, 0, 0x0E, 0x10,
+            MQTT_PROP_RECEIVE_MAXIMUM, 0, 10,
+            MQTT_PROP_USER_PROPERTY, 0, 1, 'a', 0, 2, 'b', 'c',
+        0, 4, 'l', 'i', 'a', 'm'
+    };
+    const uint8_t correct_bytes_will[] = {
+        (MQTT_CONTROL_CONNECT << 4) | 0, 24,
+        0, 4, 'M', 'Q', 'T', 'T', MQTT_PROTOCOL_LEVEL_5, MQTT_CONNECT_WILL_FLAG, 0, 120u,
+        0,
+        0, 0,
+        0,
+        0, 4, 'w', 'i', 'l', 'l',
+        0, 2, 'h', 'i'
+    };
+    struct mqtt_user_property user_property = { "a", "bc" };
+    struct mqtt_connect_properties properties;
+
+    memset(&properties, 0, sizeof(properties));
+    properties.session_expiry_interval = 3600;
+    properties.receive_maximum = 10;
+    properties.user_properties = &user_property;
+    properties.num_user_properties = 1;
+
+    rv = mqtt_pack_connection_request5(buf, sizeof(buf), "liam", NULL, NULL, 0, NULL, NULL,
+                                       MQTT_CONNECT_CLEAN_SESSION, 120u, &properties);
+    assert_true(rv == sizeof(correct_bytes));
+    assert_true(memcmp(correct_bytes, buf, sizeof(correct_bytes)) == 0);
+
+    /* an empty client id without a clean start asks the broker to assign one */
+    rv = mqtt_pack_connection_request5(buf, sizeof(buf), NULL, "will", "hi", 2, NULL, NULL, 0, 120u, NULL);
+    assert_true(rv == sizeof(correct_bytes_will));
+    assert_true(memcmp(correct_bytes_will, buf, sizeof(correct_bytes_will)) == 0);
+}
+
+static void TEST__framing__publish5(void** state) {
+    uint8_t buf[256];
+    ssize_t rv;
+    const uint8_t correct_bytes[] = {
+        (MQTT_CONTROL_PUBLISH << 4) | MQTT_PUBLISH_QOS_1, 21,
+        0, 6, 't', 'o', 'p', 'i', 'c', '1',
+        0, 23,
+        5, MQTT_PROP_TOPIC_ALIAS, 0, 3, MQTT_PROP_PAYLOAD_FORMAT_INDICATOR, 1,
+        'h', 'e', 'l', 'l', 'o'
+    };
+    const uint8_t correct_bytes_alias[] = {
+        (MQTT_CONTROL_PUBLISH << 4) | 0, 9,
+        0, 0,
+        3, MQTT_PROP_TOPIC_ALIAS, 0, 3,
+        'h', 'e', 'y'
+    };
+    struct mqtt_publish_properties properties;
+    struct mqtt_response mqtt_response;
+    struct mqtt_response_publish *response = &(mqtt_response.decoded.publish);
+    struct mqtt_property property;
+
+    memset(&properties, 0, sizeof(properties));
+    properties.payload_format_indicator = 1;
+    rv = mqtt_pack_publish_request5(buf, sizeof(buf), "topic1", 3, 23, "hello", 5, MQTT_PUBLISH_QOS_1, &properties);
+    assert_true(rv == sizeof(correct_bytes));
+    assert_true(memcmp(buf, correct_bytes, sizeof(correct_bytes)) == 0);
+
+    /* once the alias is set the topic can be left out */
+    rv = mqtt_pack_publish_request5(buf, sizeof(buf), "", 3, 0, "hey", 3, MQTT_PUBLISH_QOS_0, NULL);
+    assert_true(rv == sizeof(correct_bytes_alias));
+    assert_true(memcmp(buf, correct_bytes_alias, sizeof(correct_bytes_alias)) == 0);
+
+    /* but not without one */
+    rv = mqtt_pack_publish_request5(buf, sizeof(buf), "", 0, 0, "hey", 3, MQTT_PUBLISH_QOS_0, NULL);
+    assert_true(rv == MQTT_ERROR_MALFORMED_REQUEST);
+
+    /* the properties are handed to the application as they are */
+    properties.payload_format_indicator = 0;
+    properties.message_expiry_interval = 60;
+    properties.content_type = "text/plain";
+    properties.correlation_data = "\x01\x02";
+    properties.correlation_data_size = 2;
+    rv = mqtt_pack_publish_request5(buf, sizeof(buf), "topic1", 0, 23, "hello", 5, MQTT_PUBLISH_QOS_1, &properties);
+    assert_true(rv > 0);
+    assert_true(mqtt_unpack_response5(&mqtt_response, buf, (size_t) rv) == rv);
+    assert_true(response->topic_name_size == 6);
+    assert_true(response->packet_id == 23);
+    assert_true(response->application_message_size == 5);
+    assert_true(memcmp(response->application_message, "hello", 5) == 0);
+
+    rv = mqtt_unpack_property(&property, response->properties, response->properties_size);
+    assert_true(rv == 5);
+    assert_true(property.identifier == MQTT_PROP_MESSAGE_EXPIRY_INTERVAL);
+    assert_true(property.value == 60);
+    rv = mqtt_unpack_property(&property, response->properties + 5, response->properties_size - 5);
+    assert_true(rv == 13);
+    assert_true(property.identifier == MQTT_PROP_CONTENT_TYPE);
+    assert_true(property.data_size == 10);
+    assert_true(memcmp(property.data, "text/plain", 10) == 0);
+    rv = mqtt_unpack_property(&property, response->properties + 18, response->properties_size - 18);
+    assert_true(rv == 5);
+    assert_true(property.identifier == MQTT_PROP_CORRELATION_DATA);
+    assert_true(property.data_size == 2);
+    assert_true(response->properties_size == 23);
+}
+
+static void TEST__framing__acks5(void** state) {
+    /* short form without a reason code, then one with a reason code and no properties */
+    const uint8_t puback[] = { MQTT_CONTROL_PUBACK << 4, 2, 0, 7 };
+    const uint8_t pubrec[] = { MQTT_CONTROL_PUBREC << 4, 3, 0, 7, MQTT_REASON_QUOTA_EXCEEDED };
+    const uint8_t suback[] = { MQTT_CONTROL_SUBACK << 4, 4, 0, 9, 0, MQTT_REASON_NOT_AUTHORIZED };
+    const uint8_t unsuback[] = { MQTT_CONTROL_UNSUBACK << 4, 5, 0, 9, 0, MQTT_REASON_SUCCESS, MQTT_REASON_NO_SUBSCRIPTION_EXISTED };
+    const uint8_t disconnect[] = {
+        MQTT_CONTROL_DISCONNECT << 4, 9, MQTT_REASON_SERVER_SHUTTING_DOWN,
+        7, MQTT_PROP_REASON_STRING, 0, 4, 'b', 'y', 'e', '!'
+    };
+    const uint8_t connack[] = {
+        MQTT_CONTROL_CONNACK << 4, 11, 0, MQTT_REASON_SUCCESS,
+        8, MQTT_PROP_TOPIC_ALIAS_MAXIMUM, 0, 5, MQTT_PROP_RECEIVE_MAXIMUM, 0, 2, MQTT_PROP_RETAIN_AVAILABLE, 0
+    };
+    const uint8_t bad_property[] = { MQTT_CONTROL_DISCONNECT << 4, 4, 0, 2, 0x7F, 0 };
+    struct mqtt_response response;
+    uint8_t buf[16];
+    ssize_t rv;
+
+    assert_true(mqtt_unpack_response5(&response, puback, sizeof(puback)) == sizeof(puback));
+    assert_true(response.decoded.puback.packet_id == 7);
+    assert_true(response.decoded.puback.reason_code == MQTT_REASON_SUCCESS);
+
+    assert_true(mqtt_unpack_response5(&response, pubrec, sizeof(pubrec)) == sizeof(pubrec));
+    assert_true(response.decoded.pubrec.packet_id == 7);
+    assert_true(response.decoded.pubrec.reason_code == MQTT_REASON_QUOTA_EXCEEDED);
+
+    assert_true(mqtt_unpack_response5(&response, suback, sizeof(suback)) == sizeof(suback));
+    assert_true(response.decoded.suback.num_return_codes == 1);
+    assert_true(response.decoded.suback.return_codes[0] == MQTT_REASON_NOT_AUTHORIZED);
+
+    assert_true(mqtt_unpack_response5(&response, unsuback, sizeof(unsuback)) == sizeof(unsuback));
+    assert_true(response.decoded.unsuback.num_reason_codes == 2);
+    assert_true(response.decoded.unsuback.reason_codes[1] == MQTT_REASON_NO_SUBSCRIPTION_EXISTED);
+
+    assert_true(mqtt_unpack_response5(&response, disconnect, sizeof(disconnect)) == sizeof(disconnect));
+    assert_true(response.decoded.disconnect.reason_code == MQTT_REASON_SERVER_SHUTTING_DOWN);
+    assert_true(response.decoded.disconnect.properties_size == 7);
+
+    assert_true(mqtt_unpack_response5(&response, connack, sizeof(connack)) == sizeof(connack));
+    assert_true(response.decoded.connack.return_code == MQTT_CONNACK_ACCEPTED);
+    assert_true(response.decoded.connack.properties_size == 8);
+
+    /* unknown properties and DISCONNECT on a MQTT v3.1.1 connection are malformed */
+    assert_true(mqtt_unpack_response5(&response, bad_property, sizeof(bad_property)) < 0);
+    assert_true(mqtt_unpack_response(&response, disconnect, sizeof(disconnect)) < 0);
+
+    rv = mqtt_pack_disconnect5(buf, sizeof(buf), MQTT_REASON_DISCONNECT_WITH_WILL_MESSAGE);
+    assert_true(rv == 3);
+    assert_true(buf[0] == MQTT_CONTROL_DISCONNECT << 4);
+    assert_true(buf[1] == 1 && buf[2] == MQTT_REASON_DISCONNECT_WITH_WILL_MESSAGE);
+}
+
 static void TEST__utility__connect_disconnect(void** state) {
     uint8_t buf[256];
     struct mqtt_client client;
@@ -612,6 +771,252 @@ static void TEST__utility__pid_lfsr(void **unused) {
     assert_true(period == 65535u);
 }
 
+struct recv_stream_state {
+    int publishes;
+    size_t payload_bytes;
+    uint8_t payload[2048];
+    size_t payload_size;
+    uint8_t segmented[2048];
+    int segments;
+    size_t next_offset;
+};
+
+static void recv_stream_publish(void** state, struct mqtt_response_publish *publish) {
+    struct recv_stream_state *stream = *(struct recv_stream_state**) state;
+    assert_true(publish->topic_name_size == 6);
+    assert_true(memcmp(publish->topic_name, "stream", 6) == 0);
+    assert_true(publish->application_message_size <= sizeof(stream->payload));
+    memcpy(stream->payload, publish->application_message, publish->application_message_size);
+    stream->payload_size = publish->application_message_size;
+    stream->payload_bytes += publish->application_message_size;
+    stream->publishes++;
+}
+
+static void recv_stream_segment(void** state, struct mqtt_response_publish *publish, size_t offset, size_t total_size) {
+    struct recv_stream_state *stream = *(struct recv_stream_state**) state;
+    assert_true(publish->topic_name_size == 6);
+    assert_true(memcmp(publish->topic_name, "stream", 6) == 0);
+    assert_true(offset == stream->next_offset);
+    assert_true(offset + publish->application_message_size <= total_size);
+    assert_true(total_size <= sizeof(stream->segmented));
+    memcpy(stream->segmented + offset, publish->application_message, publish->application_message_size);
+    stream->next_offset += publish->application_message_size;
+    stream->segments++;
+}
+
+/* A client that reads from one end of a socket pair, the test writes to the other */
+static void recv_stream_init(struct mqtt_client *client, int sv[2], uint8_t *sendmem, size_t sendsz,
+                             uint8_t *recvmem, size_t recvsz, struct recv_stream_state *stream) {
+    assert_true(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+    fcntl(sv[0], F_SETFL, fcntl(sv[0], F_GETFL) | O_NONBLOCK);
+    mqtt_init(client, sv[0], sendmem, sendsz, recvmem, recvsz, recv_stream_publish);
+    client->publish_response_callback_state = stream;
+    client->error = MQTT_OK;
+    /* unlocked during CONNECT, which is skipped here */
+    MQTT_PAL_MUTEX_UNLOCK(&client->mutex);
+    memset(stream, 0, sizeof(*stream));
+}
+
+static void TEST__utility__recv_stream(void **unused) {
+    struct mqtt_client client;
+    struct recv_stream_state stream;
+    uint8_t sendmem[256], recvmem[64];
+    uint8_t packets[512];
+    size_t packets_size = 0, i;
+    int sv[2], k;
+    ssize_t rv;
+
+    recv_stream_init(&client, sv, sendmem, sizeof(sendmem), recvmem, sizeof(recvmem), &stream);
+
+    /* 20 publishes with 0 to 9 byte payloads, 10 to 19 bytes each, more than fits in the receive buffer at once */
+    for(k = 0; k < 20; ++k) {
+        char payload[16];
+        memset(payload, 'a' + k, sizeof(payload));
+        rv = mqtt_pack_publish_request(packets + packets_size, sizeof(packets) - packets_size, "stream", 0,
+                                       payload, (size_t) (k % 10), MQTT_PUBLISH_QOS_0);
+        assert_true(rv > 0);
+        packets_size += (size_t) rv;
+    }
+
+    /* one byte at a time, every fixed header and payload arrives in pieces */
+    for(i = 0; i < packets_size; ++i) {
+        assert_true(send(sv[1], packets + i, 1, 0) == 1);
+        assert_true(__mqtt_recv(&client) == MQTT_OK);
+    }
+    assert_true(stream.publishes == 20);
+    assert_true(stream.payload_bytes == 90);
+    assert_true(stream.payload_size == 9);
+    assert_true(stream.payload[0] == 'a' + 19);
+
+    /* all at once, packets straddle the end of the buffer */
+    assert_true(send(sv[1], packets, packets_size, 0) == (ssize_t) packets_size);
+    assert_true(__mqtt_recv(&client) == MQTT_OK);
+    assert_true(stream.publishes == 40);
+    assert_true(stream.payload_bytes == 180);
+
+    /* a publish larger than the buffer fails without a segment callback */
+    {
+        uint8_t big[256];
+        char payload[200];
+        memset(payload, 'x', sizeof(payload));
+        rv = mqtt_pack_publish_request(big, sizeof(big), "stream", 0, payload, sizeof(payload), MQTT_PUBLISH_QOS_0);
+        assert_true(rv > 0);
+        assert_true(send(sv[1], big, (size_t) rv, 0) == rv);
+        assert_true(__mqtt_recv(&client) == MQTT_ERROR_RECV_BUFFER_TOO_SMALL);
+        assert_true(client.error == MQTT_ERROR_RECV_BUFFER_TOO_SMALL);
+    }
+
+    close(sv[0]);
+    close(sv[1]);
+}
+
+static void TEST__utility__recv_segments(void **unused) {
+    struct mqtt_client client;
+    struct recv_stream_state stream;
+    uint8_t sendmem[512], recvmem[64];
+    uint8_t packets[2048];
+    char payload[1500];
+    size_t packets_size = 0, i;
+    uint16_t packet_id = 1234;
+    int sv[2];
+    ssize_t rv;
+
+    recv_stream_init(&client, sv, sendmem, sizeof(sendmem), recvmem, sizeof(recvmem), &stream);
+    mqtt_set_publish_segment_callback(&client, recv_stream_segment);
+
+    /* a QoS 1 publish more than 20 times the size of the buffer, then a small one */
+    for(i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (char) (i * 7);
+    }
+    rv = mqtt_pack_publish_request(packets, sizeof(packets), "stream", packet_id,
+                                   payload, sizeof(payload), MQTT_PUBLISH_QOS_1);
+    assert_true(rv > 0);
+    packets_size += (size_t) rv;
+    rv = mqtt_pack_publish_request(packets + packets_size, sizeof(packets) - packets_size, "stream", 0,
+                                   "after", 5, MQTT_PUBLISH_QOS_0);
+    assert_true(rv > 0);
+    packets_size += (size_t) rv;
+
+    /* in uneven pieces */
+    for(i = 0; i < packets_size; i += 37) {
+        size_t n = packets_size - i < 37 ? packets_size - i : 37;
+        assert_true(send(sv[1], packets + i, n, 0) == (ssize_t) n);
+        assert_true(__mqtt_recv(&client) == MQTT_OK);
+        if (stream.next_offset < sizeof(payload)) {
+            /* not acknowledged until the whole payload has been handled */
+            assert_true(mqtt_mq_find(&client.mq, MQTT_CONTROL_PUBACK, &packet_id) == NULL);
+        }
+    }
+    assert_true(stream.segments > 20);
+    assert_true(stream.next_offset == sizeof(payload));
+    assert_true(memcmp(stream.segmented, payload, sizeof(payload)) == 0);
+    assert_true(mqtt_mq_find(&client.mq, MQTT_CONTROL_PUBACK, &packet_id) != NULL);
+
+    /* the publish after it was passed whole to the publish callback */
+    assert_true(stream.publishes == 1);
+    assert_true(stream.payload_bytes == 5);
+
+    /* and all at once */
+    stream.next_offset = 0;
+    stream.segments = 0;
+    assert_true(send(sv[1], packets, packets_size, 0) == (ssize_t) packets_size);
+    assert_true(__mqtt_recv(&client) == MQTT_OK);
+    assert_true(stream.next_offset == sizeof(payload));
+    assert_true(stream.publishes == 2);
+
+    close(sv[0]);
+    close(sv[1]);
+}
+
+/* Reads the packets the client sent from the other end of the socket pair */
+static size_t topic_alias_sent(int fd, struct mqtt_response *responses, size_t max, uint8_t *mem, size_t memsz) {
+    size_t size = 0, n = 0;
+    ssize_t rv;
+    while((rv = recv(fd, mem + size, memsz - size, MSG_DONTWAIT)) > 0) {
+        size += (size_t) rv;
+    }
+    while(size > 0 && n < max) {
+        /* only the publishes are decoded, CONNECT is not a response */
+        rv = mqtt_unpack_fixed_header(&responses[n], mem, size);
+        assert_true(rv > 0);
+        rv += (ssize_t) responses[n].fixed_header.remaining_length;
+        if (responses[n].fixed_header.control_type == MQTT_CONTROL_PUBLISH) {
+            assert_true(mqtt_unpack_response5(&responses[n], mem, size) == rv);
+        }
+        mem += rv;
+        size -= (size_t) rv;
+        ++n;
+    }
+    return n;
+}
+
+static void TEST__utility__topic_alias_receive_maximum(void **unused) {
+    struct mqtt_client client;
+    struct recv_stream_state stream;
+    struct mqtt_response sent[16];
+    uint8_t sendmem[1024], recvmem[256], mem[1024];
+    const uint8_t connack[] = {
+        MQTT_CONTROL_CONNACK << 4, 9, 0, MQTT_REASON_SUCCESS,
+        6, MQTT_PROP_TOPIC_ALIAS_MAXIMUM, 0, 1, MQTT_PROP_RECEIVE_MAXIMUM, 0, 2
+    };
+    uint8_t puback[] = { MQTT_CONTROL_PUBACK << 4, 2, 0, 0 };
+    uint16_t packet_id;
+    int sv[2];
+    size_t n;
+
+    recv_stream_init(&client, sv, sendmem, sizeof(sendmem), recvmem, sizeof(recvmem), &stream);
+    assert_true(mqtt_connect5(&client, "alias", NULL, NULL, 0, NULL, NULL, MQTT_CONNECT_CLEAN_SESSION, 400, NULL) == MQTT_OK);
+    assert_true(__mqtt_send(&client) == MQTT_OK);
+    assert_true(topic_alias_sent(sv[1], sent, 16, mem, sizeof(mem)) == 1);
+    assert_true(sent[0].fixed_header.control_type == MQTT_CONTROL_CONNECT);
+
+    assert_true(send(sv[1], connack, sizeof(connack), 0) == sizeof(connack));
+    assert_true(__mqtt_recv(&client) == MQTT_OK);
+    assert_true(client.v5.topic_alias_maximum == 1);
+    assert_true(client.v5.receive_maximum == 2);
+
+    /* the first topic gets the only alias, the second is always sent in full */
+    assert_true(mqtt_publish(&client, "first", "1", 1, MQTT_PUBLISH_QOS_1) == MQTT_OK);
+    assert_true(mqtt_publish(&client, "first", "2", 1, MQTT_PUBLISH_QOS_1) == MQTT_OK);
+    assert_true(mqtt_publish(&client, "second", "3", 1, MQTT_PUBLISH_QOS_1) == MQTT_OK);
+    assert_true(mqtt_publish(&client, "first", "4", 1, MQTT_PUBLISH_QOS_0) == MQTT_OK);
+    assert_true(client.v5.num_topic_aliases == 1);
+
+    /* no more than two are in flight, and the QoS 0 one waits its turn */
+    assert_true(__mqtt_send(&client) == MQTT_OK);
+    n = topic_alias_sent(sv[1], sent, 16, mem, sizeof(mem));
+    assert_true(n == 2);
+    assert_true(sent[0].decoded.publish.topic_name_size == 5);
+    assert_true(sent[1].decoded.publish.topic_name_size == 0);
+    assert_true(*(const char*) sent[1].decoded.publish.application_message == '2');
+
+    /* acknowledging one lets the next through */
+    packet_id = sent[0].decoded.publish.packet_id;
+    puback[2] = (uint8_t) (packet_id >> 8);
+    puback[3] = (uint8_t) packet_id;
+    assert_true(send(sv[1], puback, sizeof(puback), 0) == sizeof(puback));
+    assert_true(__mqtt_recv(&client) == MQTT_OK);
+    assert_true(__mqtt_send(&client) == MQTT_OK);
+    n = topic_alias_sent(sv[1], sent, 16, mem, sizeof(mem));
+    assert_true(n == 2);
+    assert_true(sent[0].decoded.publish.topic_name_size == 6);
+    assert_true(sent[1].decoded.publish.topic_name_size == 0);
+    assert_true(*(const char*) sent[1].decoded.publish.application_message == '4');
+
+    /* a refused publish is recorded, not an error */
+    packet_id = sent[0].decoded.publish.packet_id;
+    puback[1] = 3;
+    puback[2] = (uint8_t) (packet_id >> 8);
+    puback[3] = (uint8_t) packet_id;
+    assert_true(send(sv[1], puback, 4, 0) == 4);
+    assert_true(send(sv[1], "\x97", 1, 0) == 1);
+    assert_true(__mqtt_recv(&client) == MQTT_OK);
+    assert_true(client.v5.reason_code == MQTT_REASON_QUOTA_EXCEEDED);
+
+    close(sv[0]);
+    close(sv[1]);
+}
+
 void publish_callback(void** state, struct mqtt_response_publish *publish) {
     /*char *name = (char*) malloc(publish->topic_name_size + 1);
     memcpy(name, publish->topic_name, publish->topic_name_size);
@@ -1000,6 +1405,9 @@ int main(int argc, const char *argv[]) {
         cmocka_unit_test(TEST__framing__unsuback),
         cmocka_unit_test(TEST__framing__ping),
         cmocka_unit_test(TEST__framing__disconnect),
+        cmocka_unit_test(TEST__framing__connect5),
+        cmocka_unit_test(TEST__framing__publish5),
+        cmocka_unit_test(TEST__framing__acks5),
     };
 
     rv |= cmocka_run_group_tests(framing_tests, NULL, NULL);
@@ -1008,6 +1416,9 @@ int main(int argc, const char *argv[]) {
     const struct CMUnitTest util_tests[] = {
         cmocka_unit_test(TEST__utility__message_queue),
         cmocka_unit_test(TEST__utility__pid_lfsr),
+        cmocka_unit_test(TEST__utility__recv_stream),
+        cmocka_unit_test(TEST__utility__recv_segments),
+        cmocka_unit_test(TEST__utility__topic_alias_receive_maximum),
         cmocka_unit_test(TEST__utility__connect_disconnect),
         cmocka_unit_test(TEST__utility__ping),
     };
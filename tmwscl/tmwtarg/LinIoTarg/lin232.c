@@ -29,14 +29,26 @@
  * description: Implementation of RS232 target routines for Linux
  */
 
+/* Needed for ppoll */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "tmwtargio.h"
 #include "lin232.h"
 #include "liniodiag.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#if defined(__linux__)
+#include <linux/serial.h>
+#endif
 
 #include "tmwscl/utils/tmwcnfg.h"
 #include "tmwscl/utils/tmwpltmr.h"
@@ -175,6 +187,178 @@ static TMWTYPES_CHAR * _getParityString(TMWTARG232_PARITY parity)
     return("odd");
 }
 
+/* function: _getTimeNs */
+static TMWTYPES_UINT64 _getTimeNs(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return(((TMWTYPES_UINT64)now.tv_sec * 1000000000ULL) + (TMWTYPES_UINT64)now.tv_nsec);
+}
+
+/* function: _nsToMSTime
+ *  convert a _getTimeNs value to the same scale as tmwtarg_getMSTime
+ */
+static TMWTYPES_MILLISECONDS _nsToMSTime(TMWTYPES_UINT64 timeNs)
+{
+  return((TMWTYPES_MILLISECONDS)(timeNs / 1000000ULL));
+}
+
+/* function: _setCharTime
+ *  work out how long one character takes on the line, one start bit plus
+ *  the data, parity and stop bits at the configured baud rate
+ */
+static void _setCharTime(SERIAL_IO_CHANNEL *pSerialChannel)
+{
+  TMWTYPES_ULONG bitsPerChar;
+  long baud;
+
+#if LINIOTARG_SUPPORT_LEGACY_CONFIG
+  baud = atol(_getBaudString(pSerialChannel->chnlConfig.baudRate));
+#else
+  baud = atol(pSerialChannel->chnlConfig.baudRate);
+#endif
+  if(baud <= 0)
+    baud = 9600;
+
+  bitsPerChar = 1;
+  bitsPerChar += (pSerialChannel->chnlConfig.numDataBits == TMWTARG232_DATA_BITS_8) ? 8 : 7;
+  bitsPerChar += (pSerialChannel->chnlConfig.parity == TMWTARG232_PARITY_NONE) ? 0 : 1;
+  bitsPerChar += (pSerialChannel->chnlConfig.numStopBits == TMWTARG232_STOP_BITS_1) ? 1 : 2;
+
+  pSerialChannel->charTimeNs = (TMWTYPES_ULONG)((bitsPerChar * 1000000000ULL) / (TMWTYPES_UINT64)baud);
+}
+
+/* function: _setLowLatency
+ *  ask the UART driver to push received bytes to the tty at once instead
+ *  of batching them. Not every driver supports this, a pseudo terminal
+ *  for example does not, and the port works either way.
+ */
+static void _setLowLatency(SERIAL_IO_CHANNEL *pSerialChannel)
+{
+#if defined(TIOCGSERIAL) && defined(ASYNC_LOW_LATENCY)
+  struct serial_struct serial;
+
+  if(ioctl(pSerialChannel->ttyfd, TIOCGSERIAL, &serial) != 0)
+    return;
+
+  if((serial.flags & ASYNC_LOW_LATENCY) == 0)
+  {
+    serial.flags |= ASYNC_LOW_LATENCY;
+    if(ioctl(pSerialChannel->ttyfd, TIOCSSERIAL, &serial) != 0)
+      LINIODIAG_MSG("Lin232 low latency mode not set on %s, %s", pSerialChannel->chnlConfig.portName, strerror(errno));
+  }
+#else
+  TMWTARG_UNUSED_PARAM(pSerialChannel);
+#endif
+}
+
+/* function: _waitForInput
+ *  wait up to timeoutNs for the tty to become readable
+ */
+static TMWTYPES_BOOL _waitForInput(SERIAL_IO_CHANNEL *pSerialChannel, TMWTYPES_UINT64 timeoutNs)
+{
+  struct timespec timeout;
+
+  timeout.tv_sec = (time_t)(timeoutNs / 1000000000ULL);
+  timeout.tv_nsec = (long)(timeoutNs % 1000000000ULL);
+#if TMWTARG_SUPPORT_POLL
+  return(ppoll(&pSerialChannel->pollFd, 1, &timeout, NULL) > 0);
+#else
+  {
+    fd_set rfds;
+    FD_ZERO(&rfds);
+    FD_SET(pSerialChannel->ttyfd, &rfds);
+    return(pselect(pSerialChannel->ttyfd + 1, &rfds, NULL, NULL, &timeout, NULL) > 0);
+  }
+#endif
+}
+
+/* function: _readAvailable
+ *  read what the tty holds into rxBuffer without blocking, returns the
+ *  number of bytes read
+ */
+static int _readAvailable(SERIAL_IO_CHANNEL *pSerialChannel)
+{
+  size_t space = sizeof(pSerialChannel->rxBuffer) - pSerialChannel->rxLength;
+  ssize_t bytesRead;
+
+  if(space == 0)
+    return(0);
+
+  do
+  {
+    bytesRead = read(pSerialChannel->ttyfd, &pSerialChannel->rxBuffer[pSerialChannel->rxLength], space);
+  } while((bytesRead < 0) && (errno == EINTR));
+
+  if(bytesRead < 0)
+  {
+    if((errno != EAGAIN) && (errno != EWOULDBLOCK))
+      LINIODIAG_ERRORMSG("Lin232 read failed %s", strerror(errno));
+    return(0);
+  }
+
+  pSerialChannel->rxLength = (TMWTYPES_USHORT)(pSerialChannel->rxLength + bytesRead);
+  return((int)bytesRead);
+}
+
+/* function: _fillRxBuffer
+ *  Read the bytes waiting on the tty into rxBuffer. wakeTimeNs is when the
+ *  tty was seen to be readable, it becomes the time of the first byte if
+ *  the buffer was empty. For Modbus RTU keep reading until the line has
+ *  been idle for numCharTimesBetweenFrames character times, so a whole
+ *  frame is passed up at once, and note any gap longer than
+ *  interCharTimeout character times inside the frame.
+ */
+static void _fillRxBuffer(SERIAL_IO_CHANNEL *pSerialChannel, TMWTYPES_UINT64 wakeTimeNs)
+{
+  TMWTYPES_BOOL wasEmpty;
+
+  /* Move anything not yet passed up to the start of the buffer */
+  if(pSerialChannel->rxOffset != 0)
+  {
+    pSerialChannel->rxLength = (TMWTYPES_USHORT)(pSerialChannel->rxLength - pSerialChannel->rxOffset);
+    memmove(pSerialChannel->rxBuffer, &pSerialChannel->rxBuffer[pSerialChannel->rxOffset], pSerialChannel->rxLength);
+    pSerialChannel->rxOffset = 0;
+  }
+
+  wasEmpty = (TMWTYPES_BOOL)(pSerialChannel->rxLength == 0);
+  if(_readAvailable(pSerialChannel) == 0)
+    return;
+
+  if(wasEmpty)
+  {
+    pSerialChannel->rxFirstByteTime = _nsToMSTime(wakeTimeNs);
+    pSerialChannel->rxInterCharTimeout = TMWDEFS_FALSE;
+  }
+
+  if(pSerialChannel->chnlConfig.bModbusRTU == TMWDEFS_TRUE)
+  {
+    TMWTYPES_UINT64 frameGapNs;
+    TMWTYPES_UINT64 charGapNs;
+    TMWTYPES_UINT64 lastByteNs;
+
+    frameGapNs = (TMWTYPES_UINT64)pSerialChannel->charTimeNs * TMWDEFS_MAX(pSerialChannel->numCharTimesBetweenFrames, 1);
+    charGapNs = (TMWTYPES_UINT64)pSerialChannel->charTimeNs * pSerialChannel->interCharTimeout;
+
+    lastByteNs = _getTimeNs();
+    while(pSerialChannel->rxLength < sizeof(pSerialChannel->rxBuffer))
+    {
+      TMWTYPES_UINT64 now;
+
+      if(!_waitForInput(pSerialChannel, frameGapNs))
+        break;
+
+      now = _getTimeNs();
+      if((charGapNs != 0) && ((now - lastByteNs) > charGapNs))
+        pSerialChannel->rxInterCharTimeout = TMWDEFS_TRUE;
+
+      if(_readAvailable(pSerialChannel) == 0)
+        break;
+      lastByteNs = now;
+    }
+  }
+}
+
 /* function: lin232_initChannel */
 void * TMWDEFS_GLOBAL lin232_initChannel(
   const void *pUserConfig,
@@ -209,6 +393,7 @@ void * TMWDEFS_GLOBAL lin232_initChannel(
   pTargIoChannel->pChannelReadyCbkParam = pTmwConfig->pChannelReadyCbkParam;
   pSerialChannel->numCharTimesBetweenFrames = pTmwConfig->numCharTimesBetweenFrames; 
   pSerialChannel->interCharTimeout = pTmwConfig->interCharTimeout;
+  _setCharTime(pSerialChannel);
 
   /* Set up the Channel Operation Functions */
   pTargIoChannel->pOpenFunction       = lin232_openChannel;
@@ -257,7 +442,8 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL lin232_openChannel(
   /* zero out the structure */
   memset(&settings, 0, sizeof(settings));
 
-  if ((ttyfd = open(pSerialChannel->chnlConfig.portName, O_RDWR | O_NOCTTY)) < 0)
+  /* The tty is only read when poll reports it readable, so reads never block */
+  if ((ttyfd = open(pSerialChannel->chnlConfig.portName, O_RDWR | O_NOCTTY | O_NONBLOCK)) < 0)
   {
     LINIODIAG_ERRORMSG("Lin232 Error opening %s, %s",  pSerialChannel->chnlConfig.portName, strerror(errno));
     return TMWDEFS_FALSE;
@@ -338,44 +524,29 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL lin232_openChannel(
   settings.c_lflag |= IEXTEN;
 
 
-  if(pSerialChannel->chnlConfig.bModbusRTU == TMWDEFS_TRUE)
-  { 
-    int bitsPerChar;
-    int timeBetweenFrames;
-
-    /* for modbus RTU, a message must be contiguous, with no more than 3 empty frames.
-     * For now, we will use this fact to extablish the end of a message. 
-     */
-
-    /* 1 start bit, 8 data bits, 1 parity bit + 2 stop bits */
-    bitsPerChar = 12;
-    
-    /* time in deciseconds  */
-    timeBetweenFrames = ((pSerialChannel->numCharTimesBetweenFrames*bitsPerChar*10) /9600 /*dcb.BaudRate*/) + 1;
-
-    /* The following two combined mean when there is a gap between chars or 255 chars are    *  received the read will return
-     */
-    settings.c_cc[VMIN] = 255;
-    /* time between frames in deciseconds,  1/10 of a second. */
-    settings.c_cc[VTIME] = timeBetweenFrames;
-  }
-  else
-  {
-    settings.c_cc[VMIN] = 0;
-    settings.c_cc[VTIME] = 0;
-  }
+  /* Reads return whatever has arrived. The end of a Modbus RTU frame is
+   * found by _fillRxBuffer from the gap between characters, measured at
+   * the configured baud rate rather than in the tenths of a second VTIME
+   * allows.
+   */
+  settings.c_cc[VMIN] = 0;
+  settings.c_cc[VTIME] = 0;
 
   if(tcsetattr(ttyfd, TCSANOW, &settings ) < 0)
   {
     LINIODIAG_ERRORMSG("Lin232 tcsetattr failed %s", strerror(errno));
+    close(ttyfd);
     return(TMWDEFS_FALSE);
   }
 
   pSerialChannel->ttyfd = ttyfd;
+  pSerialChannel->rxLength = 0;
+  pSerialChannel->rxOffset = 0;
 #if TMWTARG_SUPPORT_POLL
   pSerialChannel->pollFd.fd = ttyfd;
   pSerialChannel->pollFd.events = POLLIN;
 #endif
+  _setLowLatency(pSerialChannel);
   return(TMWDEFS_TRUE);
 }
 
@@ -386,6 +557,11 @@ void TMWDEFS_GLOBAL lin232_closeChannel(
   SERIAL_IO_CHANNEL *pSerialChannel = (SERIAL_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
   close(pSerialChannel->ttyfd);
   pSerialChannel->ttyfd = -1;
+  pSerialChannel->rxLength = 0;
+  pSerialChannel->rxOffset = 0;
+#if TMWTARG_SUPPORT_POLL
+  pSerialChannel->pollFdGeneration++;
+#endif
 }
 
 /* function: lin232_getTransmitReady */
@@ -405,38 +581,43 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL lin232_receive(
   TMWTYPES_BOOL *pInterCharTimeoutOccurred)
 {
   SERIAL_IO_CHANNEL *pSerialChannel = (SERIAL_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
-  int bytesReceived;
-#if !TMWTARG_SUPPORT_POLL
-  fd_set          rfds;
-  struct timeval  tv;
-#endif
+  TMWTYPES_USHORT bytesReceived;
   TMWTARG_UNUSED_PARAM(maxTimeout);
-  TMWTARG_UNUSED_PARAM(pInterCharTimeoutOccurred);
 
-  bytesReceived = 0;
+  /* Bytes are normally read by lin232_checkForInputFunction when the tty
+   * becomes readable. In polled mode, or once those have all been passed
+   * up, read whatever else has arrived.
+   */
+  if((pSerialChannel->rxOffset == pSerialChannel->rxLength) && (pSerialChannel->ttyfd != -1))
+  {
+    pSerialChannel->rxOffset = 0;
+    pSerialChannel->rxLength = 0;
+    _fillRxBuffer(pSerialChannel, _getTimeNs());
+  }
 
-#if TMWTARG_SUPPORT_POLL
-  if (poll(&pSerialChannel->pollFd, 1, 0) > 0)
+  bytesReceived = (TMWTYPES_USHORT)TMWDEFS_MIN(maxBytes, pSerialChannel->rxLength - pSerialChannel->rxOffset);
+  if(bytesReceived == 0)
+    return(0);
+
+  memcpy(pBuff, &pSerialChannel->rxBuffer[pSerialChannel->rxOffset], bytesReceived);
+  pSerialChannel->rxOffset = (TMWTYPES_USHORT)(pSerialChannel->rxOffset + bytesReceived);
+  pSerialChannel->firstByteTime = pSerialChannel->rxFirstByteTime;
+
+  if(pSerialChannel->rxInterCharTimeout)
   {
-#else
-  tv.tv_sec = 0;
-  tv.tv_usec = 0;
-  FD_ZERO(&rfds);
-  FD_SET(pSerialChannel->ttyfd, &rfds);
-
-  if(select(pSerialChannel->ttyfd + 1, &rfds, NULL, NULL, &tv) != -1)
-  {  
-    if(FD_ISSET( pSerialChannel->ttyfd, &rfds))
-#endif
-    {
-      if((bytesReceived = read(pSerialChannel->ttyfd, pBuff, maxBytes)) == -1)
-      {
-        LINIODIAG_ERRORMSG("Lin232 read failed %s", strerror(errno));
-        bytesReceived = 0;
-      }
-    }
+    if(pInterCharTimeoutOccurred != TMWDEFS_NULL)
+      *pInterCharTimeoutOccurred = TMWDEFS_TRUE;
+    pSerialChannel->rxInterCharTimeout = TMWDEFS_FALSE;
   }
-  return bytesReceived;
+  return(bytesReceived);
+}
+
+/* function: lin232_getFirstByteTime */
+TMWTYPES_MILLISECONDS TMWDEFS_GLOBAL lin232_getFirstByteTime(
+  TMWTARG_IO_CHANNEL *pTargIoChannel)
+{
+  SERIAL_IO_CHANNEL *pSerialChannel = (SERIAL_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
+  return(pSerialChannel->firstByteTime);
 }
 
 /* function: lin232_transmit */
@@ -463,26 +644,70 @@ void TMWDEFS_GLOBAL lin232_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
   if (pSerialChannel->ttyfd != -1)
   {
 #if TMWTARG_SUPPORT_POLL
-    if (poll(&pSerialChannel->pollFd, 1, timeout) > 0)
+    /* Include the timerfd so the channel thread returns when a timer expires */
+    struct pollfd pollFds[2];
+    pollFds[0] = pSerialChannel->pollFd;
+    TMWTYPES_BOOL buffered = (TMWTYPES_BOOL)(pSerialChannel->rxOffset != pSerialChannel->rxLength);
+    pollFds[1].fd = tmwtargio_getMultiTimerFd(pTargIoChannel->pChannel);
+    pollFds[1].events = POLLIN;
+
+    /* Do not wait if bytes read earlier have not all been passed up yet */
+    if (((poll(pollFds, 2, buffered ? 0 : TMWTARGIO_POLL_TIMEOUT(timeout)) > 0) && (pollFds[0].revents != 0)) || buffered)
 #else
+    TMWTYPES_BOOL   buffered = (TMWTYPES_BOOL)(pSerialChannel->rxOffset != pSerialChannel->rxLength);
     fd_set          rfds;
     struct timeval  tv;
 
-    tv.tv_sec = 0;
-    tv.tv_usec = timeout * 1000;
+    tv.tv_sec = buffered ? 0 : timeout / 1000;
+    tv.tv_usec = buffered ? 0 : (timeout % 1000) * 1000;
     FD_ZERO(&rfds);
     FD_SET(pSerialChannel->ttyfd, &rfds);
 
-    if (select(pSerialChannel->ttyfd + 1, &rfds, NULL, NULL, &tv) > 0)
+    if ((select(pSerialChannel->ttyfd + 1, &rfds, NULL, NULL, &tv) > 0) || buffered)
 #endif
     {
+      /* Stamp the bytes with the time the tty was seen to be readable */
+      _fillRxBuffer(pSerialChannel, _getTimeNs());
       pTargIoChannel->pReceiveCallbackFunc(pTargIoChannel->pCallbackParam);
     }
   }
   else
   {
-    tmwtarg_sleep(500);
+#if TMWCNFG_SUPPORT_THREADS
+    /* A runtime worker waits on the timer itself */
+    if (pTargIoChannel->pWorkerContext)
+      return;
+#endif
+    tmwtargio_waitMultiTimer(pTargIoChannel->pChannel, 500);
+  }
+}
+
+#if TMWTARG_SUPPORT_POLL
+/* function: lin232_getPollFds */
+int TMWDEFS_GLOBAL lin232_getPollFds(TMWTARG_IO_CHANNEL *pTargIoChannel, struct pollfd *pPollFds,
+  int maxFds, TMWTYPES_BOOL *pReady, TMWTYPES_ULONG *pGeneration)
+{
+  SERIAL_IO_CHANNEL *pSerialChannel = (SERIAL_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
+  int numFds = 0;
+
+  *pGeneration = pSerialChannel->pollFdGeneration;
+
+  /* Bytes already read from the tty will not make it readable again */
+  *pReady = (TMWTYPES_BOOL)((pSerialChannel->ttyfd != -1) && (pSerialChannel->rxOffset != pSerialChannel->rxLength));
+
+  if ((pSerialChannel->ttyfd != -1) && (numFds < maxFds))
+  {
+    pPollFds[numFds] = pSerialChannel->pollFd;
+    pPollFds[numFds++].revents = 0;
+  }
+  if ((tmwtargio_getMultiTimerFd(pTargIoChannel->pChannel) != -1) && (numFds < maxFds))
+  {
+    pPollFds[numFds].fd = tmwtargio_getMultiTimerFd(pTargIoChannel->pChannel);
+    pPollFds[numFds].events = POLLIN;
+    pPollFds[numFds++].revents = 0;
   }
+  return numFds;
 }
+#endif
   
 #endif /* #if TMWTARG_SUPPORT_232 */
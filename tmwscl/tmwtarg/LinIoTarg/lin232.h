@@ -40,6 +40,11 @@
 #include <poll.h>
 #endif
 
+/* Size of the buffer the tty is drained into when it becomes readable */
+#ifndef LIN232_RX_BUFFER_SIZE
+#define LIN232_RX_BUFFER_SIZE 2048
+#endif
+
 /* Define serial port channel */
 typedef struct SerialIOChannel {
 
@@ -62,8 +67,28 @@ typedef struct SerialIOChannel {
   TMWTYPES_INT       ttyfd;
   speed_t            portSpeed;
 
+  /* Time to transmit one character at the configured baud rate and framing */
+  TMWTYPES_ULONG     charTimeNs;
+
+  /* Bytes read from the tty that have not yet been passed to the SCL */
+  TMWTYPES_UCHAR     rxBuffer[LIN232_RX_BUFFER_SIZE];
+  TMWTYPES_USHORT    rxLength;
+  TMWTYPES_USHORT    rxOffset;
+
+  /* Time the first byte in rxBuffer was seen, and whether an inter
+   * character gap was seen inside the frame
+   */
+  TMWTYPES_MILLISECONDS rxFirstByteTime;
+  TMWTYPES_BOOL      rxInterCharTimeout;
+
+  /* Time the first byte of the most recently received chunk was seen */
+  TMWTYPES_MILLISECONDS firstByteTime;
+
 #if TMWTARG_SUPPORT_POLL
   struct pollfd   pollFd;
+
+  /* Changed whenever the tty is closed */
+  TMWTYPES_ULONG  pollFdGeneration;
 #endif
 
 } SERIAL_IO_CHANNEL;
@@ -108,6 +133,26 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL lin232_transmit(
 void TMWDEFS_GLOBAL lin232_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChannel,
   TMWTYPES_MILLISECONDS timeout);
 
+/* function: lin232_getFirstByteTime
+ *  Return the time the first byte returned by the last call to
+ *  lin232_receive was seen on the tty.
+ */
+TMWTYPES_MILLISECONDS TMWDEFS_GLOBAL lin232_getFirstByteTime(
+  TMWTARG_IO_CHANNEL *pTargIoChannel);
+
+#if TMWTARG_SUPPORT_POLL
+/* function: lin232_getPollFds
+ *  Fill in up to maxFds descriptors the channel is waiting on, so a
+ *  runtime worker can wait on many channels at once. Returns the number.
+ *  *pReady is set if bytes already read from the tty are waiting to be
+ *  passed to the SCL. *pGeneration changes whenever the tty has been
+ *  closed since the last call.
+ */
+int TMWDEFS_GLOBAL lin232_getPollFds(TMWTARG_IO_CHANNEL *pTargIoChannel,
+  struct pollfd *pPollFds, int maxFds, TMWTYPES_BOOL *pReady,
+  TMWTYPES_ULONG *pGeneration);
+#endif
+
 #endif /* #if TMWTARG_SUPPORT_232 */
 
 #endif /* lin232_DEFINED */
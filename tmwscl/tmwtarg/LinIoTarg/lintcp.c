@@ -30,11 +30,17 @@
 * description: Implementation of TCP/IP target routines for Linux
 */
 
+/* Needed for accept4 and pipe2 */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "tmwscl/utils/tmwcnfg.h"
 #include "tmwscl/utils/tmwtarg.h"
 #include "tmwscl/utils/tmwpltmr.h"
 #include "lintls.h"
 #include "tmwtargio.h"
+#include "tmwtargrt.h"
 
 #if TMWTARG_SUPPORT_TCP
 #include <ifaddrs.h>
@@ -48,6 +54,11 @@
 static TMWDEFS_RESOURCE_LOCK _tcpSemaphore  = TMWDEFS_NULL;
 static TCP_LISTENER         *_pTcpListeners = TMWDEFS_NULL;
 
+static TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener, SOCKET listenSocket);
+#if LINTCP_LISTENER_THREADS
+static void _stopListenerThreads(TCP_LISTENER *pTcpListener);
+#endif
+
 #if TMWTARG_SUPPORT_UDP
 static TMWTYPES_BOOL _setupUDP(TCP_IO_CHANNEL *pTcpChannel);
 static void _inputUdpData(TCP_IO_CHANNEL *pTcpChannel);
@@ -87,6 +98,10 @@ void * TMWDEFS_GLOBAL linTCP_initChannel(
   pTcpChannel->pollFds[SOCKET_INDEX_UDP].events = POLLIN;
   pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].fd = INVALID_SOCKET;
   pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].events = POLLIN;
+  pTcpChannel->pollFds[SOCKET_INDEX_WAKE].fd = INVALID_SOCKET;
+  pTcpChannel->pollFds[SOCKET_INDEX_WAKE].events = POLLIN;
+  pTcpChannel->pollFds[SOCKET_INDEX_TIMER].fd = INVALID_SOCKET;
+  pTcpChannel->pollFds[SOCKET_INDEX_TIMER].events = POLLIN;
 
   pTcpChannel->newConnectionRcvd = TMWDEFS_FALSE;
 
@@ -117,11 +132,13 @@ void * TMWDEFS_GLOBAL linTCP_initChannel(
   pTargIoChannel->pDeleteFunction     = linTCP_deleteChannel;
   
   pTargIoChannel->polledMode = pTcpChannel->chnlConfig.polledMode;
-  if (pipe(pTcpChannel->pipeFd) == -1)
+  /* Non blocking, a full pipe already wakes the thread that empties it */
+  if (pipe2(pTcpChannel->pipeFd, O_NONBLOCK | O_CLOEXEC) == -1)
   {
     LINIODIAG_ERRORMSG("TCP(%s), Unable to create pipe", pTcpChannel->chnlConfig.chnlName);
     return TMWDEFS_NULL;
   }
+  pTcpChannel->pollFds[SOCKET_INDEX_WAKE].fd = pTcpChannel->pipeFd[0];
 
   sprintf(pTargIoChannel->chanInfoBuf,"Nic: %s Port: %s:%d",
     pTcpChannel->chnlConfig.nicName,
@@ -160,27 +177,22 @@ void TMWDEFS_GLOBAL linTCP_deleteChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
   /* If this was using a listener, see if any other channels still need that listener */
   if (pTcpChannel->pTcpListener)
   {
+    TCP_LISTENER *pDeleteListener = TMWDEFS_NULL;
+
     TMWTARG_LOCK_SECTION(&_tcpSemaphore);
     if (((TCP_LISTENER *)pTcpChannel->pTcpListener)->numIoChannels == 1)
     {
       /* This is the only channel using this listener, delete it. */
       TCP_LISTENER *pTcpListener = _pTcpListeners;
       TCP_LISTENER **pListenerAnchor = &_pTcpListeners;
-      TCP_LISTENER *pTemp;
 
       while (pTcpListener != NULL)
       {
         if (pTcpListener == pTcpChannel->pTcpListener)
         { 
-          /* Close the listener socket */
-          close(pTcpListener->listenSocket);
-          pTcpListener->listenSocket = INVALID_SOCKET;
-
-          /* Remove the listener from the list and free it */
+          /* Remove the listener from the list, it is freed below */
           *pListenerAnchor = pTcpListener->pNext;
-          pTemp = pTcpListener;
-          pTcpListener = pTcpListener->pNext;
-          free(pTemp);
+          pDeleteListener = pTcpListener;
           break;
         }
         pListenerAnchor = &pTcpListener->pNext;
@@ -192,6 +204,9 @@ void TMWDEFS_GLOBAL linTCP_deleteChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
       /* Search for this Tcp channel in the listener's list & remove it. */
       int tcpChannelIndex;
       TCP_LISTENER *pTcpListener = pTcpChannel->pTcpListener;
+
+      /* Wait for any accept that may be handing a connection to this channel */
+      TMWTARG_LOCK_SECTION(&pTcpListener->listenerLock);
       for (tcpChannelIndex = 0; tcpChannelIndex < MAX_LISTENING_CHANNELS; tcpChannelIndex++)
       {
         if (pTargIoChannel == pTcpListener->ioChannelPtrs[tcpChannelIndex])
@@ -201,8 +216,39 @@ void TMWDEFS_GLOBAL linTCP_deleteChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
           break;
         }
       }
+      TMWTARG_UNLOCK_SECTION(&pTcpListener->listenerLock);
     }
     TMWTARG_UNLOCK_SECTION(&_tcpSemaphore);
+
+    /* Listener threads are stopped without holding the TCP lock */
+    if (pDeleteListener != TMWDEFS_NULL)
+    {
+#if LINTCP_LISTENER_THREADS
+      _stopListenerThreads(pDeleteListener);
+#endif
+      /* Close the listener socket and free it */
+      close(pDeleteListener->listenSocket);
+      pDeleteListener->listenSocket = INVALID_SOCKET;
+#if TMWTARG_SUPPORT_TLS
+      lintls_deleteListener(&pDeleteListener->tls);
+#endif
+      TMWTARG_LOCK_DELETE(&pDeleteListener->listenerLock);
+      free(pDeleteListener);
+    }
+
+    /* A listener that chose this channel before it was removed above */
+    /* finishes handing it the connection without the listener lock.  */
+    while (pTcpChannel->handoffPending)
+    {
+      tmwtarg_sleep(1);
+    }
+  }
+
+  /* Close a connection handed to the channel after it was last closed */
+  if (pTcpChannel->dataSocket != INVALID_SOCKET)
+  {
+    close(pTcpChannel->dataSocket);
+    pTcpChannel->dataSocket = INVALID_SOCKET;
   }
 
   if (pTcpChannel->pipeFd[0] != INVALID_SOCKET)
@@ -293,6 +339,19 @@ TMWTYPES_BOOL _connect(TCP_IO_CHANNEL *pTcpChannel)
   LINIODIAG_MSG("TCP(%s), Connecting to %s %s", pTcpChannel->chnlConfig.chnlName,
                 pTcpChannel->chnlConfig.ipAddress, portName);
 
+#if TMWTARG_SUPPORT_POLL
+  /* Empty wake ups written before this attempt, such as by the disconnect */
+  /* that preceded it, so they do not end the wait for this connection.   */
+  pollFd[0].fd = pTcpChannel->pipeFd[0];
+  pollFd[0].events = POLLIN;
+  while (poll(pollFd, 1, 0) > 0)
+  {
+    char tempChars[16];
+    if (read(pTcpChannel->pipeFd[0], tempChars, sizeof(tempChars)) <= 0)
+      break;
+  }
+#endif
+
   dataSocket = socket(pTcpChannel->afInet, SOCK_STREAM, IPPROTO_TCP);
   if (dataSocket == INVALID_SOCKET)
   {
@@ -389,6 +448,7 @@ TMWTYPES_BOOL _connect(TCP_IO_CHANNEL *pTcpChannel)
     /* simply read the character to clear empty the pipe and return. */
     char tempChar;
     read(pTcpChannel->pipeFd[0], &tempChar, 1);
+    close(dataSocket);
     return(TMWDEFS_FALSE);
   }
  
@@ -429,6 +489,7 @@ TMWTYPES_BOOL _connect(TCP_IO_CHANNEL *pTcpChannel)
     /* simply read the character to clear empty the pipe and return. */
     char tempChar;
     read(pTcpChannel->pipeFd[0], &tempChar, 1);
+    close(dataSocket);
     return(TMWDEFS_FALSE);
   }
 
@@ -484,6 +545,7 @@ TMWTYPES_BOOL _disconnect(TCP_IO_CHANNEL *pTcpChannel)
   close(pTcpChannel->dataSocket);
   pTcpChannel->dataSocket = INVALID_SOCKET;
   pTcpChannel->pollFds[SOCKET_INDEX_DATA].fd = INVALID_SOCKET;
+  pTcpChannel->pollFdsGeneration++;
   pTcpChannel->clientConnected = TMWDEFS_FALSE;
 
   TMWTARG_UNLOCK_SECTION(&pTcpChannel->tcpChannelLock);
@@ -500,6 +562,193 @@ TMWTYPES_BOOL _disconnect(TCP_IO_CHANNEL *pTcpChannel)
   return TMWDEFS_TRUE;
 }
 
+/* function: _openListenSocket
+ *  create a nonblocking socket listening on the channel's port. When there
+ *  are multiple listener threads each gets its own socket, bound to the same
+ *  port with SO_REUSEPORT so the kernel spreads new connections across them.
+ */
+static SOCKET _openListenSocket(TCP_IO_CHANNEL *pTcpChannel, struct sockaddr_in6 *pLocalAddr, struct ifreq *pIfr)
+{
+  SOCKET       listenSocket;
+  int          result;
+
+  listenSocket = socket(pTcpChannel->afInet, SOCK_STREAM | SOCK_CLOEXEC, IPPROTO_TCP);
+  if (listenSocket == INVALID_SOCKET)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), listen socket failed", pTcpChannel->chnlConfig.chnlName);
+    return(INVALID_SOCKET);
+  }
+
+  MAKE_SOCKET_REUSEADDR(listenSocket, result);
+  if (result != 0)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), reuse address failed", pTcpChannel->chnlConfig.chnlName);
+    close(listenSocket);
+    return(INVALID_SOCKET);
+  }
+
+#if LINTCP_LISTENER_THREADS > 1
+  MAKE_SOCKET_REUSEPORT(listenSocket, result);
+  if (result != 0)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), reuse port failed, %s",
+                       pTcpChannel->chnlConfig.chnlName, strerror(errno));
+    close(listenSocket);
+    return(INVALID_SOCKET);
+  }
+#endif
+
+  if (pIfr != TMWDEFS_NULL)
+  {
+    result = setsockopt(listenSocket, SOL_SOCKET, SO_BINDTODEVICE, (void *)pIfr, sizeof(struct ifreq));
+    if (result != 0) {
+      LINIODIAG_ERRORMSG("TCP(%s), listen socket bind to interface(%s) failed, %s",
+                         pTcpChannel->chnlConfig.chnlName, pIfr->ifr_name, strerror(errno));
+      close(listenSocket);
+      return(INVALID_SOCKET);
+    }
+  }
+
+  if (bind(listenSocket, (struct sockaddr *) pLocalAddr, sizeof(struct sockaddr_in6)) != 0)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), listen socket bind failed, %s",
+                       pTcpChannel->chnlConfig.chnlName, strerror(errno));
+    close(listenSocket);
+    return(INVALID_SOCKET);
+  }
+
+  if (listen(listenSocket, LINTCP_BACKLOG) != 0)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), listen failed", pTcpChannel->chnlConfig.chnlName);
+    close(listenSocket);
+    return(INVALID_SOCKET);
+  }
+
+  MAKE_SOCKET_NON_BLOCKING(listenSocket, result);
+  if (result != 0)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), non-blocking listen failed", pTcpChannel->chnlConfig.chnlName);
+    close(listenSocket);
+    return(INVALID_SOCKET);
+  }
+
+  return(listenSocket);
+}
+
+#if LINTCP_LISTENER_THREADS
+/* function: _listenerThread
+ *  accept connections from one of a listener's sockets and hand them to
+ *  the matching channels until the listener is deleted.
+ */
+static TMW_ThreadDecl _listenerThread(TMW_ThreadArg pArg)
+{
+  TCP_LISTENER_WORKER *pWorker = (TCP_LISTENER_WORKER *)pArg;
+  TCP_LISTENER        *pTcpListener = pWorker->pTcpListener;
+  struct pollfd        pollFd[2];
+
+  pollFd[0].fd     = pWorker->listenSocket;
+  pollFd[0].events = POLLIN;
+  pollFd[1].fd     = pTcpListener->stopPipeFd[0];
+  pollFd[1].events = POLLIN;
+
+  while (TMWDEFS_TRUE)
+  {
+    if (poll(pollFd, 2, -1) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      LINIODIAG_ERRORMSG("TCP: listener poll returned error %d", errno);
+      break;
+    }
+
+    /* The stop pipe is never read so every listener thread sees it */
+    if (pollFd[1].revents != 0)
+      break;
+
+    if (pollFd[0].revents != 0)
+      _accept(pTcpListener, pWorker->listenSocket);
+  }
+
+  return(TMWDEFS_NULL);
+}
+
+/* function: _startListenerThreads
+ *  start the threads that accept connections for a new listener. If none
+ *  can be started, connections are accepted by the channel threads instead.
+ */
+static void _startListenerThreads(TCP_LISTENER *pTcpListener, TCP_IO_CHANNEL *pTcpChannel,
+  struct sockaddr_in6 *pLocalAddr, struct ifreq *pIfr)
+{
+  int workerIndex;
+
+  if (pipe2(pTcpListener->stopPipeFd, O_CLOEXEC) == -1)
+  {
+    LINIODIAG_ERRORMSG("TCP(%s), Unable to create listener pipe", pTcpChannel->chnlConfig.chnlName);
+    pTcpListener->stopPipeFd[0] = INVALID_SOCKET;
+    pTcpListener->stopPipeFd[1] = INVALID_SOCKET;
+    return;
+  }
+
+  for (workerIndex = 0; workerIndex < LINTCP_LISTENER_THREADS; workerIndex++)
+  {
+    TCP_LISTENER_WORKER *pWorker = &pTcpListener->workers[workerIndex];
+    pWorker->pTcpListener = pTcpListener;
+
+    /* The first thread uses the listener's own socket */
+    if (workerIndex == 0)
+      pWorker->listenSocket = pTcpListener->listenSocket;
+    else
+      pWorker->listenSocket = _openListenSocket(pTcpChannel, pLocalAddr, pIfr);
+
+    if (pWorker->listenSocket == INVALID_SOCKET)
+      break;
+
+    if (TMW_ThreadCreate(&pWorker->threadId, _listenerThread, pWorker, 0, 0) != 0)
+    {
+      LINIODIAG_ERRORMSG("TCP(%s), Unable to create listener thread", pTcpChannel->chnlConfig.chnlName);
+      if (workerIndex != 0)
+        close(pWorker->listenSocket);
+      break;
+    }
+    pTcpListener->numWorkers++;
+  }
+
+  if (pTcpListener->numWorkers == 0)
+  {
+    close(pTcpListener->stopPipeFd[0]);
+    close(pTcpListener->stopPipeFd[1]);
+    pTcpListener->stopPipeFd[0] = INVALID_SOCKET;
+    pTcpListener->stopPipeFd[1] = INVALID_SOCKET;
+  }
+}
+
+/* function: _stopListenerThreads
+ *  stop a listener's threads and close the sockets they opened
+ */
+static void _stopListenerThreads(TCP_LISTENER *pTcpListener)
+{
+  int workerIndex;
+
+  if (pTcpListener->numWorkers == 0)
+    return;
+
+  write(pTcpListener->stopPipeFd[1], "x", 1);
+  for (workerIndex = 0; workerIndex < pTcpListener->numWorkers; workerIndex++)
+  {
+    TCP_LISTENER_WORKER *pWorker = &pTcpListener->workers[workerIndex];
+    pthread_join(pWorker->threadId, NULL);
+    if (workerIndex != 0)
+      close(pWorker->listenSocket);
+  }
+  pTcpListener->numWorkers = 0;
+
+  close(pTcpListener->stopPipeFd[0]);
+  close(pTcpListener->stopPipeFd[1]);
+  pTcpListener->stopPipeFd[0] = INVALID_SOCKET;
+  pTcpListener->stopPipeFd[1] = INVALID_SOCKET;
+}
+#endif /* LINTCP_LISTENER_THREADS */
+
 /* function: _listen */
 static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
 {
@@ -507,8 +756,8 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
   TCP_LISTENER *pTcpListener;
   struct sockaddr_in6  localAddr;
   SOCKET       listenSocket;
-  int          result;
   struct ifreq ifr;
+  struct ifreq *pIfr = TMWDEFS_NULL;
 
   /* if there is already a listener on this port, don't listen again */
   if (pTcpChannel->pTcpListener)
@@ -526,16 +775,32 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
       /* already listening on this port, add this Tcp channel to the listener's list */
       int tcpChannelIndex;
       TMWTYPES_BOOL channelAdded = TMWDEFS_FALSE;
+
+      /* Listener threads may be handing out a connection */
+      TMWTARG_LOCK_SECTION(&pTcpListener->listenerLock);
       for (tcpChannelIndex = 0; tcpChannelIndex < MAX_LISTENING_CHANNELS; tcpChannelIndex++)
       {
         if (pTcpListener->ioChannelPtrs[tcpChannelIndex] == TMWDEFS_NULL)
         {
+#if TMWTARG_SUPPORT_TLS
+          lintls_joinListener(pTcpChannel, &pTcpListener->tls);
+#endif
           pTcpListener->ioChannelPtrs[tcpChannelIndex] = pTargIoChannel;
           pTcpListener->numIoChannels++;
           channelAdded = TMWDEFS_TRUE;
           break;
         }
       }
+      TMWTARG_UNLOCK_SECTION(&pTcpListener->listenerLock);
+
+      /* Remember the listener so this channel is not added again by the */
+      /* next open and is removed from the list when it is deleted       */
+      if (channelAdded)
+        pTcpChannel->pTcpListener = (void *)pTcpListener;
+      else
+        LINIODIAG_ERRORMSG("TCP(%s), more than %d channels listening on port %d",
+          pTcpChannel->chnlConfig.chnlName, MAX_LISTENING_CHANNELS, pTcpChannel->chnlConfig.ipPort);
+
       TMWTARG_UNLOCK_SECTION(&_tcpSemaphore);
       return channelAdded;
     }
@@ -555,21 +820,6 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
     memcpy(&pTcpChannel->ipAddr, &in->sin_addr, sizeof(struct in_addr));
   }
 
-  listenSocket = socket(pTcpChannel->afInet, SOCK_STREAM, IPPROTO_TCP);
-  if (listenSocket == INVALID_SOCKET)
-  {
-    LINIODIAG_ERRORMSG("TCP(%s), listen socket failed", pTcpChannel->chnlConfig.chnlName);
-    return(TMWDEFS_FALSE);
-  }
-
-  MAKE_SOCKET_REUSEADDR(listenSocket, result);
-  if (result != 0)
-  {
-    LINIODIAG_ERRORMSG("TCP(%s), reuse address failed", pTcpChannel->chnlConfig.chnlName);
-    close(listenSocket);
-    return(TMWDEFS_FALSE);
-  }
-
   if(strcmp(pTcpChannel->chnlConfig.nicName, "") != 0) {
     char *p_char;
     int   nic_name_len;
@@ -585,13 +835,7 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
     } 
     /*If the nicName contain an alias (eth0:5), only copy the interface part (eth0) */
     strncpy(&ifr.ifr_name[0], &pTcpChannel->chnlConfig.nicName[0], nic_name_len - alias_len);
-    result = setsockopt(listenSocket, SOL_SOCKET, SO_BINDTODEVICE, (void *)&ifr, sizeof(ifr));
-    if (result != 0) {
-      LINIODIAG_ERRORMSG("TCP(%s), listen socket bind to interface(%s) failed, %s",
-                         pTcpChannel->chnlConfig.chnlName, ifr.ifr_name, strerror(errno));
-      close(listenSocket);
-      return(TMWDEFS_FALSE);
-    }
+    pIfr = &ifr;
 
     if (getifaddrs(&ifa) == -1) {
       LINIODIAG_ERRORMSG("TCP(%s), listen socket getifaddrs failed, %s",
@@ -624,28 +868,12 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
       }
       ifa_tmp = ifa_tmp->ifa_next;
     }
+    freeifaddrs(ifa);
   } 
 
-  if (bind(listenSocket, (struct sockaddr *) &localAddr, sizeof(localAddr)) != 0)
-  {
-    LINIODIAG_ERRORMSG("TCP(%s), listen socket bind failed, %s",
-                       pTcpChannel->chnlConfig.chnlName, strerror(errno));
-    close(listenSocket);
-    return(TMWDEFS_FALSE);
-  }
-
-  if (listen(listenSocket, LINTCP_BACKLOG) != 0)
-  {
-    LINIODIAG_ERRORMSG("TCP(%s), listen failed", pTcpChannel->chnlConfig.chnlName);
-    close(listenSocket);
-    return(TMWDEFS_FALSE);
-  }
-
-  MAKE_SOCKET_NON_BLOCKING(listenSocket, result);
-  if (result != 0)
+  listenSocket = _openListenSocket(pTcpChannel, &localAddr, pIfr);
+  if (listenSocket == INVALID_SOCKET)
   {
-    LINIODIAG_ERRORMSG("TCP(%s), non-blocking listen failed", pTcpChannel->chnlConfig.chnlName);
-    close(listenSocket);
     return(TMWDEFS_FALSE);
   }
 
@@ -663,6 +891,14 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
   pTcpListener->listenAddr = pTcpChannel->ipAddr;
   pTcpListener->numIoChannels = 1;
   pTcpListener->ioChannelPtrs[0] = pTargIoChannel;
+  TMWTARG_LOCK_INIT(&pTcpListener->listenerLock);
+#if TMWTARG_SUPPORT_TLS
+  lintls_joinListener(pTcpChannel, &pTcpListener->tls);
+#endif
+#if LINTCP_LISTENER_THREADS
+  pTcpListener->stopPipeFd[0] = INVALID_SOCKET;
+  pTcpListener->stopPipeFd[1] = INVALID_SOCKET;
+#endif
   pTcpChannel->pTcpListener = (void *)pTcpListener;
 
   TMWTARG_LOCK_SECTION(&_tcpSemaphore);
@@ -673,37 +909,33 @@ static TMWTYPES_BOOL _listen(TMWTARG_IO_CHANNEL *pTargIoChannel)
 
   TMWTARG_UNLOCK_SECTION(&_tcpSemaphore);
 
+#if LINTCP_LISTENER_THREADS
+  _startListenerThreads(pTcpListener, pTcpChannel, &localAddr, pIfr);
+#endif
+
   LINIODIAG_MSG("TCP(%s), listening on port %d",
     pTcpChannel->chnlConfig.chnlName, pTcpChannel->chnlConfig.ipPort);
 
   return(TMWDEFS_TRUE);
 }
 
-/* function: _accept */
-TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
+/* function: _handoff
+ *  give a newly accepted socket to the channel whose address and port
+ *  match it, or close it if no channel wants it.
+ */
+static TMWTYPES_BOOL _handoff(TCP_LISTENER *pTcpListener, SOCKET acceptSocket, struct sockaddr_in *pRemoteAddr)
 {
   int                 result;
-  SOCKET              acceptSocket;
-  struct sockaddr_in  remoteAddr;
-  socklen_t           remoteAddrLen;
   TCP_IO_CHANNEL      *pTcpChannel;
   TCP_IO_CHANNEL      *pUseThisTcpChannel;
   TMWTARG_IO_CHANNEL  *pUseThisIoChannel = TMWDEFS_NULL;
+  TMWTYPES_BOOL       disconnectOld = TMWDEFS_FALSE;
   int                 tcpChannelIndex = 0;
 
-  remoteAddrLen = sizeof(remoteAddr);
-  acceptSocket = accept(pTcpListener->listenSocket,
-    (struct sockaddr *) &remoteAddr, &remoteAddrLen);
-  if (acceptSocket == INVALID_SOCKET)
-  {
-    LINIODIAG_ERRORMSG("TCP: accept failed");
-    return(TMWDEFS_FALSE);
-  }
-
 #if defined(DEBUG_LINIOTARG)
   {
     int a,b,c,d;
-    unsigned long temp = remoteAddr.sin_addr.s_addr;
+    unsigned long temp = pRemoteAddr->sin_addr.s_addr;
     a = (temp >> 24);
     temp = temp << 8;
     b = (temp >> 24);
@@ -715,15 +947,8 @@ TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
   }
 #endif
 
-  /* We have a new connection, set up socket parameters for TCP */
-  MAKE_SOCKET_NON_BLOCKING(acceptSocket, result);
-  if (result != 0)
-  {
-    LINIODIAG_ERRORMSG("MAKE_SOCKET_N_BLOCKING returned %d", result);
-    close(acceptSocket);
-    return(TMWDEFS_FALSE);
-  }
-
+  /* We have a new connection, set up socket parameters for TCP.  */
+  /* accept4 has already made it nonblocking.                     */
   MAKE_SOCKET_NO_DELAY(acceptSocket, result);
   if (result != 0)
   { 
@@ -742,6 +967,9 @@ TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
 
   pUseThisTcpChannel = TMWDEFS_NULL;
 
+  /* Keep channels from being removed from the listener while one is chosen */
+  TMWTARG_LOCK_SECTION(&pTcpListener->listenerLock);
+
   /* Look for a matching channel */
   for (tcpChannelIndex = 0; tcpChannelIndex < MAX_LISTENING_CHANNELS; tcpChannelIndex++)
   {
@@ -757,28 +985,24 @@ TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
     {
       /* See if the address and port matches */
       if(((strcmp(pTcpChannel->chnlConfig.ipAddress, "*.*.*.*") == 0)
-        ||(inet_addr(pTcpChannel->chnlConfig.ipAddress) == remoteAddr.sin_addr.s_addr))
+        ||(inet_addr(pTcpChannel->chnlConfig.ipAddress) == pRemoteAddr->sin_addr.s_addr))
         && (pTcpChannel->chnlConfig.ipPort == pTcpListener->listenPort))
       { 
         /* If channel is not yet connected */
         if (pTcpChannel->dataSocket == INVALID_SOCKET)
         {
-#if TMWTARG_SUPPORT_TLS
-          if (lintls_listen(pTcpChannel, acceptSocket))
+          /* A channel the library has closed is skipped until it is opened */
+          /* again, unless it was closed because the remote end went away   */
+          /* and is being reopened. A channel another thread is handing a   */
+          /* connection to is skipped as well.                              */
+          if (!pTcpChannel->handoffPending
+            && ((pTargIoChannel->chanState == TMWTARG_CHANNEL_OPENED) || pTcpChannel->reopenPending))
           {
             pUseThisTcpChannel = pTcpChannel;
             pUseThisIoChannel = pTargIoChannel;
+            disconnectOld = TMWDEFS_FALSE;
             break;
           }
-          else
-          {
-            LINIODIAG_MSG("TCP: lintls_listen failed");
-          }
-#else
-          pUseThisTcpChannel = pTcpChannel;
-          pUseThisIoChannel = pTargIoChannel;
-          break;
-#endif
         }
         else /* already connected */
         {
@@ -790,6 +1014,8 @@ TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
             /* Keep looking for available channel, but save this channel to use if an unconnected channel is not found. */
             /* If this channel needs to be disconnected the code to start this process is below */
             pUseThisTcpChannel = pTcpChannel;
+            pUseThisIoChannel = pTargIoChannel;
+            disconnectOld = TMWDEFS_TRUE;
           }
 
           /* If this is a DNP dual end point outstation, 
@@ -797,12 +1023,14 @@ TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
            */
           else if ((pTcpChannel->chnlConfig.mode == TMWTARGTCP_MODE_DUAL_ENDPOINT)
                 &&(pTcpChannel->chnlConfig.role == TMWTARGTCP_ROLE_OUTSTATION)
-                &&(pTcpChannel->clientConnected))
+                &&(pTcpChannel->clientConnected)
+                &&(!pTcpChannel->handoffPending))
           {  
             /* Close existing connection and accept the new connection.*/
             LINIODIAG_MSG("TCP: Accept Dual End Point outstation, previously connected to this ip address and a new connection has come in");
             _disconnect(pTcpChannel);
             pUseThisTcpChannel = pTcpChannel;
+            pUseThisIoChannel = pTargIoChannel;
             break;
           } 
           /* this channel is busy, look at the next one */
@@ -811,122 +1039,219 @@ TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener)
     }
   } 
 
-  if(pUseThisTcpChannel != TMWDEFS_NULL)
+  if (pUseThisTcpChannel == TMWDEFS_NULL)
   {
-    /* if a new connection came in when already connected, mark old channel for disconnect and ignore new connection
-     * The next linTCP_receive() will see that newConnectionRcvd is true, 
-     * calling channel callback to inform the SCL the connection has closed with reason TMWDEFS_TARG_OC_NEW_CONNECTION
-     * The SCL will call tmwtarg_closeChannel() which will result in old connection being closed.
-     * Then the next SYN will connect and result in a channel callback indicating the new connection.
-     * If new connection comes in before next linTCP_receive(), the old connection has not closed yet so same thing happens again
-     * until linTCP_receive() sees newConnectionRcvd is true.
-     */
-    if (pUseThisTcpChannel->dataSocket != INVALID_SOCKET)
-    {
-      LINIODIAG_MSG("TCP: Mark old connection for disconnect so it can receive next connect"); 
-      pUseThisTcpChannel->newConnectionRcvd = TMWDEFS_TRUE;;
+    /* No one interested so close the socket */
+    TMWTARG_UNLOCK_SECTION(&pTcpListener->listenerLock);
+    close(acceptSocket);
+    return(TMWDEFS_FALSE);
+  }
 
-      close(acceptSocket);
-      return(TMWDEFS_FALSE);
-    }
+  /* if a new connection came in when already connected, mark old channel for disconnect and ignore new connection
+   * The next linTCP_receive() will see that newConnectionRcvd is true, 
+   * calling channel callback to inform the SCL the connection has closed with reason TMWDEFS_TARG_OC_NEW_CONNECTION
+   * The SCL will call tmwtarg_closeChannel() which will result in old connection being closed.
+   * Then the next SYN will connect and result in a channel callback indicating the new connection.
+   * If new connection comes in before next linTCP_receive(), the old connection has not closed yet so same thing happens again
+   * until linTCP_receive() sees newConnectionRcvd is true.
+   */
+  if (disconnectOld)
+  {
+    LINIODIAG_MSG("TCP: Mark old connection for disconnect so it can receive next connect"); 
+    pUseThisTcpChannel->newConnectionRcvd = TMWDEFS_TRUE;
+
+    TMWTARG_UNLOCK_SECTION(&pTcpListener->listenerLock);
+    close(acceptSocket);
+    return(TMWDEFS_FALSE);
+  }
 
-    LINIODIAG_MSG("TCP: Accept this connection");
+  /* Reserve the channel and let go of the listener, so a slow TLS */
+  /* handshake does not hold up the other connections on this port. */
+  pUseThisTcpChannel->handoffPending = TMWDEFS_TRUE;
+  TMWTARG_UNLOCK_SECTION(&pTcpListener->listenerLock);
+
+#if TMWTARG_SUPPORT_TLS
+  if (!lintls_listen(pUseThisTcpChannel, acceptSocket))
+  {
+    LINIODIAG_MSG("TCP: lintls_listen failed");
+    pUseThisTcpChannel->handoffPending = TMWDEFS_FALSE;
+    close(acceptSocket);
+    return(TMWDEFS_FALSE);
+  }
+#endif
+
+  LINIODIAG_MSG("TCP: Accept this connection");
 #if TMWTARG_SUPPORT_UDP
-    /* If configured for it, save the address from the master to
-     * be used for comparing with src address in UDP requests.
-     */
-    if(pUseThisTcpChannel->chnlConfig.validateUDPAddress)
-    {
-      pUseThisTcpChannel->validUDPAddress = remoteAddr.sin_addr.s_addr;
-    }
+  /* If configured for it, save the address from the master to
+   * be used for comparing with src address in UDP requests.
+   */
+  if(pUseThisTcpChannel->chnlConfig.validateUDPAddress)
+  {
+    pUseThisTcpChannel->validUDPAddress = pRemoteAddr->sin_addr.s_addr;
+  }
 #endif
 
-    if (pUseThisIoChannel->pChannelCallback != TMWDEFS_NULL)
-    {
-      pUseThisIoChannel->pChannelCallback(pUseThisIoChannel->pChannelCallbackParam,
-        TMWDEFS_TRUE, /* open */
-        TMWDEFS_TARG_OC_SUCCESS);
+  /* Store the socket before telling the library. The channel's open  */
+  /* succeeds as soon as it finds the socket, and the open callback is */
+  /* made by the channel's own thread, which this wakes. That thread  */
+  /* owns the channel, so the callback never runs on a listener thread */
+  /* that a channel being deleted could be waiting for.               */
+  TMWTARG_LOCK_SECTION(&pUseThisTcpChannel->tcpChannelLock);
+  pUseThisTcpChannel->clientConnected = TMWDEFS_FALSE;
+  pUseThisTcpChannel->dataSocket = acceptSocket;
+  pUseThisTcpChannel->pollFds[SOCKET_INDEX_DATA].fd = acceptSocket;
+  pUseThisTcpChannel->connectionPending = (pUseThisIoChannel->pChannelCallback != TMWDEFS_NULL);
+  TMWTARG_UNLOCK_SECTION(&pUseThisTcpChannel->tcpChannelLock);
+
+  linTCP_wakeChannelThread(pUseThisIoChannel);
+  pUseThisTcpChannel->handoffPending = TMWDEFS_FALSE;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _accept
+ *  accept the connections waiting on a listen socket, up to
+ *  LINTCP_ACCEPT_BATCH of them, and hand each to its channel.
+ *  Returns true if any connection was handed off.
+ */
+static TMWTYPES_BOOL _accept(TCP_LISTENER *pTcpListener, SOCKET listenSocket)
+{
+  SOCKET              acceptSocket;
+  struct sockaddr_in6 remoteAddr;
+  socklen_t           remoteAddrLen;
+  TMWTYPES_BOOL       accepted = TMWDEFS_FALSE;
+  int                 count;
 
-      pTcpChannel->clientConnected = TMWDEFS_FALSE;
-      pUseThisTcpChannel->dataSocket = acceptSocket;
-      pUseThisTcpChannel->pollFds[SOCKET_INDEX_DATA].fd = acceptSocket;
+  for (count = 0; count < LINTCP_ACCEPT_BATCH; count++)
+  {
+    remoteAddrLen = sizeof(remoteAddr);
+    acceptSocket = accept4(listenSocket, (struct sockaddr *) &remoteAddr,
+      &remoteAddrLen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (acceptSocket == INVALID_SOCKET)
+    {
+      /* Another thread may have taken the connection, or the backlog is empty */
+      if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)
+        && (errno != ECONNABORTED))
+      {
+        LINIODIAG_ERRORMSG("TCP: accept failed, %s", strerror(errno));
+      }
+      if (errno != ECONNABORTED)
+        break;
+      continue;
     }
+
+    if (_handoff(pTcpListener, acceptSocket, (struct sockaddr_in *)&remoteAddr))
+      accepted = TMWDEFS_TRUE;
   }
-  else
+
+  return(accepted);
+}
+
+/* function: _chanThread_sleep
+ *  sleep function implemented for the channel thread.
+ *  It supports preemption using poll/select in the case that the channel is shutdown.
+ *  If the channel has a timerfd driving its timer queue, timers that expire
+ *  during the sleep are serviced without cutting the sleep short.
+ */
+static void _chanThread_sleep(TCP_IO_CHANNEL *pTcpChannel, TMWCHNL *pChannel, TMWTYPES_MILLISECONDS timeout)
+{
+#if TMWTARG_SUPPORT_POLL
+  struct pollfd         pollFd[2];
+  TMWTYPES_MILLISECONDS startTime = tmwtarg_getMSTime();
+  TMWTYPES_MILLISECONDS elapsed = 0;
+
+  pollFd[0].fd     = pTcpChannel->pipeFd[0];
+  pollFd[0].events = POLLIN;
+  pollFd[1].fd     = tmwtargio_getMultiTimerFd(pChannel);
+  pollFd[1].events = POLLIN;
+
+  while (poll(pollFd, 2, (timeout == TMWTARG_WAIT_FOREVER) ? -1 : (int)(timeout - elapsed)) > 0)
   {
-    /* No one interested so close the socket */
-    close(acceptSocket);
-    return(TMWDEFS_FALSE);
+    if (pollFd[0].revents != 0)
+#else
+  struct timeval  timeval_out;
+  fd_set          readFds;
+
+  TMWTARG_UNUSED_PARAM(pChannel);
+  timeval_out.tv_sec = timeout / 1000;
+  timeval_out.tv_usec = (timeout % 1000) * 1000;
+  FD_ZERO(&readFds);
+  FD_SET(pTcpChannel->pipeFd[0], &readFds);
+  if (select(pTcpChannel->pipeFd[0]+1, &readFds, NULL, NULL, &timeval_out) == 1)
+#endif
+    {
+      /* The channel was disconnected and a character written to the pipe to wake up */
+      /* the channel thread simply read the character to clear empty the pipe.       */
+      char tempChar;
+      read(pTcpChannel->pipeFd[0], &tempChar, 1);
+#if TMWTARG_SUPPORT_POLL
+      return;
+    }
+
+    tmwtargio_checkMultiTimer(pChannel);
+    elapsed = tmwtarg_getMSTime() - startTime;
+    if (elapsed >= timeout)
+    {
+      return;
+    }
+#endif
   }
+}
 
-  return(TMWDEFS_TRUE);
+/* function: linTCP_waitChannelThread */
+void TMWDEFS_GLOBAL linTCP_waitChannelThread(TMWTARG_IO_CHANNEL *pTargIoChannel, TMWTYPES_MILLISECONDS timeout)
+{
+  TCP_IO_CHANNEL *pTcpChannel = (TCP_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
+  _chanThread_sleep(pTcpChannel, pTargIoChannel->pChannel, timeout);
 }
 
 /* function: _checkListener 
  *  check for activity on a listen on a socket
  */
-static TMWTYPES_BOOL _checkListener(TCP_IO_CHANNEL *pTcpChannel, TMWTYPES_MILLISECONDS timeout)
+static TMWTYPES_BOOL _checkListener(TCP_IO_CHANNEL *pTcpChannel, TMWCHNL *pChannel, TMWTYPES_MILLISECONDS timeout)
 {
   TCP_LISTENER   *pTcpListener = (TCP_LISTENER *)pTcpChannel->pTcpListener;
   if (pTcpListener == TMWDEFS_NULL)
   {
-    tmwtarg_sleep(timeout);
+    _chanThread_sleep(pTcpChannel, pChannel, timeout);
     return TMWDEFS_FALSE;
   }
 
+#if LINTCP_LISTENER_THREADS
+  /* Listener threads accept the connections and wake this thread */
+  if (pTcpListener->numWorkers > 0)
+  {
+    _chanThread_sleep(pTcpChannel, pChannel, timeout);
+    return (pTcpChannel->dataSocket != INVALID_SOCKET);
+  }
+#endif
+
 #if TMWTARG_SUPPORT_POLL
-  struct pollfd   pollFd;
-  pollFd.fd     = pTcpListener->listenSocket;
-  pollFd.events = POLLIN;
+  /* Include the timerfd so the channel thread returns when a timer expires */
+  struct pollfd   pollFd[2];
+  pollFd[0].fd     = pTcpListener->listenSocket;
+  pollFd[0].events = POLLIN;
+  pollFd[1].fd     = tmwtargio_getMultiTimerFd(pChannel);
+  pollFd[1].events = POLLIN;
 
-  if (poll(&pollFd, 1, timeout) > 0)
+  if ((poll(pollFd, 2, TMWTARGIO_POLL_TIMEOUT(timeout)) > 0) && (pollFd[0].revents != 0))
 #else
   fd_set          rfds;
   struct timeval  tv;
 
-  tv.tv_sec = 0;
-  tv.tv_usec = timeout * 1000;
+  TMWTARG_UNUSED_PARAM(pChannel);
+  tv.tv_sec = timeout / 1000;
+  tv.tv_usec = (timeout % 1000) * 1000;
   FD_ZERO(&rfds);
   FD_SET(pTcpListener->listenSocket, &rfds);
 
   if (select(pTcpListener->listenSocket + 1, &rfds, NULL, NULL, &tv) > 0)
 #endif
   {
-    return (_accept(pTcpListener));
+    return (_accept(pTcpListener, pTcpListener->listenSocket));
   }
   return TMWDEFS_FALSE;
 }
 
-/* function: _chanThread_sleep
- *  sleep function implemented for the channel thread.
- *  It supports preemption using poll/select in the case that the channel is shutdown.
- */
-static void _chanThread_sleep(TCP_IO_CHANNEL *pTcpChannel, TMWTYPES_MILLISECONDS timeout)
-{
-#if TMWTARG_SUPPORT_POLL
-  struct pollfd pollFd;
-  pollFd.fd     = pTcpChannel->pipeFd[0];
-  pollFd.events = POLLIN;
-
-  if (poll(&pollFd, 1, timeout) == 1)
-#else
-  struct timeval  timeval_out;
-  fd_set          readFds;
-
-  timeval_out.tv_sec = 0;
-  timeval_out.tv_usec = timeout * 1000;
-  FD_ZERO(&readFds);
-  FD_SET(pTcpChannel->pipeFd[0], &readFds);
-  if (select(pTcpChannel->pipeFd[0]+1, &readFds, NULL, NULL, &timeval_out) == 1)
-#endif
-  {
-    /* The channel was disconnected and a character written to the pipe to wake up */
-    /* the channel thread simply read the character to clear empty the pipe.       */
-    char tempChar;
-    read(pTcpChannel->pipeFd[0], &tempChar, 1);
-  }
-}
-
 /* function: linTCP_openChannel */
 TMWTYPES_BOOL linTCP_openChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
 {
@@ -959,6 +1284,9 @@ TMWTYPES_BOOL linTCP_openChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
   }
 #endif
 
+  /* The library is opening the channel itself now */
+  pTcpChannel->reopenPending = TMWDEFS_FALSE;
+
   /* If configured for UDP only, don't listen or connect, return success or failure */
   if (pTcpChannel->chnlConfig.mode != TMWTARGTCP_MODE_UDP)
   { 
@@ -977,9 +1305,18 @@ TMWTYPES_BOOL linTCP_openChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
            */
           if (pTargIoChannel->chanThreadState == TMWTARG_THREAD_IDLE)
           {
-            _checkListener(pTcpChannel, 0);
+            _checkListener(pTcpChannel, TMWDEFS_NULL, 0);
+            status = (pTcpChannel->dataSocket != INVALID_SOCKET);
           }
         }
+        else
+        {
+          /* A listener handed the channel a connection while it was closed. */
+          /* This open reports it, and the channel's thread is woken to read */
+          /* it rather than finishing the wait it started while closed.      */
+          pTcpChannel->connectionPending = TMWDEFS_FALSE;
+          linTCP_wakeChannelThread(pTargIoChannel);
+        }
       }
     }
 
@@ -995,7 +1332,7 @@ TMWTYPES_BOOL linTCP_openChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
          */
         if (pTargIoChannel->chanThreadState == TMWTARG_THREAD_IDLE)
         {
-          _connect(pTcpChannel);
+          status = _connect(pTcpChannel);
         }
       }
       else
@@ -1016,6 +1353,10 @@ TMWTYPES_BOOL linTCP_openChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
       if (status == TMWDEFS_TRUE)
       {
         TCP_LISTENER   *pTcpListener = (TCP_LISTENER *)pTcpChannel->pTcpListener;
+#if LINTCP_LISTENER_THREADS
+        /* Listener threads accept new connections for this channel */
+        if (pTcpListener->numWorkers == 0)
+#endif
         pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].fd = pTcpListener->listenSocket;
       }
     }
@@ -1030,6 +1371,7 @@ void TMWDEFS_GLOBAL linTCP_closeChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
   TCP_IO_CHANNEL *pTcpChannel = (TCP_IO_CHANNEL *) pTargIoChannel->pChannelInfo;
 
   LINIODIAG_MSG("TCP(%s), closeChannel ", pTcpChannel->chnlConfig.chnlName);
+  pTcpChannel->reopenPending = TMWDEFS_FALSE;
 
   /* Check TLS configuration */
   if (pTcpChannel->chnlConfig.useTLS)
@@ -1047,6 +1389,7 @@ void TMWDEFS_GLOBAL linTCP_closeChannel(TMWTARG_IO_CHANNEL *pTargIoChannel)
       close(pTcpChannel->udpSocket);
       pTcpChannel->udpSocket = INVALID_SOCKET;
       pTcpChannel->pollFds[SOCKET_INDEX_UDP].fd = INVALID_SOCKET;
+      pTcpChannel->pollFdsGeneration++;
     }
   }
 }
@@ -1072,6 +1415,22 @@ TMWTYPES_MILLISECONDS TMWDEFS_GLOBAL linTCP_getTransmitReady(TMWTARG_IO_CHANNEL
   return(500);    /* Wait for things to happen */
 }
 
+/* function: _checkReopen
+ *  After the channel callback reports the connection closed, note whether
+ *  the library closed the channel and will reopen it, so listeners can hand
+ *  it the remote end's next connection rather than refusing it meanwhile.
+ */
+static void _checkReopen(TMWTARG_IO_CHANNEL *pTargIoChannel, TMWTYPES_BOOL wasOpened)
+{
+  TCP_IO_CHANNEL *pTcpChannel = (TCP_IO_CHANNEL *) pTargIoChannel->pChannelInfo;
+  if (wasOpened
+    && (pTargIoChannel->chanState == TMWTARG_CHANNEL_CLOSED)
+    && (pTcpChannel->dataSocket == INVALID_SOCKET))
+  {
+    pTcpChannel->reopenPending = TMWDEFS_TRUE;
+  }
+}
+
 /* function: linTCP_receive, this also receives UDP data */
 TMWTYPES_USHORT TMWDEFS_GLOBAL linTCP_receive(
   TMWTARG_IO_CHANNEL *pTargIoChannel,
@@ -1082,6 +1441,7 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL linTCP_receive(
 {
   TCP_IO_CHANNEL    *pTcpChannel = (TCP_IO_CHANNEL *) pTargIoChannel->pChannelInfo;
   int               result;
+  TMWTYPES_BOOL     wasOpened = (pTargIoChannel->chanState == TMWTARG_CHANNEL_OPENED);
   TMWTARG_UNUSED_PARAM(maxTimeout);
   TMWTARG_UNUSED_PARAM(pInterCharTimeoutOccurred);
   
@@ -1090,16 +1450,20 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL linTCP_receive(
   {
     pTcpChannel->newConnectionRcvd = TMWDEFS_FALSE;
 
-    /* This close() is not necessary, the callback would cause the library to call tmwtarg_close()
-     * but this consistedn with what is done throughout this file
+    /* The callback causes the library to call tmwtarg_closeChannel which
+     * disconnects. Disconnecting here as well could close a connection a
+     * listener thread handed to the channel in between.
      */
-    _disconnect(pTcpChannel);
-
     if (pTargIoChannel->pChannelCallback != TMWDEFS_NULL)
     {
       pTargIoChannel->pChannelCallback(pTargIoChannel->pChannelCallbackParam,
         TMWDEFS_FALSE, /* close */
         TMWDEFS_TARG_OC_NEW_CONNECTION);
+      _checkReopen(pTargIoChannel, wasOpened);
+    }
+    else
+    {
+      _disconnect(pTcpChannel);
     }
     return(0);
   }
@@ -1142,18 +1506,25 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL linTCP_receive(
       /* if errno indicates there is no data available, simply return 0. */
       return((TMWTYPES_USHORT) 0);
     }
-    if (result >= 0)
+    /* Zero means the remote end closed the connection. Close the channel */
+    /* now so it can accept the remote end when it reconnects.            */
+    if (result > 0)
     {
       return((TMWTYPES_USHORT)result);
     }
+    LINIODIAG_MSG("TCP(%s), connection closed by remote end", pTcpChannel->chnlConfig.chnlName);
   }
 
-  _disconnect(pTcpChannel);
-
+  /* As above, the library disconnects when it closes the channel */
   if (pTargIoChannel->pChannelCallback != TMWDEFS_NULL)
+  {
     pTargIoChannel->pChannelCallback(pTargIoChannel->pChannelCallbackParam,
     TMWDEFS_FALSE, /* close */
     TMWDEFS_TARG_OC_FAILURE);
+    _checkReopen(pTargIoChannel, wasOpened);
+  }
+  else
+    _disconnect(pTcpChannel);
 
   return((TMWTYPES_USHORT) 0);
 }
@@ -1174,6 +1545,8 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL linTCP_transmit(
     result = lintls_transmit(pTcpChannel, pBuff, numBytes);
     if (result != 0)
     {
+      /* The data is sent from the channel thread, wake it up */
+      linTCP_wakeChannelThread(pTargIoChannel);
       return(TMWDEFS_TRUE); 
     }
     return(TMWDEFS_FALSE);
@@ -1234,23 +1607,49 @@ void TMWDEFS_GLOBAL linTCP_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
   TCP_LISTENER   *pTcpListener = NULL;
 #endif
 
+  /* Tell the library about a connection a listener handed the channel */
+  if (pTcpChannel->connectionPending)
+  {
+    pTcpChannel->connectionPending = TMWDEFS_FALSE;
+    pTargIoChannel->pChannelCallback(pTargIoChannel->pChannelCallbackParam,
+      TMWDEFS_TRUE, /* open */
+      TMWDEFS_TARG_OC_SUCCESS);
+    return;
+  }
+
   if (_isChannelOpen(pTcpChannel))
   {
 #if TMWTARG_SUPPORT_TLS
     if (pTcpChannel->chnlConfig.useTLS)
     {
+      /* Send any buffered TLS data. If OpenSSL already holds decrypted */
+      /* data the socket will not become readable for it, so deliver it */
+      /* now rather than waiting in poll.                               */
       if (lintls_checkChannel(pTcpChannel))
       {
         pTargIoChannel->pReceiveCallbackFunc(pTargIoChannel->pCallbackParam);
+        return;
       }
-      tmwtarg_sleep(50);
-      return;
+#if TMWTARG_SUPPORT_POLL
+      pTcpChannel->pollFds[SOCKET_INDEX_DATA].events =
+        lintls_wantWrite(pTcpChannel) ? (POLLIN | POLLOUT) : POLLIN;
+#endif
     }
 #endif
 #if TMWTARG_SUPPORT_POLL
-    nfds = poll(pTcpChannel->pollFds, SOCKET_INDEX_MAX, timeout);
+    /* The timerfd is fetched each time since the channel's timer queue */
+    /* may be created after the IO channel.                              */
+    pTcpChannel->pollFds[SOCKET_INDEX_TIMER].fd = tmwtargio_getMultiTimerFd(pTargIoChannel->pChannel);
+    nfds = poll(pTcpChannel->pollFds, SOCKET_INDEX_MAX, TMWTARGIO_POLL_TIMEOUT(timeout));
     if (nfds > 0)
     {
+      if (pTcpChannel->pollFds[SOCKET_INDEX_WAKE].revents != 0)
+      {
+        /* The channel was disconnected or has TLS data to send and */
+        /* characters were written to the pipe, empty the pipe.     */
+        char tempChars[16];
+        read(pTcpChannel->pipeFd[0], tempChars, sizeof(tempChars));
+      }
 #if TMWTARG_SUPPORT_UDP
       if (pTcpChannel->pollFds[SOCKET_INDEX_UDP].revents != 0)
       {
@@ -1259,17 +1658,24 @@ void TMWDEFS_GLOBAL linTCP_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
 #endif
       if (pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].revents != 0)
       {
-        _accept(pTcpChannel->pTcpListener);
+        _accept(pTcpChannel->pTcpListener, pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].fd);
+      }
+
+      /* A timer expiring alone is handled by the channel thread on return */
+      if ((pTcpChannel->pollFds[SOCKET_INDEX_DATA].revents & ~POLLOUT)
+        || (pTcpChannel->pollFds[SOCKET_INDEX_UDP].revents != 0)
+        || (pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].revents != 0))
+      {
+        pTargIoChannel->pReceiveCallbackFunc(pTargIoChannel->pCallbackParam);
       }
-      pTargIoChannel->pReceiveCallbackFunc(pTargIoChannel->pCallbackParam);
     }
     else if (nfds < 0)
     {
       LINIODIAG_ERRORMSG("TCP(%s), checkInput: poll returned error %d", pTcpChannel->chnlConfig.chnlName, errno);
     }
 #else /* !TMWTARG_SUPPORT_POLL */
-    timeval_out.tv_sec = 0;
-    timeval_out.tv_usec = timeout * 1000;
+    timeval_out.tv_sec = timeout / 1000;
+    timeval_out.tv_usec = (timeout % 1000) * 1000;
     FD_ZERO(&readFds);
     FD_SET(pTcpChannel->dataSocket, &readFds);
     nfds = pTcpChannel->dataSocket + 1;
@@ -1302,7 +1708,7 @@ void TMWDEFS_GLOBAL linTCP_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
       pTargIoChannel->pReceiveCallbackFunc(pTargIoChannel->pCallbackParam);
       if ((pTcpListener) && (FD_ISSET(pTcpListener->listenSocket, &readFds)))
       {
-        _accept(pTcpListener);
+        _accept(pTcpListener, pTcpListener->listenSocket);
       }
     }
 #endif /* TMWTARG_SUPPORT_POLL */
@@ -1315,10 +1721,16 @@ void TMWDEFS_GLOBAL linTCP_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
 
     case TMWTARGTCP_MODE_SERVER:
     case TMWTARGTCP_MODE_DUAL_ENDPOINT:
-      _checkListener(pTcpChannel, timeout);
+      _checkListener(pTcpChannel, pTargIoChannel->pChannel, timeout);
       break;
 
     case TMWTARGTCP_MODE_CLIENT:
+#if TMWCNFG_SUPPORT_THREADS
+      /* A runtime worker leaves reconnecting to the channel's open */
+      /* timer, the same as a polled channel.                       */
+      if (pTargIoChannel->pWorkerContext)
+        break;
+#endif
       if ((_connect(pTcpChannel)) && (pTargIoChannel->chanThreadState == TMWTARG_THREAD_RUNNING))
       {
         pTargIoChannel->pChannelCallback(pTargIoChannel->pChannelCallbackParam,
@@ -1329,19 +1741,112 @@ void TMWDEFS_GLOBAL linTCP_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
       {
         if (pTargIoChannel->chanState == TMWTARG_CHANNEL_OPENED)
         {
-          _chanThread_sleep(pTcpChannel, pTcpChannel->connectRetry);
+          _chanThread_sleep(pTcpChannel, pTargIoChannel->pChannel, pTcpChannel->connectRetry);
         }
       }
       break;
 
     case TMWTARGTCP_MODE_UDP: /* connectionless, no action required */
     default: 
-      _chanThread_sleep(pTcpChannel, pTcpChannel->connectRetry);
+      _chanThread_sleep(pTcpChannel, pTargIoChannel->pChannel, pTcpChannel->connectRetry);
       break;
     }
   }
 }
 
+/* function: linTCP_wakeChannelThread */
+void TMWDEFS_GLOBAL linTCP_wakeChannelThread(TMWTARG_IO_CHANNEL *pTargIoChannel)
+{
+  TCP_IO_CHANNEL *pTcpChannel = (TCP_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
+
+#if TMWCNFG_SUPPORT_THREADS
+  /* The thread that empties the pipe sends buffered TLS data and reads */
+  /* new connections before it waits again, it does not need waking.    */
+  if ((pTargIoChannel->chanThreadState == TMWTARG_THREAD_RUNNING)
+    && pthread_equal(pthread_self(), pTargIoChannel->chanThreadHandle))
+  {
+    return;
+  }
+#if TMWTARGRT_SUPPORTED
+  if (tmwtargrt_onWorkerThread(pTargIoChannel))
+    return;
+#endif
+#endif
+
+  /* Only write to the pipe if there is a channel thread or runtime */
+  /* worker to empty it                                            */
+  if (((pTargIoChannel->chanThreadState == TMWTARG_THREAD_RUNNING)
+#if TMWCNFG_SUPPORT_THREADS
+    || (pTargIoChannel->pWorkerContext != TMWDEFS_NULL)
+#endif
+    ) && (pTcpChannel->pipeFd[1] != INVALID_SOCKET))
+  {
+    /* EAGAIN means the pipe is full, so the thread will wake anyway */
+    if ((write(pTcpChannel->pipeFd[1], "x", 1) < 0) && (errno != EAGAIN))
+    {
+      LINIODIAG_ERRORMSG("TCP(%s), Unable to wake channel thread", pTcpChannel->chnlConfig.chnlName);
+    }
+  }
+}
+
+#if TMWTARG_SUPPORT_POLL
+/* function: linTCP_getPollFds */
+int TMWDEFS_GLOBAL linTCP_getPollFds(TMWTARG_IO_CHANNEL *pTargIoChannel,
+  struct pollfd *pPollFds, int maxFds, TMWTYPES_BOOL *pReady,
+  TMWTYPES_ULONG *pGeneration)
+{
+  TCP_IO_CHANNEL *pTcpChannel = (TCP_IO_CHANNEL *)pTargIoChannel->pChannelInfo;
+  TCP_LISTENER   *pTcpListener = (TCP_LISTENER *)pTcpChannel->pTcpListener;
+  int             numFds = 0;
+  int             index;
+
+  /* The open callback for a handed over connection is made by */
+  /* linTCP_checkForInputFunction.                             */
+  *pReady = pTcpChannel->connectionPending;
+  *pGeneration = pTcpChannel->pollFdsGeneration;
+#if TMWTARG_SUPPORT_TLS
+  if ((pTcpChannel->chnlConfig.useTLS) && _isChannelOpen(pTcpChannel))
+  {
+    /* Same as linTCP_checkForInputFunction, decrypted data already */
+    /* buffered by OpenSSL must be read without waiting.            */
+    if (lintls_checkChannel(pTcpChannel))
+    {
+      *pReady = TMWDEFS_TRUE;
+    }
+    pTcpChannel->pollFds[SOCKET_INDEX_DATA].events =
+      lintls_wantWrite(pTcpChannel) ? (POLLIN | POLLOUT) : POLLIN;
+  }
+#endif
+
+  pTcpChannel->pollFds[SOCKET_INDEX_TIMER].fd = tmwtargio_getMultiTimerFd(pTargIoChannel->pChannel);
+  for (index = 0; (index < SOCKET_INDEX_MAX) && (numFds < maxFds); index++)
+  {
+    if (pTcpChannel->pollFds[index].fd != INVALID_SOCKET)
+    {
+      pPollFds[numFds] = pTcpChannel->pollFds[index];
+      pPollFds[numFds++].revents = 0;
+    }
+  }
+
+  /* While a server is waiting for a connection the listen socket is */
+  /* checked by linTCP_checkForInputFunction, unless listener threads */
+  /* are accepting connections for it.                                */
+  if (!_isChannelOpen(pTcpChannel)
+    && (pTcpListener != TMWDEFS_NULL)
+    && (pTcpChannel->pollFds[SOCKET_INDEX_LISTEN].fd == INVALID_SOCKET)
+#if LINTCP_LISTENER_THREADS
+    && (pTcpListener->numWorkers == 0)
+#endif
+    && (numFds < maxFds))
+  {
+    pPollFds[numFds].fd = pTcpListener->listenSocket;
+    pPollFds[numFds].events = POLLIN;
+    pPollFds[numFds++].revents = 0;
+  }
+  return numFds;
+}
+#endif
+
 /* function: linTCP_exit */
 void TMWDEFS_GLOBAL linTCP_exit(void)
 {
@@ -1597,6 +2102,8 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL linTCP_transmitUDP(
     {
       close(pTcpChannel->udpSocket);
       pTcpChannel->udpSocket = INVALID_SOCKET;
+      pTcpChannel->pollFds[SOCKET_INDEX_UDP].fd = INVALID_SOCKET;
+      pTcpChannel->pollFdsGeneration++;
 
       if (pTargIoChannel->pChannelCallback != TMWDEFS_NULL)
         pTargIoChannel->pChannelCallback(pTargIoChannel->pChannelCallbackParam,
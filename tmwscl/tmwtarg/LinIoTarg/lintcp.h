@@ -52,12 +52,20 @@
 #define SOCKET_ERROR            -1
 #define INVALID_SOCKET          -1
 
-#define LINTCP_BACKLOG          5
+#define LINTCP_BACKLOG          SOMAXCONN
+#define LINTCP_ACCEPT_BATCH     32
 #define LINTCP_RECV_FLAGS       0
 
 #define LINTCP_UDP_BUFFER_SIZE  8000
 #define LINTCP_MAX_UDP_FRAME    2500
 
+/* Listener threads need thread support and poll */
+#if TMWCNFG_SUPPORT_THREADS && TMWTARG_SUPPORT_POLL && (TMWTARG_TCP_LISTENER_THREADS > 0)
+#define LINTCP_LISTENER_THREADS TMWTARG_TCP_LISTENER_THREADS
+#else
+#define LINTCP_LISTENER_THREADS 0
+#endif
+
 #define MAKE_SOCKET_NON_BLOCKING( s, retval ) \
     { \
         struct sigaction sa; \
@@ -74,6 +82,13 @@
                 (char *) &cmd_arg, sizeof(cmd_arg) ); \
     }
 
+#define MAKE_SOCKET_REUSEPORT( s, ret ) \
+    { \
+        int cmd_arg = 1; \
+        ret = setsockopt( s, SOL_SOCKET, SO_REUSEPORT,  \
+                (char *) &cmd_arg, sizeof(cmd_arg) ); \
+    }
+
 #define MAKE_SOCKET_KEEPALIVE( s, ret ) \
     { \
         int cmd_arg = 1; \
@@ -93,6 +108,8 @@ enum SocketIndex
   SOCKET_INDEX_DATA,
   SOCKET_INDEX_UDP,
   SOCKET_INDEX_LISTEN,
+  SOCKET_INDEX_WAKE,
+  SOCKET_INDEX_TIMER,
   SOCKET_INDEX_MAX
 };
 
@@ -107,11 +124,28 @@ typedef struct TcpIOChannel {
   TMWTYPES_BOOL         newConnectionRcvd;
   TMWTYPES_BOOL         clientConnected;
 
+  /* Set while a listener hands this channel a connection, which is done  */
+  /* without the listener lock held. The channel is not deleted until it */
+  /* is cleared.                                                         */
+  TMWTYPES_BOOL         handoffPending;
+
+  /* A listener handed this channel a connection that the library has not */
+  /* been told about yet. The channel's own thread makes the open callback.*/
+  TMWTYPES_BOOL         connectionPending;
+
+  /* The remote end closed the connection and the library is reopening the */
+  /* channel, so a new connection can be handed to it while it is closed.  */
+  TMWTYPES_BOOL         reopenPending;
+
   SOCKET                dataSocket;
   SOCKET                udpSocket;
   int                   pipeFd[2];
   struct pollfd         pollFds[SOCKET_INDEX_MAX];
 
+  /* Changed whenever the data or UDP socket is closed, so a runtime */
+  /* worker can tell a reused descriptor number from the old one.   */
+  TMWTYPES_ULONG        pollFdsGeneration;
+
   void                 *pTcpListener;
   TMWDEFS_RESOURCE_LOCK tcpChannelLock;
 
@@ -135,7 +169,20 @@ typedef struct TcpIOChannel {
 
 } TCP_IO_CHANNEL;
 
-#define MAX_LISTENING_CHANNELS 8 
+/* Most channels that can share one listen port, such as a farm of */
+/* outstations all listening on 20000                             */
+#ifndef MAX_LISTENING_CHANNELS
+#define MAX_LISTENING_CHANNELS 256
+#endif
+
+#if LINTCP_LISTENER_THREADS
+typedef struct TcpListenerWorker {
+  struct TcpListener *pTcpListener;
+  SOCKET              listenSocket;
+  TMW_ThreadId        threadId;
+} TCP_LISTENER_WORKER;
+#endif
+
 typedef struct TcpListener {
   SOCKET              listenSocket;
   TMWTYPES_USHORT     listenPort;
@@ -143,6 +190,22 @@ typedef struct TcpListener {
   int                 numIoChannels;
   TMWTARG_IO_CHANNEL *ioChannelPtrs[MAX_LISTENING_CHANNELS];
 
+  /* Protects ioChannelPtrs and numIoChannels, which channels are added */
+  /* to and removed from while listener threads hand out connections.   */
+  TMWDEFS_RESOURCE_LOCK listenerLock;
+
+#if TMWTARG_SUPPORT_TLS
+  /* SSL context shared by the TLS channels on this listener */
+  TLS_LISTENER_CTX    tls;
+#endif
+
+#if LINTCP_LISTENER_THREADS
+  /* Threads accepting connections, each on its own SO_REUSEPORT socket */
+  int                 numWorkers;
+  int                 stopPipeFd[2];
+  TCP_LISTENER_WORKER workers[LINTCP_LISTENER_THREADS];
+#endif
+
   struct TcpListener *pNext;
 } TCP_LISTENER;
 
@@ -190,6 +253,27 @@ void TMWDEFS_GLOBAL linTCP_checkForInputFunction(TMWTARG_IO_CHANNEL *pTargIoChan
 
 void TMWDEFS_GLOBAL linTCP_wakeChannelThread(TMWTARG_IO_CHANNEL *pTargIoChannel);
 
+/* function: linTCP_waitChannelThread
+ *  Wait up to timeout for the channel's thread to be woken, servicing the
+ *  channel's timer queue meanwhile. Used while the library has the channel
+ *  closed, so a connection handed to it is read as soon as it reopens.
+ */
+void TMWDEFS_GLOBAL linTCP_waitChannelThread(TMWTARG_IO_CHANNEL *pTargIoChannel,
+  TMWTYPES_MILLISECONDS timeout);
+
+#if TMWTARG_SUPPORT_POLL
+/* function: linTCP_getPollFds
+ *  Fill in up to maxFds descriptors the channel is waiting on, so a
+ *  runtime worker can wait on many channels at once. Returns the number.
+ *  *pReady is set if the channel has input that will not make any of
+ *  its descriptors readable. *pGeneration changes whenever one of the
+ *  descriptors has been closed since the last call.
+ */
+int TMWDEFS_GLOBAL linTCP_getPollFds(TMWTARG_IO_CHANNEL *pTargIoChannel,
+  struct pollfd *pPollFds, int maxFds, TMWTYPES_BOOL *pReady,
+  TMWTYPES_ULONG *pGeneration);
+#endif
+
 void TMWDEFS_GLOBAL linTCP_exit(void);
 
 #endif /* #if TMWTARG_SUPPORT_TCP */
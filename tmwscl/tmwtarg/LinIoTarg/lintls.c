@@ -63,6 +63,9 @@ void TLSCheckForRenegotiation(TCP_IO_CHANNEL *pChannel);
 int TLSCheckStatus(TCP_IO_CHANNEL *pChannel, int status);
 void TLSReceivedPdu(TCP_IO_CHANNEL *pChannel);
 int TLSDoHandShake(TCP_IO_CHANNEL *pChannel);
+#if TMWTARG_TLS_SESSION_RESUMPTION
+static int TLSNewSessionCallback(SSL *pSSL, SSL_SESSION *pSession);
+#endif
 
 TMWTYPES_BOOL OpenSSLLoaded = TMWDEFS_FALSE;
 
@@ -230,6 +233,17 @@ SSL_CTX *TLSInitSSLCtx(TCP_IO_CHANNEL *pTcpChannel)
                           /* | SSL_OP_ALLOW_UNSAFE_LEGACY_RENEGOTIATION */
                       );
 
+#if TMWTARG_TLS_SESSION_RESUMPTION
+  /* Cache sessions so a peer reconnecting after a network outage can resume */
+  /* its previous session (by session id or ticket) instead of performing a  */
+  /* full handshake. The session id context is required for a server to     */
+  /* resume sessions when it verifies client certificates.                  */
+  SSL_CTX_set_session_cache_mode(pSslCtx, SSL_SESS_CACHE_BOTH);
+  SSL_CTX_set_session_id_context(pSslCtx, (const unsigned char *)"TMWSCL", 6);
+  SSL_CTX_set_timeout(pSslCtx, TMWTARG_TLS_SESSION_TIMEOUT);
+  SSL_CTX_sess_set_new_cb(pSslCtx, TLSNewSessionCallback);
+#endif
+
   SSL_CTX_set_default_passwd_cb_userdata(pSslCtx, NULL);
   SSL_CTX_set_default_passwd_cb(pSslCtx, password_cb);
  
@@ -467,6 +481,8 @@ void TransmitFromTLSWriteBuffer(TCP_IO_CHANNEL *pChannel)
 
 int TLSWrite(TCP_IO_CHANNEL *pTcpChannel, TMWTYPES_UCHAR *pBuf, int numCharsToSend)
 {
+  pTcpChannel->tls.wantWrite = TMWDEFS_FALSE;
+
   switch (TLSCheckRenegotiationStatus(pTcpChannel))
   {
     case RFC_SOCKET_SUCCESS:
@@ -495,6 +511,13 @@ int TLSWrite(TCP_IO_CHANNEL *pTcpChannel, TMWTYPES_UCHAR *pBuf, int numCharsToSe
   /* Try to write  */
   int r=SSL_write(pTcpChannel->tls.pSSL, pBuf, numCharsToSend);
 
+  /* Remember if the socket send buffer is full so the channel thread */
+  /* waits for it to become writable before retrying.                 */
+  if ((r <= 0) && (SSL_get_error(pTcpChannel->tls.pSSL, r) == SSL_ERROR_WANT_WRITE))
+  {
+    pTcpChannel->tls.wantWrite = TMWDEFS_TRUE;
+  }
+
   switch (TLSCheckStatus(pTcpChannel, r))
   {
     case RFC_SOCKET_SUCCESS:
@@ -831,6 +854,60 @@ void TLSReceivedPdu(TCP_IO_CHANNEL *pTcpChannel)
   }
 }
 
+#if TMWTARG_TLS_SESSION_RESUMPTION
+/* Called by OpenSSL when a new session (or TLS 1.3 session ticket) has been
+ * received. A client keeps the most recent one to offer when it reconnects.
+ * Only client connections have app data set, a server relies on the
+ * session cache in its SSL context.
+ */
+static int TLSNewSessionCallback(SSL *pSSL, SSL_SESSION *pSession)
+{
+  TCP_IO_CHANNEL *pTcpChannel = (TCP_IO_CHANNEL *)SSL_get_app_data(pSSL);
+  if (pTcpChannel == TMWDEFS_NULL)
+    return 0;
+
+  if (pTcpChannel->tls.pSession != TMWDEFS_NULL)
+    SSL_SESSION_free(pTcpChannel->tls.pSession);
+
+  /* Returning 1 keeps the reference OpenSSL passed in */
+  pTcpChannel->tls.pSession = pSession;
+  return 1;
+}
+
+/* Discard the cached client session, e.g. if resuming it failed */
+static void TLSClearSession(TCP_IO_CHANNEL *pTcpChannel)
+{
+  if (pTcpChannel->tls.pSession != TMWDEFS_NULL)
+  {
+    SSL_SESSION_free(pTcpChannel->tls.pSession);
+    pTcpChannel->tls.pSession = TMWDEFS_NULL;
+  }
+}
+#endif
+
+/* Wait until the socket is ready for the operation a nonblocking SSL_accept
+ * or SSL_connect is waiting for. Returns TMWDEFS_FALSE if the handshake
+ * timeout has expired.
+ */
+static TMWTYPES_BOOL TLSWaitForHandshake(SOCKET handshakeSocket, int sslError, TMWTYPES_MILLISECONDS endTime)
+{
+  TMWTYPES_MILLISECONDS now = tmwtarg_getMSTime();
+  if ((TMWTYPES_LONG)(endTime - now) <= 0)
+    return TMWDEFS_FALSE;
+
+#if TMWTARG_SUPPORT_POLL
+  struct pollfd pollFd;
+  pollFd.fd = handshakeSocket;
+  pollFd.events = (sslError == SSL_ERROR_WANT_WRITE) ? POLLOUT : POLLIN;
+  poll(&pollFd, 1, (int)(endTime - now));
+#else
+  TMWTARG_UNUSED_PARAM(handshakeSocket);
+  TMWTARG_UNUSED_PARAM(sslError);
+  tmwtarg_sleep(TLSCCHANNEL_DELAY);
+#endif
+  return TMWDEFS_TRUE;
+}
+
 /**********************************************************************************\
 	Function    : lintls_initChannel
 	Description : Perform all channel intialization	required to support a TLS connection 
@@ -916,6 +993,10 @@ void lintls_delete(TCP_IO_CHANNEL *pTcpChannel)
 {
   LINIODIAG_MSG("TLS(%s), delete", pTcpChannel->chnlConfig.chnlName);
 
+#if TMWTARG_TLS_SESSION_RESUMPTION
+  TLSClearSession(pTcpChannel);
+#endif
+
   /* Free the SSL context */
   if (pTcpChannel->tls.pSslCtx != TMWDEFS_NULL)
   {
@@ -926,6 +1007,86 @@ void lintls_delete(TCP_IO_CHANNEL *pTcpChannel)
   TMWTARG_LOCK_DELETE(&pTcpChannel->tls.bufferLock);
 }
 
+/* Tell whether two channels' settings create the same SSL context */
+static TMWTYPES_BOOL TLSSameCtxConfig(const TMWTARGTCP_CONFIG *pConfig, const TMWTARGTCP_CONFIG *pOther)
+{
+  return (TMWTYPES_BOOL)((strcmp(pConfig->tlsRsaPrivateKeyFile, pOther->tlsRsaPrivateKeyFile) == 0)
+    && (strcmp(pConfig->tlsRsaPrivateKeyPassPhrase, pOther->tlsRsaPrivateKeyPassPhrase) == 0)
+    && (strcmp(pConfig->tlsRsaCertificateId, pOther->tlsRsaCertificateId) == 0)
+    && (strcmp(pConfig->tlsDsaPrivateKeyFile, pOther->tlsDsaPrivateKeyFile) == 0)
+    && (strcmp(pConfig->tlsDsaPrivateKeyPassPhrase, pOther->tlsDsaPrivateKeyPassPhrase) == 0)
+    && (strcmp(pConfig->tlsDsaCertificateId, pOther->tlsDsaCertificateId) == 0)
+    && (strcmp(pConfig->caFileName, pOther->caFileName) == 0)
+    && (strcmp(pConfig->caPathName, pOther->caPathName) == 0)
+    && (strcmp(pConfig->caCrlFileName, pOther->caCrlFileName) == 0)
+    && (strcmp(pConfig->dhFileName, pOther->dhFileName) == 0)
+    && (pConfig->nCaVerifyDepth == pOther->nCaVerifyDepth));
+}
+
+/**********************************************************************************\
+	Function    :	lintls_joinListener
+	Description : Use the SSL context of the listener a server channel accepts
+	              connections on. The first TLS channel on the listener provides
+	              it, later channels with the same settings drop their own.
+	Return      :	void
+	Parameters :
+			pTcpChannel	 -	Pointer to the TCP IO Channel, opened by lintls_open
+			pListenerCtx -	SSL context of the channel's listener
+	Note : Called when the channel is added to the listener, before the
+	       listener can hand it a connection.
+\**********************************************************************************/
+void lintls_joinListener(TCP_IO_CHANNEL *pTcpChannel, TLS_LISTENER_CTX *pListenerCtx)
+{
+#if defined(OPENSSL_VERSION_NUMBER) && (OPENSSL_VERSION_NUMBER < 0x1010000fL)
+  /* SSL_CTX_up_ref is not available, each channel keeps its own context */
+  TMWTARG_UNUSED_PARAM(pTcpChannel);
+  TMWTARG_UNUSED_PARAM(pListenerCtx);
+#else
+  if (!pTcpChannel->chnlConfig.useTLS || (pTcpChannel->tls.pSslCtx == TMWDEFS_NULL))
+    return;
+
+  if (pListenerCtx->pSslCtx == TMWDEFS_NULL)
+  {
+    SSL_CTX_up_ref(pTcpChannel->tls.pSslCtx);
+    pListenerCtx->pSslCtx = pTcpChannel->tls.pSslCtx;
+    pListenerCtx->config = pTcpChannel->chnlConfig;
+    return;
+  }
+
+  if (pTcpChannel->tls.pSslCtx == pListenerCtx->pSslCtx)
+    return;
+
+  if (!TLSSameCtxConfig(&pTcpChannel->chnlConfig, &pListenerCtx->config))
+  {
+    LINIODIAG_MSG("TLS(%s), keys or CA differ from the other channels on port %d, not sharing their context",
+      pTcpChannel->chnlConfig.chnlName, pTcpChannel->chnlConfig.ipPort);
+    return;
+  }
+
+  SSL_CTX_up_ref(pListenerCtx->pSslCtx);
+  SSL_CTX_free(pTcpChannel->tls.pSslCtx);
+  pTcpChannel->tls.pSslCtx = pListenerCtx->pSslCtx;
+#endif
+}
+
+/**********************************************************************************\
+	Function    :	lintls_deleteListener
+	Description : Release the SSL context of a listener being deleted. Channels
+	              that shared it hold their own reference.
+	Return      :	void
+	Parameters :
+			pListenerCtx -	SSL context of the listener
+	Note : [none]
+\**********************************************************************************/
+void lintls_deleteListener(TLS_LISTENER_CTX *pListenerCtx)
+{
+  if (pListenerCtx->pSslCtx != TMWDEFS_NULL)
+  {
+    SSL_CTX_free(pListenerCtx->pSslCtx);
+    pListenerCtx->pSslCtx = TMWDEFS_NULL;
+  }
+}
+
 /**********************************************************************************\
 	Function    :	lintls_listen
 	Description : Listen on a TLS channel
@@ -957,15 +1118,14 @@ TMWTYPES_BOOL lintls_listen(TCP_IO_CHANNEL *pTcpChannel, SOCKET acceptSocket)
 
     int retCode;
     int r = 0;
-    int loopCount = 0;
-    int loopMax = pTcpChannel->chnlConfig.tlsHandshakeMsTimeout/TLSCCHANNEL_DELAY;
+    TMWTYPES_MILLISECONDS endTime = tmwtarg_getMSTime() + pTcpChannel->chnlConfig.tlsHandshakeMsTimeout;
     while(r <=0)
     {
       r =  SSL_accept(pTcpChannel->tls.pSSL);
       if(r<=0)
       {
         retCode = SSL_get_error(pTcpChannel->tls.pSSL, r);
-        if(retCode != SSL_ERROR_WANT_READ)
+        if((retCode != SSL_ERROR_WANT_READ) && (retCode != SSL_ERROR_WANT_WRITE))
         {
           ERR_print_errors_cb(&printOpenSSLErrors, pTcpChannel);
 
@@ -983,15 +1143,21 @@ TMWTYPES_BOOL lintls_listen(TCP_IO_CHANNEL *pTcpChannel, SOCKET acceptSocket)
           LINIODIAG_ERRORMSG("TCP LISTENER: SSL accept error, %d, %d\n", r, retCode);
           return TMWDEFS_FALSE;
         }
-        if(loopCount++ > loopMax)
+        if(!TLSWaitForHandshake(acceptSocket, retCode, endTime))
         {
           LINIODIAG_ERRORMSG("TLS(%s), accept error, handshake failure", pTcpChannel->chnlConfig.chnlName);
+          SSL_free(pTcpChannel->tls.pSSL);
+          pTcpChannel->tls.pSSL = TMWDEFS_NULL;
           return TMWDEFS_FALSE;
         }
-        tmwtarg_sleep(TLSCCHANNEL_DELAY);
       }
     }
 
+    if (SSL_session_reused(pTcpChannel->tls.pSSL))
+    {
+      LINIODIAG_MSG("TLS(%s), accept resumed previous session", pTcpChannel->chnlConfig.chnlName);
+    }
+
     if(CheckCert(pTcpChannel, pTcpChannel->tls.pSSL))
     {  
       if (pTcpChannel->chnlConfig.nTlsRenegotiationSeconds > 0)
@@ -1038,12 +1204,20 @@ TMWTYPES_BOOL lintls_connect(TCP_IO_CHANNEL *pTcpChannel, SOCKET tempCommSocket)
   {
     LINIODIAG_ERRORMSG("TLS(%s), Can't set cyphers", pTcpChannel->chnlConfig.chnlName);
   }
+
+#if TMWTARG_TLS_SESSION_RESUMPTION
+  /* Offer the session from the last connection to skip a full handshake */
+  SSL_set_app_data(pTcpChannel->tls.pSSL, pTcpChannel);
+  if (pTcpChannel->tls.pSession != TMWDEFS_NULL)
+  {
+    SSL_set_session(pTcpChannel->tls.pSSL, pTcpChannel->tls.pSession);
+  }
+#endif
  
 
   int retCode;
   int r = 0;
-  int loopCount = 0;
-  int loopMax = pTcpChannel->chnlConfig.tlsHandshakeMsTimeout/TLSCCHANNEL_DELAY;
+  TMWTYPES_MILLISECONDS endTime = tmwtarg_getMSTime() + pTcpChannel->chnlConfig.tlsHandshakeMsTimeout;
   while(r <=0)
   {
     /* If this gets nulled out somewhere else */
@@ -1058,14 +1232,13 @@ TMWTYPES_BOOL lintls_connect(TCP_IO_CHANNEL *pTcpChannel, SOCKET tempCommSocket)
     if(r<=0)
     {
       retCode = SSL_get_error(pTcpChannel->tls.pSSL, r);
-      if(retCode != 2)
+      if((retCode != SSL_ERROR_WANT_READ) && (retCode != SSL_ERROR_WANT_WRITE))
       {
         LINIODIAG_ERRORMSG("TLS(%s), connect error, %d, %d", pTcpChannel->chnlConfig.chnlName, r, retCode);
         status = TMWDEFS_FALSE;
         break;
       }
-      tmwtarg_sleep(TLSCCHANNEL_DELAY);
-      if(loopCount++ > loopMax)
+      if(!TLSWaitForHandshake(tempCommSocket, retCode, endTime))
       {
         LINIODIAG_ERRORMSG("TLS(%s), connect error, handshake failure", pTcpChannel->chnlConfig.chnlName);
         status = TMWDEFS_FALSE;
@@ -1085,12 +1258,23 @@ TMWTYPES_BOOL lintls_connect(TCP_IO_CHANNEL *pTcpChannel, SOCKET tempCommSocket)
  
   if(!status)
   { 
-    SSL_free(pTcpChannel->tls.pSSL);
-    pTcpChannel->tls.pSSL = TMWDEFS_NULL;
+    if(pTcpChannel->tls.pSSL != TMWDEFS_NULL)
+    {
+      SSL_free(pTcpChannel->tls.pSSL);
+      pTcpChannel->tls.pSSL = TMWDEFS_NULL;
+    }
+#if TMWTARG_TLS_SESSION_RESUMPTION
+    /* Don't keep offering a session that may be what the server rejected */
+    TLSClearSession(pTcpChannel);
+#endif
     return(TMWDEFS_FALSE);
   }
 
   /* Return success */
+  if (SSL_session_reused(pTcpChannel->tls.pSSL))
+  {
+    LINIODIAG_MSG("TLS(%s), Connect resumed previous session", pTcpChannel->chnlConfig.chnlName);
+  }
   LINIODIAG_MSG("TLS(%s), Connect success", pTcpChannel->chnlConfig.chnlName);
   pTcpChannel->tls.state = TMW_TLS_READY;
   return(TMWDEFS_TRUE);
@@ -1105,16 +1289,36 @@ int lintls_transmit(TCP_IO_CHANNEL *pTcpChannel, const TMWTYPES_UCHAR *pBufferTo
 
 /**********************************************************************************\
 	Function :		lintls_checkChannel
-	Description : Service the TLS channel
-	Return :			bool	-	TMWDEFS_TRUE if recieve data is available.
+	Description : Service the TLS channel, sending any buffered transmit data
+	Return :			bool	-	TMWDEFS_TRUE if decrypted receive data is already
+	                        buffered by OpenSSL. Such data does not make the
+	                        socket readable so it must be read without polling.
 	Parameters :
 			pTcpChannel	-	Pointer to the TCP IO Channel
 	Note : [none]
 \**********************************************************************************/
 TMWTYPES_BOOL lintls_checkChannel(TCP_IO_CHANNEL *pTcpChannel)
 {
+  if (pTcpChannel->tls.pSSL == TMWDEFS_NULL)
+    return TMWDEFS_FALSE;
+
   TransmitFromTLSWriteBuffer(pTcpChannel);
-  return TMWDEFS_TRUE;
+  return (SSL_pending(pTcpChannel->tls.pSSL) > 0);
+}
+
+/**********************************************************************************\
+	Function :		lintls_wantWrite
+	Description : Determine if buffered transmit data is waiting for the socket 
+	              to become writable
+	Return :			bool	-	TMWDEFS_TRUE if the channel thread should poll for POLLOUT
+	Parameters :
+			pTcpChannel	-	Pointer to the TCP IO Channel
+	Note : [none]
+\**********************************************************************************/
+TMWTYPES_BOOL lintls_wantWrite(TCP_IO_CHANNEL *pTcpChannel)
+{
+  return (pTcpChannel->tls.wantWrite
+    && (pTcpChannel->tls.bufferReadIndex != pTcpChannel->tls.bufferWriteIndex));
 }
 
 #else
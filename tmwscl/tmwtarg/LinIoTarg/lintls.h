@@ -63,8 +63,27 @@ typedef struct TlsIOChannel {
   TMWTYPES_MILLISECONDS renegotiationTimeout;
   int                   renegotiationCounter;
   TMW_TLS_State         state;
+
+  /* Last SSL_write could not complete until the socket is writable */
+  TMWTYPES_BOOL         wantWrite;
+
+  /* Session from the last client connection, offered when reconnecting */
+  SSL_SESSION          *pSession;
 } TLS_IO_CHANNEL;
 
+/* Server SSL context of a TCP listener. The TLS channels accepting
+ * connections on the listener share it, and with it the session cache
+ * and session ticket keys, so a peer can resume its session whichever
+ * channel accepts its next connection.
+ */
+typedef struct TlsListenerCtx {
+  SSL_CTX              *pSslCtx;
+
+  /* Settings the context was created from. A channel on the same port */
+  /* with different keys or certificate authorities keeps its own.     */
+  TMWTARGTCP_CONFIG     config;
+} TLS_LISTENER_CTX;
+
 /* Channel Operation Function Delcarations */
 struct TcpIOChannel;
 typedef struct TcpIOChannel TCP_IO_CHANNEL;
@@ -77,11 +96,14 @@ void lintls_delete(TCP_IO_CHANNEL *pTcpChannel);
 void lintls_terminateSslLibrary(void);
 
 TMWTYPES_BOOL lintls_listen(TCP_IO_CHANNEL *pTcpChannel, SOCKET acceptSocket);
+void lintls_joinListener(TCP_IO_CHANNEL *pTcpChannel, TLS_LISTENER_CTX *pListenerCtx);
+void lintls_deleteListener(TLS_LISTENER_CTX *pListenerCtx);
 TMWTYPES_BOOL lintls_connect(TCP_IO_CHANNEL *pTcpChannel, SOCKET tempCommSocket);
 
 int lintls_transmit(TCP_IO_CHANNEL *pTcpChannel, const TMWTYPES_UCHAR *pBufferToSend, TMWTYPES_USHORT numCharsToSend);
 int lintls_read(TCP_IO_CHANNEL *pTcpChannel, TMWTYPES_UCHAR *pBuff, int maxNumChars);
 
 TMWTYPES_BOOL lintls_checkChannel(TCP_IO_CHANNEL *pTcpChannel);
+TMWTYPES_BOOL lintls_wantWrite(TCP_IO_CHANNEL *pTcpChannel);
 #endif
 #endif /* LINTLS_H */
@@ -34,66 +34,210 @@
 
 #include <sys/stat.h>
 #include <dirent.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/inotify.h>
 #include "tmwscl/dnp/dnpdefs.h"
 #include "tmwscl/dnp/dnpcnfg.h"
 
+/* Regular files and subdirectories in a directory, as sent in response to
+ * a directory read. The cache holds one reference and every open directory
+ * read holds another. A listing is only changed in place while the cache
+ * holds the only reference, so reads see a stable snapshot.
+ */
+typedef struct SdnpTargDirEntry {
+  TMWTYPES_CHAR           *pName;
+  DNPDEFS_FILE_TYPE        type;
+  TMWTYPES_ULONG           size;
+  TMWDTIME                 timeOfCreation;
+  DNPDEFS_FILE_PERMISSIONS permissions;
+
+  /* A symbolic link, listed as what it points to. Its target is not
+   * watched, so the target is looked up again when the entry is sent.
+   */
+  TMWTYPES_BOOL            isLink;
+} SDNPTARG_DIR_ENTRY;
+
+typedef struct SdnpTargDirList {
+  TMWTYPES_ULONG           refCount;
+  TMWTYPES_ULONG           count;
+  TMWTYPES_ULONG           allocated;
+  SDNPTARG_DIR_ENTRY      *pEntries;
+} SDNPTARG_DIR_LIST;
+
+/* A cached directory, kept up to date from inotify events */
+typedef struct SdnpTargDirCache {
+  TMWTYPES_CHAR            path[DNPCNFG_MAX_FILENAME];
+  int                      watch;
+  SDNPTARG_DIR_LIST       *pList;
+  TMWTYPES_ULONG           lastUsed;
+} SDNPTARG_DIR_CACHE;
+
+#define SDNPTARG_DIR_EVENTS (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO \
+  | IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+
+static SDNPTARG_DIR_CACHE _dirCache[TMWTARG_DNPFILE_DIR_CACHE_SIZE];
+static TMWTYPES_ULONG _dirCacheUseCount = 0;
+static int _inotifyFd = -1;
+static TMWTYPES_BOOL _dirCacheInitialized = TMWDEFS_FALSE;
+static pthread_mutex_t _dirCacheLock = PTHREAD_MUTEX_INITIALIZER;
 
+
+/* Simple files are read and written with pread and pwrite through a
+ * buffer of TMWTARG_DNPFILE_BUFFER_SIZE bytes. Reads fill the buffer
+ * ahead of the blocks being sent and ask the kernel to fetch the next
+ * buffer, writes are collected in it and flushed when it is full.
+ */
 typedef struct SdnpTargFileDesc {
-  FILE                    *pCurrentFile;
-  DIR                     *pDir;
-  struct dirent           *nextEntry;
+  int                      fd;
+  SDNPTARG_DIR_LIST       *pDirList;
+  TMWTYPES_ULONG           nextEntry;
   TMWTYPES_ULONG           dnpHandle;
   TMWTYPES_USHORT          blockSize;
   TMWTYPES_BOOL            inUse;
+  TMWTYPES_BOOL            writeMode;
   TMWTYPES_CHAR            fileName[DNPCNFG_MAX_FILENAME];
   DNPDEFS_FILE_TYPE        dnpType;
   TMWTYPES_ULONG           size;
   TMWDTIME                 timeOfCreation;
   DNPDEFS_FILE_PERMISSIONS dnpPermissions;
+
+  /* Offset of the next block read from the file */
+  off_t                    offset;
+
+  /* Read ahead or unwritten data, starting at bufferOffset in the file */
+  TMWTYPES_UCHAR          *pBuffer;
+  size_t                   bufferSize;
+  size_t                   bufferLength;
+  off_t                    bufferOffset;
+
+  /* The data in the buffer runs to the end of the file */
+  TMWTYPES_BOOL            endOfFile;
 } SDNPTARG_FILE_DESC;
 
 static SDNPTARG_FILE_DESC fileDescs[DNPCNFG_MAX_FILES_OPEN] = { 0 };
 
+/* Sessions on different channels open and close files from their own threads */
+static pthread_mutex_t _fileDescLock = PTHREAD_MUTEX_INITIALIZER;
+
 static SDNPTARG_FILE_DESC * _allocFileDesc(void)
 {
   TMWTYPES_ULONG descIndex;
+  SDNPTARG_FILE_DESC *pFileDesc = TMWDEFS_NULL;
+
+  pthread_mutex_lock(&_fileDescLock);
   for (descIndex = 0; descIndex < DNPCNFG_MAX_FILES_OPEN; descIndex++)
   {
     if (fileDescs[descIndex].inUse == TMWDEFS_FALSE)
     {
-      fileDescs[descIndex].inUse = TMWDEFS_TRUE;
-      fileDescs[descIndex].dnpHandle = descIndex + SDNPTARG_FILE_HANDLE;
-      return &fileDescs[descIndex];
+      pFileDesc = &fileDescs[descIndex];
+      memset(pFileDesc, 0, sizeof(SDNPTARG_FILE_DESC));
+      pFileDesc->fd = -1;
+      pFileDesc->inUse = TMWDEFS_TRUE;
+      pFileDesc->dnpHandle = descIndex + SDNPTARG_FILE_HANDLE;
+      break;
     }
   }
-  return TMWDEFS_NULL;
+  pthread_mutex_unlock(&_fileDescLock);
+  return pFileDesc;
 }
 
 static SDNPTARG_FILE_DESC * _findFileDesc(TMWTYPES_ULONG  dnpHandle)
 {
   TMWTYPES_ULONG descIndex;
+  SDNPTARG_FILE_DESC *pFileDesc = TMWDEFS_NULL;
+
+  pthread_mutex_lock(&_fileDescLock);
   for (descIndex = 0; descIndex < DNPCNFG_MAX_FILES_OPEN; descIndex++)
   {
     if ((fileDescs[descIndex].inUse == TMWDEFS_TRUE) &&
       (fileDescs[descIndex].dnpHandle == dnpHandle))
     {
-      return &fileDescs[descIndex];
+      pFileDesc = &fileDescs[descIndex];
+      break;
     }
   }
-  return TMWDEFS_NULL;
+  pthread_mutex_unlock(&_fileDescLock);
+  return pFileDesc;
 }
 
 static void _freeFileDesc(SDNPTARG_FILE_DESC *pFileDesc)
 {
   if (pFileDesc)
   {
+    free(pFileDesc->pBuffer);
+
+    pthread_mutex_lock(&_fileDescLock);
     pFileDesc->inUse = TMWDEFS_FALSE;
-    pFileDesc->pCurrentFile = TMWDEFS_NULL;
-    pFileDesc->pDir  = TMWDEFS_NULL;
-    pFileDesc->nextEntry  = TMWDEFS_NULL;
+    pFileDesc->fd = -1;
+    pFileDesc->pBuffer = TMWDEFS_NULL;
+    pFileDesc->pDirList  = TMWDEFS_NULL;
+    pFileDesc->nextEntry  = 0;
+    pthread_mutex_unlock(&_fileDescLock);
   }
 }
 
+/* function: _fillBuffer
+ *  read the buffer from the current offset and start the kernel reading
+ *  the buffer after it
+ */
+static TMWTYPES_BOOL _fillBuffer(SDNPTARG_FILE_DESC *pFileDesc)
+{
+  size_t length = 0;
+
+  while (length < pFileDesc->bufferSize)
+  {
+    ssize_t bytesRead = pread(pFileDesc->fd, pFileDesc->pBuffer + length,
+      pFileDesc->bufferSize - length, pFileDesc->offset + (off_t)length);
+    if (bytesRead < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return(TMWDEFS_FALSE);
+    }
+    if (bytesRead == 0)
+      break;
+    length += (size_t)bytesRead;
+  }
+
+  pFileDesc->bufferOffset = pFileDesc->offset;
+  pFileDesc->bufferLength = length;
+  pFileDesc->endOfFile = (TMWTYPES_BOOL)(length < pFileDesc->bufferSize);
+
+  if (!pFileDesc->endOfFile)
+  {
+    (void)posix_fadvise(pFileDesc->fd, pFileDesc->bufferOffset + (off_t)length,
+      (off_t)pFileDesc->bufferSize, POSIX_FADV_WILLNEED);
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _flushBuffer
+ *  write the collected blocks to the file
+ */
+static TMWTYPES_BOOL _flushBuffer(SDNPTARG_FILE_DESC *pFileDesc)
+{
+  size_t written = 0;
+
+  while (written < pFileDesc->bufferLength)
+  {
+    ssize_t bytesWritten = pwrite(pFileDesc->fd, pFileDesc->pBuffer + written,
+      pFileDesc->bufferLength - written, pFileDesc->bufferOffset + (off_t)written);
+    if (bytesWritten < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return(TMWDEFS_FALSE);
+    }
+    written += (size_t)bytesWritten;
+  }
+
+  pFileDesc->bufferOffset += (off_t)written;
+  pFileDesc->bufferLength = 0;
+  return(TMWDEFS_TRUE);
+}
+
 static void _convertTime(TMWDTIME *pTmwDTime, const time_t *pTime_t)
 {
   struct tm *pFileTime = localtime(pTime_t);
@@ -123,37 +267,343 @@ static DNPDEFS_FILE_PERMISSIONS _convertPermissions(mode_t st_mode)
            (st_mode & S_IRWXU));   /* owner */
 }
 
-/* function: _directorySize */
-static size_t TMWDEFS_LOCAL _directorySize(
-  char *pDirName)
+/* function: _freeDirList */
+static void _freeDirList(
+  SDNPTARG_DIR_LIST *pList)
 {
-  DIR * dirp;
-  struct dirent * entry;
-  size_t dirSize = 0;
+  TMWTYPES_ULONG index;
+  for (index = 0; index < pList->count; index++)
+    free(pList->pEntries[index].pName);
+  free(pList->pEntries);
+  free(pList);
+}
+
+/* function: _releaseDirList
+ *  drop a reference to a listing, called with _dirCacheLock held
+ */
+static void _releaseDirList(
+  SDNPTARG_DIR_LIST *pList)
+{
+  if (--pList->refCount == 0)
+    _freeDirList(pList);
+}
+
+/* function: _findDirEntry */
+static SDNPTARG_DIR_ENTRY *_findDirEntry(
+  SDNPTARG_DIR_LIST *pList,
+  const char *pName)
+{
+  TMWTYPES_ULONG index;
+  for (index = 0; index < pList->count; index++)
+  {
+    if (strcmp(pList->pEntries[index].pName, pName) == 0)
+      return(&pList->pEntries[index]);
+  }
+  return(TMWDEFS_NULL);
+}
+
+/* function: _removeDirEntry */
+static void _removeDirEntry(
+  SDNPTARG_DIR_LIST *pList,
+  const char *pName)
+{
+  SDNPTARG_DIR_ENTRY *pEntry = _findDirEntry(pList, pName);
+  if (pEntry != TMWDEFS_NULL)
+  {
+    free(pEntry->pName);
+    *pEntry = pList->pEntries[--pList->count];
+  }
+}
+
+/* function: _updateDirEntry
+ *  add or refresh the entry for pName from the file it names in directory
+ *  dirFd, or remove it if that is no longer a regular file or directory.
+ *  Symbolic links are followed with stat, so a link to a regular file or
+ *  directory is listed and a dangling link is not. isNew is TRUE when
+ *  pName is known not to be in the list yet.
+ * returns:
+ *  TMWDEFS_FALSE if memory could not be allocated
+ */
+static TMWTYPES_BOOL _updateDirEntry(
+  SDNPTARG_DIR_LIST *pList,
+  int dirFd,
+  const char *pDirName,
+  const char *pName,
+  TMWTYPES_BOOL isNew)
+{
+  SDNPTARG_DIR_ENTRY *pEntry;
+  char path[DNPCNFG_MAX_FILENAME * 2 + 2];
+  struct stat statbuf;
+  TMWTYPES_BOOL isLink;
+  int status;
+
+  if (dirFd >= 0)
+  {
+    status = fstatat(dirFd, pName, &statbuf, AT_SYMLINK_NOFOLLOW);
+    isLink = (TMWTYPES_BOOL)((status == 0) && S_ISLNK(statbuf.st_mode));
+    if (isLink)
+      status = fstatat(dirFd, pName, &statbuf, 0);
+  }
+  else
+  {
+    snprintf(path, sizeof(path), "%s/%s", pDirName, pName);
+    status = lstat(path, &statbuf);
+    isLink = (TMWTYPES_BOOL)((status == 0) && S_ISLNK(statbuf.st_mode));
+    if (isLink)
+      status = stat(path, &statbuf);
+  }
+
+  if ((status != 0) || (!S_ISREG(statbuf.st_mode) && !S_ISDIR(statbuf.st_mode)))
+  {
+    if (!isNew)
+      _removeDirEntry(pList, pName);
+    return(TMWDEFS_TRUE);
+  }
+
+  pEntry = isNew ? TMWDEFS_NULL : _findDirEntry(pList, pName);
+  if (pEntry == TMWDEFS_NULL)
+  {
+    if (pList->count == pList->allocated)
+    {
+      TMWTYPES_ULONG allocated = (pList->allocated == 0) ? 64 : pList->allocated * 2;
+      SDNPTARG_DIR_ENTRY *pEntries = (SDNPTARG_DIR_ENTRY *)realloc(pList->pEntries, allocated * sizeof(SDNPTARG_DIR_ENTRY));
+      if (pEntries == TMWDEFS_NULL)
+        return(TMWDEFS_FALSE);
+      pList->pEntries = pEntries;
+      pList->allocated = allocated;
+    }
+    pEntry = &pList->pEntries[pList->count];
+    pEntry->pName = strdup(pName);
+    if (pEntry->pName == TMWDEFS_NULL)
+      return(TMWDEFS_FALSE);
+    pList->count++;
+  }
+
+  /* The size of a subdirectory is looked up when the entry is sent */
+  pEntry->type = S_ISDIR(statbuf.st_mode) ? DNPDEFS_FILE_TYPE_DIRECTORY : DNPDEFS_FILE_TYPE_SIMPLE;
+  pEntry->size = S_ISREG(statbuf.st_mode) ? (TMWTYPES_ULONG)statbuf.st_size : 0;
+  _convertTime(&pEntry->timeOfCreation, &statbuf.st_ctim.tv_sec);
+  pEntry->permissions = _convertPermissions(statbuf.st_mode);
+  pEntry->isLink = isLink;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _readDirectory
+ *  list the regular files and subdirectories in pDirName
+ */
+static SDNPTARG_DIR_LIST *_readDirectory(
+  const char *pDirName)
+{
+  SDNPTARG_DIR_LIST *pList;
+  struct dirent *entry;
+  DIR *dirp;
 
-  /* For a directory, size is the number of octets that would be transferred by 
-   * the read requests. This is (the number of files contained in the directory * 20)
-   * + (sum of the lengths of the names of all of the files in the directory).
-   */
   dirp = opendir(pDirName);
-  if (dirp)
-  {
-    while ((entry = readdir(dirp)) != NULL) {
-      if (((entry->d_type == DT_REG) || (entry->d_type == DT_DIR)) &&
-        strcmp(entry->d_name, ".") && strcmp(entry->d_name, ".."))
-      { 
-        /* exclude links to itself and parent "."  ".." since they are not sent */
-#if 0
-        dirSize +=20;
-        dirSize += strlen(entry->d_name);
-#else
-        dirSize++;
-#endif
+  if (dirp == NULL)
+    return(TMWDEFS_NULL);
+
+  pList = (SDNPTARG_DIR_LIST *)calloc(1, sizeof(SDNPTARG_DIR_LIST));
+  if (pList != TMWDEFS_NULL)
+  {
+    while ((entry = readdir(dirp)) != NULL)
+    {
+      /* exclude links to itself and parent "."  ".." since they are not sent */
+      if (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, ".."))
+        continue;
+
+      if (!_updateDirEntry(pList, dirfd(dirp), pDirName, entry->d_name, TMWDEFS_TRUE))
+      {
+        _freeDirList(pList);
+        pList = TMWDEFS_NULL;
+        break;
+      }
+    }
+  }
+  closedir(dirp);
+  return(pList);
+}
+
+/* function: _dropDirCache
+ *  forget a cached directory, called with _dirCacheLock held
+ */
+static void _dropDirCache(
+  SDNPTARG_DIR_CACHE *pCache,
+  TMWTYPES_BOOL removeWatch)
+{
+  if (removeWatch)
+    (void)inotify_rm_watch(_inotifyFd, pCache->watch);
+  if (pCache->pList != TMWDEFS_NULL)
+    _releaseDirList(pCache->pList);
+  pCache->pList = TMWDEFS_NULL;
+  pCache->watch = -1;
+  pCache->path[0] = '\0';
+}
+
+/* function: _processDirEvents
+ *  apply the changes inotify has reported since the last call,
+ *  called with _dirCacheLock held
+ */
+static void _processDirEvents(void)
+{
+  char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+  ssize_t length;
+
+  while ((length = read(_inotifyFd, buffer, sizeof(buffer))) > 0)
+  {
+    char *pNext = buffer;
+    while (pNext < buffer + length)
+    {
+      struct inotify_event *pEvent = (struct inotify_event *)pNext;
+      int index;
+
+      pNext += sizeof(struct inotify_event) + pEvent->len;
+
+      /* Events were lost, read every directory again */
+      if (pEvent->mask & IN_Q_OVERFLOW)
+      {
+        for (index = 0; index < TMWTARG_DNPFILE_DIR_CACHE_SIZE; index++)
+        {
+          if (_dirCache[index].pList != TMWDEFS_NULL)
+          {
+            _releaseDirList(_dirCache[index].pList);
+            _dirCache[index].pList = TMWDEFS_NULL;
+          }
+        }
+        continue;
+      }
+
+      for (index = 0; index < TMWTARG_DNPFILE_DIR_CACHE_SIZE; index++)
+      {
+        if (_dirCache[index].watch == pEvent->wd)
+          break;
+      }
+      if (index == TMWTARG_DNPFILE_DIR_CACHE_SIZE)
+        continue;
+
+      if (pEvent->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+      {
+        _dropDirCache(&_dirCache[index], (TMWTYPES_BOOL)((pEvent->mask & IN_IGNORED) == 0));
+        continue;
+      }
+
+      /* Changes to the directory itself do not change the listing */
+      if ((pEvent->len == 0) || (_dirCache[index].pList == TMWDEFS_NULL))
+        continue;
+
+      /* A directory read is using the listing, build a new one when next needed */
+      if ((_dirCache[index].pList->refCount > 1)
+        || !_updateDirEntry(_dirCache[index].pList, -1, _dirCache[index].path, pEvent->name, TMWDEFS_FALSE))
+      {
+        _releaseDirList(_dirCache[index].pList);
+        _dirCache[index].pList = TMWDEFS_NULL;
+      }
+    }
+  }
+}
+
+/* function: _getDirList
+ *  return the listing of pDirName with a reference the caller must release
+ */
+static SDNPTARG_DIR_LIST *_getDirList(
+  const char *pDirName)
+{
+  SDNPTARG_DIR_CACHE *pCache = TMWDEFS_NULL;
+  SDNPTARG_DIR_LIST *pList;
+  int index;
+
+  pthread_mutex_lock(&_dirCacheLock);
+
+  if (!_dirCacheInitialized)
+  {
+    for (index = 0; index < TMWTARG_DNPFILE_DIR_CACHE_SIZE; index++)
+      _dirCache[index].watch = -1;
+    _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    _dirCacheInitialized = TMWDEFS_TRUE;
+  }
+
+  if (_inotifyFd >= 0)
+  {
+    _processDirEvents();
+
+    for (index = 0; index < TMWTARG_DNPFILE_DIR_CACHE_SIZE; index++)
+    {
+      if ((_dirCache[index].watch >= 0) && (strcmp(_dirCache[index].path, pDirName) == 0))
+      {
+        pCache = &_dirCache[index];
+        break;
+      }
+    }
+
+    if (pCache == TMWDEFS_NULL)
+    {
+      /* Use a free entry or the one used longest ago */
+      pCache = &_dirCache[0];
+      for (index = 0; index < TMWTARG_DNPFILE_DIR_CACHE_SIZE; index++)
+      {
+        if (_dirCache[index].watch < 0)
+        {
+          pCache = &_dirCache[index];
+          break;
+        }
+        if (_dirCache[index].lastUsed < pCache->lastUsed)
+          pCache = &_dirCache[index];
+      }
+      if (pCache->watch >= 0)
+        _dropDirCache(pCache, TMWDEFS_TRUE);
+
+      /* Watch before reading so no change can be missed */
+      pCache->watch = inotify_add_watch(_inotifyFd, pDirName, SDNPTARG_DIR_EVENTS);
+      if ((pCache->watch < 0) || (strlen(pDirName) >= sizeof(pCache->path)))
+      {
+        if (pCache->watch >= 0)
+          _dropDirCache(pCache, TMWDEFS_TRUE);
+        pCache = TMWDEFS_NULL;
+      }
+      else
+      {
+        strcpy(pCache->path, pDirName);
       }
     }
-    closedir(dirp);
   }
-  return dirSize;
+
+  if ((pCache != TMWDEFS_NULL) && (pCache->pList != TMWDEFS_NULL))
+  {
+    pList = pCache->pList;
+  }
+  else
+  {
+    pList = _readDirectory(pDirName);
+    if (pList == TMWDEFS_NULL)
+    {
+      if (pCache != TMWDEFS_NULL)
+        _dropDirCache(pCache, TMWDEFS_TRUE);
+      pthread_mutex_unlock(&_dirCacheLock);
+      return(TMWDEFS_NULL);
+    }
+
+    /* Without a watch the listing is only used by this caller */
+    if (pCache != TMWDEFS_NULL)
+    {
+      pCache->pList = pList;
+      pList->refCount++;
+    }
+  }
+
+  if (pCache != TMWDEFS_NULL)
+    pCache->lastUsed = ++_dirCacheUseCount;
+
+  pList->refCount++;
+  pthread_mutex_unlock(&_dirCacheLock);
+  return(pList);
+}
+
+/* function: _putDirList */
+static void _putDirList(
+  SDNPTARG_DIR_LIST *pList)
+{
+  pthread_mutex_lock(&_dirCacheLock);
+  _releaseDirList(pList);
+  pthread_mutex_unlock(&_dirCacheLock);
 }
 
 static TMWTYPES_BOOL _buildInfoResponse(
@@ -165,29 +615,49 @@ static TMWTYPES_BOOL _buildInfoResponse(
   TMWDTIME                 *pTimeOfCreation,
   DNPDEFS_FILE_PERMISSIONS *pPermissions)
 {
-  struct dirent *entry = pFileDesc->nextEntry;
-  char fileName[DNPCNFG_MAX_FILENAME+1];
+  SDNPTARG_DIR_ENTRY *pEntry;
+
+  if (pFileDesc->nextEntry >= pFileDesc->pDirList->count)
+    return TMWDEFS_FALSE;
+
+  pEntry = &pFileDesc->pDirList->pEntries[pFileDesc->nextEntry++];
+  *pType = pEntry->type;
+  *pSize = pEntry->size;
+  *pTimeOfCreation = pEntry->timeOfCreation;
+  *pPermissions = pEntry->permissions;
 
-  if (entry == NULL)
+  /* A linked file may have changed without an event for this directory */
+  if (pEntry->isLink && (pEntry->type == DNPDEFS_FILE_TYPE_SIMPLE))
   {
-    entry = readdir(pFileDesc->pDir);
+    char fileName[DNPCNFG_MAX_FILENAME * 2 + 2];
+    struct stat statbuf;
+
+    snprintf(fileName, sizeof(fileName), "%s/%s", pFileDesc->fileName, pEntry->pName);
+    if ((stat(fileName, &statbuf) == 0) && S_ISREG(statbuf.st_mode))
+    {
+      *pSize = (TMWTYPES_ULONG)statbuf.st_size;
+      _convertTime(pTimeOfCreation, &statbuf.st_ctim.tv_sec);
+      *pPermissions = _convertPermissions(statbuf.st_mode);
+    }
   }
-  while ((entry != NULL) && (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")))
+
+  /* The size of a directory is the number of entries it holds */
+  if (pEntry->type == DNPDEFS_FILE_TYPE_DIRECTORY)
   {
-    entry = readdir(pFileDesc->pDir);
+    char fileName[DNPCNFG_MAX_FILENAME * 2 + 2];
+    SDNPTARG_DIR_LIST *pList;
+
+    snprintf(fileName, sizeof(fileName), "%s/%s", pFileDesc->fileName, pEntry->pName);
+    pList = _getDirList(fileName);
+    if (pList != TMWDEFS_NULL)
+    {
+      *pSize = pList->count;
+      _putDirList(pList);
+    }
   }
 
-  if (entry != NULL)
-  {
-    strncpy(fileName, pFileDesc->fileName, DNPCNFG_MAX_FILENAME);
-    strncat(fileName, "/", DNPCNFG_MAX_FILENAME);
-    strncat(fileName, entry->d_name, DNPCNFG_MAX_FILENAME);
-    sdnptarg_getFileInfo(fileName, pType, pSize, pTimeOfCreation, pPermissions);
-    strncpy(pFilename, entry->d_name, maxNameSize);
-    pFileDesc->nextEntry = readdir(pFileDesc->pDir);
-    return TMWDEFS_TRUE;
-  }
-  return TMWDEFS_FALSE;
+  strncpy(pFilename, pEntry->pName, maxNameSize);
+  return TMWDEFS_TRUE;
 }
 
 /* function: sdnptarg_getFileInfo
@@ -220,24 +690,14 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnptarg_getFileInfo(
       *pPermissions = _convertPermissions(statbuf.st_mode);
 
       /* The directory size should report the number of files and subdirectories it contains. */
-      (*pSize) = 0;
       {
-        DIR * dirp;
-        struct dirent * entry;
-
-        dirp = opendir(pFilename);
-        if (dirp == NULL)
+        SDNPTARG_DIR_LIST *pList = _getDirList(pFilename);
+        if (pList == TMWDEFS_NULL)
         {
           return DNPDEFS_FILE_CMD_STAT_NOT_FOUND;
         }
-        while ((entry = readdir(dirp)) != NULL) {
-          if (((entry->d_type == DT_REG) || (entry->d_type == DT_DIR)) &&
-              strcmp(entry->d_name, ".") && strcmp(entry->d_name, ".."))
-          { /* If the entry is a regular file */
-            (*pSize)++;
-          }
-        }
-        closedir(dirp);
+        *pSize = pList->count;
+        _putDirList(pList);
       }
       return DNPDEFS_FILE_CMD_STAT_SUCCESS;
     }
@@ -270,15 +730,14 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnptarg_readFileInfo(
     return(DNPDEFS_FILE_TFER_STAT_INV_HANDLE);
   }
 
-  if ((pFileDesc->pCurrentFile == TMWDEFS_NULL) &&
-      (pFileDesc->pDir == TMWDEFS_NULL))
+  if (pFileDesc->pDirList == TMWDEFS_NULL)
   {
     return(DNPDEFS_FILE_TFER_STAT_NOT_OPEN);
   }
 
   _buildInfoResponse(pFileDesc, maxNameSize, pName, pType, pSize, pTimeOfCreation, pPermissions);
 
-  if (pFileDesc->nextEntry == NULL)
+  if (pFileDesc->nextEntry >= pFileDesc->pDirList->count)
   {
     *pLast = TMWDEFS_TRUE;
   }
@@ -317,8 +776,8 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnptarg_openFile(
   TMWTYPES_ULONG *pSize,
   DNPDEFS_FILE_TYPE *pType)
 {
-  char *pFileMode;
-  FILE *pFile;
+  int flags;
+  int fd;
   SDNPTARG_FILE_DESC *pFileDesc;
 
   /* If mode is read, see if the requested file is a directory */
@@ -332,14 +791,21 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnptarg_openFile(
     if(*pType == DNPDEFS_FILE_TYPE_DIRECTORY)
     {
       /* Yep, it's a directory setup a directory read */
-      *pSize = (TMWTYPES_ULONG)_directorySize(pFilename);
-
       pFileDesc = _allocFileDesc();
       if (pFileDesc)
       {
+        /* The read works through a snapshot of the directory */
+        pFileDesc->pDirList = _getDirList(pFilename);
+        if (pFileDesc->pDirList == TMWDEFS_NULL)
+        {
+          _freeFileDesc(pFileDesc);
+          *pHandle = 0;
+          return (DNPDEFS_FILE_CMD_STAT_NOT_FOUND);
+        }
+        *pSize = pFileDesc->pDirList->count;
+
         /* Initialize file state */
         pFileDesc->blockSize = *pMaxBlockSize;
-        pFileDesc->pDir = opendir(pFilename);
         pFileDesc->dnpType = DNPDEFS_FILE_TYPE_DIRECTORY;
         pFileDesc->size = *pSize;
         pFileDesc->timeOfCreation = *pTimeOfCreation;
@@ -361,42 +827,69 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnptarg_openFile(
   switch(mode)
   {
   case DNPDEFS_FILE_MODE_READ:
-    pFileMode = "rb";
+    flags = O_RDONLY;
     break;
 
   case DNPDEFS_FILE_MODE_WRITE:
-    pFileMode = "wb";
+    flags = O_WRONLY | O_CREAT | O_TRUNC;
     break;
 
   case DNPDEFS_FILE_MODE_APPEND:
-    pFileMode = "ab";
+    flags = O_WRONLY | O_CREAT;
     break;
 
   default:
     return(DNPDEFS_FILE_CMD_STAT_INV_MODE);
   }
     
-  if((pFile = fopen(pFilename, pFileMode)) != TMWDEFS_NULL)
+  if((fd = open(pFilename, flags | O_CLOEXEC, 0666)) >= 0)
   {
     pFileDesc = _allocFileDesc();
     if (pFileDesc)
     {
+      /* Whole blocks fit in the buffer so reads never straddle a refill */
+      size_t bufferSize = TMWTARG_DNPFILE_BUFFER_SIZE;
+      if (*pMaxBlockSize != 0)
+      {
+        bufferSize -= bufferSize % *pMaxBlockSize;
+        if (bufferSize == 0)
+          bufferSize = *pMaxBlockSize;
+      }
+
       /* Initialize file state */
       pFileDesc->blockSize = *pMaxBlockSize;
-      pFileDesc->pCurrentFile = pFile;
+      pFileDesc->fd = fd;
+      pFileDesc->writeMode = (TMWTYPES_BOOL)(mode != DNPDEFS_FILE_MODE_READ);
       pFileDesc->dnpType = DNPDEFS_FILE_TYPE_SIMPLE;
       pFileDesc->size = *pSize;
       pFileDesc->timeOfCreation = *pTimeOfCreation;
       pFileDesc->dnpPermissions = *pPermissions;
-      *pHandle = pFileDesc->dnpHandle;
+      pFileDesc->bufferSize = bufferSize;
+      pFileDesc->pBuffer = (TMWTYPES_UCHAR *)malloc(bufferSize);
+
+      /* Appended blocks go after the existing data */
+      if (mode == DNPDEFS_FILE_MODE_APPEND)
+        pFileDesc->bufferOffset = lseek(fd, 0, SEEK_END);
+      else if (mode == DNPDEFS_FILE_MODE_READ)
+        (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
 
-      /* Return success */
-      return(DNPDEFS_FILE_CMD_STAT_SUCCESS);
+      if ((pFileDesc->pBuffer != TMWDEFS_NULL) && (pFileDesc->bufferOffset >= 0))
+      {
+        *pHandle = pFileDesc->dnpHandle;
+
+        /* Return success */
+        return(DNPDEFS_FILE_CMD_STAT_SUCCESS);
+      }
+
+      _freeFileDesc(pFileDesc);
+      *pHandle = 0;
+      close(fd);
+      return(DNPDEFS_FILE_CMD_STAT_MISC);
     }
 
     /* Clear file handle */
     *pHandle = 0;
-    fclose(pFile);
+    close(fd);
     return (DNPDEFS_FILE_CMD_STAT_TOO_MANY);
   }
   /* Clear file handle */
@@ -419,17 +912,26 @@ DNPDEFS_FILE_CMD_STAT TMWDEFS_GLOBAL sdnptarg_closeFile(
   if (pFileDesc == TMWDEFS_NULL)
     return(DNPDEFS_FILE_CMD_STAT_INV_HANDLE);
 
-  if (pFileDesc->pCurrentFile != TMWDEFS_NULL)
+  if (pFileDesc->fd >= 0)
   {
-    /* Close file */
-    fclose(pFileDesc->pCurrentFile);
     cmdStat = DNPDEFS_FILE_CMD_STAT_SUCCESS;
+
+    /* Write the remaining blocks and make sure the data is on the disk */
+    if (pFileDesc->writeMode)
+    {
+      if (!_flushBuffer(pFileDesc) || (fdatasync(pFileDesc->fd) != 0))
+        cmdStat = DNPDEFS_FILE_CMD_STAT_MISC;
+    }
+
+    /* Close file */
+    if (close(pFileDesc->fd) != 0)
+      cmdStat = DNPDEFS_FILE_CMD_STAT_MISC;
   }
 
-  if (pFileDesc->pDir != TMWDEFS_NULL)
+  if (pFileDesc->pDirList != TMWDEFS_NULL)
   {
-    /* Close directory */
-    closedir(pFileDesc->pDir);
+    /* Release the directory snapshot */
+    _putDirList(pFileDesc->pDirList);
     cmdStat = DNPDEFS_FILE_CMD_STAT_SUCCESS;
   }
 
@@ -449,6 +951,7 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnptarg_readFile(
   TMWTYPES_UCHAR *pBuf)
 {
   SDNPTARG_FILE_DESC *pFileDesc = _findFileDesc(handle);
+  size_t available;
 
   /* Validate file state against request */
   if (pFileDesc == TMWDEFS_NULL)
@@ -456,22 +959,31 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnptarg_readFile(
     return(DNPDEFS_FILE_TFER_STAT_INV_HANDLE);
   }
 
-  if (pFileDesc->pCurrentFile == TMWDEFS_NULL)
+  if ((pFileDesc->fd < 0) || pFileDesc->writeMode)
   {
     return(DNPDEFS_FILE_TFER_STAT_NOT_OPEN);
   }
 
-  clearerr(pFileDesc->pCurrentFile);
+  /* Read ahead when the buffer does not hold a whole block */
+  available = pFileDesc->bufferLength - (size_t)(pFileDesc->offset - pFileDesc->bufferOffset);
+  if ((available < pFileDesc->blockSize) && !pFileDesc->endOfFile)
+  {
+    if (!_fillBuffer(pFileDesc))
+      return(DNPDEFS_FILE_TFER_STAT_BAD_FILE);
+
+    available = pFileDesc->bufferLength;
+  }
 
-  /* Read data */
-  *pBytesRead = (TMWTYPES_USHORT)fread(pBuf, pFileDesc->blockSize, 1, pFileDesc->pCurrentFile);
+  if (available > pFileDesc->blockSize)
+    available = pFileDesc->blockSize;
 
-  /* Check for errors */
-  if (ferror(pFileDesc->pCurrentFile))
-    return(DNPDEFS_FILE_TFER_STAT_BAD_FILE);
+  memcpy(pBuf, pFileDesc->pBuffer + (pFileDesc->offset - pFileDesc->bufferOffset), available);
+  pFileDesc->offset += (off_t)available;
+  *pBytesRead = (TMWTYPES_USHORT)available;
 
   /* Check for end of file */
-  *pLast = (TMWTYPES_BOOL)(feof(pFileDesc->pCurrentFile) ? TMWDEFS_TRUE : TMWDEFS_FALSE);
+  *pLast = (TMWTYPES_BOOL)(pFileDesc->endOfFile
+    && (pFileDesc->offset == pFileDesc->bufferOffset + (off_t)pFileDesc->bufferLength));
   return DNPDEFS_FILE_TFER_STAT_SUCCESS;
 }
 
@@ -493,7 +1005,7 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnptarg_writeFile(
     return(DNPDEFS_FILE_TFER_STAT_INV_HANDLE);
   }
 
-  if (pFileDesc->pCurrentFile == TMWDEFS_NULL)
+  if ((pFileDesc->fd < 0) || !pFileDesc->writeMode)
   {
     return(DNPDEFS_FILE_TFER_STAT_NOT_OPEN);
   }
@@ -503,15 +1015,283 @@ DNPDEFS_FILE_TFER_STAT TMWDEFS_GLOBAL sdnptarg_writeFile(
     return(DNPDEFS_FILE_TFER_STAT_OVERRUN);
   }
 
-   /* Write data */
-  if(fwrite(pBuf, 1, numBytes, pFileDesc->pCurrentFile) != numBytes)
+  /* Write the collected blocks once another one will not fit */
+  if (pFileDesc->bufferLength + numBytes > pFileDesc->bufferSize)
   {
-    return(DNPDEFS_FILE_TFER_STAT_BAD_FILE);
+    if (!_flushBuffer(pFileDesc))
+      return(DNPDEFS_FILE_TFER_STAT_BAD_FILE);
   }
 
+  memcpy(pFileDesc->pBuffer + pFileDesc->bufferLength, pBuf, numBytes);
+  pFileDesc->bufferLength += numBytes;
+
   /* Return success */
   return(DNPDEFS_FILE_TFER_STAT_SUCCESS);
 }
 
 #endif /* TMWTARG_SUPPORT_FILEIO */
 
+#if TMWTARG_SUPPORT_SHM_DB
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Regions are files in the tmpfs that also backs shm_open, so this does
+ * not need librt.
+ */
+static void TMWDEFS_LOCAL _shmPath(
+  const TMWTYPES_CHAR *pName,
+  TMWTYPES_CHAR *pPath,
+  size_t pathSize)
+{
+  while(*pName == '/')
+    pName++;
+  snprintf(pPath, pathSize, "/dev/shm/%s", pName);
+}
+
+/* function: sdnptarg_shmCreate */
+void * TMWDEFS_GLOBAL sdnptarg_shmCreate(
+  const TMWTYPES_CHAR *pName,
+  TMWTYPES_ULONG size)
+{
+  TMWTYPES_CHAR path[256];
+  void *pRegion;
+  int fd;
+
+  _shmPath(pName, path, sizeof(path));
+  fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0660);
+  if(fd < 0)
+    return(TMWDEFS_NULL);
+
+  if(ftruncate(fd, (off_t)size) != 0)
+  {
+    close(fd);
+    return(TMWDEFS_NULL);
+  }
+
+  pRegion = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if(pRegion == MAP_FAILED)
+    return(TMWDEFS_NULL);
+
+  return(pRegion);
+}
+
+/* function: sdnptarg_shmOpen */
+void * TMWDEFS_GLOBAL sdnptarg_shmOpen(
+  const TMWTYPES_CHAR *pName,
+  TMWTYPES_ULONG *pSize)
+{
+  TMWTYPES_CHAR path[256];
+  struct stat fileStat;
+  void *pRegion;
+  int fd;
+
+  _shmPath(pName, path, sizeof(path));
+  fd = open(path, O_RDWR);
+  if(fd < 0)
+    return(TMWDEFS_NULL);
+
+  if((fstat(fd, &fileStat) != 0) || (fileStat.st_size <= 0))
+  {
+    close(fd);
+    return(TMWDEFS_NULL);
+  }
+
+  pRegion = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if(pRegion == MAP_FAILED)
+    return(TMWDEFS_NULL);
+
+  *pSize = (TMWTYPES_ULONG)fileStat.st_size;
+  return(pRegion);
+}
+
+/* function: sdnptarg_shmClose */
+void TMWDEFS_GLOBAL sdnptarg_shmClose(
+  void *pRegion,
+  TMWTYPES_ULONG size)
+{
+  if(pRegion != TMWDEFS_NULL)
+    munmap(pRegion, size);
+}
+
+#endif /* TMWTARG_SUPPORT_SHM_DB */
+
+#if TMWTARG_SUPPORT_JOURNAL
+
+#include <fcntl.h>
+#include <errno.h>
+#include <libgen.h>
+#include <sys/stat.h>
+
+/* Open journal file */
+typedef struct SdnpTargJournal {
+  int fd;
+} SDNPTARG_JOURNAL;
+
+/* function: _writeAll */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _writeAll(
+  int fd,
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  while(length > 0)
+  {
+    ssize_t written = write(fd, pData, length);
+    if(written < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      return(TMWDEFS_FALSE);
+    }
+    pData += written;
+    length -= (TMWTYPES_ULONG)written;
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _syncDirectory
+ *  flush the directory holding pName so a rename of the file is on the disk
+ */
+static void TMWDEFS_LOCAL _syncDirectory(
+  const TMWTYPES_CHAR *pName)
+{
+  TMWTYPES_CHAR path[512];
+  int fd;
+
+  snprintf(path, sizeof(path), "%s", pName);
+  fd = open(dirname(path), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if(fd >= 0)
+  {
+    (void)fsync(fd);
+    close(fd);
+  }
+}
+
+/* function: sdnptarg_journalRead */
+TMWTYPES_UCHAR * TMWDEFS_GLOBAL sdnptarg_journalRead(
+  const TMWTYPES_CHAR *pName,
+  TMWTYPES_ULONG *pLength)
+{
+  struct stat fileStat;
+  TMWTYPES_UCHAR *pData;
+  TMWTYPES_ULONG length = 0;
+  int fd;
+
+  fd = open(pName, O_RDONLY | O_CLOEXEC);
+  if(fd < 0)
+    return(TMWDEFS_NULL);
+
+  if(fstat(fd, &fileStat) != 0)
+  {
+    close(fd);
+    return(TMWDEFS_NULL);
+  }
+
+  /* Allocate at least one byte so an empty file is not an error */
+  pData = (TMWTYPES_UCHAR *)tmwtarg_alloc((TMWTYPES_UINT)fileStat.st_size + 1);
+  if(pData == TMWDEFS_NULL)
+  {
+    close(fd);
+    return(TMWDEFS_NULL);
+  }
+
+  while(length < (TMWTYPES_ULONG)fileStat.st_size)
+  {
+    ssize_t count = read(fd, pData + length, (size_t)fileStat.st_size - length);
+    if(count < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      tmwtarg_free(pData);
+      close(fd);
+      return(TMWDEFS_NULL);
+    }
+    if(count == 0)
+      break;
+    length += (TMWTYPES_ULONG)count;
+  }
+
+  close(fd);
+  *pLength = length;
+  return(pData);
+}
+
+/* function: sdnptarg_journalReplace */
+void * TMWDEFS_GLOBAL sdnptarg_journalReplace(
+  const TMWTYPES_CHAR *pName,
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length)
+{
+  SDNPTARG_JOURNAL *pJournal;
+  TMWTYPES_CHAR tempName[512];
+  int fd;
+
+  snprintf(tempName, sizeof(tempName), "%s.tmp", pName);
+  fd = open(tempName, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0640);
+  if(fd < 0)
+    return(TMWDEFS_NULL);
+
+  if(!_writeAll(fd, pData, length) || (fsync(fd) != 0))
+  {
+    close(fd);
+    unlink(tempName);
+    return(TMWDEFS_NULL);
+  }
+  close(fd);
+
+  /* rename replaces the old journal in one step */
+  if(rename(tempName, pName) != 0)
+  {
+    unlink(tempName);
+    return(TMWDEFS_NULL);
+  }
+  _syncDirectory(pName);
+
+  pJournal = (SDNPTARG_JOURNAL *)tmwtarg_alloc(sizeof(SDNPTARG_JOURNAL));
+  if(pJournal == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  pJournal->fd = open(pName, O_WRONLY | O_APPEND | O_CLOEXEC);
+  if(pJournal->fd < 0)
+  {
+    tmwtarg_free(pJournal);
+    return(TMWDEFS_NULL);
+  }
+  return(pJournal);
+}
+
+/* function: sdnptarg_journalAppend */
+TMWTYPES_BOOL TMWDEFS_GLOBAL sdnptarg_journalAppend(
+  void *pHandle,
+  const TMWTYPES_UCHAR *pData,
+  TMWTYPES_ULONG length,
+  TMWTYPES_BOOL sync)
+{
+  SDNPTARG_JOURNAL *pJournal = (SDNPTARG_JOURNAL *)pHandle;
+
+  if(!_writeAll(pJournal->fd, pData, length))
+    return(TMWDEFS_FALSE);
+
+  if(sync && (fdatasync(pJournal->fd) != 0))
+    return(TMWDEFS_FALSE);
+
+  return(TMWDEFS_TRUE);
+}
+
+/* function: sdnptarg_journalClose */
+void TMWDEFS_GLOBAL sdnptarg_journalClose(
+  void *pHandle)
+{
+  SDNPTARG_JOURNAL *pJournal = (SDNPTARG_JOURNAL *)pHandle;
+
+  if(pJournal != TMWDEFS_NULL)
+  {
+    close(pJournal->fd);
+    tmwtarg_free(pJournal);
+  }
+}
+
+#endif /* TMWTARG_SUPPORT_JOURNAL */
@@ -39,6 +39,16 @@
 
 #include <time.h>
 #include <sys/time.h>
+#if TMWCNFG_MULTIPLE_TIMER_QS
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <sys/timerfd.h>
+#if TMWTARG_SUPPORT_POLL
+#include <poll.h>
+#endif
+#endif
 
 #include "tmwtargos.h"
 #include "tmwtargio.h"
@@ -46,6 +56,7 @@
 #include "lin232.h"
 #include "lintcp.h"
 #include "liniodiag.h"
+#include "tmwtargrt.h"
 
 /* Big Endian vs Little Endian
 * For all protocols currently supported by the Triangle MicroWorks
@@ -533,15 +544,36 @@ void TMWDEFS_GLOBAL tmwtarg_cancelTimer(void)
 #if (TMWCNFG_SUPPORT_THREADS == TMWDEFS_FALSE)
 #error TMWCNFG_SUPPORT_THREADS must have value TMWDEFS_TRUE in tmwcnfg.h to support TMWCNFG_MULTIPLE_TIMER_QS.
 #endif 
+/* Each channel gets its own timerfd. The channel thread includes this
+ * descriptor in the set it waits on, so the channel timer queue is
+ * serviced exactly when the next SCL timer expires instead of polling.
+ */
+typedef struct LinMultiTimer {
+  int timerFd;
+} LIN_MULTI_TIMER;
+
 /* function: tmwtarg_initMultiTimer */
 TMWTYPES_INT TMWDEFS_GLOBAL tmwtarg_initMultiTimer(
   TMWCHNL *pChannel)
 {
-  /* The Linux MultiTimer implementation uses the channel thread to */
-  /* call _MultiTimerCallback every 50 ms. The channel thread will  */
-  /* be started on channel initialization, so there is no           */
-  /* initialization required here.                                  */
-  TMWTARG_UNUSED_PARAM(pChannel);
+  LIN_MULTI_TIMER *pMultiTimer;
+
+  pMultiTimer = (LIN_MULTI_TIMER *)malloc(sizeof(LIN_MULTI_TIMER));
+  if (pMultiTimer == TMWDEFS_NULL)
+  {
+    return ENOMEM;
+  }
+
+  pMultiTimer->timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  if (pMultiTimer->timerFd == -1)
+  {
+    int error = errno;
+    LINIODIAG_ERRORMSG("initMultiTimer: timerfd_create failed %s", strerror(error));
+    free(pMultiTimer);
+    return error;
+  }
+
+  pChannel->pMultiTimerHandle = pMultiTimer;
   return 0;
 }
 
@@ -550,10 +582,25 @@ TMWTYPES_INT TMWDEFS_GLOBAL tmwtarg_setMultiTimer(
   TMWCHNL                *pChannel,
   TMWTYPES_MILLISECONDS   timeout) 
 {
-  /* The channel thread is calling the timout function every 50 ms */
-  /* so there no work to be performed in the Linux target layer.   */
-  TMWTARG_UNUSED_PARAM(pChannel);
-  TMWTARG_UNUSED_PARAM(timeout);
+  LIN_MULTI_TIMER  *pMultiTimer = (LIN_MULTI_TIMER *)pChannel->pMultiTimerHandle;
+  struct itimerspec timerSpec;
+
+  if (pMultiTimer == TMWDEFS_NULL)
+  {
+    return EINVAL;
+  }
+
+  /* A zero it_value disarms the timer, which is what a timeout of zero asks for */
+  memset(&timerSpec, 0, sizeof(timerSpec));
+  timerSpec.it_value.tv_sec = timeout / 1000;
+  timerSpec.it_value.tv_nsec = (long)(timeout % 1000) * 1000000L;
+
+  if (timerfd_settime(pMultiTimer->timerFd, 0, &timerSpec, NULL) == -1)
+  {
+    int error = errno;
+    LINIODIAG_ERRORMSG("setMultiTimer: timerfd_settime failed %s", strerror(error));
+    return error;
+  }
   return 0;
 }
 
@@ -561,10 +608,102 @@ TMWTYPES_INT TMWDEFS_GLOBAL tmwtarg_setMultiTimer(
 TMWTYPES_INT TMWDEFS_GLOBAL tmwtarg_deleteMultiTimer(
   TMWCHNL *pChannel)
 {
-  TMWTARG_UNUSED_PARAM(pChannel);
+  LIN_MULTI_TIMER *pMultiTimer = (LIN_MULTI_TIMER *)pChannel->pMultiTimerHandle;
+
+  if (pMultiTimer != TMWDEFS_NULL)
+  {
+    pChannel->pMultiTimerHandle = TMWDEFS_NULL;
+    close(pMultiTimer->timerFd);
+    free(pMultiTimer);
+  }
   return 0;
 }
+
+/* function: _wakeMultiTimer
+ *  Arm the channel's timerfd to expire immediately. This wakes a channel
+ *  thread blocked on it. Expiring early is harmless since the SCL simply
+ *  restarts the timer with the time remaining.
+ */
+static void _wakeMultiTimer(
+  TMWCHNL *pChannel)
+{
+  LIN_MULTI_TIMER  *pMultiTimer = (LIN_MULTI_TIMER *)pChannel->pMultiTimerHandle;
+  struct itimerspec timerSpec;
+
+  if (pMultiTimer != TMWDEFS_NULL)
+  {
+    memset(&timerSpec, 0, sizeof(timerSpec));
+    timerSpec.it_value.tv_nsec = 1;
+    timerfd_settime(pMultiTimer->timerFd, 0, &timerSpec, NULL);
+  }
+}
+#endif
+
+/* function: tmwtargio_getMultiTimerFd */
+int TMWDEFS_GLOBAL tmwtargio_getMultiTimerFd(
+  TMWCHNL *pChannel)
+{
+#if TMWCNFG_MULTIPLE_TIMER_QS
+  LIN_MULTI_TIMER *pMultiTimer;
+
+  if (pChannel != TMWDEFS_NULL)
+  {
+    pMultiTimer = (LIN_MULTI_TIMER *)pChannel->pMultiTimerHandle;
+    if (pMultiTimer != TMWDEFS_NULL)
+    {
+      return pMultiTimer->timerFd;
+    }
+  }
+#else
+  TMWTARG_UNUSED_PARAM(pChannel);
+#endif
+  return -1;
+}
+
+/* function: tmwtargio_checkMultiTimer */
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargio_checkMultiTimer(
+  TMWCHNL *pChannel)
+{
+#if TMWCNFG_MULTIPLE_TIMER_QS
+  uint64_t expirations;
+  int      timerFd = tmwtargio_getMultiTimerFd(pChannel);
+
+  /* The timerfd is non blocking, so this read only succeeds if it expired */
+  if ((timerFd != -1) 
+    && (read(timerFd, &expirations, sizeof(expirations)) == sizeof(expirations)))
+  {
+    pChannel->pMultiTimerCallback(pChannel);
+    return TMWDEFS_TRUE;
+  }
+#else
+  TMWTARG_UNUSED_PARAM(pChannel);
+#endif
+  return TMWDEFS_FALSE;
+}
+
+/* function: tmwtargio_waitMultiTimer */
+void TMWDEFS_GLOBAL tmwtargio_waitMultiTimer(
+  TMWCHNL *pChannel,
+  TMWTYPES_MILLISECONDS timeout)
+{
+#if TMWCNFG_MULTIPLE_TIMER_QS && TMWTARG_SUPPORT_POLL
+  struct pollfd pollFd;
+
+  pollFd.fd = tmwtargio_getMultiTimerFd(pChannel);
+  pollFd.events = POLLIN;
+  if (pollFd.fd != -1)
+  {
+    if (poll(&pollFd, 1, TMWTARGIO_POLL_TIMEOUT(timeout)) > 0)
+    {
+      tmwtargio_checkMultiTimer(pChannel);
+    }
+    return;
+  }
+#else
+  TMWTARG_UNUSED_PARAM(pChannel);
 #endif
+  tmwtarg_sleep(timeout);
+}
 
 void TMWDEFS_GLOBAL tmwtarg_stopThreads(
   void *pContext)
@@ -580,6 +719,13 @@ void TMWDEFS_GLOBAL tmwtarg_stopThreads(
   if (pTargIoChannel->chanThreadState == TMWTARG_THREAD_RUNNING)
   {
     pTargIoChannel->chanThreadState = TMWTARG_THREAD_EXITING;
+#if TMWCNFG_MULTIPLE_TIMER_QS
+    /* The channel thread may be blocked waiting on its timerfd */
+    if (pTargIoChannel->pChannel)
+    {
+      _wakeMultiTimer(pTargIoChannel->pChannel);
+    }
+#endif
  
     while (pTargIoChannel->chanThreadState > TMWTARG_THREAD_EXITED)
     {
@@ -617,17 +763,27 @@ static TMW_ThreadDecl _channelThread(TMW_ThreadArg pVoidArg)
     /* Wait until the channel is operational */
     if (pTargIoChannel->chanState == TMWTARG_CHANNEL_INITIALIZED)
     {
+#if TMWCNFG_MULTIPLE_TIMER_QS
+      /* Timers may be started on the channel before it is opened */
+      tmwtargio_waitMultiTimer(pChannel, 1000);
+#else
       tmwtarg_sleep(1000);
+#endif
       continue;
     }
 
-    /* Once online, handle channel timeouts */
-    timeoutValue = 100;
 #if TMWCNFG_MULTIPLE_TIMER_QS
-    if ((pChannel) && (pChannel->timerQueue.timerRunning == TMWDEFS_TRUE))
-    {
-      pChannel->pMultiTimerCallback(pChannel);
-    }
+    /* Once online, handle channel timeouts. The channel's timerfd is part  */
+    /* of the descriptors the check input function waits on, so it returns */
+    /* as soon as a timer expires and the wait can be much longer.          */
+    tmwtargio_checkMultiTimer(pChannel);
+#if TMWTARG_SUPPORT_POLL
+    timeoutValue = TMWTARG_MULTI_TIMER_IDLE_WAIT;
+#else
+    timeoutValue = 100;
+#endif
+#else
+    timeoutValue = 100;
 #endif
 
     /* Call the channel's check input function */
@@ -636,7 +792,20 @@ static TMW_ThreadDecl _channelThread(TMW_ThreadArg pVoidArg)
       pTargIoChannel->pCheckInputFunction(pTargIoChannel, timeoutValue);
       continue;
     }
+#if TMWTARG_SUPPORT_TCP
+    /* A listener can hand a closed TCP channel its next connection, and */
+    /* wakes the thread so the connection is read as soon as it reopens. */
+    if (pTargIoChannel->type == TMWTARGIO_TYPE_TCP)
+    {
+      linTCP_waitChannelThread(pTargIoChannel, 500);
+      continue;
+    }
+#endif
+#if TMWCNFG_MULTIPLE_TIMER_QS
+    tmwtargio_waitMultiTimer(pChannel, 500);
+#else
     tmwtarg_sleep(500);
+#endif
   }
   pTargIoChannel->chanThreadState = TMWTARG_THREAD_EXITED;
 
@@ -704,6 +873,15 @@ void * TMWDEFS_GLOBAL tmwtarg_initChannel(
    * to process this channel's timer queue.
    */
   pTargIoChannel->chanState = TMWTARG_CHANNEL_INITIALIZED;
+#if TMWTARGRT_SUPPORTED
+  /* Channels opened by a runtime worker are driven by that worker */
+  if (tmwtargrt_attachChannel(pTargIoChannel))
+  {
+    pTargIoChannel->polledMode = TMWDEFS_FALSE;
+    pChannel->polledMode = TMWDEFS_FALSE;
+    return(pTargIoChannel);
+  }
+#endif
 #if TMWCNFG_SUPPORT_THREADS
   if ((pTargIoChannel->polledMode == TMWDEFS_FALSE) || (TMWCNFG_MULTIPLE_TIMER_QS))
   {
@@ -735,6 +913,12 @@ void TMWDEFS_GLOBAL tmwtarg_deleteChannel(
  * any memory and resources.
  */
   TMWTARG_IO_CHANNEL *pTargIoChannel = (TMWTARG_IO_CHANNEL *)pContext;
+#if TMWTARGRT_SUPPORTED
+  if (pTargIoChannel->pWorkerContext)
+  {
+    tmwtargrt_detachChannel(pTargIoChannel);
+  }
+#endif
   if (pTargIoChannel->pDeleteFunction)
   {
     pTargIoChannel->pDeleteFunction(pTargIoChannel);
@@ -874,7 +1058,6 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL tmwtarg_receive(
   TMWTYPES_BOOL *pInterCharTimeoutOccurred,
   TMWTYPES_MILLISECONDS *pFirstByteReceived)
 {
-  TMWTARG_UNUSED_PARAM(pFirstByteReceived);
 /* Attempt to read the specified number of bytes from this
  * channel. This routine should read at most maxBytes bytes
  * from this channel into pBuff. Implementation of the
@@ -887,7 +1070,15 @@ TMWTYPES_USHORT TMWDEFS_GLOBAL tmwtarg_receive(
   TMWTARG_IO_CHANNEL *pTargIoChannel = (TMWTARG_IO_CHANNEL *)pContext;
   if (pTargIoChannel->pRecvFunction)
   {
-    return (pTargIoChannel->pRecvFunction(pTargIoChannel, pBuff, maxBytes, maxTimeout, pInterCharTimeoutOccurred));
+    TMWTYPES_USHORT numReceived = pTargIoChannel->pRecvFunction(pTargIoChannel, pBuff, maxBytes, maxTimeout, pInterCharTimeoutOccurred);
+#if TMWTARG_SUPPORT_232
+    /* Serial channels know when the first byte was seen on the tty */
+    if ((numReceived > 0) && (pTargIoChannel->type == TMWTARGIO_TYPE_232) && (pFirstByteReceived != TMWDEFS_NULL))
+      *pFirstByteReceived = lin232_getFirstByteTime(pTargIoChannel);
+#else
+    TMWTARG_UNUSED_PARAM(pFirstByteReceived);
+#endif
+    return (numReceived);
   }
   return(0);
 }
@@ -41,6 +41,17 @@
 /* set this to TMWDEFS_TRUE to enable DNP file operations */
 #define TMWTARG_SUPPORT_DNPFILEIO TMWDEFS_TRUE
 
+/* Size in bytes of the buffer each open DNP file uses.  */
+/* Object 70 reads fill it ahead of the blocks being     */
+/* sent and writes are collected in it, so a transfer    */
+/* makes one system call per buffer instead of per block. */
+#define TMWTARG_DNPFILE_BUFFER_SIZE 65536
+
+/* Number of directories whose object 70 listings are   */
+/* cached. Each one is watched with inotify so listings */
+/* stay current without reading the directory again.    */
+#define TMWTARG_DNPFILE_DIR_CACHE_SIZE 8
+
 /* set this to TMWDEFS_TRUE to enable UDP support */
 /* UDP is required for DNP, otherwise can be set to TMWDEFS_FALSE */
 #define TMWTARG_SUPPORT_UDP TMWDEFS_TRUE
@@ -51,6 +62,15 @@
   #error TMWCNFG_USE_OPENSSL Must be defined to support TLS.
 #endif
 
+/* set this to TMWDEFS_FALSE to disable TLS session resumption. When    */
+/* enabled a TLS client offers the session from its previous connection */
+/* and a TLS server caches sessions, so reconnecting after a network    */
+/* outage does not require a full handshake.                            */
+#define TMWTARG_TLS_SESSION_RESUMPTION TMWDEFS_TRUE
+
+/* Number of seconds a cached TLS session may be resumed */
+#define TMWTARG_TLS_SESSION_TIMEOUT 3600
+
 /* set this to TMWDEFS_FALSE to remove POLL support.    */
 /* The Linux target layer uses this as its default      */
 /* setting. With this disabled, the Linux target layer  */
@@ -61,4 +81,41 @@
 /* this target layer to an OS that only supports select.*/
 #define TMWTARG_SUPPORT_POLL TMWDEFS_TRUE
 
+/* A wait timeout meaning wait until a descriptor is   */
+/* ready, there is no limit.                            */
+#define TMWTARG_WAIT_FOREVER ((TMWTYPES_MILLISECONDS)0xffffffffUL)
+
+/* When TMWCNFG_MULTIPLE_TIMER_QS is enabled each channel */
+/* timer queue is driven by a timerfd that the channel  */
+/* thread waits on along with its IO descriptors. This  */
+/* is the longest the channel thread will then wait     */
+/* without any IO or timer activity, in milliseconds.   */
+/* The timerfd is armed whenever a timer is running and */
+/* tmwtarg_stopThreads fires it to stop the thread, so  */
+/* by default an idle channel waits until it is needed. */
+#define TMWTARG_MULTI_TIMER_IDLE_WAIT TMWTARG_WAIT_FOREVER
+
+/* Number of threads accepting connections for each TCP */
+/* listen port. Each thread has its own SO_REUSEPORT    */
+/* socket so the kernel spreads connection storms across */
+/* them, and accepted sockets are handed straight to the */
+/* matching channel. Set to 0 to accept connections from */
+/* the channel threads instead.                          */
+#define TMWTARG_TCP_LISTENER_THREADS 2
+
+/* set this to TMWDEFS_FALSE to remove support for keeping */
+/* DNP slave point values in a shared memory region that a  */
+/* separate data acquisition process updates, see sdnpshm.h */
+#define TMWTARG_SUPPORT_SHM_DB TMWDEFS_TRUE
+
+/* set this to TMWDEFS_FALSE to add entries to the asynchronous */
+/* database queue under its lock instead of with atomic         */
+/* operations on a preallocated ring, see tmwdb.h               */
+#define TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE TMWDEFS_TRUE
+
+/* set this to TMWDEFS_FALSE to remove support for keeping  */
+/* a journal of the DNP slave event queues and point values */
+/* in a file so they survive a restart, see sdnpjrnl.h      */
+#define TMWTARG_SUPPORT_JOURNAL TMWDEFS_TRUE
+
 #endif /* TMWTARGCNFG_DEFINED */
@@ -33,6 +33,10 @@
 #include "tmwtargcnfg.h"
 #include "tmwscl/utils/tmwtarg.h"
 
+/* Convert a wait in milliseconds to a poll timeout */
+#define TMWTARGIO_POLL_TIMEOUT(timeout) \
+  (((timeout) == TMWTARG_WAIT_FOREVER) ? -1 : (int)(timeout))
+
 /* Configuration structure */
 typedef struct TmwTargIOConfig {
   TMWTARGIO_TYPE_ENUM type;
@@ -67,6 +71,43 @@ extern "C" {
 TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwtargio_initConfig(
   TMWTARGIO_CONFIG *pConfig);
 
+/* function: tmwtargio_getMultiTimerFd
+* purpose: Get the timerfd that drives this channel's timer queue when
+*  TMWCNFG_MULTIPLE_TIMER_QS is enabled, so it can be waited on along
+*  with the channel's IO descriptors.
+* arguments :
+*  pChannel - pointer to channel, may be TMWDEFS_NULL
+* returns :
+*  file descriptor, or -1 if there is none
+*/
+int TMWDEFS_GLOBAL tmwtargio_getMultiTimerFd(
+  TMWCHNL *pChannel);
+
+/* function: tmwtargio_checkMultiTimer
+* purpose: If the channel's timerfd has expired, acknowledge it and
+*  service the channel's timer queue. Does not block.
+* arguments :
+*  pChannel - pointer to channel, may be TMWDEFS_NULL
+* returns :
+*  TMWDEFS_TRUE if the timer queue was serviced
+*/
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargio_checkMultiTimer(
+  TMWCHNL *pChannel);
+
+/* function: tmwtargio_waitMultiTimer
+* purpose: Sleep for up to timeout milliseconds, servicing the channel's
+*  timer queue if its timerfd expires in the meantime. Without
+*  TMWCNFG_MULTIPLE_TIMER_QS this is the same as tmwtarg_sleep.
+* arguments :
+*  pChannel - pointer to channel, may be TMWDEFS_NULL
+*  timeout - maximum number of milliseconds to wait
+* returns :
+*  void
+*/
+void TMWDEFS_GLOBAL tmwtargio_waitMultiTimer(
+  TMWCHNL *pChannel,
+  TMWTYPES_MILLISECONDS timeout);
+
 #ifdef __cplusplus
 }
 ;
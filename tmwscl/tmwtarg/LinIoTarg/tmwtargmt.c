@@ -0,0 +1,292 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 2008-2011 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: tmwtargmt.c
+ * description: Implementation of the Linux metrics export
+ */
+#include "tmwscl/utils/tmwcnfg.h"
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwtargmt.h"
+
+#if TMWTARGMT_SUPPORTED
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "liniodiag.h"
+
+/* Size of the first snapshot buffer, it is doubled until the snapshot fits */
+#define TMWTARGMT_INITIAL_BUFFER  16384
+
+/* Largest snapshot buffer */
+#define TMWTARGMT_MAX_BUFFER      (16 * 1024 * 1024)
+
+/* Longest request that is read, only the request line is used */
+#define TMWTARGMT_MAX_REQUEST     2048
+
+/* Longest a client may take to send its request, in seconds */
+#define TMWTARGMT_REQUEST_TIMEOUT 2
+
+static int _listenSocket = -1;
+static TMW_ThreadId _serverThread;
+static volatile TMWTYPES_BOOL _serverRunning = TMWDEFS_FALSE;
+
+/* function: _takeSnapshot
+ *  return a snapshot in a buffer allocated with malloc, the caller frees it
+ */
+static TMWTYPES_CHAR *_takeSnapshot(TMWTYPES_ULONG *pLength)
+{
+  TMWTYPES_ULONG size = TMWTARGMT_INITIAL_BUFFER;
+
+  while(size <= TMWTARGMT_MAX_BUFFER)
+  {
+    TMWTYPES_CHAR *pBuf = (TMWTYPES_CHAR *)malloc(size);
+    if(pBuf == NULL)
+      return(TMWDEFS_NULL);
+
+    *pLength = tmwmetr_snapshot(pBuf, size);
+    if(*pLength != 0)
+      return(pBuf);
+
+    free(pBuf);
+    size *= 2;
+  }
+  return(TMWDEFS_NULL);
+}
+
+/* function: _sendAll */
+static TMWTYPES_BOOL _sendAll(int sock, const TMWTYPES_CHAR *pData, size_t length)
+{
+  while(length > 0)
+  {
+    ssize_t sent = send(sock, pData, length, MSG_NOSIGNAL);
+    if(sent < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      return(TMWDEFS_FALSE);
+    }
+    pData += sent;
+    length -= (size_t)sent;
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _serveClient
+ *  read one request and answer it, then close the connection
+ */
+static void _serveClient(int sock)
+{
+  TMWTYPES_CHAR request[TMWTARGMT_MAX_REQUEST];
+  TMWTYPES_CHAR header[160];
+  struct timeval timeout;
+  size_t length = 0;
+
+  timeout.tv_sec = TMWTARGMT_REQUEST_TIMEOUT;
+  timeout.tv_usec = 0;
+  (void)setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  /* Read until the end of the request headers */
+  while(length < sizeof(request) - 1)
+  {
+    ssize_t received = recv(sock, request + length, sizeof(request) - 1 - length, 0);
+    if(received <= 0)
+    {
+      if((received < 0) && (errno == EINTR))
+        continue;
+      break;
+    }
+    length += (size_t)received;
+    request[length] = '\0';
+    if(strstr(request, "\r\n\r\n") != NULL || strstr(request, "\n\n") != NULL)
+      break;
+  }
+  request[length] = '\0';
+
+  if((strncmp(request, "GET /metrics ", 13) == 0) || (strncmp(request, "GET / ", 6) == 0))
+  {
+    TMWTYPES_ULONG bodyLength;
+    TMWTYPES_CHAR *pBody = _takeSnapshot(&bodyLength);
+    if(pBody != TMWDEFS_NULL)
+    {
+      (void)tmwtarg_snprintf(header, sizeof(header),
+        "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+        "Content-Length: %lu\r\nConnection: close\r\n\r\n", (unsigned long)bodyLength);
+      if(_sendAll(sock, header, strlen(header)))
+        (void)_sendAll(sock, pBody, bodyLength);
+      free(pBody);
+    }
+    else
+    {
+      const TMWTYPES_CHAR *pError = "HTTP/1.0 500 Internal Server Error\r\nConnection: close\r\n\r\n";
+      (void)_sendAll(sock, pError, strlen(pError));
+    }
+  }
+  else
+  {
+    const TMWTYPES_CHAR *pError = "HTTP/1.0 404 Not Found\r\nConnection: close\r\n\r\n";
+    (void)_sendAll(sock, pError, strlen(pError));
+  }
+
+  close(sock);
+}
+
+/* function: _serverThreadFunc */
+static TMW_ThreadDecl _serverThreadFunc(TMW_ThreadArg pArg)
+{
+  TMWTARG_UNUSED_PARAM(pArg);
+
+  while(_serverRunning)
+  {
+    int sock = accept(_listenSocket, NULL, NULL);
+    if(sock < 0)
+    {
+      if(errno == EINTR || errno == ECONNABORTED)
+        continue;
+
+      /* The listen socket was shut down by tmwtargmt_stopServer */
+      break;
+    }
+    _serveClient(sock);
+  }
+  return(NULL);
+}
+
+/* function: tmwtargmt_startServer */
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargmt_startServer(
+  const TMWTYPES_CHAR *pAddress,
+  TMWTYPES_USHORT port)
+{
+  struct sockaddr_in address;
+  int reuse = 1;
+
+  if(_serverRunning)
+    return(TMWDEFS_FALSE);
+
+  memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if(pAddress == TMWDEFS_NULL)
+    pAddress = "127.0.0.1";
+  if(inet_pton(AF_INET, pAddress, &address.sin_addr) != 1)
+  {
+    LINIODIAG_ERRORMSG("metrics: invalid server address %s", pAddress);
+    return(TMWDEFS_FALSE);
+  }
+
+  _listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if(_listenSocket < 0)
+  {
+    LINIODIAG_ERRORMSG("metrics: unable to create server socket, %s", strerror(errno));
+    return(TMWDEFS_FALSE);
+  }
+  (void)setsockopt(_listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  if((bind(_listenSocket, (struct sockaddr *)&address, sizeof(address)) != 0)
+    || (listen(_listenSocket, 8) != 0))
+  {
+    LINIODIAG_ERRORMSG("metrics: unable to listen on port %u, %s", (unsigned int)port, strerror(errno));
+    close(_listenSocket);
+    _listenSocket = -1;
+    return(TMWDEFS_FALSE);
+  }
+
+  _serverRunning = TMWDEFS_TRUE;
+  if(TMW_ThreadCreate(&_serverThread, _serverThreadFunc, TMWDEFS_NULL, 0, 0) != 0)
+  {
+    LINIODIAG_ERRORMSG("metrics: unable to start server thread");
+    _serverRunning = TMWDEFS_FALSE;
+    close(_listenSocket);
+    _listenSocket = -1;
+    return(TMWDEFS_FALSE);
+  }
+  return(TMWDEFS_TRUE);
+}
+
+/* function: tmwtargmt_stopServer */
+void TMWDEFS_GLOBAL tmwtargmt_stopServer(void)
+{
+  if(!_serverRunning)
+    return;
+
+  /* Shutting down the listen socket wakes the server thread from accept */
+  _serverRunning = TMWDEFS_FALSE;
+  (void)shutdown(_listenSocket, SHUT_RDWR);
+  pthread_join(_serverThread, NULL);
+
+  close(_listenSocket);
+  _listenSocket = -1;
+}
+
+/* function: tmwtargmt_writeFile */
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargmt_writeFile(
+  const TMWTYPES_CHAR *pFileName)
+{
+  TMWTYPES_CHAR tempName[512];
+  TMWTYPES_ULONG length;
+  TMWTYPES_CHAR *pBuf;
+  TMWTYPES_BOOL status = TMWDEFS_FALSE;
+  FILE *pFile;
+
+  (void)tmwtarg_snprintf(tempName, sizeof(tempName), "%s.%d.tmp", pFileName, (int)getpid());
+
+  pBuf = _takeSnapshot(&length);
+  if(pBuf == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  pFile = fopen(tempName, "w");
+  if(pFile != NULL)
+  {
+    status = (TMWTYPES_BOOL)(fwrite(pBuf, 1, length, pFile) == length);
+    if(fclose(pFile) != 0)
+      status = TMWDEFS_FALSE;
+
+    /* rename replaces the old file in one step */
+    if(status && (rename(tempName, pFileName) != 0))
+      status = TMWDEFS_FALSE;
+
+    if(!status)
+    {
+      LINIODIAG_ERRORMSG("metrics: unable to write %s, %s", pFileName, strerror(errno));
+      (void)unlink(tempName);
+    }
+  }
+  else
+  {
+    LINIODIAG_ERRORMSG("metrics: unable to create %s, %s", tempName, strerror(errno));
+  }
+
+  free(pBuf);
+  return(status);
+}
+
+#endif /* TMWTARGMT_SUPPORTED */
@@ -0,0 +1,93 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 2008-2011 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+
+/* file: tmwtargmt.h
+ * description: Export of the SCL runtime metrics on Linux.
+ *
+ *  The metrics kept by tmwmetr.c can be served over HTTP so Prometheus can
+ *  scrape them directly, or written to a file for a collector such as the
+ *  node exporter textfile collector to pick up. Serving runs on a thread
+ *  of its own and only reads the metrics, so it never holds up channel
+ *  processing.
+ */
+#ifndef tmwtargmt_DEFINED
+#define tmwtargmt_DEFINED
+
+#include "tmwtargcnfg.h"
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwmetr.h"
+
+#define TMWTARGMT_SUPPORTED \
+  (TMWCNFG_SUPPORT_METRICS && TMWCNFG_SUPPORT_THREADS)
+
+#if TMWTARGMT_SUPPORTED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* function: tmwtargmt_startServer
+* purpose: Start a thread that answers HTTP requests for /metrics with a
+*  snapshot of the metrics in the Prometheus text format.
+* arguments :
+*  pAddress - IP address to listen on, TMWDEFS_NULL listens on 127.0.0.1
+*  port - TCP port to listen on
+* returns :
+*  TMWDEFS_TRUE if the server is listening
+*/
+TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargmt_startServer(
+  const TMWTYPES_CHAR *pAddress,
+  TMWTYPES_USHORT port);
+
+/* function: tmwtargmt_stopServer
+* purpose: Stop the server started by tmwtargmt_startServer
+* arguments :
+*  void
+* returns :
+*  void
+*/
+TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwtargmt_stopServer(void);
+
+/* function: tmwtargmt_writeFile
+* purpose: Write a snapshot of the metrics to a file. The snapshot is
+*  written to a temporary file that then replaces pFileName, so a reader
+*  never sees a partly written file.
+* arguments :
+*  pFileName - file to write
+* returns :
+*  TMWDEFS_TRUE if the file was written
+*/
+TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargmt_writeFile(
+  const TMWTYPES_CHAR *pFileName);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TMWTARGMT_SUPPORTED */
+
+#endif /* tmwtargmt_DEFINED */
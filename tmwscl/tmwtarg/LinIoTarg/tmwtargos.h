@@ -31,6 +31,7 @@
 #define tmwtargos_DEFINED
 
 #include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 #include <signal.h>
 #include <sys/time.h>
@@ -40,6 +41,32 @@
 
 #define SOCKET                  int
 
+/* Full memory barrier, used to order updates to shared memory point
+ * values with their sequence numbers, see sdnpshm.h
+ */
+#define TMWTARG_MEMORY_BARRIER() __sync_synchronize()
+
+/* Atomically set *pValue to newValue if it is oldValue, with a full
+ * memory barrier. Evaluates to non zero if the value was set.
+ */
+#define TMWTARG_COMPARE_AND_SWAP(pValue, oldValue, newValue) \
+  __sync_bool_compare_and_swap(pValue, oldValue, newValue)
+
+/* Relaxed atomic add, store and load, used to update runtime metrics
+ * that another thread may read at the same time, see tmwmetr.h
+ */
+#define TMWTARG_ATOMIC_ADD(pValue, amount) \
+  ((void)__atomic_fetch_add(pValue, amount, __ATOMIC_RELAXED))
+#define TMWTARG_ATOMIC_STORE(pValue, value) \
+  __atomic_store_n(pValue, value, __ATOMIC_RELAXED)
+#define TMWTARG_ATOMIC_LOAD(pValue) \
+  __atomic_load_n(pValue, __ATOMIC_RELAXED)
+
+/* Let another thread run, used while waiting for a shared memory point
+ * that another thread is updating.
+ */
+#define TMWTARG_YIELD() sched_yield()
+
 #if TMWCNFG_SUPPORT_THREADS
  /* Type for the handle that the OS passes back for the created thread */
 #define TMW_ThreadId            pthread_t
@@ -0,0 +1,899 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 2008-2011 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+
+/* file: tmwtargrt.c
+ * description: Implementation of the Linux worker pool runtime
+ */
+
+/* Needed for pthread_setaffinity_np */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include "tmwscl/utils/tmwcnfg.h"
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwtargrt.h"
+
+#if TMWTARGRT_SUPPORTED
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#include "tmwtargio.h"
+#include "lin232.h"
+#include "lintcp.h"
+#include "liniodiag.h"
+
+/* Most descriptors a single IO channel waits on */
+#define TMWTARGRT_MAX_CHANNEL_FDS 8
+
+/* Most epoll events read by one wait, any more are read by the next */
+#define TMWTARGRT_MAX_EVENTS      64
+
+typedef struct TmwTargRtSubmit {
+  TMWTARGRT_SUBMIT_FUNC pFunc;
+  void                 *pParam;
+  int                   channelIndex;
+} TMWTARGRT_SUBMIT;
+
+/* An IO channel driven by a worker. pWorkerContext in the IO channel
+ * points here, and so does the data of each of its epoll events.
+ */
+typedef struct TmwTargRtSlot {
+  struct TmwTargRtWorker *pWorker;
+
+  /* TMWDEFS_NULL once the IO channel has been deleted */
+  TMWTARG_IO_CHANNEL   *pTargIoChannel;
+
+  /* Descriptors the IO channel was waiting on when last synced */
+  struct pollfd         fds[TMWTARGRT_MAX_CHANNEL_FDS];
+  int                   numFds;
+  TMWTYPES_ULONG        generation;
+
+  /* Descriptors registered with epoll, -1 if registration failed. A
+   * duplicate is registered when another channel on the worker already
+   * registered the same descriptor, such as a shared listen socket.
+   */
+  int                   regFds[TMWTARGRT_MAX_CHANNEL_FDS];
+  TMWTYPES_BOOL         dupFds[TMWTARGRT_MAX_CHANNEL_FDS];
+  int                   numRegFds;
+  TMWTYPES_BOOL         registerPending;
+
+  /* Pass the slot was last run in, and last added to the sync list in */
+  TMWTYPES_ULONG        runPass;
+  TMWTYPES_ULONG        syncPass;
+} TMWTARGRT_SLOT;
+
+typedef struct TmwTargRtWorker {
+  struct TmwTargRt     *pRuntime;
+  int                   index;
+  TMW_ThreadId          threadId;
+  TMWAPPL              *pApplContext;
+
+  /* eventfd written to wake the worker, registered with a NULL pointer */
+  int                   wakeFd;
+  int                   epollFd;
+
+  /* IO channels driven by this worker. These are only added on the
+   * worker's own thread. Deleted channels are left in place with a NULL
+   * pTargIoChannel and freed at the start of the next pass.
+   */
+  TMWTARGRT_SLOT      **ppSlots;
+  int                   numSlots;
+  int                   maxSlots;
+  TMWTYPES_BOOL         slotRemoved;
+
+  /* Slots whose channel has input that will not wake epoll */
+  TMWTARGRT_SLOT      **ppReady;
+  int                   numReady;
+
+  /* Slots run or submitted to during this pass, whose descriptors are
+   * synced with epoll at the end of it, and slots added since the last
+   * sync. Only these can have changed the descriptors they wait on.
+   */
+  TMWTARGRT_SLOT      **ppSync;
+  int                   numSync;
+  TMWTARGRT_SLOT      **ppNew;
+  int                   numNew;
+  TMWTYPES_ULONG        pass;
+
+  /* Functions submitted from other threads */
+  TMWDEFS_RESOURCE_LOCK submitLock;
+  TMWTARGRT_SUBMIT     *pSubmitQueue;
+  int                   submitHead;
+  int                   submitCount;
+
+  TMWTYPES_MILLISECONDS lastTick;
+} TMWTARGRT_WORKER;
+
+struct TmwTargRt {
+  TMWTARGRT_CONFIG      config;
+  int                   numWorkers;
+  TMWTARGRT_WORKER     *pWorkers;
+  int                   numChannels;
+  TMWCHNL             **ppChannels;
+  TMWTARGRT_OPEN_FUNC   pOpenFunc;
+  TMWTARGRT_CLOSE_FUNC  pCloseFunc;
+  void                 *pParam;
+  volatile TMWTYPES_BOOL running;
+
+  /* Signalled as each worker finishes opening its channels */
+  pthread_mutex_t       openLock;
+  pthread_cond_t        openCond;
+  int                   numOpened;
+};
+
+/* Worker running on this thread, if any */
+static __thread TMWTARGRT_WORKER *_pCurrentWorker = TMWDEFS_NULL;
+
+/* function: _reserveSlots
+ *  make room for numSlots IO channels on a worker
+ */
+static TMWTYPES_BOOL _reserveSlots(TMWTARGRT_WORKER *pWorker, int numSlots)
+{
+  TMWTARGRT_SLOT **ppSlots;
+
+  if (numSlots <= pWorker->maxSlots)
+    return TMWDEFS_TRUE;
+
+  ppSlots = (TMWTARGRT_SLOT **)realloc(pWorker->ppSlots, numSlots * sizeof(TMWTARGRT_SLOT *));
+  if (ppSlots == NULL)
+    return TMWDEFS_FALSE;
+  pWorker->ppSlots = ppSlots;
+
+  ppSlots = (TMWTARGRT_SLOT **)realloc(pWorker->ppReady, numSlots * sizeof(TMWTARGRT_SLOT *));
+  if (ppSlots == NULL)
+    return TMWDEFS_FALSE;
+  pWorker->ppReady = ppSlots;
+
+  ppSlots = (TMWTARGRT_SLOT **)realloc(pWorker->ppSync, numSlots * sizeof(TMWTARGRT_SLOT *));
+  if (ppSlots == NULL)
+    return TMWDEFS_FALSE;
+  pWorker->ppSync = ppSlots;
+
+  ppSlots = (TMWTARGRT_SLOT **)realloc(pWorker->ppNew, numSlots * sizeof(TMWTARGRT_SLOT *));
+  if (ppSlots == NULL)
+    return TMWDEFS_FALSE;
+  pWorker->ppNew = ppSlots;
+
+  pWorker->maxSlots = numSlots;
+  return TMWDEFS_TRUE;
+}
+
+/* function: _getPollFds
+ *  get the descriptors an IO channel is waiting on
+ */
+static int _getPollFds(TMWTARG_IO_CHANNEL *pTargIoChannel, struct pollfd *pFds,
+  TMWTYPES_BOOL *pReady, TMWTYPES_ULONG *pGeneration)
+{
+  *pReady = TMWDEFS_FALSE;
+  *pGeneration = 0;
+  switch (pTargIoChannel->type)
+  {
+#if TMWTARG_SUPPORT_232
+  case TMWTARGIO_TYPE_232:
+    return lin232_getPollFds(pTargIoChannel, pFds, TMWTARGRT_MAX_CHANNEL_FDS, pReady, pGeneration);
+#endif
+
+#if TMWTARG_SUPPORT_TCP
+  case TMWTARGIO_TYPE_TCP:
+    return linTCP_getPollFds(pTargIoChannel, pFds, TMWTARGRT_MAX_CHANNEL_FDS, pReady, pGeneration);
+#endif
+  default:
+    break;
+  }
+  return 0;
+}
+
+/* function: _registerSlot
+ *  register the descriptors a slot was synced with
+ */
+static void _registerSlot(TMWTARGRT_WORKER *pWorker, TMWTARGRT_SLOT *pSlot)
+{
+  int i;
+
+  for (i = 0; i < pSlot->numFds; i++)
+  {
+    struct epoll_event event;
+    int                fd = pSlot->fds[i].fd;
+
+    memset(&event, 0, sizeof(event));
+    event.events = (uint32_t)pSlot->fds[i].events;
+    event.data.ptr = pSlot;
+    pSlot->dupFds[i] = TMWDEFS_FALSE;
+
+    if (epoll_ctl(pWorker->epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+    {
+      int error = errno;
+
+      /* Another channel on this worker waits on the same descriptor */
+      fd = -1;
+      if (error == EEXIST)
+      {
+        fd = fcntl(pSlot->fds[i].fd, F_DUPFD_CLOEXEC, 0);
+        if (fd == -1)
+        {
+          error = errno;
+        }
+        else if (epoll_ctl(pWorker->epollFd, EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+          error = errno;
+          close(fd);
+          fd = -1;
+        }
+        else
+        {
+          pSlot->dupFds[i] = TMWDEFS_TRUE;
+        }
+      }
+      if (fd == -1)
+      {
+        LINIODIAG_ERRORMSG("runtime: worker %d unable to wait on descriptor %d, %s",
+          pWorker->index, pSlot->fds[i].fd, strerror(error));
+      }
+    }
+    pSlot->regFds[i] = fd;
+  }
+  pSlot->numRegFds = pSlot->numFds;
+  pSlot->registerPending = TMWDEFS_FALSE;
+}
+
+/* function: _unregisterSlot
+ *  remove a slot's descriptors from epoll. Descriptors the channel has
+ *  already closed were removed by the kernel, so errors are ignored.
+ */
+static void _unregisterSlot(TMWTARGRT_WORKER *pWorker, TMWTARGRT_SLOT *pSlot)
+{
+  int i;
+
+  for (i = 0; i < pSlot->numRegFds; i++)
+  {
+    if (pSlot->regFds[i] == -1)
+      continue;
+
+    epoll_ctl(pWorker->epollFd, EPOLL_CTL_DEL, pSlot->regFds[i], NULL);
+    if (pSlot->dupFds[i])
+      close(pSlot->regFds[i]);
+  }
+  pSlot->numRegFds = 0;
+}
+
+/* function: _syncSlots
+ *  bring the epoll registrations of a list of slots up to date with the
+ *  descriptors their IO channels are waiting on, and add the slots with
+ *  input already waiting to the ready list. Every changed slot is
+ *  unregistered before any is registered, since a descriptor one channel
+ *  closed may have been reopened by another with the same number.
+ */
+static void _syncSlots(TMWTARGRT_WORKER *pWorker, TMWTARGRT_SLOT **ppSlots, int numSlots)
+{
+  int i;
+
+  for (i = 0; i < numSlots; i++)
+  {
+    TMWTARGRT_SLOT *pSlot = ppSlots[i];
+    struct pollfd   fds[TMWTARGRT_MAX_CHANNEL_FDS];
+    TMWTYPES_BOOL   ready;
+    TMWTYPES_ULONG  generation;
+    TMWTYPES_BOOL   changed;
+    int             numFds;
+    int             fd;
+
+    if (pSlot->pTargIoChannel == TMWDEFS_NULL)
+      continue;
+
+    numFds = _getPollFds(pSlot->pTargIoChannel, fds, &ready, &generation);
+    if (ready)
+      pWorker->ppReady[pWorker->numReady++] = pSlot;
+
+    changed = (numFds != pSlot->numFds) || (generation != pSlot->generation);
+    for (fd = 0; (fd < numFds) && !changed; fd++)
+    {
+      changed = (fds[fd].fd != pSlot->fds[fd].fd) || (fds[fd].events != pSlot->fds[fd].events);
+    }
+    if (!changed)
+      continue;
+
+    _unregisterSlot(pWorker, pSlot);
+    memcpy(pSlot->fds, fds, numFds * sizeof(struct pollfd));
+    pSlot->numFds = numFds;
+    pSlot->generation = generation;
+    pSlot->registerPending = TMWDEFS_TRUE;
+  }
+
+  for (i = 0; i < numSlots; i++)
+  {
+    if (ppSlots[i]->registerPending)
+      _registerSlot(pWorker, ppSlots[i]);
+  }
+}
+
+/* function: _addSyncSlot
+ *  sync a slot's descriptors at the end of this pass
+ */
+static void _addSyncSlot(TMWTARGRT_WORKER *pWorker, TMWTARGRT_SLOT *pSlot)
+{
+  if (pSlot->syncPass != pWorker->pass)
+  {
+    pSlot->syncPass = pWorker->pass;
+    pWorker->ppSync[pWorker->numSync++] = pSlot;
+  }
+}
+
+/* function: _endPass
+ *  sync the slots that could have changed their descriptors this pass,
+ *  or every slot if all is set
+ */
+static void _endPass(TMWTARGRT_WORKER *pWorker, TMWTYPES_BOOL all)
+{
+  int i;
+
+  pWorker->numReady = 0;
+  if (all)
+  {
+    _syncSlots(pWorker, pWorker->ppSlots, pWorker->numSlots);
+  }
+  else
+  {
+    for (i = 0; i < pWorker->numNew; i++)
+    {
+      _addSyncSlot(pWorker, pWorker->ppNew[i]);
+    }
+    _syncSlots(pWorker, pWorker->ppSync, pWorker->numSync);
+  }
+  pWorker->numNew = 0;
+  pWorker->numSync = 0;
+}
+
+/* function: _runSlot
+ *  process expired timers and received data for a slot's IO channel
+ */
+static void _runSlot(TMWTARGRT_WORKER *pWorker, TMWTARGRT_SLOT *pSlot)
+{
+  TMWTARG_IO_CHANNEL *pTargIoChannel = pSlot->pTargIoChannel;
+
+  /* Deleted, or already run, earlier in this pass */
+  if ((pTargIoChannel == TMWDEFS_NULL) || (pSlot->runPass == pWorker->pass))
+    return;
+
+  pSlot->runPass = pWorker->pass;
+  _addSyncSlot(pWorker, pSlot);
+
+  tmwtargio_checkMultiTimer(pTargIoChannel->pChannel);
+  if ((pSlot->pTargIoChannel != TMWDEFS_NULL)
+    && (pTargIoChannel->chanState == TMWTARG_CHANNEL_OPENED) && (pTargIoChannel->pCheckInputFunction))
+  {
+    pTargIoChannel->pCheckInputFunction(pTargIoChannel, 0);
+  }
+}
+
+/* function: _getChannelSlot
+ *  get the slot of the IO channel under runtime channel channelIndex
+ */
+static TMWTARGRT_SLOT *_getChannelSlot(TMWTARGRT *pRuntime, int channelIndex)
+{
+  TMWCHNL            *pChannel = pRuntime->ppChannels[channelIndex];
+  TMWTARG_IO_CHANNEL *pTargIoChannel;
+
+  if ((pChannel == TMWDEFS_NULL) || (pChannel->pPhysContext == TMWDEFS_NULL))
+    return TMWDEFS_NULL;
+
+  pTargIoChannel = (TMWTARG_IO_CHANNEL *)pChannel->pPhysContext->pIOContext;
+  if (pTargIoChannel == TMWDEFS_NULL)
+    return TMWDEFS_NULL;
+
+  return (TMWTARGRT_SLOT *)pTargIoChannel->pWorkerContext;
+}
+
+/* function: _wakeWorker */
+static void _wakeWorker(TMWTARGRT_WORKER *pWorker)
+{
+  uint64_t one = 1;
+  write(pWorker->wakeFd, &one, sizeof(one));
+}
+
+/* function: _runSubmitted
+ *  run the functions that were submitted to this worker
+ */
+static void _runSubmitted(TMWTARGRT_WORKER *pWorker)
+{
+  int      queueSize = pWorker->pRuntime->config.submitQueueSize;
+  uint64_t count;
+
+  read(pWorker->wakeFd, &count, sizeof(count));
+
+  while (TMWDEFS_TRUE)
+  {
+    TMWTARGRT_SUBMIT submit;
+    TMWTARGRT_SLOT  *pSlot;
+
+    TMWTARG_LOCK_SECTION(&pWorker->submitLock);
+    if (pWorker->submitCount == 0)
+    {
+      TMWTARG_UNLOCK_SECTION(&pWorker->submitLock);
+      break;
+    }
+    submit = pWorker->pSubmitQueue[pWorker->submitHead];
+    pWorker->submitHead = (pWorker->submitHead + 1) % queueSize;
+    pWorker->submitCount--;
+    TMWTARG_UNLOCK_SECTION(&pWorker->submitLock);
+
+    /* Run the function without the lock so it can submit more work. */
+    /* It may change what the channel waits on, so sync the channel.  */
+    pSlot = _getChannelSlot(pWorker->pRuntime, submit.channelIndex);
+    submit.pFunc(submit.pParam);
+    if (pSlot != TMWDEFS_NULL)
+      _addSyncSlot(pWorker, pSlot);
+  }
+}
+
+/* function: _removeDeletedSlots */
+static void _removeDeletedSlots(TMWTARGRT_WORKER *pWorker)
+{
+  int from;
+  int to = 0;
+
+  for (from = 0; from < pWorker->numSlots; from++)
+  {
+    if (pWorker->ppSlots[from]->pTargIoChannel != TMWDEFS_NULL)
+    {
+      pWorker->ppSlots[to++] = pWorker->ppSlots[from];
+    }
+    else
+    {
+      free(pWorker->ppSlots[from]);
+    }
+  }
+  pWorker->numSlots = to;
+  pWorker->slotRemoved = TMWDEFS_FALSE;
+}
+
+/* function: _setAffinity */
+static void _setAffinity(TMWTARGRT_WORKER *pWorker)
+{
+  cpu_set_t cpuSet;
+  long      numCpus = sysconf(_SC_NPROCESSORS_ONLN);
+  int       cpu;
+  int       result;
+
+  if (numCpus < 1)
+    return;
+
+  cpu = (int)((pWorker->pRuntime->config.firstCpu + pWorker->index) % numCpus);
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  result = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+  if (result != 0)
+  {
+    LINIODIAG_ERRORMSG("runtime: unable to bind worker %d to CPU %d, %s",
+      pWorker->index, cpu, strerror(result));
+  }
+}
+
+/* function: _workerThread */
+static TMW_ThreadDecl _workerThread(TMW_ThreadArg pArg)
+{
+  TMWTARGRT_WORKER  *pWorker = (TMWTARGRT_WORKER *)pArg;
+  TMWTARGRT         *pRuntime = pWorker->pRuntime;
+  int                idleWait = (pRuntime->config.idleWait != 0) ? (int)pRuntime->config.idleWait : -1;
+  struct epoll_event events[TMWTARGRT_MAX_EVENTS];
+  int                channelIndex;
+
+  _pCurrentWorker = pWorker;
+
+  if (pRuntime->config.setAffinity)
+    _setAffinity(pWorker);
+
+  /* Open this worker's channels. The target layer attaches their IO */
+  /* channels to this worker since they are opened on its thread.    */
+  pWorker->pApplContext = tmwappl_initApplication();
+  if (pWorker->pApplContext != TMWDEFS_NULL)
+  {
+    for (channelIndex = pWorker->index; channelIndex < pRuntime->numChannels; channelIndex += pRuntime->numWorkers)
+    {
+      pRuntime->ppChannels[channelIndex] = pRuntime->pOpenFunc(pRuntime->pParam, pWorker->pApplContext, channelIndex);
+      if (pRuntime->ppChannels[channelIndex] == TMWDEFS_NULL)
+      {
+        LINIODIAG_ERRORMSG("runtime: worker %d failed to open channel %d", pWorker->index, channelIndex);
+      }
+    }
+  }
+  else
+  {
+    LINIODIAG_ERRORMSG("runtime: worker %d unable to create application context", pWorker->index);
+  }
+  _endPass(pWorker, TMWDEFS_TRUE);
+  pWorker->lastTick = tmwtarg_getMSTime();
+
+  pthread_mutex_lock(&pRuntime->openLock);
+  pRuntime->numOpened++;
+  pthread_cond_broadcast(&pRuntime->openCond);
+  pthread_mutex_unlock(&pRuntime->openLock);
+
+  while (pRuntime->running)
+  {
+    TMWTYPES_MILLISECONDS now;
+    TMWTYPES_BOOL         tick;
+    int                   numEvents;
+    int                   numSlots;
+    int                   i;
+
+    if (pWorker->slotRemoved)
+      _removeDeletedSlots(pWorker);
+
+    /* Block until a descriptor or timerfd is ready or work is submitted */
+    numEvents = epoll_wait(pWorker->epollFd, events, TMWTARGRT_MAX_EVENTS,
+      (pWorker->numReady != 0) ? 0 : idleWait);
+    if (numEvents < 0)
+    {
+      if (errno != EINTR)
+      {
+        LINIODIAG_ERRORMSG("runtime: worker %d epoll_wait returned error %d", pWorker->index, errno);
+      }
+      numEvents = 0;
+    }
+
+    pWorker->pass++;
+    for (i = 0; i < numEvents; i++)
+    {
+      if (events[i].data.ptr == NULL)
+        _runSubmitted(pWorker);
+    }
+
+    /* If configured, every idleWait give each channel a chance to run */
+    tick = TMWDEFS_FALSE;
+    if (pRuntime->config.idleWait != 0)
+    {
+      now = tmwtarg_getMSTime();
+      tick = ((now - pWorker->lastTick) >= pRuntime->config.idleWait);
+      if (tick)
+        pWorker->lastTick = now;
+    }
+
+    if (tick)
+    {
+      /* Slots added by a callback during this loop are run next pass */
+      numSlots = pWorker->numSlots;
+      for (i = 0; i < numSlots; i++)
+      {
+        _runSlot(pWorker, pWorker->ppSlots[i]);
+      }
+    }
+    else
+    {
+      for (i = 0; i < pWorker->numReady; i++)
+      {
+        _runSlot(pWorker, pWorker->ppReady[i]);
+      }
+      for (i = 0; i < numEvents; i++)
+      {
+        if (events[i].data.ptr != NULL)
+          _runSlot(pWorker, (TMWTARGRT_SLOT *)events[i].data.ptr);
+      }
+    }
+
+    _endPass(pWorker, tick);
+  }
+
+  /* Close this worker's channels on its own thread */
+  for (channelIndex = pWorker->index; channelIndex < pRuntime->numChannels; channelIndex += pRuntime->numWorkers)
+  {
+    if ((pRuntime->ppChannels[channelIndex] != TMWDEFS_NULL) && (pRuntime->pCloseFunc != TMWDEFS_NULL))
+    {
+      pRuntime->pCloseFunc(pRuntime->pParam, pRuntime->ppChannels[channelIndex], channelIndex);
+    }
+    pRuntime->ppChannels[channelIndex] = TMWDEFS_NULL;
+  }
+  if (pWorker->pApplContext != TMWDEFS_NULL)
+  {
+    tmwappl_closeApplication(pWorker->pApplContext, TMWDEFS_FALSE);
+    pWorker->pApplContext = TMWDEFS_NULL;
+  }
+
+  _pCurrentWorker = TMWDEFS_NULL;
+  return((TMW_ThreadPtr) NULL);
+}
+
+/* function: _freeRuntime */
+static void _freeRuntime(TMWTARGRT *pRuntime)
+{
+  int workerIndex;
+  int i;
+
+  for (workerIndex = 0; workerIndex < pRuntime->numWorkers; workerIndex++)
+  {
+    TMWTARGRT_WORKER *pWorker = &pRuntime->pWorkers[workerIndex];
+    if (pWorker->epollFd != -1)
+      close(pWorker->epollFd);
+    if (pWorker->wakeFd != -1)
+      close(pWorker->wakeFd);
+    if (pWorker->submitLock != TMWDEFS_NULL)
+      TMWTARG_LOCK_DELETE(&pWorker->submitLock);
+    free(pWorker->pSubmitQueue);
+    for (i = 0; i < pWorker->numSlots; i++)
+    {
+      free(pWorker->ppSlots[i]);
+    }
+    free(pWorker->ppSlots);
+    free(pWorker->ppReady);
+    free(pWorker->ppSync);
+    free(pWorker->ppNew);
+  }
+  pthread_cond_destroy(&pRuntime->openCond);
+  pthread_mutex_destroy(&pRuntime->openLock);
+  free(pRuntime->pWorkers);
+  free(pRuntime->ppChannels);
+  free(pRuntime);
+}
+
+/* function: tmwtargrt_initConfig */
+void TMWDEFS_GLOBAL tmwtargrt_initConfig(
+  TMWTARGRT_CONFIG *pConfig)
+{
+  pConfig->numWorkers = 0;
+  pConfig->setAffinity = TMWDEFS_FALSE;
+  pConfig->firstCpu = 0;
+  pConfig->submitQueueSize = 1024;
+  pConfig->idleWait = 0;
+}
+
+/* function: tmwtargrt_start */
+TMWTARGRT * TMWDEFS_GLOBAL tmwtargrt_start(
+  const TMWTARGRT_CONFIG *pConfig,
+  int numChannels,
+  TMWTARGRT_OPEN_FUNC pOpenFunc,
+  TMWTARGRT_CLOSE_FUNC pCloseFunc,
+  void *pParam)
+{
+  TMWTARGRT *pRuntime;
+  int        numWorkers;
+  int        numStarted;
+  int        workerIndex;
+
+  if ((numChannels < 1) || (pOpenFunc == TMWDEFS_NULL) || (pConfig->submitQueueSize < 1))
+    return TMWDEFS_NULL;
+
+  numWorkers = pConfig->numWorkers;
+  if (numWorkers <= 0)
+    numWorkers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (numWorkers > numChannels)
+    numWorkers = numChannels;
+  if (numWorkers < 1)
+    numWorkers = 1;
+
+  pRuntime = (TMWTARGRT *)calloc(1, sizeof(TMWTARGRT));
+  if (pRuntime == NULL)
+    return TMWDEFS_NULL;
+
+  pthread_mutex_init(&pRuntime->openLock, NULL);
+  pthread_cond_init(&pRuntime->openCond, NULL);
+  pRuntime->config = *pConfig;
+  pRuntime->numChannels = numChannels;
+  pRuntime->pOpenFunc = pOpenFunc;
+  pRuntime->pCloseFunc = pCloseFunc;
+  pRuntime->pParam = pParam;
+  pRuntime->running = TMWDEFS_TRUE;
+  pRuntime->ppChannels = (TMWCHNL **)calloc(numChannels, sizeof(TMWCHNL *));
+  pRuntime->pWorkers = (TMWTARGRT_WORKER *)calloc(numWorkers, sizeof(TMWTARGRT_WORKER));
+  if ((pRuntime->ppChannels == NULL) || (pRuntime->pWorkers == NULL))
+  {
+    _freeRuntime(pRuntime);
+    return TMWDEFS_NULL;
+  }
+
+  pRuntime->numWorkers = numWorkers;
+  for (workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+  {
+    pRuntime->pWorkers[workerIndex].wakeFd = -1;
+    pRuntime->pWorkers[workerIndex].epollFd = -1;
+  }
+
+  for (workerIndex = 0; workerIndex < numWorkers; workerIndex++)
+  {
+    TMWTARGRT_WORKER  *pWorker = &pRuntime->pWorkers[workerIndex];
+    struct epoll_event event;
+
+    pWorker->pRuntime = pRuntime;
+    pWorker->index = workerIndex;
+    pWorker->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    pWorker->epollFd = epoll_create1(EPOLL_CLOEXEC);
+    pWorker->pSubmitQueue = (TMWTARGRT_SUBMIT *)calloc(pConfig->submitQueueSize, sizeof(TMWTARGRT_SUBMIT));
+    TMWTARG_LOCK_INIT(&pWorker->submitLock);
+
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = NULL;
+    if ((pWorker->wakeFd == -1) || (pWorker->epollFd == -1) || (pWorker->pSubmitQueue == NULL)
+      || (epoll_ctl(pWorker->epollFd, EPOLL_CTL_ADD, pWorker->wakeFd, &event) != 0)
+      || !_reserveSlots(pWorker, (numChannels + numWorkers - 1) / numWorkers))
+    {
+      LINIODIAG_ERRORMSG("runtime: unable to create worker %d", workerIndex);
+      _freeRuntime(pRuntime);
+      return TMWDEFS_NULL;
+    }
+  }
+
+  for (numStarted = 0; numStarted < numWorkers; numStarted++)
+  {
+    TMWTARGRT_WORKER *pWorker = &pRuntime->pWorkers[numStarted];
+    if (TMW_ThreadCreate(&pWorker->threadId, _workerThread, (TMW_ThreadArg)pWorker, 0, 0) != 0)
+    {
+      LINIODIAG_ERRORMSG("runtime: unable to start worker %d", numStarted);
+      break;
+    }
+  }
+
+  /* Wait for the workers to open their channels */
+  pthread_mutex_lock(&pRuntime->openLock);
+  while (pRuntime->numOpened < numStarted)
+  {
+    pthread_cond_wait(&pRuntime->openCond, &pRuntime->openLock);
+  }
+  pthread_mutex_unlock(&pRuntime->openLock);
+
+  if (numStarted < numWorkers)
+  {
+    pRuntime->running = TMWDEFS_FALSE;
+    for (workerIndex = 0; workerIndex < numStarted; workerIndex++)
+    {
+      _wakeWorker(&pRuntime->pWorkers[workerIndex]);
+      pthread_join(pRuntime->pWorkers[workerIndex].threadId, NULL);
+    }
+    _freeRuntime(pRuntime);
+    return TMWDEFS_NULL;
+  }
+
+  return pRuntime;
+}
+
+/* function: tmwtargrt_stop */
+void TMWDEFS_GLOBAL tmwtargrt_stop(
+  TMWTARGRT *pRuntime)
+{
+  int workerIndex;
+
+  pRuntime->running = TMWDEFS_FALSE;
+  for (workerIndex = 0; workerIndex < pRuntime->numWorkers; workerIndex++)
+  {
+    _wakeWorker(&pRuntime->pWorkers[workerIndex]);
+  }
+  for (workerIndex = 0; workerIndex < pRuntime->numWorkers; workerIndex++)
+  {
+    pthread_join(pRuntime->pWorkers[workerIndex].threadId, NULL);
+  }
+  _freeRuntime(pRuntime);
+}
+
+/* function: tmwtargrt_getChannel */
+TMWCHNL * TMWDEFS_GLOBAL tmwtargrt_getChannel(
+  TMWTARGRT *pRuntime,
+  int channelIndex)
+{
+  if ((channelIndex < 0) || (channelIndex >= pRuntime->numChannels))
+    return TMWDEFS_NULL;
+
+  return pRuntime->ppChannels[channelIndex];
+}
+
+/* function: tmwtargrt_submit */
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargrt_submit(
+  TMWTARGRT *pRuntime,
+  int channelIndex,
+  TMWTARGRT_SUBMIT_FUNC pFunc,
+  void *pParam)
+{
+  TMWTARGRT_WORKER *pWorker;
+  int               queueSize = pRuntime->config.submitQueueSize;
+  int               tail;
+
+  if ((channelIndex < 0) || (channelIndex >= pRuntime->numChannels))
+    return TMWDEFS_FALSE;
+
+  pWorker = &pRuntime->pWorkers[channelIndex % pRuntime->numWorkers];
+
+  TMWTARG_LOCK_SECTION(&pWorker->submitLock);
+  if (pWorker->submitCount == queueSize)
+  {
+    TMWTARG_UNLOCK_SECTION(&pWorker->submitLock);
+    return TMWDEFS_FALSE;
+  }
+  tail = (pWorker->submitHead + pWorker->submitCount) % queueSize;
+  pWorker->pSubmitQueue[tail].pFunc = pFunc;
+  pWorker->pSubmitQueue[tail].pParam = pParam;
+  pWorker->pSubmitQueue[tail].channelIndex = channelIndex;
+  pWorker->submitCount++;
+  TMWTARG_UNLOCK_SECTION(&pWorker->submitLock);
+
+  _wakeWorker(pWorker);
+  return TMWDEFS_TRUE;
+}
+
+/* function: tmwtargrt_attachChannel */
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargrt_attachChannel(
+  TMWTARG_IO_CHANNEL *pTargIoChannel)
+{
+  TMWTARGRT_WORKER *pWorker = _pCurrentWorker;
+  TMWTARGRT_SLOT   *pSlot;
+
+  if (pWorker == TMWDEFS_NULL)
+    return TMWDEFS_FALSE;
+
+  pSlot = (TMWTARGRT_SLOT *)calloc(1, sizeof(TMWTARGRT_SLOT));
+  if ((pSlot == NULL) || !_reserveSlots(pWorker, pWorker->numSlots + 1))
+  {
+    LINIODIAG_ERRORMSG("runtime: worker %d unable to add channel", pWorker->index);
+    free(pSlot);
+    return TMWDEFS_FALSE;
+  }
+
+  /* The descriptors are registered at the end of the current pass, */
+  /* once the channel has been opened.                              */
+  pSlot->pWorker = pWorker;
+  pSlot->pTargIoChannel = pTargIoChannel;
+  pSlot->numFds = -1;
+  pWorker->ppSlots[pWorker->numSlots++] = pSlot;
+  pWorker->ppNew[pWorker->numNew++] = pSlot;
+  pTargIoChannel->pWorkerContext = pSlot;
+  return TMWDEFS_TRUE;
+}
+
+/* function: tmwtargrt_onWorkerThread */
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargrt_onWorkerThread(
+  TMWTARG_IO_CHANNEL *pTargIoChannel)
+{
+  TMWTARGRT_SLOT *pSlot = (TMWTARGRT_SLOT *)pTargIoChannel->pWorkerContext;
+
+  return (TMWTYPES_BOOL)((_pCurrentWorker != TMWDEFS_NULL)
+    && (pSlot != TMWDEFS_NULL) && (pSlot->pWorker == _pCurrentWorker));
+}
+
+/* function: tmwtargrt_detachChannel */
+void TMWDEFS_GLOBAL tmwtargrt_detachChannel(
+  TMWTARG_IO_CHANNEL *pTargIoChannel)
+{
+  TMWTARGRT_SLOT *pSlot = (TMWTARGRT_SLOT *)pTargIoChannel->pWorkerContext;
+
+  if (pSlot == TMWDEFS_NULL)
+    return;
+
+  /* The slot is cleared rather than freed since the worker may be part */
+  /* way through a list of slots or events that refer to it.            */
+  _unregisterSlot(pSlot->pWorker, pSlot);
+  pSlot->pTargIoChannel = TMWDEFS_NULL;
+  pSlot->pWorker->slotRemoved = TMWDEFS_TRUE;
+  pTargIoChannel->pWorkerContext = TMWDEFS_NULL;
+}
+
+#endif /* TMWTARGRT_SUPPORTED */
@@ -0,0 +1,230 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 2008-2011 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+
+/* file: tmwtargrt.h
+ * description: Runtime that drives many channels from a fixed pool of
+ *  worker threads on Linux.
+ *
+ *  Normally LinIoTarg starts a thread per channel. For a process serving
+ *  hundreds or thousands of sessions that is a lot of threads, so the
+ *  runtime instead spreads the channels over a small number of workers,
+ *  typically one per CPU. Each worker has its own application context,
+ *  opens its channels, and then waits on all of their descriptors and
+ *  timer queues at once, processing received data and expired timers for
+ *  its channels. The descriptors are kept registered with an epoll
+ *  instance per worker and only updated for channels that ran, so a
+ *  wakeup costs the number of channels with activity rather than the
+ *  number on the worker. Since every channel is only ever processed on
+ *  its own worker, other threads hand work such as adding events to a
+ *  channel's worker with tmwtargrt_submit rather than calling into the
+ *  SCL directly.
+ *
+ *  The runtime requires TMWCNFG_SUPPORT_THREADS and
+ *  TMWCNFG_MULTIPLE_TIMER_QS so each channel has its own timer queue that
+ *  its worker can service.
+ */
+#ifndef tmwtargrt_DEFINED
+#define tmwtargrt_DEFINED
+
+#include "tmwtargcnfg.h"
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwappl.h"
+#include "tmwscl/utils/tmwchnl.h"
+
+#define TMWTARGRT_SUPPORTED \
+  (TMWCNFG_SUPPORT_THREADS && TMWCNFG_MULTIPLE_TIMER_QS && TMWTARG_SUPPORT_POLL)
+
+#if TMWTARGRT_SUPPORTED
+
+/* Runtime configuration */
+typedef struct TmwTargRtConfig {
+  /* Number of worker threads, 0 starts one per online CPU. No more
+   * workers are started than there are channels.
+   */
+  int                   numWorkers;
+
+  /* If TMWDEFS_TRUE worker N is bound to CPU (firstCpu + N) modulo
+   * the number of online CPUs.
+   */
+  TMWTYPES_BOOL         setAffinity;
+  int                   firstCpu;
+
+  /* Number of functions that can be waiting in each worker's submit
+   * queue. tmwtargrt_submit fails when the queue is full.
+   */
+  int                   submitQueueSize;
+
+  /* Longest a worker waits without IO or timer activity, in milliseconds,
+   * after which every channel's check input function is called. The
+   * default of 0 waits until a descriptor or timer is ready, since
+   * channels retry connecting from their open channel timers.
+   */
+  TMWTYPES_MILLISECONDS idleWait;
+} TMWTARGRT_CONFIG;
+
+/* Opaque runtime context */
+typedef struct TmwTargRt TMWTARGRT;
+
+/* Called on a worker thread to open channel channelIndex, and its
+ * sessions, on that worker's application context. Returns the channel,
+ * or TMWDEFS_NULL if it could not be opened.
+ */
+typedef TMWCHNL *(*TMWTARGRT_OPEN_FUNC)(
+  void *pParam,
+  TMWAPPL *pApplContext,
+  int channelIndex);
+
+/* Called on a worker thread when the runtime is stopped to close
+ * channel channelIndex and its sessions.
+ */
+typedef void (*TMWTARGRT_CLOSE_FUNC)(
+  void *pParam,
+  TMWCHNL *pChannel,
+  int channelIndex);
+
+/* Function run on a channel's worker thread by tmwtargrt_submit */
+typedef void (*TMWTARGRT_SUBMIT_FUNC)(
+  void *pParam);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* function: tmwtargrt_initConfig
+* purpose: Initialize a runtime configuration structure to default values.
+* arguments :
+*  pConfig - pointer to the runtime configuration structure
+* returns :
+*  void
+*/
+TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwtargrt_initConfig(
+  TMWTARGRT_CONFIG *pConfig);
+
+/* function: tmwtargrt_start
+* purpose: Start the worker threads and open numChannels channels on them.
+*  Channel N is opened by worker N modulo the number of workers, by calling
+*  pOpenFunc on that worker's thread. Any IO channel opened from a worker
+*  thread is driven by that worker instead of by a thread of its own.
+*  This does not return until every worker has opened its channels.
+* arguments :
+*  pConfig - runtime configuration
+*  numChannels - number of channels to open
+*  pOpenFunc - function that opens a channel
+*  pCloseFunc - function that closes a channel, may be TMWDEFS_NULL
+*  pParam - parameter passed to pOpenFunc and pCloseFunc
+* returns :
+*  runtime context, or TMWDEFS_NULL on failure
+*/
+TMWDEFS_SCL_API TMWTARGRT * TMWDEFS_GLOBAL tmwtargrt_start(
+  const TMWTARGRT_CONFIG *pConfig,
+  int numChannels,
+  TMWTARGRT_OPEN_FUNC pOpenFunc,
+  TMWTARGRT_CLOSE_FUNC pCloseFunc,
+  void *pParam);
+
+/* function: tmwtargrt_stop
+* purpose: Close all channels on their workers, stop the worker threads
+*  and free the runtime.
+* arguments :
+*  pRuntime - runtime context returned by tmwtargrt_start
+* returns :
+*  void
+*/
+TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwtargrt_stop(
+  TMWTARGRT *pRuntime);
+
+/* function: tmwtargrt_getChannel
+* purpose: Get the channel opened for channelIndex.
+* arguments :
+*  pRuntime - runtime context returned by tmwtargrt_start
+*  channelIndex - index passed to the open function
+* returns :
+*  channel, or TMWDEFS_NULL if it was not opened
+*/
+TMWDEFS_SCL_API TMWCHNL * TMWDEFS_GLOBAL tmwtargrt_getChannel(
+  TMWTARGRT *pRuntime,
+  int channelIndex);
+
+/* function: tmwtargrt_submit
+* purpose: Run pFunc(pParam) on the worker thread that owns channel
+*  channelIndex. This may be called from any thread. Functions submitted
+*  for the same worker run in the order they were submitted.
+* arguments :
+*  pRuntime - runtime context returned by tmwtargrt_start
+*  channelIndex - index of the channel the function operates on
+*  pFunc - function to run
+*  pParam - parameter passed to pFunc
+* returns :
+*  TMWDEFS_TRUE if queued, TMWDEFS_FALSE if the worker's queue is full
+*/
+TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargrt_submit(
+  TMWTARGRT *pRuntime,
+  int channelIndex,
+  TMWTARGRT_SUBMIT_FUNC pFunc,
+  void *pParam);
+
+/* function: tmwtargrt_attachChannel
+* purpose: INTERNAL FUNCTION called by tmwtarg_initChannel. If called on
+*  a worker thread, make that worker responsible for the IO channel.
+* arguments :
+*  pTargIoChannel - IO channel being initialized
+* returns :
+*  TMWDEFS_TRUE if a worker will drive the channel
+*/
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargrt_attachChannel(
+  TMWTARG_IO_CHANNEL *pTargIoChannel);
+
+/* function: tmwtargrt_onWorkerThread
+* purpose: INTERNAL FUNCTION, tells whether the calling thread is the
+*  worker driving an IO channel.
+* arguments :
+*  pTargIoChannel - IO channel
+* returns :
+*  TMWDEFS_TRUE if called on the channel's worker thread
+*/
+TMWTYPES_BOOL TMWDEFS_GLOBAL tmwtargrt_onWorkerThread(
+  TMWTARG_IO_CHANNEL *pTargIoChannel);
+
+/* function: tmwtargrt_detachChannel
+* purpose: INTERNAL FUNCTION called by tmwtarg_deleteChannel to remove
+*  an IO channel from its worker.
+* arguments :
+*  pTargIoChannel - IO channel being deleted
+* returns :
+*  void
+*/
+void TMWDEFS_GLOBAL tmwtargrt_detachChannel(
+  TMWTARG_IO_CHANNEL *pTargIoChannel);
+
+#ifdef __cplusplus
+}
+;
+#endif
+
+#endif /* TMWTARGRT_SUPPORTED */
+
+#endif /* tmwtargrt_DEFINED */
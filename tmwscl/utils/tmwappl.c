@@ -69,6 +69,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwappl_internalInit(void)
 TMWTYPES_BOOL TMWDEFS_GLOBAL tmwappl_initSCL(void)
 {
   TMWTARG_LOCK_INIT(&sclInitlock);
+#if TMWCNFG_SUPPORT_METRICS
+  tmwmetr_init();
+#endif
   if (sclInitlock)
   {
     return(TMWDEFS_TRUE);
@@ -98,6 +101,10 @@ TMWAPPL * TMWDEFS_GLOBAL tmwappl_initApplication(void)
     /* Initialize memory management module */
     if(!tmwmem_init(TMWDEFS_NULL))
       return(TMWDEFS_NULL);
+
+#if TMWCNFG_SUPPORT_METRICS
+    tmwmetr_init();
+#endif
   }
   if (sclInitlock)
     TMWTARG_UNLOCK_SECTION(&sclInitlock);
@@ -94,12 +94,19 @@ void TMWDEFS_GLOBAL tmwchnl_initChannel(
   /* If multiple timer support, initialize per channel timer queue */
   tmwtimer_initMultiTimer(pChannel);
 #endif
+
+#if TMWCNFG_SUPPORT_METRICS
+  tmwmetr_initChannel(&pChannel->metrics);
+#endif
 }
 
 /* function: tmwchnl_deleteChannel */
 void TMWDEFS_GLOBAL tmwchnl_deleteChannel(
   TMWCHNL *pChannel)
 {
+#if TMWCNFG_SUPPORT_METRICS
+  tmwmetr_deleteChannel(&pChannel->metrics);
+#endif
 #if TMWCNFG_MULTIPLE_TIMER_QS
   if (tmwtarg_deleteMultiTimer(pChannel))
   {
@@ -150,12 +157,73 @@ void TMWDEFS_GLOBAL tmwchnl_setStatCallback(
   pChannel->pStatCallbackParam = pCallbackParam;
 }
 
+#if TMWCNFG_SUPPORT_METRICS
+/* function: _updateMetrics
+ * purpose: Update the channel metrics for a statistics event
+ * arguments:
+ *  pChannel - channel the event occurred on
+ *  eventType - statistics event
+ *  pEventData - event specific data
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _updateMetrics(
+  TMWCHNL *pChannel,
+  TMWCHNL_STAT_EVENT eventType,
+  void *pEventData)
+{
+  TMWMETR_CHANNEL *pMetrics = &pChannel->metrics;
+
+  switch(eventType)
+  {
+  case TMWCHNL_STAT_ERROR:
+    {
+      TMWCHNL_STAT_ERROR_TYPE *pError = (TMWCHNL_STAT_ERROR_TYPE *)pEventData;
+      if((pError != TMWDEFS_NULL) && ((TMWTYPES_UINT)pError->errorCode < TMWMETR_NUM_ERRORS))
+      {
+        TMWMETR_INC(pMetrics->errors[pError->errorCode]);
+      }
+    }
+    break;
+  case TMWCHNL_STAT_OPEN:
+    TMWMETR_SET(pMetrics->open, 1);
+    break;
+  case TMWCHNL_STAT_CLOSED:
+    TMWMETR_SET(pMetrics->open, 0);
+    break;
+  case TMWCHNL_STAT_BYTES_SENT:
+    TMWMETR_ADD(pMetrics->bytesSent, *(TMWTYPES_USHORT *)pEventData);
+    break;
+  case TMWCHNL_STAT_BYTES_RECEIVED:
+    TMWMETR_ADD(pMetrics->bytesReceived, *(TMWTYPES_USHORT *)pEventData);
+    break;
+  case TMWCHNL_STAT_FRAME_SENT:
+    TMWMETR_INC(pMetrics->framesSent);
+    break;
+  case TMWCHNL_STAT_FRAME_RECEIVED:
+    TMWMETR_INC(pMetrics->framesReceived);
+    break;
+  case TMWCHNL_STAT_FRAGMENT_SENT:
+    TMWMETR_INC(pMetrics->fragmentsSent);
+    break;
+  case TMWCHNL_STAT_FRAGMENT_RECEIVED:
+    TMWMETR_INC(pMetrics->fragmentsReceived);
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 /* function: tmwchnl_callStatCallback */
 void TMWDEFS_GLOBAL tmwchnl_callStatCallback(
   TMWCHNL *pChannel,
   TMWCHNL_STAT_EVENT eventType,
   void *pEventData)
 {
+#if TMWCNFG_SUPPORT_METRICS
+  _updateMetrics(pChannel, eventType, pEventData);
+#endif
   if(pChannel->pStatCallbackFunc != TMWDEFS_NULL)
   {
     pChannel->pStatCallbackFunc(
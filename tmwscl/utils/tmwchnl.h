@@ -40,6 +40,7 @@
 #include "tmwscl/utils/tmwtprt.h"
 #include "tmwscl/utils/tmwappl.h"
 #include "tmwscl/utils/tmwdtime.h"
+#include "tmwscl/utils/tmwmetr.h"
 #include "tmwtargos.h"  /* TMWDEFS_RESOURCE_LOCK */
 #endif
 
@@ -320,6 +321,11 @@ typedef struct TMWChannelStruct {
 
   /* Diagnostic mask */
   TMWTYPES_ULONG chnlDiagMask;
+
+#if TMWCNFG_SUPPORT_METRICS
+  /* Runtime metrics */
+  TMWMETR_CHANNEL metrics;
+#endif
 } TMWCHNL;
 
 #if TMWCNFG_SUPPORT_STATS
@@ -79,6 +79,14 @@
  */
 #define TMWCNFG_SUPPORT_STATS         TMWDEFS_TRUE
 
+/* TMWCNFG_SUPPORT_METRICS keeps counters and latency histograms for each
+ * channel and session, updated at the same points that generate the
+ * statistical information above, that can be read at any time in the
+ * Prometheus text format with tmwmetr_snapshot. Requires
+ * TMWCNFG_SUPPORT_STATS.
+ */
+#define TMWCNFG_SUPPORT_METRICS       TMWDEFS_TRUE
+
 /* Define whether or not single and/or double precision floating point 
  * support should be included. 
  *
@@ -139,7 +147,9 @@
  * to TMWDEFS_TRUE will create separate queues and require multiple system 
  * timers through a call to tmwtarg_setMultiTimer().
  */
+#ifndef TMWCNFG_MULTIPLE_TIMER_QS
 #define TMWCNFG_MULTIPLE_TIMER_QS     TMWDEFS_FALSE
+#endif
 
 /* Define whether database processing should be performed asynchronous
  * to the rest of the TMW SCL processing in Master SCLs. This parameter is
@@ -157,6 +167,14 @@
 #define TMWCNFG_SUPPORT_ASYNCH_DB     TMWDEFS_TRUE
 #endif
 
+/* Size of the asynchronous database entries preallocated by tmwdb_init when
+ * the target supports TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE. Larger entries are
+ * allocated with tmwtarg_alloc.
+ */
+#ifndef TMWCNFG_ASYNCH_DB_ENTRY_SIZE
+#define TMWCNFG_ASYNCH_DB_ENTRY_SIZE  128
+#endif
+
 /* If this parameter is set to TMWDEFS_TRUE the TMW SCL will use a simulated
  * database. Define this to TMWDEFS_FALSE to remove all references to the
  * simulated database.
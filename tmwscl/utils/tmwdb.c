@@ -34,11 +34,89 @@
 
 #if TMWCNFG_SUPPORT_ASYNCH_DB
 
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+#ifndef TMWTARG_MEMORY_BARRIER
+#error TMWTARG_MEMORY_BARRIER must be defined in tmwtargos.h to support TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+#endif
+#ifndef TMWTARG_COMPARE_AND_SWAP
+#error TMWTARG_COMPARE_AND_SWAP must be defined in tmwtargos.h to support TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+#endif
+#ifndef TMWTARG_ATOMIC_ADD
+#error TMWTARG_ATOMIC_xxx must be defined in tmwtargos.h to support TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+#endif
+#ifndef TMWTARG_YIELD
+#error TMWTARG_YIELD must be defined in tmwtargos.h to support TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+#endif
+
+/* Keep the positions the producers and the consumer update on separate
+ * cache lines
+ */
+#define TMWDB_CACHE_LINE 64
+
+/* Times tmwdb_allocData waits for an entry being returned to the pool
+ * before allocating one
+ */
+#define TMWDB_ALLOC_TRIES 8
+
+/* Preallocated entries, rounded up so each one is aligned for any type */
+#define TMWDB_ENTRY_SIZE \
+  ((TMWCNFG_ASYNCH_DB_ENTRY_SIZE + sizeof(TMWTYPES_DOUBLE) - 1) & ~(sizeof(TMWTYPES_DOUBLE) - 1))
+
+/* A cell of a ring. Position pos may be pushed into the cell when its
+ * sequence is pos and popped from it when its sequence is pos + 1. A pop
+ * sets the sequence to pos + capacity, handing the cell to the push one
+ * lap later.
+ */
+typedef struct TMWDbCell
+{
+  volatile TMWTYPES_ULONG sequence;
+  void *pEntry;
+} TMWDB_CELL;
+
+/* Bounded ring of entry pointers that any number of threads can push to
+ * and pop from without a lock
+ */
+typedef struct TMWDbRing
+{
+  TMWDB_CELL *pCells;
+  TMWTYPES_ULONG mask;
+  TMWTYPES_UCHAR pad1[TMWDB_CACHE_LINE];
+  volatile TMWTYPES_ULONG pushPos;
+  TMWTYPES_UCHAR pad2[TMWDB_CACHE_LINE];
+  volatile TMWTYPES_ULONG popPos;
+  TMWTYPES_UCHAR pad3[TMWDB_CACHE_LINE];
+} TMWDB_RING;
+#endif
+
 typedef struct TMWDbQueue
 {
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  /* Entries waiting to be stored */
+  TMWDB_RING ring;
+
+  /* Preallocated entries that are free. There are twice as many as the
+   * ring holds, so threads still have entries to fill while it is full.
+   */
+  TMWDB_RING pool;
+  TMWTYPES_UCHAR *pEntries;
+  TMWTYPES_ULONG numEntries;
+
+  /* Entries taken from the pool and not returned yet. tmwdb_destroy keeps
+   * pEntries while this is not zero, so the entries can still be returned
+   * and the last one returned frees them.
+   */
+  volatile TMWTYPES_ULONG outstanding;
+
+  /* Entries removed from the ring by tmwdb_closeDatabase that the
+   * consumer has not skipped yet
+   */
+  TMWTYPES_ULONG removed;
+#else
   TMWDLIST data;
+#endif
   TMWTYPES_UINT maxSize;
-  TMWTYPES_BOOL overLimit;
+  volatile TMWTYPES_BOOL overLimit;
+  TMWDB_STATS stats;
 #if TMWCNFG_SUPPORT_THREADS
   TMWDEFS_RESOURCE_LOCK lock;
 #endif
@@ -46,17 +124,372 @@ typedef struct TMWDbQueue
 
 static TMWDB_QUEUE _tmwdbQueue;
 
+/* Counters updated by several threads, see tmwmetr.h */
+#ifdef TMWTARG_ATOMIC_ADD
+#define TMWDB_STAT_ADD(value, amount) TMWTARG_ATOMIC_ADD(&(value), (amount))
+#define TMWDB_STAT_GET(value)         TMWTARG_ATOMIC_LOAD(&(value))
+#else
+#define TMWDB_STAT_ADD(value, amount) ((value) += (amount))
+#define TMWDB_STAT_GET(value)         (value)
+#endif
+
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+/* function: _ringInit */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _ringInit(
+  TMWDB_RING *pRing,
+  TMWTYPES_ULONG capacity)
+{
+  TMWTYPES_ULONG i;
+
+  pRing->pCells = (TMWDB_CELL *)tmwtarg_alloc((TMWTYPES_UINT)(capacity * sizeof(TMWDB_CELL)));
+  if(pRing->pCells == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  for(i = 0; i < capacity; i++)
+  {
+    pRing->pCells[i].sequence = i;
+    pRing->pCells[i].pEntry = TMWDEFS_NULL;
+  }
+  pRing->mask = capacity - 1;
+  pRing->pushPos = 0;
+  pRing->popPos = 0;
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _ringPush
+ *  Push an entry unless the ring already holds limit entries. Returns
+ *  TMWDEFS_FALSE if the ring is full.
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _ringPush(
+  TMWDB_RING *pRing,
+  void *pEntry,
+  TMWTYPES_ULONG limit)
+{
+  TMWTYPES_ULONG pos = TMWTARG_ATOMIC_LOAD(&pRing->pushPos);
+
+  for(;;)
+  {
+    TMWDB_CELL *pCell = &pRing->pCells[pos & pRing->mask];
+    TMWTYPES_LONG diff = (TMWTYPES_LONG)(TMWTARG_ATOMIC_LOAD(&pCell->sequence) - pos);
+
+    if(diff == 0)
+    {
+      if((TMWTYPES_ULONG)(pos - TMWTARG_ATOMIC_LOAD(&pRing->popPos)) >= limit)
+        return(TMWDEFS_FALSE);
+
+      if(TMWTARG_COMPARE_AND_SWAP(&pRing->pushPos, pos, pos + 1))
+      {
+        pCell->pEntry = pEntry;
+
+        /* Publish the entry before handing the cell to the consumer */
+        TMWTARG_MEMORY_BARRIER();
+        TMWTARG_ATOMIC_STORE(&pCell->sequence, pos + 1);
+        return(TMWDEFS_TRUE);
+      }
+
+      /* Another producer took this position */
+      TMWDB_STAT_ADD(_tmwdbQueue.stats.contended, 1);
+    }
+    else if(diff < 0)
+    {
+      /* The cell still holds the entry pushed one lap ago */
+      return(TMWDEFS_FALSE);
+    }
+
+    pos = TMWTARG_ATOMIC_LOAD(&pRing->pushPos);
+  }
+}
+
+/* function: _ringPop
+ *  Pop the oldest entry, returns TMWDEFS_FALSE if the ring is empty
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _ringPop(
+  TMWDB_RING *pRing,
+  void **ppEntry)
+{
+  TMWTYPES_ULONG pos = TMWTARG_ATOMIC_LOAD(&pRing->popPos);
+
+  for(;;)
+  {
+    TMWDB_CELL *pCell = &pRing->pCells[pos & pRing->mask];
+    TMWTYPES_LONG diff = (TMWTYPES_LONG)(TMWTARG_ATOMIC_LOAD(&pCell->sequence) - (pos + 1));
+
+    if(diff == 0)
+    {
+      if(TMWTARG_COMPARE_AND_SWAP(&pRing->popPos, pos, pos + 1))
+      {
+        *ppEntry = pCell->pEntry;
+
+        /* Read the entry before handing the cell back to the producers */
+        TMWTARG_MEMORY_BARRIER();
+        TMWTARG_ATOMIC_STORE(&pCell->sequence, pos + pRing->mask + 1);
+        return(TMWDEFS_TRUE);
+      }
+    }
+    else if(diff < 0)
+    {
+      return(TMWDEFS_FALSE);
+    }
+
+    pos = TMWTARG_ATOMIC_LOAD(&pRing->popPos);
+  }
+}
+
+/* function: _isPoolEntry */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _isPoolEntry(
+  void *pEntry)
+{
+  TMWTYPES_UCHAR *pByte = (TMWTYPES_UCHAR *)pEntry;
+
+  return((TMWTYPES_BOOL)((_tmwdbQueue.pEntries != TMWDEFS_NULL)
+    && (pByte >= _tmwdbQueue.pEntries)
+    && (pByte < _tmwdbQueue.pEntries + _tmwdbQueue.numEntries * TMWDB_ENTRY_SIZE)));
+}
+
+/* function: _releaseEntry
+ *  Count an entry returned after tmwdb_destroy. Returns TMWDEFS_TRUE if
+ *  it was the last one outstanding.
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _releaseEntry(void)
+{
+  TMWTYPES_ULONG outstanding;
+
+  do
+  {
+    outstanding = TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.outstanding);
+  } while(!TMWTARG_COMPARE_AND_SWAP(&_tmwdbQueue.outstanding, outstanding, outstanding - 1));
+
+  return((TMWTYPES_BOOL)(outstanding == 1));
+}
+
+/* function: _addEntry */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _addEntry(
+  TMWDB_DATA *pData)
+{
+  TMWTYPES_ULONG size;
+  TMWTYPES_ULONG highWater;
+
+  if(_tmwdbQueue.ring.pCells == TMWDEFS_NULL)
+    return(TMWDEFS_FALSE);
+
+  if(!_ringPush(&_tmwdbQueue.ring, pData, _tmwdbQueue.maxSize))
+    return(TMWDEFS_FALSE);
+
+  size = TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.ring.pushPos) - TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.ring.popPos);
+  highWater = TMWDB_STAT_GET(_tmwdbQueue.stats.highWater);
+  while((size > highWater)
+    && !TMWTARG_COMPARE_AND_SWAP(&_tmwdbQueue.stats.highWater, highWater, size))
+  {
+    highWater = TMWDB_STAT_GET(_tmwdbQueue.stats.highWater);
+  }
+
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _getEntry
+ *  Remove the oldest entry, called with the queue locked
+ */
+static TMWDB_DATA * TMWDEFS_LOCAL _getEntry(void)
+{
+  void *pEntry;
+
+  if(_tmwdbQueue.ring.pCells == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  while(_ringPop(&_tmwdbQueue.ring, &pEntry))
+  {
+    if(pEntry != TMWDEFS_NULL)
+      return((TMWDB_DATA *)pEntry);
+
+    /* Removed by tmwdb_closeDatabase */
+    _tmwdbQueue.removed--;
+  }
+
+  return(TMWDEFS_NULL);
+}
+
+/* function: _removeDatabase
+ *  Remove the entries of a database, called with the queue locked. The
+ *  entries are left in the ring as null pointers that _getEntry skips.
+ *  Every position claimed before this is called is checked, waiting for
+ *  a producer that has claimed a position but not yet stored its entry.
+ */
+static void TMWDEFS_LOCAL _removeDatabase(
+  void *pDbHandle)
+{
+  TMWDB_RING *pRing = &_tmwdbQueue.ring;
+  TMWTYPES_ULONG pos;
+  TMWTYPES_ULONG end;
+
+  if(pRing->pCells == TMWDEFS_NULL)
+    return;
+
+  pos = TMWTARG_ATOMIC_LOAD(&pRing->popPos);
+  end = TMWTARG_ATOMIC_LOAD(&pRing->pushPos);
+  while(pos != end)
+  {
+    TMWDB_CELL *pCell = &pRing->pCells[pos & pRing->mask];
+    TMWDB_DATA *pData;
+
+    /* The producer stores the entry right after claiming the position */
+    while(TMWTARG_ATOMIC_LOAD(&pCell->sequence) != pos + 1)
+      TMWTARG_YIELD();
+    TMWTARG_MEMORY_BARRIER();
+
+    pData = (TMWDB_DATA *)pCell->pEntry;
+    if((pData != TMWDEFS_NULL) && (pData->pDbHandle == pDbHandle))
+    {
+      pCell->pEntry = TMWDEFS_NULL;
+      _tmwdbQueue.removed++;
+      tmwdb_freeData(pData);
+    }
+    pos++;
+  }
+}
+
+/* function: _getSize */
+static TMWTYPES_UINT TMWDEFS_LOCAL _getSize(void)
+{
+  TMWTYPES_ULONG size = TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.ring.popPos);
+
+  size = TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.ring.pushPos) - size;
+  if(size < _tmwdbQueue.removed)
+    return(0);
+
+  return((TMWTYPES_UINT)(size - _tmwdbQueue.removed));
+}
+
+#else
+/* function: _addEntry
+ *  Called with the queue locked
+ */
+static TMWTYPES_BOOL TMWDEFS_LOCAL _addEntry(
+  TMWDB_DATA *pData)
+{
+  if(tmwdlist_size(&_tmwdbQueue.data) >= _tmwdbQueue.maxSize)
+    return(TMWDEFS_FALSE);
+
+  tmwdlist_addEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData);
+  _tmwdbQueue.stats.added++;
+  if(tmwdlist_size(&_tmwdbQueue.data) > _tmwdbQueue.stats.highWater)
+    _tmwdbQueue.stats.highWater = tmwdlist_size(&_tmwdbQueue.data);
+
+  return(TMWDEFS_TRUE);
+}
+
+/* function: _getEntry
+ *  Remove the oldest entry, called with the queue locked
+ */
+static TMWDB_DATA * TMWDEFS_LOCAL _getEntry(void)
+{
+  TMWDB_DATA *pData = (TMWDB_DATA *)tmwdlist_getFirst(&_tmwdbQueue.data);
+
+  if(pData != TMWDEFS_NULL)
+  {
+    if(!tmwdlist_removeEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData))
+    {
+      TMWDIAG_ERROR("tmwdb_storeEntry: Error Removing Item from DataBase Queue");
+      return(TMWDEFS_NULL);
+    }
+  }
+
+  return(pData);
+}
+
+/* function: _removeDatabase
+ *  Remove the entries of a database, called with the queue locked
+ */
+static void TMWDEFS_LOCAL _removeDatabase(
+  void *pDbHandle)
+{
+  TMWDB_DATA *pData = (TMWDB_DATA *)tmwdlist_getFirst(&_tmwdbQueue.data);
+
+  while (pData != TMWDEFS_NULL)
+  {
+    TMWDB_DATA *pNextData = (TMWDB_DATA *)
+      tmwdlist_getAfter(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData);
+
+    if (pData->pDbHandle == pDbHandle)
+    {
+      if (tmwdlist_removeEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData))
+      {
+        tmwdb_freeData(pData);
+      }
+      else
+      {
+        TMWDIAG_ERROR("tmwdb_closeDatabase: Error Removing Item from DataBase Queue");
+      }
+    }
+
+    pData = pNextData;
+  }
+}
+
+/* function: _getSize */
+static TMWTYPES_UINT TMWDEFS_LOCAL _getSize(void)
+{
+  return(tmwdlist_size(&_tmwdbQueue.data));
+}
+#endif /* TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE */
+
 /* function: tmwdb_init */
 void TMWDEFS_GLOBAL tmwdb_init(
   TMWTYPES_UINT maxSize)
 {
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  TMWTYPES_ULONG capacity = 1;
+  TMWTYPES_ULONG i;
+#endif
+
   /* Lock database queue */
   TMWTARG_LOCK_INIT(&_tmwdbQueue.lock);
   TMWTARG_LOCK_SECTION(&_tmwdbQueue.lock);
 
   _tmwdbQueue.maxSize = maxSize;
   _tmwdbQueue.overLimit = TMWDEFS_FALSE;
+  memset(&_tmwdbQueue.stats, 0, sizeof(_tmwdbQueue.stats));
+
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  /* The ring holds a power of 2 entries, so positions wrap around it */
+  while((capacity < maxSize) && (capacity < 0x40000000UL))
+    capacity <<= 1;
+
+  _tmwdbQueue.removed = 0;
+  _tmwdbQueue.pool.pCells = TMWDEFS_NULL;
+  if(!_ringInit(&_tmwdbQueue.ring, capacity))
+  {
+    TMWDIAG_ERROR("tmwdb_init: Error allocating database queue");
+    _tmwdbQueue.maxSize = 0;
+  }
+  else if(_tmwdbQueue.pEntries != TMWDEFS_NULL)
+  {
+    /* Entries from before the last tmwdb_destroy are still outstanding.
+     * Keep them so they are recognized when returned, and allocate this
+     * queue's entries with tmwtarg_alloc.
+     */
+    TMWDIAG_ERROR("tmwdb_init: Database entries still in use, not preallocating entries");
+  }
+  else if(_ringInit(&_tmwdbQueue.pool, capacity * 2))
+  {
+    /* If the entries cannot be allocated tmwdb_allocData falls back to
+     * tmwtarg_alloc
+     */
+    _tmwdbQueue.outstanding = 0;
+    _tmwdbQueue.pEntries = (TMWTYPES_UCHAR *)tmwtarg_alloc((TMWTYPES_UINT)(capacity * 2 * TMWDB_ENTRY_SIZE));
+    if(_tmwdbQueue.pEntries != TMWDEFS_NULL)
+    {
+      _tmwdbQueue.numEntries = capacity * 2;
+      for(i = 0; i < _tmwdbQueue.numEntries; i++)
+        _ringPush(&_tmwdbQueue.pool, _tmwdbQueue.pEntries + i * TMWDB_ENTRY_SIZE, _tmwdbQueue.numEntries);
+    }
+    else
+    {
+      _tmwdbQueue.numEntries = 0;
+    }
+  }
+#else
   tmwdlist_initialize(&_tmwdbQueue.data);
+#endif
 
   /* Unlock database queue */
   TMWTARG_UNLOCK_SECTION(&_tmwdbQueue.lock);
@@ -65,17 +498,38 @@ void TMWDEFS_GLOBAL tmwdb_init(
 /* function: tmwdb_destroy */
 void TMWDEFS_GLOBAL tmwdb_destroy(void)
 {
-  void *pEntry;
+  TMWDB_DATA *pData;
 
   /* Lock database queue */
   TMWTARG_LOCK_SECTION(&_tmwdbQueue.lock);
 
-  while ((pEntry = tmwdlist_getFirst(&_tmwdbQueue.data)) != TMWDEFS_NULL)
+  while ((pData = _getEntry()) != TMWDEFS_NULL)
   {
-    tmwdlist_removeEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pEntry);
-    tmwtarg_free(pEntry);
+    tmwdb_freeData(pData);
   }
 
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  if(_tmwdbQueue.ring.pCells != TMWDEFS_NULL)
+    tmwtarg_free(_tmwdbQueue.ring.pCells);
+  if(_tmwdbQueue.pool.pCells != TMWDEFS_NULL)
+  {
+    tmwtarg_free(_tmwdbQueue.pool.pCells);
+
+    /* Entries other threads still hold are returned with tmwdb_freeData
+     * later, so the entries are only freed once none are outstanding
+     */
+    if((_tmwdbQueue.pEntries != TMWDEFS_NULL) && (TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.outstanding) == 0))
+    {
+      tmwtarg_free(_tmwdbQueue.pEntries);
+      _tmwdbQueue.pEntries = TMWDEFS_NULL;
+      _tmwdbQueue.numEntries = 0;
+    }
+  }
+  _tmwdbQueue.ring.pCells = TMWDEFS_NULL;
+  _tmwdbQueue.pool.pCells = TMWDEFS_NULL;
+  _tmwdbQueue.maxSize = 0;
+#endif
+
   /* Unlock database queue */
   TMWTARG_UNLOCK_SECTION(&_tmwdbQueue.lock);
   TMWTARG_LOCK_DELETE(&_tmwdbQueue.lock);
@@ -88,6 +542,13 @@ void TMWDEFS_GLOBAL tmwdb_setMaxSize(
   /* Lock database queue */
   TMWTARG_LOCK_SECTION(&_tmwdbQueue.lock);
 
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  /* The ring cannot grow while producers may be using it */
+  if(maxSize > _tmwdbQueue.ring.mask + 1)
+  {
+    TMWDIAG_ERROR("tmwdb_setMaxSize: Size limited to the size given to tmwdb_init");
+  }
+#endif
   _tmwdbQueue.maxSize = maxSize;
 
   /* Unlock database queue */
@@ -105,19 +566,85 @@ void TMWDEFS_GLOBAL tmwdb_initData(
   return;
 }
 
+/* function: tmwdb_allocData */
+void * TMWDEFS_GLOBAL tmwdb_allocData(
+  TMWTYPES_UINT size)
+{
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  TMWDB_RING *pPool = &_tmwdbQueue.pool;
+  TMWTYPES_UINT tries;
+  void *pEntry;
+
+  if((size <= TMWDB_ENTRY_SIZE) && (pPool->pCells != TMWDEFS_NULL) && (_tmwdbQueue.pEntries != TMWDEFS_NULL))
+  {
+    for(tries = 0; tries < TMWDB_ALLOC_TRIES; tries++)
+    {
+      if(_ringPop(pPool, &pEntry))
+      {
+        TMWTARG_ATOMIC_ADD(&_tmwdbQueue.outstanding, 1);
+        return(pEntry);
+      }
+
+      /* Empty, unless a thread returning an entry has taken the next
+       * cell but not filled it yet
+       */
+      if(TMWTARG_ATOMIC_LOAD(&pPool->pushPos) == TMWTARG_ATOMIC_LOAD(&pPool->popPos))
+        break;
+      TMWTARG_YIELD();
+    }
+  }
+#endif
+
+  TMWDB_STAT_ADD(_tmwdbQueue.stats.allocated, 1);
+  return(tmwtarg_alloc(size));
+}
+
+/* function: tmwdb_freeData */
+void TMWDEFS_GLOBAL tmwdb_freeData(
+  void *pData)
+{
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  if(_isPoolEntry(pData))
+  {
+    if(_tmwdbQueue.pool.pCells == TMWDEFS_NULL)
+    {
+      /* Returned after tmwdb_destroy, the last one frees the entries */
+      if(_releaseEntry())
+      {
+        tmwtarg_free(_tmwdbQueue.pEntries);
+        _tmwdbQueue.pEntries = TMWDEFS_NULL;
+        _tmwdbQueue.numEntries = 0;
+      }
+      return;
+    }
+
+    /* The pool has room for every entry, so this only fails while a thread
+     * taking the entry one lap ago has not released its cell yet
+     */
+    while(!_ringPush(&_tmwdbQueue.pool, pData, _tmwdbQueue.numEntries))
+      TMWTARG_YIELD();
+    TMWTARG_ATOMIC_ADD(&_tmwdbQueue.outstanding, -1);
+    return;
+  }
+#endif
+
+  tmwtarg_free(pData);
+}
+
 /* function: tmwdb_addEntry */
 TMWTYPES_BOOL TMWDEFS_GLOBAL tmwdb_addEntry(
   TMWDB_DATA *pData)
 {
   TMWTYPES_BOOL status = TMWDEFS_FALSE;
 
+#if !TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
   /* Lock database queue */
   TMWTARG_LOCK_SECTION(&_tmwdbQueue.lock);
+#endif
 
-  if (tmwdlist_size(&_tmwdbQueue.data) < _tmwdbQueue.maxSize)
+  if (_addEntry(pData))
   {
     _tmwdbQueue.overLimit = TMWDEFS_FALSE;
-    tmwdlist_addEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData);
     status = TMWDEFS_TRUE;
   }
   else
@@ -128,11 +655,14 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwdb_addEntry(
     }
 
     _tmwdbQueue.overLimit = TMWDEFS_TRUE;
+    TMWDB_STAT_ADD(_tmwdbQueue.stats.overflows, 1);
     status = TMWDEFS_FALSE;
   }
 
+#if !TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
   /* Unlock database queue */
   TMWTARG_UNLOCK_SECTION(&_tmwdbQueue.lock);
+#endif
 
   return(status);
 }
@@ -154,21 +684,15 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwdb_storeEntry(
   TMWTARG_UNUSED_PARAM(lockQueue);
 #endif
 
-  pData = (TMWDB_DATA *)tmwdlist_getFirst(&_tmwdbQueue.data);
+  pData = _getEntry();
   if(pData != TMWDEFS_NULL)
   {
-    if (tmwdlist_removeEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData))
-    {
-      /* The queue needs to remain locked to prevent the database being closed 
-       * after the pData was removed but before the store function is executed 
-       */
-      status = pData->pStoreFunc(pData); 
-      tmwtarg_free(pData); 
-    }
-    else
-    {
-      TMWDIAG_ERROR("tmwdb_storeEntry: Error Removing Item from DataBase Queue");
-    }
+    /* The queue needs to remain locked to prevent the database being closed 
+     * after the pData was removed but before the store function is executed 
+     */
+    status = pData->pStoreFunc(pData); 
+    tmwdb_freeData(pData); 
+    TMWDB_STAT_ADD(_tmwdbQueue.stats.stored, 1);
   }
 
 #if TMWCNFG_SUPPORT_THREADS
@@ -182,6 +706,31 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwdb_storeEntry(
   return(status);
 }
 
+/* function: tmwdb_storeEntries */
+TMWTYPES_UINT TMWDEFS_GLOBAL tmwdb_storeEntries(
+  TMWTYPES_UINT maxEntries)
+{
+  TMWTYPES_UINT count = 0;
+  TMWDB_DATA *pData;
+
+  /* Lock database queue */
+  TMWTARG_LOCK_SECTION(&_tmwdbQueue.lock);
+
+  while((count < maxEntries)
+    && ((pData = _getEntry()) != TMWDEFS_NULL))
+  {
+    pData->pStoreFunc(pData);
+    tmwdb_freeData(pData);
+    count++;
+  }
+  TMWDB_STAT_ADD(_tmwdbQueue.stats.stored, count);
+
+  /* Unlock database queue */
+  TMWTARG_UNLOCK_SECTION(&_tmwdbQueue.lock);
+
+  return(count);
+}
+
 /* function: tmwdb_lockQueue */
 TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwdb_lockQueue(void)
 {
@@ -198,39 +747,35 @@ TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwdb_unlockQueue(void)
 TMWTYPES_UINT TMWDEFS_GLOBAL tmwdb_getSize(void)
 {
   TMWTYPES_UINT size;
-  size = tmwdlist_size(&_tmwdbQueue.data);
+  size = _getSize();
   return(size);
 }
 
+/* function: tmwdb_getStats */
+void TMWDEFS_GLOBAL tmwdb_getStats(
+  TMWDB_STATS *pStats)
+{
+#if TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE
+  /* Every push takes one position of the ring */
+  pStats->added = TMWTARG_ATOMIC_LOAD(&_tmwdbQueue.ring.pushPos);
+#else
+  pStats->added = _tmwdbQueue.stats.added;
+#endif
+  pStats->stored = TMWDB_STAT_GET(_tmwdbQueue.stats.stored);
+  pStats->overflows = TMWDB_STAT_GET(_tmwdbQueue.stats.overflows);
+  pStats->highWater = TMWDB_STAT_GET(_tmwdbQueue.stats.highWater);
+  pStats->contended = TMWDB_STAT_GET(_tmwdbQueue.stats.contended);
+  pStats->allocated = TMWDB_STAT_GET(_tmwdbQueue.stats.allocated);
+}
+
 /* function: tmwdb_closeDatabase */
 void TMWDEFS_GLOBAL tmwdb_closeDatabase(
   void *pDbHandle)
 {
-  TMWDB_DATA *pData = TMWDEFS_NULL;
-
   /* Lock database queue */
   TMWTARG_LOCK_SECTION(&_tmwdbQueue.lock);
 
-  pData = (TMWDB_DATA *)tmwdlist_getFirst(&_tmwdbQueue.data);
-  while (pData != TMWDEFS_NULL)
-  {
-    TMWDB_DATA *pNextData = (TMWDB_DATA *)
-      tmwdlist_getAfter(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData);
-
-    if (pData->pDbHandle == pDbHandle)
-    {
-      if (tmwdlist_removeEntry(&_tmwdbQueue.data, (TMWDLIST_MEMBER *)pData))
-      {
-        tmwtarg_free(pData);
-      }
-      else
-      {
-        TMWDIAG_ERROR("tmwdb_closeDatabase: Error Removing Item from DataBase Queue");
-      }
-    }
-
-    pData = pNextData;
-  }
+  _removeDatabase(pDbHandle);
 
   /* Unlock database queue */
   TMWTARG_UNLOCK_SECTION(&_tmwdbQueue.lock);
@@ -26,6 +26,13 @@
 
 /* file: tmwdb.h
  * description: Utilities for managing the TMW database queue
+ *  Channel threads add database updates to the queue and the application
+ *  stores them, usually from a single thread. When the target defines
+ *  TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE the queue is a bounded ring that
+ *  producers add to without taking the queue lock, and entries allocated
+ *  with tmwdb_allocData come from a pool preallocated by tmwdb_init
+ *  instead of the heap. The queue lock then only serializes the threads
+ *  storing entries with the threads closing databases.
  */
 #ifndef TMWDB_DEFINED
 #define TMWDB_DEFINED
@@ -54,6 +61,31 @@ typedef struct TMWDBDataStruct {
   TMWDB_STORE_FUNC pStoreFunc;
 } TMWDB_DATA;
 
+/* Counters of the database queue since tmwdb_init */
+typedef struct TMWDBStatsStruct {
+  /* Entries added to the queue */
+  TMWTYPES_ULONG added;
+
+  /* Entries whose store function was called */
+  TMWTYPES_ULONG stored;
+
+  /* Entries rejected by tmwdb_addEntry because the queue was full */
+  TMWTYPES_ULONG overflows;
+
+  /* Most entries in the queue at once */
+  TMWTYPES_ULONG highWater;
+
+  /* Times a thread adding an entry had to retry because another thread
+   * added one at the same time
+   */
+  TMWTYPES_ULONG contended;
+
+  /* Entries tmwdb_allocData allocated with tmwtarg_alloc because no
+   * preallocated entry was free or large enough
+   */
+  TMWTYPES_ULONG allocated;
+} TMWDB_STATS;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -74,6 +106,12 @@ extern "C" {
    * purpose: Destroy the entire database queue
    *  removing all of the entries from the queue. After this is called
    *  the database queue no longer exists.
+   *  This must not be called while other threads are adding entries.
+   *  With TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE, entries allocated with
+   *  tmwdb_allocData that another thread still holds may be freed with
+   *  tmwdb_freeData after this returns. The preallocated entries are not
+   *  freed until the last of them is, and until then tmwdb_init does not
+   *  preallocate new ones.
    * argments:
    *  void
    * returns:
@@ -82,7 +120,9 @@ extern "C" {
   TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwdb_destroy(void);
 
   /* function: tmwdb_setMaxSize 
-   * purpose: Set maximum size of database queue
+   * purpose: Set maximum size of database queue. With
+   *  TMWTARG_SUPPORT_LOCK_FREE_DB_QUEUE the queue can not hold more than
+   *  the maxSize given to tmwdb_init, rounded up to a power of 2.
    * arguments:
    *  maxSize - number of entries to allow on the async database queue.
    * returns:
@@ -107,6 +147,17 @@ extern "C" {
   TMWDEFS_SCL_API TMWTYPES_BOOL TMWDEFS_GLOBAL tmwdb_storeEntry(
     TMWTYPES_BOOL lockQueue);
 
+  /* function: tmwdb_storeEntries
+   * purpose: Read up to maxEntries entries from the database queue and
+   *  call their store functions, locking the queue once for all of them.
+   * arguments:
+   *  maxEntries - most entries to store
+   * returns:
+   *  number of entries stored
+   */
+  TMWDEFS_SCL_API TMWTYPES_UINT TMWDEFS_GLOBAL tmwdb_storeEntries(
+    TMWTYPES_UINT maxEntries);
+
   /* function: tmwdb_lockQueue
    * purpose: lock the asynchronous database queue if multiple threads
    *  are supported.
@@ -138,6 +189,42 @@ extern "C" {
    */
   TMWDEFS_SCL_API TMWTYPES_UINT TMWDEFS_GLOBAL tmwdb_getSize(void);
 
+  /* function: tmwdb_getStats
+   * purpose: Get the counters of the database queue. They may be read
+   *  while other threads are adding and storing entries.
+   * arguments:
+   *  pStats - returns the counters
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwdb_getStats(
+    TMWDB_STATS *pStats);
+
+  /* function: tmwdb_allocData
+   * purpose: Allocate a database entry
+   *  Entries of up to TMWCNFG_ASYNCH_DB_ENTRY_SIZE bytes come from the
+   *  entries preallocated by tmwdb_init when there is one free. Entries
+   *  are freed by the queue once stored or removed, or with tmwdb_freeData
+   *  if tmwdb_addEntry fails.
+   * arguments:
+   *  size - size of the entry in bytes
+   * returns:
+   *  the entry, or TMWDEFS_NULL if it could not be allocated
+   */
+  TMWDEFS_SCL_API void * TMWDEFS_GLOBAL tmwdb_allocData(
+    TMWTYPES_UINT size);
+
+  /* function: tmwdb_freeData
+   * purpose: Free a database entry allocated with tmwdb_allocData or
+   *  tmwtarg_alloc
+   * arguments:
+   *  pData - entry to free
+   * returns:
+   *  void
+   */
+  TMWDEFS_SCL_API void TMWDEFS_GLOBAL tmwdb_freeData(
+    void *pData);
+
   /* function: tmwdb_initData
    * purpose: Initialize a database entry
    *  This is called internally by the SCL before putting an
@@ -0,0 +1,491 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: tmwmetr.c
+ * description: Runtime metrics registry and Prometheus text export
+ */
+#include <stddef.h>
+
+#include "tmwscl/utils/tmwtarg.h"
+#include "tmwscl/utils/tmwmetr.h"
+#include "tmwscl/utils/tmwchnl.h"
+#include "tmwscl/utils/tmwsesn.h"
+
+#if TMWCNFG_SUPPORT_METRICS
+
+/* Upper bounds of the histogram buckets in milliseconds */
+static const TMWTYPES_MILLISECONDS _bucketBounds[TMWMETR_NUM_BUCKETS] = {
+  1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000
+};
+
+/* Registered channel and session metrics */
+static TMWTYPES_BOOL _initialized = TMWDEFS_FALSE;
+static TMWDLIST _channels;
+static TMWDLIST _sessions;
+#if TMWCNFG_SUPPORT_THREADS
+static TMWDEFS_RESOURCE_LOCK _registryLock;
+#endif
+
+/* Description of a counter or gauge kept in each metrics block */
+typedef struct {
+  const TMWTYPES_CHAR *pName;
+  const TMWTYPES_CHAR *pHelp;
+  const TMWTYPES_CHAR *pType;
+  TMWTYPES_UINT offset;
+} TMWMETR_VALUE_DESC;
+
+static const TMWMETR_VALUE_DESC _channelValues[] = {
+  {"tmwscl_channel_open", "1 while the channel connection is open", "gauge",
+    offsetof(TMWMETR_CHANNEL, open)},
+  {"tmwscl_channel_bytes_sent_total", "Bytes sent", "counter",
+    offsetof(TMWMETR_CHANNEL, bytesSent)},
+  {"tmwscl_channel_bytes_received_total", "Bytes received", "counter",
+    offsetof(TMWMETR_CHANNEL, bytesReceived)},
+  {"tmwscl_channel_frames_sent_total", "Link frames sent", "counter",
+    offsetof(TMWMETR_CHANNEL, framesSent)},
+  {"tmwscl_channel_frames_received_total", "Link frames received", "counter",
+    offsetof(TMWMETR_CHANNEL, framesReceived)},
+  {"tmwscl_channel_fragments_sent_total", "Application fragments sent", "counter",
+    offsetof(TMWMETR_CHANNEL, fragmentsSent)},
+  {"tmwscl_channel_fragments_received_total", "Application fragments received", "counter",
+    offsetof(TMWMETR_CHANNEL, fragmentsReceived)},
+  {"tmwscl_channel_link_retries_total", "Link frames sent again after no confirm", "counter",
+    offsetof(TMWMETR_CHANNEL, linkRetries)},
+  {"tmwscl_channel_crc_errors_total", "Frames received with an invalid CRC", "counter",
+    offsetof(TMWMETR_CHANNEL, errors) + TMWCHNL_ERROR_LINK_INVALID_CHECKSUM * sizeof(TMWTYPES_ULONG)}
+};
+
+static const TMWMETR_VALUE_DESC _sessionValues[] = {
+  {"tmwscl_session_online", "1 while the session is online", "gauge",
+    offsetof(TMWMETR_SESSION, online)},
+  {"tmwscl_session_asdus_sent_total", "Application layer messages sent", "counter",
+    offsetof(TMWMETR_SESSION, asdusSent)},
+  {"tmwscl_session_asdus_received_total", "Application layer messages received", "counter",
+    offsetof(TMWMETR_SESSION, asdusReceived)},
+  {"tmwscl_session_events_sent_total", "Events sent, including resends", "counter",
+    offsetof(TMWMETR_SESSION, eventsSent)},
+  {"tmwscl_session_events_confirmed_total", "Events confirmed and removed from the queues", "counter",
+    offsetof(TMWMETR_SESSION, eventsConfirmed)},
+  {"tmwscl_session_event_overflows_total", "Events dropped because an event queue was full", "counter",
+    offsetof(TMWMETR_SESSION, eventOverflows)},
+  {"tmwscl_session_request_timeouts_total", "Requests that timed out", "counter",
+    offsetof(TMWMETR_SESSION, requestTimeouts)},
+  {"tmwscl_session_request_failures_total", "Requests that failed", "counter",
+    offsetof(TMWMETR_SESSION, requestFailures)},
+  {"tmwscl_session_unsol_retries_total", "Unsolicited responses not confirmed in time", "counter",
+    offsetof(TMWMETR_SESSION, unsolRetries)}
+};
+
+#define TMWMETR_NUM_VALUES(descs) (sizeof(descs) / sizeof((descs)[0]))
+
+/* Snapshot output buffer */
+typedef struct {
+  TMWTYPES_CHAR *pBuf;
+  TMWTYPES_ULONG bufSize;
+  TMWTYPES_ULONG length;
+  TMWTYPES_BOOL overflow;
+} TMWMETR_OUTPUT;
+
+/* function: _written
+ * purpose: Account for text just written by tmwtarg_snprintf
+ * arguments:
+ *  pOut - snapshot output
+ *  length - length returned by tmwtarg_snprintf
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _written(
+  TMWMETR_OUTPUT *pOut,
+  TMWTYPES_INT length)
+{
+  /* tmwtarg_snprintf truncates, so if the text filled all the space
+   * left it may not have fit
+   */
+  if((TMWTYPES_ULONG)length + 1 >= pOut->bufSize - pOut->length)
+  {
+    pOut->overflow = TMWDEFS_TRUE;
+    return;
+  }
+  pOut->length += (TMWTYPES_ULONG)length;
+}
+
+/* function: _space
+ * purpose: Get the space left in the snapshot buffer
+ * arguments:
+ *  pOut - snapshot output
+ * returns:
+ *  TMWDEFS_NULL if the buffer is already full
+ */
+static TMWTYPES_CHAR * TMWDEFS_LOCAL _space(
+  TMWMETR_OUTPUT *pOut)
+{
+  if(pOut->overflow)
+  {
+    return(TMWDEFS_NULL);
+  }
+  return(pOut->pBuf + pOut->length);
+}
+
+/* function: _writeHeader */
+static void TMWDEFS_LOCAL _writeHeader(
+  TMWMETR_OUTPUT *pOut,
+  const TMWTYPES_CHAR *pName,
+  const TMWTYPES_CHAR *pHelp,
+  const TMWTYPES_CHAR *pType)
+{
+  TMWTYPES_CHAR *pSpace = _space(pOut);
+  if(pSpace != TMWDEFS_NULL)
+  {
+    _written(pOut, tmwtarg_snprintf(pSpace, (TMWTYPES_UINT)(pOut->bufSize - pOut->length),
+      "# HELP %s %s\n# TYPE %s %s\n", pName, pHelp, pName, pType));
+  }
+}
+
+/* function: _writeSample
+ * purpose: Write one sample line
+ * arguments:
+ *  pOut - snapshot output
+ *  pName - metric name
+ *  pSuffix - suffix added to the name, for histograms
+ *  pLabels - labels, without the braces
+ *  pExtra - more labels added after pLabels, or an empty string
+ *  value - sample value
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _writeSample(
+  TMWMETR_OUTPUT *pOut,
+  const TMWTYPES_CHAR *pName,
+  const TMWTYPES_CHAR *pSuffix,
+  const TMWTYPES_CHAR *pLabels,
+  const TMWTYPES_CHAR *pExtra,
+  TMWTYPES_ULONG value)
+{
+  TMWTYPES_CHAR *pSpace = _space(pOut);
+  if(pSpace != TMWDEFS_NULL)
+  {
+    _written(pOut, tmwtarg_snprintf(pSpace, (TMWTYPES_UINT)(pOut->bufSize - pOut->length),
+      "%s%s{%s%s} %lu\n", pName, pSuffix, pLabels, pExtra, (unsigned long)value));
+  }
+}
+
+/* function: _writeHistogram
+ * purpose: Write the bucket, sum and count lines of a histogram. Times
+ *  are kept in milliseconds and written in seconds.
+ * arguments:
+ *  pOut - snapshot output
+ *  pName - metric name
+ *  pLabels - labels, without the braces
+ *  pHistogram - histogram to write
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _writeHistogram(
+  TMWMETR_OUTPUT *pOut,
+  const TMWTYPES_CHAR *pName,
+  const TMWTYPES_CHAR *pLabels,
+  TMWMETR_HISTOGRAM *pHistogram)
+{
+  TMWTYPES_CHAR extra[32];
+  TMWTYPES_CHAR *pSpace;
+  TMWTYPES_ULONG cumulative = 0;
+  TMWTYPES_ULONG sum;
+  int i;
+
+  for(i = 0; i < TMWMETR_NUM_BUCKETS; i++)
+  {
+    cumulative += TMWMETR_GET(pHistogram->buckets[i]);
+    (void)tmwtarg_snprintf(extra, sizeof(extra), ",le=\"%lu.%03lu\"",
+      (unsigned long)(_bucketBounds[i] / 1000), (unsigned long)(_bucketBounds[i] % 1000));
+    _writeSample(pOut, pName, "_bucket", pLabels, extra, cumulative);
+  }
+  cumulative += TMWMETR_GET(pHistogram->buckets[TMWMETR_NUM_BUCKETS]);
+  _writeSample(pOut, pName, "_bucket", pLabels, ",le=\"+Inf\"", cumulative);
+
+  sum = TMWMETR_GET(pHistogram->sum);
+  pSpace = _space(pOut);
+  if(pSpace != TMWDEFS_NULL)
+  {
+    _written(pOut, tmwtarg_snprintf(pSpace, (TMWTYPES_UINT)(pOut->bufSize - pOut->length),
+      "%s_sum{%s} %lu.%03lu\n", pName, pLabels, (unsigned long)(sum / 1000), (unsigned long)(sum % 1000)));
+  }
+
+  _writeSample(pOut, pName, "_count", pLabels, "", cumulative);
+}
+
+/* function: _channelLabels */
+static void TMWDEFS_LOCAL _channelLabels(
+  TMWMETR_CHANNEL *pMetrics,
+  TMWTYPES_CHAR *pLabels,
+  TMWTYPES_UINT size)
+{
+  (void)tmwtarg_snprintf(pLabels, size, "channel=\"%s\"", pMetrics->name);
+}
+
+/* function: _sessionLabels */
+static void TMWDEFS_LOCAL _sessionLabels(
+  TMWMETR_SESSION *pMetrics,
+  TMWTYPES_CHAR *pLabels,
+  TMWTYPES_UINT size)
+{
+  (void)tmwtarg_snprintf(pLabels, size, "channel=\"%s\",source=\"%u\",destination=\"%u\"",
+    pMetrics->pChannelMetrics->name,
+    (unsigned int)pMetrics->pSession->srcAddress, (unsigned int)pMetrics->pSession->destAddress);
+}
+
+/* function: _value */
+static TMWTYPES_ULONG TMWDEFS_LOCAL _value(
+  void *pMetrics,
+  const TMWMETR_VALUE_DESC *pDesc)
+{
+  TMWTYPES_ULONG *pValue = (TMWTYPES_ULONG *)((TMWTYPES_UCHAR *)pMetrics + pDesc->offset);
+  return(TMWMETR_GET(*pValue));
+}
+
+/* function: _writeChannels */
+static void TMWDEFS_LOCAL _writeChannels(
+  TMWMETR_OUTPUT *pOut)
+{
+  TMWTYPES_CHAR labels[TMWMETR_NAME_LENGTH + 16];
+  TMWTYPES_CHAR extra[32];
+  TMWMETR_CHANNEL *pMetrics;
+  TMWTYPES_UINT i;
+  int code;
+
+  for(i = 0; i < TMWMETR_NUM_VALUES(_channelValues); i++)
+  {
+    _writeHeader(pOut, _channelValues[i].pName, _channelValues[i].pHelp, _channelValues[i].pType);
+    pMetrics = (TMWMETR_CHANNEL *)tmwdlist_getFirst(&_channels);
+    while(pMetrics != TMWDEFS_NULL)
+    {
+      _channelLabels(pMetrics, labels, sizeof(labels));
+      _writeSample(pOut, _channelValues[i].pName, "", labels, "", _value(pMetrics, &_channelValues[i]));
+      pMetrics = (TMWMETR_CHANNEL *)tmwdlist_getNext((TMWDLIST_MEMBER *)pMetrics);
+    }
+  }
+
+  /* Only codes that have occurred, labelled with the TMWCHNL_ERROR_CODE value */
+  _writeHeader(pOut, "tmwscl_channel_errors_total", "Channel errors by TMWCHNL_ERROR_CODE", "counter");
+  pMetrics = (TMWMETR_CHANNEL *)tmwdlist_getFirst(&_channels);
+  while(pMetrics != TMWDEFS_NULL)
+  {
+    _channelLabels(pMetrics, labels, sizeof(labels));
+    for(code = 0; code < TMWMETR_NUM_ERRORS; code++)
+    {
+      TMWTYPES_ULONG count = TMWMETR_GET(pMetrics->errors[code]);
+      if(count != 0)
+      {
+        (void)tmwtarg_snprintf(extra, sizeof(extra), ",code=\"%d\"", code);
+        _writeSample(pOut, "tmwscl_channel_errors_total", "", labels, extra, count);
+      }
+    }
+    pMetrics = (TMWMETR_CHANNEL *)tmwdlist_getNext((TMWDLIST_MEMBER *)pMetrics);
+  }
+
+  _writeHeader(pOut, "tmwscl_channel_timer_lag_seconds", "How late timers expired", "histogram");
+  pMetrics = (TMWMETR_CHANNEL *)tmwdlist_getFirst(&_channels);
+  while(pMetrics != TMWDEFS_NULL)
+  {
+    _channelLabels(pMetrics, labels, sizeof(labels));
+    _writeHistogram(pOut, "tmwscl_channel_timer_lag_seconds", labels, &pMetrics->timerLag);
+    pMetrics = (TMWMETR_CHANNEL *)tmwdlist_getNext((TMWDLIST_MEMBER *)pMetrics);
+  }
+}
+
+/* function: _writeSessions */
+static void TMWDEFS_LOCAL _writeSessions(
+  TMWMETR_OUTPUT *pOut)
+{
+  TMWTYPES_CHAR labels[TMWMETR_NAME_LENGTH + 48];
+  TMWTYPES_CHAR extra[16];
+  TMWMETR_SESSION *pMetrics;
+  TMWTYPES_UINT i;
+  int eventClass;
+
+  for(i = 0; i < TMWMETR_NUM_VALUES(_sessionValues); i++)
+  {
+    _writeHeader(pOut, _sessionValues[i].pName, _sessionValues[i].pHelp, _sessionValues[i].pType);
+    pMetrics = (TMWMETR_SESSION *)tmwdlist_getFirst(&_sessions);
+    while(pMetrics != TMWDEFS_NULL)
+    {
+      _sessionLabels(pMetrics, labels, sizeof(labels));
+      _writeSample(pOut, _sessionValues[i].pName, "", labels, "", _value(pMetrics, &_sessionValues[i]));
+      pMetrics = (TMWMETR_SESSION *)tmwdlist_getNext((TMWDLIST_MEMBER *)pMetrics);
+    }
+  }
+
+  _writeHeader(pOut, "tmwscl_session_events_queued", "Events waiting to be confirmed by class", "gauge");
+  pMetrics = (TMWMETR_SESSION *)tmwdlist_getFirst(&_sessions);
+  while(pMetrics != TMWDEFS_NULL)
+  {
+    _sessionLabels(pMetrics, labels, sizeof(labels));
+    for(eventClass = 0; eventClass < TMWMETR_NUM_CLASSES; eventClass++)
+    {
+      (void)tmwtarg_snprintf(extra, sizeof(extra), ",class=\"%d\"", eventClass + 1);
+      _writeSample(pOut, "tmwscl_session_events_queued", "", labels, extra,
+        TMWMETR_GET(pMetrics->eventsQueued[eventClass]));
+    }
+    pMetrics = (TMWMETR_SESSION *)tmwdlist_getNext((TMWDLIST_MEMBER *)pMetrics);
+  }
+
+  _writeHeader(pOut, "tmwscl_session_unsol_confirm_latency_seconds",
+    "Time from sending an unsolicited response until its confirm", "histogram");
+  pMetrics = (TMWMETR_SESSION *)tmwdlist_getFirst(&_sessions);
+  while(pMetrics != TMWDEFS_NULL)
+  {
+    _sessionLabels(pMetrics, labels, sizeof(labels));
+    _writeHistogram(pOut, "tmwscl_session_unsol_confirm_latency_seconds", labels,
+      &pMetrics->unsolConfirmLatency);
+    pMetrics = (TMWMETR_SESSION *)tmwdlist_getNext((TMWDLIST_MEMBER *)pMetrics);
+  }
+}
+
+/* function: tmwmetr_init */
+void TMWDEFS_GLOBAL tmwmetr_init(void)
+{
+  if(!_initialized)
+  {
+    tmwdlist_initialize(&_channels);
+    tmwdlist_initialize(&_sessions);
+    TMWTARG_LOCK_INIT(&_registryLock);
+    _initialized = TMWDEFS_TRUE;
+  }
+}
+
+/* function: tmwmetr_initChannel */
+void TMWDEFS_GLOBAL tmwmetr_initChannel(
+  TMWMETR_CHANNEL *pMetrics)
+{
+  memset(pMetrics, 0, sizeof(TMWMETR_CHANNEL));
+
+  TMWTARG_LOCK_SECTION(&_registryLock);
+  tmwdlist_addEntry(&_channels, (TMWDLIST_MEMBER *)pMetrics);
+  TMWTARG_UNLOCK_SECTION(&_registryLock);
+}
+
+/* function: tmwmetr_setChannelName */
+void TMWDEFS_GLOBAL tmwmetr_setChannelName(
+  TMWMETR_CHANNEL *pMetrics,
+  const TMWTYPES_CHAR *pName)
+{
+  int i = 0;
+
+  TMWTARG_LOCK_SECTION(&_registryLock);
+  if(pName != TMWDEFS_NULL)
+  {
+    for(; (i < TMWMETR_NAME_LENGTH - 1) && (pName[i] != '\0'); i++)
+    {
+      /* Keep the label value valid without escaping */
+      if((pName[i] == '"') || (pName[i] == '\\') || (pName[i] == '\n'))
+        pMetrics->name[i] = '_';
+      else
+        pMetrics->name[i] = pName[i];
+    }
+  }
+  pMetrics->name[i] = '\0';
+  TMWTARG_UNLOCK_SECTION(&_registryLock);
+}
+
+/* function: tmwmetr_deleteChannel */
+void TMWDEFS_GLOBAL tmwmetr_deleteChannel(
+  TMWMETR_CHANNEL *pMetrics)
+{
+  TMWTARG_LOCK_SECTION(&_registryLock);
+  (void)tmwdlist_removeEntry(&_channels, (TMWDLIST_MEMBER *)pMetrics);
+  TMWTARG_UNLOCK_SECTION(&_registryLock);
+}
+
+/* function: tmwmetr_openSession */
+void TMWDEFS_GLOBAL tmwmetr_openSession(
+  TMWMETR_SESSION *pMetrics,
+  TMWMETR_CHANNEL *pChannelMetrics,
+  struct TMWSessionStruct *pSession)
+{
+  memset(pMetrics, 0, sizeof(TMWMETR_SESSION));
+  pMetrics->pSession = pSession;
+  pMetrics->pChannelMetrics = pChannelMetrics;
+
+  TMWTARG_LOCK_SECTION(&_registryLock);
+  tmwdlist_addEntry(&_sessions, (TMWDLIST_MEMBER *)pMetrics);
+  TMWTARG_UNLOCK_SECTION(&_registryLock);
+}
+
+/* function: tmwmetr_closeSession */
+void TMWDEFS_GLOBAL tmwmetr_closeSession(
+  TMWMETR_SESSION *pMetrics)
+{
+  TMWTARG_LOCK_SECTION(&_registryLock);
+  (void)tmwdlist_removeEntry(&_sessions, (TMWDLIST_MEMBER *)pMetrics);
+  TMWTARG_UNLOCK_SECTION(&_registryLock);
+}
+
+/* function: tmwmetr_observe */
+void TMWDEFS_GLOBAL tmwmetr_observe(
+  TMWMETR_HISTOGRAM *pHistogram,
+  TMWTYPES_MILLISECONDS value)
+{
+  int i;
+
+  for(i = 0; i < TMWMETR_NUM_BUCKETS; i++)
+  {
+    if(value <= _bucketBounds[i])
+      break;
+  }
+  TMWMETR_INC(pHistogram->buckets[i]);
+  TMWMETR_ADD(pHistogram->sum, value);
+}
+
+/* function: tmwmetr_snapshot */
+TMWTYPES_ULONG TMWDEFS_GLOBAL tmwmetr_snapshot(
+  TMWTYPES_CHAR *pBuf,
+  TMWTYPES_ULONG bufSize)
+{
+  TMWMETR_OUTPUT out;
+
+  if((pBuf == TMWDEFS_NULL) || (bufSize == 0) || !_initialized)
+  {
+    return(0);
+  }
+
+  out.pBuf = pBuf;
+  out.bufSize = bufSize;
+  out.length = 0;
+  out.overflow = TMWDEFS_FALSE;
+  pBuf[0] = '\0';
+
+  TMWTARG_LOCK_SECTION(&_registryLock);
+  _writeChannels(&out);
+  _writeSessions(&out);
+  TMWTARG_UNLOCK_SECTION(&_registryLock);
+
+  if(out.overflow)
+  {
+    return(0);
+  }
+  return(out.length);
+}
+
+#endif /* TMWCNFG_SUPPORT_METRICS */
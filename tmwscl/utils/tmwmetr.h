@@ -0,0 +1,260 @@
+/*****************************************************************************/
+/* Triangle MicroWorks, Inc.                         Copyright (c) 1997-2020 */
+/*****************************************************************************/
+/*                                                                           */
+/* This file is the property of:                                             */
+/*                                                                           */
+/*                       Triangle MicroWorks, Inc.                           */
+/*                      Raleigh, North Carolina USA                          */
+/*                       www.TriangleMicroWorks.com                          */
+/*                          (919) 870-6615                                   */
+/*                                                                           */
+/* This Source Code and the associated Documentation contain proprietary     */
+/* information of Triangle MicroWorks, Inc. and may not be copied or         */
+/* distributed in any form without the written permission of Triangle        */
+/* MicroWorks, Inc.  Copies of the source code may be made only for backup   */
+/* purposes.                                                                 */
+/*                                                                           */
+/* Your License agreement may limit the installation of this source code to  */
+/* specific products.  Before installing this source code on a new           */
+/* application, check your license agreement to ensure it allows use on the  */
+/* product in question.  Contact Triangle MicroWorks for information about   */
+/* extending the number of products that may use this source code library or */
+/* obtaining the newest revision.                                            */
+/*                                                                           */
+/*****************************************************************************/
+
+/* file: tmwmetr.h
+ * description: Runtime metrics for channels and sessions.
+ *
+ *  Each channel and session keeps a block of counters, gauges and latency
+ *  histograms that the SCL updates as it processes data, from the same
+ *  places that generate statistics callbacks. The blocks are only ever
+ *  written while holding their channel lock, and are updated with relaxed
+ *  atomic adds so tmwmetr_snapshot can read them from any thread without
+ *  taking the channel locks. Only registering and removing blocks, and
+ *  taking a snapshot, use the registry lock.
+ *
+ *  tmwmetr_snapshot formats every registered block in the Prometheus text
+ *  exposition format. The target layer can then serve it or write it to a
+ *  file.
+ */
+#ifndef TMWMETR_DEFINED
+#define TMWMETR_DEFINED
+
+#include "tmwscl/utils/tmwcnfg.h"
+#include "tmwscl/utils/tmwdefs.h"
+#include "tmwscl/utils/tmwdlist.h"
+#include "tmwtargos.h"
+
+#if TMWCNFG_SUPPORT_METRICS
+
+#if !TMWCNFG_SUPPORT_STATS
+#error TMWCNFG_SUPPORT_STATS is required for TMWCNFG_SUPPORT_METRICS
+#endif
+
+/* Number of histogram buckets with an upper bound, see tmwmetr.c. One
+ * more bucket counts everything larger than the last bound.
+ */
+#define TMWMETR_NUM_BUCKETS   12
+
+/* Longest channel name kept for the channel label */
+#define TMWMETR_NAME_LENGTH   64
+
+/* Number of channel error codes counted, must be more than the number
+ * of TMWCHNL_ERROR_CODE values
+ */
+#define TMWMETR_NUM_ERRORS    32
+
+/* Number of event classes */
+#define TMWMETR_NUM_CLASSES   3
+
+/* Update a counter or gauge. The target layer may define these as atomic
+ * operations in tmwtargos.h, otherwise a snapshot taken on another thread
+ * may occasionally read a value that is being updated.
+ */
+#ifdef TMWTARG_ATOMIC_ADD
+#define TMWMETR_ADD(value, amount) TMWTARG_ATOMIC_ADD(&(value), (amount))
+#define TMWMETR_SET(value, amount) TMWTARG_ATOMIC_STORE(&(value), (amount))
+#define TMWMETR_GET(value)         TMWTARG_ATOMIC_LOAD(&(value))
+#else
+#define TMWMETR_ADD(value, amount) ((value) += (amount))
+#define TMWMETR_SET(value, amount) ((value) = (amount))
+#define TMWMETR_GET(value)         (value)
+#endif
+
+#define TMWMETR_INC(value)         TMWMETR_ADD(value, 1)
+#define TMWMETR_DEC(value)         TMWMETR_ADD(value, (TMWTYPES_ULONG)-1)
+
+/* Latency histogram, all times in milliseconds */
+typedef struct TMWMetricsHistogram {
+  TMWTYPES_ULONG buckets[TMWMETR_NUM_BUCKETS + 1];
+  TMWTYPES_ULONG sum;
+} TMWMETR_HISTOGRAM;
+
+/* Metrics kept for each channel */
+typedef struct TMWMetricsChannel {
+  /* List Member, must be first entry */
+  TMWDLIST_MEMBER listMember;
+
+  /* Value of the channel label */
+  TMWTYPES_CHAR name[TMWMETR_NAME_LENGTH];
+
+  /* Gauge, 1 while the channel connection is open */
+  TMWTYPES_ULONG open;
+
+  TMWTYPES_ULONG bytesSent;
+  TMWTYPES_ULONG bytesReceived;
+  TMWTYPES_ULONG framesSent;
+  TMWTYPES_ULONG framesReceived;
+  TMWTYPES_ULONG fragmentsSent;
+  TMWTYPES_ULONG fragmentsReceived;
+
+  /* Link frames sent again because no confirm was received */
+  TMWTYPES_ULONG linkRetries;
+
+  /* Errors indexed by TMWCHNL_ERROR_CODE */
+  TMWTYPES_ULONG errors[TMWMETR_NUM_ERRORS];
+
+  /* How late timers on this channel expired */
+  TMWMETR_HISTOGRAM timerLag;
+} TMWMETR_CHANNEL;
+
+/* Metrics kept for each session */
+typedef struct TMWMetricsSession {
+  /* List Member, must be first entry */
+  TMWDLIST_MEMBER listMember;
+
+  /* Session these metrics belong to, for the address labels */
+  struct TMWSessionStruct *pSession;
+
+  /* Metrics of the channel the session is on, for the channel label */
+  TMWMETR_CHANNEL *pChannelMetrics;
+
+  /* Gauge, 1 while the session is online */
+  TMWTYPES_ULONG online;
+
+  TMWTYPES_ULONG asdusSent;
+  TMWTYPES_ULONG asdusReceived;
+  TMWTYPES_ULONG eventsSent;
+  TMWTYPES_ULONG eventsConfirmed;
+  TMWTYPES_ULONG eventOverflows;
+  TMWTYPES_ULONG requestTimeouts;
+  TMWTYPES_ULONG requestFailures;
+
+  /* Gauges, number of events queued in each class */
+  TMWTYPES_ULONG eventsQueued[TMWMETR_NUM_CLASSES];
+
+  /* Unsolicited responses whose confirm did not arrive in time */
+  TMWTYPES_ULONG unsolRetries;
+
+  /* Time from sending an unsolicited response until its confirm */
+  TMWTYPES_MILLISECONDS unsolSentTime;
+  TMWMETR_HISTOGRAM unsolConfirmLatency;
+} TMWMETR_SESSION;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  /* function: tmwmetr_init
+   * purpose: Initialize the metrics registry. This is called by
+   *  tmwappl_initSCL and tmwappl_initApplication, and does nothing
+   *  if the registry is already initialized.
+   * arguments:
+   *  void
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_init(void);
+
+  /* function: tmwmetr_initChannel
+   * purpose: Clear a channel's metrics and add them to the registry
+   * arguments:
+   *  pMetrics - metrics to register
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_initChannel(
+    TMWMETR_CHANNEL *pMetrics);
+
+  /* function: tmwmetr_setChannelName
+   * purpose: Set the channel label. The name is copied.
+   * arguments:
+   *  pMetrics - channel metrics
+   *  pName - channel name, TMWDEFS_NULL leaves the label empty
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_setChannelName(
+    TMWMETR_CHANNEL *pMetrics,
+    const TMWTYPES_CHAR *pName);
+
+  /* function: tmwmetr_deleteChannel
+   * purpose: Remove a channel's metrics from the registry. Any sessions
+   *  on the channel must already have been removed.
+   * arguments:
+   *  pMetrics - metrics to remove
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_deleteChannel(
+    TMWMETR_CHANNEL *pMetrics);
+
+  /* function: tmwmetr_openSession
+   * purpose: Clear a session's metrics and add them to the registry
+   * arguments:
+   *  pMetrics - metrics to register
+   *  pChannelMetrics - metrics of the channel the session is on
+   *  pSession - session, used to label the metrics with its addresses
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_openSession(
+    TMWMETR_SESSION *pMetrics,
+    TMWMETR_CHANNEL *pChannelMetrics,
+    struct TMWSessionStruct *pSession);
+
+  /* function: tmwmetr_closeSession
+   * purpose: Remove a session's metrics from the registry
+   * arguments:
+   *  pMetrics - metrics to remove
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_closeSession(
+    TMWMETR_SESSION *pMetrics);
+
+  /* function: tmwmetr_observe
+   * purpose: Add a time to a histogram
+   * arguments:
+   *  pHistogram - histogram to update
+   *  value - time in milliseconds
+   * returns:
+   *  void
+   */
+  void TMWDEFS_GLOBAL tmwmetr_observe(
+    TMWMETR_HISTOGRAM *pHistogram,
+    TMWTYPES_MILLISECONDS value);
+
+  /* function: tmwmetr_snapshot
+   * purpose: Format the metrics of every registered channel and session
+   *  in the Prometheus text exposition format.
+   * arguments:
+   *  pBuf - buffer to write the text into
+   *  bufSize - size of pBuf
+   * returns:
+   *  Length of the text, not counting the terminating null character,
+   *  or 0 if it does not fit in pBuf
+   */
+  TMWDEFS_SCL_API TMWTYPES_ULONG TMWDEFS_GLOBAL tmwmetr_snapshot(
+    TMWTYPES_CHAR *pBuf,
+    TMWTYPES_ULONG bufSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TMWCNFG_SUPPORT_METRICS */
+
+#endif /* TMWMETR_DEFINED */
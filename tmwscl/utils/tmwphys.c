@@ -799,6 +799,10 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwphys_initChannel(
   pChannel->pPhys = &_tmwphysInterface;
   pChannel->pPhysContext = pContext;
 
+#if TMWCNFG_SUPPORT_METRICS
+  tmwmetr_setChannelName(&pChannel->metrics, tmwtarg_getChannelName(pContext->pIOContext));
+#endif
+
   return(TMWDEFS_TRUE);
 }
 
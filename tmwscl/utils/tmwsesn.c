@@ -68,6 +68,13 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwsesn_openSession(
   pSession->online = 0;
 
   tmwsesn_setStatCallback(pSession,pCallback,pCallbackParam);
+
+#if TMWCNFG_SUPPORT_METRICS
+  if (status)
+  {
+    tmwmetr_openSession(&pSession->metrics, &pChannel->metrics, pSession);
+  }
+#endif
   
   return (status);
 }
@@ -75,6 +82,9 @@ TMWTYPES_BOOL TMWDEFS_GLOBAL tmwsesn_openSession(
 /* function: tmwsesn_closeSession */
 void TMWDEFS_GLOBAL tmwsesn_closeSession(TMWSESN *pSession)
 {
+#if TMWCNFG_SUPPORT_METRICS
+  tmwmetr_closeSession(&pSession->metrics);
+#endif
   pSession->pUserData = TMWDEFS_NULL;
   TMWTARG_UNUSED_PARAM(pSession);
 }
@@ -103,12 +113,65 @@ void TMWDEFS_GLOBAL tmwsesn_setStatCallback(
   pSession->pStatCallbackParam = pCallbackParam;
 }
 
+#if TMWCNFG_SUPPORT_METRICS
+/* function: _updateMetrics
+ * purpose: Update the session metrics for a statistics event
+ * arguments:
+ *  pSession - session the event occurred on
+ *  eventType - statistics event
+ * returns:
+ *  void
+ */
+static void TMWDEFS_LOCAL _updateMetrics(
+  TMWSESN *pSession,
+  TMWSESN_STAT_EVENT eventType)
+{
+  TMWMETR_SESSION *pMetrics = &pSession->metrics;
+
+  switch(eventType)
+  {
+  case TMWSESN_STAT_ONLINE:
+    TMWMETR_SET(pMetrics->online, 1);
+    break;
+  case TMWSESN_STAT_OFFLINE:
+    TMWMETR_SET(pMetrics->online, 0);
+    break;
+  case TMWSESN_STAT_ASDU_SENT:
+    TMWMETR_INC(pMetrics->asdusSent);
+    break;
+  case TMWSESN_STAT_ASDU_RECEIVED:
+    TMWMETR_INC(pMetrics->asdusReceived);
+    break;
+  case TMWSESN_STAT_EVENT_OVERFLOW:
+    TMWMETR_INC(pMetrics->eventOverflows);
+    break;
+  case TMWSESN_STAT_DNPEVENT_SENT:
+    TMWMETR_INC(pMetrics->eventsSent);
+    break;
+  case TMWSESN_STAT_DNPEVENT_CONFIRM:
+    TMWMETR_INC(pMetrics->eventsConfirmed);
+    break;
+  case TMWSESN_STAT_REQUEST_TIMEOUT:
+    TMWMETR_INC(pMetrics->requestTimeouts);
+    break;
+  case TMWSESN_STAT_REQUEST_FAILED:
+    TMWMETR_INC(pMetrics->requestFailures);
+    break;
+  default:
+    break;
+  }
+}
+#endif
+
 /* function: tmwsesn_callStatCallback */
 void TMWDEFS_GLOBAL tmwsesn_callStatCallback(
   TMWSESN *pSession,
   TMWSESN_STAT_EVENT eventType,
   void *pEventData)
 {
+#if TMWCNFG_SUPPORT_METRICS
+  _updateMetrics(pSession, eventType);
+#endif
   if(pSession->pStatCallbackFunc != TMWDEFS_NULL)
   {
     pSession->pStatCallbackFunc(
@@ -34,6 +34,7 @@
 #include "tmwscl/utils/tmwdefs.h"
 #include "tmwscl/utils/tmwdlist.h"
 #include "tmwscl/utils/tmwtimer.h"
+#include "tmwscl/utils/tmwmetr.h"
 #endif
 
 /* Define session information passed to the user */
@@ -283,6 +284,11 @@ typedef struct TMWSessionStruct {
 
   /* Diagnostic mask */
   TMWTYPES_ULONG sesnDiagMask;
+
+#if TMWCNFG_SUPPORT_METRICS
+  /* Runtime metrics */
+  TMWMETR_SESSION metrics;
+#endif
 } TMWSESN;
 
 
@@ -56,27 +56,45 @@ void TMWDEFS_CALLBACK tmwsim_tableDestroy(
   tmwdlist_destroy(pTableHead, (TMWMEM_FREE_FUNC)tmwsim_deletePoint);
 } 
 
-/* function: tmwsim_tableAdd */
-TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableAdd(
+/* function: _insertBefore
+ * purpose: Insert a point before pEntry, or at the end of the list if
+ *  pEntry is TMWDEFS_NULL. A point put between two points of an arena
+ *  means the arena can no longer be indexed directly.
+ */
+static void TMWDEFS_LOCAL _insertBefore(
   TMWSIM_TABLE_HEAD *pTableHead,
-  TMWTYPES_ULONG pointNum)
+  TMWSIM_POINT *pEntry,
+  TMWSIM_POINT *pPoint)
 {
-  TMWSIM_POINT *pPoint;
+  if(pEntry == TMWDEFS_NULL)
+  {
+    tmwdlist_addEntry(pTableHead, (TMWDLIST_MEMBER *)pPoint);
+    return;
+  }
 
-  /* List must be kept in order, otherwise a range won't work     */
-  /* Start at the end of list, since we often add points in order */
-  TMWSIM_POINT *pEntry = TMWDEFS_NULL;
+  if((pEntry->pArena != TMWDEFS_NULL) && (pEntry != &pEntry->pArena->points[0]))
+    pEntry->pArena->contiguous = TMWDEFS_FALSE;
 
-  pPoint = tmwsim_newPoint();
-  if(pPoint == TMWDEFS_NULL)
-    return(TMWDEFS_NULL);
+  tmwdlist_insertEntryBefore(pTableHead,
+    (TMWDLIST_MEMBER *)pEntry, (TMWDLIST_MEMBER *)pPoint);
+}
 
-  pEntry = (TMWSIM_POINT *)tmwdlist_getLast(pTableHead); 
+/* function: _insertPoint
+ * purpose: Insert a point in point number order
+ */
+static void TMWDEFS_LOCAL _insertPoint(
+  TMWSIM_TABLE_HEAD *pTableHead,
+  TMWSIM_POINT *pPoint,
+  TMWTYPES_ULONG pointNum)
+{
+  /* List must be kept in order, otherwise a range won't work     */
+  /* Start at the end of list, since we often add points in order */
+  TMWSIM_POINT *pEntry = (TMWSIM_POINT *)tmwdlist_getLast(pTableHead); 
   if((pEntry == TMWDEFS_NULL) || (pEntry->pointNumber < pointNum))
   {
     /* Yes, insert at end of queue */
     tmwdlist_addEntry(pTableHead, (TMWDLIST_MEMBER *)pPoint);
-    return(pPoint);
+    return;
   }
 
   /* Oh well, start at the beginning of list and see where to insert */
@@ -88,20 +106,127 @@ TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableAdd(
       break;
   }
 
-  /* See if we are at the end of the queue */
-  if(pEntry != TMWDEFS_NULL)
+  /* Insert before next entry, or at end of queue if there is none */
+  _insertBefore(pTableHead, pEntry, pPoint);
+}
+
+/* function: tmwsim_tableAdd */
+TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableAdd(
+  TMWSIM_TABLE_HEAD *pTableHead,
+  TMWTYPES_ULONG pointNum)
+{
+  TMWSIM_POINT *pPoint = tmwsim_newPoint();
+  if(pPoint == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  _insertPoint(pTableHead, pPoint, pointNum);
+  return(pPoint);
+} 
+
+/* function: tmwsim_tableAddRange */
+TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableAddRange(
+  TMWSIM_TABLE_HEAD *pTableHead,
+  TMWTYPES_ULONG firstPointNum,
+  TMWTYPES_ULONG numPoints,
+  const TMWSIM_POINT *pTemplate)
+{
+  TMWSIM_POINT *pFirst = TMWDEFS_NULL;
+  TMWSIM_POINT *pPrev = TMWDEFS_NULL;
+  TMWSIM_POINT *pNext;
+  TMWTYPES_ULONG i;
+#if TMWCNFG_USE_DYNAMIC_MEMORY && !TMWCNFG_ALLOC_ONLY_AT_STARTUP
+  TMWSIM_ARENA *pArena;
+#else
+  TMWSIM_POINT *pChain = TMWDEFS_NULL;
+#endif
+
+  if((numPoints == 0) || (firstPointNum + (numPoints - 1) < firstPointNum))
+    return(TMWDEFS_NULL);
+
+#if TMWCNFG_USE_DYNAMIC_MEMORY && !TMWCNFG_ALLOC_ONLY_AT_STARTUP
+  if(numPoints > (TMWDEFS_ULONG_MAX - sizeof(TMWSIM_ARENA)) / sizeof(TMWSIM_POINT))
+    return(TMWDEFS_NULL);
+
+  pArena = (TMWSIM_ARENA *)tmwtarg_alloc((TMWTYPES_UINT)(sizeof(TMWSIM_ARENA)
+    + (numPoints - 1) * sizeof(TMWSIM_POINT)));
+  if(pArena == TMWDEFS_NULL)
+    return(TMWDEFS_NULL);
+
+  pArena->firstPointNumber = firstPointNum;
+  pArena->numPoints = numPoints;
+  pArena->numLive = numPoints;
+  pArena->contiguous = TMWDEFS_TRUE;
+#else
+  /* Allocate every point before adding any, chained through their list
+   * members, so a failure leaves the table as it was
+   */
+  for(i = 0; i < numPoints; i++)
+  {
+    TMWSIM_POINT *pPoint = tmwsim_newPoint();
+    if(pPoint == TMWDEFS_NULL)
+    {
+      while(pChain != TMWDEFS_NULL)
+      {
+        pNext = (TMWSIM_POINT *)pChain->listMember.pNext;
+        tmwmem_free(pChain);
+        pChain = pNext;
+      }
+      return(TMWDEFS_NULL);
+    }
+    pPoint->listMember.pNext = (TMWDLIST_MEMBER *)pChain;
+    pChain = pPoint;
+  }
+#endif
+
+  for(i = 0; i < numPoints; i++)
   {
-    /* No, insert before next event entry */
-    tmwdlist_insertEntryBefore(pTableHead,
-      (TMWDLIST_MEMBER *)pEntry, (TMWDLIST_MEMBER *)pPoint);
+#if TMWCNFG_USE_DYNAMIC_MEMORY && !TMWCNFG_ALLOC_ONLY_AT_STARTUP
+    TMWSIM_POINT *pPoint = &pArena->points[i];
+    *pPoint = *pTemplate;
+    pPoint->pArena = pArena;
+#else
+    TMWSIM_POINT *pPoint = pChain;
+    pChain = (TMWSIM_POINT *)pChain->listMember.pNext;
+    *pPoint = *pTemplate;
+    pPoint->pArena = TMWDEFS_NULL;
+#endif
+    pPoint->pointNumber = firstPointNum + i;
+
+    /* Each point usually follows the one before it, only search the
+     * table for the first point or if the range overlaps other points
+     */
+    pNext = (pPrev == TMWDEFS_NULL) ? TMWDEFS_NULL
+      : (TMWSIM_POINT *)tmwdlist_getNext((TMWDLIST_MEMBER *)pPrev);
+    if((pPrev != TMWDEFS_NULL) 
+      && ((pNext == TMWDEFS_NULL) || (pNext->pointNumber > pPoint->pointNumber)))
+    {
+      _insertBefore(pTableHead, pNext, pPoint);
+    }
+    else
+    {
+      _insertPoint(pTableHead, pPoint, pPoint->pointNumber);
+    }
+
+    if(pFirst == TMWDEFS_NULL)
+      pFirst = pPoint;
+    pPrev = pPoint;
   }
-  else
+
+#if TMWCNFG_USE_DYNAMIC_MEMORY && !TMWCNFG_ALLOC_ONLY_AT_STARTUP
+  /* Points of the table with the same point numbers may have ended up
+   * between points of the arena
+   */
+  for(i = 1; i < numPoints; i++)
   {
-    /* Yes, insert at end of queue */
-    tmwdlist_addEntry(pTableHead, (TMWDLIST_MEMBER *)pPoint);
+    if(tmwdlist_getNext((TMWDLIST_MEMBER *)&pArena->points[i - 1]) != (TMWDLIST_MEMBER *)&pArena->points[i])
+    {
+      pArena->contiguous = TMWDEFS_FALSE;
+      break;
+    }
   }
-  return(pPoint);
-} 
+#endif
+  return(pFirst);
+}
 
 /* function: tmwsim_tableDelete */
 TMWTYPES_BOOL TMWDEFS_CALLBACK tmwsim_tableDelete(
@@ -128,9 +253,22 @@ TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableFindPoint(
    TMWSIM_POINT *pPoint = (TMWSIM_POINT *)tmwdlist_getFirst(pTableHead);
    while(pPoint != TMWDEFS_NULL)
    {
+     TMWSIM_ARENA *pArena;
+
      if(pPoint->pointNumber == pointNum)
        return(pPoint);
 
+     /* Index an arena that is still in one piece instead of walking it */
+     pArena = pPoint->pArena;
+     if((pArena != TMWDEFS_NULL) && pArena->contiguous && (pPoint == &pArena->points[0]))
+     {
+       if((pointNum > pArena->firstPointNumber) 
+         && (pointNum - pArena->firstPointNumber < pArena->numPoints))
+         return(&pArena->points[pointNum - pArena->firstPointNumber]);
+
+       pPoint = &pArena->points[pArena->numPoints - 1];
+     }
+
      pPoint = (TMWSIM_POINT *)tmwdlist_getNext((TMWDLIST_MEMBER *)pPoint);
   }
   return(TMWDEFS_NULL);
@@ -168,12 +306,23 @@ TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableFindPointByIndex(
   TMWSIM_TABLE_HEAD *pTableHead,
   TMWTYPES_USHORT pointIndex)
 {
-  int i;
+  TMWTYPES_ULONG i = 0;
   TMWSIM_POINT *pPoint = tmwsim_tableGetFirstPoint(pTableHead);
-  for(i=0; i<pointIndex; i++)
+  while((pPoint != TMWDEFS_NULL) && (i < pointIndex))
   { 
-    if(pPoint == TMWDEFS_NULL)
-      break;
+    /* Index an arena that is still in one piece instead of walking it */
+    TMWSIM_ARENA *pArena = pPoint->pArena;
+    if((pArena != TMWDEFS_NULL) && pArena->contiguous && (pPoint == &pArena->points[0]))
+    {
+      if(pointIndex - i < pArena->numPoints)
+        return(&pArena->points[pointIndex - i]);
+
+      i += pArena->numPoints;
+      pPoint = tmwsim_tableGetNextPoint(pTableHead, &pArena->points[pArena->numPoints - 1]);
+      continue;
+    }
+
+    i++;
     pPoint = tmwsim_tableGetNextPoint(pTableHead, pPoint);
   }
   return(pPoint);
@@ -195,7 +344,10 @@ TMWTYPES_UINT TMWDEFS_CALLBACK tmwsim_tableSize(
 /* function: tmwsim_newPoint */
 TMWSIM_POINT *TMWDEFS_GLOBAL tmwsim_newPoint(void)
 {
-  return((TMWSIM_POINT *)tmwmem_alloc(TMWMEM_SIM_POINT_TYPE));
+  TMWSIM_POINT *pPoint = (TMWSIM_POINT *)tmwmem_alloc(TMWMEM_SIM_POINT_TYPE);
+  if(pPoint != TMWDEFS_NULL)
+    pPoint->pArena = TMWDEFS_NULL;
+  return(pPoint);
 }
 
 /* function: tmwsim_deletePoint */
@@ -215,6 +367,16 @@ void TMWDEFS_CALLBACK tmwsim_deletePoint(TMWSIM_POINT *pPoint)
   { 
     tmwmem_free(pPoint->data.attribute.pBuf);
   }
+
+  if(pPoint->pArena != TMWDEFS_NULL)
+  {
+    /* The arena is freed with its last point */
+    TMWSIM_ARENA *pArena = pPoint->pArena;
+    pArena->contiguous = TMWDEFS_FALSE;
+    if(--pArena->numLive == 0)
+      tmwtarg_free(pArena);
+    return;
+  }
   tmwmem_free(pPoint);
 }
 
@@ -217,6 +217,11 @@ typedef struct TMWSIMPointStruct {
   TMWTIMER freezeTimer;
   TMWTYPES_ULONG freezeInterval;
   void *pCallbackParam;
+
+  /* Arena this point was allocated from by tmwsim_tableAddRange, or
+   * TMWDEFS_NULL if it was allocated by itself
+   */
+  struct TMWSimArenaStruct *pArena;
   union {
     TMWSIM_BINARY binary;
     TMWSIM_DOUBLE_BINARY doubleBinary;
@@ -232,6 +237,26 @@ typedef struct TMWSIMPointStruct {
   } data;
 } TMWSIM_POINT;
 
+/* A range of points with consecutive point numbers allocated in one block
+ * by tmwsim_tableAddRange. The block is freed when the last of its points
+ * is deleted.
+ */
+typedef struct TMWSimArenaStruct {
+  TMWTYPES_ULONG firstPointNumber;
+  TMWTYPES_ULONG numPoints;
+
+  /* Points not deleted yet */
+  TMWTYPES_ULONG numLive;
+
+  /* TMWDEFS_TRUE while every point of the arena is still in the table
+   * and no other point has been inserted between them, so a lookup can
+   * index the arena instead of walking it
+   */
+  TMWTYPES_BOOL contiguous;
+
+  TMWSIM_POINT points[1];
+} TMWSIM_ARENA;
+
 /* Specify callback */
 typedef enum {
   TMWSIM_POINT_ADD = 0,
@@ -277,6 +302,30 @@ extern "C" {
     TMWSIM_TABLE_HEAD *pTableHead,
     TMWTYPES_ULONG pointNum);
 
+  /* function: tmwsim_tableAddRange
+   * purpose: Add numPoints points numbered from firstPointNum, each a copy
+   *  of pTemplate. With TMWCNFG_USE_DYNAMIC_MEMORY the points are
+   *  allocated together in one arena, so adding them costs one allocation
+   *  and finding them does not walk the range. Otherwise each point is
+   *  allocated with tmwsim_newPoint.
+   * arguments:
+   *  pTableHead - table to add the points to
+   *  firstPointNum - point number of the first point
+   *  numPoints - number of points to add, at least 1
+   *  pTemplate - initialized point copied into each new point, it must
+   *   not be a string, list or attribute point since their buffers would
+   *   be shared
+   * returns:
+   *  pointer to the first point, the others follow it in the table
+   *  TMWDEFS_NULL if the points could not be allocated, in which case
+   *   none were added
+   */
+  TMWSIM_POINT * TMWDEFS_CALLBACK tmwsim_tableAddRange(
+    TMWSIM_TABLE_HEAD *pTableHead,
+    TMWTYPES_ULONG firstPointNum,
+    TMWTYPES_ULONG numPoints,
+    const TMWSIM_POINT *pTemplate);
+
   /* function: tmwsim_tableDelete
    * purpose:
    * arguments:
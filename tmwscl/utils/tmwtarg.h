@@ -770,6 +770,9 @@ typedef struct TmwtargIOChannel {
 
 #if TMWCNFG_SUPPORT_THREADS
   TMW_ThreadId                      chanThreadHandle;
+
+  /* Worker thread driving this channel instead of chanThreadHandle */
+  void                             *pWorkerContext;
 #endif
 } TMWTARG_IO_CHANNEL;
 
@@ -230,6 +230,12 @@ static void TMWDEFS_CALLBACK _timerCallback(
     /* Process this timer if it has already timed out */
     if((pLockedTimer == pTimer) && _checkTimerExpired(pTimer, now))
     {
+#if TMWCNFG_SUPPORT_METRICS
+      /* Copy these while the timer queue is still locked */
+      TMWCHNL *pTimerChannel = pTimer->pChannel;
+      TMWTYPES_MILLISECONDS timerLag = now - pTimer->timeout;
+#endif
+
       /* Cancel timer and delete from list */
       pTimer->active = TMWDEFS_FALSE;
       tmwdlist_removeEntry(&_timerPool.list, (TMWDLIST_MEMBER *)pTimer);
@@ -237,6 +243,12 @@ static void TMWDEFS_CALLBACK _timerCallback(
       /* Unlock this, so that others can access timer queue */
       TMWTARG_UNLOCK_SECTION(&_timerPool.lock);
 
+#if TMWCNFG_SUPPORT_METRICS
+      /* Record how late the timer expired */
+      if(pTimerChannel != TMWDEFS_NULL)
+        tmwmetr_observe(&pTimerChannel->metrics.timerLag, timerLag);
+#endif
+
       /* Call timer callback */
       if(pTimer->pCallback != TMWDEFS_NULL)
       {
@@ -469,6 +481,11 @@ static void TMWDEFS_CALLBACK _timerCallback(
     pTimer->active = TMWDEFS_FALSE;
     tmwdlist_removeEntry(&pChannel->timerQueue.list, (TMWDLIST_MEMBER *)pTimer);
 
+#if TMWCNFG_SUPPORT_METRICS
+    /* Record how late the timer expired */
+    tmwmetr_observe(&pChannel->metrics.timerLag, now - pTimer->timeout);
+#endif
+
     /* Call timer callback */
     if(pTimer->pCallback != TMWDEFS_NULL)
     {